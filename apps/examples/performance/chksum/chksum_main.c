@@ -0,0 +1,193 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <lwip/inet_chksum.h>
+
+#define CHKSUM_BYTES   (2 * 1024 * 1024)
+#define CHKSUM_BUFLEN  1536
+#define CHKSUM_CHECKS  20000
+
+static const int g_lengths[] = { 64, 512, 1460 };
+
+/* Room for the longest length at any of the offsets 0..3 */
+
+static uint32_t g_src[(CHKSUM_BUFLEN + 4) / 4];
+static uint32_t g_dst[(CHKSUM_BUFLEN + 4) / 4];
+
+static volatile u16_t g_sink;
+
+static double elapsed(struct timespec *start, struct timespec *end)
+{
+	return ((double)end->tv_sec + 1.0e-9 * end->tv_nsec) - ((double)start->tv_sec + 1.0e-9 * start->tv_nsec);
+}
+
+static void report(const char *name, int len, int soff, int doff, struct timespec *start, struct timespec *end)
+{
+	double sec = elapsed(start, end);
+
+	printf("%-16s len %4d src+%d dst+%d: %8.2f MB/s\n", name, len, soff, doff, sec > 0 ? CHKSUM_BYTES / sec / (1024 * 1024) : 0.0);
+}
+
+static void bench_chksum(int len, int off)
+{
+	const u8_t *src = (const u8_t *)g_src + off;
+	struct timespec start;
+	struct timespec end;
+	int n;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (n = 0; n < CHKSUM_BYTES; n += len) {
+		g_sink = inet_chksum(src, len);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("chksum", len, off, off, &start, &end);
+}
+
+static void bench_copy(int len, int soff, int doff)
+{
+	const u8_t *src = (const u8_t *)g_src + soff;
+	u8_t *dst = (u8_t *)g_dst + doff;
+	struct timespec start;
+	struct timespec end;
+	int n;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (n = 0; n < CHKSUM_BYTES; n += len) {
+		memcpy(dst, src, len);
+		g_sink = inet_chksum(dst, len);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("memcpy+chksum", len, soff, doff, &start, &end);
+
+#if LWIP_CHECKSUM_ON_COPY
+	/* LWIP_CHKSUM_COPY() returns the sum, inet_chksum() its complement */
+	memset(dst, 0, len);
+	if ((u16_t)~LWIP_CHKSUM_COPY(dst, src, len) != inet_chksum(src, len) || memcmp(dst, src, len) != 0) {
+		printf("chksum_copy len %d src+%d dst+%d: MISMATCH\n", len, soff, doff);
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (n = 0; n < CHKSUM_BYTES; n += len) {
+		g_sink = LWIP_CHKSUM_COPY(dst, src, len);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	report("chksum_copy", len, soff, doff, &start, &end);
+#endif
+}
+
+#ifdef CONFIG_NET_ARCH_CHKSUM
+/* Compare up_chksum() and up_chksum_copy() with the portable sum over random
+ * data, lengths and alignments of source and destination.
+ */
+
+static int verify_arch_chksum(void)
+{
+	u8_t *src;
+	u8_t *dst;
+	u16_t ref;
+	int errors = 0;
+	int len;
+	int soff;
+	int doff;
+	int n;
+	int i;
+
+	srand(1);
+	for (n = 0; n < CHKSUM_CHECKS; n++) {
+		len = rand() % (CHKSUM_BUFLEN + 1);
+		soff = rand() & 3;
+		doff = rand() & 3;
+		src = (u8_t *)g_src + soff;
+		dst = (u8_t *)g_dst + doff;
+		for (i = 0; i < len; i++) {
+			src[i] = (u8_t)rand();
+		}
+
+		ref = lwip_standard_chksum(src, len);
+		if (up_chksum(src, len) != ref) {
+			printf("up_chksum len %d src+%d: 0x%04x, expected 0x%04x\n", len, soff, up_chksum(src, len), ref);
+			errors++;
+		}
+
+		memset(dst, 0, len);
+		if (up_chksum_copy(dst, src, (u16_t)len) != ref || memcmp(dst, src, len) != 0) {
+			printf("up_chksum_copy len %d src+%d dst+%d: MISMATCH\n", len, soff, doff);
+			errors++;
+		}
+	}
+
+	printf("up_chksum: %d random checks, %d errors\n", CHKSUM_CHECKS, errors);
+	return errors;
+}
+#endif
+
+/****************************************************************************
+ * chksum_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int chksum_main(int argc, char *argv[])
+#endif
+{
+	int i;
+	int off;
+
+	printf("Internet Checksum Performance Measurement\n");
+
+#ifdef CONFIG_NET_ARCH_CHKSUM
+	if (verify_arch_chksum() != 0) {
+		return -1;
+	}
+#endif
+
+	for (i = 0; i < sizeof(g_src); i++) {
+		((u8_t *)g_src)[i] = (u8_t)(i * 7 + 3);
+	}
+
+	for (i = 0; i < sizeof(g_lengths) / sizeof(g_lengths[0]); i++) {
+		for (off = 0; off < 4; off++) {
+			bench_chksum(g_lengths[i], off);
+		}
+
+		/* same alignment, then halfword and odd relative offsets */
+
+		bench_copy(g_lengths[i], 0, 0);
+		bench_copy(g_lengths[i], 1, 1);
+		bench_copy(g_lengths[i], 0, 2);
+		bench_copy(g_lengths[i], 0, 1);
+	}
+
+#if !LWIP_CHECKSUM_ON_COPY
+	printf("chksum_copy: not measured, enable NET_CHECKSUM_ON_COPY\n");
+#endif
+
+	return 0;
+}
@@ -24,9 +24,13 @@
 #include <stdio.h>
 #include <sched.h>
 #include <time.h>
+#include <pthread.h>
 #include <sys/types.h>
 
 #define SWITCHING_ITERATIONS 1000000
+#define HANDOFF_ITERATIONS   100000
+
+static pthread_mutex_t g_handoff_mutex;
 
 static int yield_task_1(int a, char *b[])
 {
@@ -61,6 +65,48 @@ static int yield_task_2(int a, char *b[])
 	return 0;
 }
 
+/* Two tasks yield while holding the same mutex, so every lock blocks and
+ * every unlock hands the mutex over to the other task.  This measures the
+ * contended mutex path, including the priority inheritance bookkeeping.
+ */
+
+static int handoff_task_1(int a, char *b[])
+{
+	int cnt = HANDOFF_ITERATIONS;
+	struct timespec start;
+	struct timespec end;
+	double diff_time;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	while (cnt--) {
+		pthread_mutex_lock(&g_handoff_mutex);
+		sched_yield();
+		pthread_mutex_unlock(&g_handoff_mutex);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	diff_time = ((double)end.tv_sec + 1.0e-9 * end.tv_nsec) - ((double)start.tv_sec + 1.0e-9 * start.tv_nsec);
+
+	printf("%d-th Average Mutex Handoff Time is %.10f seconds\n", HANDOFF_ITERATIONS, (double)diff_time / (2 * HANDOFF_ITERATIONS));
+
+	return 0;
+}
+
+static int handoff_task_2(int a, char *b[])
+{
+	int cnt = HANDOFF_ITERATIONS;
+
+	while (cnt--) {
+		pthread_mutex_lock(&g_handoff_mutex);
+		sched_yield();
+		pthread_mutex_unlock(&g_handoff_mutex);
+	}
+
+	return 0;
+}
+
 #ifdef CONFIG_BUILD_KERNEL
 int main(int argc, FAR char *argv[])
 #else
@@ -75,6 +121,12 @@ int ctx_switch_main(int argc, char *argv[])
 	task_create("A_Task", SCHED_PRIORITY_MAX, 1024, yield_task_1, NULL);
 	task_create("B_Task", SCHED_PRIORITY_MAX, 1024, yield_task_2, NULL);
 
+	/* The mutex handoff runs after the yield measurement has finished */
+
+	pthread_mutex_init(&g_handoff_mutex, NULL);
+	task_create("C_Task", SCHED_PRIORITY_MAX - 1, 1024, handoff_task_1, NULL);
+	task_create("D_Task", SCHED_PRIORITY_MAX - 1, 1024, handoff_task_2, NULL);
+
 	sched_unlock();
 
 	return 0;
@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define THROUGHPUT_BYTES  (4 * 1024 * 1024)
+#define THROUGHPUT_CHUNK  1024
+#define LATENCY_ROUNDS    10000
+#define LATENCY_MSGLEN    64
+
+static char g_buf[THROUGHPUT_CHUNK];
+
+static double elapsed(struct timespec *start, struct timespec *end)
+{
+	return ((double)end->tv_sec + 1.0e-9 * end->tv_nsec) - ((double)start->tv_sec + 1.0e-9 * start->tv_nsec);
+}
+
+static socklen_t abstract_addr(struct sockaddr_un *addr, const char *name)
+{
+	memset(addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	strncpy(&addr->sun_path[1], name, sizeof(addr->sun_path) - 2);
+	return offsetof(struct sockaddr_un, sun_path) + 1 + strlen(name);
+}
+
+static int recv_all(int fd, char *buf, int len)
+{
+	int total = 0;
+	int ret;
+
+	while (total < len) {
+		ret = recv(fd, buf + total, len - total, 0);
+		if (ret <= 0) {
+			return ret;
+		}
+		total += ret;
+	}
+	return total;
+}
+
+/* Connect a stream socket pair over AF_UNIX or over TCP on 127.0.0.1.  The
+ * connection is queued by the listener, so no second task is needed.
+ */
+
+static int stream_pair(int domain, int *cfd, int *sfd)
+{
+	struct sockaddr_un un;
+	struct sockaddr_in in;
+	struct sockaddr *addr;
+	socklen_t addrlen;
+	int lfd;
+
+	lfd = socket(domain, SOCK_STREAM, 0);
+	if (lfd < 0) {
+		return -1;
+	}
+
+	if (domain == AF_UNIX) {
+		addrlen = abstract_addr(&un, "lsbench");
+		addr = (struct sockaddr *)&un;
+	} else {
+		memset(&in, 0, sizeof(in));
+		in.sin_family = AF_INET;
+		in.sin_port = 0;
+		in.sin_addr.s_addr = inet_addr("127.0.0.1");
+		addrlen = sizeof(in);
+		addr = (struct sockaddr *)&in;
+	}
+
+	if (bind(lfd, addr, addrlen) < 0 || listen(lfd, 1) < 0 || getsockname(lfd, addr, &addrlen) < 0) {
+		goto errout;
+	}
+
+	*cfd = socket(domain, SOCK_STREAM, 0);
+	if (*cfd < 0) {
+		goto errout;
+	}
+	if (connect(*cfd, addr, addrlen) < 0) {
+		close(*cfd);
+		goto errout;
+	}
+
+	*sfd = accept(lfd, NULL, NULL);
+	if (*sfd < 0) {
+		close(*cfd);
+		goto errout;
+	}
+
+	close(lfd);
+	return 0;
+
+errout:
+	close(lfd);
+	return -1;
+}
+
+static int dgram_pair(int *cfd, int *sfd)
+{
+	struct sockaddr_un caddr;
+	struct sockaddr_un saddr;
+	socklen_t clen = abstract_addr(&caddr, "lsbench.c");
+	socklen_t slen = abstract_addr(&saddr, "lsbench.s");
+
+	*cfd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	*sfd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	if (*cfd < 0 || *sfd < 0) {
+		goto errout;
+	}
+
+	if (bind(*cfd, (struct sockaddr *)&caddr, clen) < 0 || bind(*sfd, (struct sockaddr *)&saddr, slen) < 0) {
+		goto errout;
+	}
+	if (connect(*cfd, (struct sockaddr *)&saddr, slen) < 0 || connect(*sfd, (struct sockaddr *)&caddr, clen) < 0) {
+		goto errout;
+	}
+	return 0;
+
+errout:
+	if (*cfd >= 0) {
+		close(*cfd);
+	}
+	if (*sfd >= 0) {
+		close(*sfd);
+	}
+	return -1;
+}
+
+static void *sink_thread(void *arg)
+{
+	int fd = (int)(intptr_t)arg;
+	char buf[THROUGHPUT_CHUNK];
+
+	while (recv(fd, buf, sizeof(buf), 0) > 0) {
+	}
+	return NULL;
+}
+
+static void *echo_thread(void *arg)
+{
+	int fd = (int)(intptr_t)arg;
+	char buf[LATENCY_MSGLEN];
+	int i;
+
+	for (i = 0; i < LATENCY_ROUNDS; i++) {
+		if (recv_all(fd, buf, LATENCY_MSGLEN) <= 0) {
+			break;
+		}
+		if (send(fd, buf, LATENCY_MSGLEN, 0) != LATENCY_MSGLEN) {
+			break;
+		}
+	}
+	return NULL;
+}
+
+/* Stream bytes into a sink task and report the rate once it has seen EOF */
+
+static void bench_throughput(const char *name, int cfd, int sfd)
+{
+	struct timespec start;
+	struct timespec end;
+	pthread_t tid;
+	int sent = 0;
+
+	if (pthread_create(&tid, NULL, sink_thread, (void *)(intptr_t)sfd) != 0) {
+		printf("%s: pthread_create failed\n", name);
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (sent < THROUGHPUT_BYTES) {
+		if (send(cfd, g_buf, THROUGHPUT_CHUNK, 0) != THROUGHPUT_CHUNK) {
+			break;
+		}
+		sent += THROUGHPUT_CHUNK;
+	}
+	shutdown(cfd, SHUT_WR);
+	pthread_join(tid, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printf("%-16s throughput %10.1f KB/s (%d bytes in %d byte writes)\n", name, sent / 1024.0 / elapsed(&start, &end), sent, THROUGHPUT_CHUNK);
+}
+
+/* Bounce a message off an echo task and report the average round trip */
+
+static void bench_latency(const char *name, int cfd, int sfd)
+{
+	struct timespec start;
+	struct timespec end;
+	pthread_t tid;
+	char buf[LATENCY_MSGLEN];
+	int i;
+
+	memset(buf, 0x5a, sizeof(buf));
+	if (pthread_create(&tid, NULL, echo_thread, (void *)(intptr_t)sfd) != 0) {
+		printf("%s: pthread_create failed\n", name);
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LATENCY_ROUNDS; i++) {
+		if (send(cfd, buf, LATENCY_MSGLEN, 0) != LATENCY_MSGLEN) {
+			break;
+		}
+		if (recv_all(cfd, buf, LATENCY_MSGLEN) <= 0) {
+			break;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	pthread_join(tid, NULL);
+
+	printf("%-16s round trip %10.2f us (%d of %d rounds, %d bytes)\n", name, elapsed(&start, &end) * 1.0e6 / (i > 0 ? i : 1), i, LATENCY_ROUNDS, LATENCY_MSGLEN);
+}
+
+static void bench_stream(const char *name, int domain)
+{
+	int cfd;
+	int sfd;
+
+	if (stream_pair(domain, &cfd, &sfd) < 0) {
+		printf("%s: cannot connect\n", name);
+		return;
+	}
+	bench_latency(name, cfd, sfd);
+	bench_throughput(name, cfd, sfd);
+	close(cfd);
+	close(sfd);
+}
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int local_socket_main(int argc, char *argv[])
+#endif
+{
+	int cfd;
+	int sfd;
+
+	printf("Local Socket Performance Measurement\n");
+
+	bench_stream("unix stream", AF_UNIX);
+
+	if (dgram_pair(&cfd, &sfd) < 0) {
+		printf("unix dgram: cannot connect\n");
+	} else {
+		bench_latency("unix dgram", cfd, sfd);
+		close(cfd);
+		close(sfd);
+	}
+
+	bench_stream("tcp loopback", AF_INET);
+
+	return 0;
+}
@@ -28,6 +28,7 @@
 #include <sys/ioctl.h>
 #include <sys/types.h>
 #include <fcntl.h>
+#include <pthread.h>
 
 #define NUM_LOOPS	1000000
 #define SEC_10	10
@@ -173,6 +174,37 @@ static void syscall_perf_timer_settime(void)
 	measure_performance(timer_settime, 4, timer_id, 0, NULL, NULL);
 }
 
+static void mutex_lock_unlock(pthread_mutex_t *mutex)
+{
+	pthread_mutex_lock(mutex);
+	pthread_mutex_unlock(mutex);
+}
+
+/*
+ * @fn                   :syscall_perf_pthread_mutex
+ * @description          :Measuring performance for an uncontended
+ *                        pthread_mutex_lock/pthread_mutex_unlock pair.
+ *                        With CONFIG_PTHREAD_MUTEX_USERFAST no system
+ *                        call is made at all.
+ * @return               :void
+ */
+static void syscall_perf_pthread_mutex(void)
+{
+	pthread_mutex_t mutex;
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+#ifdef CONFIG_PTHREAD_MUTEX_BOTH
+	pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_STALLED);
+#endif
+	pthread_mutex_init(&mutex, &attr);
+
+	measure_performance(mutex_lock_unlock, 1, &mutex);
+
+	pthread_mutex_destroy(&mutex);
+	pthread_mutexattr_destroy(&attr);
+}
+
 /****************************************************************************
  * Name: Syscall Performance
  ****************************************************************************/
@@ -188,6 +220,11 @@ int syscall_performance_main(void)
 	syscall_perf_unsetenv();
 	sched_unlock();
 
+	/* System Call 1 (pthread_mutex_lock + pthread_mutex_unlock) */
+	sched_lock();
+	syscall_perf_pthread_mutex();
+	sched_unlock();
+
 	/* System Call 2 */
 	sched_lock();
 	syscall_perf_clock_getres();
@@ -245,20 +245,22 @@ static int myrand(void *rng_state, unsigned char *output, size_t len)
 }
 
 /*
- * Clear some memory that was used to prepare the context
+ * Clear some memory that was used to prepare the context.
+ * A table with T_size == 0 is a static one (MBEDTLS_ECP_FIXED_POINT_STATIC),
+ * it stays in place.
  */
 #if defined(MBEDTLS_ECP_C)
 void ecp_clear_precomputed(mbedtls_ecp_group *grp)
 {
-	if (grp->T != NULL) {
+	if (grp->T != NULL && grp->T_size != 0) {
 		size_t i;
 		for (i = 0; i < grp->T_size; i++) {
 			mbedtls_ecp_point_free(&grp->T[i]);
 		}
 		mbedtls_free(grp->T);
+		grp->T = NULL;
+		grp->T_size = 0;
 	}
-	grp->T = NULL;
-	grp->T_size = 0;
 }
 #else
 #define ecp_clear_precomputed(g)
@@ -754,6 +756,34 @@ pthread_addr_t tls_benchmark_cb(void *args)
 			mbedtls_ecdh_free(&ecdh);
 		}
 
+		/*
+		 * A TLS handshake starts from a freshly loaded group, so the comb
+		 * table for the generator is built again on every handshake unless
+		 * it is precomputed (MBEDTLS_ECP_FIXED_POINT_STATIC).
+		 */
+		for (curve_info = mbedtls_ecp_curve_list();
+			 curve_info->grp_id != MBEDTLS_ECP_DP_NONE;
+			 curve_info++) {
+			mbedtls_ecdh_init(&ecdh);
+
+			if (mbedtls_ecp_group_load(&ecdh.grp, curve_info->grp_id) != 0 ||
+				mbedtls_ecdh_make_public(&ecdh, &olen, buf, sizeof(buf),
+										 myrand, NULL) != 0 ||
+				mbedtls_ecp_copy(&ecdh.Qp, &ecdh.Q) != 0) {
+				mbedtls_exit(1);
+			}
+
+			mbedtls_snprintf(title, sizeof(title), "ECDHE-%s new",
+							 curve_info->name);
+			TIME_PUBLIC(title, "handshake",
+						ret |= mbedtls_ecp_group_load(&ecdh.grp, curve_info->grp_id);
+						ret |= mbedtls_ecdh_make_public(&ecdh, &olen, buf, sizeof(buf),
+								myrand, NULL);
+						ret |= mbedtls_ecdh_calc_secret(&ecdh, &olen, buf, sizeof(buf),
+								myrand, NULL));
+			mbedtls_ecdh_free(&ecdh);
+		}
+
 		/* Curve25519 needs to be handled separately */
 #if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
 		mbedtls_ecdh_init(&ecdh);
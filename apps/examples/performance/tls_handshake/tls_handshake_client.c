@@ -26,15 +26,30 @@
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/error.h"
 #include "mbedtls/certs.h"
+#ifdef CONFIG_TLS_SESSION_CACHE
+#include "mbedtls/tls_session_cache.h"
+#endif
 
+#include <stdlib.h>
 #include <string.h>
 
 #define SERVER_PORT "4433"
+#define SERVER_PORT_NUM 4433
 static char *SERVER_ADDR = NULL;
 #define GET_REQUEST "GET / HTTP/1.0\r\n\r\n"
 
 #define DEBUG_LEVEL 0
 
+/* The first handshake is a full one, the rest try to resume it */
+
+#define DEFAULT_ROUNDS 5
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#define TLS_HS_CLOCK CLOCK_MONOTONIC
+#else
+#define TLS_HS_CLOCK CLOCK_REALTIME
+#endif
+
 #define mbedtls_printf printf
 
 static void my_debug(void *ctx, int level,
@@ -66,20 +81,143 @@ static unsigned char rootca[] =
 
 static int rootca_len = sizeof(rootca);
 
-int tls_handshake_client(char *ipaddr)
+static unsigned int elapsed_msec(struct timespec *start, struct timespec *end)
+{
+	return (unsigned int)((end->tv_sec - start->tv_sec) * 1000 + (end->tv_nsec - start->tv_nsec) / 1000000);
+}
+
+/*
+ * Connect, handshake, send the GET request and read the response.
+ * 'session' holds the session to offer when the shared session cache is not
+ * configured. On return *resumed tells whether the server resumed the
+ * session and *msec how long the handshake took.
+ */
+
+static int tls_handshake_round(mbedtls_ssl_config *conf, mbedtls_ssl_session *session, int *resumed, unsigned int *msec)
 {
 	mbedtls_net_context server_fd;
-	uint32_t flags;
+	mbedtls_ssl_context ssl;
 	unsigned char buf[1024];
+	struct timespec start;
+	struct timespec end;
+	uint32_t flags;
+	int len;
+	int ret;
+#ifdef CONFIG_TLS_SESSION_CACHE
+	struct tls_session_cache_stats before;
+	struct tls_session_cache_stats after;
+#endif
+
+	mbedtls_net_init(&server_fd);
+	mbedtls_ssl_init(&ssl);
+
+	if ((ret = mbedtls_net_connect(&server_fd, SERVER_ADDR,
+								   SERVER_PORT, MBEDTLS_NET_PROTO_TCP)) != 0) {
+		mbedtls_printf(" failed\n	 ! mbedtls_net_connect returned %d\n\n", ret);
+		goto exit;
+	}
+
+	if ((ret = mbedtls_ssl_setup(&ssl, conf)) != 0) {
+		mbedtls_printf(" failed\n	 ! mbedtls_ssl_setup returned %d\n\n", ret);
+		goto exit;
+	}
+
+	mbedtls_ssl_set_bio(&ssl, &server_fd, mbedtls_net_send, mbedtls_net_recv, NULL);
+
+#ifdef CONFIG_TLS_SESSION_CACHE
+	tls_session_cache_stats(&before);
+	tls_session_cache_load(&ssl, SERVER_ADDR, SERVER_PORT_NUM);
+#else
+	if (session->id_len > 0
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+		|| session->ticket_len > 0
+#endif
+	   ) {
+		mbedtls_ssl_set_session(&ssl, session);
+	}
+#endif
+
+	clock_gettime(TLS_HS_CLOCK, &start);
+	while ((ret = mbedtls_ssl_handshake(&ssl)) != 0) {
+		if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+			mbedtls_printf(" failed\n	 ! mbedtls_ssl_handshake returned -0x%x\n\n", (unsigned int)-ret);
+#ifdef CONFIG_TLS_SESSION_CACHE
+			tls_session_cache_remove(SERVER_ADDR, SERVER_PORT_NUM);
+#endif
+			goto exit;
+		}
+	}
+	clock_gettime(TLS_HS_CLOCK, &end);
+	*msec = elapsed_msec(&start, &end);
+
+#ifdef CONFIG_TLS_SESSION_CACHE
+	tls_session_cache_save(&ssl, SERVER_ADDR, SERVER_PORT_NUM);
+	tls_session_cache_stats(&after);
+	*resumed = (after.resumed != before.resumed);
+#else
+	*resumed = (session->id_len > 0 && memcmp(session->master, ssl.session->master, sizeof(session->master)) == 0);
+	mbedtls_ssl_session_free(session);
+	mbedtls_ssl_session_init(session);
+	mbedtls_ssl_get_session(&ssl, session);
+#endif
+
+	/* In real life, we probably want to bail out when flags != 0 */
+	if ((flags = mbedtls_ssl_get_verify_result(&ssl)) != 0) {
+		char vrfy_buf[512];
+
+		mbedtls_x509_crt_verify_info(vrfy_buf, sizeof(vrfy_buf), "	! ", flags);
+		mbedtls_printf("%s\n", vrfy_buf);
+	}
+
+	len = sprintf((char *)buf, GET_REQUEST);
+
+	while ((ret = mbedtls_ssl_write(&ssl, buf, len)) <= 0) {
+		if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+			mbedtls_printf(" failed\n	 ! mbedtls_ssl_write returned %d\n\n", ret);
+			goto exit;
+		}
+	}
+
+	do {
+		ret = mbedtls_ssl_read(&ssl, buf, sizeof(buf));
+
+		if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
+			continue;
+		}
+		if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY || ret == 0) {
+			ret = 0;
+			break;
+		}
+		if (ret < 0) {
+			mbedtls_printf("failed\n	! mbedtls_ssl_read returned %d\n\n", ret);
+			break;
+		}
+	} while (1);
+
+	mbedtls_ssl_close_notify(&ssl);
+
+exit:
+	mbedtls_net_free(&server_fd);
+	mbedtls_ssl_free(&ssl);
+
+	return ret;
+}
+
+int tls_handshake_client(char *ipaddr, int rounds)
+{
 	const char *pers = "ssl_client1";
 
 	mbedtls_entropy_context entropy;
 	mbedtls_ctr_drbg_context ctr_drbg;
-	mbedtls_ssl_context ssl;
 	mbedtls_ssl_config conf;
 	mbedtls_x509_crt cacert;
+	mbedtls_ssl_session session;
+	unsigned int full_msec = 0;
+	unsigned int resumed_msec = 0;
+	int nfull = 0;
+	int nresumed = 0;
 	int ret = 1;
-	int len = 0;
+	int i;
 	struct timespec ts;
 	SERVER_ADDR = ipaddr;
 	ts.tv_sec = 1633074152; // 2021-10-01
@@ -87,6 +225,10 @@ int tls_handshake_client(char *ipaddr)
 
 	clock_settime(CLOCK_REALTIME, &ts);
 
+	if (rounds <= 0) {
+		rounds = DEFAULT_ROUNDS;
+	}
+
 #if defined(MBEDTLS_DEBUG_C)
 	mbedtls_debug_set_threshold(DEBUG_LEVEL);
 #endif
@@ -94,11 +236,10 @@ int tls_handshake_client(char *ipaddr)
 	/*
 	 * 0. Initialize the RNG and the session data
 	 */
-	mbedtls_net_init(&server_fd);
-	mbedtls_ssl_init(&ssl);
 	mbedtls_ssl_config_init(&conf);
 	mbedtls_x509_crt_init(&cacert);
 	mbedtls_ctr_drbg_init(&ctr_drbg);
+	mbedtls_ssl_session_init(&session);
 
 	mbedtls_printf("\n	. Seeding the random number generator...");
 	fflush(stdout);
@@ -114,8 +255,8 @@ int tls_handshake_client(char *ipaddr)
 	mbedtls_printf(" ok\n");
 
 	/*
-		 * 0. Initialize certificates
-		 */
+	 * 1. Initialize certificates
+	 */
 	mbedtls_printf("	. Loading the CA root certificate ...");
 	fflush(stdout);
 
@@ -129,22 +270,8 @@ int tls_handshake_client(char *ipaddr)
 	mbedtls_printf(" ok (%d skipped)\n", ret);
 
 	/*
-		 * 1. Start the connection
-		 */
-	mbedtls_printf("	. Connecting to tcp/%s/%s...", SERVER_ADDR, SERVER_PORT);
-	fflush(stdout);
-
-	if ((ret = mbedtls_net_connect(&server_fd, SERVER_ADDR,
-								   SERVER_PORT, MBEDTLS_NET_PROTO_TCP)) != 0) {
-		mbedtls_printf(" failed\n	 ! mbedtls_net_connect returned %d\n\n", ret);
-		goto exit;
-	}
-
-	mbedtls_printf(" ok\n");
-
-	/*
-		 * 2. Setup stuff
-		 */
+	 * 2. Setup stuff
+	 */
 	mbedtls_printf("	. Setting up the SSL/TLS structure...");
 	fflush(stdout);
 
@@ -158,117 +285,59 @@ int tls_handshake_client(char *ipaddr)
 
 	mbedtls_printf(" ok\n");
 
-	/* OPTIONAL is not optimal for security,
-		 * but makes interop easier in this simplified example */
 	mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_REQUIRED);
 	mbedtls_ssl_conf_ca_chain(&conf, &cacert, NULL);
 	mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &ctr_drbg);
 	mbedtls_ssl_conf_dbg(&conf, my_debug, stdout);
 
-	if ((ret = mbedtls_ssl_setup(&ssl, &conf)) != 0) {
-		mbedtls_printf(" failed\n	 ! mbedtls_ssl_setup returned %d\n\n", ret);
-		goto exit;
-	}
-
-	mbedtls_ssl_set_bio(&ssl, &server_fd, mbedtls_net_send, mbedtls_net_recv, NULL);
-
 	/*
-		 * 4. Handshake
-		 */
-	mbedtls_printf("	. Performing the SSL/TLS handshake...");
-	fflush(stdout);
+	 * 3. Handshake with tcp/SERVER_ADDR/SERVER_PORT 'rounds' times
+	 */
+	mbedtls_printf("	. Performing %d SSL/TLS handshakes with tcp/%s/%s\n", rounds, SERVER_ADDR, SERVER_PORT);
 
-	while ((ret = mbedtls_ssl_handshake(&ssl)) != 0) {
-		if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-			mbedtls_printf(" failed\n	 ! mbedtls_ssl_handshake returned -0x%x\n\n", (unsigned int)-ret);
+	for (i = 0; i < rounds; i++) {
+		unsigned int msec = 0;
+		int resumed = 0;
+
+		if ((ret = tls_handshake_round(&conf, &session, &resumed, &msec)) != 0) {
 			goto exit;
 		}
-	}
-
-	mbedtls_printf(" ok\n");
-
-	/*
-		 * 5. Verify the server certificate
-		 */
-	mbedtls_printf("	. Verifying peer X.509 certificate...");
-
-	/* In real life, we probably want to bail out when ret != 0 */
-	if ((flags = mbedtls_ssl_get_verify_result(&ssl)) != 0) {
-		char vrfy_buf[512];
 
-		mbedtls_printf(" failed\n");
-
-		mbedtls_x509_crt_verify_info(vrfy_buf, sizeof(vrfy_buf), "	! ", flags);
-
-		mbedtls_printf("%s\n", vrfy_buf);
-	} else
-		mbedtls_printf(" ok\n");
-
-	/*
-		 * 3. Write the GET request
-		 */
-	mbedtls_printf("	> Write to server:");
-	fflush(stdout);
-
-	len = sprintf((char *)buf, GET_REQUEST);
-
-	while ((ret = mbedtls_ssl_write(&ssl, buf, len)) <= 0) {
-		if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-			mbedtls_printf(" failed\n	 ! mbedtls_ssl_write returned %d\n\n", ret);
-			goto exit;
+		mbedtls_printf("	  [%d] %s handshake: %u ms\n", i, resumed ? "resumed" : "full", msec);
+		if (resumed) {
+			nresumed++;
+			resumed_msec += msec;
+		} else {
+			nfull++;
+			full_msec += msec;
 		}
 	}
 
-	len = ret;
-	mbedtls_printf(" %d bytes written\n\n%s", len, (char *)buf);
-
-	/*
-		 * 7. Read the HTTP response
-		 */
-	mbedtls_printf("	< Read from server:");
-	fflush(stdout);
+	mbedtls_printf("\n	full    : %d handshakes, avg %u ms\n", nfull, nfull ? full_msec / nfull : 0);
+	mbedtls_printf("	resumed : %d handshakes, avg %u ms\n", nresumed, nresumed ? resumed_msec / nresumed : 0);
 
-	do {
-		len = sizeof(buf) - 1;
-		memset(buf, 0, sizeof(buf));
-		ret = mbedtls_ssl_read(&ssl, buf, len);
+#ifdef CONFIG_TLS_SESSION_CACHE
+	{
+		struct tls_session_cache_stats stats;
 
-		if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
-			continue;
-		}
-		if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
-			ret = 0;
-			break;
-		}
-		if (ret < 0) {
-			mbedtls_printf("failed\n	! mbedtls_ssl_read returned %d\n\n", ret);
-			break;
-		}
-		if (ret == 0) {
-			mbedtls_printf("\n\nEOF\n\n");
-			break;
-		}
-
-		len = ret;
-		mbedtls_printf(" %d bytes read\n\n%s", len, (char *)buf);
-	} while (1);
-
-	mbedtls_ssl_close_notify(&ssl);
+		tls_session_cache_stats(&stats);
+		mbedtls_printf("	session cache: lookups %lu hits %lu resumed %lu full %lu evictions %lu\n",
+					   stats.lookups, stats.hits, stats.resumed, stats.full, stats.evictions);
+	}
+#endif
 
 exit:
 
 #ifdef MBEDTLS_ERROR_C
-	if (ret != -1) {
+	if (ret != 0) {
 		char error_buf[100];
 		mbedtls_strerror(ret, error_buf, 100);
 		mbedtls_printf("Last error was: %d - %s\n\n", ret, error_buf);
 	}
 #endif
 
-	mbedtls_net_free(&server_fd);
-
+	mbedtls_ssl_session_free(&session);
 	mbedtls_x509_crt_free(&cacert);
-	mbedtls_ssl_free(&ssl);
 	mbedtls_ssl_config_free(&conf);
 	mbedtls_ctr_drbg_free(&ctr_drbg);
 	mbedtls_entropy_free(&entropy);
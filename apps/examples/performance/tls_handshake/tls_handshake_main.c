@@ -25,15 +25,15 @@
 #include "tls_handshake_usage.h"
 
 extern int tls_handshake_server(void);
-extern int tls_handshake_client(char *ipaddr);
+extern int tls_handshake_client(char *ipaddr, int rounds);
 
 int tls_handshake_main(int argc, char **argv)
 {
 	if (argc == 2 && !strncmp("-s", argv[1], 3)) {
 		tls_handshake_server();
 		return 0;
-	} else if (argc == 3 && !strncmp("-c", argv[1], 3)) {
-		tls_handshake_client(argv[2]);
+	} else if ((argc == 3 || argc == 4) && !strncmp("-c", argv[1], 3)) {
+		tls_handshake_client(argv[2], argc == 4 ? atoi(argv[3]) : 0);
 		return 0;
 	}
 
@@ -91,6 +91,10 @@ int main(void)
 #include "mbedtls/ssl_cache.h"
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include "mbedtls/ssl_ticket.h"
+#endif
+
 #define HTTP_RESPONSE                                    \
 	"HTTP/1.0 200 OK\r\nContent-Type: text/html\r\n\r\n" \
 	"<h2>mbed TLS Test Server</h2>\r\n"                  \
@@ -187,6 +191,9 @@ int tls_handshake_server(void)
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_context cache;
 #endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_context ticket;
+#endif
 
 	mbedtls_net_init(&listen_fd);
 	mbedtls_net_init(&client_fd);
@@ -194,6 +201,9 @@ int tls_handshake_server(void)
 	mbedtls_ssl_config_init(&conf);
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_init(&cache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&ticket);
 #endif
 	mbedtls_x509_crt_init(&srvcert);
 	mbedtls_pk_init(&pkey);
@@ -296,6 +306,17 @@ int tls_handshake_server(void)
 								   mbedtls_ssl_cache_set);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* Issue RFC 5077 tickets so that clients can resume statelessly */
+	if ((ret = mbedtls_ssl_ticket_setup(&ticket, mbedtls_ctr_drbg_random, &ctr_drbg,
+										MBEDTLS_CIPHER_AES_256_GCM, 86400)) != 0) {
+		mbedtls_printf(" failed\n  ! mbedtls_ssl_ticket_setup returned %d\n\n", ret);
+		goto exit;
+	}
+	mbedtls_ssl_conf_session_tickets_cb(&conf, mbedtls_ssl_ticket_write,
+										mbedtls_ssl_ticket_parse, &ticket);
+#endif
+
 	mbedtls_ssl_conf_ca_chain(&conf, srvcert.next, NULL);
 	if ((ret = mbedtls_ssl_conf_own_cert(&conf, &srvcert, &pkey)) != 0) {
 		mbedtls_printf(" failed\n  ! mbedtls_ssl_conf_own_cert returned %d\n\n", ret);
@@ -481,6 +502,9 @@ exit:
 	mbedtls_ssl_config_free(&conf);
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_free(&cache);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_free(&ticket);
 #endif
 	mbedtls_ctr_drbg_free(&ctr_drbg);
 	mbedtls_entropy_free(&entropy);
@@ -70,11 +70,10 @@ static void tc_libc_semaphore_sem_init(void)
 	sem_flag = FLAGS_INITIALIZED;
 	sem_flag &= ~(PRIOINHERIT_FLAGS_DISABLE);
 	TC_ASSERT_EQ("sem_init", sem.flags, sem_flag);
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-	TC_ASSERT_EQ("sem_init", sem.hhead, NULL);
-#else
 	TC_ASSERT_EQ("sem_init", sem.holder.htcb, NULL);
 	TC_ASSERT_EQ("sem_init", sem.holder.counts, 0);
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+	TC_ASSERT_EQ("sem_init", sem.hhead, NULL);
 #endif
 #endif
 
@@ -59,6 +59,9 @@
 #include "connect.h" /* for the connect timeout */
 #include "select.h"
 #include "polarssl_threadlock.h"
+#ifdef CONFIG_TLS_SESSION_CACHE
+#include <mbedtls/tls_session_cache.h>
+#endif
 
 /* The last 3 #include files should be in this order */
 #include "curl_printf.h"
@@ -448,7 +451,7 @@ mbed_connect_step1(struct connectdata *conn,
                                  MBEDTLS_SSL_RENEGOTIATION_ENABLED);
 #endif
 
-#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && !defined(CONFIG_TLS_SESSION_CACHE)
   mbedtls_ssl_conf_session_tickets(&BACKEND->config,
                                    MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
 #endif
@@ -467,6 +470,12 @@ mbed_connect_step1(struct connectdata *conn,
       }
       infof(data, "mbedTLS re-using session\n");
     }
+#ifdef CONFIG_TLS_SESSION_CACHE
+    /* Not known to this handle, but maybe to another TLS client */
+    else if(!tls_session_cache_load(&BACKEND->ssl, hostname,
+                                    (unsigned short)port))
+      infof(data, "mbedTLS re-using shared session\n");
+#endif
     Curl_ssl_sessionid_unlock(conn);
   }
 
@@ -572,6 +581,12 @@ mbed_connect_step2(struct connectdata *conn,
 #endif /* MBEDTLS_ERROR_C */
     failf(data, "ssl_handshake returned - mbedTLS: (-0x%04X) %s",
           -ret, errorbuf);
+#ifdef CONFIG_TLS_SESSION_CACHE
+    tls_session_cache_remove(SSL_IS_PROXY() ? conn->http_proxy.host.name :
+                             conn->host.name,
+                             (unsigned short)(SSL_IS_PROXY() ? conn->port :
+                                              conn->remote_port));
+#endif
     return CURLE_SSL_CONNECT_ERROR;
   }
 
@@ -733,6 +748,13 @@ mbed_connect_step3(struct connectdata *conn,
 
     retcode = Curl_ssl_addsessionid(conn, our_ssl_sessionid, 0, sockindex);
     Curl_ssl_sessionid_unlock(conn);
+#ifdef CONFIG_TLS_SESSION_CACHE
+    tls_session_cache_save(&BACKEND->ssl,
+                           SSL_IS_PROXY() ? conn->http_proxy.host.name :
+                           conn->host.name,
+                           (unsigned short)(SSL_IS_PROXY() ? conn->port :
+                                            conn->remote_port));
+#endif
     if(retcode) {
       free(our_ssl_sessionid);
       failf(data, "failed to store ssl session");
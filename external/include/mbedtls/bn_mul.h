@@ -597,7 +597,31 @@
 #define MULADDC_CANNOT_USE_R7
 #endif
 
-#if defined(__arm__) && !defined(MULADDC_CANNOT_USE_R7)
+#if defined(__arm__) && defined(MBEDTLS_BIGNUM_ARM_UMAAL) && \
+    defined(__ARM_FEATURE_DSP) && ( __ARM_FEATURE_DSP == 1 )
+
+/*
+ * Cores with the DSP extension (Cortex-M4, M7, M33): UMAAL does the
+ * multiplication, the accumulation and the carry of one limb at once.
+ * It does not need r7 either, so it is also usable without __OPTIMIZE__.
+ */
+
+#define MULADDC_INIT                                    \
+    asm(
+
+#define MULADDC_CORE                                    \
+            "ldr    r0, [%0], #4                \n\t"   \
+            "ldr    r1, [%1]                    \n\t"   \
+            "umaal  r1, %2, %3, r0              \n\t"   \
+            "str    r1, [%1], #4                \n\t"
+
+#define MULADDC_STOP                                    \
+         : "=r" (s),  "=r" (d), "=r" (c)        \
+         : "r" (b), "0" (s), "1" (d), "2" (c)   \
+         : "r0", "r1", "memory"                 \
+         );
+
+#elif defined(__arm__) && !defined(MULADDC_CANNOT_USE_R7)
 
 #if defined(__thumb__) && !defined(__thumb2__)
 
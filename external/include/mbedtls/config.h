@@ -2804,6 +2804,26 @@
 #define MBEDTLS_ECP_WINDOW_SIZE            7 /**< Maximum window size used */
 #define MBEDTLS_ECP_FIXED_POINT_OPTIM      1 /**< Enable fixed-point speed-up */
 
+/**
+ * \def MBEDTLS_ECP_FIXED_POINT_STATIC
+ *
+ * Use the comb tables of ecp_comb_tables.h (secp256r1) for multiplications
+ * by the generator instead of computing them on first use in RAM.
+ * Requires MBEDTLS_ECP_FIXED_POINT_OPTIM and MBEDTLS_ECP_WINDOW_SIZE >= 5.
+ *
+ * \def MBEDTLS_BIGNUM_ARM_UMAAL
+ *
+ * Use UMAAL for the bignum multiply-accumulate on ARM cores with the DSP
+ * extension (Cortex-M4/M7/M33). Ignored by compilers which do not define
+ * __ARM_FEATURE_DSP.
+ */
+#if defined(CONFIG_TLS_ECP_STATIC_COMB)
+#define MBEDTLS_ECP_FIXED_POINT_STATIC
+#endif
+#if defined(CONFIG_TLS_BIGNUM_ARM_UMAAL)
+#define MBEDTLS_BIGNUM_ARM_UMAAL
+#endif
+
 /* Entropy options */
 //#define MBEDTLS_ENTROPY_MAX_SOURCES                20 /**< Maximum number of sources supported */
 //#define MBEDTLS_ENTROPY_MAX_GATHER                128 /**< Maximum amount requested from entropy sources */
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __TLS_SESSION_CACHE_H
+#define __TLS_SESSION_CACHE_H
+
+#include <tinyara/config.h>
+
+#include "mbedtls/config.h"
+#include "mbedtls/ssl.h"
+
+#ifdef CONFIG_TLS_SESSION_CACHE
+
+/* Resumption counters, see tls_session_cache_stats() */
+
+struct tls_session_cache_stats {
+	unsigned long lookups;		/* tls_session_cache_load() calls */
+	unsigned long hits;			/* ... which offered a cached session */
+	unsigned long resumed;		/* Handshakes the server resumed */
+	unsigned long full;			/* Handshakes with a full key exchange */
+	unsigned long evictions;	/* Live entries dropped to make room */
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Offer a cached session for host:port to a client connection.
+ *
+ * Call after mbedtls_ssl_setup() and before the handshake. The session
+ * ID and, if the server issued one, the RFC 5077 ticket are offered; the
+ * server decides whether to resume.
+ *
+ * @param[in] ssl  client context
+ * @param[in] host server name, as passed to mbedtls_ssl_set_hostname()
+ * @param[in] port server port
+ * @return 0 if a session was offered, -1 if none is cached
+ * @since TizenRT v3.1
+ */
+int tls_session_cache_load(mbedtls_ssl_context *ssl, const char *host, unsigned short port);
+
+/**
+ * @brief Store the session of a completed handshake.
+ *
+ * Call after mbedtls_ssl_handshake() returned 0. Also updates the
+ * resumed/full counters.
+ *
+ * @param[in] ssl  client context
+ * @param[in] host server name
+ * @param[in] port server port
+ * @since TizenRT v3.1
+ */
+void tls_session_cache_save(const mbedtls_ssl_context *ssl, const char *host, unsigned short port);
+
+/**
+ * @brief Forget the session cached for host:port.
+ *
+ * Call when a handshake that was offered a cached session failed.
+ *
+ * @param[in] host server name
+ * @param[in] port server port
+ * @since TizenRT v3.1
+ */
+void tls_session_cache_remove(const char *host, unsigned short port);
+
+/**
+ * @brief Drop every cached session.
+ * @since TizenRT v3.1
+ */
+void tls_session_cache_flush(void);
+
+/**
+ * @brief Read the resumption counters.
+ *
+ * @param[out] stats counters since boot
+ * @since TizenRT v3.1
+ */
+void tls_session_cache_stats(struct tls_session_cache_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_TLS_SESSION_CACHE */
+#endif /* __TLS_SESSION_CACHE_H */
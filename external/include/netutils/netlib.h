@@ -155,6 +155,10 @@ void netlib_freeifaddrs(struct ifaddrs *ifa);
 #ifdef CONFIG_NET_NETMON
 int netlib_netmon_sock(void *arg);
 int netlib_netmon_devstats(const char *ifname, void **arg);
+#ifdef CONFIG_NET_TCP_PCB_STATS
+struct netmon_tcp_stats;
+int netlib_netmon_tcpstats(struct netmon_tcp_stats *stats, int max);
+#endif
 #endif
 
 /* HTTP support */
@@ -567,6 +567,38 @@ static const mbedtls_mpi_uint brainpoolP512r1_n[] = {
 };
 #endif /* MBEDTLS_ECP_DP_BP512R1_ENABLED */
 
+#if defined(MBEDTLS_ECP_FIXED_POINT_STATIC)
+/*
+ * Precomputed comb tables for the generators, in read-only memory.
+ * A group with T set and T_size == 0 uses such a table; it is never
+ * freed or modified.
+ */
+static const mbedtls_mpi_uint ecp_comb_one[] = { 1 };
+
+#define ECP_MPI_INIT( p, n )            { 1, ( n ), (mbedtls_mpi_uint *)( p ) }
+#define ECP_MPI_INIT_ARRAY( x )         ECP_MPI_INIT( x, sizeof( x ) / sizeof( mbedtls_mpi_uint ) )
+#define ECP_POINT_INIT_XY_Z1( x, y )    { ECP_MPI_INIT_ARRAY( x ), ECP_MPI_INIT_ARRAY( y ), \
+                                          ECP_MPI_INIT( ecp_comb_one, 1 ) }
+
+#include "ecp_comb_tables.h"
+
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM != 1
+#error "MBEDTLS_ECP_FIXED_POINT_STATIC requires MBEDTLS_ECP_FIXED_POINT_OPTIM"
+#endif
+
+/* The tables were generated for the comb width ecp_mul_comb() picks for G */
+#if defined(SECP256R1_T_WINDOW) && MBEDTLS_ECP_WINDOW_SIZE < SECP256R1_T_WINDOW
+#error "MBEDTLS_ECP_FIXED_POINT_STATIC requires a larger MBEDTLS_ECP_WINDOW_SIZE"
+#endif
+
+#define ECP_STATIC_COMB( G )    do {                                    \
+                                    grp->T = (mbedtls_ecp_point *) G ## _T; \
+                                    grp->T_size = 0;                    \
+                                } while( 0 )
+#else
+#define ECP_STATIC_COMB( G )
+#endif /* MBEDTLS_ECP_FIXED_POINT_STATIC */
+
 /*
  * Create an MPI from embedded constants
  * (assumes len is an exact multiple of sizeof mbedtls_mpi_uint)
@@ -731,6 +763,7 @@ int mbedtls_ecp_group_load( mbedtls_ecp_group *grp, mbedtls_ecp_group_id id )
 #if defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
         case MBEDTLS_ECP_DP_SECP256R1:
             NIST_MODP( p256 );
+            ECP_STATIC_COMB( secp256r1 );
             return( LOAD_GROUP( secp256r1 ) );
 #endif /* MBEDTLS_ECP_DP_SECP256R1_ENABLED */
 
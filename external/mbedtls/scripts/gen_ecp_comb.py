@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+###########################################################################
+#
+# Copyright 2026 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Generate the fixed-base comb tables used with MBEDTLS_ECP_FIXED_POINT_STATIC.
+#
+#   scripts/gen_ecp_comb.py > ecp_comb_tables.h
+#
+# The tables hold exactly what ecp_precompute_comb() in ecp.c would compute
+# for P == G: with w the comb width picked by ecp_mul_comb() for the
+# generator and d = ceil(nbits / w),
+#
+#   T[i] = (1 + i_1 2^d + i_2 2^{2d} + ... + i_{w-1} 2^{(w-1)d}) G
+#
+# for i = i_{w-1} ... i_1, in affine coordinates.
+#
+# Montgomery curves (Curve25519) use the ladder, not the comb method, so
+# they have no table.
+
+import sys
+
+# name, bits of N, p, a, gx, gy, n
+CURVES = [
+    ('secp256r1', 'MBEDTLS_ECP_DP_SECP256R1_ENABLED',
+     0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF,
+     -3,
+     0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+     0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5,
+     0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551),
+]
+
+
+def comb_width(nbits):
+    # ecp_mul_comb(): one more than the default width when P == G
+    return (5 if nbits >= 384 else 4) + 1
+
+
+def point_add(p, a, P, Q):
+    if P is None:
+        return Q
+    if Q is None:
+        return P
+    if P[0] == Q[0]:
+        if (P[1] + Q[1]) % p == 0:
+            return None
+        l = (3 * P[0] * P[0] + a) * pow(2 * P[1], p - 2, p) % p
+    else:
+        l = (Q[1] - P[1]) * pow(Q[0] - P[0], p - 2, p) % p
+    x = (l * l - P[0] - Q[0]) % p
+    return (x, (l * (P[0] - x) - P[1]) % p)
+
+
+def point_mul(p, a, k, P):
+    R = None
+    while k:
+        if k & 1:
+            R = point_add(p, a, R, P)
+        P = point_add(p, a, P, P)
+        k >>= 1
+    return R
+
+
+def limbs(v, nbytes):
+    b = v.to_bytes(nbytes, 'little')
+    out = []
+    for i in range(0, nbytes, 8):
+        out.append('    BYTES_TO_T_UINT_8( %s ),' %
+                   ', '.join('0x%02X' % c for c in b[i:i + 8]))
+    return out
+
+
+def emit(out, name, guard, p, a, gx, gy, n):
+    nbits = n.bit_length()
+    nbytes = (p.bit_length() + 7) // 8
+    w = comb_width(nbits)
+    d = (nbits + w - 1) // w
+    count = 1 << (w - 1)
+
+    out.append('#if defined(%s)' % guard)
+    out.append('')
+    out.append('#define %s_T_WINDOW %d' % (name.upper(), w))
+    out.append('')
+    for i in range(count):
+        k = 1
+        for l in range(1, w):
+            if i & (1 << (l - 1)):
+                k += 1 << (l * d)
+        x, y = point_mul(p, a, k, (gx, gy))
+        out.append('static const mbedtls_mpi_uint %s_T_%d_X[] = {' % (name, i))
+        out += limbs(x, nbytes)
+        out.append('};')
+        out.append('static const mbedtls_mpi_uint %s_T_%d_Y[] = {' % (name, i))
+        out += limbs(y, nbytes)
+        out.append('};')
+    out.append('')
+    out.append('static const mbedtls_ecp_point %s_T[%d] = {' % (name, count))
+    for i in range(count):
+        out.append('    ECP_POINT_INIT_XY_Z1( %s_T_%d_X, %s_T_%d_Y ),' %
+                   (name, i, name, i))
+    out.append('};')
+    out.append('')
+    out.append('#endif /* %s */' % guard)
+    out.append('')
+
+
+def main():
+    out = [
+        '/*',
+        ' * Fixed-base comb tables for MBEDTLS_ECP_FIXED_POINT_STATIC',
+        ' *',
+        ' * Generated by scripts/gen_ecp_comb.py, do not edit.',
+        ' */',
+        '',
+    ]
+    for c in CURVES:
+        emit(out, *c)
+    sys.stdout.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,284 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Client side TLS session cache shared by every TLS user in the system.
+ *
+ * Sessions are keyed by server name and port. A cached session carries the
+ * session ID and, when the server issued one, the RFC 5077 ticket, so both
+ * stateful and stateless resumption are offered. The least recently used
+ * entry is replaced when the cache is full.
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "mbedtls/tls_session_cache.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TLS_SESSION_CACHE_SIZE    CONFIG_TLS_SESSION_CACHE_SIZE
+#define TLS_SESSION_CACHE_TIMEOUT CONFIG_TLS_SESSION_CACHE_TIMEOUT
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct tls_session_entry {
+	char *host;					/* NULL if the slot is free */
+	unsigned short port;
+	uint32_t expire;			/* tls_session_now() when the entry expires */
+	unsigned long used;			/* LRU stamp */
+	mbedtls_ssl_session session;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct tls_session_entry g_tls_sessions[TLS_SESSION_CACHE_SIZE];
+static struct tls_session_cache_stats g_tls_session_stats;
+static unsigned long g_tls_session_clock;
+static pthread_mutex_t g_tls_session_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Seconds on a clock that NTP does not step, when the board has one */
+
+static uint32_t tls_session_now(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint32_t)ts.tv_sec;
+}
+
+/* Wrap-safe: the entry has expired once now reaches its expiry */
+
+static bool tls_session_expired(struct tls_session_entry *entry, uint32_t now)
+{
+	return (int32_t)(entry->expire - now) <= 0;
+}
+
+static void tls_session_entry_free(struct tls_session_entry *entry)
+{
+	if (entry->host) {
+		free(entry->host);
+		entry->host = NULL;
+		mbedtls_ssl_session_free(&entry->session);
+	}
+}
+
+/* Find the live entry for host:port, dropping it if it has expired.
+ * Called with the lock held.
+ */
+
+static struct tls_session_entry *tls_session_find(const char *host, unsigned short port)
+{
+	int i;
+
+	for (i = 0; i < TLS_SESSION_CACHE_SIZE; i++) {
+		struct tls_session_entry *entry = &g_tls_sessions[i];
+
+		if (entry->host && entry->port == port && strcmp(entry->host, host) == 0) {
+			if (tls_session_expired(entry, tls_session_now())) {
+				tls_session_entry_free(entry);
+				return NULL;
+			}
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Pick the slot for a new entry: a free one, else the least recently used.
+ * Called with the lock held.
+ */
+
+static struct tls_session_entry *tls_session_victim(void)
+{
+	struct tls_session_entry *victim = &g_tls_sessions[0];
+	int i;
+
+	for (i = 0; i < TLS_SESSION_CACHE_SIZE; i++) {
+		struct tls_session_entry *entry = &g_tls_sessions[i];
+
+		if (entry->host == NULL) {
+			return entry;
+		}
+		if (entry->used < victim->used) {
+			victim = entry;
+		}
+	}
+
+	if (!tls_session_expired(victim, tls_session_now())) {
+		g_tls_session_stats.evictions++;
+	}
+	tls_session_entry_free(victim);
+	return victim;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int tls_session_cache_load(mbedtls_ssl_context *ssl, const char *host, unsigned short port)
+{
+	struct tls_session_entry *entry;
+	int ret = -1;
+
+	if (ssl == NULL || host == NULL) {
+		return -1;
+	}
+
+	pthread_mutex_lock(&g_tls_session_lock);
+	g_tls_session_stats.lookups++;
+
+	entry = tls_session_find(host, port);
+
+	/* A session whose certificate did not verify is only offered to a
+	 * connection that would have accepted it as well.
+	 */
+
+	if (entry && (entry->session.verify_result == 0 || ssl->conf->authmode != MBEDTLS_SSL_VERIFY_REQUIRED)) {
+		if (mbedtls_ssl_set_session(ssl, &entry->session) == 0) {
+			entry->used = ++g_tls_session_clock;
+			g_tls_session_stats.hits++;
+			ret = 0;
+		}
+	}
+
+	pthread_mutex_unlock(&g_tls_session_lock);
+	return ret;
+}
+
+void tls_session_cache_save(const mbedtls_ssl_context *ssl, const char *host, unsigned short port)
+{
+	struct tls_session_entry *entry;
+	time_t lifetime = TLS_SESSION_CACHE_TIMEOUT;
+
+	if (ssl == NULL || ssl->session == NULL || host == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_tls_session_lock);
+
+	/* The master secret only survives an abbreviated handshake */
+
+	entry = tls_session_find(host, port);
+	if (entry && memcmp(entry->session.master, ssl->session->master, sizeof(entry->session.master)) == 0) {
+		g_tls_session_stats.resumed++;
+	} else {
+		g_tls_session_stats.full++;
+	}
+
+	/* Nothing to resume with: neither an ID nor a ticket */
+
+	if (ssl->session->id_len == 0
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+		&& ssl->session->ticket_len == 0
+#endif
+	   ) {
+		goto out;
+	}
+
+	if (entry) {
+		tls_session_entry_free(entry);
+	} else {
+		entry = tls_session_victim();
+	}
+
+	entry->host = strdup(host);
+	if (entry->host == NULL) {
+		goto out;
+	}
+
+	mbedtls_ssl_session_init(&entry->session);
+	if (mbedtls_ssl_get_session(ssl, &entry->session) != 0) {
+		mbedtls_ssl_session_free(&entry->session);
+		free(entry->host);
+		entry->host = NULL;
+		goto out;
+	}
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+	if (entry->session.ticket_len > 0 && entry->session.ticket_lifetime > 0 && entry->session.ticket_lifetime < lifetime) {
+		lifetime = entry->session.ticket_lifetime;
+	}
+#endif
+
+	entry->port = port;
+	entry->expire = tls_session_now() + (uint32_t)lifetime;
+	entry->used = ++g_tls_session_clock;
+
+out:
+	pthread_mutex_unlock(&g_tls_session_lock);
+}
+
+void tls_session_cache_remove(const char *host, unsigned short port)
+{
+	struct tls_session_entry *entry;
+
+	if (host == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_tls_session_lock);
+	entry = tls_session_find(host, port);
+	if (entry) {
+		tls_session_entry_free(entry);
+	}
+	pthread_mutex_unlock(&g_tls_session_lock);
+}
+
+void tls_session_cache_flush(void)
+{
+	int i;
+
+	pthread_mutex_lock(&g_tls_session_lock);
+	for (i = 0; i < TLS_SESSION_CACHE_SIZE; i++) {
+		tls_session_entry_free(&g_tls_sessions[i]);
+	}
+	pthread_mutex_unlock(&g_tls_session_lock);
+}
+
+void tls_session_cache_stats(struct tls_session_cache_stats *stats)
+{
+	if (stats == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_tls_session_lock);
+	*stats = g_tls_session_stats;
+	pthread_mutex_unlock(&g_tls_session_lock);
+}
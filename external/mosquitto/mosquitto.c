@@ -971,7 +971,7 @@ int mosquitto_tls_set(struct mosquitto *mosq, const char *cafile, const char *ca
 	if (!mosq->ssl) {
 		return MOSQ_ERR_NOMEM;
 	}
-#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && !defined(CONFIG_TLS_SESSION_CACHE)
 	mbedtls_ssl_conf_session_tickets(mosq->ssl, 0);
 #endif
 	mbedtls_ssl_config_init(mosq->ssl);
@@ -62,6 +62,10 @@ Contributors:
 #	include <ares.h>
 #endif
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+#	include <sys/uio.h>
+#endif
+
 #ifdef WIN32
 #	if _MSC_VER < 1600
 typedef unsigned char uint8_t;
@@ -170,6 +174,21 @@ struct _mosquitto_packet {
 	int8_t remaining_count;
 };
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+#define MOSQ_ZC_IOV_MAX 4
+
+/* Segments received with recv_zerocopy() and not yet consumed. */
+struct _mosquitto_zc_in {
+	void *handle;
+	struct iovec iov[MOSQ_ZC_IOV_MAX];
+	int iovcnt;
+	int idx;
+	size_t off;
+	int8_t state;		/* 0: not set up yet, 1: enabled, -1: not supported */
+	bool borrowed;		/* in_packet.payload points into iov[] */
+};
+#endif
+
 struct mosquitto_message_all {
 	struct mosquitto_message_all *next;
 	time_t timestamp;
@@ -196,6 +215,9 @@ struct mosquitto {
 	time_t next_msg_out;
 	time_t ping_t;
 	struct _mosquitto_packet in_packet;
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+	struct _mosquitto_zc_in zc_in;
+#endif
 	struct _mosquitto_packet *current_out_packet;
 	struct _mosquitto_packet *out_packet;
 	struct mosquitto_message *will;
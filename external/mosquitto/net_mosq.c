@@ -74,6 +74,10 @@ Contributors:
 #	include <tls_mosq.h>
 #endif
 
+#if defined(WITH_MBEDTLS) && defined(CONFIG_TLS_SESSION_CACHE)
+#	include "mbedtls/tls_session_cache.h"
+#endif
+
 #ifdef WITH_BROKER
 #	include <mosquitto_broker.h>
 #	ifdef WITH_SYS_TREE
@@ -222,6 +226,138 @@ int _mosquitto_packet_queue(struct mosquitto *mosq, struct _mosquitto_packet *pa
 #endif
 }
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+/* Give the held segments back to the stack, which opens the receive
+ * window for them. Segments a borrowed payload points into are kept.
+ */
+static void _mosquitto_zc_release(struct mosquitto *mosq)
+{
+	struct _mosquitto_zc_in *zc = &mosq->zc_in;
+
+	if (zc->handle && !zc->borrowed) {
+		recv_zerocopy_release(mosq->sock, zc->handle);
+		zc->handle = NULL;
+		zc->iovcnt = 0;
+		zc->idx = 0;
+		zc->off = 0;
+	}
+}
+
+static void _mosquitto_zc_advance(struct mosquitto *mosq, size_t len)
+{
+	struct _mosquitto_zc_in *zc = &mosq->zc_in;
+
+	zc->off += len;
+	if (zc->off == zc->iov[zc->idx].iov_len) {
+		zc->idx++;
+		zc->off = 0;
+		if (zc->idx == zc->iovcnt) {
+			_mosquitto_zc_release(mosq);
+		}
+	}
+}
+
+/* Take more segments from the socket. Returns as recv() does. */
+static ssize_t _mosquitto_zc_fill(struct mosquitto *mosq, int flags)
+{
+	struct _mosquitto_zc_in *zc = &mosq->zc_in;
+	ssize_t len;
+	ssize_t sum;
+	int on = 1;
+
+	if (zc->state == 0) {
+		zc->state = setsockopt(mosq->sock, IPPROTO_TCP, TCP_ZEROCOPY_RECV, &on, sizeof(on)) == 0 ? 1 : -1;
+	}
+	if (zc->state < 0) {
+		set_errno(EOPNOTSUPP);
+		return -1;
+	}
+
+	len = recv_zerocopy(mosq->sock, zc->iov, MOSQ_ZC_IOV_MAX, &zc->handle, flags);
+	if (len <= 0) {
+		zc->handle = NULL;
+		return len;
+	}
+	for (zc->iovcnt = 0, sum = 0; sum < len; zc->iovcnt++) {
+		sum += zc->iov[zc->iovcnt].iov_len;
+	}
+	zc->idx = 0;
+	zc->off = 0;
+	return len;
+}
+
+/* Copy from the held segments, taking more from the socket as needed. */
+static ssize_t _mosquitto_zc_read(struct mosquitto *mosq, void *buf, size_t count)
+{
+	struct _mosquitto_zc_in *zc = &mosq->zc_in;
+	size_t copied = 0;
+	size_t len;
+	ssize_t ret;
+
+	if (zc->state < 0) {
+		return read(mosq->sock, buf, count);
+	}
+
+	while (copied < count) {
+		if (!zc->handle) {
+			/* only block if nothing has been read yet */
+			ret = _mosquitto_zc_fill(mosq, copied ? MSG_DONTWAIT : 0);
+			if (ret <= 0) {
+				if (copied) {
+					break;
+				}
+				if (ret < 0 && zc->state < 0) {
+					return read(mosq->sock, buf, count);
+				}
+				return ret;
+			}
+		}
+		len = zc->iov[zc->idx].iov_len - zc->off;
+		if (len > count - copied) {
+			len = count - copied;
+		}
+		memcpy((uint8_t *)buf + copied, (uint8_t *)zc->iov[zc->idx].iov_base + zc->off, len);
+		copied += len;
+		_mosquitto_zc_advance(mosq, len);
+	}
+	return (ssize_t)copied;
+}
+
+/* Point the incoming payload straight at the received data if the whole
+ * packet is already held in one segment, so read_handle.c parses it in
+ * place. Returns NULL if it has to be copied.
+ */
+static uint8_t *_mosquitto_zc_borrow(struct mosquitto *mosq, uint32_t len)
+{
+	struct _mosquitto_zc_in *zc = &mosq->zc_in;
+	uint8_t *payload;
+
+	if (!zc->handle || zc->iov[zc->idx].iov_len - zc->off < len) {
+		return NULL;
+	}
+	payload = (uint8_t *)zc->iov[zc->idx].iov_base + zc->off;
+	zc->borrowed = true;
+	_mosquitto_zc_advance(mosq, len);
+	return payload;
+}
+
+/* The borrowed payload has been handled: detach it from in_packet so that
+ * it is not freed, then drop the segments if they are all consumed.
+ */
+static void _mosquitto_zc_unborrow(struct mosquitto *mosq)
+{
+	struct _mosquitto_zc_in *zc = &mosq->zc_in;
+
+	if (zc->borrowed) {
+		mosq->in_packet.payload = NULL;
+		zc->borrowed = false;
+		if (zc->idx == zc->iovcnt) {
+			_mosquitto_zc_release(mosq);
+		}
+	}
+}
+#endif
+
 /* Close a socket associated with a context and set it to -1.
  * Returns 1 on failure (context is NULL)
  * Returns 0 on success.
@@ -250,6 +386,11 @@ int _mosquitto_socket_close(struct mosquitto *mosq)
 	if ((int)mosq->sock >= 0) {
 #ifdef WITH_BROKER
 		HASH_DELETE(hh_sock, db->contexts_by_sock, mosq);
+#endif
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+		_mosquitto_zc_unborrow(mosq);
+		_mosquitto_zc_release(mosq);
+		mosq->zc_in.state = 0;
 #endif
 		rc = COMPAT_CLOSE(mosq->sock);
 		mosq->sock = INVALID_SOCKET;
@@ -465,16 +606,29 @@ int mosquitto__socket_connect_tls(struct mosquitto *mosq)
 int mosquitto__socket_connect_tls(struct mosquitto *mosq)
 {
 	int r;
+#ifdef CONFIG_TLS_SESSION_CACHE
+	int offered;
+
+	offered = (tls_session_cache_load(mosq->ssl_ctx, mosq->host, mosq->port) == 0);
+#endif
 	_mosquitto_log_printf(mosq, MOSQ_LOG_DEBUG, "Handshake Start.");
 	/* Handshake */
 	while ((r = mbedtls_ssl_handshake(mosq->ssl_ctx)) != 0) {
 		if (r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			_mosquitto_log_printf(mosq, MOSQ_LOG_ERR, "Error: handshake fail -%x", -r);
+#ifdef CONFIG_TLS_SESSION_CACHE
+			if (offered) {
+				tls_session_cache_remove(mosq->host, mosq->port);
+			}
+#endif
 			COMPAT_CLOSE(mosq->sock);
 			mosq->sock = INVALID_SOCKET;
 			return MOSQ_ERR_TLS;
 		}
 	}
+#ifdef CONFIG_TLS_SESSION_CACHE
+	tls_session_cache_save(mosq->ssl_ctx, mosq->host, mosq->port);
+#endif
 	_mosquitto_log_printf(mosq, MOSQ_LOG_DEBUG, "Handshake End.");
 	return MOSQ_ERR_SUCCESS;
 }
@@ -847,7 +1001,9 @@ ssize_t _mosquitto_net_read(struct mosquitto *mosq, void *buf, size_t count)
 			/* Call normal write/send */
 #endif
 
-#ifndef WIN32
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+			return _mosquitto_zc_read(mosq, buf, count);
+#elif !defined(WIN32)
 			return read(mosq->sock, buf, count);
 #else
 			return recv(mosq->sock, buf, count, 0);
@@ -1175,11 +1331,17 @@ int _mosquitto_packet_read(struct mosquitto *mosq)
 		mosq->in_packet.remaining_count *= -1;
 
 		if (mosq->in_packet.remaining_length > 0) {
-			mosq->in_packet.payload = _mosquitto_malloc(mosq->in_packet.remaining_length * sizeof(uint8_t));
-			if (!mosq->in_packet.payload) {
-				return MOSQ_ERR_NOMEM;
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+			mosq->in_packet.payload = _mosquitto_zc_borrow(mosq, mosq->in_packet.remaining_length);
+			if (!mosq->in_packet.payload)
+#endif
+			{
+				mosq->in_packet.payload = _mosquitto_malloc(mosq->in_packet.remaining_length * sizeof(uint8_t));
+				if (!mosq->in_packet.payload) {
+					return MOSQ_ERR_NOMEM;
+				}
+				mosq->in_packet.to_process = mosq->in_packet.remaining_length;
 			}
-			mosq->in_packet.to_process = mosq->in_packet.remaining_length;
 		}
 	}
 	while (mosq->in_packet.to_process > 0) {
@@ -1231,6 +1393,9 @@ int _mosquitto_packet_read(struct mosquitto *mosq)
 	rc = _mosquitto_packet_handle(mosq);
 #endif
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+	_mosquitto_zc_unborrow(mosq);
+#endif
 	/* Free data and reset values */
 	_mosquitto_packet_cleanup(&mosq->in_packet);
 
@@ -125,4 +125,51 @@ int netlib_netmon_devstats(const char *ifname, void **arg)
 	}
 	return req.req_res;
 }
+
+#ifdef CONFIG_NET_TCP_PCB_STATS
+/****************************************************************************
+ * Name: netlib_netmon_tcpstats
+ *
+ * Description:
+ *   Get the statistics of the active TCP connections
+
+ * Parameters:
+ *   stats   Array to fill
+ *   max     Number of entries in stats
+ *
+ * Return:
+ *   The number of active connections, which may exceed max; -1 on failure
+ *
+ ****************************************************************************/
+
+int netlib_netmon_tcpstats(struct netmon_tcp_stats *stats, int max)
+{
+	if (max < 0 || (max > 0 && stats == NULL)) {
+		return -1;
+	}
+	int ret = ERROR;
+	struct req_lwip_data req;
+	int sockfd = socket(AF_INET, NETLIB_SOCK_IOCTL, 0);
+	if (sockfd == -1) {
+		NET_LOGE(TAG, "socket() failed with errno: %d\n", errno);
+		return -1;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.type = GETTCPSTATS;
+	req.msg.tcpstats.stats = stats;
+	req.msg.tcpstats.max = max;
+
+	ret = ioctl(sockfd, SIOCLWIP, (unsigned long)&req);
+	close(sockfd);
+	if (ret == ERROR) {
+		NET_LOGE(TAG, "ioctl() failed with errno: %d\n", errno);
+		return -1;
+	}
+	if (req.req_res != 0) {
+		return -1;
+	}
+	return req.msg.tcpstats.count;
+}
+#endif
 #endif /* CONFIG_NET && CONFIG_NSOCKET_DESCRIPTORS */
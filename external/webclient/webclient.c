@@ -94,6 +94,9 @@
 #include "../webserver/http_client.h"
 #include <protocols/webserver/http_err.h>
 #include <protocols/webclient.h>
+#ifdef CONFIG_TLS_SESSION_CACHE
+#include <mbedtls/tls_session_cache.h>
+#endif
 #if defined(CONFIG_NETUTILS_CODECS)
 #  if defined(CONFIG_CODECS_URLCODE)
 #    define WGET_USE_URLENCODE 1
@@ -601,9 +604,12 @@ void wget_tls_ssl_release(struct http_client_tls_t *client)
 	mbedtls_ssl_free(&(client->tls_ssl));
 }
 
-int wget_tls_handshake(struct http_client_tls_t *client, const char *hostname)
+int wget_tls_handshake(struct http_client_tls_t *client, const char *hostname, uint16_t port)
 {
 	int result = 0;
+#ifdef CONFIG_TLS_SESSION_CACHE
+	int offered;
+#endif
 
 	mbedtls_net_init(&(client->tls_client_fd));
 	mbedtls_ssl_init(&(client->tls_ssl));
@@ -640,15 +646,28 @@ int wget_tls_handshake(struct http_client_tls_t *client, const char *hostname)
 	mbedtls_ssl_set_bio(&(client->tls_ssl), &(client->tls_client_fd),
 						mbedtls_net_send, mbedtls_net_recv, NULL);
 
+#ifdef CONFIG_TLS_SESSION_CACHE
+	offered = (tls_session_cache_load(&(client->tls_ssl), hostname, port) == 0);
+#endif
+
 	/* Handshake */
 	while ((result = mbedtls_ssl_handshake(&(client->tls_ssl))) != 0) {
 		if (result != MBEDTLS_ERR_SSL_WANT_READ &&
 			result != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			printf("Error: TLS Handshake fail returned -%4x\n", -result);
+#ifdef CONFIG_TLS_SESSION_CACHE
+			if (offered) {
+				tls_session_cache_remove(hostname, port);
+			}
+#endif
 			goto HANDSHAKE_FAIL;
 		}
 	}
 
+#ifdef CONFIG_TLS_SESSION_CACHE
+	tls_session_cache_save(&(client->tls_ssl), hostname, port);
+#endif
+
 	printf("TLS Handshake Success\n");
 
 	return 0;
@@ -991,7 +1010,7 @@ retry:
 	}
 
 	client_tls->client_fd = sockfd;
-	if (param->tls && (ret = wget_tls_handshake(client_tls, ws.hostname))) {
+	if (param->tls && (ret = wget_tls_handshake(client_tls, ws.hostname, ws.port))) {
 		if (handshake_retry-- > 0) {
 			if (ret == MBEDTLS_ERR_NET_SEND_FAILED ||
 				ret == MBEDTLS_ERR_NET_RECV_FAILED ||
@@ -43,6 +43,9 @@
 #include <netutils/netlib.h>
 #include <protocols/websocket.h>
 #include <protocols/wslay/wslay.h>
+#ifdef CONFIG_TLS_SESSION_CACHE
+#include "mbedtls/tls_session_cache.h"
+#endif
 
 /****************************************************************************
  * Definitions
@@ -67,9 +70,16 @@ websocket_t ws_srv_table[WEBSOCKET_MAX_CLIENT];
 
 /****** websocket common functions *****/
 
-int websocket_tls_handshake(websocket_t *data, char *hostname, int auth_mode)
+/* hostname is NULL on the server side; the session cache only applies to
+ * clients.
+ */
+
+int websocket_tls_handshake(websocket_t *data, char *hostname, unsigned short port, int auth_mode)
 {
 	int r;
+#ifdef CONFIG_TLS_SESSION_CACHE
+	int offered;
+#endif
 
 	/* set socket file descriptor */
 	data->tls_net.fd = data->fd;
@@ -101,13 +111,26 @@ int websocket_tls_handshake(websocket_t *data, char *hostname, int auth_mode)
 	/* Handshake */
 	WEBSOCKET_DEBUG("  . Performing the SSL/TLS handshake...");
 
+#ifdef CONFIG_TLS_SESSION_CACHE
+	offered = (tls_session_cache_load(data->tls_ssl, hostname, port) == 0);
+#endif
+
 	while ((r = mbedtls_ssl_handshake(data->tls_ssl)) != 0) {
 		if (r != MBEDTLS_ERR_SSL_WANT_READ && r != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			WEBSOCKET_DEBUG("Error: mbedtls_ssl_handshake returned -%4x\n", -r);
+#ifdef CONFIG_TLS_SESSION_CACHE
+			if (offered) {
+				tls_session_cache_remove(hostname, port);
+			}
+#endif
 			return r;
 		}
 	}
 
+#ifdef CONFIG_TLS_SESSION_CACHE
+	tls_session_cache_save(data->tls_ssl, hostname, port);
+#endif
+
 	WEBSOCKET_DEBUG("OK\n");
 	return WEBSOCKET_SUCCESS;
 }
@@ -413,7 +436,7 @@ TLS_HS_RETRY:
 	}
 
 	if (client->tls_enabled) {
-		if ((r = websocket_tls_handshake(client, host, client->auth_mode)) != WEBSOCKET_SUCCESS) {
+		if ((r = websocket_tls_handshake(client, host, atoi(port), client->auth_mode)) != WEBSOCKET_SUCCESS) {
 			if (r == MBEDTLS_ERR_NET_SEND_FAILED || r == MBEDTLS_ERR_NET_RECV_FAILED || r == MBEDTLS_ERR_SSL_CONN_EOF) {
 				if (tls_hs_retry-- > 0) {
 					WEBSOCKET_DEBUG("Handshake again.... \n");
@@ -536,7 +559,7 @@ int websocket_server_authenticate(websocket_t *server)
 		mbedtls_ssl_init(server->tls_ssl);
 		mbedtls_net_init(&(server->tls_net));
 
-		if ((r = websocket_tls_handshake(server, NULL, server->auth_mode)) != WEBSOCKET_SUCCESS) {
+		if ((r = websocket_tls_handshake(server, NULL, 0, server->auth_mode)) != WEBSOCKET_SUCCESS) {
 			WEBSOCKET_DEBUG("fail to tls handshake\n");
 			r = WEBSOCKET_TLS_HANDSHAKE_ERROR;
 			goto EXIT_SERVER_START;
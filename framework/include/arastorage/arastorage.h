@@ -172,6 +172,9 @@ typedef struct _db_handle_s db_handle_t;
 struct _db_cursor_s;
 typedef struct _db_cursor_s db_cursor_t;
 
+struct db_stmt_s;
+typedef struct db_stmt_s db_stmt_t;
+
 typedef int db_storage_id_t;
 
 typedef uint32_t cursor_row_t;
@@ -232,6 +235,78 @@ db_result_t db_exec(char *format);
 */
 db_cursor_t *db_query(char *format);
 
+/**
+* @brief compile a query once for repeated execution
+*
+* @details @b #include <arastorage/arastorage.h>
+* Each '?' in the query is a parameter, numbered from 1 in the order of
+* appearance. Parameters can stand for inserted values and for the
+* operands of a WHERE condition. Preparing a query text that was
+* finalized recently reuses its compiled form.
+* @param[in] format query sentence
+* @return On success, a pointer to db_stmt_t is returned. On failure, a NULL is returned.
+* @since TizenRT v3.1
+*/
+db_stmt_t *db_stmt_prepare(char *format);
+
+/**
+* @brief bind an integer value to a parameter of a prepared query
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] stmt a pointer to prepared query
+* @param[in] index parameter number, starting from 1
+* @param[in] value value of the parameter
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_stmt_bind_long(db_stmt_t *stmt, int index, long value);
+
+/**
+* @brief bind a string value to a parameter of a prepared query
+*
+* @details @b #include <arastorage/arastorage.h>
+* Only inserted values can be strings. The string is not copied, so it
+* must stay valid until the query is executed.
+* @param[in] stmt a pointer to prepared query
+* @param[in] index parameter number, starting from 1
+* @param[in] value value of the parameter
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_stmt_bind_string(db_stmt_t *stmt, int index, char *value);
+
+/**
+* @brief execute a prepared query which does not return tuples, such as INSERT
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] stmt a pointer to prepared query whose parameters are all bound
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_stmt_exec(db_stmt_t *stmt);
+
+/**
+* @brief run a prepared SELECT or REMOVE query
+*
+* @details @b #include <arastorage/arastorage.h>
+* The bindings are kept, so the query can be run again after changing
+* some of them.
+* @param[in] stmt a pointer to prepared query whose parameters are all bound
+* @return On success, a pointer to db_cursor_t is returned. On failure, a NULL is returned.
+* @since TizenRT v3.1
+*/
+db_cursor_t *db_stmt_query(db_stmt_t *stmt);
+
+/**
+* @brief release a prepared query
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] stmt a pointer to prepared query
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_stmt_finalize(db_stmt_t *stmt);
+
 /**
 * @brief free allocated cursor data, it should be called before application terminated
 *
@@ -199,6 +199,21 @@ public:
 	 */
 	player_result_t setDataSource(std::unique_ptr<stream::InputDataSource>);
 
+	/**
+	 * @brief Queue the DataSource to be played after the current one
+	 * @details @b #include <media/MediaPlayer.h>
+	 * This function is a synchronous API.
+	 * The queued dataSource is opened and buffered in the background while the
+	 * current one is played, and it starts without a gap once the current one
+	 * reaches its end. The output device is kept open if the formats match,
+	 * otherwise the queued stream is resampled to the opened device.
+	 * Queueing another dataSource replaces the one queued before.
+	 * @param[in] dataSource The dataSource that the config of input data
+	 * @return The result of the setNextDataSource operation
+	 * @since TizenRT v3.1
+	 */
+	player_result_t setNextDataSource(std::unique_ptr<stream::InputDataSource>);
+
 	/**
 	 * @brief Set the observer of MediaPlayer
 	 * @details @b #include <media/MediaPlayer.h>
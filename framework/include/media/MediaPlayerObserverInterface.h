@@ -134,6 +134,13 @@ public:
 	 * @since TizenRT v2.0
 	 */
 	virtual void onAsyncPrepared(MediaPlayer &mediaPlayer, player_error_t error) {}
+	/**
+	 * @brief informs the user that the data source queued by setNextDataSource()
+	 * has started playing after the previous one finished.
+	 * @details @b #include <media/MediaPlayerObserverInterface.h>
+	 * @since TizenRT v3.1
+	 */
+	virtual void onPlaybackNextSourceStarted(MediaPlayer &mediaPlayer) {}
 };
 } // namespace media
 
@@ -91,11 +91,19 @@
 #define AQL_TYPE_SELECT                    (AQL_OP_TYPE_QUERY | 0x00000009)
 #define AQL_TYPE_REMOVE_TUPLES             (AQL_OP_TYPE_QUERY | 0x0000000A)
 
+#define AQL_TYPE_BEGIN                     (AQL_OP_TYPE_EXEC | 0x0000000B)
+#define AQL_TYPE_COMMIT                    (AQL_OP_TYPE_EXEC | 0x0000000C)
+#define AQL_TYPE_ROLLBACK                  (AQL_OP_TYPE_EXEC | 0x0000000D)
+
 #define AQL_TYPE_MASK                      (AQL_OP_TYPE_MASK | AQL_DATA_TYPE_MASK)
 
 #define AQL_FLAG_AGGREGATE              1
 #define AQL_FLAG_SELECT_ALL             2
 #define AQL_FLAG_ASSIGN                 4
+#define AQL_FLAG_DERIVED                8	/* The condition has been derived already */
+
+/* Parameter placed in the condition rather than in the inserted values */
+#define AQL_PARAMETER_CONDITION         0xff
 
 #define AQL_CLEAR(adt)                  aql_clear(adt)
 #define AQL_SET_TYPE(adt, type)  (((adt))->optype = (type))
@@ -126,6 +134,8 @@
 #define AQL_SET_CONDITION(adt, cond)    ((adt)->lvm_instance = (cond))
 #define AQL_ADD_VALUE(adt, domain, value)                               \
 	aql_add_value((adt), (domain), (value))
+#define AQL_ADD_PARAMETER(adt, value_slot)                              \
+	aql_add_parameter((adt), (value_slot))
 
 /****************************************************************************
 * Public Type Definitions
@@ -193,6 +203,10 @@ enum token_e {
 
 	ATTRIBUTE,
 	BPLUSTREE,					/* 48 */
+	BEGIN,
+	COMMIT,
+	ROLLBACK,
+	PARAMETER,
 
 	INTEGER_VALUE = 251,
 	FLOAT_VALUE = 252,
@@ -244,6 +258,8 @@ struct aql_adt_s {
 	uint8_t value_count;
 	uint32_t optype;
 	uint8_t flags;
+	uint8_t parameter_count;
+	uint8_t parameter_values[AQL_PARAMETER_LIMIT];	/* Value slot of each parameter or AQL_PARAMETER_CONDITION */
 	void *lvm_instance;
 };
 typedef struct aql_adt_s aql_adt_t;
@@ -258,7 +274,14 @@ void lexer_rewind(lexer_t *);
 void aql_clear(aql_adt_t *adt);
 void aql_add_relation(aql_adt_t *adt, char *rel);
 aql_status_t aql_parse(aql_adt_t *adt, char *query_string);
+db_result_t aql_init_handle(db_handle_t **handle);
+db_result_t aql_deinit_handle(db_handle_t **handle);
 db_result_t aql_add_attribute(aql_adt_t *adt, char *name, domain_t domain, unsigned element_size, int processed_only);
 db_result_t aql_add_value(aql_adt_t *adt, domain_t domain, void *value);
+db_result_t aql_add_parameter(aql_adt_t *adt, uint8_t value_slot);
+db_result_t aql_get_parse_result(char *format, aql_adt_t *adt);
+db_result_t aql_exec_adt(aql_adt_t *adt);
+db_cursor_t *aql_query_adt(aql_adt_t *adt);
+void aql_stmt_cache_clear(void);
 
 #endif							/* !AQL_H */
@@ -85,6 +85,7 @@ void aql_clear(aql_adt_t *adt)
 	adt->attribute_count = 0;
 	adt->value_count = 0;
 	adt->flags = 0;
+	adt->parameter_count = 0;
 	memset(adt->aggregators, 0, sizeof(adt->aggregators));
 }
 
@@ -160,3 +161,22 @@ db_result_t aql_add_value(aql_adt_t *adt, domain_t domain, void *value_ptr)
 
 	return DB_OK;
 }
+
+/* Adds a '?' parameter. An inserted value is reserved for it unless it
+   is an operand of the condition. */
+db_result_t aql_add_parameter(aql_adt_t *adt, uint8_t value_slot)
+{
+	if (adt->parameter_count == AQL_PARAMETER_LIMIT) {
+		return DB_LIMIT_ERROR;
+	}
+
+	if (value_slot != AQL_PARAMETER_CONDITION) {
+		if (adt->value_count == AQL_ATTRIBUTE_LIMIT) {
+			return DB_LIMIT_ERROR;
+		}
+		adt->values[adt->value_count++].domain = DOMAIN_UNSPECIFIED;
+	}
+	adt->parameter_values[adt->parameter_count++] = value_slot;
+
+	return DB_OK;
+}
@@ -64,9 +64,11 @@
 #include <unistd.h>
 
 #include "db_debug.h"
+#include "buffer_pool.h"
 #include "storage.h"
 #include "relation.h"
 #include "result.h"
+#include "transaction.h"
 #include "aql.h"
 
 /****************************************************************************
@@ -146,30 +148,58 @@ relation_t *aql_get_relation(aql_adt_t *adt)
 	return relation_load(adt->relations[first_rel_arg]);
 }
 
-db_result_t db_exec(char *format)
+/****************************************************************************
+ * Name: aql_exec_adt
+ *
+ * Description: Executes a parsed statement which does not return tuples.
+ *              Shared by db_exec() and prepared statements.
+ *
+ ****************************************************************************/
+db_result_t aql_exec_adt(aql_adt_t *adt)
 {
 	db_result_t res;
-	aql_adt_t adt;
 	relation_t *rel = NULL;
 	aql_attribute_t *attr;
 	attribute_t *relattr = NULL;
+	attribute_t *index_attrs[DB_INDEX_ATTRIBUTE_LIMIT];
 	uint32_t optype;
-	res = aql_get_parse_result(format, &adt);
+	int i;
 
-	if (DB_ERROR(res)) {
-		DB_LOG_E("DB : Parsing Error in db_create : %d\n", res);
-		return DB_PARSING_ERROR;
-	}
-
-	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(adt));
 	if (optype == AQL_OP_TYPE_QUERY) {
 		DB_LOG_E("DB : AQL OP TYPE Error \n");
 		return DB_ARGUMENT_ERROR;
 	}
 
-	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(adt));
+	switch (optype) {
+	case AQL_TYPE_BEGIN:
+		return transaction_begin();
+	case AQL_TYPE_COMMIT:
+		return transaction_commit();
+	case AQL_TYPE_ROLLBACK:
+		return transaction_rollback();
+	case AQL_TYPE_INSERT:
+		break;
+	default:
+		/* Only INSERT statements are logged, so the schema stays put until COMMIT */
+		if (transaction_is_active()) {
+			DB_LOG_E("DB : Only INSERT is allowed in a transaction\n");
+			return DB_BUSY_ERROR;
+		}
+		break;
+	}
+
+	if (!transaction_is_active()) {
+		res = transaction_check();
+		if (DB_ERROR(res)) {
+			DB_LOG_E("DB : A failed commit has not been applied yet\n");
+			return res;
+		}
+	}
+
 	if (optype != AQL_TYPE_CREATE_RELATION) {
-		rel = aql_get_relation(&adt);
+		rel = aql_get_relation(adt);
 		if (rel == NULL) {
 			DB_LOG_E("DB : get relation Failed\n");
 			return DB_RELATIONAL_ERROR;
@@ -180,39 +210,48 @@ db_result_t db_exec(char *format)
 
 	switch (optype) {
 	case AQL_TYPE_CREATE_ATTRIBUTE:
-		attr = &(adt.attributes[0]);
+		attr = &(adt->attributes[0]);
 		if (relation_attribute_add(rel, DB_STORAGE, attr->name, attr->domain, attr->element_size) != NULL) {
 			res = DB_OK;
 		}
 		break;
 	case AQL_TYPE_CREATE_INDEX:
-		relattr = relation_attribute_get(rel, adt.attributes[0].name);
-		if (relattr == NULL) {
+		if (adt->attribute_count > DB_INDEX_ATTRIBUTE_LIMIT) {
+			res = DB_LIMIT_ERROR;
+			break;
+		}
+		for (i = 0; i < adt->attribute_count; i++) {
+			index_attrs[i] = relation_attribute_get(rel, adt->attributes[i].name);
+			if (index_attrs[i] == NULL) {
+				break;
+			}
+		}
+		if (i < adt->attribute_count) {
 			res = DB_NAME_ERROR;
 			break;
 		}
-		res = index_create(AQL_GET_INDEX_TYPE(&adt), rel, relattr);
+		res = index_create(AQL_GET_INDEX_TYPE(adt), rel, index_attrs, adt->attribute_count);
 		break;
 	case AQL_TYPE_CREATE_RELATION:
-		if (relation_create(adt.relations[0], DB_STORAGE) != NULL) {
+		if (relation_create(adt->relations[0], DB_STORAGE) != NULL) {
 			res = DB_OK;
 		}
 		break;
 	case AQL_TYPE_INSERT:
-		if (relation_cardinality(rel) < DB_TUPLE_LIMIT) {
-			res = relation_insert(rel, adt.values);
-			if (DB_SUCCESS(res)) {
-				res = DB_OK;
-			}
-		} else {
-			res = DB_LIMIT_ERROR;
+		if (transaction_is_active()) {
+			res = transaction_insert(rel, adt->values);
+			break;
+		}
+		res = relation_insert(rel, adt->values);
+		if (DB_SUCCESS(res)) {
+			res = DB_OK;
 		}
 		break;
 	case AQL_TYPE_REMOVE_ATTRIBUTE:
-		res = relation_attribute_remove(rel, adt.attributes[0].name);
+		res = relation_attribute_remove(rel, adt->attributes[0].name);
 		break;
 	case AQL_TYPE_REMOVE_INDEX:
-		relattr = relation_attribute_get(rel, adt.attributes[0].name);
+		relattr = relation_attribute_get(rel, adt->attributes[0].name);
 		if (relattr != NULL) {
 			index_load(rel, relattr);
 			if (relattr->index != NULL) {
@@ -233,12 +272,45 @@ db_result_t db_exec(char *format)
 	if (rel != NULL) {
 		relation_release(rel);
 	}
+
+	/* Commit the index records the statement modified */
+	if (DB_ERROR(buffer_pool_flush(INVALID_STORAGE_ID)) && DB_SUCCESS(res)) {
+		res = DB_STORAGE_ERROR;
+	}
 	return res;
 }
 
-db_cursor_t *db_query(char *format)
+db_result_t db_exec(char *format)
 {
+	db_result_t res;
 	aql_adt_t adt;
+
+	res = aql_get_parse_result(format, &adt);
+	if (DB_ERROR(res)) {
+		DB_LOG_E("DB : Parsing Error in db_create : %d\n", res);
+		return DB_PARSING_ERROR;
+	}
+	if (adt.parameter_count > 0) {
+		DB_LOG_E("DB : A query with parameters needs db_stmt_prepare()\n");
+		if (adt.lvm_instance != NULL) {
+			free(adt.lvm_instance);
+		}
+		return DB_ARGUMENT_ERROR;
+	}
+
+	return aql_exec_adt(&adt);
+}
+
+/****************************************************************************
+ * Name: aql_query_adt
+ *
+ * Description: Runs a parsed SELECT or REMOVE FROM query. The condition of
+ *              the query is owned by the returned cursor from now on.
+ *              Shared by db_query() and prepared statements.
+ *
+ ****************************************************************************/
+db_cursor_t *aql_query_adt(aql_adt_t *adt)
+{
 	relation_t *rel;
 	uint32_t optype;
 	db_handle_t *handler;
@@ -248,11 +320,7 @@ db_cursor_t *db_query(char *format)
 	handler = NULL;
 	cursor = NULL;
 
-	if (DB_ERROR(aql_get_parse_result(format, &adt))) {
-		DB_LOG_E("DB : Parsing Error in db_create\n");
-		return NULL;
-	}
-	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(adt));
 	if (optype != AQL_OP_TYPE_QUERY) {
 		DB_LOG_E("DB : AQL OP TYPE Error \n");
 		return NULL;
@@ -263,19 +331,25 @@ db_cursor_t *db_query(char *format)
 	}
 #endif
 
-	rel = aql_get_relation(&adt);
+	/* The replay of a failed commit expects the tuple files as they were at commit time */
+	if (AQL_GET_EXEC_TYPE(AQL_GET_TYPE(adt)) == AQL_TYPE_REMOVE_TUPLES && DB_ERROR(transaction_check())) {
+		DB_LOG_E("DB : A failed commit has not been applied yet\n");
+		return NULL;
+	}
+
+	rel = aql_get_relation(adt);
 	if (rel == NULL) {
 		return NULL;
 	}
 
-	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(adt));
 	switch (optype) {
 	case AQL_TYPE_REMOVE_TUPLES:
 		/* Overwrite the attribute array with a full copy of the original
 		   relation's attributes. */
-		adt.attribute_count = 0;
+		adt->attribute_count = 0;
 		for (attr_ptr = list_head(rel->attributes); attr_ptr != NULL; attr_ptr = attr_ptr->next) {
-			AQL_ADD_ATTRIBUTE(&adt, attr_ptr->name, DOMAIN_UNSPECIFIED, 0);
+			AQL_ADD_ATTRIBUTE(adt, attr_ptr->name, DOMAIN_UNSPECIFIED, 0);
 		}
 	/* FALLTHROUGH */
 	case AQL_TYPE_SELECT:
@@ -283,7 +357,7 @@ db_cursor_t *db_query(char *format)
 			DB_LOG_E("DB: Init handle failed\n");
 			goto errout;
 		}
-		if (DB_ERROR(relation_select(&handler, rel, &adt))) {
+		if (DB_ERROR(relation_select(&handler, rel, adt))) {
 			DB_LOG_E("DB: Failed relation_select\n");
 			goto errout;
 		}
@@ -292,6 +366,17 @@ db_cursor_t *db_query(char *format)
 			DB_LOG_E("DB: Failed to process cursor tuples\n");
 			goto errout;
 		}
+		if (cursor->handle != NULL) {
+			/* The cursor reads rows with the handle, so the handle and the
+			   relation are released by the cursor from now on. Read the
+			   first row to report errors and an empty result here. */
+			if (DB_ERROR(cursor_fetch(cursor, 0))) {
+				DB_LOG_E("DB: Failed to process cursor tuples\n");
+				cursor_deinit(cursor);
+				return NULL;
+			}
+			return cursor;
+		}
 		break;
 	case AQL_TYPE_FLUSH:
 	//TODO flush operation will be implemented later
@@ -317,3 +402,22 @@ errout:
 
 	return NULL;
 }
+
+db_cursor_t *db_query(char *format)
+{
+	aql_adt_t adt;
+
+	if (DB_ERROR(aql_get_parse_result(format, &adt))) {
+		DB_LOG_E("DB : Parsing Error in db_create\n");
+		return NULL;
+	}
+	if (adt.parameter_count > 0) {
+		DB_LOG_E("DB : A query with parameters needs db_stmt_prepare()\n");
+		if (adt.lvm_instance != NULL) {
+			free(adt.lvm_instance);
+		}
+		return NULL;
+	}
+
+	return aql_query_adt(&adt);
+}
@@ -261,6 +261,11 @@ PARSER(values)
 	case INTEGER_VALUE:
 		AQL_ADD_VALUE(adt, DOMAIN_INT, VALUE);
 		break;
+	case PARAMETER:
+		if (DB_ERROR(AQL_ADD_PARAMETER(adt, adt->value_count))) {
+			RETURN(SYNTAX_ERROR);
+		}
+		break;
 	default:
 		RETURN(SYNTAX_ERROR);
 	}
@@ -298,6 +303,11 @@ PARSER(operand)
 			RETURN(SYNTAX_ERROR);
 		}
 		break;
+	case PARAMETER:
+		if (LVM_ERROR(lvm_set_parameter(p, adt->parameter_count)) || DB_ERROR(AQL_ADD_PARAMETER(adt, AQL_PARAMETER_CONDITION))) {
+			RETURN(SYNTAX_ERROR);
+		}
+		break;
 	default:
 		RETURN(SYNTAX_ERROR);
 	}
@@ -707,6 +717,26 @@ PARSER_TOKEN(index_type)
 	}
 }
 
+/* The key attributes of an index in key order: a, b, c */
+PARSER(index_attributes)
+{
+	CONSUME(IDENTIFIER);
+
+	DB_LOG_V("Creating an index for the attribute %s\n", VALUE);
+	AQL_ADD_ATTRIBUTE(adt, VALUE, DOMAIN_UNSPECIFIED, 0);
+
+	NEXT;
+	if (TOKEN == COMMA) {
+		if (!PARSE(index_attributes)) {
+			RETURN(SYNTAX_ERROR);
+		}
+	} else {
+		REWIND;
+	}
+
+	RETURN(STATUS_OK);
+}
+
 PARSER(create_index)
 {
 	token_t token;
@@ -718,10 +748,9 @@ PARSER(create_index)
 	AQL_ADD_RELATION(adt, VALUE);
 
 	CONSUME(DOT);
-	CONSUME(IDENTIFIER);
-
-	DB_LOG_V("Creating an index for the attribute %s\n", VALUE);
-	AQL_ADD_ATTRIBUTE(adt, VALUE, DOMAIN_UNSPECIFIED, 0);
+	if (!PARSE(index_attributes)) {
+		RETURN(SYNTAX_ERROR);
+	}
 
 	CONSUME(TYPE);
 
@@ -908,6 +937,18 @@ aql_status_t aql_parse(aql_adt_t *adt, char *input_string)
 		case SELECT:
 			result = parse_select(adt, &lex);
 			break;
+		case BEGIN:
+			AQL_SET_TYPE(adt, AQL_TYPE_BEGIN);
+			result = STATUS_OK;
+			break;
+		case COMMIT:
+			AQL_SET_TYPE(adt, AQL_TYPE_COMMIT);
+			result = STATUS_OK;
+			break;
+		case ROLLBACK:
+			AQL_SET_TYPE(adt, AQL_TYPE_ROLLBACK);
+			result = STATUS_OK;
+			break;
 		case REMAIN:
 			result = parse_remain(adt, &lex);
 
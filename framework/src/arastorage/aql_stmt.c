@@ -0,0 +1,344 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * framework/src/arastorage/aql_stmt.c
+ *
+ *   Prepared queries.  A query is lexed and parsed once; its '?'
+ *   parameters become empty inserted values or parameter operands in the
+ *   LVM code of the condition.  Binding all parameters substitutes them
+ *   into a copy of the code and derives the attribute ranges used for
+ *   index selection, so that running the query again only copies the
+ *   bound code.  Finalized queries are kept in a small cache keyed by
+ *   their text and handed out again by db_stmt_prepare().
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "db_debug.h"
+#include "aql.h"
+#include "lvm.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct db_stmt_s {
+	struct db_stmt_s *next;		/* Next finalized query in the cache */
+	char query[AQL_MAX_QUERY_LENGTH + 1];
+	aql_adt_t adt;				/* Parsed query without its condition */
+	lvm_instance_t *condition;	/* Condition with parameter operands */
+	lvm_instance_t *bound;		/* Condition with the bound values */
+	attribute_value_t parameters[AQL_PARAMETER_LIMIT];
+	uint32_t bound_mask;		/* Bit n is set once parameter n + 1 is bound */
+	bool bound_valid;			/* bound holds the current parameter values */
+	bool derived;				/* The ranges of bound have been derived */
+};
+
+/****************************************************************************
+ * Private variables
+ ****************************************************************************/
+static db_stmt_t *g_stmt_cache;
+static int g_stmt_cache_count;
+static pthread_mutex_t g_stmt_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void aql_stmt_free(db_stmt_t *stmt)
+{
+	int i;
+
+	if (stmt == NULL) {
+		return;
+	}
+
+	/* Constant strings of the query were copied by the parser */
+	for (i = 0; i < stmt->adt.value_count; i++) {
+		if (stmt->adt.values[i].domain == DOMAIN_STRING) {
+			free(VALUE_STRING(&stmt->adt.values[i]));
+		}
+	}
+	if (stmt->condition != NULL) {
+		free(stmt->condition);
+	}
+	if (stmt->bound != NULL) {
+		free(stmt->bound);
+	}
+	free(stmt);
+}
+
+static bool aql_stmt_is_bound(db_stmt_t *stmt)
+{
+	return stmt->bound_mask == (1U << stmt->adt.parameter_count) - 1;
+}
+
+/****************************************************************************
+ * Name: aql_stmt_derive
+ *
+ * Description: Substitutes the bound values into a copy of the condition
+ *              and derives the attribute ranges for index selection.
+ *
+ ****************************************************************************/
+static db_result_t aql_stmt_derive(db_stmt_t *stmt)
+{
+	long values[AQL_PARAMETER_LIMIT];
+	int i;
+
+	for (i = 0; i < stmt->adt.parameter_count; i++) {
+		values[i] = VALUE_LONG(&stmt->parameters[i]);
+	}
+
+	memcpy(stmt->bound, stmt->condition, sizeof(lvm_instance_t));
+	if (LVM_ERROR(lvm_bind_parameters(stmt->bound, values, stmt->adt.parameter_count))) {
+		return DB_ARGUMENT_ERROR;
+	}
+	stmt->derived = !LVM_ERROR(lvm_derive(stmt->bound));
+	stmt->bound_valid = true;
+
+	return DB_OK;
+}
+
+static db_result_t aql_stmt_bind(db_stmt_t *stmt, int index, attribute_value_t *value)
+{
+	db_result_t result = DB_OK;
+
+	if (stmt == NULL || index < 1 || index > stmt->adt.parameter_count) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	index--;
+	if (stmt->adt.parameter_values[index] == AQL_PARAMETER_CONDITION && value->domain != DOMAIN_INT) {
+		DB_LOG_E("DB: Only integers can be compared in a condition\n");
+		return DB_TYPE_ERROR;
+	}
+
+	stmt->parameters[index] = *value;
+	stmt->bound_mask |= 1U << index;
+
+	if (stmt->adt.parameter_values[index] == AQL_PARAMETER_CONDITION) {
+		stmt->bound_valid = false;
+		if (aql_stmt_is_bound(stmt)) {
+			result = aql_stmt_derive(stmt);
+			if (DB_ERROR(result)) {
+				stmt->bound_mask &= ~(1U << index);
+			}
+		}
+	}
+
+	return result;
+}
+
+/****************************************************************************
+ * Name: aql_stmt_build
+ *
+ * Description: Fills adt with the parsed query, the bound values and a copy
+ *              of the bound condition, which the query execution frees.
+ *
+ ****************************************************************************/
+static db_result_t aql_stmt_build(db_stmt_t *stmt, aql_adt_t *adt)
+{
+	uint8_t slot;
+	int i;
+
+	if (!aql_stmt_is_bound(stmt)) {
+		DB_LOG_E("DB: Every parameter of a prepared query must be bound\n");
+		return DB_ARGUMENT_ERROR;
+	}
+
+	*adt = stmt->adt;
+	for (i = 0; i < stmt->adt.parameter_count; i++) {
+		slot = stmt->adt.parameter_values[i];
+		if (slot != AQL_PARAMETER_CONDITION) {
+			adt->values[slot] = stmt->parameters[i];
+		}
+	}
+
+	if (stmt->condition == NULL) {
+		return DB_OK;
+	}
+	if (!stmt->bound_valid && DB_ERROR(aql_stmt_derive(stmt))) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	adt->lvm_instance = malloc(sizeof(lvm_instance_t));
+	if (adt->lvm_instance == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+	memcpy(adt->lvm_instance, stmt->bound, sizeof(lvm_instance_t));
+	if (stmt->derived) {
+		AQL_SET_FLAG(adt, AQL_FLAG_DERIVED);
+	}
+
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+db_stmt_t *db_stmt_prepare(char *format)
+{
+	db_stmt_t *stmt;
+	db_stmt_t **prev;
+
+	if (format == NULL || strlen(format) > AQL_MAX_QUERY_LENGTH) {
+		DB_LOG_E("DB: Invalid query to prepare\n");
+		return NULL;
+	}
+
+	pthread_mutex_lock(&g_stmt_cache_lock);
+	for (prev = &g_stmt_cache; *prev != NULL; prev = &(*prev)->next) {
+		if (strcmp((*prev)->query, format) == 0) {
+			stmt = *prev;
+			*prev = stmt->next;
+			g_stmt_cache_count--;
+			pthread_mutex_unlock(&g_stmt_cache_lock);
+
+			DB_LOG_D("DB: Reusing the compiled query \"%s\"\n", format);
+			stmt->next = NULL;
+			stmt->bound_mask = 0;
+			stmt->bound_valid = false;
+			return stmt;
+		}
+	}
+	pthread_mutex_unlock(&g_stmt_cache_lock);
+
+	stmt = (db_stmt_t *)malloc(sizeof(db_stmt_t));
+	if (stmt == NULL) {
+		DB_LOG_E("DB: Failed to allocate a prepared query\n");
+		return NULL;
+	}
+	memset(stmt, 0, sizeof(db_stmt_t));
+
+	if (DB_ERROR(aql_get_parse_result(format, &stmt->adt))) {
+		DB_LOG_E("DB: Parsing error in db_stmt_prepare\n");
+		free(stmt);
+		return NULL;
+	}
+	strncpy(stmt->query, format, AQL_MAX_QUERY_LENGTH);
+
+	/* The condition is copied into every execution, so keep it aside */
+	stmt->condition = (lvm_instance_t *)stmt->adt.lvm_instance;
+	stmt->adt.lvm_instance = NULL;
+	if (stmt->condition != NULL) {
+		stmt->bound = (lvm_instance_t *)malloc(sizeof(lvm_instance_t));
+		if (stmt->bound == NULL) {
+			aql_stmt_free(stmt);
+			return NULL;
+		}
+	}
+
+	return stmt;
+}
+
+db_result_t db_stmt_bind_long(db_stmt_t *stmt, int index, long value)
+{
+	attribute_value_t av;
+
+	av.domain = DOMAIN_INT;
+	VALUE_LONG(&av) = value;
+	return aql_stmt_bind(stmt, index, &av);
+}
+
+db_result_t db_stmt_bind_string(db_stmt_t *stmt, int index, char *value)
+{
+	attribute_value_t av;
+
+	if (value == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	av.domain = DOMAIN_STRING;
+	VALUE_STRING(&av) = (unsigned char *)value;
+	return aql_stmt_bind(stmt, index, &av);
+}
+
+db_result_t db_stmt_exec(db_stmt_t *stmt)
+{
+	aql_adt_t adt;
+	db_result_t res;
+
+	if (stmt == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	res = aql_stmt_build(stmt, &adt);
+	if (DB_ERROR(res)) {
+		return res;
+	}
+	return aql_exec_adt(&adt);
+}
+
+db_cursor_t *db_stmt_query(db_stmt_t *stmt)
+{
+	aql_adt_t adt;
+
+	if (stmt == NULL || DB_ERROR(aql_stmt_build(stmt, &adt))) {
+		return NULL;
+	}
+	return aql_query_adt(&adt);
+}
+
+db_result_t db_stmt_finalize(db_stmt_t *stmt)
+{
+	db_stmt_t *victim;
+	db_stmt_t **prev;
+
+	if (stmt == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	victim = stmt;
+	pthread_mutex_lock(&g_stmt_cache_lock);
+	if (AQL_STMT_CACHE_SIZE > 0) {
+		stmt->next = g_stmt_cache;
+		g_stmt_cache = stmt;
+		victim = NULL;
+
+		/* Drop the query finalized longest ago */
+		if (++g_stmt_cache_count > AQL_STMT_CACHE_SIZE) {
+			for (prev = &g_stmt_cache; (*prev)->next != NULL; prev = &(*prev)->next) ;
+			victim = *prev;
+			*prev = NULL;
+			g_stmt_cache_count--;
+		}
+	}
+	pthread_mutex_unlock(&g_stmt_cache_lock);
+
+	aql_stmt_free(victim);
+	return DB_OK;
+}
+
+void aql_stmt_cache_clear(void)
+{
+	db_stmt_t *stmt;
+
+	pthread_mutex_lock(&g_stmt_cache_lock);
+	while (g_stmt_cache != NULL) {
+		stmt = g_stmt_cache;
+		g_stmt_cache = stmt->next;
+		aql_stmt_free(stmt);
+	}
+	g_stmt_cache_count = 0;
+	pthread_mutex_unlock(&g_stmt_cache_lock);
+}
@@ -65,6 +65,8 @@
 #include "db_debug.h"
 #include "result.h"
 #include "aql.h"
+#include "buffer_pool.h"
+#include "transaction.h"
 #include <arastorage/arastorage.h>
 
 /****************************************************************************
@@ -77,6 +79,10 @@ db_result_t db_init(void)
 	if (res != DB_OK) {
 		return res;
 	}
+	res = buffer_pool_init();
+	if (res != DB_OK) {
+		return res;
+	}
 	res = index_init();
 	if (res != DB_OK) {
 		return res;
@@ -87,16 +93,23 @@ db_result_t db_init(void)
 		return res;
 	}
 #endif
+	/* Finish a commit that was interrupted by a reset */
+	res = transaction_recover();
 	return res;
 }
 
 db_result_t db_deinit()
 {
+	if (transaction_is_active()) {
+		transaction_rollback();
+	}
+	aql_stmt_cache_clear();
 #ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
 	storage_write_buffer_deinit();
 #endif
 	relation_deinit();
 	index_deinit();
+	buffer_pool_deinit();
 	return DB_OK;
 }
 
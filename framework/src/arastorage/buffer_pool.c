@@ -0,0 +1,426 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * framework/src/arastorage/buffer_pool.c
+ *
+ *   A pool of fixed-size frames shared by all files of the database.  A
+ *   frame caches one record (a bplus-tree node or bucket, or a tuple row)
+ *   identified by the descriptor of its file and its offset in that file.
+ *   Frames are kept in LRU order; a pinned frame is owned by one user and
+ *   is never evicted.  Modified frames are written back when they are
+ *   evicted or flushed, and before their file is closed.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "db_debug.h"
+#include "storage.h"
+#include "buffer_pool.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define FRAME_STATE_VALID  1
+#define FRAME_STATE_PINNED 2
+#define FRAME_STATE_DIRTY  4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct buffer_frame_s {
+	struct buffer_frame_s *next;	/* Towards the most recently used frame */
+	struct buffer_frame_s *prev;	/* Towards the least recently used frame */
+	db_storage_id_t fd;			/* File the record belongs to */
+	unsigned long offset;		/* Offset of the record in the file */
+	unsigned length;			/* Length of the record */
+	uint8_t state;				/* FRAME_STATE_* flags */
+	unsigned char *data;		/* DB_BUFFER_PAGE_SIZE bytes of record data */
+};
+typedef struct buffer_frame_s buffer_frame_t;
+
+struct buffer_pool_s {
+	buffer_frame_t *frames;
+	unsigned char *pages;
+	buffer_frame_t lru;			/* lru.next is the least recently used frame */
+	pthread_mutex_t lock;
+};
+
+/****************************************************************************
+ * Private variables
+ ****************************************************************************/
+static struct buffer_pool_s g_buffer_pool;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void frame_remove(buffer_frame_t *frame)
+{
+	frame->prev->next = frame->next;
+	frame->next->prev = frame->prev;
+}
+
+/* Make the frame the most recently used one */
+static void frame_touch(buffer_frame_t *frame)
+{
+	frame_remove(frame);
+	frame->prev = g_buffer_pool.lru.prev;
+	frame->next = &g_buffer_pool.lru;
+	g_buffer_pool.lru.prev->next = frame;
+	g_buffer_pool.lru.prev = frame;
+}
+
+/* Forget the record and make the frame the first one to be reused */
+static void frame_discard(buffer_frame_t *frame)
+{
+	frame->state = 0;
+	frame_remove(frame);
+	frame->next = g_buffer_pool.lru.next;
+	frame->prev = &g_buffer_pool.lru;
+	g_buffer_pool.lru.next->prev = frame;
+	g_buffer_pool.lru.next = frame;
+}
+
+static buffer_frame_t *frame_find(db_storage_id_t fd, unsigned long offset)
+{
+	int i;
+	buffer_frame_t *frame;
+
+	for (i = 0; i < DB_BUFFER_POOL_SIZE; i++) {
+		frame = &g_buffer_pool.frames[i];
+		if ((frame->state & FRAME_STATE_VALID) && frame->fd == fd && frame->offset == offset) {
+			return frame;
+		}
+	}
+	return NULL;
+}
+
+static db_result_t frame_write_back(buffer_frame_t *frame)
+{
+	if ((frame->state & FRAME_STATE_VALID) && (frame->state & FRAME_STATE_DIRTY)) {
+		if (DB_ERROR(storage_write_to(frame->fd, frame->data, frame->offset, frame->length))) {
+			DB_LOG_E("DB: Failed to write back %u bytes at %lu of fd %d\n", frame->length, frame->offset, frame->fd);
+			return DB_STORAGE_ERROR;
+		}
+		frame->state &= ~FRAME_STATE_DIRTY;
+	}
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: frame_alloc
+ *
+ * Description: Returns the least recently used frame which is not pinned,
+ *              after writing it back if it is dirty. NULL is returned when
+ *              every frame is pinned or the write back fails.
+ *
+ ****************************************************************************/
+static buffer_frame_t *frame_alloc(void)
+{
+	buffer_frame_t *frame;
+
+	for (frame = g_buffer_pool.lru.next; frame != &g_buffer_pool.lru; frame = frame->next) {
+		if (frame->state & FRAME_STATE_PINNED) {
+			continue;
+		}
+		if (DB_ERROR(frame_write_back(frame))) {
+			return NULL;
+		}
+		frame->state = 0;
+		return frame;
+	}
+	DB_LOG_E("DB: No unpinned frame in the buffer pool\n");
+	return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+db_result_t buffer_pool_init(void)
+{
+	int i;
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames != NULL) {
+		return DB_OK;
+	}
+
+	g_buffer_pool.frames = (buffer_frame_t *)malloc(DB_BUFFER_POOL_SIZE * sizeof(buffer_frame_t));
+	g_buffer_pool.pages = (unsigned char *)malloc(DB_BUFFER_POOL_SIZE * DB_BUFFER_PAGE_SIZE);
+	if (g_buffer_pool.frames == NULL || g_buffer_pool.pages == NULL) {
+		DB_LOG_E("DB: Failed to allocate the buffer pool\n");
+		free(g_buffer_pool.frames);
+		free(g_buffer_pool.pages);
+		g_buffer_pool.frames = NULL;
+		g_buffer_pool.pages = NULL;
+		return DB_ALLOCATION_ERROR;
+	}
+
+	g_buffer_pool.lru.next = &g_buffer_pool.lru;
+	g_buffer_pool.lru.prev = &g_buffer_pool.lru;
+	for (i = 0; i < DB_BUFFER_POOL_SIZE; i++) {
+		frame = &g_buffer_pool.frames[i];
+		frame->data = g_buffer_pool.pages + i * DB_BUFFER_PAGE_SIZE;
+		frame->state = 0;
+		frame->next = &g_buffer_pool.lru;
+		frame->prev = g_buffer_pool.lru.prev;
+		g_buffer_pool.lru.prev->next = frame;
+		g_buffer_pool.lru.prev = frame;
+	}
+	pthread_mutex_init(&g_buffer_pool.lock, NULL);
+
+	return DB_OK;
+}
+
+/* Files are closed, and their frames dropped, before the pool goes away */
+void buffer_pool_deinit(void)
+{
+	if (g_buffer_pool.frames == NULL) {
+		return;
+	}
+	pthread_mutex_destroy(&g_buffer_pool.lock);
+	free(g_buffer_pool.frames);
+	free(g_buffer_pool.pages);
+	g_buffer_pool.frames = NULL;
+	g_buffer_pool.pages = NULL;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_pin
+ *
+ * Description: Returns the cached copy of the record at offset in fd,
+ *              reading it from storage on a miss, or the part beyond the
+ *              cached length on a hit, and pins it. The caller
+ *              releases it with buffer_pool_unpin(). NULL is returned when
+ *              the record is pinned by someone else, no frame can be freed
+ *              or the read fails.
+ *
+ ****************************************************************************/
+void *buffer_pool_pin(db_storage_id_t fd, unsigned long offset, unsigned length)
+{
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames == NULL || length > DB_BUFFER_PAGE_SIZE) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	frame = frame_find(fd, offset);
+	if (frame != NULL) {
+		if (frame->state & FRAME_STATE_PINNED) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return NULL;
+		}
+		if (frame->length < length) {
+			/* Cached shorter: read the rest, the cached part may be newer */
+			if (DB_ERROR(storage_read_from(fd, frame->data + frame->length, offset + frame->length, length - frame->length))) {
+				DB_LOG_E("DB: Failed to read %u bytes at %lu of fd %d\n", length - frame->length, offset + frame->length, fd);
+				pthread_mutex_unlock(&g_buffer_pool.lock);
+				return NULL;
+			}
+			frame->length = length;
+		}
+	} else {
+		frame = frame_alloc();
+		if (frame == NULL) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return NULL;
+		}
+		if (DB_ERROR(storage_read_from(fd, frame->data, offset, length))) {
+			DB_LOG_E("DB: Failed to read %u bytes at %lu of fd %d\n", length, offset, fd);
+			frame_discard(frame);
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return NULL;
+		}
+		frame->fd = fd;
+		frame->offset = offset;
+		frame->length = length;
+		frame->state = FRAME_STATE_VALID;
+	}
+	frame->state |= FRAME_STATE_PINNED;
+	frame_touch(frame);
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+
+	return frame->data;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_put
+ *
+ * Description: Stores a new content for the record at offset in fd. It is
+ *              written to storage later, when the frame is evicted or
+ *              flushed. A pinned copy of the record is replaced and unpinned.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_put(db_storage_id_t fd, unsigned long offset, void *data, unsigned length)
+{
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames == NULL || length > DB_BUFFER_PAGE_SIZE) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	frame = frame_find(fd, offset);
+	if (frame == NULL) {
+		frame = frame_alloc();
+		if (frame == NULL) {
+			pthread_mutex_unlock(&g_buffer_pool.lock);
+			return DB_FULL_ERROR;
+		}
+		frame->fd = fd;
+		frame->offset = offset;
+	}
+	/* data may be the discarded copy of the record in this very frame */
+	memmove(frame->data, data, length);
+	frame->length = length;
+	frame->state = FRAME_STATE_VALID | FRAME_STATE_DIRTY;
+	frame_touch(frame);
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+
+	return DB_OK;
+}
+
+db_result_t buffer_pool_mark_dirty(db_storage_id_t fd, unsigned long offset)
+{
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	frame = frame_find(fd, offset);
+	if (frame != NULL) {
+		frame->state |= FRAME_STATE_DIRTY;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+
+	return frame != NULL ? DB_OK : DB_ARGUMENT_ERROR;
+}
+
+db_result_t buffer_pool_unpin(db_storage_id_t fd, unsigned long offset)
+{
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	frame = frame_find(fd, offset);
+	if (frame != NULL) {
+		frame->state &= ~FRAME_STATE_PINNED;
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+
+	return frame != NULL ? DB_OK : DB_ARGUMENT_ERROR;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_invalidate
+ *
+ * Description: Forgets the cached copy of a record without writing it back.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_invalidate(db_storage_id_t fd, unsigned long offset)
+{
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	frame = frame_find(fd, offset);
+	if (frame != NULL) {
+		frame_discard(frame);
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+
+	return frame != NULL ? DB_OK : DB_ARGUMENT_ERROR;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_flush
+ *
+ * Description: Writes back every modified record of fd, or of all files
+ *              when fd is INVALID_STORAGE_ID. The records stay cached.
+ *
+ ****************************************************************************/
+db_result_t buffer_pool_flush(db_storage_id_t fd)
+{
+	int i;
+	buffer_frame_t *frame;
+	db_result_t result = DB_OK;
+
+	if (g_buffer_pool.frames == NULL) {
+		return DB_OK;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	for (i = 0; i < DB_BUFFER_POOL_SIZE; i++) {
+		frame = &g_buffer_pool.frames[i];
+		if ((frame->state & FRAME_STATE_VALID) && (fd == INVALID_STORAGE_ID || frame->fd == fd)) {
+			if (DB_ERROR(frame_write_back(frame))) {
+				result = DB_STORAGE_ERROR;
+			}
+		}
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+
+	return result;
+}
+
+/****************************************************************************
+ * Name: buffer_pool_drop
+ *
+ * Description: Writes back and forgets every record of fd. Called before
+ *              fd is closed, as the descriptor may be reused for another
+ *              file afterwards.
+ *
+ ****************************************************************************/
+void buffer_pool_drop(db_storage_id_t fd)
+{
+	int i;
+	buffer_frame_t *frame;
+
+	if (g_buffer_pool.frames == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&g_buffer_pool.lock);
+	for (i = 0; i < DB_BUFFER_POOL_SIZE; i++) {
+		frame = &g_buffer_pool.frames[i];
+		if ((frame->state & FRAME_STATE_VALID) && frame->fd == fd) {
+			if (frame->state & FRAME_STATE_PINNED) {
+				DB_LOG_E("DB: Dropping a pinned record at %lu of fd %d\n", frame->offset, fd);
+			}
+			frame_write_back(frame);
+			frame_discard(frame);
+		}
+	}
+	pthread_mutex_unlock(&g_buffer_pool.lock);
+}
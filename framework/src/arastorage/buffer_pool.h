@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __BUFFER_POOL_H__
+#define __BUFFER_POOL_H__
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <arastorage/arastorage.h>
+#include "db_options.h"
+
+/****************************************************************************
+* Global Function Prototypes
+****************************************************************************/
+db_result_t buffer_pool_init(void);
+void buffer_pool_deinit(void);
+
+void *buffer_pool_pin(db_storage_id_t fd, unsigned long offset, unsigned length);
+db_result_t buffer_pool_put(db_storage_id_t fd, unsigned long offset, void *data, unsigned length);
+db_result_t buffer_pool_mark_dirty(db_storage_id_t fd, unsigned long offset);
+db_result_t buffer_pool_unpin(db_storage_id_t fd, unsigned long offset);
+db_result_t buffer_pool_invalidate(db_storage_id_t fd, unsigned long offset);
+db_result_t buffer_pool_flush(db_storage_id_t fd);
+void buffer_pool_drop(db_storage_id_t fd);
+
+#endif							/* __BUFFER_POOL_H__ */
@@ -28,11 +28,38 @@
 #include "db_debug.h"
 #include "storage.h"
 #include "relation.h"
+#include "aql.h"
 
 /****************************************************************************
 * Public Functions
 ****************************************************************************/
 
+/* Read rows from the query until the cursor holds (row_id + 1) rows or all
+   rows are read. Passing INVALID_TUPLE reads all the remaining rows. */
+db_result_t cursor_fetch(db_cursor_t *cursor, tuple_id_t row_id)
+{
+	db_result_t res;
+
+	if (cursor == NULL) {
+		return DB_CURSOR_ERROR;
+	}
+
+	while (cursor->handle != NULL && (row_id == INVALID_TUPLE || cursor->cursor_rows <= row_id)) {
+		res = relation_process(&cursor->handle, cursor);
+		if (DB_ERROR(res)) {
+			DB_LOG_E("DB: Failed to process tuples : %d\n", res);
+			aql_deinit_handle(&cursor->handle);
+			return res;
+		}
+		if (res == DB_FINISHED) {
+			/* All rows are known, release the relation */
+			aql_deinit_handle(&cursor->handle);
+		}
+	}
+
+	return DB_OK;
+}
+
 /* Update current cursor id and storage id. */
 db_result_t cursor_move_to(db_cursor_t *cursor, tuple_id_t row_id)
 {
@@ -41,7 +68,11 @@ db_result_t cursor_move_to(db_cursor_t *cursor, tuple_id_t row_id)
 		return DB_CURSOR_ERROR;
 	}
 
-	if (row_id >= DB_CURSOR_RESULT_ENTRY || row_id >= cursor->cursor_rows) {
+	if (row_id >= cursor->cursor_rows && DB_ERROR(cursor_fetch(cursor, row_id))) {
+		return DB_CURSOR_ERROR;
+	}
+
+	if (row_id >= cursor->cursor_rows) {
 		DB_LOG_E("invalid row id\n");
 		return DB_CURSOR_ERROR;
 	}
@@ -49,8 +80,15 @@ db_result_t cursor_move_to(db_cursor_t *cursor, tuple_id_t row_id)
 	int i, index, pos;
 	int cnt = 0;
 
+	/* Moving forward, search from the current row instead of the first one */
+	i = 0;
+	if (cursor->current_cursor_row < cursor->cursor_rows && row_id > cursor->current_cursor_row) {
+		i = cursor->current_storage_row + 1;
+		cnt = cursor->current_cursor_row + 1;
+	}
+
 	/* search (row_id)th set tuple id */
-	for (i = 0; i < cursor->total_rows; i++) {
+	for (; i < cursor->total_rows; i++) {
 		index = GET_INDEX(i);
 		pos = GET_POS(i);
 
@@ -80,6 +118,10 @@ db_result_t cursor_move_last(db_cursor_t *cursor)
 		return DB_CURSOR_ERROR;
 	}
 
+	if (DB_ERROR(cursor_fetch(cursor, INVALID_TUPLE))) {
+		return DB_CURSOR_ERROR;
+	}
+
 	return cursor_move_to(cursor, cursor->cursor_rows - 1);
 }
 
@@ -96,7 +138,7 @@ db_result_t cursor_move_next(db_cursor_t *cursor)
 /* Search previous set tuple id and update storage id corresponding it. */
 db_result_t cursor_move_prev(db_cursor_t *cursor)
 {
-	if (!cursor) {
+	if (!cursor || cursor->current_cursor_row == 0) {
 		return DB_CURSOR_ERROR;
 	}
 
@@ -145,6 +187,10 @@ bool cursor_is_last_row(db_cursor_t *cursor)
 	if (cursor == NULL) {
 		return false;
 	}
+	//the last row is known only when there is no more row to read
+	if (cursor->current_cursor_row == cursor->cursor_rows - 1 && DB_ERROR(cursor_fetch(cursor, cursor->cursor_rows))) {
+		return false;
+	}
 	//check whether pointing cursor id is correct
 	if (cursor->current_cursor_row != cursor->cursor_rows - 1) {
 		return false;
@@ -173,7 +219,7 @@ db_result_t cursor_data_add(db_cursor_t *cursor, tuple_id_t tuple_id)
 		return DB_CURSOR_ERROR;
 	}
 
-	if (tuple_id >= DB_CURSOR_RESULT_ENTRY || tuple_id >= cursor->total_rows) {
+	if (tuple_id >= cursor->total_rows) {
 		DB_LOG_E("invalid tuple id error\n");
 		return DB_CURSOR_ERROR;
 	}
@@ -189,9 +235,43 @@ db_result_t cursor_data_add(db_cursor_t *cursor, tuple_id_t tuple_id)
 	return DB_OK;
 }
 
+/* Keep the columns of a row built by an index-only scan, so it is not read from storage */
+db_result_t cursor_index_row_add(db_cursor_t *cursor, tuple_id_t tuple_id, unsigned char *row)
+{
+	unsigned char *to;
+	int i;
+
+	if (cursor == NULL || tuple_id >= cursor->total_rows) {
+		DB_LOG_E("invalid tuple id error\n");
+		return DB_CURSOR_ERROR;
+	}
+
+	if (cursor->index_rows == NULL) {
+		cursor->index_row_length = 0;
+		for (i = 0; i < cursor->attribute_count; i++) {
+			cursor->index_row_length += cursor->attr_map[i].data_size;
+		}
+		cursor->index_rows = (unsigned char *)malloc(cursor->index_row_length * cursor->total_rows);
+		if (cursor->index_rows == NULL) {
+			return DB_ALLOCATION_ERROR;
+		}
+	}
+	to = cursor->index_rows + tuple_id * cursor->index_row_length;
+	for (i = 0; i < cursor->attribute_count; i++) {
+		memcpy(to, row + cursor->attr_map[i].offset, cursor->attr_map[i].data_size);
+		to += cursor->attr_map[i].data_size;
+	}
+
+	return DB_OK;
+}
+
 /* Get the number of tuples in a cursor */
 cursor_row_t cursor_get_count(db_cursor_t *cursor)
 {
+	if (DB_ERROR(cursor_fetch(cursor, INVALID_TUPLE))) {
+		return INVALID_CURSOR_VALUE;
+	}
+
 	if (IS_EMPTY_CURSOR(cursor)) {
 		return INVALID_CURSOR_VALUE;
 	}
@@ -251,6 +331,7 @@ db_result_t cursor_get_value_storage(attribute_value_t *value, db_cursor_t *curs
 	int fd, offset;
 	attribute_t attr;
 	unsigned char *buf;
+	unsigned i;
 
 	if (col >= cursor->attribute_count) {
 		DB_LOG_E("DB: Requested value (%d) is out of bounds; max = (%d)\n", col, cursor->attribute_count);
@@ -262,8 +343,6 @@ db_result_t cursor_get_value_storage(attribute_value_t *value, db_cursor_t *curs
 		return DB_CURSOR_ERROR;
 	}
 
-	buf = cursor->tuple;
-
 	memcpy(attr.name, cursor->attr_map[col].name, sizeof(attr.name));
 	attr.domain = cursor->attr_map[col].domain;
 	attr.element_size = cursor->attr_map[col].data_size;
@@ -271,17 +350,31 @@ db_result_t cursor_get_value_storage(attribute_value_t *value, db_cursor_t *curs
 	if (cursor->attr_map[col].valuetype == AGGREGATE_VALUE) {
 		/* If the type of value is aggregate value, we don't need to read storage.
 		 Because aggregate result is already calculated and stored in buffer. */
-		buf += cursor->attr_map[col].offset;
+		buf = cursor->tuple + cursor->attr_map[col].offset;
+	} else if (cursor->index_rows != NULL) {
+		/* An index-only scan reads nothing but the key, whose columns the cursor keeps */
+		buf = cursor->index_rows + cursor->current_storage_row * cursor->index_row_length;
+		for (i = 0; i < col; i++) {
+			buf += cursor->attr_map[i].data_size;
+		}
 	} else {
-		/* Otherwise, Read tuple value from storage. */
-		offset = cursor->current_storage_row * cursor->storage_row_length + cursor->attr_map[col].offset;
-		fd = storage_open(cursor->name, O_RDONLY);
-		if (fd < 0) {
-			DB_LOG_E("failed to open storage %s\n", cursor->name);
-			return DB_CURSOR_ERROR;
+		/* Otherwise, Read the whole tuple from storage once for all its values. */
+		if (cursor->buffered_row != cursor->current_storage_row) {
+			offset = cursor->current_storage_row * cursor->storage_row_length;
+			fd = storage_open(cursor->name, O_RDONLY);
+			if (fd < 0) {
+				DB_LOG_E("failed to open storage %s\n", cursor->name);
+				return DB_CURSOR_ERROR;
+			}
+			if (DB_ERROR(storage_read_from(fd, cursor->row_buf, offset, cursor->storage_row_length))) {
+				storage_close(fd);
+				cursor->buffered_row = INVALID_TUPLE;
+				return DB_CURSOR_ERROR;
+			}
+			storage_close(fd);
+			cursor->buffered_row = cursor->current_storage_row;
 		}
-		storage_read_from(fd, buf, offset, attr.element_size);
-		storage_close(fd);
+		buf = cursor->row_buf + cursor->attr_map[col].offset;
 	}
 
 	return db_phy_to_value(value, &attr, buf);
@@ -411,6 +504,15 @@ void cursor_clean_data(db_cursor_t *cursor)
 		free(cursor->row_arr);
 	}
 	cursor->row_arr = NULL;
+	if (cursor->row_buf != NULL) {
+		free(cursor->row_buf);
+	}
+	cursor->row_buf = NULL;
+	if (cursor->index_rows != NULL) {
+		free(cursor->index_rows);
+	}
+	cursor->index_rows = NULL;
+	cursor->buffered_row = INVALID_TUPLE;
 }
 
 db_result_t cursor_init(db_cursor_t **cursor, relation_t *rel)
@@ -423,12 +525,15 @@ db_result_t cursor_init(db_cursor_t **cursor, relation_t *rel)
 	cursor_clean_data(*cursor);
 
 	arr_size = GET_CURSOR_DATA_ARR_SIZE(rel->cardinality);
-	if (arr_size > DB_CURSOR_LIMIT) {
+	(*cursor)->row_arr = (uint32_t *)malloc(sizeof(uint32_t) * arr_size);
+	if ((*cursor)->row_arr == NULL) {
 		return DB_CURSOR_ERROR;
 	}
 
-	(*cursor)->row_arr = (uint32_t *)malloc(sizeof(uint32_t) * arr_size);
-	if ((*cursor)->row_arr == NULL) {
+	(*cursor)->row_buf = (unsigned char *)malloc(rel->row_length + 1);
+	if ((*cursor)->row_buf == NULL) {
+		free((*cursor)->row_arr);
+		(*cursor)->row_arr = NULL;
 		return DB_CURSOR_ERROR;
 	}
 	memset((*cursor)->row_arr, 0, arr_size * sizeof(uint32_t));
@@ -446,10 +551,21 @@ db_result_t cursor_deinit(db_cursor_t *cursor)
 	if (cursor == NULL) {
 		return DB_CURSOR_ERROR;
 	}
+	if (cursor->handle) {
+		aql_deinit_handle(&cursor->handle);
+	}
 	if (cursor->row_arr) {
 		free(cursor->row_arr);
 		cursor->row_arr = NULL;
 	}
+	if (cursor->row_buf) {
+		free(cursor->row_buf);
+		cursor->row_buf = NULL;
+	}
+	if (cursor->index_rows) {
+		free(cursor->index_rows);
+		cursor->index_rows = NULL;
+	}
 	free(cursor);
 	return DB_OK;
 }
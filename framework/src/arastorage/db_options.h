@@ -127,6 +127,20 @@
 #define AQL_ATTRIBUTE_LIMIT             9
 #endif							/* AQL_ATTRIBUTE_LIMIT */
 
+/* The maximum number of '?' parameters in a prepared query. */
+#ifndef AQL_PARAMETER_LIMIT
+#define AQL_PARAMETER_LIMIT             8
+#endif							/* AQL_PARAMETER_LIMIT */
+
+/* The number of finalized prepared queries kept for reuse. */
+#ifndef AQL_STMT_CACHE_SIZE
+#ifdef CONFIG_ARASTORAGE_STMT_CACHE_SIZE
+#define AQL_STMT_CACHE_SIZE             CONFIG_ARASTORAGE_STMT_CACHE_SIZE
+#else
+#define AQL_STMT_CACHE_SIZE             4
+#endif
+#endif							/* AQL_STMT_CACHE_SIZE */
+
 /*----------------------------------------------------------------------------*/
 
 /*
@@ -163,23 +177,8 @@
 #define CONFIG_MOUNT_POINT "/mnt/"
 #endif
 
-/* The maximum number of tuples in a relation. */
-#ifndef DB_TUPLE_LIMIT
-#define DB_TUPLE_LIMIT          1000
-#endif							/* DB_TUPLE_LIMIT */
-
-/* The number of int array in a cursor. */
-#ifndef DB_CURSOR_LIMIT
-#define DB_CURSOR_LIMIT          ((DB_TUPLE_LIMIT / (sizeof(uint32_t)*8)) + 1)
-#endif							/* DB_CURSOR_LIMIT */
-
-/* The maximum number of tuples in a cursor. */
-#ifndef DB_CURSOR_RESULT_ENTRY
-#define DB_CURSOR_RESULT_ENTRY          ((DB_CURSOR_LIMIT) * (sizeof(uint32_t)*8))
-#endif							/* DB_CURSOR_RESULT_ENTRY */
-
-/* The name of the intermediate "result" relation file, which is used
-   for presenting the result of a query to a user. */
+/* The name of the in-memory "result" relation, which describes the
+   attributes of a query result presented to a user. */
 #ifndef RESULT_RELATION
 #define RESULT_RELATION "db-res"
 #endif							/* RESULT_RELATION */
@@ -208,6 +207,23 @@
 #define TEMP_FILE_SUFFIX ".tmp"
 
 #define TEMP_FILE_SUFFIX_LENGTH 4
+
+/* The redo log of the ongoing transaction. */
+#define TRANSACTION_LOG_FILE "txn.log"
+/*----------------------------------------------------------------------------*/
+
+/* Transaction options. */
+
+/* The maximum number of relations a transaction may insert into. */
+#ifndef DB_TRANSACTION_RELATION_LIMIT
+#define DB_TRANSACTION_RELATION_LIMIT   4
+#endif							/* DB_TRANSACTION_RELATION_LIMIT */
+
+/* The number of index entries sorted together when a transaction is
+   committed. */
+#ifndef DB_TRANSACTION_SORT_LIMIT
+#define DB_TRANSACTION_SORT_LIMIT       128
+#endif							/* DB_TRANSACTION_SORT_LIMIT */
 /*----------------------------------------------------------------------------*/
 
 /* Index options. */
@@ -216,19 +232,37 @@
 #define DB_INDEX_COST                   64
 #endif							/* DB_INDEX_COST */
 
+/* The maximum number of attributes in the key of an index. */
+#ifndef DB_INDEX_ATTRIBUTE_LIMIT
+#define DB_INDEX_ATTRIBUTE_LIMIT        4
+#endif							/* DB_INDEX_ATTRIBUTE_LIMIT */
+
+/* The maximum length of an encoded index key. An INT takes 2 bytes, a LONG
+   4 bytes and a STRING its characters and a terminating NUL. */
+#ifndef DB_INDEX_KEY_LENGTH
+#define DB_INDEX_KEY_LENGTH             32
+#endif							/* DB_INDEX_KEY_LENGTH */
+
 /* The maximum number of Maxheap indexes. */
 #ifndef DB_HEAP_INDEX_LIMIT
 #define DB_HEAP_INDEX_LIMIT             1
 #endif							/* DB_HEAP_INDEX_LIMIT */
 
-/* The maximum number of buckets cached in the MaxHeap index. */
-#ifndef DB_HEAP_CACHE_LIMIT
-#define DB_HEAP_CACHE_LIMIT             6
-#endif							/* DB_HEAP_CACHE_LIMIT */
-
-#ifndef DB_TREE_CACHE_LIMIT
-#define DB_TREE_CACHE_LIMIT             10
+/* The number of frames in the buffer pool shared by all open index and
+   tuple files. */
+#ifndef DB_BUFFER_POOL_SIZE
+#ifdef CONFIG_ARASTORAGE_BUFFER_POOL_SIZE
+#define DB_BUFFER_POOL_SIZE             CONFIG_ARASTORAGE_BUFFER_POOL_SIZE
+#else
+#define DB_BUFFER_POOL_SIZE             16
 #endif
+#endif							/* DB_BUFFER_POOL_SIZE */
+
+/* The size of a buffer pool frame. It must hold a bplus-tree bucket;
+   tuple rows longer than this bypass the pool. */
+#ifndef DB_BUFFER_PAGE_SIZE
+#define DB_BUFFER_PAGE_SIZE             512
+#endif							/* DB_BUFFER_PAGE_SIZE */
 
 #ifdef DB_WIP
 #undef DB_WIP						/* DB WORK IN PROGRESS */
@@ -68,6 +68,8 @@
 #define INDEX_API_INLINE        0x04
 #define INDEX_API_COMPLETE      0x08
 #define INDEX_API_RANGE_QUERIES 0x10
+#define INDEX_API_COVERING      0x20	/* get_next sets the key of the returned tuple */
+#define INDEX_API_COMPOSITE     0x40	/* Keys of several attributes and of strings */
 
 /****************************************************************************
 * Public Type Definitions
@@ -91,26 +93,48 @@ struct index_s {
 	struct index_s *next;
 	char descriptor_file[DB_MAX_FILENAME_LENGTH];
 	relation_t *rel;
-	attribute_t *attr;
+	attribute_t *attr;			/* The first key attribute, which refers to the index */
+	attribute_t *attrs[DB_INDEX_ATTRIBUTE_LIMIT];	/* The key attributes in key order */
+	uint16_t offsets[DB_INDEX_ATTRIBUTE_LIMIT];	/* Offsets of the key attributes in a row */
 	struct index_api_s *api;
 	void *opaque_data;
 	index_type_t type;
 	index_state_t state;
 	uint8_t ref_cnt;
-	uint8_t reserved[3];
+	uint8_t attr_count;
+	uint8_t reserved[2];
 };
 typedef struct index_s index_t;
 
 
 struct index_iterator_s {
 	index_t *index;
-	attribute_value_t min_value;
+	attribute_value_t min_value;	/* Range of the first key attribute */
 	attribute_value_t max_value;
 	tuple_id_t next_item_no;
 	tuple_id_t found_items;
+	unsigned char min_key[DB_INDEX_KEY_LENGTH];	/* Encoded bounds of the range. A key is */
+	unsigned char max_key[DB_INDEX_KEY_LENGTH];	/* compared over the length of a bound */
+	uint8_t min_length;
+	uint8_t max_length;
+	uint8_t empty;				/* No key can be in the range */
+	uint8_t key_length;
+	unsigned char key[DB_INDEX_KEY_LENGTH];	/* Encoded key of the last tuple returned */
+	uint16_t page;				/* Position of the next entry, kept by the index */
+	uint16_t offset;
+	uint16_t version;
+	tuple_id_t last_tuple;
 };
 typedef struct index_iterator_s index_iterator_t;
 
+/* A key and the tuple it points to, as given to index_insert_batch() */
+struct index_entry_s {
+	unsigned char key[DB_INDEX_KEY_LENGTH];
+	uint8_t key_length;
+	tuple_id_t tuple_id;
+};
+typedef struct index_entry_s index_entry_t;
+
 struct index_api_s {
 	index_type_t type;
 	uint8_t flags;
@@ -118,9 +142,20 @@ struct index_api_s {
 	db_result_t(*destroy)(index_t *);
 	db_result_t(*load)(index_t *);
 	db_result_t(*release)(index_t *);
-	db_result_t(*insert)(index_t *, attribute_value_t *, tuple_id_t);
-	db_result_t(*delete)(index_t *, attribute_value_t *);
+	/* The key is encoded by index_key_from_row() */
+	db_result_t(*insert)(index_t *, unsigned char *, unsigned, tuple_id_t);
+	db_result_t(*delete)(index_t *, unsigned char *, unsigned, tuple_id_t);
 	tuple_id_t(*get_next)(index_iterator_t *, uint8_t);
+	db_result_t(*flush)(index_t *);
+	unsigned long (*cost)(index_t *, unsigned long);
+	/* Builds an empty index from entries sorted by key and tuple id. DB_LIMIT_ERROR
+	   means the index was left as it is and the entries must be inserted
+	   one by one: the index is not empty, or the entries need more pages
+	   than the index is configured with. DB_STORAGE_ERROR means a page
+	   could not be written and the index was reset to empty; DB_INDEX_ERROR
+	   means the reset failed too and the index must be rebuilt. NULL if the
+	   index cannot bulk load. */
+	db_result_t(*bulk_load)(index_t *, index_entry_t *, int);
 };
 
 typedef struct index_api_s index_api_t;
@@ -135,14 +170,20 @@ extern index_api_t index_bplustree;
  * Internal function prototypes
  ****************************************************************************/
 db_result_t index_init(void);
-db_result_t index_create(index_type_t, relation_t *, attribute_t *);
+db_result_t index_create(index_type_t, relation_t *, attribute_t **, int);
 db_result_t index_destroy(index_t *);
 db_result_t index_load(relation_t *, attribute_t *);
 db_result_t index_release(index_t *);
-db_result_t index_insert(index_t *, attribute_value_t *, tuple_id_t);
-db_result_t index_delete(index_t *, attribute_value_t *);
-db_result_t index_get_iterator(index_iterator_t *, index_t *, attribute_value_t *, attribute_value_t *);
+db_result_t index_insert(index_t *, unsigned char *, tuple_id_t);
+db_result_t index_insert_batch(index_t *, index_entry_t *, int);
+db_result_t index_flush(index_t *);
+db_result_t index_delete(index_t *, unsigned char *, tuple_id_t);
+db_result_t index_get_iterator(index_iterator_t *, index_t *, attribute_value_t *, attribute_value_t *, int);
 tuple_id_t index_get_next(index_iterator_t *, uint8_t);
+unsigned long index_cost(index_t *, unsigned long);
 int index_exists(attribute_t *);
+int index_key_from_row(index_t *, unsigned char *, unsigned char *);
+db_result_t index_key_to_row(index_t *, unsigned char *, unsigned, unsigned char *);
+int index_has_attribute(index_t *, attribute_t *);
 db_result_t index_deinit(void);
 #endif							/* !INDEX_H */
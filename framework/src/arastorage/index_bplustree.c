@@ -53,7 +53,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
-#include <pthread.h>
 #include <time.h>
 #include <sys/types.h>
 
@@ -61,6 +60,7 @@
 #include "db_options.h"
 #include "db_debug.h"
 #include "storage.h"
+#include "buffer_pool.h"
 #include "random.h"
 #include "rw_locks.h"
 
@@ -69,256 +69,233 @@
  ****************************************************************************/
 #define BRANCH_FACTOR CONFIG_BRANCH_FACTOR
 #define DB_TUPLES_LIMIT CONFIG_DB_TUPLES_LIMIT
-#define PG_SIZE        1*sizeof(struct key_value_pair)
-#define BUCKET_SIZE      48
-#define NODE_DEPTH      2
-#define LEAF_NODES      pow(BRANCH_FACTOR, NODE_DEPTH)
-#define EMPTY_NODE(node)        (node)->val[BRANCH_FACTOR-1] == 0
-#define KEY_MAX INT_MAX
-#define ROW_XOR 0xf6U
-#define NODE_STATE_VALID 1
-#define NODE_STATE_LOCK 2
-#define NODE_STATE_DIRTY 4
-#define ROOT_NODE_PARENT 255
-
-/* The total number of states possible of a node */
-#define NODE_STATES 255
-#define CONFIG_VACUUM_THRESHOLD 40
-
-#ifdef CONFIG_ARASTORAGE_ENABLE_VACUUM
-#define VACUUM_THRESHOLD CONFIG_VACUUM_THRESHOLD
-#endif
 
-#define max(a, b) ({ __typeof__(a) _a = (a);  __typeof__(b) _b = (b); _a > _b ? _a : _b; })
 #define min(a, b) ({ __typeof__(a) _a = (a);  __typeof__(b) _b = (b); _a < _b ? _a : _b; })
 
-#define SET_NODE_STATE(node, type) \
-	do { \
-		node->node_state |= type; \
-	} while (0)
-
-#define UNSET_NODE_STATE(node, type) \
-	do { \
-		node->node_state &= ((type) ^ NODE_STATES); \
-	} while (0)
-
-#define REMOVE_ENTRY(node) \
-	do { \
-		node->prev->next = node->next; \
-		node->next->prev = node->prev; \
-	} while (0)
-
-#define PLACE_AT_HEAD(node, cache_type) \
-	do { \
-		cache_type->in_cache.head->next->prev = node; \
-		node->next = cache_type->in_cache.head->next; \
-		node->prev = cache_type->in_cache.head; \
-		cache_type->in_cache.head->next = node; \
-	} while (0)
-
-#define PLACE_AT_TAIL(node, cache_type) \
-	do { \
-		cache_type->in_cache.tail->prev->next = node; \
-		node->next = cache_type->in_cache.tail; \
-		node->prev = cache_type->in_cache.tail->prev; \
-		cache_type->in_cache.tail->prev = node; \
-	} while (0)
+/* Written first in the descriptor file. Files of the former format of
+   fixed integer keys do not start with it and are not loaded. */
+#define TREE_MAGIC        0x42707432
+
+/* No page: the end of the bucket chain or of a free list */
+#define PAGE_NONE         0xffff
+
+/* Nodes on the way from the root to a bucket */
+#define TREE_LEVEL_LIMIT  8
+
+/*
+ * Nodes and buckets are pages of sorted entries. The key prefix shared by
+ * all entries of a page is stored once at the start of its data, followed
+ * by each entry: the length of the rest of its key, the rest of its key,
+ * the tuple id and, in a node, the child holding the entries from this one
+ * up to the next. Entries are ordered by key and then by tuple id, so that
+ * entries of equal keys are told apart and can be split between pages.
+ */
+#define TUPLE_ID_SIZE     4
+#define CHILD_SIZE        2
+#define ENTRY_MAX         (1 + DB_INDEX_KEY_LENGTH + TUPLE_ID_SIZE + CHILD_SIZE)
+
+/* A node holds BRANCH_FACTOR - 1 of the longest keys, and more of shorter
+   keys or of keys sharing a prefix. A split needs room for three. */
+#define PAGE_HEADER_SIZE  8
+#define NODE_DATA_SIZE    ((BRANCH_FACTOR - 1) * ENTRY_MAX)
+#define NODE_SIZE         (PAGE_HEADER_SIZE + NODE_DATA_SIZE)
+#define BUCKET_SIZE       DB_BUFFER_PAGE_SIZE
+#define BUCKET_DATA_SIZE  (BUCKET_SIZE - PAGE_HEADER_SIZE)
+
+#if BRANCH_FACTOR < 4
+#error "CONFIG_BRANCH_FACTOR must be at least 4"
+#endif
+
+/* Nodes and buckets are cached in buffer pool frames */
+#if PAGE_HEADER_SIZE + (BRANCH_FACTOR - 1) * ENTRY_MAX > DB_BUFFER_PAGE_SIZE
+#error "A node of CONFIG_BRANCH_FACTOR does not fit in a buffer pool page"
+#endif
+
+/* Every entry takes at least its length byte and its tuple id */
+#define PAGE_ENTRY_LIMIT  (BUCKET_DATA_SIZE / (1 + TUPLE_ID_SIZE))
+
+/* Pages built by bulk_load are left a quarter empty for later inserts */
+#define BULK_FILL(type)   (g_kinds[type].size * 3 / 4)
+
+/* A bucket less full than this is merged with a sibling where they fit */
+#define MERGE_FILL        (BUCKET_DATA_SIZE / 4)
+
+/* Location of pages in the descriptor and bucket files. The descriptor file
+   starts with the tree header, the bucket file name and the key attributes. */
+#define NODES_OFFSET      (sizeof(struct tree_header_s) + DB_MAX_FILENAME_LENGTH + DB_INDEX_ATTRIBUTE_LIMIT * ATTRIBUTE_NAME_LENGTH)
+#define NODE_OFFSET(id)   (NODES_OFFSET + (unsigned long)(id) * NODE_SIZE)
+#define BUCKET_OFFSET(id) ((unsigned long)(id) * BUCKET_SIZE)
 
 /****************************************************************************
  * Private Types
  ****************************************************************************/
-struct key_value_pair_s {
-	int key;
-	uint16_t value;
-};
-typedef struct key_value_pair_s pair_t;
+typedef enum {
+	NODE = 0,
+	BUCKET = 1
+} page_type_t;
 
-struct tree_node_s {
-	int val[BRANCH_FACTOR];
-	uint16_t id[BRANCH_FACTOR];
-	uint16_t is_leaf;
+enum page_result_e {
+	PAGE_OK = 0,
+	PAGE_FULL = -1,
+	PAGE_ERROR = -2
 };
-typedef struct tree_node_s tree_node_t;
+typedef enum page_result_e page_result_t;
 
-struct bucket_s {
-	pair_t pairs[BUCKET_SIZE];
-	uint8_t next_free_slot;
-	int info[3];
-};
-typedef struct bucket_s bucket_t;
-
-struct qnode_s {
-	struct qnode_s *next;
-	struct qnode_s *prev;
-	uint8_t id;
-	uint8_t pos;
-	uint8_t node_state;
+enum tree_result_e {
+	TREE_LOCK_ERROR = -3,
+	TREE_READ_FAIL = -2,
+	TREE_INSERT_FAIL = -1,
+	TREE_OK = 0
 };
+typedef enum tree_result_e tree_result_t;
 
-typedef struct qnode_s qnode_t;
-struct queue_s {
-	qnode_t *head;
-	qnode_t *tail;
+struct page_header_s {
+	uint16_t link;				/* Node: first child. Bucket: next bucket. Free page: next free page */
+	uint16_t used;				/* Bytes of data in use, the prefix included */
+	uint8_t count;				/* Entries */
+	uint8_t prefix;				/* Length of the key prefix shared by the entries */
+	uint8_t is_leaf;			/* The children of the node are buckets */
+	uint8_t reserved;
 };
-typedef struct queue_s queue_t;
 
-/* A Bucket Cache Entry */
-struct bucket_cache_s {
-	bucket_t bucket;
-};
+/* Fails to compile if PAGE_HEADER_SIZE is not the size of the header */
+typedef char page_header_size_check[sizeof(struct page_header_s) == PAGE_HEADER_SIZE ? 1 : -1];
 
-/* A Tree Cache Entry */
-struct tree_cache_s {
-	tree_node_t node;
+/* A node is read into the start of a page and only uses NODE_DATA_SIZE bytes */
+struct page_s {
+	struct page_header_s hdr;
+	uint8_t data[BUCKET_DATA_SIZE];
 };
+typedef struct page_s page_t;
 
-/* Bucket Cache Structure */
-typedef struct {
-	struct bucket_cache_s cache_t[DB_HEAP_CACHE_LIMIT];
-	queue_t in_cache;
-	uint8_t num;
-} bucket_cache_t;
+struct page_kind_s {
+	uint16_t size;				/* Bytes of data */
+	uint8_t value_size;			/* Bytes after the key of an entry */
+};
 
-/* Tree Cache Structure */
-typedef struct {
-	struct tree_cache_s cache_t[DB_TREE_CACHE_LIMIT];
-	queue_t in_cache;
-	uint8_t num;
-} tree_cache_t;
+/* An entry with its whole key */
+struct entry_s {
+	uint8_t key[DB_INDEX_KEY_LENGTH];
+	uint8_t length;
+	tuple_id_t tuple_id;
+	uint16_t child;
+};
 
-typedef enum {
-	NODE = 0,
-	BUCKET = 1
-} cache_type_t;
+/* A searched key. With any_tuple set it is before all entries of the key. */
+struct probe_s {
+	const uint8_t *key;
+	unsigned length;
+	tuple_id_t tuple_id;
+	uint8_t any_tuple;
+};
 
-typedef enum {
-	INVALIDATE = 0,
-	UNLOCK = 1,
-	DIRTY = 2
-} op_type_t;
-
-enum tsplit_status_e {
-	TSPLIT_ERROR = -1,
-	TSPLIT_FAIL,
-	TSPLIT_OK
+/* Where a probe falls in a page */
+struct slot_s {
+	unsigned rank;				/* Entries up to the probe */
+	unsigned offset;			/* Offset of the first entry after the probe */
+	unsigned last;				/* Offset of the last entry up to the probe */
+	uint16_t child;				/* Of a node, the child holding the probe */
+	uint8_t equal;				/* The last entry up to the probe is the probe */
 };
 
-typedef enum tsplit_status_e tsplit_status_t;
+/* The nodes from the root to a bucket, and the child taken in each */
+struct path_s {
+	uint16_t nodes[TREE_LEVEL_LIMIT];
+	uint8_t ranks[TREE_LEVEL_LIMIT];
+	uint8_t depth;
+	uint16_t bucket;
+};
 
-enum bsplit_status_e {
-	BSPLIT_RETRY = -1,
-	BSPLIT_FAIL,
-	BSPLIT_OK
+/* Walks the entries of a page with one more entry put in at rank */
+struct merge_s {
+	const page_t *page;
+	page_type_t type;
+	unsigned offset;
+	unsigned index;
+	unsigned rank;
+	const struct entry_s *entry;
 };
 
-enum cache_result_e {
-	CACHE_FULL = 1,
-	CACHE_OK = 0,
-	CACHE_NOT_EXIST = -1,
-	CACHE_ALLOCATION_ERROR = -2,
-	CACHE_BUCKET_FULL = -3,
-	CACHE_UNLOCKED = -4
+/* Scratch space of an insert, allocated before the tree is changed */
+struct split_s {
+	page_t halves[2];
+	uint8_t lengths[PAGE_ENTRY_LIMIT + 1];
+	uint8_t common[PAGE_ENTRY_LIMIT + 1];
+	uint8_t tail[PAGE_ENTRY_LIMIT + 1];
+	uint16_t sums[PAGE_ENTRY_LIMIT + 2];
 };
 
-enum tree_result_e {
-	TREE_LOCK_ERROR = -3,
-	TREE_READ_FAIL = -2,
-	TREE_INSERT_FAIL = -1,
-	TREE_OK = 0
+/* Tree metadata, stored at the start of the descriptor file */
+struct tree_header_s {
+	uint32_t magic;
+	uint16_t root;				/* The node id of the root of the bplus-tree */
+	uint16_t off_nodes;			/* Nodes and buckets ever used, the free ones included */
+	uint16_t off_buckets;
+	uint16_t free_node;			/* First page of the lists of freed nodes and buckets */
+	uint16_t free_bucket;
+	uint16_t free_nodes;		/* Pages in the free lists */
+	uint16_t free_buckets;
+	uint16_t entries;			/* Entries in the buckets */
+	uint16_t inserted;			/* Count of total number of tuples inserted */
+	uint16_t deleted;			/* Count of total number of tuples deleted */
+	uint8_t levels;				/* The depth of the bplus-tree including the buckets */
+	uint8_t attr_count;			/* Key attributes, whose names follow the bucket file name */
 };
-typedef enum bsplit_status_e bsplit_status_t;
-typedef enum cache_result_e cache_result_t;
-typedef enum tree_result_e tree_result_t;
 
 /* Tree Metadata maintained in RAM */
 struct tree_s {
+	struct tree_header_s hdr;
 	db_storage_id_t tree_storage;	/* The fd to tree storage file */
 	db_storage_id_t bucket_storage;	/* The fd to bucket storage file */
-	uint8_t off_nodes, off_buckets;	/*  Maintaining number of nodes and buckets used by the index structure */
-	uint8_t root;				/*   The node id of the root of the bplus-tree */
-	uint8_t lock_buckets[CONFIG_BUCKETS_LIMIT];	/* The structure to prevent to tasks to simultaneously edit same buckets  */
-	uint16_t inserted;			/*  Count of total number of tuples inserted  */
-	uint16_t deleted;			/*    Count of total number of tuples deleted  */
-	uint8_t levels;				/*  The depth of the bplus-tree including the buckets  */
-	tree_cache_t *node_cache;	/*  Structure to maintain node cache  */
-	bucket_cache_t *buck_cache;	/*   Structure to maintain bucket cache  */
-	pthread_mutex_t node_cache_lock;	/*  Maintains concurrency control over Node Cache  */
-	pthread_mutex_t buck_cache_lock;	/*  Maintains concurrency control over Bucket Cache  */
-	pthread_mutex_t bucket_lock;	/*  Maintains serialisability over in RAM Tree Structure  */
-	struct rw_lock_s tree_lock;	/*  A Reader Writer Lock used to maintain consistency in tree structure */
+	uint16_t version;			/* Changed by every update, for iterators to find their place again */
+	struct rw_lock_s tree_lock;	/* A Reader Writer Lock used to maintain consistency in tree structure */
 };
 typedef struct tree_s tree_t;
 
-/****************************************************************************
- * Private variables
- ****************************************************************************/
-static int base_offset = 0;
-
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
-static int transform_key(int);
-static tree_node_t *tree_read(tree_t *, int);
-static int tree_write(tree_t *, int, tree_node_t *);
-static tree_result_t tree_insert(tree_t *, int);
-static pair_t *tree_find(tree_t *, int key);
-tree_result_t insert_item_btree(tree_t *, int, int);
-
-static bucket_t *bucket_read(tree_t *, int);
-static int bucket_write(tree_t *, int, bucket_t *);
-static bsplit_status_t bucket_split(tree_t *, int, int, pair_t *);
-static cache_result_t cache_bucket_append(tree_t *, int, pair_t *);
-static cache_result_t cache_write_bucket(tree_t *, int, bucket_t *);
-
-static cache_result_t modify_cache(tree_t *, int, cache_type_t, op_type_t);
-static cache_result_t cache_write_node(tree_t *, int, tree_node_t *);
-static cache_result_t cache_replace_node(tree_t *, int, tree_node_t *);
-static db_result_t delete_item_btree(index_t *index, int value);
-
 static db_result_t create(index_t *);
 static db_result_t destroy(index_t *);
 static db_result_t load(index_t *);
 static db_result_t release(index_t *);
-static db_result_t insert(index_t *, attribute_value_t *, tuple_id_t);
-static db_result_t delete(index_t *, attribute_value_t *);
+static db_result_t insert(index_t *, unsigned char *, unsigned, tuple_id_t);
+static db_result_t delete(index_t *, unsigned char *, unsigned, tuple_id_t);
 static tuple_id_t get_next(index_iterator_t *, uint8_t);
+static db_result_t flush(index_t *);
+static unsigned long cost(index_t *, unsigned long);
+static db_result_t bulk_load(index_t *, index_entry_t *, int);
 
-#ifdef DB_WIP
-static db_result_t vacuum(tree_t *, relation_t *);
-#endif
-/****************************************************************************
-* Private Functions
-****************************************************************************/
 #ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
 static int db_flush(tree_t *, relation_t *);
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static const struct page_kind_s g_kinds[2] = {
+	{ NODE_DATA_SIZE, TUPLE_ID_SIZE + CHILD_SIZE },
+	{ BUCKET_DATA_SIZE, TUPLE_ID_SIZE }
+};
+
 index_api_t index_bplustree = {
 	INDEX_BPLUSTREE,
-	INDEX_API_EXTERNAL | INDEX_API_RANGE_QUERIES,
+	INDEX_API_EXTERNAL | INDEX_API_RANGE_QUERIES | INDEX_API_COVERING | INDEX_API_COMPOSITE,
 	create,
 	destroy,
 	load,
 	release,
 	insert,
 	delete,
-	get_next
+	get_next,
+	flush,
+	cost,
+	bulk_load
 };
 
 /****************************************************************************
- * Name: compare
- *
- * Description: Comparator to sort the bucket entries before splitting the bucket
- *
+ * Private Functions
  ****************************************************************************/
-int compare(const void *p1, const void *p2)
-{
-	if (((pair_t *)p1)->key <= ((pair_t *)p2)->key) {
-		return -1;
-	}
-	return 1;
-}
-
 void* bptree_malloc(size_t size)
 {
 	void *p = malloc(size);
@@ -329,1620 +306,1455 @@ void* bptree_malloc(size_t size)
 }
 
 /****************************************************************************
- * Name: create
+ * Name: key_common
  *
- * Description: The function initialises all the structures required for the
- *              bplus-tree both in memory and on flash.
- *              The tree_filename, bucket_filename and tree structure are
- *              saved the flash and also in the index_t structure in RAM,
- *              The cache for both node and buckets is present in RAM and
- *              is de-allocated when the index exits in the release function
+ * Description: Returns the length of the prefix two keys share.
  *
  ****************************************************************************/
-static db_result_t create(index_t *index)
+static unsigned key_common(const uint8_t *key1, unsigned length1, const uint8_t *key2, unsigned length2)
 {
-	/* Files storing tree and bucket data */
-	char tree_filename[DB_MAX_FILENAME_LENGTH];
-	char bucket_filename[DB_MAX_FILENAME_LENGTH];
-	tree_node_t *tree_node;
-	size_t tree_node_size = 0;
-	bucket_t *buck;
-	size_t buck_size = 0;
-	int offset = 0;
-	db_result_t result;
-	uint8_t success = 0;
-	int curtime;
+	unsigned n = min(length1, length2);
+	unsigned i;
 
-	curtime = time(NULL);
-	random_init(curtime);
-	tree_t *tree = bptree_malloc(sizeof(tree_t));
-	if (tree == NULL) {
-		DB_LOG_E("DB: Failed to allocate a tree\n");
-		result = DB_ALLOCATION_ERROR;
-		return result;
+	for (i = 0; i < n && key1[i] == key2[i]; i++) ;
+	return i;
+}
 
-	}
+static unsigned entry_size(unsigned suffix, page_type_t type)
+{
+	return 1 + suffix + g_kinds[type].value_size;
+}
 
-	/* Generating the file to store the tree structure */
-	snprintf(tree_filename, HEAP_FILE_LENGTH, "%s.%x\0", HEAP_FILE_NAME, (unsigned)(random_rand() & 0xffff));
+static void put_u32(uint8_t *p, uint32_t value)
+{
+	p[0] = value >> 24;
+	p[1] = value >> 16;
+	p[2] = value >> 8;
+	p[3] = value;
+}
 
-	result = storage_generate_file(tree_filename);
-	if (result == DB_INDEX_ERROR) {
-		DB_LOG_E("DB: Failed to generate a tree file\n");
-		free(tree);
-		return result;
-	}
+static uint32_t get_u32(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
 
-	memcpy(index->descriptor_file, tree_filename, sizeof(index->descriptor_file));
-	tree_node_size = CONFIG_NODE_LIMIT * sizeof(tree_node_t);
-	DB_LOG_D("DB: Generated the tree file \"%s\" using %u bytes of space\n", index->descriptor_file, tree_node_size);
+/****************************************************************************
+ * Name: page_read
+ *
+ * Description: Reads the entry at offset with its whole key and returns the
+ *              offset of the next entry.
+ *
+ ****************************************************************************/
+static unsigned page_read(const page_t *page, page_type_t type, unsigned offset, struct entry_s *entry)
+{
+	const uint8_t *p = page->data + offset;
+	unsigned suffix = p[0];
+
+	memcpy(entry->key, page->data, page->hdr.prefix);
+	memcpy(entry->key + page->hdr.prefix, p + 1, suffix);
+	entry->length = page->hdr.prefix + suffix;
+	p += 1 + suffix;
+	entry->tuple_id = get_u32(p);
+	entry->child = type == NODE ? (p[TUPLE_ID_SIZE] << 8) | p[TUPLE_ID_SIZE + 1] : PAGE_NONE;
+	return offset + entry_size(suffix, type);
+}
 
-	/* Generating bucket file to store <key, tuple_id> pair */
-	snprintf(bucket_filename, BUCKET_FILE_LENGTH, "%s.%x\0", BUCKET_FILE_NAME, (unsigned)(random_rand() & 0xffff));
+/* Writes an entry without the prefix of the page and returns its size */
+static unsigned page_write(uint8_t *p, page_type_t type, unsigned prefix, const struct entry_s *entry)
+{
+	unsigned suffix = entry->length - prefix;
 
-	result = storage_generate_file(bucket_filename);
-	if (result == DB_INDEX_ERROR) {
-		DB_LOG_E("DB: Failed to generate a bucket file\n");
-		storage_remove(tree_filename);
-		free(tree);
-		return result;
+	p[0] = suffix;
+	memcpy(p + 1, entry->key + prefix, suffix);
+	p += 1 + suffix;
+	put_u32(p, entry->tuple_id);
+	if (type == NODE) {
+		p[TUPLE_ID_SIZE] = entry->child >> 8;
+		p[TUPLE_ID_SIZE + 1] = entry->child & 0xff;
 	}
-	buck_size = CONFIG_BUCKETS_LIMIT * sizeof(bucket_t);
-	DB_LOG_D("DB: Generated the bucket file \"%s\" using %u bytes of space\n", bucket_filename, buck_size);
+	return entry_size(suffix, type);
+}
 
-	/* Initialising both tree and bucket storage files */
-	tree->tree_storage = storage_open(tree_filename, O_RDWR);
-	if (tree->tree_storage < 0) {
-		result = DB_STORAGE_ERROR;
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		free(tree);
-		return result;
+/* Empties a page, keeping its links, with a prefix of the first length bytes of key */
+static void page_reset(page_t *page, const uint8_t *key, unsigned length)
+{
+	if (length > 0) {
+		memcpy(page->data, key, length);
 	}
-	tree->bucket_storage = storage_open(bucket_filename, O_RDWR);
-	if (tree->bucket_storage < 0) {
-		result = DB_STORAGE_ERROR;
-		storage_close(tree->tree_storage);
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		free(tree);
-		return result;
+	page->hdr.prefix = length;
+	page->hdr.used = length;
+	page->hdr.count = 0;
+}
 
-	}
-	storage_write_to(tree->tree_storage, tree, offset, sizeof(tree_t));
-	offset += sizeof(tree_t);
-	storage_write_to(tree->tree_storage, bucket_filename, offset, sizeof(bucket_filename));
-	offset += sizeof(bucket_filename);
-	base_offset = offset;
-	tree_node = bptree_malloc(tree_node_size);
-	if (tree_node) {
-		storage_write_to(tree->tree_storage, tree_node, offset, tree_node_size);
-		free(tree_node);
+/* Appends an entry starting with the prefix of the page and after all its entries */
+static void page_append(page_t *page, page_type_t type, const struct entry_s *entry)
+{
+	page->hdr.used += page_write(page->data + page->hdr.used, type, page->hdr.prefix, entry);
+	page->hdr.count++;
+}
+
+/****************************************************************************
+ * Name: page_find
+ *
+ * Description: Finds the entries of a page up to a probe, comparing the
+ *              probe with the prefix of the page once and then with the
+ *              rest of each key.
+ *
+ ****************************************************************************/
+static void page_find(const page_t *page, page_type_t type, const struct probe_s *probe, struct slot_s *slot)
+{
+	const uint8_t *p;
+	unsigned prefix = page->hdr.prefix;
+	unsigned offset;
+	unsigned suffix;
+	unsigned length;
+	tuple_id_t tuple_id;
+	int after;
+	int cmp;
+
+	slot->rank = 0;
+	slot->last = 0;
+	slot->child = page->hdr.link;
+	slot->equal = FALSE;
+	slot->offset = prefix;
+	if (page->hdr.count == 0) {
+		return;
 	}
 
-	buck = bptree_malloc(buck_size);
-	if (buck) {
-		buck[0].next_free_slot = 0;
-		buck[0].info[0] = CONFIG_BUCKETS_LIMIT - 1;
-		buck[0].info[1] = KEY_MAX;
-		buck[0].info[2] = 0;
-		storage_write_to(tree->bucket_storage, buck, 0, buck_size);
-		free(buck);
+	cmp = memcmp(probe->key, page->data, min(probe->length, prefix));
+	if (cmp < 0 || (cmp == 0 && probe->length < prefix)) {
+		/* Before every key of the page */
+		return;
 	}
-	
-	/* One is the root node and one is the bucket layer */
-	tree->levels = 2;
+	after = cmp > 0;
 
-	index->opaque_data = tree;
-	/* Initialize the tree metadata. */
-	memset(&tree->lock_buckets, 0, sizeof(tree->lock_buckets));
-
-	/* Allocating node cache and initialising it */
-	tree->node_cache = bptree_malloc(sizeof(tree_cache_t));
-	if (tree->node_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->node_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->node_cache->in_cache.tail = end;
-				tree->node_cache->num = 0;
+	for (offset = prefix; offset < page->hdr.used; offset += entry_size(suffix, type)) {
+		p = page->data + offset;
+		suffix = p[0];
+		if (!after) {
+			length = probe->length - prefix;
+			cmp = memcmp(probe->key + prefix, p + 1, min(length, suffix));
+			if (cmp == 0) {
+				cmp = length < suffix ? -1 : length > suffix;
 			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE NODE CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->node_cache->in_cache.head);
+			if (cmp == 0) {
+				tuple_id = get_u32(p + 1 + suffix);
+				cmp = probe->any_tuple || probe->tuple_id < tuple_id ? -1 : probe->tuple_id > tuple_id;
 			}
-			free(tree->node_cache);
-		}
-		free(tree);
-		return result;
-	}
-
-	/* Allocating bucket cache and initialising it */
-	tree->buck_cache = bptree_malloc(sizeof(bucket_cache_t));
-	success = 0;
-	if (tree->buck_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->buck_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->buck_cache->in_cache.tail = end;
-				tree->buck_cache->num = 0;
+			if (cmp < 0) {
+				break;
 			}
+			slot->equal = cmp == 0;
 		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE BUCKET CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		free(tree->node_cache->in_cache.tail);
-		free(tree->node_cache->in_cache.head);
-		free(tree->node_cache);
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->buck_cache->in_cache.head);
-			}
-			free(tree->buck_cache);
+		p += 1 + suffix;
+		slot->rank++;
+		slot->last = offset;
+		if (type == NODE) {
+			slot->child = (p[TUPLE_ID_SIZE] << 8) | p[TUPLE_ID_SIZE + 1];
 		}
-		free(tree);
-		return result;
 	}
+	slot->offset = offset;
+}
 
-	tree->inserted = 0;
-	tree->deleted = 0;
-
-	/* Initialising Locks for concurrency control */
-	pthread_mutex_init(&(tree->node_cache_lock), NULL);
-	pthread_mutex_init(&(tree->bucket_lock), NULL);
-	pthread_mutex_init(&(tree->buck_cache_lock), NULL);
-	rw_init(&(tree->tree_lock));
-
-	tree->off_nodes = tree->off_buckets = 0;
+static void merge_init(struct merge_s *merge, const page_t *page, page_type_t type, unsigned rank, const struct entry_s *entry)
+{
+	merge->page = page;
+	merge->type = type;
+	merge->offset = page->hdr.prefix;
+	merge->index = 0;
+	merge->rank = rank;
+	merge->entry = entry;
+}
 
-	/* Inserting first value to initialise the tree data structure */
-	if (tree_insert(tree, KEY_MAX) != TREE_OK) {
-		result = DB_STORAGE_ERROR;
-		return result;
+static void merge_next(struct merge_s *merge, struct entry_s *entry)
+{
+	if (merge->index++ == merge->rank) {
+		*entry = *merge->entry;
+		return;
 	}
-
-	DB_LOG_D("DB: Created a bplus-tree index\n");
-	result = DB_OK;
-	return result;
+	merge->offset = page_read(merge->page, merge->type, merge->offset, entry);
 }
 
-static db_result_t destroy(index_t *index)
+/****************************************************************************
+ * Name: page_insert
+ *
+ * Description: Puts an entry into a page after rank entries. If the entry
+ *              does not start with the prefix of the page, the prefix is
+ *              shortened and the page rewritten in scratch. PAGE_FULL is
+ *              returned, with the page unchanged, if the entry does not fit.
+ *
+ ****************************************************************************/
+static page_result_t page_insert(page_t *page, page_type_t type, unsigned rank, const struct entry_s *entry, page_t *scratch)
 {
-	db_storage_id_t fd;
-	size_t r;
-	char bucket_file[DB_MAX_FILENAME_LENGTH];
-	if (DB_ERROR(release(index))) {
-		return DB_INDEX_ERROR;
-	}
-	fd = storage_open(index->descriptor_file, O_RDWR);
-	if (fd < 0) {
-		return DB_STORAGE_ERROR;
-	}
-	if (DB_ERROR(storage_read_from(fd, bucket_file, sizeof(tree_t), sizeof(bucket_file)))) {
-		storage_close(fd);
-		return DB_STORAGE_ERROR;
-	}
-	storage_close(fd);
-	r = storage_remove(bucket_file);
-	if (DB_ERROR(r)) {
-		return DB_STORAGE_ERROR;
-	}
-	return DB_OK;
+	struct merge_s merge;
+	struct entry_s current;
+	unsigned prefix = page->hdr.prefix;
+	unsigned common;
+	unsigned offset;
+	unsigned size;
+	unsigned i;
+
+	if (page->hdr.count == 0) {
+		page_reset(page, entry->key, entry->length);
+		page_append(page, type, entry);
+		return PAGE_OK;
+	}
+	if (page->hdr.count >= PAGE_ENTRY_LIMIT) {
+		return PAGE_FULL;
+	}
+
+	common = key_common(entry->key, entry->length, page->data, prefix);
+	size = page->hdr.used + (page->hdr.count - 1) * (prefix - common) + entry_size(entry->length - common, type);
+	if (size > g_kinds[type].size) {
+		return PAGE_FULL;
+	}
+
+	if (common == prefix) {
+		offset = prefix;
+		for (i = 0; i < rank; i++) {
+			offset += entry_size(page->data[offset], type);
+		}
+		size = entry_size(entry->length - prefix, type);
+		memmove(page->data + offset + size, page->data + offset, page->hdr.used - offset);
+		page_write(page->data + offset, type, prefix, entry);
+		page->hdr.used += size;
+		page->hdr.count++;
+		return PAGE_OK;
+	}
+
+	if (scratch == NULL) {
+		return PAGE_ERROR;
+	}
+	scratch->hdr = page->hdr;
+	page_reset(scratch, entry->key, common);
+	merge_init(&merge, page, type, rank, entry);
+	for (i = 0; i <= page->hdr.count; i++) {
+		merge_next(&merge, &current);
+		page_append(scratch, type, &current);
+	}
+	memcpy(page, scratch, sizeof(struct page_header_s) + scratch->hdr.used);
+	return PAGE_OK;
 }
 
-static db_result_t load(index_t *index)
+/* Removes the entry at offset */
+static void page_remove(page_t *page, page_type_t type, unsigned offset)
 {
-	tree_t *tree;
-	db_storage_id_t fd;
-	char bucket_file[DB_MAX_FILENAME_LENGTH];
-	db_result_t result;
-	uint8_t success = 0;
+	unsigned size = entry_size(page->data[offset], type);
 
-	index->opaque_data = tree = bptree_malloc(sizeof(tree_t));
-	if (tree == NULL) {
-		DB_LOG_E("DB: Failed to allocate a tree while loading\n");
-		return DB_ALLOCATION_ERROR;
+	memmove(page->data + offset, page->data + offset + size, page->hdr.used - offset - size);
+	page->hdr.used -= size;
+	if (--page->hdr.count == 0) {
+		page_reset(page, NULL, 0);
 	}
+}
 
-	DB_LOG_D("load index : descriptor file name : %s\n", index->descriptor_file);
-	fd = storage_open(index->descriptor_file, O_RDWR);
-	if (fd < 0) {
-		DB_LOG_E("Failed opening index descriptor file :%s Error Code %d", index->descriptor_file);
-		free(tree);
-		return DB_STORAGE_ERROR;
-	}
-	if (DB_ERROR(storage_read_from(fd, bucket_file, sizeof(tree_t), sizeof(bucket_file)))) {
-		DB_LOG_E("Failed reading bucket file\n");
-		storage_close(fd);
-		free(tree);
-		return DB_STORAGE_ERROR;
-	}
-	if (DB_ERROR(storage_read_from(fd, tree, 0, sizeof(tree_t)))) {
-		DB_LOG_E("Failed  reading tree structure from descriptor file\n");
-		storage_close(fd);
-		free(tree);
-		return DB_STORAGE_ERROR;
+/****************************************************************************
+ * Name: page_split
+ *
+ * Description: Divides the entries of a full page and a new entry at rank
+ *              between a left and a right page, where the larger of them
+ *              is smallest. Each half gets the prefix its own keys share.
+ *              Of a node, the entry between the halves is kept in neither
+ *              but returned in middle to go up to the parent. Of a bucket,
+ *              middle is a copy of the first entry of the right half.
+ *
+ ****************************************************************************/
+static int page_split(const page_t *page, page_type_t type, unsigned rank, const struct entry_s *entry, struct split_s *split, struct entry_s *middle)
+{
+	struct merge_s merge;
+	struct entry_s previous;
+	struct entry_s current;
+	page_t *left = &split->halves[0];
+	page_t *right = &split->halves[1];
+	unsigned n = page->hdr.count + 1;
+	unsigned skip = type == NODE ? 1 : 0;
+	unsigned capacity = g_kinds[type].size;
+	unsigned best = 0;
+	unsigned best_size = UINT_MAX;
+	unsigned best_head = 0;
+	unsigned best_tail = 0;
+	unsigned head;
+	unsigned left_size;
+	unsigned right_size;
+	unsigned i;
+	unsigned m;
+
+	/* Key lengths, prefixes shared by neighbours and sizes without prefixes */
+	merge_init(&merge, page, type, rank, entry);
+	split->sums[0] = 0;
+	for (i = 0; i < n; i++) {
+		merge_next(&merge, &current);
+		split->lengths[i] = current.length;
+		split->sums[i + 1] = split->sums[i] + entry_size(current.length, type);
+		if (i > 0) {
+			split->common[i - 1] = key_common(previous.key, previous.length, current.key, current.length);
+		}
+		previous = current;
+	}
+
+	/* tail[i] is the prefix shared by the entries from i on */
+	split->tail[n - 1] = split->lengths[n - 1];
+	for (i = n - 1; i-- > 0;) {
+		split->tail[i] = min(split->common[i], split->tail[i + 1]);
+	}
+
+	head = split->lengths[0];
+	for (m = 1; m + skip < n; m++) {
+		if (m > 1) {
+			head = min(head, (unsigned)split->common[m - 2]);
+		}
+		left_size = head + split->sums[m] - m * head;
+		i = m + skip;
+		right_size = split->tail[i] + split->sums[n] - split->sums[i] - (n - i) * split->tail[i];
+		if (left_size <= capacity && right_size <= capacity && (left_size > right_size ? left_size : right_size) < best_size) {
+			best = m;
+			best_size = left_size > right_size ? left_size : right_size;
+			best_head = head;
+			best_tail = split->tail[i];
+		}
+	}
+	if (best == 0) {
+		return -1;
 	}
-	storage_close(fd);
 
-	tree->node_cache = bptree_malloc(sizeof(tree_cache_t));
-	if (tree->node_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->node_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->node_cache->in_cache.tail = end;
-				tree->node_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE NODE CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->node_cache->in_cache.head);
+	memset(&left->hdr, 0, sizeof(left->hdr));
+	memset(&right->hdr, 0, sizeof(right->hdr));
+	merge_init(&merge, page, type, rank, entry);
+	for (i = 0; i < n; i++) {
+		merge_next(&merge, &current);
+		if (i < best) {
+			if (i == 0) {
+				page_reset(left, current.key, best_head);
 			}
-			free(tree->node_cache);
+			page_append(left, type, &current);
+			continue;
 		}
-		free(tree);
-		return result;
-	}
-
-	/* Allocating bucket cache and initialising it  */
-	tree->buck_cache = bptree_malloc(sizeof(bucket_cache_t));
-	success = 0;
-	if (tree->buck_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->buck_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->buck_cache->in_cache.tail = end;
-				tree->buck_cache->num = 0;
+		if (i == best) {
+			*middle = current;
+			if (type == NODE) {
+				continue;
 			}
 		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE BUCKET CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		free(tree->node_cache->in_cache.tail);
-		free(tree->node_cache->in_cache.head);
-		free(tree->node_cache);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->buck_cache->in_cache.head);
-			}
-			free(tree->buck_cache);
+		if (i == best + skip) {
+			page_reset(right, current.key, best_tail);
 		}
-		free(tree);
-		return result;
+		page_append(right, type, &current);
 	}
+	return 0;
+}
 
-	base_offset = sizeof(tree_t) + sizeof(bucket_file);
-	tree->tree_storage = storage_open(index->descriptor_file, O_RDWR);
-	tree->bucket_storage = storage_open(bucket_file, O_RDWR);
+/* Nodes and buckets are kept in the buffer pool, pinned while they are used */
+static page_t *page_pin(tree_t *tree, page_type_t type, uint16_t id)
+{
+	if (type == NODE) {
+		return (page_t *)buffer_pool_pin(tree->tree_storage, NODE_OFFSET(id), NODE_SIZE);
+	}
+	return (page_t *)buffer_pool_pin(tree->bucket_storage, BUCKET_OFFSET(id), BUCKET_SIZE);
+}
 
-	DB_LOG_D("DB: Loaded btree index from file %s and bucket file %s\n", index->descriptor_file, bucket_file);
+static void page_unpin(tree_t *tree, page_type_t type, uint16_t id, int dirty)
+{
+	db_storage_id_t fd = type == NODE ? tree->tree_storage : tree->bucket_storage;
+	unsigned long offset = type == NODE ? NODE_OFFSET(id) : BUCKET_OFFSET(id);
 
-	return DB_OK;
+	if (dirty) {
+		buffer_pool_mark_dirty(fd, offset);
+	}
+	buffer_pool_unpin(fd, offset);
+}
 
+/* Replaces a page, unpinning it if it is pinned */
+static int page_put(tree_t *tree, page_type_t type, uint16_t id, page_t *page)
+{
+	if (type == NODE) {
+		return DB_ERROR(buffer_pool_put(tree->tree_storage, NODE_OFFSET(id), page, NODE_SIZE)) ? -1 : 0;
+	}
+	return DB_ERROR(buffer_pool_put(tree->bucket_storage, BUCKET_OFFSET(id), page, BUCKET_SIZE)) ? -1 : 0;
 }
 
-static db_result_t release(index_t *index)
+/* Pages which can still be allocated */
+static unsigned page_available(tree_t *tree, page_type_t type)
 {
-	tree_t *tree;
-	qnode_t *tmp_node;
-
-	tree = index->opaque_data;
-	if (tree == NULL) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if (tree->node_cache == NULL || tree->buck_cache == NULL) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if ((tree->node_cache->in_cache.tail == NULL) || (tree->node_cache->in_cache.head == NULL)) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if ((tree->buck_cache->in_cache.tail == NULL) || (tree->buck_cache->in_cache.head == NULL)) {
-		return DB_ALLOCATION_ERROR;
-	}
-	storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t));
-	/* Bucket Cache being flushed */
-	tmp_node = tree->buck_cache->in_cache.head->next;
-	free(tmp_node->prev);
-	while (tmp_node != tree->buck_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket));
-		}
-		tmp_node = tmp_node->next;
-		if (tmp_node->prev) {
-			free(tmp_node->prev);
-		}
-	}
-	free(tree->buck_cache->in_cache.tail);
-	tmp_node = tree->node_cache->in_cache.head->next;
-	free(tmp_node->prev);
-	while (tmp_node != tree->node_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node));
-		}
-		tmp_node = tmp_node->next;
-		if (tmp_node->prev) {
-			free(tmp_node->prev);
-		}
-	}
-	free(tree->node_cache->in_cache.tail);
-	storage_close(tree->bucket_storage);
-	storage_close(tree->tree_storage);
-
-	free(tree->node_cache);
-	free(tree->buck_cache);
-	free(tree);
-	return DB_OK;
-}
+	if (type == NODE) {
+		return CONFIG_NODE_LIMIT - tree->hdr.off_nodes + tree->hdr.free_nodes;
+	}
+	return CONFIG_BUCKETS_LIMIT - tree->hdr.off_buckets + tree->hdr.free_buckets;
+}
 
 /****************************************************************************
- * Name: insert
+ * Name: page_alloc
  *
- * Description: This routine is called by the antelope engine for insertion
- *              which in turns calls index insert routines to insert index
- *              entries.
+ * Description: Takes a page from the free list, or the first page never
+ *              used. The caller checks page_available() first.
  *
  ****************************************************************************/
-static db_result_t insert(index_t *index, attribute_value_t *key, tuple_id_t value)
+static int page_alloc(tree_t *tree, page_type_t type, uint16_t *id)
 {
-	tree_t *tree;
-	long long_key;
-
-	tree = (tree_t *)index->opaque_data;
-	long_key = db_value_to_long(key);
-
-#ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
-	if ((tree->inserted) >= DB_TUPLES_LIMIT) {
-		db_flush(tree, index->rel);
-		value = value - DB_TUPLES_LIMIT / 2;
-	}
-#endif
-	if (insert_item_btree(tree, (int)long_key, (int)value) == TREE_INSERT_FAIL) {
-		DB_LOG_E("DB: Failed to insert key %ld into a bplus-tree index\n", long_key);
-		return DB_INDEX_ERROR;
-	}
-
-	/***************************************************************************************
-	 *	The following code is to implement write through caching structure.
-	 *	The write back cache gives better performance as compared to write through cache
-	 *	and write back is preferred.
-	 ***************************************************************************************/
-#ifdef DB_WIP
-	qnode_t *tmp_node;
-	storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t));
-
-	/* Bucket Cache being flushed */
-
-	tmp_node = tree->buck_cache->in_cache.head->next;
-	while (tmp_node != tree->buck_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket));
-			UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
-		}
-		tmp_node = tmp_node->next;
+	uint16_t *head = type == NODE ? &tree->hdr.free_node : &tree->hdr.free_bucket;
+	uint16_t *count = type == NODE ? &tree->hdr.free_nodes : &tree->hdr.free_buckets;
+	uint16_t *off = type == NODE ? &tree->hdr.off_nodes : &tree->hdr.off_buckets;
+	page_t *page;
+
+	if (*head != PAGE_NONE) {
+		page = page_pin(tree, type, *head);
+		if (page == NULL) {
+			return -1;
+		}
+		*id = *head;
+		*head = page->hdr.link;
+		(*count)--;
+		page_unpin(tree, type, *id, FALSE);
+		return 0;
 	}
-	tmp_node = tree->node_cache->in_cache.head->next;
-	while (tmp_node != tree->node_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node));
-			UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
-		}
-		tmp_node = tmp_node->next;
+	if (*off >= (type == NODE ? CONFIG_NODE_LIMIT : CONFIG_BUCKETS_LIMIT)) {
+		return -1;
 	}
-#endif
-	return DB_OK;
+	*id = (*off)++;
+	return 0;
 }
 
-static db_result_t delete(index_t *index, attribute_value_t *value)
+static int page_free(tree_t *tree, page_type_t type, uint16_t id)
 {
-	int i_key;
-
-	i_key = db_value_to_long(value);
-	DB_LOG_D("delete index for value %d\n", i_key);
+	uint16_t *head = type == NODE ? &tree->hdr.free_node : &tree->hdr.free_bucket;
+	page_t *page;
 
-	return delete_item_btree(index, i_key);
+	page = page_pin(tree, type, id);
+	if (page == NULL) {
+		return -1;
+	}
+	memset(&page->hdr, 0, sizeof(page->hdr));
+	page->hdr.link = *head;
+	page_unpin(tree, type, id, TRUE);
+	*head = id;
+	if (type == NODE) {
+		tree->hdr.free_nodes++;
+	} else {
+		tree->hdr.free_buckets++;
+	}
+	return 0;
 }
 
 /****************************************************************************
- * Name: next_bucket
+ * Name: tree_reset
  *
- * Description: Helper function for get_next.
- *              Finds the bucket id of the bucket which is next in increasing
- *              order of keys
+ * Description: Empties the tree: the root is node 0, a leaf over the empty
+ *              bucket 0, and all other pages are unused.
  *
  ****************************************************************************/
-static uint16_t next_bucket(tree_t *tree, bucket_t *bucket)
+static int tree_reset(tree_t *tree)
 {
-	uint16_t next_bucket;
-	next_bucket = bucket->info[0];
-	if ((next_bucket == (uint16_t)-1) || (next_bucket == CONFIG_BUCKETS_LIMIT - 1)) {
-		return (uint16_t)-1;
+	page_t *page;
+	int ret;
+
+	page = bptree_malloc(sizeof(page_t));
+	if (page == NULL) {
+		return -1;
+	}
+	page->hdr.link = 0;
+	page->hdr.is_leaf = 1;
+	ret = page_put(tree, NODE, 0, page);
+	page->hdr.link = PAGE_NONE;
+	page->hdr.is_leaf = 0;
+	if (ret == 0) {
+		ret = page_put(tree, BUCKET, 0, page);
 	}
-	return next_bucket;
+	free(page);
+	if (ret < 0) {
+		return -1;
+	}
+
+	tree->hdr.root = 0;
+	tree->hdr.off_nodes = 1;
+	tree->hdr.off_buckets = 1;
+	tree->hdr.free_node = PAGE_NONE;
+	tree->hdr.free_bucket = PAGE_NONE;
+	tree->hdr.free_nodes = 0;
+	tree->hdr.free_buckets = 0;
+	tree->hdr.entries = 0;
+	tree->hdr.levels = 2;
+	tree->version++;
+	return 0;
 }
 
 /****************************************************************************
- * Name: get_next
+ * Name: tree_descend
  *
- * Description: Returns the tuple id of the next valid tuple for the case of
- *              select and remove queries
+ * Description: Follows a probe from the root to the bucket it belongs in,
+ *              recording the nodes and the children taken.
  *
  ****************************************************************************/
-static tuple_id_t get_next(index_iterator_t *iterator, uint8_t matched_condition)
+static int tree_descend(tree_t *tree, const struct probe_s *probe, struct path_s *path)
 {
+	struct slot_s slot;
+	page_t *node;
+	uint16_t id = tree->hdr.root;
+	int is_leaf;
 
-	/* This cache holds a pointer to a bucket in the main cache and other
-	 * information required to iterate over the bucket
-	 */
-	struct iteration_cache {
-		index_iterator_t *index_iterator;
-		uint16_t bucket_id;
-		bucket_t *bucket;
-		tuple_id_t found_items;
-		uint8_t start;
-		uint8_t end;
-	};
-	int i;
-	static struct iteration_cache cache;
-	int key_max;
-	int key_min;
-	tree_t *tree;
-	key_min = *(int *)&iterator->min_value;
-	key_max = *(int *)&iterator->max_value;
-	tree = (tree_t *)iterator->index->opaque_data;
-
-	/* To initialize the iterator_cache */
-	if (iterator->next_item_no == 0) {	/* removed the condition of iterator inequality */
-		if (iterator->found_items == 0) {
-			rw_lock_write(&(tree->tree_lock));
-			pair_t *path = tree_find(tree, key_min);
-			if (path == NULL) {
-				return INVALID_TUPLE;
-			}
-			uint16_t bucket_id = path[tree->levels].key;
-			free(path);
-			/* TODO
-			 * Absent of non-cast return handling, should be taken care in the definition
-			 */
-			cache.bucket = bucket_read(tree, bucket_id);
-			cache.bucket_id = bucket_id;
-			cache.start = 0;
-			cache.end = cache.bucket->next_free_slot;
+	path->depth = 0;
+	for (;;) {
+		if (path->depth == TREE_LEVEL_LIMIT) {
+			return -1;
 		}
-	}
-
-	/* Iterate over the key-value pairs in the bucket and find the ones which satisfy the condition */
-	for (i = cache.start; i < cache.end; i++) {
-		if ((key_min <= cache.bucket->pairs[i].key) && (cache.bucket->pairs[i].key <= key_max)) {
-			iterator->found_items++;
-			iterator->next_item_no = iterator->found_items;
-
-			/* matched condition is FALSE when the query is for remove tuples */
-			if (matched_condition == FALSE) {
-				tuple_id_t tmp = cache.bucket->pairs[i].value;
-				if (cache.end > (i + 1)) {
-					cache.bucket->pairs[i] = cache.bucket->pairs[cache.end - 1];
-
-					/* Start Bucket chaining */
-					int iter = 0;
-					uint16_t new_min = cache.bucket->info[1];
-					uint16_t new_max = cache.bucket->info[2];
-					for (; iter < cache.bucket->next_free_slot - 1; iter++) {
-						new_min = min(cache.bucket->pairs[iter].key, new_min);
-						new_max = max(cache.bucket->pairs[iter].key, new_max);
-					}
-					cache.bucket->info[1] = new_min;
-					cache.bucket->info[2] = new_max;
-					/* End of Bucket chaining */
-				}
-
-				cache.bucket->next_free_slot--;
-				tree->deleted++;
-				cache.end--;
-				cache.start = i;
-				return tmp;
-			} else {
-				cache.start = i + 1;
-			}
-			return cache.bucket->pairs[i].value;
+		node = page_pin(tree, NODE, id);
+		if (node == NULL) {
+			return -1;
+		}
+		page_find(node, NODE, probe, &slot);
+		is_leaf = node->hdr.is_leaf;
+		page_unpin(tree, NODE, id, FALSE);
+
+		path->nodes[path->depth] = id;
+		path->ranks[path->depth] = slot.rank;
+		path->depth++;
+		id = slot.child;
+		if (is_leaf) {
+			path->bucket = id;
+			return 0;
 		}
 	}
+}
 
-	/* case when delete query comes */
-	if (matched_condition == FALSE) {
-		modify_cache(tree, cache.bucket_id, BUCKET, INVALIDATE);
-		cache_write_bucket(tree, cache.bucket_id, cache.bucket);
-#ifdef DB_WIP
-		if ((int)((double)(tree->deleted) * 100 / tree->inserted) >= VACUUM_THRESHOLD) {
-			vacuum(tree, iterator->index->rel);
-		}
-#endif
-	} else {
-		modify_cache(tree, cache.bucket_id, BUCKET, UNLOCK);
-	}
-	pthread_mutex_lock(&(tree->bucket_lock));
-	tree->lock_buckets[cache.bucket_id] = 0;
-	cache.bucket_id = next_bucket(tree, cache.bucket);
-	if (cache.bucket_id == (uint16_t)-1) {
-		if (iterator->found_items == 0) {
-			iterator->next_item_no = 0;
-		} else {
-			iterator->next_item_no = 1;
-		}
-		pthread_mutex_unlock(&(tree->bucket_lock));
-		rw_unlock_write(&(tree->tree_lock));
-		return INVALID_TUPLE;
+/****************************************************************************
+ * Name: tree_insert
+ *
+ * Description: Puts an entry into its bucket. A full bucket is split and
+ *              the first entry of its right half goes up to the parent as
+ *              a separator, splitting full nodes up to the root. The pages
+ *              and memory for all the splits are checked for first, so that
+ *              a failed insert leaves the tree as it was.
+ *
+ ****************************************************************************/
+static tree_result_t tree_insert(tree_t *tree, const struct entry_s *entry)
+{
+	struct probe_s probe = { entry->key, entry->length, entry->tuple_id, FALSE };
+	struct path_s path;
+	struct slot_s slot;
+	struct split_s *split;
+	struct entry_s middle;
+	struct entry_s up;
+	page_result_t res;
+	page_t *page;
+	uint16_t new_id;
+	uint16_t id;
+	int level;
+
+	if (tree_descend(tree, &probe, &path) < 0) {
+		return TREE_READ_FAIL;
 	}
-	while (tree->lock_buckets[cache.bucket_id] == 1) {
-		pthread_mutex_unlock(&(tree->bucket_lock));
-		DB_LOG_D("BUCKET ALREADY LOCKED IN GET NEXT SPINNING\n");
-		pthread_mutex_lock(&(tree->bucket_lock));
+	split = (struct split_s *)malloc(sizeof(struct split_s));
+	if (split == NULL) {
+		return TREE_INSERT_FAIL;
 	}
 
-	/* TODO
-	 * Absent of non-cast return handling, should be taken care in the definition
-	 */
-	cache.bucket = bucket_read(tree, cache.bucket_id);
-	if (cache.bucket->info[1] > key_max) {
-		modify_cache(tree, cache.bucket_id, BUCKET, UNLOCK);
-		if (iterator->found_items == 0) {
-			iterator->next_item_no = 0;
-		} else {
-			iterator->next_item_no = 1;
-		}
-		pthread_mutex_unlock(&(tree->bucket_lock));
-		rw_unlock_write(&(tree->tree_lock));
-		return INVALID_TUPLE;
-
+	page = page_pin(tree, BUCKET, path.bucket);
+	if (page == NULL) {
+		free(split);
+		return TREE_READ_FAIL;
 	}
+	page_find(page, BUCKET, &probe, &slot);
+	if (slot.equal) {
+		page_unpin(tree, BUCKET, path.bucket, FALSE);
+		free(split);
+		return TREE_OK;
+	}
+	res = page_insert(page, BUCKET, slot.rank, entry, &split->halves[0]);
+	if (res == PAGE_OK) {
+		page_unpin(tree, BUCKET, path.bucket, TRUE);
+		free(split);
+		return TREE_OK;
+	}
+	if (page_available(tree, BUCKET) < 1 || page_available(tree, NODE) < path.depth + 1U || path.depth == TREE_LEVEL_LIMIT || page_split(page, BUCKET, slot.rank, entry, split, &middle) < 0) {
+		page_unpin(tree, BUCKET, path.bucket, FALSE);
+		free(split);
+		return TREE_INSERT_FAIL;
+	}
+
+	if (page_alloc(tree, BUCKET, &new_id) < 0) {
+		page_unpin(tree, BUCKET, path.bucket, FALSE);
+		free(split);
+		return TREE_INSERT_FAIL;
+	}
+	split->halves[1].hdr.link = page->hdr.link;
+	split->halves[0].hdr.link = new_id;
+	if (page_put(tree, BUCKET, path.bucket, &split->halves[0]) < 0 || page_put(tree, BUCKET, new_id, &split->halves[1]) < 0) {
+		goto errout;
+	}
+	middle.child = new_id;
+
+	for (level = path.depth - 1; level >= 0; level--) {
+		id = path.nodes[level];
+		page = page_pin(tree, NODE, id);
+		if (page == NULL) {
+			goto errout;
+		}
+		res = page_insert(page, NODE, path.ranks[level], &middle, &split->halves[0]);
+		if (res == PAGE_OK) {
+			page_unpin(tree, NODE, id, TRUE);
+			free(split);
+			return TREE_OK;
+		}
+		if (page_split(page, NODE, path.ranks[level], &middle, split, &up) < 0 || page_alloc(tree, NODE, &new_id) < 0) {
+			page_unpin(tree, NODE, id, FALSE);
+			goto errout;
+		}
+		split->halves[0].hdr.link = page->hdr.link;
+		split->halves[1].hdr.link = up.child;
+		split->halves[0].hdr.is_leaf = split->halves[1].hdr.is_leaf = page->hdr.is_leaf;
+		if (page_put(tree, NODE, id, &split->halves[0]) < 0 || page_put(tree, NODE, new_id, &split->halves[1]) < 0) {
+			goto errout;
+		}
+		middle = up;
+		middle.child = new_id;
+	}
+
+	/* The root was split, and a new root over its halves holds the separator */
+	if (page_alloc(tree, NODE, &new_id) < 0) {
+		goto errout;
+	}
+	page = &split->halves[0];
+	memset(&page->hdr, 0, sizeof(page->hdr));
+	page->hdr.link = tree->hdr.root;
+	page_reset(page, middle.key, middle.length);
+	page_append(page, NODE, &middle);
+	if (page_put(tree, NODE, new_id, page) < 0) {
+		goto errout;
+	}
+	tree->hdr.root = new_id;
+	tree->hdr.levels++;
+	free(split);
+	return TREE_OK;
 
-	tree->lock_buckets[cache.bucket_id] = 1;
-	pthread_mutex_unlock(&(tree->bucket_lock));
-
-	cache.start = 0;
-	cache.end = cache.bucket->next_free_slot;
-
-	iterator->next_item_no = 1;
-	return get_next(iterator, matched_condition);
+errout:
+	/* The pages were checked for, so only a failing flash gets here */
+	DB_LOG_E("DB: Failed to write a split of the bplus-tree, the index is inconsistent\n");
+	free(split);
+	return TREE_INSERT_FAIL;
 }
 
-
-
-#ifdef DB_WIP
 /****************************************************************************
- * Name: vacuum
+ * Name: tree_merge
  *
- * Description: Reclaims the space of all the deleted tuples.
- *              Creates a new tuple storage file with all the valid tuples
- *              and removes the old one.
+ * Description: Merges an underfull bucket with its sibling under the same
+ *              node if both fit in one bucket. The right bucket is freed
+ *              and the separator between them removed from the node.
+ *              Nodes are not merged.
  *
  ****************************************************************************/
-static db_result_t vacuum(tree_t *tree, relation_t *rel)
+static void tree_merge(tree_t *tree, struct path_s *path)
 {
-	char tuple_path[TUPLE_NAME_LENGTH];
-	db_result_t result;
-	relation_t old_rel;
-	memcpy(&old_rel, rel, sizeof(relation_t));
-	unsigned long long offset;
-	int fd;
-	int id;
-	int num_tuples = 0;
-
-	offset = 0;
-
-	fd = storage_open(rel->name, O_WRONLY);
-	result = storage_write_to(fd, rel->name, offset, sizeof(rel->name));
-	if (result != DB_OK) {
-		storage_close(fd);
-		storage_remove(rel->name);
-		return DB_STORAGE_ERROR;
+	struct entry_s current;
+	struct entry_s first;
+	struct entry_s last;
+	page_t *parent;
+	page_t *pages[2];
+	page_t *merged;
+	uint16_t ids[2];
+	uint16_t parent_id = path->nodes[path->depth - 1];
+	unsigned rank = path->ranks[path->depth - 1];
+	unsigned separator;
+	unsigned prefix;
+	unsigned count;
+	unsigned size;
+	unsigned offset;
+	unsigned i;
+	int k;
+
+	merged = (page_t *)malloc(sizeof(page_t));
+	if (merged == NULL) {
+		return;
 	}
-	offset += sizeof(rel->name);
-
-	/* Generate new tuple file */
-	snprintf(tuple_path, TUPLE_NAME_LENGTH, "%s.%x\0", TUPLE_FILE_NAME, (unsigned)(random_rand() & 0xffff));
-	result = storage_generate_file(tuple_path);
-	if (result == DB_STORAGE_ERROR) {
-		storage_close(fd);
-		storage_remove(rel->tuple_filename);
-		return DB_STORAGE_ERROR;
+	parent = page_pin(tree, NODE, parent_id);
+	if (parent == NULL) {
+		free(merged);
+		return;
 	}
-	strncpy(rel->tuple_filename, tuple_path, TUPLE_NAME_LENGTH);
-
-	result = storage_write_to(fd, rel->tuple_filename, offset, sizeof(rel->tuple_filename));
-
-	storage_close(fd);
-	if (result != DB_OK) {
-		storage_remove(rel->tuple_filename);
-		return DB_STORAGE_ERROR;
+	if (parent->hdr.count == 0) {
+		goto out_parent;
 	}
 
-	/* Set the fields of the relation structure */
-	rel->tuple_storage = storage_open(rel->tuple_filename, O_RDWR);
+	/* The separator between the bucket and its left sibling, or its right
+	   sibling if it is the first child */
+	if (rank > 0) {
+		rank--;
+	}
+	ids[0] = parent->hdr.link;
+	separator = parent->hdr.prefix;
+	for (i = 0; i < rank; i++) {
+		separator = page_read(parent, NODE, separator, &current);
+		ids[0] = current.child;
+	}
+	page_read(parent, NODE, separator, &current);
+	ids[1] = current.child;
 
-	rel->next_row = num_tuples;
-	rel->cardinality = num_tuples;
-	storage_row_t temp = bptree_malloc(sizeof(rel->row_length));
-	if (temp == NULL) {
-		return DB_ALLOCATION_ERROR;
+	pages[0] = page_pin(tree, BUCKET, ids[0]);
+	pages[1] = pages[0] == NULL ? NULL : page_pin(tree, BUCKET, ids[1]);
+	if (pages[1] == NULL) {
+		goto out_bucket;
 	}
 
-	/* Iterate over all the buckets to read the tuples from storage and put them in new tuple file */
-	for (id = 0; id < tree->off_buckets; id++) {
-		bucket_t *bucket = bucket_read(tree, id);
-		int num;
-		for (num = 0; num < bucket->next_free_slot; num++) {
-			tuple_id_t tup;
-			tup = bucket->pairs[num].value;
+	/* The merged size, with the prefix of the first and the last key */
+	count = 0;
+	size = 0;
+	for (k = 0; k < 2; k++) {
+		for (offset = pages[k]->hdr.prefix; offset < pages[k]->hdr.used;) {
+			offset = page_read(pages[k], BUCKET, offset, &current);
+			if (count++ == 0) {
+				first = current;
+			}
+			last = current;
+			size += entry_size(current.length, BUCKET);
+		}
+	}
+	prefix = count > 0 ? key_common(first.key, first.length, last.key, last.length) : 0;
+	if (count > PAGE_ENTRY_LIMIT || prefix + size - count * prefix > BUCKET_DATA_SIZE) {
+		goto out_buckets;
+	}
 
-			storage_get_row(&old_rel, &tup, temp);
-			storage_put_row(rel, temp, FALSE);
-			bucket->pairs[num].value = num_tuples;
-			num_tuples++;
+	merged->hdr = pages[0]->hdr;
+	merged->hdr.link = pages[1]->hdr.link;
+	page_reset(merged, first.key, prefix);
+	for (k = 0; k < 2; k++) {
+		for (offset = pages[k]->hdr.prefix; offset < pages[k]->hdr.used;) {
+			offset = page_read(pages[k], BUCKET, offset, &current);
+			page_append(merged, BUCKET, &current);
 		}
-		modify_cache(tree, id, BUCKET, DIRTY);
-		modify_cache(tree, id, BUCKET, UNLOCK);
 	}
-	free(temp);
-	tree->inserted -= tree->deleted;
-	tree->deleted = 0;
+	page_unpin(tree, BUCKET, ids[1], FALSE);
+	if (page_put(tree, BUCKET, ids[0], merged) < 0) {
+		goto out_parent;
+	}
+	page_free(tree, BUCKET, ids[1]);
+	page_remove(parent, NODE, separator);
+	page_unpin(tree, NODE, parent_id, TRUE);
+	free(merged);
+	return;
 
-	storage_remove(old_rel.tuple_filename);
-	return DB_OK;
+out_buckets:
+	page_unpin(tree, BUCKET, ids[1], FALSE);
+out_bucket:
+	if (pages[0] != NULL) {
+		page_unpin(tree, BUCKET, ids[0], FALSE);
+	}
+out_parent:
+	page_unpin(tree, NODE, parent_id, FALSE);
+	free(merged);
 }
-#endif
 
 /****************************************************************************
- * Name: modify_cache
+ * Name: tree_delete
  *
- * Description: Modifying the cache entries to mark the entry dirty,
- *              invalid or unlocking it
+ * Description: Removes the entry of a key and a tuple id.
  *
  ****************************************************************************/
-static cache_result_t modify_cache(tree_t *tree, int id, cache_type_t cache, op_type_t op)
+static tree_result_t tree_delete(tree_t *tree, const struct entry_s *entry)
 {
-	qnode_t *temp;
-	qnode_t *end;
-	if (cache == NODE) {
-		pthread_mutex_lock(&(tree->node_cache_lock));
-		temp = tree->node_cache->in_cache.tail->prev;
-		end = tree->node_cache->in_cache.head;
-	} else {
-		pthread_mutex_lock(&(tree->buck_cache_lock));
-		temp = tree->buck_cache->in_cache.tail->prev;
-		end = tree->buck_cache->in_cache.head;
-	}
-	while (temp != end) {
-		if ((temp->id == id) && (temp->node_state & NODE_STATE_VALID)) {
-			if (op == UNLOCK) {
-				UNSET_NODE_STATE(temp, NODE_STATE_LOCK);
-			} else if (op == DIRTY) {
-				SET_NODE_STATE(temp, NODE_STATE_DIRTY);
-			} else {
-				UNSET_NODE_STATE(temp, NODE_STATE_VALID | NODE_STATE_DIRTY | NODE_STATE_LOCK);
-				REMOVE_ENTRY(temp);
-				if (cache == NODE) {
-					PLACE_AT_HEAD(temp, tree->node_cache);
-				} else {
-					PLACE_AT_HEAD(temp, tree->buck_cache);
-				}
-			}
-			break;
-		}
-		temp = temp->prev;
-	}
+	struct probe_s probe = { entry->key, entry->length, entry->tuple_id, FALSE };
+	struct path_s path;
+	struct slot_s slot;
+	page_t *page;
+	unsigned used;
 
-	if (cache == NODE) {
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-	} else {
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
+	if (tree_descend(tree, &probe, &path) < 0) {
+		return TREE_READ_FAIL;
 	}
-
-	if (temp == end) {
-		DB_LOG_E("PANIC CACHE OPERATION FOR A NON EXISTENT ENTRY\n");
-		return CACHE_NOT_EXIST;
+	page = page_pin(tree, BUCKET, path.bucket);
+	if (page == NULL) {
+		return TREE_READ_FAIL;
+	}
+	page_find(page, BUCKET, &probe, &slot);
+	if (!slot.equal) {
+		page_unpin(tree, BUCKET, path.bucket, FALSE);
+		return TREE_READ_FAIL;
 	}
+	page_remove(page, BUCKET, slot.last);
+	used = page->hdr.used;
+	page_unpin(tree, BUCKET, path.bucket, TRUE);
 
-	return CACHE_OK;
+	if (used < MERGE_FILL) {
+		tree_merge(tree, &path);
+	}
+	return TREE_OK;
 }
 
 /****************************************************************************
- * Name: cache_write_node
+ * Name: tree_write_header
  *
- * Description: Routine enabling to put a new cache entry in Node Cache.
- *              Required when new nodes are generated resulting from splits
+ * Description: Writes the tree metadata, the bucket file name and the names
+ *              of the key attributes at the start of the descriptor file.
  *
  ****************************************************************************/
-static cache_result_t cache_write_node(tree_t *tree, int id, tree_node_t *node)
+static db_result_t tree_write_header(tree_t *tree, index_t *index, char *bucket_filename)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-	if (new_node == NULL) {
-		DB_LOG_E("Failed allocation of node\n");
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return CACHE_ALLOCATION_ERROR;
-	}
+	char names[DB_INDEX_ATTRIBUTE_LIMIT][ATTRIBUTE_NAME_LENGTH];
+	unsigned long offset;
+	int i;
 
-	if (tree->node_cache->num < DB_TREE_CACHE_LIMIT) {
-		new_node->pos = tree->node_cache->num++;
-	} else {
-		qnode_t *iter_node;
-		iter_node = tree->node_cache->in_cache.head->next;
-		while ((iter_node->node_state & NODE_STATE_LOCK) && iter_node != tree->node_cache->in_cache.tail) {
-			iter_node = iter_node->next;
+	offset = sizeof(struct tree_header_s);
+	if (bucket_filename != NULL) {
+		if (DB_ERROR(storage_write_to(tree->tree_storage, bucket_filename, offset, DB_MAX_FILENAME_LENGTH))) {
+			return DB_STORAGE_ERROR;
 		}
-		if (iter_node == tree->node_cache->in_cache.tail) {
-			free(new_node);
-			DB_LOG_E("NO SLOT AVAIABLE IN CACHE\n");
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return CACHE_FULL;
+	}
+	offset += DB_MAX_FILENAME_LENGTH;
+	if (index != NULL) {
+		memset(names, 0, sizeof(names));
+		for (i = 0; i < index->attr_count; i++) {
+			strncpy(names[i], index->attrs[i]->name, ATTRIBUTE_NAME_LENGTH - 1);
 		}
-		if ((iter_node->node_state & NODE_STATE_DIRTY) && (iter_node->node_state & NODE_STATE_DIRTY)) {
-			tree_write(tree, iter_node->id, &(tree->node_cache->cache_t[iter_node->pos].node));
+		if (DB_ERROR(storage_write_to(tree->tree_storage, names, offset, sizeof(names)))) {
+			return DB_STORAGE_ERROR;
 		}
-		new_node->pos = iter_node->pos;
-		/* iter_node is the node which has to be evicted from cache.
-		 * It is removed the queue maintaining the LRU status.
-		 */
-		REMOVE_ENTRY(iter_node);
-		free(iter_node);
 	}
-
-	PLACE_AT_TAIL(new_node, tree->node_cache);
-	new_node->id = id;
-	UNSET_NODE_STATE(new_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(new_node, NODE_STATE_VALID);
-	SET_NODE_STATE(new_node, NODE_STATE_DIRTY);
-
-	memcpy(&(tree->node_cache->cache_t[new_node->pos].node), node, sizeof(tree_node_t));
-
-	pthread_mutex_unlock(&(tree->node_cache_lock));
-
-	return CACHE_OK;
+	return storage_write_to(tree->tree_storage, &tree->hdr, 0, sizeof(tree->hdr));
 }
 
 /****************************************************************************
- * Name: cache_replace_node
+ * Name: create
  *
- * Description: Routine to replace cache entry.
- *              Required when a node needs to be rewritten
+ * Description: The function initialises all the structures required for the
+ *              bplus-tree both in memory and on flash.
+ *              The tree metadata, the bucket file name and the names of the
+ *              key attributes are saved at the start of the descriptor file,
+ *              followed by the nodes. Nodes and buckets are cached in the
+ *              shared buffer pool and written back at the latest when
+ *              release closes the files
  *
  ****************************************************************************/
-static cache_result_t cache_replace_node(tree_t *tree, int id, tree_node_t *node)
+static db_result_t create(index_t *index)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
+	/* Files storing tree and bucket data */
+	char tree_filename[DB_MAX_FILENAME_LENGTH];
+	char bucket_filename[DB_MAX_FILENAME_LENGTH];
+	page_t *page;
+	db_result_t result;
+	int curtime;
+	int i;
 
-	qnode_t *replace_node;
-	replace_node = tree->node_cache->in_cache.head->next;
+	curtime = time(NULL);
+	random_init(curtime);
+	tree_t *tree = bptree_malloc(sizeof(tree_t));
+	if (tree == NULL) {
+		DB_LOG_E("DB: Failed to allocate a tree\n");
+		result = DB_ALLOCATION_ERROR;
+		return result;
 
-	while ((replace_node->id != id) && (replace_node != tree->node_cache->in_cache.tail)) {
-		replace_node = replace_node->next;
 	}
-	if (replace_node == tree->node_cache->in_cache.tail || !(replace_node->node_state & NODE_STATE_LOCK)) {
-		DB_LOG_E("PANIC REPLACE FOR NON_EXISTENT OR NON_LOCKED ENTRY\n");
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return CACHE_NOT_EXIST;
+
+	/* Generating the file to store the tree structure */
+	snprintf(tree_filename, HEAP_FILE_LENGTH, "%s.%x\0", HEAP_FILE_NAME, (unsigned)(random_rand() & 0xffff));
+
+	result = storage_generate_file(tree_filename);
+	if (result == DB_INDEX_ERROR) {
+		DB_LOG_E("DB: Failed to generate a tree file\n");
+		free(tree);
+		return result;
 	}
-	UNSET_NODE_STATE(replace_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(replace_node, NODE_STATE_VALID | NODE_STATE_DIRTY);
 
-	memcpy(&(tree->node_cache->cache_t[replace_node->pos].node), node, sizeof(tree_node_t));
+	memcpy(index->descriptor_file, tree_filename, sizeof(index->descriptor_file));
+	DB_LOG_D("DB: Generated the tree file \"%s\" using %lu bytes of space\n", index->descriptor_file, NODE_OFFSET(CONFIG_NODE_LIMIT));
 
-	pthread_mutex_unlock(&(tree->node_cache_lock));
+	/* Generating bucket file to store <key, tuple_id> pair */
+	memset(bucket_filename, 0, sizeof(bucket_filename));
+	snprintf(bucket_filename, BUCKET_FILE_LENGTH, "%s.%x\0", BUCKET_FILE_NAME, (unsigned)(random_rand() & 0xffff));
 
-	return CACHE_OK;
-}
+	result = storage_generate_file(bucket_filename);
+	if (result == DB_INDEX_ERROR) {
+		DB_LOG_E("DB: Failed to generate a bucket file\n");
+		storage_remove(tree_filename);
+		free(tree);
+		return result;
+	}
+	DB_LOG_D("DB: Generated the bucket file \"%s\" using %lu bytes of space\n", bucket_filename, BUCKET_OFFSET(CONFIG_BUCKETS_LIMIT));
 
-/****************************************************************************
- * Name: cache_write_bucket
- *
- * Description: Routine enabling to put a new cache entry in Bucket Cache.
- *              Required when new buckets are generated resulting from splits.
- *
- ****************************************************************************/
-static cache_result_t cache_write_bucket(tree_t *tree, int id, bucket_t *bucket)
-{
-	pthread_mutex_lock(&(tree->buck_cache_lock));
+	/* Initialising both tree and bucket storage files */
+	tree->tree_storage = storage_open(tree_filename, O_RDWR);
+	if (tree->tree_storage < 0) {
+		result = DB_STORAGE_ERROR;
+		storage_remove(tree_filename);
+		storage_remove(bucket_filename);
+		free(tree);
+		return result;
+	}
+	tree->bucket_storage = storage_open(bucket_filename, O_RDWR);
+	if (tree->bucket_storage < 0) {
+		result = DB_STORAGE_ERROR;
+		storage_close(tree->tree_storage);
+		storage_remove(tree_filename);
+		storage_remove(bucket_filename);
+		free(tree);
+		return result;
 
-	qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-	if (new_node == NULL) {
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return CACHE_ALLOCATION_ERROR;
 	}
 
-	if (tree->buck_cache->num < DB_HEAP_CACHE_LIMIT) {
-		new_node->pos = tree->buck_cache->num++;
-	} else {
-		qnode_t *iter_node;
-		iter_node = tree->buck_cache->in_cache.head->next;
-		while ((iter_node->node_state & NODE_STATE_LOCK) && (iter_node != tree->buck_cache->in_cache.tail)) {
-			iter_node = iter_node->next;
-		}
-		if (iter_node == tree->buck_cache->in_cache.tail) {
-			free(new_node);
-			DB_LOG_E("NO SLOT AVAILABLE IN CACHE bucket\n");
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return CACHE_FULL;
-		}
+	tree->hdr.magic = TREE_MAGIC;
+	tree->hdr.attr_count = index->attr_count;
+	result = tree_write_header(tree, index, bucket_filename);
 
-		if ((iter_node->node_state & NODE_STATE_DIRTY) && (iter_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, iter_node->id, &(tree->buck_cache->cache_t[iter_node->pos].bucket));
+	/* Reserving the space of all nodes and buckets */
+	page = bptree_malloc(sizeof(page_t));
+	if (page) {
+		for (i = 0; i < CONFIG_NODE_LIMIT && !DB_ERROR(result); i++) {
+			result = storage_write_to(tree->tree_storage, page, NODE_OFFSET(i), NODE_SIZE);
+		}
+		for (i = 0; i < CONFIG_BUCKETS_LIMIT && !DB_ERROR(result); i++) {
+			result = storage_write_to(tree->bucket_storage, page, BUCKET_OFFSET(i), BUCKET_SIZE);
 		}
-		new_node->pos = iter_node->pos;
-		REMOVE_ENTRY(iter_node);
-		free(iter_node);
+		free(page);
 	}
-	PLACE_AT_TAIL(new_node, tree->buck_cache);
-	new_node->id = id;
-	UNSET_NODE_STATE(new_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(new_node, NODE_STATE_DIRTY | NODE_STATE_VALID);
 
-	memcpy(&(tree->buck_cache->cache_t[new_node->pos].bucket), bucket, sizeof(bucket_t));
+	/* Initialising Locks for concurrency control */
+	rw_init(&(tree->tree_lock));
+	index->opaque_data = tree;
 
-	pthread_mutex_unlock(&(tree->buck_cache_lock));
+	if (DB_ERROR(result) || tree_reset(tree) < 0) {
+		storage_close(tree->bucket_storage);
+		storage_close(tree->tree_storage);
+		storage_remove(bucket_filename);
+		index->opaque_data = NULL;
+		free(tree);
+		return DB_STORAGE_ERROR;
+	}
 
-	return CACHE_OK;
+	DB_LOG_D("DB: Created a bplus-tree index\n");
+	result = DB_OK;
+	return result;
 }
 
-/****************************************************************************
- * Name: transform_key
- *
- * Description: Routine to tranform key to a type acceptable by index.
- *              Different data types of keys can be supported.
- *              some codes will be added in future.
- *
- ****************************************************************************/
-static int transform_key(int key)
+static db_result_t destroy(index_t *index)
 {
-	return key;
+	db_storage_id_t fd;
+	size_t r;
+	char bucket_file[DB_MAX_FILENAME_LENGTH];
+	if (DB_ERROR(release(index))) {
+		return DB_INDEX_ERROR;
+	}
+	fd = storage_open(index->descriptor_file, O_RDWR);
+	if (fd < 0) {
+		return DB_STORAGE_ERROR;
+	}
+	if (DB_ERROR(storage_read_from(fd, bucket_file, sizeof(struct tree_header_s), sizeof(bucket_file)))) {
+		storage_close(fd);
+		return DB_STORAGE_ERROR;
+	}
+	storage_close(fd);
+	r = storage_remove(bucket_file);
+	if (DB_ERROR(r)) {
+		return DB_STORAGE_ERROR;
+	}
+	return DB_OK;
 }
 
 /****************************************************************************
- * Name: tree_read
+ * Name: load
  *
- * Description: Fetches nodes from the flash and suitably evicts the nodes
- *              from cache, in case the cache is full
+ * Description: Reads the tree metadata from the descriptor file and finds
+ *              the key attributes, in key order, in the relation.
  *
  ****************************************************************************/
-static tree_node_t *tree_read(tree_t *tree, int bucket_id)
+static db_result_t load(index_t *index)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
+	tree_t *tree;
+	db_storage_id_t fd;
+	char bucket_file[DB_MAX_FILENAME_LENGTH];
+	char names[DB_INDEX_ATTRIBUTE_LIMIT][ATTRIBUTE_NAME_LENGTH];
+	attribute_t *attr;
+	int i;
 
-	bool found = false;
-	qnode_t *iter = (tree->node_cache->in_cache.tail)->prev;
+	index->opaque_data = tree = bptree_malloc(sizeof(tree_t));
+	if (tree == NULL) {
+		DB_LOG_E("DB: Failed to allocate a tree while loading\n");
+		return DB_ALLOCATION_ERROR;
+	}
 
-	while (iter != (tree->node_cache->in_cache.head)) {
-		if (bucket_id == iter->id && (iter->node_state & NODE_STATE_VALID)) {
-			found = true;
-			break;
-		}
-		iter = iter->prev;
+	DB_LOG_D("load index : descriptor file name : %s\n", index->descriptor_file);
+	fd = storage_open(index->descriptor_file, O_RDWR);
+	if (fd < 0) {
+		DB_LOG_E("Failed opening index descriptor file :%s\n", index->descriptor_file);
+		goto errout;
 	}
-	if (found) {
-		/* Case when node is found in the cache */
-		if (iter->node_state & NODE_STATE_LOCK) {
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-		SET_NODE_STATE(iter, NODE_STATE_LOCK);
-		REMOVE_ENTRY(iter);
-		PLACE_AT_TAIL(iter, tree->node_cache);
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return &(tree->node_cache->cache_t[iter->pos].node);
-	} else {
-		qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (new_node == NULL) {
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-		if (tree->node_cache->num < DB_TREE_CACHE_LIMIT) {
-			new_node->pos = tree->node_cache->num++;
-		} else {
-			/* Case when the least recently used node needs to be evicted to make place for new node */
-			qnode_t *replace_node = tree->node_cache->in_cache.head->next;
-			while ((replace_node->node_state & NODE_STATE_LOCK) && replace_node != tree->node_cache->in_cache.tail) {
-				replace_node = replace_node->next;
-			}
-			if (replace_node == tree->node_cache->in_cache.tail) {
-				free(new_node);
-				pthread_mutex_unlock(&(tree->node_cache_lock));
-				return NULL;
-			}
-			if ((replace_node->node_state & NODE_STATE_DIRTY) && (replace_node->node_state & NODE_STATE_VALID)) {
-				tree_write(tree, replace_node->id, &(tree->node_cache->cache_t[replace_node->pos].node));
-			}
-			new_node->pos = replace_node->pos;
-			REMOVE_ENTRY(replace_node);
-			free(replace_node);
-		}
-		/* Adjusting the pointers */
-		PLACE_AT_TAIL(new_node, tree->node_cache);
-		new_node->id = bucket_id;
-		SET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID | NODE_STATE_DIRTY);
-
-		/* Reading from flash */
-		if (DB_ERROR(storage_read_from(tree->tree_storage, &(tree->node_cache->cache_t[new_node->pos].node), base_offset + (unsigned long)bucket_id * sizeof(tree_node_t), sizeof(tree_node_t)))) {
-			DB_LOG_E("PANIC TREE READ FAILED AT NODE ID %d\n", new_node->id);
-			UNSET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID);
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
+	if (DB_ERROR(storage_read_from(fd, &tree->hdr, 0, sizeof(tree->hdr))) || DB_ERROR(storage_read_from(fd, bucket_file, sizeof(tree->hdr), sizeof(bucket_file))) || DB_ERROR(storage_read_from(fd, names, sizeof(tree->hdr) + sizeof(bucket_file), sizeof(names)))) {
+		DB_LOG_E("Failed  reading tree structure from descriptor file\n");
+		storage_close(fd);
+		goto errout;
+	}
+	storage_close(fd);
+
+	if (tree->hdr.magic != TREE_MAGIC || tree->hdr.attr_count == 0 || tree->hdr.attr_count > DB_INDEX_ATTRIBUTE_LIMIT) {
+		DB_LOG_E("DB: Index file %s is not a bplus-tree of this version\n", index->descriptor_file);
+		goto errout;
+	}
+	for (i = 0; i < tree->hdr.attr_count; i++) {
+		names[i][ATTRIBUTE_NAME_LENGTH - 1] = '\0';
+		attr = relation_attribute_get(index->rel, names[i]);
+		if (attr == NULL) {
+			DB_LOG_E("DB: Key attribute %s of index %s not found\n", names[i], index->descriptor_file);
+			goto errout;
 		}
+		index->attrs[i] = attr;
+	}
+	index->attr_count = tree->hdr.attr_count;
+
+	tree->tree_storage = storage_open(index->descriptor_file, O_RDWR);
+	tree->bucket_storage = storage_open(bucket_file, O_RDWR);
+	rw_init(&(tree->tree_lock));
 
-		pthread_mutex_unlock(&(tree->node_cache_lock));
+	DB_LOG_D("DB: Loaded btree index from file %s and bucket file %s\n", index->descriptor_file, bucket_file);
 
-		return &(tree->node_cache->cache_t[new_node->pos].node);
-	}
-}
+	return DB_OK;
 
-/****************************************************************************
- * Name: tree_write
- *
- * Description: Routine to issue a flash write of node in the tree.
- *              Required while evicting dirty cache entries
- *
- ****************************************************************************/
-static int tree_write(tree_t *tree, int offset, tree_node_t *node)
-{
-	if (DB_ERROR(storage_write_to(tree->tree_storage, node, base_offset + (unsigned long)offset * sizeof(*node), sizeof(*node)))) {
-		DB_LOG_E("TREE WRITE FAILED AT NODE ID %d\n", offset);
-		return 0;
-	}
-	return 1;
+errout:
+	index->opaque_data = NULL;
+	free(tree);
+	return DB_STORAGE_ERROR;
 }
 
-/****************************************************************************
- * Name: bucket_write
- *
- * Description: Routine to issue a flash write of bucket in the tree.
- *              Required while evicting dirty cache entries
- *
- ****************************************************************************/
-static int bucket_write(tree_t *tree, int pos, bucket_t *bucket)
+static db_result_t release(index_t *index)
 {
-	if (DB_ERROR(storage_write_to(tree->bucket_storage, bucket, (unsigned long)pos * sizeof(bucket_t), sizeof(bucket_t)))) {
-		DB_LOG_E("BUCKET WRITE FAILED AT BUCKET ID %d\n", pos);
-		return 0;
-	}
-	return 1;
-}
+	tree_t *tree;
 
-/****************************************************************************
- * Name: tree_insert
- *
- * Description: Initialises the bplus tree by putting a dummy entry with
- *              value max(uint16_t) and two buckets
- *
- ****************************************************************************/
-static tree_result_t tree_insert(tree_t *tree, int max)
-{
-	int i = tree->off_nodes;
-	tree_node_t *node;
-
-	/* TODO
-	 * Absent of noncast return handling, should be taken care in the definition
-	 */
-	node = tree_read(tree, i);
-	if (node == NULL) {
-		return TREE_READ_FAIL;
+	tree = index->opaque_data;
+	if (tree == NULL) {
+		return DB_ALLOCATION_ERROR;
 	}
-	node->val[0] = max;
-	node->val[BRANCH_FACTOR - 1] = 1;
-	node->id[0] = tree->off_buckets++;
-	node->id[1] = CONFIG_BUCKETS_LIMIT - 1;
-	node->is_leaf = 1;
-	tree->root = i;
-	tree->off_nodes++;
-
-	modify_cache(tree, tree->root, NODE, DIRTY);
-	modify_cache(tree, tree->root, NODE, UNLOCK);
+	tree_write_header(tree, NULL, NULL);
+	/* Closing the files writes back their dirty nodes and buckets from the buffer pool */
+	storage_close(tree->bucket_storage);
+	storage_close(tree->tree_storage);
 
-	return TREE_OK;
+	free(tree);
+	index->opaque_data = NULL;
+	return DB_OK;
 }
 
 /****************************************************************************
- * Name: tree_find
+ * Name: insert
  *
- * Description: Traverses the bplus tree to find the appropriate bucket
- *              for an insertion
+ * Description: This routine is called by the antelope engine for insertion
+ *              which in turns calls index insert routines to insert index
+ *              entries.
  *
  ****************************************************************************/
-static pair_t *tree_find(tree_t *tree, int key)
+static db_result_t insert(index_t *index, unsigned char *key, unsigned length, tuple_id_t value)
 {
-	int hashed_key;
-	uint8_t id;
-	tree_node_t *node;
-	int index;
-	hashed_key = transform_key(key);
-	bool iset;
-	int j;
-	pair_t *path = bptree_malloc(sizeof(pair_t) * ((tree->levels) + 1));
-	if (path == NULL) {
-		return NULL;
-	}
-	uint8_t tree_level = 1;
-	path[0].key = ROOT_NODE_PARENT;
-	path[0].value = 0;
-	id = tree->root;
-	/* Keep traversing down the tree until leaf node is reached */
-	while (true) {
-		/* TODO
-		 * Absent of noncast return handling, should be taken care in the definition
-		 */
-		node = tree_read(tree, id);
-		if (node == NULL) {
-			free(path);
-			return NULL;
-		}
-		index = id;
-		iset = false;
-		/* If leaf is found iterate over the keys and find the appropriate bucket */
-		for (j = 0; j < node->val[BRANCH_FACTOR - 1]; j++) {
-			if (node->val[j] > hashed_key) {
-				iset = true;
-				break;
-			}
-		}
-		if (node->is_leaf) {
-			if (iset) {
-				index = j;
-			} else {
-				index = node->val[BRANCH_FACTOR - 1];
-			}
+	tree_t *tree;
+	struct entry_s entry;
+	tree_result_t result;
 
-			/* Bucket id should be returned */
-			pthread_mutex_lock(&(tree->bucket_lock));
-			if (tree->lock_buckets[node->id[index]]) {
-				pthread_mutex_unlock(&(tree->bucket_lock));
-				modify_cache(tree, id, NODE, UNLOCK);
-				free(path);
-				return NULL;
-			} else {
-				tree->lock_buckets[node->id[index]] = 1;
-				pthread_mutex_unlock(&(tree->bucket_lock));
-			}
-			modify_cache(tree, id, NODE, UNLOCK);
-			path[tree_level].key = id;
-			path[tree_level].value = index;
-			tree_level++;
-			path[tree_level].key = node->id[index];
-			return path;
-		} else {
-			path[tree_level].key = id;
-			if (iset) {
-				id = node->id[j];
-				path[tree_level].value = j;
-			} else {
-				id = node->id[node->val[BRANCH_FACTOR - 1]];
-				path[tree_level].value = node->val[BRANCH_FACTOR - 1];
-			}
-			tree_level++;
-			modify_cache(tree, index, NODE, UNLOCK);
-		}
+	tree = (tree_t *)index->opaque_data;
+	if (length > DB_INDEX_KEY_LENGTH) {
+		return DB_INDEX_ERROR;
 	}
-	free(path);
-	return NULL;
-}
 
+	rw_lock_write(&(tree->tree_lock));
+#ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
+	if ((tree->hdr.inserted) >= DB_TUPLES_LIMIT) {
+		db_flush(tree, index->rel);
+		value = value - DB_TUPLES_LIMIT / 2;
+	}
+#endif
+	memcpy(entry.key, key, length);
+	entry.length = length;
+	entry.tuple_id = value;
+	entry.child = PAGE_NONE;
+	result = tree_insert(tree, &entry);
+	if (result == TREE_OK) {
+		tree->hdr.entries++;
+		tree->hdr.inserted++;
+		tree->version++;
+	}
+	rw_unlock_write(&(tree->tree_lock));
+
+	if (result != TREE_OK) {
+		DB_LOG_E("DB: Failed to insert tuple %lu into a bplus-tree index\n", (unsigned long)value);
+		return DB_INDEX_ERROR;
+	}
+	return DB_OK;
+}
 
-#if (DEBUG & DEBUG_VERBOSE) || (DEBUG & DEBUG_ENABLE)
-/****************************************************************************
- * Name: tree_print
- *
- * Description: Debugging Function to print the whole tree structure
- *
- ****************************************************************************/
-void tree_print(tree_t *tree, int id)
+static db_result_t delete(index_t *index, unsigned char *key, unsigned length, tuple_id_t value)
 {
-	tree_node_t *node;
-	bucket_t *bucket;
-	int i, j;
-	node = tree_read(tree, id);
-	DB_LOG_D("Node %d:", id);
-	if (node->is_leaf) {
-		for (i = 0; i < node->val[BRANCH_FACTOR - 1]; i++) {
-			DB_LOG_V(" Key: %d\n", node->val[i]);
-			bucket = bucket_read(tree, node->id[i]);
-			DB_LOG_V("Bucket id:%d\n", node->id[i]);
-			for (j = 0; j < bucket->next_free_slot; j++) {
-				DB_LOG_V("Key %d, Value %d\n", bucket->pairs[j].key, bucket->pairs[j].value);
-			}
-			modify_cache(tree, node->id[i], BUCKET, UNLOCK);
-		}
-		bucket = bucket_read(tree, node->id[node->val[BRANCH_FACTOR - 1]]);
-		if (bucket != NULL) {
-			DB_LOG_D("Bucket id:%d\n", node->id[node->val[BRANCH_FACTOR - 1]]);
-			for (j = 0; j < bucket->next_free_slot; j++) {
-				DB_LOG_V("Key %d, Value %d\n", bucket->pairs[j].key, bucket->pairs[j].value);
-			}
-			modify_cache(tree, node->id[node->val[BRANCH_FACTOR - 1]], BUCKET, UNLOCK);
-		}
+	tree_t *tree;
+	struct entry_s entry;
+	tree_result_t result;
 
-	} else {
-		for (i = 0; i < node->val[BRANCH_FACTOR - 1]; i++) {
-			DB_LOG_V("Key: %d\n", node->val[i]);
-			tree_print(tree, node->id[i]);
-		}
-		tree_print(tree, node->id[node->val[BRANCH_FACTOR - 1]]);
+	tree = (tree_t *)index->opaque_data;
+	if (length > DB_INDEX_KEY_LENGTH) {
+		return DB_INDEX_ERROR;
 	}
-	modify_cache(tree, id, NODE, UNLOCK);
-	DB_LOG_D("Node End\n");
+	DB_LOG_D("delete index entry of tuple %lu\n", (unsigned long)value);
+
+	memcpy(entry.key, key, length);
+	entry.length = length;
+	entry.tuple_id = value;
+	rw_lock_write(&(tree->tree_lock));
+	result = tree_delete(tree, &entry);
+	if (result == TREE_OK) {
+		tree->hdr.entries--;
+		tree->hdr.deleted++;
+		tree->version++;
+	}
+	rw_unlock_write(&(tree->tree_lock));
+
+	return result == TREE_OK ? DB_OK : DB_INDEX_ERROR;
 }
-#endif
 
 /****************************************************************************
- * Name: bucket_read
+ * Name: flush
  *
- * Description: Reads buckets from the cache and fetches them from flash
- *              when the entry does not exist in cache.
- *              Also evicts the suitable entries from cache when cache is full
+ * Description: Writes the tree metadata and every modified node and bucket
+ *              to flash, so that the index survives a power loss.
  *
- ****************************************************************************/
-static bucket_t *bucket_read(tree_t *tree, int bucket_id)
-{
-	pthread_mutex_lock(&(tree->buck_cache_lock));
-
-	bool found = false;
-	qnode_t *iter = (tree->buck_cache->in_cache.tail)->prev;
-
-	while (iter != (tree->buck_cache->in_cache.head)) {
-		if (bucket_id == iter->id && (iter->node_state & NODE_STATE_VALID)) {
-			found = true;
-			break;
-		}
-		iter = iter->prev;
-	}
-	if (found) {
-		/* If the bucket is found in the cache */
-		if (iter->node_state & NODE_STATE_LOCK) {
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		SET_NODE_STATE(iter, NODE_STATE_LOCK);
-		REMOVE_ENTRY(iter);
-		PLACE_AT_TAIL(iter, tree->buck_cache);
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return &(tree->buck_cache->cache_t[iter->pos].bucket);
-	} else {
-		/* Bucket has to be read from flash into the cache */
-		qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (new_node == NULL) {
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		if (tree->buck_cache->num < DB_HEAP_CACHE_LIMIT) {
-			new_node->pos = tree->buck_cache->num++;
-		} else {
-			/* Cache doesn't have enough space and the least recently used bucket needs to be evicted */
-			qnode_t *replace_node = tree->buck_cache->in_cache.head->next;
-			while ((replace_node->node_state & NODE_STATE_LOCK) && (replace_node != tree->buck_cache->in_cache.tail)) {
-				replace_node = replace_node->next;
-			}
-			if (replace_node == tree->buck_cache->in_cache.tail) {
-				free(new_node);
-				pthread_mutex_unlock(&(tree->buck_cache_lock));
-				return NULL;
-			}
-			if ((replace_node->node_state & NODE_STATE_DIRTY) && (replace_node->node_state & NODE_STATE_VALID)) {
-				bucket_write(tree, replace_node->id, &(tree->buck_cache->cache_t[replace_node->pos].bucket));
-			}
-			new_node->pos = replace_node->pos;
-			REMOVE_ENTRY(replace_node);
-			free(replace_node);
-		}
+ ****************************************************************************/
+static db_result_t flush(index_t *index)
+{
+	tree_t *tree;
 
-		/* Adjust the pointers */
-		PLACE_AT_TAIL(new_node, tree->buck_cache);
-		new_node->id = bucket_id;
-		SET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID);
-		UNSET_NODE_STATE(new_node, NODE_STATE_DIRTY);
-
-		/* Read from flash */
-		if (DB_ERROR(storage_read_from(tree->bucket_storage, (void *)&(tree->buck_cache->cache_t[new_node->pos].bucket), (unsigned long)bucket_id * sizeof(bucket_t), sizeof(bucket_t)))) {
-			DB_LOG_E("PANIC BUCKET READ FAILED AT ID %d\n", bucket_id);
-			UNSET_NODE_STATE(new_node, (NODE_STATE_LOCK | NODE_STATE_VALID));
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return &(tree->buck_cache->cache_t[new_node->pos].bucket);
+	tree = (tree_t *)index->opaque_data;
+	if (tree == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+	if (DB_ERROR(tree_write_header(tree, NULL, NULL))) {
+		return DB_STORAGE_ERROR;
+	}
+	if (DB_ERROR(buffer_pool_flush(tree->bucket_storage)) || DB_ERROR(buffer_pool_flush(tree->tree_storage))) {
+		return DB_STORAGE_ERROR;
 	}
+	return DB_OK;
 }
 
 /****************************************************************************
- * Name: cache_bucket_append
+ * Name: cost
  *
- * Description: Routine to append an index entry to a bucket in cache
+ * Description: Estimates the reads to find matching keys: a node per level
+ *              on the way down, then the chained buckets holding the keys,
+ *              as many entries to a bucket as the buckets hold on average.
  *
  ****************************************************************************/
-static cache_result_t cache_bucket_append(tree_t *tree, int bucket_id, pair_t *pair)
+static unsigned long cost(index_t *index, unsigned long matches)
 {
-	bucket_t *bucket_tmp = bucket_read(tree, bucket_id);
-	if (bucket_tmp == NULL) {
-		return CACHE_NOT_EXIST;
-	}
-	if (bucket_tmp->next_free_slot >= BUCKET_SIZE) {
-		modify_cache(tree, bucket_id, BUCKET, UNLOCK);
-		return CACHE_BUCKET_FULL;
-	}
-	bucket_tmp->info[1] = min(bucket_tmp->info[1], pair->key);
-	bucket_tmp->info[2] = max(bucket_tmp->info[2], pair->key);
-	bucket_tmp->pairs[bucket_tmp->next_free_slot].key = pair->key;
-	bucket_tmp->pairs[bucket_tmp->next_free_slot].value = pair->value;
-	bucket_tmp->next_free_slot++;
-	pthread_mutex_lock(&(tree->bucket_lock));
-	if (tree->lock_buckets[bucket_id] == 0) {
-		DB_LOG_E("PANIC EDITED BUCKET WITHOUT LOCK\n");
-		pthread_mutex_unlock(&(tree->bucket_lock));
-		return CACHE_UNLOCKED;
-	} else {
-		tree->lock_buckets[bucket_id] = 0;
-		pthread_mutex_unlock(&(tree->bucket_lock));
+	tree_t *tree;
+	unsigned long per_bucket;
+
+	tree = (tree_t *)index->opaque_data;
+	if (tree == NULL) {
+		return ULONG_MAX;
 	}
-	modify_cache(tree, bucket_id, BUCKET, DIRTY);
-	modify_cache(tree, bucket_id, BUCKET, UNLOCK);
+	per_bucket = tree->hdr.entries / (tree->hdr.off_buckets - tree->hdr.free_buckets) + 1;
+	return tree->hdr.levels + (matches + per_bucket - 1) / per_bucket;
+}
 
-	return CACHE_OK;
+static void entry_from_index(struct entry_s *entry, const index_entry_t *from)
+{
+	memcpy(entry->key, from->key, from->key_length);
+	entry->length = from->key_length;
+	entry->tuple_id = from->tuple_id;
+	entry->child = PAGE_NONE;
 }
 
 /****************************************************************************
- * Name: tree_split
+ * Name: bulk_fill
  *
- * Description: A recursive function implementing the tree splitting logic
- *              which is called if the insertion fails and the tree needs to
- *              grow. The nodes are split in a top-down approach.
- *              i.e. higher nodes are split then the lower nodes are split.
+ * Description: Fills a page with the entries picked by picks[first..n), or
+ *              entries[first..n) if picks is NULL, as long as they fit in
+ *              BULK_FILL. At least one entry is taken. Returns the end of
+ *              the entries taken; their children are given by ids.
  *
  ****************************************************************************/
-static tsplit_status_t tree_split(tree_t *tree, int key, int id, pair_t *path, int level)
+static int bulk_fill(page_t *page, page_type_t type, index_entry_t *entries, int *picks, uint16_t *ids, int first, int n)
 {
-	if (level < 0 || level > (tree->levels - 1)) {
-		DB_LOG_E("PANIC: Tree level out of bounds\n");
-	}
-	/* TODO
-	 * It is very hard to understand n, node, n1, n2 means exactly.
-	 * Please rename variable & add descriptions more in detail for each progress
-	 */
-	tree_node_t *n;
-	tree_node_t node;
-	int i, j;
-	if (path[level].key == ROOT_NODE_PARENT) {
-		/* Case when root has split and new root node requires to be created */
-		uint8_t root = tree->root;
-		uint8_t new_root = tree->off_nodes++;
-		if (tree->off_nodes > CONFIG_NODE_LIMIT) {
-			tree->off_nodes--;
-			return TSPLIT_FAIL;
-		}
-		node.val[0] = key;
-		node.id[0] = root;
-		node.id[1] = id;
-		node.val[BRANCH_FACTOR - 1] = 1;
-		node.is_leaf = 0;
-		while (cache_write_node(tree, new_root, &node) != CACHE_OK) ;
-		tree->root = new_root;
-		tree->levels++;
-		return TSPLIT_OK;
-	}
-	/* TODO
-	 * Absent of noncast return handling, should be taken care in the definition
-	 */
-	n = tree_read(tree, path[level].key);
-	if (n == NULL) {
-		DB_LOG_E("CACHE FULL:All writed locked\n");
-		return TSPLIT_ERROR;
-	}
-
-	if ((n->val[BRANCH_FACTOR - 1] < BRANCH_FACTOR - 1)) {
-		/* The case when the node has space for new entry */
-		node.is_leaf = n->is_leaf;
-		node.val[BRANCH_FACTOR - 1] = n->val[BRANCH_FACTOR - 1] + 1;
-		node.id[0] = n->id[0];
-		/* Insert the key at appropriate place in the node */
-		j = 0;
-		for (i = 0; i < node.val[BRANCH_FACTOR - 1]; i++) {
-			if (i == path[level].value) {
-				node.val[i] = key;
-				node.id[i + 1] = id;
-			} else {
-				node.val[i] = n->val[j];
-				node.id[i + 1] = n->id[j + 1];
-				j++;
-			}
-		}
-
-		/* Replace the entry for the node in the cache with the new node after inserting the key */
-		if (cache_replace_node(tree, path[level].key, &node) != CACHE_OK) {
-			return TSPLIT_ERROR;
-		}
-		return TSPLIT_OK;
-	} else {
-		/* Case when the node doesn't have space for new key and requires splitting */
-		tree_node_t node1;
-		int res;
-		int nid = tree->off_nodes++;
-		/* Create dummy arrays to facilitate splitting */
-		int key_arr[BRANCH_FACTOR];
-		int ids_arr[BRANCH_FACTOR + 1];
-
-		if (tree->off_nodes > CONFIG_NODE_LIMIT) {
-			tree->off_nodes--;
-			modify_cache(tree, path[level].key, NODE, UNLOCK);
-			return TSPLIT_FAIL;
-		}
-
-		ids_arr[0] = n->id[0];
-		j = 0;
-		for (i = 0; i < BRANCH_FACTOR; i++) {
-			if (i == path[level].value) {
-				key_arr[i] = key;
-				ids_arr[i + 1] = id;
-			} else {
-				key_arr[i] = n->val[j];
-				ids_arr[i + 1] = n->id[j + 1];
-				j++;
-			}
+	struct entry_s entry;
+	index_entry_t *previous = NULL;
+	index_entry_t *e;
+	unsigned prefix = 0;
+	unsigned size = 0;
+	unsigned p;
+	unsigned s;
+	int end;
+
+	for (end = first; end < n && end - first < PAGE_ENTRY_LIMIT; end++) {
+		e = &entries[picks != NULL ? picks[end] : end];
+		p = previous == NULL ? e->key_length : min(prefix, key_common(previous->key, previous->key_length, e->key, e->key_length));
+		s = size + entry_size(e->key_length, type);
+		if (previous != NULL && p + s - (end - first + 1) * p > BULK_FILL(type)) {
+			break;
 		}
-		/* Call tree_split to insert the median value(BRANCH_FACTOR/2) in the upper level node(level-1) */
-		res = tree_split(tree, key_arr[BRANCH_FACTOR / 2], nid, path, level - 1);
-		if (res == TSPLIT_OK) {
-			node.val[BRANCH_FACTOR - 1] = BRANCH_FACTOR / 2;
-			node1.val[BRANCH_FACTOR - 1] = (BRANCH_FACTOR - 1) / 2;
-			node.is_leaf = n->is_leaf;
-			node1.is_leaf = n->is_leaf;
-			int ind = 0;
-			node.id[0] = ids_arr[0];
-
-			/* Copy left half into the same node and right half into new node */
-			for (; ind < BRANCH_FACTOR / 2; ind++) {
-				node.val[ind] = key_arr[ind];
-				node.id[ind + 1] = ids_arr[ind + 1];
-			}
-			ind++;
-			node1.id[0] = ids_arr[BRANCH_FACTOR / 2 + 1];
-			for (; ind < BRANCH_FACTOR; ind++) {
-				node1.val[ind - BRANCH_FACTOR / 2 - 1] = key_arr[ind];
-				node1.id[ind - BRANCH_FACTOR / 2] = ids_arr[ind + 1];
-			}
+		prefix = p;
+		size = s;
+		previous = e;
+	}
 
-			/* Replace the left node and write the right node in the cache */
-			cache_replace_node(tree, path[level].key, &node);
-			cache_write_node(tree, nid, &node1);
-		} else {
-			modify_cache(tree, path[level].key, NODE, UNLOCK);
-			tree->off_nodes--;
+	page_reset(page, entries[picks != NULL ? picks[first] : first].key, first < end ? prefix : 0);
+	for (; first < end; first++) {
+		entry_from_index(&entry, &entries[picks != NULL ? picks[first] : first]);
+		if (ids != NULL) {
+			entry.child = ids[first];
 		}
-		return res;
+		page_append(page, type, &entry);
 	}
+	return end;
 }
 
 /****************************************************************************
- * Name: tree_split
+ * Name: bulk_load
  *
- * Description: This routine splits the bucket and calls the tree_split
- *              function. This is called when a bucket is full and is part of
- *              the insertion process of an index entry
+ * Description: Builds an empty tree bottom-up from entries sorted by key and
+ *              tuple id. The buckets are filled to BULK_FILL in key order
+ *              and chained, then each level of nodes is built over the one
+ *              below until a single root is left. DB_LIMIT_ERROR is returned
+ *              if the tree is not empty, or if the entries need more than
+ *              CONFIG_BUCKETS_LIMIT buckets or CONFIG_NODE_LIMIT nodes, or
+ *              take the tuple ids past DB_TUPLES_LIMIT with flushing. If a
+ *              page cannot be written, the pages written so far are dropped
+ *              and DB_STORAGE_ERROR is returned with the tree empty again,
+ *              or DB_INDEX_ERROR if the empty tree cannot be written either.
  *
  ****************************************************************************/
-static bsplit_status_t bucket_split(tree_t *tree, int key, int value, pair_t *path)
+static db_result_t bulk_load(index_t *index, index_entry_t *entries, int count)
 {
-	int median;
-	bucket_t *bucket;
-	uint16_t bucket_id = path[tree->levels].key;
+	tree_t *tree;
+	page_t *page;
+	uint16_t *ids;
+	int *picks;
+	int nbuckets;
+	int nid;
+	int n;
+	int groups;
+	int end;
 	int i;
-	if (tree->off_buckets == CONFIG_BUCKETS_LIMIT - 1) {
-		DB_LOG_E("TREE FULL !");
-		return BSPLIT_FAIL;
-	}
-
-	/* TODO
-	 * Absent of non-cast return handling, should be taken care in the definition
-	 */
-	bucket = bucket_read(tree, bucket_id);
-
-	/* Sort the key-value pairs in the bucket according to the keys and pick the median */
-	pair_t bucket_tuples[BUCKET_SIZE + 1];
-	for (i = 0; i < BUCKET_SIZE; i++) {
-		bucket_tuples[i].key = bucket->pairs[i].key;
-		bucket_tuples[i].value = bucket->pairs[i].value;
-	}
-	bucket_tuples[BUCKET_SIZE].key = key;
-	bucket_tuples[BUCKET_SIZE].value = value;
-
-	qsort(bucket_tuples, BUCKET_SIZE + 1, sizeof(pair_t), compare);
-
-	median = bucket_tuples[(BUCKET_SIZE + 1) / 2].key;
-	/* Call tree_split before creating a new bucket and dividing the entries */
-	int b_id = tree->off_buckets++;
-	int res = tree_split(tree, median, b_id, path, tree->levels - 1);
-
-	/* Proceed only if the tree split is successful. This ensures top-down splitting of the tree nodes */
-	if (res == TSPLIT_OK) {
-		bucket_t b1, b2;
-		int ind = 0;
-		int off;
-		for (;; ind++) {
-			if (ind == (BUCKET_SIZE + 1) / 2) {
-				break;
-			}
-			b1.pairs[ind] = bucket_tuples[ind];
-		}
-		off = ind;
-		for (; ind < BUCKET_SIZE + 1; ind++) {
-			b2.pairs[ind - off] = bucket_tuples[ind];
-		}
+	db_result_t result;
 
-		b2.next_free_slot = BUCKET_SIZE + 1 - off;
-		b1.next_free_slot = off;
-		/* Start Bucket chaining */
-		b2.info[0] = bucket->info[0];
-		b1.info[0] = b_id;
-		b1.info[1] = b1.pairs[0].key;
-		b1.info[2] = b1.pairs[b1.next_free_slot - 1].key;
-		b2.info[1] = b2.pairs[0].key;
-		b2.info[2] = b2.pairs[b2.next_free_slot - 1].key;
-		/* End of Bucket chaining */
-
-		modify_cache(tree, bucket_id, BUCKET, INVALIDATE);
-		cache_write_bucket(tree, bucket_id, &b1);
-		cache_write_bucket(tree, b_id, &b2);
-	} else {
-		tree->off_buckets--;
-		modify_cache(tree, bucket_id, BUCKET, UNLOCK);
+	tree = (tree_t *)index->opaque_data;
+	if (tree == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+	if (count <= 0) {
+		return DB_LIMIT_ERROR;
+	}
+#ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
+	if (tree->hdr.inserted + count >= DB_TUPLES_LIMIT) {
+		return DB_LIMIT_ERROR;
 	}
-	return BSPLIT_OK;
+#endif
+
+	page = (page_t *)bptree_malloc(sizeof(page_t));
+	ids = (uint16_t *)malloc((CONFIG_BUCKETS_LIMIT + 1) * sizeof(uint16_t));
+	picks = (int *)malloc((CONFIG_BUCKETS_LIMIT + 1) * sizeof(int));
+	if (page == NULL || ids == NULL || picks == NULL) {
+		free(page);
+		free(ids);
+		free(picks);
+		return DB_ALLOCATION_ERROR;
+	}
+
+	rw_lock_write(&tree->tree_lock);
+	if (tree->hdr.entries != 0) {
+		result = DB_LIMIT_ERROR;
+		goto out;
+	}
+
+	/* Buckets in key order, each starting with the separator picked for it */
+	nbuckets = 0;
+	result = DB_LIMIT_ERROR;
+	for (i = 0; i < count; i = end) {
+		if (nbuckets == CONFIG_BUCKETS_LIMIT) {
+			goto errout;
+		}
+		memset(&page->hdr, 0, sizeof(page->hdr));
+		end = bulk_fill(page, BUCKET, entries, NULL, NULL, i, count);
+		page->hdr.link = end < count ? nbuckets + 1 : PAGE_NONE;
+		if (page_put(tree, BUCKET, nbuckets, page) < 0) {
+			result = DB_STORAGE_ERROR;
+			goto errout;
+		}
+		ids[nbuckets] = nbuckets;
+		picks[nbuckets] = i;
+		nbuckets++;
+	}
+
+	/* Each node has the first child of a group as its link and the others
+	   with their separators as entries. The first separator of each group
+	   goes up to the level above. */
+	nid = 0;
+	n = nbuckets;
+	tree->hdr.levels = 1;
+	do {
+		groups = 0;
+		for (i = 0; i < n; i = end) {
+			if (nid == CONFIG_NODE_LIMIT) {
+				goto errout;
+			}
+			memset(&page->hdr, 0, sizeof(page->hdr));
+			page->hdr.link = ids[i];
+			page->hdr.is_leaf = tree->hdr.levels == 1;
+			end = i + 1 < n ? bulk_fill(page, NODE, entries, picks, ids, i + 1, n) : i + 1;
+			if (page_put(tree, NODE, nid, page) < 0) {
+				result = DB_STORAGE_ERROR;
+				goto errout;
+			}
+			ids[groups] = nid++;
+			picks[groups] = picks[i];
+			groups++;
+		}
+		n = groups;
+		tree->hdr.levels++;
+	} while (n > 1);
+
+	tree->hdr.root = ids[0];
+	tree->hdr.off_nodes = nid;
+	tree->hdr.off_buckets = nbuckets;
+	tree->hdr.free_node = PAGE_NONE;
+	tree->hdr.free_bucket = PAGE_NONE;
+	tree->hdr.free_nodes = 0;
+	tree->hdr.free_buckets = 0;
+	tree->hdr.entries = count;
+	tree->hdr.inserted += count;
+	tree->version++;
+	result = DB_OK;
+	goto out;
+
+errout:
+	/* Nothing but the pages written here refers to them, so an empty tree is
+	   what the caller had before */
+	if (tree_reset(tree) < 0) {
+		result = DB_INDEX_ERROR;
+	}
+out:
+	rw_unlock_write(&tree->tree_lock);
+	free(page);
+	free(ids);
+	free(picks);
+	return result;
+}
+
+/* Whether an entry is after the upper bound, compared over the length of the bound */
+static int iterator_past_end(index_iterator_t *iterator, const struct entry_s *entry)
+{
+	return memcmp(entry->key, iterator->max_key, min(entry->length, iterator->max_length)) > 0;
 }
 
 /****************************************************************************
- * Name: insert_item_btree
+ * Name: get_next
  *
- * Description: This implements the whole insertion logic by using the
- *              routines defined above.
+ * Description: Returns the tuple id of the next entry in the range of the
+ *              iterator and sets the key of the iterator to its key. The
+ *              iterator keeps the bucket and offset of the next entry, and
+ *              finds its place again from the last key if the tree changed
+ *              in between. With matched_condition FALSE the entry returned
+ *              is removed.
  *
  ****************************************************************************/
-tree_result_t insert_item_btree(tree_t *tree, int key, int value)
+static tuple_id_t get_next(index_iterator_t *iterator, uint8_t matched_condition)
 {
-	int bucket_id;
-	pair_t *path;
-	bucket_t *tmp_bucket;
-	int num_entries_bucket = 0;
-start:
-	bucket_id = -1;
-	pair_t pair;
-	while (bucket_id < 0) {
-		rw_lock_read(&(tree->tree_lock));
-		path = tree_find(tree, key);
-		if (path == NULL) {
-			rw_unlock_read(&(tree->tree_lock));
-			continue;
+	struct probe_s probe;
+	struct path_s path;
+	struct slot_s slot;
+	struct entry_s entry;
+	tree_t *tree;
+	page_t *page;
+	uint16_t id;
+	unsigned offset;
+	tuple_id_t result = INVALID_TUPLE;
+
+	tree = (tree_t *)iterator->index->opaque_data;
+	if (iterator->empty) {
+		iterator->next_item_no = 0;
+		return INVALID_TUPLE;
+	}
+
+	rw_lock_write(&(tree->tree_lock));
+	if (iterator->found_items == 0 || iterator->version != tree->version) {
+		/* The first entry from the lower bound, or after the last one returned */
+		if (iterator->found_items == 0) {
+			probe.key = iterator->min_key;
+			probe.length = iterator->min_length;
+			probe.any_tuple = TRUE;
+		} else {
+			probe.key = iterator->key;
+			probe.length = iterator->key_length;
+			probe.tuple_id = iterator->last_tuple;
+			probe.any_tuple = FALSE;
+		}
+		if (tree_descend(tree, &probe, &path) < 0 || (page = page_pin(tree, BUCKET, path.bucket)) == NULL) {
+			goto out;
 		}
-		bucket_id = path[tree->levels].key;
-		rw_unlock_read(&(tree->tree_lock));
-	}
-	pair.key = key;
-	pair.value = value;
-	tmp_bucket = bucket_read(tree, bucket_id);
-	num_entries_bucket = tmp_bucket->next_free_slot;
-	modify_cache(tree, bucket_id, BUCKET, UNLOCK);
-
-	/* When the bucket is full and requires splitting */
-	if (num_entries_bucket == BUCKET_SIZE) {
-		DB_LOG_D("DB: Bucket %d is full\n", bucket_id);
-retry:
-		if (rw_trylock_write(&(tree->tree_lock)) == 0) {
-			pthread_mutex_lock(&(tree->bucket_lock));
-			tree->lock_buckets[bucket_id] = 0;
-			pthread_mutex_unlock(&(tree->bucket_lock));
-			free(path);
-			goto start;
+		page_find(page, BUCKET, &probe, &slot);
+		page_unpin(tree, BUCKET, path.bucket, FALSE);
+		iterator->page = path.bucket;
+		iterator->offset = slot.offset;
+		iterator->version = tree->version;
+	}
+
+	for (id = iterator->page, offset = iterator->offset; id != PAGE_NONE; id = iterator->page, offset = 0) {
+		page = page_pin(tree, BUCKET, id);
+		if (page == NULL) {
+			goto out;
 		}
-		/* Call the bucket split function and depending on the return value take further action */
-		int res = bucket_split(tree, key, value, path);
-		if (res == BSPLIT_FAIL) {
-			pthread_mutex_lock(&(tree->bucket_lock));
-			if (tree->lock_buckets[bucket_id] == 0) {
-				DB_LOG_E("PANIC EDITED BUCKET WITHOUT LOCK\n");
-				pthread_mutex_unlock(&(tree->bucket_lock));
-				rw_unlock_write(&(tree->tree_lock));
-				free(path);
-				return TREE_LOCK_ERROR;
+		if (offset < page->hdr.prefix) {
+			offset = page->hdr.prefix;
+		}
+		if (offset < page->hdr.used) {
+			iterator->offset = page_read(page, BUCKET, offset, &entry);
+			if (iterator_past_end(iterator, &entry)) {
+				page_unpin(tree, BUCKET, id, FALSE);
+				break;
+			}
+
+			iterator->found_items++;
+			iterator->next_item_no = iterator->found_items;
+			memcpy(iterator->key, entry.key, entry.length);
+			iterator->key_length = entry.length;
+			iterator->last_tuple = entry.tuple_id;
+			result = entry.tuple_id;
+
+			/* matched condition is FALSE when the query is for remove tuples */
+			if (matched_condition == FALSE) {
+				page_remove(page, BUCKET, offset);
+				page_unpin(tree, BUCKET, id, TRUE);
+				tree->hdr.entries--;
+				tree->hdr.deleted++;
+				tree->version++;
+				iterator->offset = offset;
+				iterator->version = tree->version;
 			} else {
-				tree->lock_buckets[bucket_id] = 0;
-				pthread_mutex_unlock(&(tree->bucket_lock));
-				rw_unlock_write(&(tree->tree_lock));
+				page_unpin(tree, BUCKET, id, FALSE);
 			}
-			free(path);
-			return TREE_INSERT_FAIL;
-		} else if (res == BSPLIT_RETRY) {
-			rw_unlock_write(&(tree->tree_lock));
-			goto retry;
+			goto out;
 		}
+		iterator->page = page->hdr.link;
+		page_unpin(tree, BUCKET, id, FALSE);
+	}
 
-		pthread_mutex_lock(&(tree->bucket_lock));
-		if (tree->lock_buckets[bucket_id] == 0) {
-			DB_LOG_E("PANIC EDITED BUCKET WITHOUT LOCK\n");
-			pthread_mutex_unlock(&(tree->bucket_lock));
-			rw_unlock_write(&(tree->tree_lock));
-			free(path);
-			return TREE_LOCK_ERROR;
-		} else {
-			tree->lock_buckets[bucket_id] = 0;
-			pthread_mutex_unlock(&(tree->bucket_lock));
-			rw_unlock_write(&(tree->tree_lock));
-		}
+	iterator->page = PAGE_NONE;
+	if (iterator->found_items == 0) {
+		iterator->next_item_no = 0;
 	} else {
-		/* If the bucket has space for the entry, just append the new entry in the cache */
-		cache_bucket_append(tree, bucket_id, &pair);
-		tree->inserted++;
+		iterator->next_item_no = 1;
 	}
-	free(path);
-	return TREE_OK;
+
+out:
+	rw_unlock_write(&(tree->tree_lock));
+	return result;
 }
 
 #ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
 /****************************************************************************
  * Name: db_flush
  *
- * Description: Removes the old tuples from storage in case the tuple
- *              storage limit is reached
+ * Description: Removes the older half of the tuples from storage when the
+ *              tuple storage limit is reached. The tuples from the threshold
+ *              on are copied in order to a new tuple file, so each tuple id
+ *              drops by the threshold. The entries of removed tuples are
+ *              dropped from the buckets, and the tuple ids of the others and
+ *              of the separators lowered, which keeps the order of entries.
  *
  ****************************************************************************/
 static int db_flush(tree_t *tree, relation_t *rel)
 {
-	DB_LOG_D("Started flushing the database. Deleted till now: %d\n", tree->deleted);
+	DB_LOG_D("Started flushing the database. Deleted till now: %d\n", tree->hdr.deleted);
 	char tuple_path[TUPLE_NAME_LENGTH];
 	db_result_t result;
 	relation_t old_rel;
-	int flush_threshold = DB_TUPLES_LIMIT / 2;
+	tuple_id_t flush_threshold = DB_TUPLES_LIMIT / 2;
 	memcpy(&old_rel, rel, sizeof(relation_t));
 	unsigned long long offset;
 	int fd;
@@ -1967,7 +1779,6 @@ static int db_flush(tree_t *tree, relation_t *rel)
 	}
 	strncpy(rel->tuple_filename, tuple_path, TUPLE_NAME_LENGTH);
 
-	/* char buff[sizeof(rel->tuple_filename)+13] */
 	result = storage_write_to(fd, rel->tuple_filename, offset, sizeof(rel->tuple_filename));
 
 	storage_close(fd);
@@ -1977,620 +1788,70 @@ static int db_flush(tree_t *tree, relation_t *rel)
 	}
 	rel->tuple_storage = storage_open(rel->tuple_filename, O_RDWR);
 
-	int id;
-	int num_tuples = 0;
-	rel->next_row = num_tuples;
-	rel->cardinality = num_tuples;
-	storage_row_t temp = bptree_malloc(sizeof(rel->row_length));
+	struct probe_s probe = { NULL, 0, 0, TRUE };
+	struct path_s path;
+	page_t *page;
+	uint8_t *p;
+	tuple_id_t tid;
+	unsigned suffix;
+	uint16_t id;
+	uint16_t next;
+
+	rel->next_row = 0;
+	rel->cardinality = 0;
+	storage_row_t temp = bptree_malloc(rel->row_length);
 	if (temp == NULL) {
 		return DB_ALLOCATION_ERROR;
 	}
-	/* Iterate over the buckets and pick the tuples which should be retained i.e. written
-	 * to the new storage file. Currently tuple_id decides this.
-	 */
-	for (id = 0; id < tree->off_buckets; id++) {
-		/* TODO
-		 * Absent of non-cast return handling, should be taken care in the definition
-		 */
-		bucket_t *bucket = bucket_read(tree, id);
-
-		int num, ind;
-		int num_entries = bucket->next_free_slot;
-		for (num = 0, ind = 0; num < num_entries; num++) {
-			tuple_id_t tup;
-			tup = bucket->pairs[num].value;
-
-			if (tup >= flush_threshold) {
-				storage_get_row(&old_rel, &tup, temp);
-				storage_put_row(rel, temp, FALSE);
-				uint16_t tmp_key = bucket->pairs[num].key;
-				bucket->pairs[ind].key = tmp_key;
-				bucket->pairs[ind].value = num_tuples;
-				num_tuples++;
-				ind++;
-			} else {
-				bucket->next_free_slot--;
-				tree->deleted++;
-			}
-		}
-		/* Start Bucket chaining */
-		int iter = 0;
-		uint16_t new_min = bucket->info[1];
-		uint16_t new_max = bucket->info[2];
-		for (; iter < bucket->next_free_slot; iter++) {
-			new_min = min(bucket->pairs[iter].key, new_min);
-			new_max = max(bucket->pairs[iter].key, new_max);
-		}
-		bucket->info[1] = new_min;
-		bucket->info[2] = new_max;
-		/* End of Bucket chaining */
-
-		modify_cache(tree, id, BUCKET, DIRTY);
-		modify_cache(tree, id, BUCKET, UNLOCK);
+	for (tid = flush_threshold; storage_get_row(&old_rel, &tid, temp) == DB_OK; tid++) {
+		storage_put_row(rel, temp, FALSE);
 	}
 	free(temp);
-	tree->inserted -= tree->deleted;
-	tree->deleted = 0;
-	storage_remove(old_rel.tuple_filename);
-	DB_LOG_D("Flushed the database.\n");
-	return DB_OK;
-}
-#endif
-
-//caller need to free memory of rm_values
-static int bucket_remove_pair(bucket_t *bucket, int value, int **rm_values, int remove_all)
-{
-	int i;
-	int j;
-	int new_range;
-	bool bMin = false;
-	bool bMax = false;
-	int rm_cnt = 0;
-	int *removed;
-
-	DB_LOG_V("bucket_remove_pair , bucket 0x%x , value %d\n", bucket, value);
-	bMin = (bucket->info[1] == value);
-	bMax = (bucket->info[2] == value);
-	removed = (int *)bptree_malloc(bucket->next_free_slot * sizeof(int));
-	if (removed == NULL) {
-		return 0;
-	}
-
-	for (i = 0; i < bucket->next_free_slot; i++) {
-		if (bucket->pairs[i].key == value) {
-			removed[rm_cnt++] = bucket->pairs[i].value;
-			bucket->next_free_slot--;
-			for (j = i; j < bucket->next_free_slot; j++) {
-				bucket->pairs[j].key = bucket->pairs[j + 1].key;
-				bucket->pairs[j].value = bucket->pairs[j + 1].value;
-			}
-
-			if (remove_all == 0) {
-				break; //delete only one pair, make it possible to update
-			}			
-			i--; //do not break, remove all item match the value
-		}
-	}
-
-	if (bucket->next_free_slot > 0 && (bMin || bMax)) {
-		new_range = bucket->pairs[0].key;
-		for (i = 0; i < bucket->next_free_slot; i++) {
-			if (bMin && (bucket->pairs[i].key < new_range)) {
-				new_range = bucket->pairs[i].key;
-			}
-			if (bMax && (bucket->pairs[i].key > new_range)) {
-				new_range = bucket->pairs[i].key;
-			}
-		}
-
-		if (bMin) {
-			bucket->info[1] = new_range;
-		} else if (bMax) {
-			bucket->info[2] = new_range;
-		}
-	}
-
-	*rm_values = removed;
-	return rm_cnt;
-}
-
-static void tree_node_update_keys(tree_t *tree, pair_t *path, int rm_val, int level, int range_min)
-{
-	int i;
-	int node_id;
-	tree_node_t *n;
-	bool bFound = false;
-
-	node_id = path[level].key;
-	if (node_id == ROOT_NODE_PARENT) {
-		return;
-	}
-
-	n = tree_read(tree, node_id);
-	if (n == NULL) {
-		return;
-	}
-
-	for (i = 0; i < n->val[BRANCH_FACTOR - 1]; i++) {
-		if (n->val[i] == rm_val) {
-			n->val[i] = range_min;
-			bFound = true;
-			DB_LOG_D("Found keys, value %d , node_id %d\n", rm_val, node_id);
-			break;
-		}
-	}
-
-	if (level > 0 && !bFound) {
-		tree_node_update_keys(tree, path, rm_val, level-1, range_min);
-	}
-
-	modify_cache(tree, node_id, NODE, UNLOCK);
-	return;
-}
-
-//check and update if delete key is in the tree node.val
-static void bucket_update_keys(tree_t *tree, pair_t *path, int bucket_id, int rm_val)
-{
-	int i;
-	int node_id;
-	tree_node_t *n;
-	bool bLeaf = false;
-	int range_min;
-	bucket_t *first_bucket;
-
-	node_id = path[tree->levels - 1].key;
-
-	n = tree_read(tree, node_id);
-	if (n == NULL) {
-		return;
-	}
-
-	for (i = 0; i < n->val[BRANCH_FACTOR - 1]; i++) {
-		if (n->val[i] == rm_val) {
-			first_bucket = bucket_read(tree, bucket_id);
-			n->val[i] = first_bucket->info[1];
-			modify_cache(tree, bucket_id, BUCKET, UNLOCK);
-			bLeaf = true;
-			DB_LOG_D("bucket_update_keys, value %d , node_id %d\n", rm_val, node_id);
-			break;
-		}
-	}
-
-	if (!bLeaf) {
-		first_bucket = bucket_read(tree, n->id[0]);
-		if (first_bucket == NULL) {
-			modify_cache(tree, node_id, NODE, UNLOCK);
-			return;
-		}
-		range_min = first_bucket->info[1];
-		modify_cache(tree, n->id[0], BUCKET, UNLOCK);
-
-		tree_node_update_keys(tree, path, rm_val, tree->levels - 2, range_min);
-	}
-
-	modify_cache(tree, node_id, NODE, UNLOCK);
-}
-
-static int bucket_request_sibling(tree_t *tree, pair_t *path, bucket_t *bucket)
-{
-	int i;
-	int index;
-	int node_id;
-	bucket_t *left_bucket;
-	bucket_t *right_bucket;
-	tree_node_t *n;
-	int share_key;
-	int *share_value = NULL;
-	int value_cnt;
-
-	node_id = path[tree->levels - 1].key;
-	n = tree_read(tree, node_id);
-	index = path[tree->levels - 1].value;
-	//check left sibling
-	if (index) {
-		if (n->id[index - 1] < CONFIG_BUCKETS_LIMIT - 1) {
-			left_bucket = bucket_read(tree, n->id[index-1]);
-			if (left_bucket && left_bucket->next_free_slot > BUCKET_SIZE / 2) {
-				share_key = left_bucket->info[2];
-				value_cnt = bucket_remove_pair(left_bucket, share_key, &share_value, 1);
-
-				bucket->info[1] = share_key;
-				for (i = 0; i < value_cnt; i++) {
-					bucket->pairs[bucket->next_free_slot].key = share_key;
-					bucket->pairs[bucket->next_free_slot].value = share_value[i];
-					bucket->next_free_slot++;
-				}
-				free(share_value);
-
-				n->val[index - 1] = share_key;
-
-				modify_cache(tree, node_id, NODE, UNLOCK);
-				modify_cache(tree, n->id[index - 1], BUCKET, UNLOCK);
-				return 0;
-			}
-			modify_cache(tree, n->id[index - 1], BUCKET, UNLOCK);
-		}
-	}
-
-	//check right sibling
-	if (index < n->val[BRANCH_FACTOR - 1]) {
-		if (n->id[index + 1] < CONFIG_BUCKETS_LIMIT - 1) {
-			right_bucket = bucket_read(tree, n->id[index + 1]);
-			if (right_bucket && right_bucket->next_free_slot > BUCKET_SIZE / 2) {
-				share_key = right_bucket->info[1];
-				value_cnt = bucket_remove_pair(right_bucket, share_key, &share_value, 1);
-
-				bucket->info[2] = share_key;
-				for (i = 0; i < value_cnt; i++) {
-					bucket->pairs[bucket->next_free_slot].key = share_key;
-					bucket->pairs[bucket->next_free_slot].value = share_value[i];
-					bucket->next_free_slot++;
-				}
-				free(share_value);
-
-				n->val[index] = right_bucket->info[1];
-
-				modify_cache(tree, node_id, NODE, UNLOCK);
-				modify_cache(tree, n->id[index + 1], BUCKET, UNLOCK);
-				return 0;
-			}
-
-			modify_cache(tree, n->id[index + 1], BUCKET, UNLOCK);
-		}
-	}
-
-	modify_cache(tree, node_id, NODE, UNLOCK);
-	return -1;
-}
-
-static void bucket_update_next(tree_t *tree, int bucket_id, int next_id)
-{
-	bucket_t *bucket;
-
-	bucket = bucket_read(tree, bucket_id);
-	if (bucket) {
-		bucket->info[0] = next_id;
-		DB_LOG_D("set bucket %d next id %d\n", bucket_id, next_id);
-	}
-	modify_cache(tree, bucket_id, BUCKET, UNLOCK);
-}
-
-static int bucket_get_prev_id(tree_t *tree, pair_t *path)
-{
-	int node_level;
-	int pnode_id;
-	int index;
-	int sb_id;
-	int left_bucket = -1;
-	tree_node_t *pn;
-	tree_node_t *sbn = NULL;
-
-	node_level = tree->levels-1;
-	pnode_id = path[node_level - 1].key;
-	if (pnode_id == ROOT_NODE_PARENT) {
-		return -1;
-	}
-
-	index = path[node_level - 1].value;
-	//check left sibling node 
-	if (index) {
-		pn = tree_read(tree, pnode_id);	
-		sb_id = pn->id[index - 1];
-		sbn = tree_read(tree, sb_id);
-		if (sbn) {
-			left_bucket = sbn->id[sbn->val[BRANCH_FACTOR - 1]];
-		}
-
-		modify_cache(tree, pnode_id, NODE, UNLOCK);
-		modify_cache(tree, sb_id, NODE, UNLOCK);
-	}
-
-	return left_bucket;
-}
-
-static int tree_rebuild_node(tree_t *tree, pair_t *path, int level)
-{
-	int i;
-	int node_id;
-	int lsb_id = -1;
-	int rsb_id = -1;
-	int pnode_id;
-	int index;
-	int key_num;
-	int sb_key_num;
-	bool bmerge_left = false;
-	bool bmerge_right = false;
-	tree_node_t *n;
-	tree_node_t *pn;
-	tree_node_t *lsbn = NULL;
-	tree_node_t *rsbn = NULL;
-
-	node_id = path[level].key;
-	if (node_id == ROOT_NODE_PARENT) {
-		return 0;
-	}
-	n = tree_read(tree, node_id);
-
-	pnode_id = path[level - 1].key;
-	index = path[level - 1].value;
-	pn = tree_read(tree, pnode_id);
-	//check left sibling node 
-	if (index) {
-		lsb_id = pn->id[index - 1];
-		lsbn = tree_read(tree, lsb_id);
-		if (lsbn && (lsbn->val[BRANCH_FACTOR - 1] > BRANCH_FACTOR / 2)) {
-			//move own keys
-			key_num = n->val[BRANCH_FACTOR - 1] + 1;
-			for (i = key_num; i >= 1; i--) {
-				n->val[i] = n->val[i - 1];
-				n->id[i] = n->id[i - 1];
-			}
-			n->val[BRANCH_FACTOR - 1] = key_num;
-			
-			//move key, and child id, from sibling and parent
-			sb_key_num = lsbn->val[BRANCH_FACTOR - 1];
-			n->val[0] = pn->val[index - 1];
-			n->id[0] = lsbn->id[sb_key_num];
-			pn->val[index - 1] = lsbn->val[sb_key_num - 1];			
-			lsbn->val[BRANCH_FACTOR - 1] = sb_key_num - 1;
-
-			modify_cache(tree, node_id, NODE, UNLOCK);
-			modify_cache(tree, pnode_id, NODE, UNLOCK);
-			modify_cache(tree, lsb_id, NODE, UNLOCK);
-
-			return 0;
-		}
-
-		bmerge_left = (lsbn != NULL);
-	}
-	
-	//left maybe exist, but could only merge, check right sibling node
-	if (index < pn->val[BRANCH_FACTOR - 1]) {
-		rsb_id = pn->id[index + 1];
-		rsbn = tree_read(tree, rsb_id);
-		if (rsbn && (rsbn->val[BRANCH_FACTOR - 1] > BRANCH_FACTOR / 2)) {
-			//move key, and child id, from sibling and parent
-			key_num = n->val[BRANCH_FACTOR - 1];
-			n->val[key_num] = pn->val[index];
-			n->id[key_num+1] = rsbn->id[0];
-			pn->val[index] = rsbn->val[0];
-			n->val[BRANCH_FACTOR - 1] = key_num + 1;
-
-			//update sibling keys
-			sb_key_num = rsbn->val[BRANCH_FACTOR - 1];
-			for (i = 0; i < sb_key_num; i++) {
-				rsbn->val[i] = rsbn->val[i + 1];
-				rsbn->id[i] = rsbn->id[i + 1];
-			}
-			rsbn->val[BRANCH_FACTOR - 1] = sb_key_num - 1;
-
-			modify_cache(tree, node_id, NODE, UNLOCK);
-			modify_cache(tree, pnode_id, NODE, UNLOCK);
-			modify_cache(tree, rsb_id, NODE, UNLOCK);
-			if (bmerge_left) {
-				modify_cache(tree, lsb_id, NODE, UNLOCK);
-			}
-
-			return 0;
-		}
 
-		bmerge_right = (rsbn != NULL);
+	/* The bucket chain from the first bucket */
+	if (tree_descend(tree, &probe, &path) < 0) {
+		return DB_INDEX_ERROR;
 	}
-
-	//need to merge node
-	if (bmerge_left || bmerge_right) {
-		//merge to left node
-		key_num = n->val[BRANCH_FACTOR - 1];
-		sb_key_num = bmerge_left ? lsbn->val[BRANCH_FACTOR - 1] : rsbn->val[BRANCH_FACTOR - 1];
-		if (bmerge_left) {
-			lsbn->val[sb_key_num++] = pn->val[index - 1];
-			for (i = 0; i < key_num; i++) {
-				lsbn->val[sb_key_num + i] = n->val[i];
-				lsbn->id[sb_key_num + i] = n->id[i];
-			}
-			lsbn->id[sb_key_num + key_num] = n->id[key_num];
-			lsbn->val[BRANCH_FACTOR - 1] = sb_key_num + key_num;
-		} else {
-			key_num++;
-			for (i = sb_key_num; i >= 0 ; i--) {
-				rsbn->val[key_num + i] = rsbn->val[i];
-				rsbn->id[key_num + i] = rsbn->id[i];
-			}
-			for (i = 0; i < key_num; i++) {
-				rsbn->val[i] = n->val[i];
-				rsbn->id[i] = n->id[i];
-			}
-			rsbn->val[key_num-1] = pn->val[index];
-			rsbn->val[BRANCH_FACTOR - 1] = sb_key_num + key_num;
-		}
-
-		//release current node
-		modify_cache(tree, node_id, NODE, INVALIDATE);
-		tree->off_nodes--;
-
-		//update parent node
-		if (pn->val[BRANCH_FACTOR - 1] == 1) {  //parent node MUST be root
-			tree->root = bmerge_left ? lsb_id : rsb_id;
-			DB_LOG_D("[tree->root]tree root change to %d\n", tree->root);
-			tree->levels--;
-			tree->off_nodes--;
-			modify_cache(tree, pnode_id, NODE, INVALIDATE);
-		} else {
-			if (bmerge_left) {
-				pn->val[index - 1] = pn->val[index];
-			}
-			for (i = index; i < pn->val[BRANCH_FACTOR - 1]; i++) {
-				pn->val[i] = pn->val[i + 1];
-				pn->id[i] = pn->id[i + 1];
-			}
-			pn->val[BRANCH_FACTOR - 1] = pn->val[BRANCH_FACTOR - 1] - 1;
-
-			if ((pnode_id != tree->root) && pn->val[BRANCH_FACTOR - 1] < BRANCH_FACTOR / 2) {
-				tree_rebuild_node(tree, path, level-1);
+	for (id = path.bucket; id != PAGE_NONE; id = next) {
+		page = page_pin(tree, BUCKET, id);
+		if (page == NULL) {
+			return DB_INDEX_ERROR;
+		}
+		for (offset = page->hdr.prefix; offset < page->hdr.used;) {
+			p = page->data + offset;
+			suffix = p[0];
+			tid = get_u32(p + 1 + suffix);
+			if (tid < flush_threshold) {
+				page_remove(page, BUCKET, offset);
+				tree->hdr.entries--;
+				continue;
 			}
+			put_u32(p + 1 + suffix, tid - flush_threshold);
+			offset += entry_size(suffix, BUCKET);
 		}
+		next = page->hdr.link;
+		page_unpin(tree, BUCKET, id, TRUE);
 	}
 
-	if (bmerge_left) {
-		modify_cache(tree, lsb_id, NODE, UNLOCK);
-	}
-	if (bmerge_right) {
-		modify_cache(tree, rsb_id, NODE, UNLOCK);
-	}
-
-	modify_cache(tree, node_id, NODE, UNLOCK);
-	modify_cache(tree, pnode_id, NODE, UNLOCK);
-
-	return 0;
-}
-
-static int bucket_merge_sibling(tree_t *tree, pair_t *path, bucket_t *bucket, int rm_val)
-{
-	int i;
-	int index;
-	int node_id;
-	int sibling_id;
-	int key_num = -1;
-	int merged = 0;
-	int left_bucket_id = -1;
-	bucket_t *left_bucket;
-	bucket_t *right_bucket;
-	tree_node_t *n;
-
-	node_id = path[tree->levels - 1].key;
-	n = tree_read(tree, node_id);
-	index = path[tree->levels - 1].value;
-	//merge left sibling
-	if (index) {
-		//merge bucket
-		sibling_id = n->id[index - 1];
-		if (sibling_id < CONFIG_BUCKETS_LIMIT - 1) {
-			left_bucket = bucket_read(tree, sibling_id);
-			for (i = 0; i < bucket->next_free_slot; i++) {
-				left_bucket->info[1] = min(left_bucket->info[1], bucket->pairs[i].key);
-				left_bucket->info[2] = max(left_bucket->info[2], bucket->pairs[i].key);
-				left_bucket->pairs[left_bucket->next_free_slot].key = bucket->pairs[i].key;
-				left_bucket->pairs[left_bucket->next_free_slot].value = bucket->pairs[i].value;
-				left_bucket->next_free_slot++;
-			}
-			left_bucket->info[0] = bucket->info[0];
-			DB_LOG_D("merge left, set bucket %d next id %d\n", sibling_id, bucket->info[0]);
-			
-			//update bucket list
-			modify_cache(tree, path[tree->levels].key, BUCKET, INVALIDATE);
-			modify_cache(tree, sibling_id, BUCKET, UNLOCK);
-
-			//update parent tree node
-			n->val[index - 1] = n->val[index];
-			key_num = n->val[BRANCH_FACTOR - 1];
-			for (i = index; i < key_num; i++) {
-				n->val[i] = n->val[i + 1];
-				n->id[i] = n->id[i + 1];
-			}
-			n->val[BRANCH_FACTOR - 1] = (--key_num);
-			modify_cache(tree, node_id, NODE, UNLOCK);
-
-			bucket_update_keys(tree, path, sibling_id, rm_val);
-			merged = 1;
+	for (id = 0; id < tree->hdr.off_nodes; id++) {
+		page = page_pin(tree, NODE, id);
+		if (page == NULL) {
+			return DB_INDEX_ERROR;
 		}
-	} else if (index < n->val[BRANCH_FACTOR - 1]) {  //merge right sibling
-		//merge bucket
-		sibling_id = n->id[index + 1];
-		if (sibling_id < CONFIG_BUCKETS_LIMIT - 1) {
-			right_bucket = bucket_read(tree, sibling_id);
-			for (i = 0; i < bucket->next_free_slot; i++) {
-				right_bucket->info[1] = min(right_bucket->info[1], bucket->pairs[i].key);
-				right_bucket->info[2] = max(right_bucket->info[2], bucket->pairs[i].key);
-				right_bucket->pairs[right_bucket->next_free_slot].key = bucket->pairs[i].key;
-				right_bucket->pairs[right_bucket->next_free_slot].value = bucket->pairs[i].value;
-				right_bucket->next_free_slot++;
-			}
-
-			left_bucket_id = bucket_get_prev_id(tree, path);
-			if (left_bucket_id >= 0) {
-				DB_LOG_D("merge right, find left_bucket_id %d !!\n", left_bucket_id);
-				bucket_update_next(tree, left_bucket_id, sibling_id);
-			}
-			//update bucket list
-			modify_cache(tree, path[tree->levels].key, BUCKET, INVALIDATE);
-			modify_cache(tree, sibling_id, BUCKET, UNLOCK);
-
-			//update parent tree node
-			key_num = n->val[BRANCH_FACTOR - 1];
-			for (i = index; i < key_num; i++) {
-				n->val[i] = n->val[i + 1];
-				n->id[i] = n->id[i + 1];
-			}
-			n->val[BRANCH_FACTOR - 1] = (--key_num);
-			modify_cache(tree, node_id, NODE, UNLOCK);
-
-			bucket_update_keys(tree, path, sibling_id, rm_val);
-			merged = 1;
-		}
-	} else {
-		DB_LOG_E("ERROR: should not be here\n");
-		key_num = n->val[BRANCH_FACTOR - 1];
-	}
-
-	if (merged == 0) {
-		modify_cache(tree, node_id, NODE, UNLOCK);
-	}
-
-	//check tree node merge
-	if (key_num > 0 && key_num < BRANCH_FACTOR / 2) {
-		tree_rebuild_node(tree, path, tree->levels - 1);
-	}
-
-	return 0;
-}
-
-static db_result_t delete_item_btree(index_t *index, int value)
-{
-	db_result_t ret = DB_OK;
-	int bucket_id;
-	pair_t *path;
-	tree_t *tree;
-	bucket_t *tmp_bucket;
-	int *rm_value = NULL;
-
-	tree = (tree_t*)index->opaque_data;
-	path = tree_find(tree, value);
-	if (path == NULL) {
-		return DB_INDEX_ERROR;
-	}
-
-	bucket_id = path[tree->levels].key;
-	tmp_bucket = bucket_read(tree, bucket_id);
-	bucket_remove_pair(tmp_bucket, value, &rm_value, 0);
-	free(rm_value);
-	modify_cache(tree, bucket_id, BUCKET, UNLOCK);
-	tree->inserted--;
-
-	if (tmp_bucket->next_free_slot >= BUCKET_SIZE / 2) { //no need re-orgnize
-		bucket_update_keys(tree, path, bucket_id, value);
-	} else { //need to re-orgnize the bucket and tree node
-		if (bucket_request_sibling(tree, path, tmp_bucket) == 0) {
-			bucket_update_keys(tree, path, bucket_id, value);
-			DB_LOG_D("request from sibling bucket successfully\n");
-		} else {
-			if (bucket_merge_sibling(tree, path, tmp_bucket, value) != 0) {
-				ret = DB_INDEX_ERROR;
-			}
+		for (offset = page->hdr.prefix; offset < page->hdr.used; offset += entry_size(suffix, NODE)) {
+			p = page->data + offset;
+			suffix = p[0];
+			tid = get_u32(p + 1 + suffix);
+			put_u32(p + 1 + suffix, tid >= flush_threshold ? tid - flush_threshold : 0);
 		}
+		page_unpin(tree, NODE, id, TRUE);
 	}
 
-	pthread_mutex_lock(&(tree->bucket_lock));
-	if (tree->lock_buckets[bucket_id] == 0) {
-		DB_LOG_E("PANIC EDITED BUCKET WITHOUT LOCK\n");
-		pthread_mutex_unlock(&(tree->bucket_lock));
-		rw_unlock_write(&(tree->tree_lock));
-		ret = DB_INDEX_ERROR;
-	} else {
-		tree->lock_buckets[bucket_id] = 0;
-		pthread_mutex_unlock(&(tree->bucket_lock));
-		rw_unlock_write(&(tree->tree_lock));
-	}
-
-	free(path);
-	return ret;
+	tree->hdr.inserted = tree->hdr.entries;
+	tree->hdr.deleted = 0;
+	tree->version++;
+	storage_remove(old_rel.tuple_filename);
+	DB_LOG_D("Flushed the database.\n");
+	return DB_OK;
 }
+#endif
@@ -59,6 +59,7 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -72,9 +73,10 @@
 * Private Function Prototypes
 ****************************************************************************/
 static db_result_t null_op(index_t *);
-static db_result_t insert(index_t *, attribute_value_t *, tuple_id_t);
-static db_result_t delete(index_t *, attribute_value_t *);
+static db_result_t insert(index_t *, unsigned char *, unsigned, tuple_id_t);
+static db_result_t delete(index_t *, unsigned char *, unsigned, tuple_id_t);
 static tuple_id_t get_next(index_iterator_t *, uint8_t);
+static unsigned long cost(index_t *, unsigned long);
 
 /****************************************************************************
 * Private Types
@@ -103,7 +105,10 @@ index_api_t index_inline = {
 	null_op,
 	insert,
 	delete,
-	get_next
+	get_next,
+	null_op,
+	cost,
+	NULL
 };
 
 /****************************************************************************
@@ -201,16 +206,32 @@ static db_result_t null_op(index_t *index)
 	return DB_OK;
 }
 
-static db_result_t insert(index_t *index, attribute_value_t *value, tuple_id_t tuple_id)
+static db_result_t insert(index_t *index, unsigned char *key, unsigned length, tuple_id_t tuple_id)
 {
 	return DB_OK;
 }
 
-static db_result_t delete(index_t *index, attribute_value_t *value)
+static db_result_t delete(index_t *index, unsigned char *key, unsigned length, tuple_id_t tuple_id)
 {
 	return DB_OK;
 }
 
+/* Each bound of the range is found by a binary search over the rows */
+static unsigned long cost(index_t *index, unsigned long matches)
+{
+	tuple_id_t cardinality;
+	unsigned long probes;
+
+	cardinality = relation_cardinality(index->rel);
+	if (cardinality == INVALID_TUPLE) {
+		return ULONG_MAX;
+	}
+	for (probes = 1; cardinality > 1; cardinality >>= 1) {
+		probes++;
+	}
+	return 2 * probes;
+}
+
 static tuple_id_t get_next(index_iterator_t *iterator, uint8_t inverse_condition)
 {
 	static tuple_id_t cached_start;
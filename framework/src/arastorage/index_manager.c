@@ -56,6 +56,8 @@
  * Included Files
  ****************************************************************************/
 #include <sys/types.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <pthread.h>
@@ -81,6 +83,8 @@ pthread_attr_t g_attr;
  * Private function prototypes
  ****************************************************************************/
 static index_api_t *find_index_api(index_type_t index_type);
+static void index_set_offsets(index_t *index);
+static int index_key_from_values(index_t *index, attribute_value_t *values, int count, bool upper, unsigned char *key, bool *empty);
 db_result_t db_indexing(relation_t*);
 LIST(indices);
 
@@ -125,25 +129,28 @@ db_result_t index_deinit(void)
 	return DB_OK;
 }
 
-db_result_t index_create(index_type_t index_type, relation_t *rel, attribute_t *attr)
+db_result_t index_create(index_type_t index_type, relation_t *rel, attribute_t **attrs, int attr_count)
 {
 	tuple_id_t cardinality;
 	index_t *index;
 	index_api_t *api;
+	unsigned key_length;
+	int i;
+	int j;
 
 	cardinality = relation_cardinality(rel);
 	if (cardinality == INVALID_TUPLE) {
 		return DB_STORAGE_ERROR;
 	}
 
-	if (attr->index != NULL) {
-		/* Refuse to overwrite the old index. */
-		DB_LOG_E("DB: The attribute %s is already indexed\n", attr->name);
+	if (attr_count < 1 || attr_count > DB_INDEX_ATTRIBUTE_LIMIT) {
+		DB_LOG_E("DB: An index key has 1 to %d attributes\n", DB_INDEX_ATTRIBUTE_LIMIT);
 		return DB_INDEX_ERROR;
 	}
 
-	if (attr->domain != DOMAIN_INT && attr->domain != DOMAIN_LONG) {
-		DB_LOG_E("DB: Cannot create an index for a non-number attribute!\n");
+	if (attrs[0]->index != NULL) {
+		/* Refuse to overwrite the old index. */
+		DB_LOG_E("DB: The attribute %s is already indexed\n", attrs[0]->name);
 		return DB_INDEX_ERROR;
 	}
 
@@ -153,6 +160,30 @@ db_result_t index_create(index_type_t index_type, relation_t *rel, attribute_t *
 		return DB_INDEX_ERROR;
 	}
 
+	key_length = 0;
+	for (i = 0; i < attr_count; i++) {
+		for (j = 0; j < i; j++) {
+			if (attrs[j] == attrs[i]) {
+				DB_LOG_E("DB: The attribute %s is twice in the index key\n", attrs[i]->name);
+				return DB_INDEX_ERROR;
+			}
+		}
+		if (attrs[i]->domain == DOMAIN_INT) {
+			key_length += 2;
+		} else if (attrs[i]->domain == DOMAIN_LONG) {
+			key_length += 4;
+		} else if (attrs[i]->domain == DOMAIN_STRING && (api->flags & INDEX_API_COMPOSITE)) {
+			key_length += attrs[i]->element_size;
+		} else {
+			DB_LOG_E("DB: Cannot create this type of index for the attribute %s!\n", attrs[i]->name);
+			return DB_INDEX_ERROR;
+		}
+	}
+	if ((attr_count > 1 && !(api->flags & INDEX_API_COMPOSITE)) || key_length > DB_INDEX_KEY_LENGTH) {
+		DB_LOG_E("DB: The key of %u bytes cannot be indexed\n", key_length);
+		return DB_INDEX_ERROR;
+	}
+
 	index = malloc(sizeof(index_t));
 	if (index == NULL) {
 		DB_LOG_E("DB: Failed to allocate an index\n");
@@ -160,7 +191,10 @@ db_result_t index_create(index_type_t index_type, relation_t *rel, attribute_t *
 	}
 
 	index->rel = rel;
-	index->attr = attr;
+	index->attr = attrs[0];
+	memcpy(index->attrs, attrs, attr_count * sizeof(attribute_t *));
+	index->attr_count = attr_count;
+	index_set_offsets(index);
 	index->api = api;
 	index->state = INDEX_LOAD_NEEDED;
 	index->opaque_data = NULL;
@@ -170,11 +204,11 @@ db_result_t index_create(index_type_t index_type, relation_t *rel, attribute_t *
 	
 	if (DB_ERROR(api->create(index))) {
 		free(index);
-		DB_LOG_E("DB: Index-specific creation failed for attribute %s\n", attr->name);
+		DB_LOG_E("DB: Index-specific creation failed for attribute %s\n", attrs[0]->name);
 		return DB_INDEX_ERROR;
 	}
 
-	attr->index = index;
+	attrs[0]->index = index;
 	list_push(indices, index);
 
 	if (DB_ERROR(storage_put_index(index))) {
@@ -193,7 +227,7 @@ db_result_t index_create(index_type_t index_type, relation_t *rel, attribute_t *
 	} else {
 		/* Inline indexes (i.e., those using the existing storage of the relation)
 		   do not need to be reloaded after restarting the system. */
-		DB_LOG_D("DB: Index created for attribute %s\n", attr->name);
+		DB_LOG_D("DB: Index created for attribute %s\n", attrs[0]->name);
 	}
 
 	index->state = INDEX_READY;
@@ -263,6 +297,8 @@ db_result_t index_load(relation_t *rel, attribute_t *attr)
 
 		index->rel = rel;
 		index->attr = attr;
+		index->attrs[0] = attr;
+		index->attr_count = 1;
 		index->opaque_data = NULL;
 		index->ref_cnt = 1;
 		
@@ -282,6 +318,7 @@ db_result_t index_load(relation_t *rel, attribute_t *attr)
 			free(index);
 			return DB_INDEX_ERROR;
 		}
+		index_set_offsets(index);
 		list_add(indices, index);
 		attr->index = index;
 		index->state = INDEX_READY;
@@ -302,39 +339,108 @@ db_result_t index_release(index_t *index)
 	return DB_OK;
 }
 
-db_result_t index_insert(index_t *index, attribute_value_t *value, tuple_id_t tuple_id)
+db_result_t index_insert(index_t *index, unsigned char *row, tuple_id_t tuple_id)
+{
+	unsigned char key[DB_INDEX_KEY_LENGTH];
+
+	return index->api->insert(index, key, index_key_from_row(index, row, key), tuple_id);
+}
+
+static int index_entry_compare(const void *p1, const void *p2)
 {
-	return index->api->insert(index, value, tuple_id);
+	const index_entry_t *e1 = (const index_entry_t *)p1;
+	const index_entry_t *e2 = (const index_entry_t *)p2;
+	int result;
+
+	result = memcmp(e1->key, e2->key, e1->key_length < e2->key_length ? e1->key_length : e2->key_length);
+	if (result != 0) {
+		return result;
+	}
+	if (e1->key_length != e2->key_length) {
+		return e1->key_length < e2->key_length ? -1 : 1;
+	}
+	return e1->tuple_id < e2->tuple_id ? -1 : (e1->tuple_id > e2->tuple_id);
 }
 
-db_result_t index_delete(index_t *index, attribute_value_t *value)
+/****************************************************************************
+ * Name: index_insert_batch
+ *
+ * Description: Inserts a batch of entries in key order. The entries are
+ *              sorted in place. An index that can bulk load builds itself
+ *              from the sorted entries in one pass when it is empty;
+ *              otherwise the entries are inserted one by one, and
+ *              consecutive keys then hit the same cached bplus-tree bucket.
+ *
+ ****************************************************************************/
+db_result_t index_insert_batch(index_t *index, index_entry_t *entries, int count)
 {
+	db_result_t result;
+	int i;
+
+	qsort(entries, count, sizeof(index_entry_t), index_entry_compare);
+
+	if (index->api->bulk_load != NULL) {
+		result = index->api->bulk_load(index, entries, count);
+		if (result != DB_LIMIT_ERROR) {
+			return result;
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		if (DB_ERROR(index->api->insert(index, entries[i].key, entries[i].key_length, entries[i].tuple_id))) {
+			return DB_INDEX_ERROR;
+		}
+	}
+	return DB_OK;
+}
+
+db_result_t index_flush(index_t *index)
+{
+	if (index->api->flush == NULL) {
+		return DB_OK;
+	}
+	return index->api->flush(index);
+}
+
+db_result_t index_delete(index_t *index, unsigned char *row, tuple_id_t tuple_id)
+{
+	unsigned char key[DB_INDEX_KEY_LENGTH];
+
 	if (index->state != INDEX_READY) {
 		return DB_INDEX_ERROR;
 	}
 
-	return index->api->delete(index, value);
+	return index->api->delete(index, key, index_key_from_row(index, row, key), tuple_id);
 }
 
-db_result_t index_get_iterator(index_iterator_t *iterator, index_t *index, attribute_value_t *min_value, attribute_value_t *max_value)
+/****************************************************************************
+ * Name: index_get_iterator
+ *
+ * Description: Prepares an iteration over the tuples whose first count key
+ *              attributes are in the given ranges. The ranges of all but
+ *              the last of them must hold a single value each.
+ *
+ ****************************************************************************/
+db_result_t index_get_iterator(index_iterator_t *iterator, index_t *index, attribute_value_t *min_values, attribute_value_t *max_values, int count)
 {
 	tuple_id_t cardinality;
 	unsigned long range;
 	unsigned long max_range;
 	long max;
 	long min;
+	bool empty;
 
 	cardinality = relation_cardinality(index->rel);
 	if (cardinality == INVALID_TUPLE) {
 		return DB_STORAGE_ERROR;
 	}
 
-	if (index->state != INDEX_READY) {
+	if (index->state != INDEX_READY || count < 1 || count > index->attr_count) {
 		return DB_INDEX_ERROR;
 	}
 
-	min = db_value_to_long(min_value);
-	max = db_value_to_long(max_value);
+	min = db_value_to_long(&min_values[count - 1]);
+	max = db_value_to_long(&max_values[count - 1]);
 	DB_LOG_D("DB : Index_get_iterator min = %ld, max = %ld\n", min, max);
 	range = (unsigned long)max - min;
 	if (range > 0) {
@@ -363,15 +469,40 @@ db_result_t index_get_iterator(index_iterator_t *iterator, index_t *index, attri
 	}
 
 	iterator->index = index;
-	iterator->min_value = *min_value;
-	iterator->max_value = *max_value;
+	iterator->min_value = min_values[0];
+	iterator->max_value = max_values[0];
 	iterator->next_item_no = 0;
+	iterator->found_items = 0;
+	iterator->key_length = 0;
 
-	DB_LOG_D("DB: Acquired an index iterator for %s.%s over the range (%ld,%ld)\n", index->rel->name, index->attr->name, min_value->u.long_value, max_value->u.long_value);
+	empty = false;
+	if (index->api->flags & INDEX_API_COMPOSITE) {
+		iterator->min_length = index_key_from_values(index, min_values, count, false, iterator->min_key, &empty);
+		iterator->max_length = index_key_from_values(index, max_values, count, true, iterator->max_key, &empty);
+	}
+	iterator->empty = empty;
+
+	DB_LOG_D("DB: Acquired an index iterator for %s.%s over the range (%ld,%ld)\n", index->rel->name, index->attr->name, min, max);
 
 	return DB_OK;
 }
 
+/****************************************************************************
+ * Name: index_cost
+ *
+ * Description: Estimates the storage reads the index needs to find the
+ *              tuples of a range holding the given number of matches. The
+ *              reads of the matching tuples themselves are not included.
+ *
+ ****************************************************************************/
+unsigned long index_cost(index_t *index, unsigned long matches)
+{
+	if (index->state != INDEX_READY || index->api->cost == NULL) {
+		return ULONG_MAX;
+	}
+	return index->api->cost(index, matches);
+}
+
 tuple_id_t index_get_next(index_iterator_t *iterator, uint8_t matched_condition)
 {
 	long min;
@@ -382,7 +513,7 @@ tuple_id_t index_get_next(index_iterator_t *iterator, uint8_t matched_condition)
 		return INVALID_TUPLE;
 	}
 
-	if ((iterator->index->attr->flags & ATTRIBUTE_FLAG_UNIQUE) && iterator->next_item_no == 1) {
+	if ((iterator->index->attr->flags & ATTRIBUTE_FLAG_UNIQUE) && iterator->index->attr_count == 1 && iterator->next_item_no == 1) {
 		min = db_value_to_long(&iterator->min_value);
 		max = db_value_to_long(&iterator->max_value);
 		if (min == max) {
@@ -398,6 +529,110 @@ tuple_id_t index_get_next(index_iterator_t *iterator, uint8_t matched_condition)
 	return iterator->index->api->get_next(iterator, matched_condition);
 }
 
+/****************************************************************************
+ * Name: index_key_from_row
+ *
+ * Description: Encodes the key attributes of a row into a key whose bytes
+ *              compare with memcmp() in the order of the values. An INT is
+ *              kept as stored, a LONG is stored big-endian with its sign bit
+ *              flipped, and a STRING is followed by a NUL byte, so that no
+ *              key is the beginning of another. Returns the key length.
+ *
+ ****************************************************************************/
+int index_key_from_row(index_t *index, unsigned char *row, unsigned char *key)
+{
+	attribute_t *attr;
+	unsigned char *value;
+	int length;
+	int i;
+	int j;
+
+	length = 0;
+	for (i = 0; i < index->attr_count; i++) {
+		attr = index->attrs[i];
+		value = row + index->offsets[i];
+		switch (attr->domain) {
+		case DOMAIN_INT:
+			key[length++] = value[0];
+			key[length++] = value[1];
+			break;
+		case DOMAIN_LONG:
+			key[length++] = value[0] ^ 0x80;
+			key[length++] = value[1];
+			key[length++] = value[2];
+			key[length++] = value[3];
+			break;
+		default:
+			for (j = 0; j < attr->element_size - 1 && value[j] != '\0'; j++) {
+				key[length++] = value[j];
+			}
+			key[length++] = '\0';
+			break;
+		}
+	}
+	return length;
+}
+
+/* Writes the key attributes encoded in a key to their place in a row */
+db_result_t index_key_to_row(index_t *index, unsigned char *key, unsigned length, unsigned char *row)
+{
+	attribute_t *attr;
+	unsigned char *value;
+	unsigned pos;
+	int i;
+	int j;
+
+	pos = 0;
+	for (i = 0; i < index->attr_count; i++) {
+		attr = index->attrs[i];
+		value = row + index->offsets[i];
+		switch (attr->domain) {
+		case DOMAIN_INT:
+			if (pos + 2 > length) {
+				return DB_INDEX_ERROR;
+			}
+			value[0] = key[pos++];
+			value[1] = key[pos++];
+			break;
+		case DOMAIN_LONG:
+			if (pos + 4 > length) {
+				return DB_INDEX_ERROR;
+			}
+			value[0] = key[pos++] ^ 0x80;
+			value[1] = key[pos++];
+			value[2] = key[pos++];
+			value[3] = key[pos++];
+			break;
+		default:
+			memset(value, 0, attr->element_size);
+			for (j = 0; pos < length && key[pos] != '\0'; j++) {
+				if (j == attr->element_size - 1) {
+					return DB_INDEX_ERROR;
+				}
+				value[j] = key[pos++];
+			}
+			if (pos++ == length) {
+				return DB_INDEX_ERROR;
+			}
+			break;
+		}
+	}
+	return DB_OK;
+}
+
+/* Whether an attribute is part of the key of an index */
+int index_has_attribute(index_t *index, attribute_t *attr)
+{
+	int i;
+
+	for (i = 0; i < index->attr_count; i++) {
+		if (index->attrs[i] == attr) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
 /****************************************************************************
 * Private Functions
 ****************************************************************************/
@@ -414,6 +649,76 @@ static index_api_t *find_index_api(index_type_t index_type)
 	return NULL;
 }
 
+static void index_set_offsets(index_t *index)
+{
+	attribute_t *attr;
+	unsigned offset;
+	int i;
+
+	for (i = 0; i < index->attr_count; i++) {
+		offset = 0;
+		for (attr = list_head(index->rel->attributes); attr != NULL && attr != index->attrs[i]; attr = attr->next) {
+			offset += attr->element_size;
+		}
+		index->offsets[i] = offset;
+	}
+}
+
+/****************************************************************************
+ * Name: index_key_from_values
+ *
+ * Description: Encodes a bound of a range over the first count key
+ *              attributes like index_key_from_row() does. A bound outside
+ *              the values an attribute can store is moved to its nearest
+ *              value, or sets *empty if no stored value can be in range.
+ *
+ ****************************************************************************/
+static int index_key_from_values(index_t *index, attribute_value_t *values, int count, bool upper, unsigned char *key, bool *empty)
+{
+	attribute_t *attr;
+	unsigned char *str;
+	long value;
+	uint32_t bits;
+	int length;
+	int i;
+	int j;
+
+	length = 0;
+	for (i = 0; i < count; i++) {
+		attr = index->attrs[i];
+		if (attr->domain == DOMAIN_STRING) {
+			str = values[i].domain == DOMAIN_STRING ? VALUE_STRING(&values[i]) : (unsigned char *)"";
+			for (j = 0; j < attr->element_size - 1 && str[j] != '\0'; j++) {
+				key[length++] = str[j];
+			}
+			key[length++] = '\0';
+			continue;
+		}
+
+		value = db_value_to_long(&values[i]);
+		if (attr->domain == DOMAIN_INT) {
+			/* An INT reads back as an unsigned 16-bit value */
+			if ((upper && value < 0) || (!upper && value > 0xffff)) {
+				*empty = true;
+			}
+			value = value < 0 ? 0 : (value > 0xffff ? 0xffff : value);
+			key[length++] = value >> 8;
+			key[length++] = value & 0xff;
+		} else {
+			if ((upper && value < INT32_MIN) || (!upper && value > INT32_MAX)) {
+				*empty = true;
+			}
+			value = value < INT32_MIN ? INT32_MIN : (value > INT32_MAX ? INT32_MAX : value);
+			bits = (uint32_t)value ^ 0x80000000;
+			key[length++] = bits >> 24;
+			key[length++] = bits >> 16;
+			key[length++] = bits >> 8;
+			key[length++] = bits & 0xff;
+		}
+	}
+	return length;
+}
+
 static index_t *get_next_index_to_load(void)
 {
 	index_t *index;
@@ -433,11 +738,7 @@ db_result_t db_indexing(relation_t *rel)
 	tuple_id_t tuple_id;
 	tuple_id_t cardinality;
 	storage_row_t row;
-	attribute_value_t value;
-	attribute_t *attr;
 	db_result_t result;
-	int offset;
-	bool isfound;
 
 	index = get_next_index_to_load();
 	if (index == NULL) {
@@ -456,25 +757,6 @@ db_result_t db_indexing(relation_t *rel)
 #endif
 	DB_LOG_D("DB: Loading the index for %s.%s...\n", index->rel->name, index->attr->name);
 
-	offset  = 0;
-	isfound = false;
-
-	attr = list_head(rel->attributes);
-	while (attr != NULL) {
-		if (strcmp(attr->name, index->attr->name) == 0) {
-			DB_LOG_D("DB: Found attribute %s in %s\n", index->attr->name, rel->name);
-			isfound = true;
-			break;
-		}
-		offset += attr->element_size;
-		attr = attr->next;
-	}
-
-	if (!isfound) {
-		DB_LOG_E("DB: Failed to find attribute %s in %s\n", index->attr->name, rel->name);
-		goto errout;
-	}
-
 	cardinality = relation_cardinality(rel);
 
 	for (tuple_id = 0; tuple_id < cardinality; tuple_id++) {
@@ -486,13 +768,7 @@ db_result_t db_indexing(relation_t *rel)
 			goto errout;
 		}
 
-		result = db_phy_to_value(&value, index->attr, row + offset);
-		if (DB_ERROR(result)) {
-			DB_LOG_E("DB: Failed to get value from row\n");
-			goto errout;
-		}
-
-		if (DB_ERROR(index_insert(index, &value, tuple_id))) {
+		if (DB_ERROR(index_insert(index, row, tuple_id))) {
 			DB_LOG_E("DB: Failed to get a row in relation %s!\n", rel->name);
 			goto errout;
 		}
@@ -453,6 +453,51 @@ lvm_status_t lvm_set_long(lvm_instance_t *p, long l)
 	return lvm_set_operand(p, &op);
 }
 
+lvm_status_t lvm_set_parameter(lvm_instance_t *p, uint8_t parameter)
+{
+	operand_t op;
+
+	op.type = LVM_PARAMETER;
+	op.value.l = 0;
+	op.value.parameter = parameter;
+
+	return lvm_set_operand(p, &op);
+}
+
+/* Replaces the parameter operands with the given values, so that the code
+   can be derived and executed. */
+lvm_status_t lvm_bind_parameters(lvm_instance_t *p, long *values, int count)
+{
+	operand_t operand;
+	lvm_ip_t ip;
+
+	for (ip = 0; ip < p->end;) {
+		switch (*(node_type_t *)(p->code + ip)) {
+		case LVM_CMP_OP:
+		case LVM_ARITH_OP:
+			ip += sizeof(node_type_t) + sizeof(operator_t);
+			break;
+		case LVM_OPERAND:
+			ip += sizeof(node_type_t);
+			memcpy(&operand, p->code + ip, sizeof(operand));
+			if (operand.type == LVM_PARAMETER) {
+				if (operand.value.parameter >= count) {
+					return INVALID_IDENTIFIER;
+				}
+				operand.type = LVM_LONG;
+				operand.value.l = values[operand.value.parameter];
+				memcpy(p->code + ip, &operand, sizeof(operand));
+			}
+			ip += sizeof(operand);
+			break;
+		default:
+			return SEMANTIC_ERROR;
+		}
+	}
+
+	return LVM_TRUE;
+}
+
 lvm_status_t lvm_register_variable(lvm_instance_t *p, char *name, operand_type_t type)
 {
 	variable_id_t id;
@@ -756,6 +801,9 @@ static lvm_ip_t print_operand(lvm_instance_t *p, lvm_ip_t index)
 	case LVM_LONG:
 		DB_LOG_D("long:%ld ", operand.value.l);
 		break;
+	case LVM_PARAMETER:
+		DB_LOG_D("param:%d ", operand.value.parameter + 1);
+		break;
 	default:
 		DB_LOG_D("?? ");
 		break;
@@ -118,7 +118,8 @@ typedef enum lvm_operator_e operator_t;
 enum operand_type_e {
 	LVM_VARIABLE,
 	LVM_FLOAT,
-	LVM_LONG
+	LVM_LONG,
+	LVM_PARAMETER				/* Placeholder for a long bound before execution */
 };
 typedef enum operand_type_e operand_type_t;
 
@@ -129,6 +130,7 @@ union operand_value_u {
 	float f;
 #endif
 	variable_id_t id;
+	uint8_t parameter;
 };
 typedef union operand_value_u operand_value_t;
 
@@ -182,6 +184,8 @@ lvm_status_t lvm_set_relation(lvm_instance_t *p, operator_t op);
 lvm_status_t lvm_set_operand(lvm_instance_t *p, operand_t *op);
 lvm_status_t lvm_set_operand_value(lvm_instance_t *p, attribute_t *attr, unsigned char *value);
 lvm_status_t lvm_set_long(lvm_instance_t *p, long l);
+lvm_status_t lvm_set_parameter(lvm_instance_t *p, uint8_t parameter);
+lvm_status_t lvm_bind_parameters(lvm_instance_t *p, long *values, int count);
 lvm_status_t lvm_set_variable(lvm_instance_t *p, char *name);
 lvm_status_t lvm_set_variable_value(lvm_instance_t *p, char *name, operand_value_t value);
 #endif							/* LVM_H */
@@ -85,6 +85,7 @@ static void purge_relations(void);
 static void relation_clear(relation_t *);
 static relation_t *relation_allocate(void);
 static void relation_free(relation_t *);
+static relation_t *relation_create_result(void);
 
 /****************************************************************************
 * Public Functions
@@ -183,6 +184,25 @@ static relation_t *relation_allocate(void)
 	return rel;
 }
 
+static relation_t *relation_create_result(void)
+{
+	relation_t *rel;
+
+	/* A result relation is private to a query handle. It is not registered
+	   in the relation list and freed with the last release. */
+	rel = relation_allocate();
+	if (rel == NULL) {
+		return NULL;
+	}
+
+	rel->cardinality = 0;
+	strncpy(rel->name, RESULT_RELATION, sizeof(rel->name) - 1);
+	rel->dir = DB_MEMORY;
+	rel->references = 1;
+
+	return rel;
+}
+
 static void relation_free(relation_t *rel)
 {
 	attribute_t *attr;
@@ -249,6 +269,12 @@ relation_t *relation_load(char *name)
 	list_add(relations, rel);
 
 end:
+	/* A cursor may still read the relation, so reopen its tuple file
+	   instead of leaking the one in use. */
+	if (rel->dir == DB_STORAGE && RELATION_HAS_TUPLES(rel)) {
+		storage_unload(rel);
+	}
+
 	if (rel->dir == DB_STORAGE && DB_ERROR(storage_load(rel))) {
 		relation_release(rel);
 		return NULL;
@@ -268,6 +294,10 @@ db_result_t relation_release(relation_t *rel)
 	}
 
 	if (rel->references == 0) {
+		if (rel->dir == DB_MEMORY) {
+			relation_free(rel);
+			return DB_OK;
+		}
 		res = storage_unload(rel);
 		if (DB_ERROR(res)) {
 			return res;
@@ -508,10 +538,16 @@ db_result_t relation_remove(relation_t *rel, int remove_tuples)
 	return result;
 }
 
-db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
+/****************************************************************************
+ * Name: relation_format_row
+ *
+ * Description: Converts the values of a tuple to the physical row format of
+ *              the relation. record must hold rel->row_length bytes.
+ *
+ ****************************************************************************/
+db_result_t relation_format_row(relation_t *rel, attribute_value_t *values, unsigned char *record)
 {
 	attribute_t *attr;
-	unsigned char record[rel->row_length];
 	unsigned char *ptr;
 	attribute_value_t *value;
 	db_result_t result;
@@ -523,8 +559,7 @@ db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 
 	DB_LOG_V("DB: Insert (");
 
-	attr = list_head(rel->attributes);
-	while (attr != NULL) {
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, value++) {
 		/* Verify that the value is in the expected domain. An exception
 		   to this rule is that INT may be promoted to LONG. */
 		if (attr->domain != value->domain && !(attr->domain == DOMAIN_LONG && value->domain == DOMAIN_INT)) {
@@ -563,21 +598,40 @@ db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 			DB_LOG_V(", ");
 		}
 #endif              /* DEBUG */
+		ptr += attr->element_size;
+	}
+
+	DB_LOG_V(")\n");
+
+	return DB_OK;
+}
+
+db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
+{
+	attribute_t *attr;
+	unsigned char record[rel->row_length];
+	db_result_t result;
+
+	result = relation_format_row(rel, values, record);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	/* An index is referred to by its first key attribute and takes its key from the row */
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next) {
+		if (attr->flags & ATTRIBUTE_FLAG_INVALID) {
+			continue;
+		}
 		if (attr->index == NULL) {
 			index_load(rel, attr);
 		}
-		ptr += attr->element_size;
 		if (attr->index != NULL) {
-			if (DB_ERROR(index_insert(attr->index, value, rel->next_row))) {
+			if (DB_ERROR(index_insert(attr->index, record, rel->next_row))) {
 				return DB_INDEX_ERROR;
 			}
 		}
-		attr = attr->next;
-		value++;
 	}
 
-	DB_LOG_V(")\n");
-
 	return storage_put_row(rel, record, FALSE);
 }
 
@@ -678,31 +732,111 @@ static db_result_t generate_attribute_map(source_dest_map_t *attr_map, unsigned
 	return DB_OK;
 }
 
+/* The index answers the query alone if every attribute read is part of the key */
+static uint8_t select_index_covers(db_handle_t *handle, index_t *index)
+{
+	source_dest_map_t *attr_map_ptr;
+	source_dest_map_t *attr_map_end;
+
+	if (AQL_GET_EXEC_TYPE(handle->optype) != AQL_TYPE_SELECT || !(index->api->flags & INDEX_API_COVERING)) {
+		return FALSE;
+	}
+
+	attr_map_end = handle->attr_map + handle->result_rel->attribute_count;
+	for (attr_map_ptr = handle->attr_map; attr_map_ptr < attr_map_end; attr_map_ptr++) {
+		if (!index_has_attribute(index, attr_map_ptr->from_attr)) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/****************************************************************************
+ * Name: select_index_range
+ *
+ * Description: Finds the ranges of the leading key attributes of an index
+ *              which the condition of a query limits: each attribute but
+ *              the last has a single value. Returns how many there are.
+ *
+ ****************************************************************************/
+static int select_index_range(db_handle_t *handle, index_t *index, attribute_value_t *mins, attribute_value_t *maxs, unsigned long *range)
+{
+	operand_value_t min;
+	operand_value_t max;
+	attribute_t *attr;
+	int count;
+
+	*range = 0;
+	for (count = 0; count < index->attr_count; count++) {
+		attr = index->attrs[count];
+		if ((attr->domain != DOMAIN_INT && attr->domain != DOMAIN_LONG) || LVM_ERROR(lvm_get_derived_range(handle->lvm_instance, attr->name, &min, &max))) {
+			break;
+		}
+		mins[count].domain = maxs[count].domain = DOMAIN_LONG;
+		VALUE_LONG(&mins[count]) = min.l;
+		VALUE_LONG(&maxs[count]) = max.l;
+		*range = (unsigned long)max.l - (unsigned long)min.l;
+		if (*range != 0) {
+			count++;
+			break;
+		}
+	}
+	return count;
+}
+
 static void select_index(db_handle_t **handle)
 {
 	index_t *index;
+	index_t *candidate;
 	attribute_t *attr;
-	operand_value_t min;
-	operand_value_t max;
-	attribute_value_t av_min;
-	attribute_value_t av_max;
-	long range;
-	unsigned long min_range;
+	attribute_value_t mins[DB_INDEX_ATTRIBUTE_LIMIT];
+	attribute_value_t maxs[DB_INDEX_ATTRIBUTE_LIMIT];
+	attribute_value_t av_min[DB_INDEX_ATTRIBUTE_LIMIT];
+	attribute_value_t av_max[DB_INDEX_ATTRIBUTE_LIMIT];
+	tuple_id_t cardinality;
+	unsigned long range;
+	unsigned long matches;
+	unsigned long cost;
+	unsigned long min_cost;
+	uint8_t covering;
+	uint8_t index_only;
+	int av_count;
+	int count;
 	index = NULL;
-	min_range = ULONG_MAX;
+	index_only = FALSE;
+	av_count = 0;
 
-	/* Find all indexed and derived attributes, and select the index of
-	   the attribute with the smallest range. */
+	/* A scan reads every tuple once. */
+	cardinality = relation_cardinality((*handle)->rel);
+	if (cardinality == INVALID_TUPLE) {
+		(*handle)->flags = DB_HANDLE_FLAG_INVALID;
+		return;
+	}
+	min_cost = cardinality;
+
+	/* Find all indexes whose leading key attributes are derived, and select
+	   the one which reads the fewest tuples and index entries, assuming
+	   distinct keys. An index over the attributes a query reads does not
+	   read the tuples. */
 	attr = list_head((*handle)->rel->attributes);
 	while (attr != NULL) {
-		if (attr->index != NULL && !LVM_ERROR(lvm_get_derived_range((*handle)->lvm_instance, attr->name, &min, &max))) {
-			range = (unsigned long)max.l - (unsigned long)min.l;
-			DB_LOG_D("DB: The search range for attribute \"%s\" comprises %ld values\n", attr->name, range + 1);
-			if (range <= min_range) {
-				index = attr->index;
-				av_min.domain = av_max.domain = DOMAIN_INT;
-				VALUE_LONG(&av_min) = min.l;
-				VALUE_LONG(&av_max) = max.l;
+		candidate = attr->index;
+		count = candidate != NULL ? select_index_range(*handle, candidate, mins, maxs, &range) : 0;
+		if (count > 0) {
+			matches = range < cardinality ? range + 1 : cardinality;
+			covering = select_index_covers(*handle, candidate);
+			cost = index_cost(candidate, matches);
+			if (!covering && cost != ULONG_MAX) {
+				cost += matches;
+			}
+			DB_LOG_D("DB: The search range of %d key attributes from \"%s\" comprises %lu values, cost %lu\n", count, attr->name, range + 1, cost);
+			if (cost < min_cost) {
+				min_cost = cost;
+				index = candidate;
+				index_only = covering;
+				av_count = count;
+				memcpy(av_min, mins, count * sizeof(mins[0]));
+				memcpy(av_max, maxs, count * sizeof(maxs[0]));
 			}
 		}
 		attr = attr->next;
@@ -710,14 +844,26 @@ static void select_index(db_handle_t **handle)
 
 	if (index != NULL) {
 		/* We found a suitable index; get an iterator for it. */
-		if (index_get_iterator(&((*handle)->index_iterator), index, &av_min, &av_max) == DB_OK) {
+		if (index_get_iterator(&((*handle)->index_iterator), index, av_min, av_max, av_count) == DB_OK) {
 			(*handle)->flags |= DB_HANDLE_FLAG_SEARCH_INDEX;
+			if (index_only) {
+				(*handle)->flags |= DB_HANDLE_FLAG_INDEX_ONLY;
+			}
 		}
 	} else {
 		(*handle)->flags = DB_HANDLE_FLAG_INVALID;
 	}
 }
 
+/* Builds the row of an index-only scan from the key the index returned */
+static db_result_t relation_get_index_row(db_handle_t *handle, storage_row_t row)
+{
+	index_iterator_t *iterator;
+
+	iterator = &handle->index_iterator;
+	return index_key_to_row(iterator->index, iterator->key, iterator->key_length, row);
+}
+
 static void relation_index_clear(relation_t *rel)
 {
 	char *filename;
@@ -744,18 +890,15 @@ static void relation_index_clear(relation_t *rel)
 static void relation_delete_index_item(db_handle_t **handle, unsigned char *row_ptr, int update_index)
 {
 	attribute_t *from_attr;
-	attribute_value_t index_key;
 	tuple_id_t tuple_id;
 
 	from_attr = list_head((*handle)->rel->attributes);
 	while (from_attr != NULL) {
 		if (from_attr->index != NULL) {
-			if (relation_get_value((*handle)->rel, from_attr, row_ptr, &index_key) == DB_OK) {
-				index_delete(from_attr->index, &index_key);
-				if (update_index) { //update with new tuple_id
-					tuple_id = (*handle)->result_rel->cardinality - 1; //cardinality increased when storage_put_row
-					index_insert(from_attr->index, &index_key, tuple_id);
-				}
+			index_delete(from_attr->index, row_ptr, (*handle)->tuple_id);
+			if (update_index) { //update with new tuple_id
+				tuple_id = (*handle)->result_rel->cardinality - 1; //cardinality increased when storage_put_row
+				index_insert(from_attr->index, row_ptr, tuple_id);
 			}
 		}
 		from_attr = from_attr->next;
@@ -796,8 +939,9 @@ static db_result_t generate_selection_result(db_handle_t **handle, relation_t *r
 	}
 
 	if ((*handle)->lvm_instance != NULL) {
-		/* Try to establish acceptable ranges for the attribute values. */
-		if (!LVM_ERROR(lvm_derive((*handle)->lvm_instance))) {
+		/* Try to establish acceptable ranges for the attribute values.
+		   A prepared query derives them once when its values are bound. */
+		if (((*handle)->adt_flags & AQL_FLAG_DERIVED) || !LVM_ERROR(lvm_derive((*handle)->lvm_instance))) {
 			select_index(handle);
 		}
 	}
@@ -882,6 +1026,18 @@ db_result_t relation_process_select(db_handle_t **handle, db_cursor_t *cursor)
 		(*handle)->tuple_id++;
 	}
 
+	/* Tuples inserted while the cursor is being read are not in the result. */
+	if ((*handle)->tuple_id >= cursor->total_rows) {
+		if ((*handle)->flags & DB_HANDLE_FLAG_SEARCH_INDEX) {
+			return DB_OK;
+		}
+		if ((*handle)->adt_flags & AQL_FLAG_AGGREGATE) {
+			result = DB_FINISHED;
+			goto processing_aggregation;
+		}
+		return DB_FINISHED;
+	}
+
 	row = (storage_row_t)malloc(sizeof(char) * (*handle)->rel->row_length + 1);
 	if (row == NULL) {
 		DB_LOG_E("DB: Failed to allocate row\n");
@@ -890,7 +1046,11 @@ db_result_t relation_process_select(db_handle_t **handle, db_cursor_t *cursor)
 
 	/* Put the tuples fulfilling the- given condition into a new relation.
 	   The tuples may be projected. */
-	result = storage_get_row((*handle)->rel, &((*handle)->tuple_id), row);
+	if ((*handle)->flags & DB_HANDLE_FLAG_INDEX_ONLY) {
+		result = relation_get_index_row(*handle, row);
+	} else {
+		result = storage_get_row((*handle)->rel, &((*handle)->tuple_id), row);
+	}
 	if (DB_ERROR(result)) {
 		DB_LOG_E("DB: Failed to get a row in relation %s!\n", (*handle)->rel->name);
 		goto errout;
@@ -944,6 +1104,9 @@ db_result_t relation_process_select(db_handle_t **handle, db_cursor_t *cursor)
 			}
 		} else {
 			result = cursor_data_add(cursor, (*handle)->tuple_id);
+			if (DB_SUCCESS(result) && ((*handle)->flags & DB_HANDLE_FLAG_INDEX_ONLY)) {
+				result = cursor_index_row_add(cursor, (*handle)->tuple_id, row);
+			}
 			if (DB_ERROR(result)) {
 				goto errout;
 			}
@@ -1139,6 +1302,11 @@ db_cursor_t *relation_process_result(db_handle_t *handler)
 			cursor_deinit(cursor);
 			return NULL;
 		}
+
+		/* Tuples are not processed all at once. The cursor keeps the handle
+		   and reads the next tuples from the relation when they are requested. */
+		cursor->handle = handler;
+		return cursor;
 	}
 
 	res = DB_ARGUMENT_ERROR;
@@ -1186,16 +1354,18 @@ db_result_t relation_select(db_handle_t **handle, relation_t *rel, void *adt_ptr
 	if (AQL_GET_FLAGS(adt) & AQL_FLAG_ASSIGN) {
 		name = adt->relations[0];
 		dir = DB_STORAGE;
+
+		res_rel = relation_load(name);
+		relation_remove(res_rel, 1);
+		relation_create(name, dir);
+		(*handle)->result_rel = relation_load(name);
 	} else {
-		name = RESULT_RELATION;
+		/* Result tuples are read from the relation through the cursor, so
+		   the result relation only describes them and is never stored. */
 		dir = DB_MEMORY;
+		(*handle)->result_rel = relation_create_result();
 	}
 
-	res_rel = relation_load(name);
-	relation_remove(res_rel, 1);
-	relation_create(name, dir);
-	(*handle)->result_rel = relation_load(name);
-
 	if ((*handle)->result_rel == NULL) {
 		DB_LOG_E("DB: Failed to load a relation for the query result\n");
 		return DB_ALLOCATION_ERROR;
@@ -1206,7 +1376,6 @@ db_result_t relation_select(db_handle_t **handle, relation_t *rel, void *adt_ptr
 		while (attr_ptr != NULL) {
 			if (attr_ptr->flags & ATTRIBUTE_FLAG_INVALID) {
 				DB_LOG_E("DB: Failed to add a result attribute\n");
-				relation_release((*handle)->result_rel);
 				return DB_ALLOCATION_ERROR;
 			} else {
 				index_load(rel, attr_ptr);
@@ -1215,7 +1384,6 @@ db_result_t relation_select(db_handle_t **handle, relation_t *rel, void *adt_ptr
 			attr = relation_attribute_add((*handle)->result_rel, dir, attr_ptr->name, attr_ptr->domain, attr_ptr->element_size);
 			if (attr == NULL) {
 				DB_LOG_E("DB: Failed to add a result attribute\n");
-				relation_release((*handle)->result_rel);
 				return DB_ALLOCATION_ERROR;
 			}
 			attr_ptr = attr_ptr->next;
@@ -1238,7 +1406,6 @@ db_result_t relation_select(db_handle_t **handle, relation_t *rel, void *adt_ptr
 
 			if (attr == NULL) {
 				DB_LOG_E("DB: Failed to add a result attribute\n");
-				relation_release((*handle)->result_rel);
 				return DB_ALLOCATION_ERROR;
 			}
 			attr->aggregator = adt->aggregators[i];
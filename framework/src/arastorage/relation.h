@@ -97,7 +97,7 @@
 #define IS_INVALID_CURSOR_ROW(a) ((a) == NULL || ((a)->current_cursor_row >= (a)->cursor_rows))
 
 /* check current storage row is valid or invalid*/
-#define IS_INVALID_STORAGE_ROW(a) ((a) == NULL || ((a)->current_storage_row >= (a)->total_rows) || (a)->current_storage_row >= DB_CURSOR_RESULT_ENTRY)
+#define IS_INVALID_STORAGE_ROW(a) ((a) == NULL || ((a)->current_storage_row >= (a)->total_rows))
 
 #define RELATION_HAS_TUPLES(rel) ((rel)->tuple_storage >= 0)
 
@@ -159,6 +159,11 @@ struct _db_cursor_s {
 	attribute_id_t attribute_count;
 	size_t storage_row_length;
 	uint32_t *row_arr;
+	db_handle_t *handle;		/* Query producing the remaining rows, NULL when all rows are known */
+	tuple_id_t buffered_row;	/* Storage row which is read into row_buf */
+	unsigned char *row_buf;
+	unsigned char *index_rows;	/* Columns of each storage row of an index-only scan, NULL otherwise */
+	size_t index_row_length;
 	unsigned char tuple[DB_MAX_ELEMENT_SIZE + 1];
 	char name[TUPLE_NAME_LENGTH + 1];
 	char rel_name[RELATION_NAME_LENGTH + 1];
@@ -172,6 +177,8 @@ struct _db_cursor_s {
 db_result_t cursor_init(db_cursor_t **cursor, relation_t *rel);
 db_result_t cursor_load(db_cursor_t **target, db_cursor_t *src);
 db_result_t cursor_data_add(db_cursor_t *cursor, tuple_id_t tuple_id);
+db_result_t cursor_index_row_add(db_cursor_t *cursor, tuple_id_t tuple_id, unsigned char *row);
+db_result_t cursor_fetch(db_cursor_t *cursor, tuple_id_t row_id);
 db_result_t cursor_deinit(db_cursor_t *cursor);
 
 
@@ -180,6 +187,7 @@ db_result_t relation_init(void);
 db_result_t relation_deinit(void);
 db_result_t relation_process_remove(db_handle_t **, db_cursor_t *);
 db_result_t relation_process_select(db_handle_t **, db_cursor_t *);
+db_result_t relation_process(db_handle_t **, db_cursor_t *);
 db_cursor_t *relation_process_result(db_handle_t *);
 relation_t *relation_load(char *);
 db_result_t relation_release(relation_t *);
@@ -191,6 +199,7 @@ db_result_t relation_get_value(relation_t *, attribute_t *, unsigned char *, att
 db_result_t relation_attribute_remove(relation_t *, char *);
 db_result_t relation_set_primary_key(relation_t *, char *);
 db_result_t relation_remove(relation_t *, int);
+db_result_t relation_format_row(relation_t *, attribute_value_t *, unsigned char *);
 db_result_t relation_insert(relation_t *, attribute_value_t *);
 db_result_t relation_select(db_handle_t **, relation_t *, void *);
 tuple_id_t relation_cardinality(relation_t *);
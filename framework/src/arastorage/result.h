@@ -71,6 +71,7 @@
 #define DB_HANDLE_FLAG_INDEX_STEP       0x01
 #define DB_HANDLE_FLAG_SEARCH_INDEX     0x02
 #define DB_HANDLE_FLAG_PROCESSING       0x04
+#define DB_HANDLE_FLAG_INDEX_ONLY       0x08
 #define DB_HANDLE_FLAG_INVALID          0x00
 
 /****************************************************************************
@@ -112,6 +112,7 @@ void storage_write_buffer_clean(void);
 db_storage_id_t storage_open(const char *, int);
 db_storage_id_t storage_close(db_storage_id_t);
 db_result_t storage_remove(const char *);
+db_result_t storage_truncate(const char *, off_t);
 db_result_t storage_rename(const char *, const char *);
 off_t storage_seek(db_storage_id_t, unsigned long, int);
 ssize_t storage_read(db_storage_id_t, void *, unsigned);
@@ -27,6 +27,7 @@
 #include <sys/stat.h>
 #endif
 #include "db_debug.h"
+#include "buffer_pool.h"
 #include "storage.h"
 
 /****************************************************************************
@@ -56,9 +57,28 @@ db_storage_id_t storage_open(const char *filename, int oflag)
 /* It mapped with close function in specific file system */
 db_storage_id_t storage_close(db_storage_id_t fd)
 {
+	/* The descriptor may be reused for another file once it is closed */
+	buffer_pool_drop(fd);
 	return close(fd);
 }
 
+/* It mapped with ftruncate function in specific file system */
+db_result_t storage_truncate(const char *filename, off_t length)
+{
+	db_storage_id_t fd;
+	int res = DB_STORAGE_ERROR;
+
+	fd = storage_open(filename, O_WRONLY);
+	if (fd < 0) {
+		return DB_STORAGE_ERROR;
+	}
+	if (ftruncate(fd, length) == OK) {
+		res = DB_OK;
+	}
+	storage_close(fd);
+	return res;
+}
+
 /* It mapped with unlink function in specific file system */
 db_result_t storage_remove(const char *filename)
 {
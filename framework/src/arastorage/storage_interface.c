@@ -66,6 +66,7 @@
 #include "db_options.h"
 #include "db_debug.h"
 #include "random.h"
+#include "buffer_pool.h"
 #include "storage.h"
 
 /****************************************************************************
@@ -500,6 +501,7 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 {
 	ssize_t r;
 	tuple_id_t nrows;
+	void *cached;
 
 	if (DB_ERROR(storage_get_row_amount(rel, &nrows))) {
 		return DB_STORAGE_ERROR;
@@ -510,6 +512,15 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 		return DB_FINISHED;
 	}
 
+	/* Stored rows are never rewritten in place, so a cached row stays valid
+	   until the tuple file is closed. */
+	cached = buffer_pool_pin(rel->tuple_storage, (unsigned long)*tuple_id * rel->row_length, rel->row_length);
+	if (cached != NULL) {
+		memcpy(row, cached, rel->row_length);
+		buffer_pool_unpin(rel->tuple_storage, (unsigned long)*tuple_id * rel->row_length);
+		return DB_OK;
+	}
+
 	if (storage_seek(rel->tuple_storage, *tuple_id * rel->row_length, SEEK_SET) == (off_t)-1) {
 		return DB_STORAGE_ERROR;
 	}
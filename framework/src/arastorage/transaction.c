@@ -0,0 +1,656 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * framework/src/arastorage/transaction.c
+ *
+ *   INSERT statements between BEGIN and COMMIT form a transaction.  Their
+ *   rows are only written to a redo log.  COMMIT marks the log committed,
+ *   then appends the rows to the tuple files and inserts their keys into
+ *   the indexes in sorted batches, and finally removes the log.  If the
+ *   system stops after the commit mark, db_init() replays the log: the
+ *   tuple files are cut back to their size at commit time, the rows are
+ *   appended again and the external indexes are rebuilt.  A log without
+ *   the commit mark is discarded.
+ *
+ *   Log layout: a header followed by records.  A RELATION record names a
+ *   relation and the number of rows it had at commit time; the ROW records
+ *   that follow refer to it by its slot number.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+
+#include "db_options.h"
+#include "db_debug.h"
+#include "index.h"
+#include "result.h"
+#include "storage.h"
+#include "transaction.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define TRANSACTION_LOG_MAGIC 0x4e585441	/* "ATXN" */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+enum transaction_log_state_e {
+	TRANSACTION_LOG_PENDING = 0,
+	TRANSACTION_LOG_COMMITTED = 1
+};
+
+enum transaction_record_type_e {
+	TRANSACTION_RECORD_RELATION = 1,
+	TRANSACTION_RECORD_ROW = 2
+};
+
+struct transaction_log_header_s {
+	uint32_t magic;
+	uint32_t state;
+};
+
+struct transaction_record_s {
+	uint8_t type;				/* TRANSACTION_RECORD_* */
+	uint8_t slot;				/* Relation slot the record refers to */
+	uint16_t length;			/* Length of the data following the record */
+};
+
+struct transaction_relation_s {
+	char name[RELATION_NAME_LENGTH + 1];
+	tuple_id_t base_rows;		/* Rows of the relation at commit time */
+};
+
+struct transaction_slot_s {
+	relation_t *rel;
+	unsigned long offset;		/* Offset of the transaction_relation_s in the log */
+	tuple_id_t base_rows;
+};
+
+struct transaction_s {
+	bool active;
+	db_storage_id_t log;
+	unsigned long log_size;
+	int slot_count;
+	struct transaction_slot_s slots[DB_TRANSACTION_RELATION_LIMIT];
+};
+
+/****************************************************************************
+ * Private variables
+ ****************************************************************************/
+static struct transaction_s g_transaction = { false, INVALID_STORAGE_ID };
+
+/* A committed log is on flash which could not be applied yet */
+static bool g_replay_pending;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void transaction_release_slots(struct transaction_slot_s *slots)
+{
+	int i;
+
+	for (i = 0; i < DB_TRANSACTION_RELATION_LIMIT; i++) {
+		if (slots[i].rel != NULL) {
+			relation_release(slots[i].rel);
+			slots[i].rel = NULL;
+		}
+	}
+}
+
+static void transaction_end(void)
+{
+	if (g_transaction.log >= 0) {
+		storage_close(g_transaction.log);
+	}
+	transaction_release_slots(g_transaction.slots);
+	memset(&g_transaction, 0, sizeof(g_transaction));
+	g_transaction.log = INVALID_STORAGE_ID;
+}
+
+/****************************************************************************
+ * Name: transaction_add_relation
+ *
+ * Description: Returns the slot of rel in the ongoing transaction, logging
+ *              a RELATION record the first time rel is inserted into.
+ *
+ ****************************************************************************/
+static db_result_t transaction_add_relation(relation_t *rel, int *slot_id)
+{
+	struct transaction_record_s record;
+	struct transaction_relation_s relation;
+	struct transaction_slot_s *slot;
+	int i;
+
+	for (i = 0; i < g_transaction.slot_count; i++) {
+		if (strcmp(g_transaction.slots[i].rel->name, rel->name) == 0) {
+			*slot_id = i;
+			return DB_OK;
+		}
+	}
+
+	if (g_transaction.slot_count >= DB_TRANSACTION_RELATION_LIMIT) {
+		DB_LOG_E("DB: A transaction can insert into %d relations at most\n", DB_TRANSACTION_RELATION_LIMIT);
+		return DB_LIMIT_ERROR;
+	}
+
+	slot = &g_transaction.slots[g_transaction.slot_count];
+	slot->rel = relation_load(rel->name);
+	if (slot->rel == NULL) {
+		return DB_RELATIONAL_ERROR;
+	}
+
+	memset(&relation, 0, sizeof(relation));
+	strncpy(relation.name, rel->name, sizeof(relation.name) - 1);
+	relation.base_rows = INVALID_TUPLE;
+	record.type = TRANSACTION_RECORD_RELATION;
+	record.slot = g_transaction.slot_count;
+	record.length = sizeof(relation);
+
+	slot->offset = g_transaction.log_size + sizeof(record);
+	if (DB_ERROR(storage_write_to(g_transaction.log, &record, g_transaction.log_size, sizeof(record))) || DB_ERROR(storage_write_to(g_transaction.log, &relation, slot->offset, sizeof(relation)))) {
+		DB_LOG_E("DB: Failed to write the transaction log\n");
+		relation_release(slot->rel);
+		slot->rel = NULL;
+		return DB_STORAGE_ERROR;
+	}
+	g_transaction.log_size = slot->offset + sizeof(relation);
+
+	*slot_id = g_transaction.slot_count++;
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: transaction_restore_relation
+ *
+ * Description: Loads a relation of a log being replayed and cuts its tuple
+ *              file back to its size at commit time, dropping the rows a
+ *              previous attempt may have appended.
+ *
+ ****************************************************************************/
+static db_result_t transaction_restore_relation(struct transaction_slot_s *slot, struct transaction_relation_s *relation)
+{
+	relation->name[sizeof(relation->name) - 1] = '\0';
+	slot->rel = relation_load(relation->name);
+	if (slot->rel == NULL) {
+		DB_LOG_E("DB: Failed to load relation %s of the transaction log\n", relation->name);
+		return DB_RELATIONAL_ERROR;
+	}
+
+	storage_unload(slot->rel);
+	if (DB_ERROR(storage_truncate(slot->rel->tuple_filename, (off_t)relation->base_rows * slot->rel->row_length))) {
+		DB_LOG_E("DB: Failed to truncate the tuple file of %s\n", relation->name);
+		return DB_STORAGE_ERROR;
+	}
+	if (DB_ERROR(storage_load(slot->rel))) {
+		return DB_STORAGE_ERROR;
+	}
+	slot->rel->cardinality = INVALID_TUPLE;
+	if (relation_cardinality(slot->rel) != relation->base_rows) {
+		return DB_INCONSISTENCY_ERROR;
+	}
+
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: transaction_apply_rows
+ *
+ * Description: Appends the rows of the log to the tuple files.
+ *
+ ****************************************************************************/
+static db_result_t transaction_apply_rows(db_storage_id_t log, unsigned long size, struct transaction_slot_s *slots, bool recovery)
+{
+	struct transaction_record_s record;
+	struct transaction_relation_s relation;
+	struct transaction_slot_s *slot;
+	unsigned char *row = NULL;
+	unsigned row_size = 0;
+	unsigned long offset;
+	db_result_t result = DB_OK;
+
+	for (offset = sizeof(struct transaction_log_header_s); offset < size; offset += record.length) {
+		if (DB_ERROR(storage_read_from(log, &record, offset, sizeof(record)))) {
+			result = DB_STORAGE_ERROR;
+			break;
+		}
+		offset += sizeof(record);
+		if (record.slot >= DB_TRANSACTION_RELATION_LIMIT) {
+			result = DB_INCONSISTENCY_ERROR;
+			break;
+		}
+		slot = &slots[record.slot];
+
+		if (record.type == TRANSACTION_RECORD_RELATION) {
+			if (record.length != sizeof(relation) || DB_ERROR(storage_read_from(log, &relation, offset, sizeof(relation)))) {
+				result = DB_INCONSISTENCY_ERROR;
+				break;
+			}
+			if (recovery) {
+				result = transaction_restore_relation(slot, &relation);
+				if (DB_ERROR(result)) {
+					break;
+				}
+			}
+			slot->base_rows = relation.base_rows;
+		} else if (record.type == TRANSACTION_RECORD_ROW) {
+			if (slot->rel == NULL || record.length != slot->rel->row_length) {
+				result = DB_INCONSISTENCY_ERROR;
+				break;
+			}
+			if (record.length > row_size) {
+				free(row);
+				row = (unsigned char *)malloc(record.length);
+				if (row == NULL) {
+					result = DB_ALLOCATION_ERROR;
+					break;
+				}
+				row_size = record.length;
+			}
+			if (DB_ERROR(storage_read_from(log, row, offset, record.length))) {
+				result = DB_STORAGE_ERROR;
+				break;
+			}
+			result = storage_put_row(slot->rel, row, FALSE);
+			if (DB_ERROR(result)) {
+				break;
+			}
+		} else {
+			result = DB_INCONSISTENCY_ERROR;
+			break;
+		}
+	}
+
+	free(row);
+#ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	if (DB_SUCCESS(result)) {
+		result = storage_flush_insert_buffer();
+	}
+#endif
+	return result;
+}
+
+/****************************************************************************
+ * Name: transaction_apply_index
+ *
+ * Description: Inserts the keys of the logged rows of a relation into one
+ *              of its indexes, DB_TRANSACTION_SORT_LIMIT sorted keys at a
+ *              time, and writes the index back. row holds a row of the
+ *              relation.
+ *
+ ****************************************************************************/
+static db_result_t transaction_apply_index(db_storage_id_t log, unsigned long size, int slot_id, struct transaction_slot_s *slot, index_t *index, unsigned char *row, index_entry_t *entries)
+{
+	struct transaction_record_s record;
+	unsigned long offset;
+	tuple_id_t tuple_id;
+	int count = 0;
+
+	tuple_id = slot->base_rows;
+	for (offset = sizeof(struct transaction_log_header_s); offset < size; offset += record.length) {
+		if (DB_ERROR(storage_read_from(log, &record, offset, sizeof(record)))) {
+			return DB_STORAGE_ERROR;
+		}
+		offset += sizeof(record);
+		if (record.type != TRANSACTION_RECORD_ROW || record.slot != slot_id) {
+			continue;
+		}
+
+		if (DB_ERROR(storage_read_from(log, row, offset, record.length))) {
+			return DB_STORAGE_ERROR;
+		}
+		entries[count].key_length = index_key_from_row(index, row, entries[count].key);
+		entries[count].tuple_id = tuple_id++;
+		if (++count == DB_TRANSACTION_SORT_LIMIT) {
+			if (DB_ERROR(index_insert_batch(index, entries, count))) {
+				return DB_INDEX_ERROR;
+			}
+			count = 0;
+		}
+	}
+
+	if (count > 0 && DB_ERROR(index_insert_batch(index, entries, count))) {
+		return DB_INDEX_ERROR;
+	}
+	return index_flush(index);
+}
+
+/* The keys in a rebuilt index come from the tuple file, which now holds the logged rows */
+static db_result_t transaction_rebuild_index(relation_t *rel, attribute_t *attr)
+{
+	attribute_t *attrs[DB_INDEX_ATTRIBUTE_LIMIT];
+	index_type_t type;
+	db_result_t result;
+	int count;
+
+	type = ((index_t *)attr->index)->type;
+	count = ((index_t *)attr->index)->attr_count;
+	memcpy(attrs, ((index_t *)attr->index)->attrs, count * sizeof(attrs[0]));
+	result = index_destroy(attr->index);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+	result = index_create(type, rel, attrs, count);
+	if (DB_ERROR(result)) {
+		return result;
+	}
+	return index_flush(attr->index);
+}
+
+/****************************************************************************
+ * Name: transaction_apply_indexes
+ *
+ * Description: Brings the external indexes of the relations in the log up
+ *              to date with the appended rows. Inline indexes read the tuple
+ *              file directly and need nothing.
+ *
+ ****************************************************************************/
+static db_result_t transaction_apply_indexes(db_storage_id_t log, unsigned long size, struct transaction_slot_s *slots, bool recovery)
+{
+	index_entry_t *entries;
+	attribute_t *attr;
+	unsigned char *row;
+	db_result_t result = DB_OK;
+	int i;
+
+	entries = (index_entry_t *)malloc(DB_TRANSACTION_SORT_LIMIT * sizeof(index_entry_t));
+	if (entries == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+
+	for (i = 0; i < DB_TRANSACTION_RELATION_LIMIT && DB_SUCCESS(result); i++) {
+		if (slots[i].rel == NULL) {
+			continue;
+		}
+		row = (unsigned char *)malloc(slots[i].rel->row_length);
+		if (row == NULL) {
+			result = DB_ALLOCATION_ERROR;
+			break;
+		}
+		for (attr = list_head(slots[i].rel->attributes); attr != NULL && DB_SUCCESS(result); attr = attr->next) {
+			if (!(attr->flags & ATTRIBUTE_FLAG_INVALID)) {
+				if (attr->index == NULL) {
+					index_load(slots[i].rel, attr);
+				}
+				if (attr->index != NULL && ((index_t *)attr->index)->type != INDEX_INLINE) {
+					if (recovery) {
+						result = transaction_rebuild_index(slots[i].rel, attr);
+					} else {
+						result = transaction_apply_index(log, size, i, &slots[i], attr->index, row, entries);
+					}
+				}
+			}
+		}
+		free(row);
+	}
+
+	free(entries);
+	return result;
+}
+
+static db_result_t transaction_replay(struct transaction_slot_s *slots, bool recovery)
+{
+	db_storage_id_t log;
+	off_t size;
+	db_result_t result;
+
+	log = storage_open(TRANSACTION_LOG_FILE, O_RDONLY);
+	if (log < 0) {
+		return DB_STORAGE_ERROR;
+	}
+	size = storage_seek(log, 0, SEEK_END);
+	if (size == (off_t)-1) {
+		storage_close(log);
+		return DB_STORAGE_ERROR;
+	}
+
+	result = transaction_apply_rows(log, (unsigned long)size, slots, recovery);
+	if (DB_SUCCESS(result)) {
+		result = transaction_apply_indexes(log, (unsigned long)size, slots, recovery);
+	}
+	storage_close(log);
+
+	return result;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+bool transaction_is_active(void)
+{
+	return g_transaction.active;
+}
+
+db_result_t transaction_begin(void)
+{
+	struct transaction_log_header_s header;
+	db_result_t result;
+
+	if (g_transaction.active) {
+		DB_LOG_E("DB: A transaction is already in progress\n");
+		return DB_BUSY_ERROR;
+	}
+
+	/* The log of a commit which failed to apply must not be overwritten */
+	result = transaction_recover();
+	if (DB_ERROR(result)) {
+		return result;
+	}
+
+	g_transaction.log = storage_open(TRANSACTION_LOG_FILE, O_RDWR | O_CREAT | O_TRUNC);
+	if (g_transaction.log < 0) {
+		DB_LOG_E("DB: Failed to create the transaction log\n");
+		return DB_STORAGE_ERROR;
+	}
+
+	header.magic = TRANSACTION_LOG_MAGIC;
+	header.state = TRANSACTION_LOG_PENDING;
+	if (DB_ERROR(storage_write_to(g_transaction.log, &header, 0, sizeof(header)))) {
+		transaction_end();
+		storage_remove(TRANSACTION_LOG_FILE);
+		return DB_STORAGE_ERROR;
+	}
+	g_transaction.log_size = sizeof(header);
+	g_transaction.active = true;
+
+	return DB_OK;
+}
+
+db_result_t transaction_insert(relation_t *rel, attribute_value_t *values)
+{
+	struct transaction_record_s record;
+	unsigned char *row;
+	db_result_t result;
+	int slot_id;
+
+	if (!g_transaction.active) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	row = (unsigned char *)malloc(rel->row_length);
+	if (row == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+
+	result = relation_format_row(rel, values, row);
+	if (DB_ERROR(result)) {
+		goto out;
+	}
+
+	result = transaction_add_relation(rel, &slot_id);
+	if (DB_ERROR(result)) {
+		goto out;
+	}
+
+	record.type = TRANSACTION_RECORD_ROW;
+	record.slot = slot_id;
+	record.length = rel->row_length;
+	if (DB_ERROR(storage_write_to(g_transaction.log, &record, g_transaction.log_size, sizeof(record))) || DB_ERROR(storage_write_to(g_transaction.log, row, g_transaction.log_size + sizeof(record), rel->row_length))) {
+		DB_LOG_E("DB: Failed to write the transaction log\n");
+		result = DB_STORAGE_ERROR;
+		goto out;
+	}
+	g_transaction.log_size += sizeof(record) + rel->row_length;
+	result = DB_OK;
+
+out:
+	free(row);
+	return result;
+}
+
+db_result_t transaction_commit(void)
+{
+	struct transaction_log_header_s header;
+	struct transaction_slot_s *slot;
+	db_result_t result;
+	int i;
+
+	if (!g_transaction.active) {
+		DB_LOG_E("DB: No transaction to commit\n");
+		return DB_ARGUMENT_ERROR;
+	}
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	if (DB_ERROR(storage_flush_insert_buffer())) {
+		result = DB_STORAGE_ERROR;
+		goto errout;
+	}
+#endif
+
+	/* Record where the rows of each relation start */
+	for (i = 0; i < g_transaction.slot_count; i++) {
+		slot = &g_transaction.slots[i];
+		slot->base_rows = relation_cardinality(slot->rel);
+		if (slot->base_rows == INVALID_TUPLE || DB_ERROR(storage_write_to(g_transaction.log, &slot->base_rows, slot->offset + offsetof(struct transaction_relation_s, base_rows), sizeof(slot->base_rows)))) {
+			result = DB_STORAGE_ERROR;
+			goto errout;
+		}
+	}
+
+	/* The records reach the flash before the commit mark does */
+	storage_close(g_transaction.log);
+	g_transaction.log = storage_open(TRANSACTION_LOG_FILE, O_RDWR);
+	if (g_transaction.log < 0) {
+		result = DB_STORAGE_ERROR;
+		goto errout;
+	}
+	header.magic = TRANSACTION_LOG_MAGIC;
+	header.state = TRANSACTION_LOG_COMMITTED;
+	if (DB_ERROR(storage_write_to(g_transaction.log, &header, 0, sizeof(header)))) {
+		result = DB_STORAGE_ERROR;
+		goto errout;
+	}
+	storage_close(g_transaction.log);
+	g_transaction.log = INVALID_STORAGE_ID;
+
+	result = transaction_replay(g_transaction.slots, false);
+	if (DB_ERROR(result)) {
+		DB_LOG_E("DB: Failed to apply the committed transaction, it is replayed before the next change\n");
+		g_replay_pending = true;
+		transaction_end();
+		return result;
+	}
+
+	transaction_end();
+	storage_remove(TRANSACTION_LOG_FILE);
+	return DB_OK;
+
+errout:
+	transaction_end();
+	storage_remove(TRANSACTION_LOG_FILE);
+	return result;
+}
+
+db_result_t transaction_rollback(void)
+{
+	if (!g_transaction.active) {
+		DB_LOG_E("DB: No transaction to roll back\n");
+		return DB_ARGUMENT_ERROR;
+	}
+
+	transaction_end();
+	storage_remove(TRANSACTION_LOG_FILE);
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: transaction_recover
+ *
+ * Description: Replays a committed transaction log left by an interrupted
+ *              commit and removes any other log. Called from db_init().
+ *
+ ****************************************************************************/
+db_result_t transaction_recover(void)
+{
+	struct transaction_log_header_s header;
+	struct transaction_slot_s slots[DB_TRANSACTION_RELATION_LIMIT];
+	db_storage_id_t log;
+	db_result_t result;
+
+	log = storage_open(TRANSACTION_LOG_FILE, O_RDONLY);
+	if (log < 0) {
+		return DB_OK;
+	}
+	result = storage_read_from(log, &header, 0, sizeof(header));
+	storage_close(log);
+
+	if (DB_SUCCESS(result) && header.magic == TRANSACTION_LOG_MAGIC && header.state == TRANSACTION_LOG_COMMITTED) {
+		DB_LOG_D("DB: Replaying the committed transaction log\n");
+		memset(slots, 0, sizeof(slots));
+		result = transaction_replay(slots, true);
+		transaction_release_slots(slots);
+		if (DB_ERROR(result)) {
+			DB_LOG_E("DB: Failed to replay the transaction log\n");
+			g_replay_pending = true;
+			return result;
+		}
+	}
+
+	storage_remove(TRANSACTION_LOG_FILE);
+	g_replay_pending = false;
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: transaction_check
+ *
+ * Description: Replays a committed log that failed to apply before a
+ *              statement outside a transaction changes the relations.
+ *              The replay truncates the tuple files to their rows at commit
+ *              time, which would drop rows appended in the meantime, so
+ *              DB_BUSY_ERROR is returned while the log cannot be applied.
+ *
+ ****************************************************************************/
+db_result_t transaction_check(void)
+{
+	if (!g_replay_pending) {
+		return DB_OK;
+	}
+	if (DB_ERROR(transaction_recover())) {
+		return DB_BUSY_ERROR;
+	}
+	return DB_OK;
+}
@@ -119,6 +119,22 @@ void InputHandler::resetWorker()
 
 bool InputHandler::processWorker()
 {
+	if (!mDemuxer && !mDecoder) {
+		// PCM needs no processing, read it from source straight into stream buffer
+		unsigned char *span;
+		size_t size = mBufferWriter->acquire(&span, SIZE_MAX, false);
+		if (size > 0) {
+			ssize_t readLen = readFromSource(span, size);
+			if (readLen <= 0) {
+				// Error occurred, or inputting finished
+				mBufferWriter->setEndOfStream();
+				return false;
+			}
+			mBufferWriter->commit((size_t)readLen);
+		}
+		return true;
+	}
+
 	size_t size = getAvailSpace();
 	if (size > 0) {
 		auto buf = new unsigned char[size];
@@ -255,6 +271,14 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 		while (1) {
 			unsigned char *buffPCM = buf;
 			size_t sizePCM = used;
+			if (mDecoder) {
+				// Decode in place into stream buffer
+				sizePCM = mBufferWriter->acquire(&buffPCM, SIZE_MAX);
+				if (sizePCM == 0) {
+					meddbg("End of writting!\n");
+					return EOF;
+				}
+			}
 			ret = getPCM(buffES, sizeES, &usedES, &buffPCM, &sizePCM);
 			if (ret < 0) {
 				meddbg("getPCM failed! error: %d\n", ret);
@@ -265,6 +289,11 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 				break;
 			}
 
+			if (mDecoder) {
+				mBufferWriter->commit(sizePCM);
+				continue;
+			}
+
 			// write PCM data to stream buffer
 			size_t written = mBufferWriter->write(buffPCM, sizePCM);
 			if (written != sizePCM) {
@@ -87,6 +87,11 @@ player_result_t MediaPlayer::setDataSource(std::unique_ptr<stream::InputDataSour
 	return mPMpImpl->setDataSource(std::move(source));
 }
 
+player_result_t MediaPlayer::setNextDataSource(std::unique_ptr<stream::InputDataSource> source)
+{
+	return mPMpImpl->setNextDataSource(std::move(source));
+}
+
 player_result_t MediaPlayer::setObserver(std::shared_ptr<MediaPlayerObserverInterface> observer)
 {
 	return mPMpImpl->setObserver(observer);
@@ -35,6 +35,10 @@ MediaPlayerImpl::MediaPlayerImpl(MediaPlayer &player) : mPlayer(player)
 	mCurState = PLAYER_STATE_NONE;
 	mBuffer = nullptr;
 	mBufSize = 0;
+	mInputHandler = std::make_shared<stream::InputHandler>();
+	mNextInputHandler = nullptr;
+	mNextState = NEXT_SOURCE_NONE;
+	mNextWaiting = false;
 }
 
 player_result_t MediaPlayerImpl::create()
@@ -146,13 +150,13 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
-	if (!mInputHandler.open()) {
+	if (!mInputHandler->open()) {
 		meddbg("MediaPlayer prepare fail : open fail\n");
 		ret = PLAYER_ERROR_FILE_OPEN_FAILED;
 		return notifySync();
 	}
 
-	auto source = mInputHandler.getDataSource();
+	auto source = mInputHandler->getDataSource();
 	if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 							 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
 		meddbg("MediaPlayer prepare fail : set_audio_stream_out fail\n");
@@ -213,7 +217,7 @@ void MediaPlayerImpl::prepareAsyncPlayer()
 
 	mCurState = PLAYER_STATE_PREPARING;
 
-	if (!mInputHandler.doStandBy()) {
+	if (!mInputHandler->doStandBy()) {
 		meddbg("MediaPlayer prepare fail : doStandBy fail\n");
 		notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		return;
@@ -262,7 +266,8 @@ void MediaPlayerImpl::unpreparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
-	mInputHandler.close();
+	discardNextSource();
+	mInputHandler->close();
 
 	mCurState = PLAYER_STATE_IDLE;
 	return notifySync();
@@ -297,7 +302,7 @@ void MediaPlayerImpl::startPlayer()
 	}
 
 	if (mCurState == PLAYER_STATE_PAUSED) {
-		auto source = mInputHandler.getDataSource();
+		auto source = mInputHandler->getDataSource();
 		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 								 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
 			meddbg("MediaPlayer startPlayer fail : set_audio_stream_out fail\n");
@@ -358,6 +363,7 @@ player_result_t MediaPlayerImpl::stopPlayback()
 	}
 
 	mCurState = PLAYER_STATE_READY;
+	mNextWaiting = false;
 	mpw.setPlayer(nullptr);
 
 	audio_manager_result_t result = stop_audio_stream_out();
@@ -410,6 +416,7 @@ void MediaPlayerImpl::pausePlayer()
 		mpw.setPlayer(nullptr);
 	}
 	mCurState = PLAYER_STATE_PAUSED;
+	mNextWaiting = false;
 	notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSED);
 }
 
@@ -558,13 +565,173 @@ void MediaPlayerImpl::setPlayerDataSource(std::shared_ptr<stream::InputDataSourc
 		return notifySync();
 	}
 
-	mInputHandler.setPlayer(shared_from_this());
-	mInputHandler.setInputDataSource(source);
+	mInputHandler->setPlayer(shared_from_this());
+	mInputHandler->setInputDataSource(source);
 	mCurState = PLAYER_STATE_CONFIGURED;
 
 	return notifySync();
 }
 
+player_result_t MediaPlayerImpl::setNextDataSource(std::unique_ptr<stream::InputDataSource> source)
+{
+	player_result_t ret = PLAYER_OK;
+
+	std::unique_lock<std::mutex> lock(mCmdMtx);
+	medvdbg("MediaPlayer setNextDataSource\n");
+
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+	if (!mpw.isAlive()) {
+		meddbg("PlayerWorker is not alive\n");
+		return PLAYER_ERROR_NOT_ALIVE;
+	}
+
+	std::shared_ptr<stream::InputDataSource> sharedDataSource = std::move(source);
+	mpw.enQueue(&MediaPlayerImpl::setPlayerNextDataSource, shared_from_this(), sharedDataSource, std::ref(ret));
+	mSyncCv.wait(lock);
+
+	return ret;
+}
+
+void MediaPlayerImpl::setPlayerNextDataSource(std::shared_ptr<stream::InputDataSource> source, player_result_t &ret)
+{
+	LOG_STATE_INFO(mCurState);
+
+	if (mCurState == PLAYER_STATE_NONE || mCurState == PLAYER_STATE_IDLE) {
+		meddbg("%s Fail : invalid state\n", __func__);
+		LOG_STATE_DEBUG(mCurState);
+		ret = PLAYER_ERROR_INVALID_STATE;
+		return notifySync();
+	}
+
+	if (!source) {
+		meddbg("MediaPlayer setNextDataSource fail : invalid argument. DataSource should not be nullptr\n");
+		ret = PLAYER_ERROR_INVALID_PARAMETER;
+		return notifySync();
+	}
+
+	discardNextSource();
+
+	// The player is set when the source becomes current, so that buffer events
+	// of the preroll are not reported as events of the current source
+	auto handler = std::make_shared<stream::InputHandler>();
+	handler->setInputDataSource(source);
+	{
+		std::lock_guard<std::mutex> lock(mNextMtx);
+		mNextInputHandler = handler;
+		mNextState = NEXT_SOURCE_PREROLLING;
+	}
+
+	// Open the source and decode until buffered while the current one is played
+	auto mp = shared_from_this();
+	std::thread wk = std::thread([=]() {
+		medvdbg("MediaPlayer preroll thread enter\n");
+		bool prepared = handler->open();
+
+		std::unique_lock<std::mutex> lock(mp->mNextMtx);
+		if (mp->mNextInputHandler != handler) {
+			// Discarded while prerolling
+			lock.unlock();
+			handler->close();
+		} else {
+			mp->mNextState = prepared ? NEXT_SOURCE_READY : NEXT_SOURCE_FAILED;
+			lock.unlock();
+			PlayerWorker &mpw = PlayerWorker::getWorker();
+			mpw.enQueue(&MediaPlayerImpl::nextSourcePrerolled, mp);
+		}
+		medvdbg("MediaPlayer preroll thread exit\n");
+	});
+	wk.detach();
+
+	return notifySync();
+}
+
+void MediaPlayerImpl::discardNextSource()
+{
+	std::unique_lock<std::mutex> lock(mNextMtx);
+	auto handler = mNextInputHandler;
+	bool prerolling = (mNextState == NEXT_SOURCE_PREROLLING);
+
+	mNextInputHandler = nullptr;
+	mNextState = NEXT_SOURCE_NONE;
+	lock.unlock();
+	mNextWaiting = false;
+
+	// The preroll thread closes the handler it is still opening
+	if (handler && !prerolling) {
+		handler->close();
+	}
+}
+
+bool MediaPlayerImpl::startNextSource()
+{
+	std::unique_lock<std::mutex> lock(mNextMtx);
+	if (!mNextInputHandler) {
+		return false;
+	}
+
+	if (mNextState == NEXT_SOURCE_PREROLLING) {
+		// PlayerWorker sleeps on its queue until nextSourcePrerolled() is run
+		medvdbg("Wait for the next source to be prerolled\n");
+		mNextWaiting = true;
+		return true;
+	}
+
+	auto next = mNextInputHandler;
+	bool prepared = (mNextState == NEXT_SOURCE_READY);
+	mNextInputHandler = nullptr;
+	mNextState = NEXT_SOURCE_NONE;
+	lock.unlock();
+
+	if (!prepared) {
+		meddbg("MediaPlayer next source fail : open fail\n");
+		next->close();
+		return false;
+	}
+
+	auto source = next->getDataSource();
+	audio_manager_result_t result = change_audio_stream_out(source->getChannels(), source->getSampleRate(), source->getPcmFormat());
+	if (result == AUDIO_MANAGER_DEVICE_NOT_SUPPORT) {
+		// The stream cannot be converted to the opened device, reopen it
+		medvdbg("Reopen the output stream for the next source\n");
+		if (reset_audio_stream_out() == AUDIO_MANAGER_SUCCESS) {
+			result = set_audio_stream_out(source->getChannels(), source->getSampleRate(), source->getPcmFormat());
+		}
+	}
+	if (result != AUDIO_MANAGER_SUCCESS) {
+		meddbg("MediaPlayer next source fail : audio stream out error %d\n", result);
+		next->close();
+		return false;
+	}
+
+	int bufSize = get_user_output_frames_to_byte(get_output_frame_count());
+	if (bufSize > mBufSize) {
+		unsigned char *buffer = new unsigned char[bufSize];
+		if (!buffer) {
+			meddbg("MediaPlayer next source fail : mBuffer allocation fail\n");
+			next->close();
+			return false;
+		}
+		delete[] mBuffer;
+		mBuffer = buffer;
+	}
+	mBufSize = bufSize;
+	medvdbg("MediaPlayer mBuffer size : %d\n", mBufSize);
+
+	mInputHandler->close();
+	next->setPlayer(shared_from_this());
+	mInputHandler = next;
+
+	notifyObserver(PLAYER_OBSERVER_COMMAND_NEXT_SOURCE_STARTED);
+	return true;
+}
+
+void MediaPlayerImpl::nextSourcePrerolled()
+{
+	// If playback is waiting for the next source, the next playback() starts
+	// it, or finishes if it failed to open
+	mNextWaiting = false;
+}
+
 player_result_t MediaPlayerImpl::setObserver(std::shared_ptr<MediaPlayerObserverInterface> observer)
 {
 	std::unique_lock<std::mutex> lock(mCmdMtx);
@@ -676,6 +843,9 @@ void MediaPlayerImpl::notifyObserver(player_observer_command_t cmd, ...)
 		case PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED:
 			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferStateChanged, mPlayerObserver, mPlayer, (buffer_state_t)va_arg(ap, int));
 			break;
+		case PLAYER_OBSERVER_COMMAND_NEXT_SOURCE_STARTED:
+			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackNextSourceStarted, mPlayerObserver, mPlayer);
+			break;
 		case PLAYER_OBSERVER_COMMAND_BUFFER_DATAREACHED: {
 			medvdbg("OBSERVER_COMMAND_BUFFER_DATAREACHED\n");
 			unsigned char *data = va_arg(ap, unsigned char *);
@@ -711,7 +881,7 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 	case PLAYER_EVENT_SOURCE_PREPARED: {
 		// Input handler has been opened successfully by InputHandler::doStandBy().
 		// Now setup audio manager and notify player observer the result.
-		auto source = mInputHandler.getDataSource();
+		auto source = mInputHandler->getDataSource();
 		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 								 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
 			meddbg("MediaPlayer prepare fail : set_audio_stream_out fail\n");
@@ -746,7 +916,7 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 
 void MediaPlayerImpl::playback()
 {
-	ssize_t num_read = mInputHandler.read(mBuffer, (int)mBufSize);
+	ssize_t num_read = mInputHandler->read(mBuffer, (int)mBufSize);
 	medvdbg("num_read : %d\n", num_read);
 	if (num_read > 0) {
 		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)num_read));
@@ -765,6 +935,10 @@ void MediaPlayerImpl::playback()
 			}
 		}
 	} else if (num_read == 0) {
+		if (startNextSource()) {
+			return;
+		}
+
 		player_result_t errcode = stopPlayback();
 		if (errcode != PLAYER_OK) {
 			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, errcode);
@@ -78,6 +78,7 @@ typedef enum player_observer_command_e {
 	PLAYER_OBSERVER_COMMAND_BUFFER_UPDATED,
 	PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED,
 	PLAYER_OBSERVER_COMMAND_BUFFER_DATAREACHED,
+	PLAYER_OBSERVER_COMMAND_NEXT_SOURCE_STARTED,
 } player_observer_command_t;
 
 typedef enum player_event_e {
@@ -85,6 +86,13 @@ typedef enum player_event_e {
 	PLAYER_EVENT_SOURCE_PREPARED,
 } player_event_t;
 
+typedef enum next_source_state_e {
+	NEXT_SOURCE_NONE,
+	NEXT_SOURCE_PREROLLING,
+	NEXT_SOURCE_READY,
+	NEXT_SOURCE_FAILED
+} next_source_state_t;
+
 class MediaPlayerImpl : public std::enable_shared_from_this<MediaPlayerImpl>
 {
 public:
@@ -105,10 +113,12 @@ public:
 	player_result_t setVolume(uint8_t vol);
 
 	player_result_t setDataSource(std::unique_ptr<stream::InputDataSource>);
+	player_result_t setNextDataSource(std::unique_ptr<stream::InputDataSource>);
 	player_result_t setObserver(std::shared_ptr<MediaPlayerObserverInterface>);
 
 	player_state_t getState();
 	bool isPlaying();
+	bool isWaitingNextSource() { return mNextWaiting; }
 
 	void notifySync();
 	void notifyObserver(player_observer_command_t cmd, ...);
@@ -130,6 +140,10 @@ private:
 	void setPlayerVolume(uint8_t vol, player_result_t &ret);
 	void setPlayerObserver(std::shared_ptr<MediaPlayerObserverInterface> observer);
 	void setPlayerDataSource(std::shared_ptr<stream::InputDataSource> dataSource, player_result_t &ret);
+	void setPlayerNextDataSource(std::shared_ptr<stream::InputDataSource> dataSource, player_result_t &ret);
+	void discardNextSource();
+	bool startNextSource();
+	void nextSourcePrerolled();
 
 private:
 	MediaPlayer &mPlayer;
@@ -140,7 +154,11 @@ private:
 	std::condition_variable mSyncCv;
 	std::shared_ptr<stream_info_t> mStreamInfo;
 	std::shared_ptr<MediaPlayerObserverInterface> mPlayerObserver;
-	stream::InputHandler mInputHandler;
+	std::shared_ptr<stream::InputHandler> mInputHandler;
+	std::shared_ptr<stream::InputHandler> mNextInputHandler;
+	next_source_state_t mNextState;
+	std::mutex mNextMtx;
+	bool mNextWaiting;
 };
 } // namespace media
 #endif
@@ -16,31 +16,103 @@
  *
  ******************************************************************/
 
+#include <errno.h>
+#include <sys/types.h>
 #include "MediaQueue.h"
 
 namespace media {
-MediaQueue::MediaQueue()
+MediaQueue::MediaQueue() : mEnqueuePos(0), mDequeuePos(0), mCredits(0), mOverflowCount(0)
 {
+	for (size_t i = 0; i < RING_SIZE; i++) {
+		mRing[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	sem_init(&mSem, 0, 0);
 }
 MediaQueue::~MediaQueue()
 {
+	sem_destroy(&mSem);
+}
+
+MediaQueue::Cell *MediaQueue::claim(size_t *pos)
+{
+	size_t cur = mEnqueuePos.load(std::memory_order_relaxed);
+	while (1) {
+		Cell *cell = &mRing[cur & (RING_SIZE - 1)];
+		size_t seq = cell->sequence.load(std::memory_order_acquire);
+		if (seq == cur) {
+			// The slot is free, try to take it
+			if (mEnqueuePos.compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed)) {
+				*pos = cur;
+				return cell;
+			}
+		} else if ((ssize_t)(seq - cur) < 0) {
+			// The slot is still in use one lap ago, ring is full
+			return nullptr;
+		} else {
+			// Another producer took the slot
+			cur = mEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+void MediaQueue::publish(Cell *cell, size_t pos)
+{
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	sem_post(&mSem);
+}
+
+void MediaQueue::pushOverflow(std::function<void()> &&func)
+{
+	std::lock_guard<std::mutex> lock(mOverflowMtx);
+	mOverflow.push(std::move(func));
+	mOverflowCount++;
+	sem_post(&mSem);
+}
+
+bool MediaQueue::tryPop(MediaCommand &command)
+{
+	Cell *cell = &mRing[mDequeuePos & (RING_SIZE - 1)];
+	if (cell->sequence.load(std::memory_order_acquire) == mDequeuePos + 1) {
+		command = std::move(cell->command);
+		// Free the slot for the next lap
+		cell->sequence.store(mDequeuePos + RING_SIZE, std::memory_order_release);
+		mDequeuePos++;
+		return true;
+	}
+
+	if (mOverflowCount > 0) {
+		std::lock_guard<std::mutex> lock(mOverflowMtx);
+		command.assign(std::move(mOverflow.front()));
+		mOverflow.pop();
+		mOverflowCount--;
+		return true;
+	}
+
+	return false;
 }
 
-std::function<void()> MediaQueue::deQueue()
+MediaCommand MediaQueue::deQueue()
 {
-	std::unique_lock<std::mutex> lock(mQueueMtx);
-	if (mQueueData.empty()) {
-		mQueueCv.wait(lock);
+	// Take the token of a published command
+	if (mCredits > 0) {
+		mCredits--;
+	} else {
+		while (sem_wait(&mSem) != 0 && errno == EINTR);
+	}
+
+	// The oldest slot may be claimed but not published yet, while later ones are.
+	// Wait for its token then, and keep the extra one for next time.
+	MediaCommand command;
+	while (!tryPop(command)) {
+		while (sem_wait(&mSem) != 0 && errno == EINTR);
+		mCredits++;
 	}
 
-	auto data = std::move(mQueueData.front());
-	mQueueData.pop();
-	return data;
+	return command;
 }
 
 bool MediaQueue::isEmpty()
 {
-	std::unique_lock<std::mutex> lock(mQueueMtx);
-	return mQueueData.empty();
+	return mEnqueuePos.load(std::memory_order_acquire) == mDequeuePos && mOverflowCount == 0;
 }
 } // namespace media
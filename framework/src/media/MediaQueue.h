@@ -20,13 +20,102 @@
 #define __MEDIA_QUEUE_H
 
 #include <mutex>
-#include <condition_variable>
 #include <queue>
 #include <atomic>
-#include <iostream>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <semaphore.h>
 
 namespace media {
+
+/**
+ * A callable stored in place. Storing, moving and calling it never allocate,
+ * so it can carry commands on hot paths such as buffer-level notifications.
+ */
+class MediaCommand
+{
+public:
+	static constexpr size_t STORAGE_SIZE = 8 * sizeof(void *);
+	typedef std::aligned_storage<STORAGE_SIZE>::type Storage;
+
+	template <typename _Fn>
+	struct fits : std::integral_constant<bool, sizeof(_Fn) <= STORAGE_SIZE && alignof(_Fn) <= alignof(Storage)> {
+	};
+
+	MediaCommand() : mOps(nullptr) {}
+	MediaCommand(MediaCommand &&other) : mOps(nullptr) { *this = std::move(other); }
+	MediaCommand &operator=(MediaCommand &&other) {
+		if (this != &other) {
+			reset();
+			if (other.mOps) {
+				other.mOps(OP_MOVE, &mStorage, &other.mStorage);
+				mOps = other.mOps;
+				other.mOps = nullptr;
+			}
+		}
+		return *this;
+	}
+	MediaCommand(const MediaCommand &) = delete;
+	MediaCommand &operator=(const MediaCommand &) = delete;
+	~MediaCommand() { reset(); }
+
+	template <typename _Fn>
+	void assign(_Fn &&fn) {
+		typedef typename std::decay<_Fn>::type Fn;
+		static_assert(fits<Fn>::value, "callable does not fit in MediaCommand");
+		reset();
+		new (&mStorage) Fn(std::forward<_Fn>(fn));
+		mOps = &ops<Fn>;
+	}
+	void reset() {
+		if (mOps) {
+			mOps(OP_DESTROY, &mStorage, nullptr);
+			mOps = nullptr;
+		}
+	}
+	void operator()() {
+		if (mOps) {
+			mOps(OP_CALL, &mStorage, nullptr);
+		}
+	}
+	explicit operator bool() const { return mOps != nullptr; }
+
+private:
+	enum Op {
+		OP_CALL,
+		OP_MOVE,
+		OP_DESTROY,
+	};
+
+	template <typename Fn>
+	static void ops(Op op, void *dst, void *src) {
+		switch (op) {
+		case OP_CALL:
+			(*static_cast<Fn *>(dst))();
+			break;
+		case OP_MOVE:
+			new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+			static_cast<Fn *>(src)->~Fn();
+			break;
+		case OP_DESTROY:
+			static_cast<Fn *>(dst)->~Fn();
+			break;
+		}
+	}
+
+	Storage mStorage;
+	void (*mOps)(Op, void *, void *);
+};
+
+/**
+ * Commands are kept in a bounded lock-free ring and run by a single worker.
+ * Any thread may enqueue, each ring slot carries a sequence number telling whether
+ * it's free or published. Commands too big for MediaCommand, and commands enqueued
+ * while the ring is full, go to a locked overflow queue. Once the overflow queue
+ * is in use, new commands follow it until it's drained, to keep the order.
+ */
 class MediaQueue
 {
 public:
@@ -34,18 +123,50 @@ public:
 	~MediaQueue();
 	template <typename _Callable, typename... _Args>
 	void enQueue(_Callable &&__f, _Args &&... __args) {
-		std::unique_lock<std::mutex> lock(mQueueMtx);
-		std::function<void()> func = std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
-		mQueueData.push(func);
-		mQueueCv.notify_one();
+		auto func = std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
+		push(std::move(func), std::integral_constant<bool, MediaCommand::fits<decltype(func)>::value>());
 	}
-	std::function<void()> deQueue();
+	/* Called by the worker only */
+	MediaCommand deQueue();
 	bool isEmpty();
 
 private:
-	std::queue<std::function<void()>> mQueueData;
-	std::condition_variable mQueueCv;
-	std::mutex mQueueMtx;
+	static constexpr size_t RING_SIZE = 16;
+	static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of 2");
+
+	struct Cell {
+		std::atomic<size_t> sequence;
+		MediaCommand command;
+	};
+
+	template <typename _Fn>
+	void push(_Fn &&func, std::true_type) {
+		size_t pos;
+		Cell *cell = (mOverflowCount == 0) ? claim(&pos) : nullptr;
+		if (cell == nullptr) {
+			pushOverflow(std::function<void()>(std::move(func)));
+			return;
+		}
+		cell->command.assign(std::move(func));
+		publish(cell, pos);
+	}
+	template <typename _Fn>
+	void push(_Fn &&func, std::false_type) {
+		pushOverflow(std::function<void()>(std::move(func)));
+	}
+	Cell *claim(size_t *pos);
+	void publish(Cell *cell, size_t pos);
+	void pushOverflow(std::function<void()> &&func);
+	bool tryPop(MediaCommand &command);
+
+	Cell mRing[RING_SIZE];
+	std::atomic<size_t> mEnqueuePos;
+	size_t mDequeuePos;
+	size_t mCredits;
+	std::atomic<size_t> mOverflowCount;
+	std::queue<std::function<void()>> mOverflow;
+	std::mutex mOverflowMtx;
+	sem_t mSem;
 };
 } // namespace media
 
@@ -81,7 +81,7 @@ void MediaWorker::stopWorker()
 	}
 }
 
-std::function<void()> MediaWorker::deQueue()
+MediaCommand MediaWorker::deQueue()
 {
 	return mWorkerQueue.deQueue();
 }
@@ -99,9 +99,9 @@ void *MediaWorker::mediaLooper(void *arg)
 	while (worker->mIsRunning) {
 		while (worker->processLoop() && worker->mWorkerQueue.isEmpty());
 
-		std::function<void()> run = worker->deQueue();
+		MediaCommand run = worker->deQueue();
 		medvdbg("MediaWorker : deQueue\n");
-		if (run != nullptr) {
+		if (run) {
 			run();
 		}
 	}
@@ -39,7 +39,7 @@ public:
 	void enQueue(_Callable &&__f, _Args &&... __args) {
 		mWorkerQueue.enQueue(__f, __args...);
 	}
-	std::function<void()> deQueue();
+	MediaCommand deQueue();
 	bool isAlive();
 
 protected:
@@ -126,22 +126,26 @@ void OutputHandler::resetWorker()
 
 void OutputHandler::writeToSource(size_t size)
 {
-	auto buf = new unsigned char[size];
-	auto readed = mBufferReader->read(buf, size);
-	if (readed != size) {
-		meddbg("StreamBufferReader::read failed! size : %u, readed : %u\n", size, readed);
-		delete[] buf;
-		return;
-	}
+	// Write data to output source straight from stream buffer, a span at a time
+	while (size > 0) {
+		unsigned char *span;
+		size_t len = mBufferReader->acquire(&span, size);
+		if (len == 0) {
+			meddbg("StreamBufferReader::acquire failed! size : %u\n", size);
+			return;
+		}
 
-	auto written = mOutputDataSource->write(buf, size);
-	if (written <= 0) {
-		// Error occurred, stop outputting
-		meddbg("OutputDataSource::write returned <= 0! size : %u, written : %d\n", size, written);
-		mBufferWriter->setEndOfStream();
-	}
+		auto written = mOutputDataSource->write(span, len);
+		if (written <= 0) {
+			// Error occurred, stop outputting
+			meddbg("OutputDataSource::write returned <= 0! size : %u, written : %d\n", len, written);
+			mBufferWriter->setEndOfStream();
+			return;
+		}
 
-	delete[] buf;
+		mBufferReader->commit(len);
+		size -= len;
+	}
 }
 
 bool OutputHandler::processWorker()
@@ -47,6 +47,7 @@ namespace stream {
 
 StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold)
 	: mObserver(nullptr), mEOS(false), mBufferSize(bufferSize), mThreshold(threshold)
+	, mPendingWritten(0), mPendingRead(0), mDataWanted(0), mSpaceWanted(0)
 {
 	mRingBuf.buf = nullptr;
 	mRingBuf.depth = 0;
@@ -74,6 +75,8 @@ bool StreamBuffer::init(size_t size)
 bool StreamBuffer::reset()
 {
 	mEOS = false;
+	mPendingWritten = 0;
+	mPendingRead = 0;
 	return rb_reset(&mRingBuf);
 }
 
@@ -92,6 +95,84 @@ size_t StreamBuffer::write(unsigned char *buf, size_t size)
 	return rb_write(&mRingBuf, buf, size);
 }
 
+size_t StreamBuffer::writeSpan(unsigned char **buf)
+{
+	return rb_write_span(&mRingBuf, (void **)buf);
+}
+
+size_t StreamBuffer::commitWrite(size_t size)
+{
+	return rb_write_commit(&mRingBuf, size);
+}
+
+size_t StreamBuffer::readSpan(unsigned char **buf)
+{
+	return rb_read_span(&mRingBuf, (void **)buf);
+}
+
+size_t StreamBuffer::commitRead(size_t size)
+{
+	return rb_read(&mRingBuf, nullptr, size);
+}
+
+void StreamBuffer::updateChange(ssize_t change)
+{
+	size_t used = sizeOfData();
+	bool flush;
+
+	if (change > 0) {
+		mPendingWritten += (size_t)change;
+		flush = (mPendingWritten >= mThreshold) || (used == mBufferSize) || \
+				(used >= mThreshold && used - (size_t)change < mThreshold) || \
+				(mDataWanted > 0 && used >= mDataWanted);
+	} else if (change < 0) {
+		mPendingRead += (size_t)(-change);
+		flush = (mPendingRead >= mThreshold) || (used == 0) || \
+				(used < mThreshold && used + (size_t)(-change) >= mThreshold) || \
+				(mSpaceWanted > 0 && mBufferSize - used >= mSpaceWanted);
+	} else {
+		flush = false;
+	}
+
+	if (flush) {
+		flushChange();
+	}
+}
+
+void StreamBuffer::flushChange()
+{
+	if (mPendingWritten > 0) {
+		ssize_t change = (ssize_t)mPendingWritten;
+		mPendingWritten = 0;
+		notifyObserver(State::UPDATED, change);
+	}
+
+	if (mPendingRead > 0) {
+		ssize_t change = -((ssize_t)mPendingRead);
+		mPendingRead = 0;
+		notifyObserver(State::UPDATED, change);
+	}
+
+	// The other side may be waiting for data or spaces
+	mCondv.notify_one();
+}
+
+void StreamBuffer::waitForData(std::unique_lock<std::mutex> &lock, size_t size)
+{
+	flushChange();
+	mDataWanted = (size < mBufferSize) ? size : mBufferSize;
+	mCondv.wait(lock);
+	mDataWanted = 0;
+}
+
+void StreamBuffer::waitForSpace(std::unique_lock<std::mutex> &lock, size_t size)
+{
+	flushChange();
+	mSpaceWanted = (size < mBufferSize) ? size : mBufferSize;
+	mCondv.wait(lock);
+	mSpaceWanted = 0;
+}
+
 size_t StreamBuffer::sizeOfSpace()
 {
 	return rb_avail(&mRingBuf);
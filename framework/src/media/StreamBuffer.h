@@ -87,6 +87,45 @@ public:
 	 * Write(push) data into stream buffer.
 	 */
 	size_t write(unsigned char *buf, size_t size);
+	/**
+	 * Get the contiguous free space in stream buffer, data can be put in place
+	 * and then pushed by commitWrite() instead of being copied by write().
+	 */
+	size_t writeSpan(unsigned char **buf);
+	/**
+	 * Push data put in place in the span given by writeSpan().
+	 */
+	size_t commitWrite(size_t size);
+	/**
+	 * Get the contiguous data in stream buffer, it can be used in place
+	 * and then popped by commitRead() instead of being copied by read().
+	 */
+	size_t readSpan(unsigned char **buf);
+	/**
+	 * Pop data used in place in the span given by readSpan().
+	 */
+	size_t commitRead(size_t size);
+	/**
+	 * Account bytes written (positive change) or read (negative change).
+	 * Observer and the waiting side are notified in batches: once changes add up
+	 * to the threshold, the data crosses the threshold, stream buffer gets empty
+	 * or full, or the waiting side has what it waits for.
+	 */
+	void updateChange(ssize_t change);
+	/**
+	 * Notify the pending changes to observer and the waiting side.
+	 */
+	void flushChange();
+	/**
+	 * Wait until the writer has written data of the given size or set EOS.
+	 * Pending changes are notified before waiting, the lock must be held.
+	 */
+	void waitForData(std::unique_lock<std::mutex> &lock, size_t size);
+	/**
+	 * Wait until the reader has freed space of the given size.
+	 * Pending changes are notified before waiting, the lock must be held.
+	 */
+	void waitForSpace(std::unique_lock<std::mutex> &lock, size_t size);
 	/**
 	 * Get bytes of data available in stream buffer.
 	 */
@@ -114,6 +153,10 @@ private:
 	bool mEOS;
 	size_t mBufferSize;
 	size_t mThreshold;
+	size_t mPendingWritten;
+	size_t mPendingRead;
+	size_t mDataWanted;
+	size_t mSpaceWanted;
 };
 
 } // namespace stream
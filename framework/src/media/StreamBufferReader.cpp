@@ -53,7 +53,7 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 		while (rlen < size) {
 			// Read data from stream as much as possible
 			size_t temp = mStream->read(buf + rlen, size - rlen);
-			mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) temp));
+			mStream->updateChange(-((ssize_t) temp));
 			rlen += temp;
 			if (rlen < size) {
 				// There's not enough data
@@ -66,26 +66,50 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 				medvdbg("read %lu/%lu\n", rlen, size);
 				// Notify observer, shouldn't be blocked.
 				mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
-				// Writer may be waiting for more spaces, so it's necessary to notify after reading.
-				mStream->getCondv().notify_one();
 				// Then wait notification from writer.
-				mStream->getCondv().wait(lock);
+				mStream->waitForData(lock, size - rlen);
 			}
 		}
 
 		assert(rlen == size || mStream->isEndOfStream());
 	} else {
 		rlen = mStream->read(buf, size);
-		mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) rlen));
+		mStream->updateChange(-((ssize_t) rlen));
 	}
 
-	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
-	mStream->getCondv().notify_one();
-
 	medvdbg("read %lu\n", rlen);
 	return rlen;
 }
 
+size_t StreamBufferReader::acquire(unsigned char **buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = mStream->readSpan(buf);
+	while (sync && len == 0) {
+		if (mStream->isEndOfStream()) {
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		// Then wait notification from writer.
+		mStream->waitForData(lock, 1);
+		len = mStream->readSpan(buf);
+	}
+
+	return (len < size) ? len : size;
+}
+
+void StreamBufferReader::commit(size_t size)
+{
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	size_t rlen = mStream->commitRead(size);
+	mStream->updateChange(-((ssize_t) rlen));
+}
+
 size_t StreamBufferReader::sizeOfData()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
@@ -34,6 +34,16 @@ public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfData();
+	/**
+	 * Get a span of contiguous data in stream buffer, to use it in place without copying.
+	 * In sync mode it waits until there's data or EOS. Returns size of the span, at most
+	 * the given size, 0 means no data. The span stays valid until commit() pops it.
+	 */
+	virtual size_t acquire(unsigned char **buf, size_t size, bool sync = true);
+	/**
+	 * Pop data of the given size used in place, it must be within the acquired span.
+	 */
+	virtual void commit(size_t size);
 
 public:
 	bool isEndOfStream();
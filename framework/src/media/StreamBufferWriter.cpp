@@ -51,31 +51,54 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 
 			// Write data into stream as much as possible
 			size_t temp = mStream->write(buf + wlen, size - wlen);
-			mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) temp);
+			mStream->updateChange((ssize_t) temp);
 			wlen += temp;
 			if (wlen < size) {
 				medvdbg("written %lu/%lu\n", wlen, size);
 				// There's not enough space
 				// Notify observer, shouldn't be blocked.
 				mStream->notifyObserver(StreamBuffer::State::OVERRUN);
-				// Reader may be waiting for more data, so it's necessary to notify after writing.
-				mStream->getCondv().notify_one();
 				// Then wait notification from reader.
-				mStream->getCondv().wait(lock);
+				mStream->waitForSpace(lock, size - wlen);
 			}
 		}
 	} else {
 		wlen = mStream->write(buf, size);
-		mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) wlen);
+		mStream->updateChange((ssize_t) wlen);
 	}
 
-	// Reader may be waiting for more data, so it's necessary to notify after writing.
-	mStream->getCondv().notify_one();
-
 	medvdbg("written %lu\n", wlen);
 	return wlen;
 }
 
+size_t StreamBufferWriter::acquire(unsigned char **buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = 0;
+	while (!mStream->isEndOfStream()) {
+		len = mStream->writeSpan(buf);
+		if (len > 0 || !sync) {
+			break;
+		}
+
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		// Then wait notification from reader.
+		mStream->waitForSpace(lock, 1);
+	}
+
+	return (len < size) ? len : size;
+}
+
+void StreamBufferWriter::commit(size_t size)
+{
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	size_t wlen = mStream->commitWrite(size);
+	mStream->updateChange((ssize_t) wlen);
+}
+
 size_t StreamBufferWriter::sizeOfSpace()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
@@ -89,8 +112,8 @@ void StreamBufferWriter::setEndOfStream()
 	// Set EOS flag in stream.
 	mStream->setEndOfStream();
 
-	// Reader may be waiting for more data, so it's necessary to notify.
-	mStream->getCondv().notify_one();
+	// Reader may be waiting for more data, notify it with the pending changes.
+	mStream->flushChange();
 }
 
 } // namespace stream
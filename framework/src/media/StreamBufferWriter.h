@@ -33,6 +33,16 @@ public:
 public:
 	virtual size_t write(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfSpace();
+	/**
+	 * Get a span of contiguous free space in stream buffer, to fill it in place without copying.
+	 * In sync mode it waits until there's space or EOS. Returns size of the span, at most
+	 * the given size, 0 means no space or EOS. Fill the span and push it with commit().
+	 */
+	virtual size_t acquire(unsigned char **buf, size_t size, bool sync = true);
+	/**
+	 * Push data of the given size filled in place, it must be within the acquired span.
+	 */
+	virtual void commit(size_t size);
 
 public:
 	void setEndOfStream();
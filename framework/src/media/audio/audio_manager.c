@@ -187,6 +187,8 @@ static audio_manager_result_t get_supported_process_type(int card_id, int device
 static uint32_t get_closest_samprate(unsigned origin_samprate, audio_io_direction_t direct);
 static unsigned int resample_stream_in(audio_card_info_t *card, void *data, unsigned int frames);
 static unsigned int resample_stream_out(audio_card_info_t *card, void *data, unsigned int frames);
+static audio_manager_result_t setup_resample_stream_out(audio_card_info_t *card, unsigned int card_channels, unsigned int card_rate);
+static void release_resample(audio_card_info_t *card);
 static audio_manager_result_t get_audio_volume(audio_io_direction_t direct);
 static audio_manager_result_t set_audio_volume(audio_io_direction_t direct, uint8_t volume);
 
@@ -505,6 +507,71 @@ static unsigned int resample_stream_out(audio_card_info_t *card, void *data, uns
 	return resampled_frames;
 }
 
+/****************************************************************************
+ * Name: setup_resample_stream_out
+ *
+ * Description:
+ *   Prepare the resampler converting the user format, saved in card->resample,
+ *   to the format of the opened output pcm. Nothing is allocated if both are
+ *   the same.
+ ****************************************************************************/
+static audio_manager_result_t setup_resample_stream_out(audio_card_info_t *card, unsigned int card_channels, unsigned int card_rate)
+{
+	card->resample.necessary = false;
+
+	// Check if resampling is required
+	if ((card_channels != card->resample.user_channel) || (card_rate != card->resample.user_sample_rate)) {
+		// Yes, resampling is necessary, and it would be processed in src_simple().
+		card->resample.necessary = true;
+		card->resample.buffer = NULL;
+		card->resample.handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+		if (!card->resample.handle) {
+			meddbg("src_init failed\n");
+			card->resample.necessary = false;
+			return AUDIO_MANAGER_RESAMPLE_FAIL;
+		}
+
+		// Calculate the buffer size required for resampling.
+		float resample_buffer_frames = (float)get_output_frame_count();
+		card->resample.ratio = 1;
+		if (card_rate != card->resample.user_sample_rate) {
+			card->resample.ratio = (float)card_rate / (float)card->resample.user_sample_rate; // ratio = card / user
+			resample_buffer_frames *= card->resample.ratio;
+			if (resample_buffer_frames - (int)resample_buffer_frames > 0) {
+				resample_buffer_frames = (int)resample_buffer_frames + 1;
+			}
+			medvdbg("resampling ratio %f, frames %u -> %d\n", card->resample.ratio, get_output_frame_count(), (int)resample_buffer_frames);
+		}
+		card->resample.buffer_size = get_card_output_frames_to_byte((int)resample_buffer_frames);
+		card->resample.buffer = malloc(card->resample.buffer_size);
+		if (!card->resample.buffer) {
+			meddbg("malloc for a resampling buffer(stream_out) is failed, resample_buffer_frames = %d\n", (int)resample_buffer_frames);
+			src_destroy(card->resample.handle);
+			card->resample.handle = NULL;
+			card->resample.necessary = false;
+			return AUDIO_MANAGER_RESAMPLE_FAIL;
+		}
+		medvdbg("resampling buffer 0x%x, buffer_size %u\n", card->resample.buffer, card->resample.buffer_size);
+	}
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+static void release_resample(audio_card_info_t *card)
+{
+	if (card->resample.necessary) {
+		card->resample.necessary = false;
+		if (card->resample.buffer) {
+			free(card->resample.buffer);
+			card->resample.buffer = NULL;
+		}
+		if (card->resample.handle) {
+			src_destroy(card->resample.handle);
+			card->resample.handle = NULL;
+		}
+	}
+}
+
 static audio_manager_result_t get_audio_volume(audio_io_direction_t direct)
 {
 	audio_manager_result_t ret = AUDIO_MANAGER_SUCCESS;
@@ -797,44 +864,13 @@ audio_manager_result_t set_audio_stream_out(unsigned int channels, unsigned int
 		goto error_with_pcm;
 	}
 
-	card->resample.necessary = false;
 	card->resample.user_channel = channels;
 	card->resample.user_sample_rate = sample_rate;
 	card->resample.user_format = pcm_format_to_bits((enum pcm_format)format) >> 3;
 
-	// Check if resampling is required
-	if ((config.channels != card->resample.user_channel) || (config.rate != card->resample.user_sample_rate)) {
-		// Yes, resampling is necessary, and it would be processed in src_simple().
-		card->resample.necessary = true;
-		card->resample.buffer = NULL;
-		card->resample.handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
-		if (!card->resample.handle) {
-			meddbg("src_init failed\n");
-			ret = AUDIO_MANAGER_RESAMPLE_FAIL;
-			goto error_with_pcm;
-		}
-
-		// Calculate the buffer size required for resampling.
-		float resample_buffer_frames = (float)get_output_frame_count();
-		card->resample.ratio = 1;
-		if (config.rate != card->resample.user_sample_rate) {
-			card->resample.ratio = (float)config.rate / (float)card->resample.user_sample_rate; // ratio = card / user
-			resample_buffer_frames *= card->resample.ratio;
-			if (resample_buffer_frames - (int)resample_buffer_frames > 0) {
-				resample_buffer_frames = (int)resample_buffer_frames + 1;
-			}
-			medvdbg("resampling ratio %f, frames %u -> %d\n", card->resample.ratio, get_output_frame_count(), (int)resample_buffer_frames);
-		}
-		card->resample.buffer_size = get_card_output_frames_to_byte((int)resample_buffer_frames);
-		card->resample.buffer = malloc(card->resample.buffer_size);
-		if (!card->resample.buffer) {
-			meddbg("malloc for a resampling buffer(stream_out) is failed, resample_buffer_frames = %d\n", (int)resample_buffer_frames);
-			ret = AUDIO_MANAGER_RESAMPLE_FAIL;
-			src_destroy(card->resample.handle);
-			card->resample.handle = NULL;
-			goto error_with_pcm;
-		}
-		medvdbg("resampling buffer 0x%x, buffer_size %u\n", card->resample.buffer, card->resample.buffer_size);
+	ret = setup_resample_stream_out(card, config.channels, config.rate);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		goto error_with_pcm;
 	}
 
 	card_config->status = AUDIO_CARD_READY;
@@ -847,6 +883,62 @@ error_with_pcm:
 	return ret;
 }
 
+audio_manager_result_t change_audio_stream_out(unsigned int channels, unsigned int sample_rate, int format)
+{
+	audio_card_info_t *card;
+	audio_config_t *card_config;
+	audio_manager_result_t ret = AUDIO_MANAGER_SUCCESS;
+	unsigned int card_channels;
+	unsigned int card_rate;
+
+	if ((channels == 0) || (sample_rate == 0)) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	if (g_actual_audio_out_card_id < 0) {
+		meddbg("Found no active output audio card\n");
+		return AUDIO_MANAGER_NO_AVAIL_CARD;
+	}
+
+	card = &g_audio_out_cards[g_actual_audio_out_card_id];
+	card_config = &card->config[card->device_id];
+
+	if ((card_config->status == AUDIO_CARD_IDLE) || (card_config->status == AUDIO_CARD_NONE)) {
+		meddbg("Card status is wrong status : %d\n", card_config->status);
+		return AUDIO_MANAGER_INVALID_DEVICE;
+	}
+
+	pthread_mutex_lock(&(card->card_mutex));
+
+	card_channels = pcm_get_channels(card->pcm);
+	card_rate = pcm_get_rate(card->pcm);
+
+	if ((card->resample.user_channel == channels) && (card->resample.user_sample_rate == sample_rate) && (pcm_get_format(card->pcm) == (enum pcm_format)format)) {
+		medvdbg("[OUT] Stream format is not changed\n");
+		goto done;
+	}
+
+	// Only the sample rate and the channels can be converted without reopening the pcm
+	if ((pcm_get_format(card->pcm) != (enum pcm_format)format) || !src_is_valid_ratio((float)card_rate / (float)sample_rate)) {
+		meddbg("[OUT] Cannot convert to the opened device, rate %u -> %u\n", sample_rate, card_rate);
+		ret = AUDIO_MANAGER_DEVICE_NOT_SUPPORT;
+		goto done;
+	}
+
+	medvdbg("[OUT] Device samplerate: %u, User requested: %u\n", card_rate, sample_rate);
+	medvdbg("[OUT] Device channel: %u, User requested: %u\n", card_channels, channels);
+	release_resample(card);
+	card->resample.user_channel = channels;
+	card->resample.user_sample_rate = sample_rate;
+	card->resample.user_format = pcm_format_to_bits((enum pcm_format)format) >> 3;
+
+	ret = setup_resample_stream_out(card, card_channels, card_rate);
+
+done:
+	pthread_mutex_unlock(&(card->card_mutex));
+	return ret;
+}
+
 int start_audio_stream_in(void *data, unsigned int frames)
 {
 	int ret = 0;
@@ -1189,17 +1281,7 @@ audio_manager_result_t reset_audio_stream_out(void)
 	pcm_close(card->pcm);
 	card->pcm = NULL;
 
-	if (card->resample.necessary) {
-		card->resample.necessary = false;
-		if (card->resample.buffer) {
-			free(card->resample.buffer);
-			card->resample.buffer = NULL;
-		}
-		if (card->resample.handle) {
-			src_destroy(card->resample.handle);
-			card->resample.handle = NULL;
-		}
-	}
+	release_resample(card);
 
 	card->config[card->device_id].status = AUDIO_CARD_IDLE;
 	card->policy = STREAM_TYPE_MEDIA;
@@ -142,6 +142,27 @@ audio_manager_result_t set_audio_stream_in(unsigned int channels, unsigned int s
  ****************************************************************************/
 audio_manager_result_t set_audio_stream_out(unsigned int channels, unsigned int sample_rate, int format);
 
+/****************************************************************************
+ * Name: change_audio_stream_out
+ *
+ * Description:
+ *   Change the format of the stream written to the output stream prepared by
+ *   set_audio_stream_out(), without closing the pcm. The frames written after
+ *   the call are resampled to the rate and channels of the opened device, so
+ *   that the stream continues without a gap.
+ *
+ * Input parameters:
+ *   channels: number of channels
+ *   sample_rate: sample rate of the following frames
+ *   format: audio format of the following frames
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. AUDIO_MANAGER_DEVICE_NOT_SUPPORT if the
+ *   stream cannot be converted to the opened device, then it should be reset
+ *   and set again. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t change_audio_stream_out(unsigned int channels, unsigned int sample_rate, int format);
+
 /****************************************************************************
  * Name: start_audio_stream_in
  *
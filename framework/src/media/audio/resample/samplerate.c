@@ -36,48 +36,40 @@
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
-// Range of ratio supported for sample rate conversion
-#define SRC_MAX_RATIO   ((float)3)
+// Range of ratio supported for sample rate conversion, e.g. 8K <-> 48K
+#define SRC_MAX_RATIO   ((float)6)
 #define SRC_MIN_RATIO   ((float)1 / SRC_MAX_RATIO)
 
 #define MAXIMUM(a, b)   (((a) > (b)) ? (a) : (b))
 #define MINIMUM(a, b)   (((a) < (b)) ? (a) : (b))
 
-// Fraction part bits
-#define FRACBITS            (16)
-
-// Convert to 16.16 fixed point value
-#define TO_16_16_FIXED(x)   ((uint32_t)((float)(x) * (float)(1 << FRACBITS) + 0.5f))
-
-// Int part value: 16.0 fixed point
-#define INTPART_VALUE(x)    ((x) >> FRACBITS)
-
-// Fraction part value: 0.16 fixed point
-#define FRACPART_VALUE(x)   ((x) & 0xffff)
-
-// Calculate new sample data
-#define CALC_NEW_SAMPLE(s1, s2, part) ((s1) + INTPART_VALUE(((s2) - (s1)) * (int32_t)(part)))
-
 // Convert sample width in bytes
 #define BYTES_PER_SAMPLE(bits_per_sample)   ((bits_per_sample) >> 3)
 
-// Round the given positive float number to the nearest integer
-#define LRINTPF(pf) ((long)((float)(pf) + 0.5f))
+// Max channel num supported for SRC output and input
+#define SRC_MAX_CH      (2)
+#define SRC_MAX_IN_CH   (6)
+
+// Taps of each filter phase for up resampling, multiplied by ceil(down ratio) for down resampling
+#define SRC_BASE_TAPS   (16)
 
-// Max channel num supported for SRC
-#define SRC_MAX_CH  (2)
+// Max number of filter phases, positions between them are rounded to the nearest phase
+#define SRC_MAX_PHASES  (128)
 
-// Down resample ratio for 44.1k->32k, 22.05k->16k and 11.025k->8k
-#define DOWN_RESAMPLE_441_320_RATIO ((float)441 / (float)320)
+// Max number of filter coefficients of all phases
+#define SRC_MAX_COEFFS  (4096)
 
-#define FLOAT_ACCURACY      (0.000001f)
-#define FLOAT_EQUAL(a, b)   (fabsf((a)-(b)) < FLOAT_ACCURACY)
+// Passband edge, relative to the lower Nyquist frequency of the two sample rates
+#define SRC_CUTOFF      (0.9f)
 
-#define NUM_COEFF_22KHZ (sizeof(filter_22khz_coeff) / sizeof(filter_22khz_coeff[0]))
-#define OVERLAP_22KHZ   (NUM_COEFF_22KHZ - 2)
+#define PI_F            (3.14159265358979f)
 
-// At least remain one frame (one sample for each channel)
-#define OVERLAP_DEFAULT (1)
+// Filter coefficients are Q15 fixed point values
+#define Q15_SHIFT       (15)
+#define Q15_ONE         (1 << Q15_SHIFT)
+
+// Round the given float number to the nearest integer
+#define LRINTF(f)       ((int32_t)floorf((float)(f) + 0.5f))
 
 #define RETURN_VAL_IF_FAIL(condition, val) \
 	do { \
@@ -88,11 +80,13 @@
 
 // Count bytes of the given frames
 #define OLD_FRAMES_TO_BYTES(src, frames) ((frames) * (src)->old_channel_num * BYTES_PER_SAMPLE((src)->old_sample_width))
-#define NEW_FRAMES_TO_BYTES(src, frames) ((frames) * (src)->new_channel_num * BYTES_PER_SAMPLE((src)->new_sample_width))
 
 // Check src context initialized or not
 #define CHECK_SRC_CONTEXT_INIT(src) ((src)->in_buffer != NULL)
 
+// Internal buffer row of the given output channel
+#define CHANNEL_ROW(src, ch) ((src)->in_buffer + (ch) * (src)->in_buffer_frames)
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -100,81 +94,49 @@
  * @structure src_context_s: main structure used for SRC, it contains context
  *            variables used between src_simple() calls.
  * @brief It's internal structure, user can only get the handler via src_init().
+ *        The ratio is reduced to up/down. Each output frame is a dot product of
+ *        the last taps input frames with one phase of a windowed sinc filter,
+ *        the phase being the position of the output frame between two input frames.
  */
 struct src_context_s {
-	int16_t *in_buffer;     // pointer to the internal input buffer allocated
-	int16_t *out_buffer;    // pointer to the external output buffer assigned
-	int in_buffer_bytes;    // internal input buffer capability in bytes
-	int in_buffer_frames;   // internal input buffer capability in frames
-	int left_frames;        // number of frames remained in internal input buffer
-	int used_frames;        // number of frames used in internal input buffer
+	int16_t *in_buffer;     // pointer to the internal input buffer allocated, one row per output channel
+	int in_buffer_bytes;    // internal input buffer capability in bytes of input frames
+	int in_buffer_frames;   // capability of each row in frames
+	int left_frames;        // number of frames remained in each row
 	int old_channel_num;    // memorize old channel number
 	int new_channel_num;    // memorize new channel number
 	int old_sample_rate;    // memorize old sample rate
 	int new_sample_rate;    // memorize new sample rate
 	int old_sample_width;   // memorize old sample width(format)
 	int new_sample_width;   // memorize new sample width(format)
-	const int *filter_coeff;// pointer to filter coefficient array
-	int overlap_frames;     // number of overlap frames reserved in internal buffer
-	float ratio;            // (float)new_sample_rate / (float)old_sample_rate
-	float inverse_ratio;    // (float)old_sample_rate / (float)new_sample_rate
-	uint32_t fp_frac;       // fraction part value of last fixed point index
-	/**
-	 * @brief   Function pointer to resampling process function
-	 * @param   src_context_t *: pointer to resampler object.
-	 * @param   int32_t *: give number of frames available for converting
-	 *                     and retrieve number of frames used actually.
-	 * @return  number of frames generated
-	 */
-	int32_t (*src_func)(struct src_context_s *, int32_t *);
+	int16_t *filter_coeff;  // Q15 coefficients of (phases + 1) phases, taps per phase in time order
+	int taps;               // number of coefficients per phase
+	int phases;             // number of phases between two input frames
+	uint32_t up;            // reduced new sample rate
+	uint32_t down;          // reduced old sample rate
+	int position;           // row index of the newest input frame for next output frame
+	uint32_t phase;         // position of next output frame after it, in 1/up frames
+	int16_t remix[SRC_MAX_CH * SRC_MAX_IN_CH]; // Q14 remix gains, see remix_matrix()
 };
 
 typedef struct src_context_s src_context_t;
 
-/**
- * 16.16 fixed point FIR filter coefficients for conversion 44100 -> 22050.
- * (Works equivalently for 22010 -> 11025 or any other halving, of course.)
- */
-static const int32_t filter_22khz_coeff[] = {
-	2089257, 2898328, -5820678, -10484531,
-	19038724, 30542725, -50469415, -81505260,
-	152544464, 478517512, 478517512, 152544464,
-	-81505260, -50469415, 30542725, 19038724,
-	-10484531, -5820678, 2898328, 2089257,
-};
-
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
-/**
- * @brief   Do convolution calculation for sample data
- * @remarks FIR: Finite Impulse Response
- * @param   input: pointer to input samples buffer.
- * @param   coeff: pointer to coefficient array for convolution.
- * @param   num_samples: num of coefficients in array.
- * @param   channels_num: num of channels of input samples.
- * @return  value of convolution result.
- * @see
- */
-static int32_t fir_convolve(const int16_t *input, const int32_t *coeff, int32_t num_samples, int32_t channels_num)
-{
-	int32_t sum = 1 << 13;
-	int32_t i;
-	for (i = 0; i < num_samples; ++i) {
-		sum += input[i * channels_num] * (coeff[i] >> 16);
-	}
-	return sum >> 14;
-}
-
 /**
  * @brief   Clip an integer value (32 bits) to a signed short type value(16 bits)
  * @remarks int16_t value in range [INT16_MIN, INT16_MAX], which is defined in <stdint.h>
  * @param   x: input 32 bits integer value.
  * @return  output 16 bits signed short value.
  */
-static int16_t clip(int32_t x)
+static inline int16_t clip(int32_t x)
 {
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+	__asm__("ssat %0, #16, %1" : "=r"(x) : "r"(x));
+	return (int16_t)x;
+#else
 	if (x < INT16_MIN) {
 		return INT16_MIN;
 	} else if (x > INT16_MAX) {
@@ -182,91 +144,166 @@ static int16_t clip(int32_t x)
 	}
 
 	return x;
+#endif
 }
 
 /**
- * It handles sample rate up scaling in all ratio cases (i.e. inverse ratio 0.*)
- * and sample rate down scaling cases in inverse ratio 1.* and 2.* with fraction.
+ * @brief   Do convolution calculation for sample data
+ * @remarks FIR: Finite Impulse Response. With DSP extension (Cortex-M4/M7/M33),
+ *          two samples are multiplied and accumulated in one SMLAD instruction.
+ * @param   input: pointer to the oldest input sample.
+ * @param   coeff: pointer to Q15 coefficients, 4 bytes aligned.
+ * @param   taps: num of coefficients, it must be even.
+ * @return  value of convolution result.
  */
-static int32_t resample_frac(src_context_t *src, int32_t *num_frames_in)
+static inline int32_t fir_convolve(const int16_t *input, const int16_t *coeff, int32_t taps)
 {
-	int32_t num_frames_out = (int32_t)((float)*num_frames_in * src->ratio);
-	const int16_t *input = src->in_buffer;
-	int16_t *output = src->out_buffer;
-	int32_t channels_num = src->new_channel_num;
-	uint32_t step = TO_16_16_FIXED(src->inverse_ratio);
-	uint32_t fp_index = src->fp_frac;
-	uint32_t whole, frac;
-	int32_t i, j, s1, s2;
-
-	for (i = 0; i < num_frames_out; ++i, fp_index += step) {
-		whole = INTPART_VALUE(fp_index);
-		frac = FRACPART_VALUE(fp_index);
-		for (j = 0; j < channels_num; j++) {
-			s1 = input[whole * channels_num + j];
-			s2 = input[(whole + 1) * channels_num + j];
-			*output++ = clip(CALC_NEW_SAMPLE(s1, s2, frac));
-		}
+	int32_t sum = 1 << (Q15_SHIFT - 1);
+	int32_t i;
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+	uint32_t in2, coeff2;
+	for (i = 0; i < taps; i += 2) {
+		// Input rows are not aligned, unaligned word loads are fine on ARMv7E-M
+		memcpy(&in2, input + i, sizeof(in2));
+		memcpy(&coeff2, coeff + i, sizeof(coeff2));
+		__asm__("smlad %0, %1, %2, %0" : "+r"(sum) : "r"(in2), "r"(coeff2));
 	}
+#else
+	for (i = 0; i < taps; i += 2) {
+		sum += (int32_t)input[i] * coeff[i];
+		sum += (int32_t)input[i + 1] * coeff[i + 1];
+	}
+#endif
+
+	return sum >> Q15_SHIFT;
+}
 
-	*num_frames_in = INTPART_VALUE(fp_index);
-	src->fp_frac = FRACPART_VALUE(fp_index);;
-	return num_frames_out;
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+	uint32_t t;
+	while (b != 0) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
 }
 
 /**
- * It handles sample rate down scaling cases in inverse ratio 2.0 and 3.0 without fraction.
- * This function has same logic as resample_frac(), that means resample_frac() also works,
- * but downresample_int() is more efficient in special inverse ratio 2.0 and 3.0 cases.
- * Optimization: The fraction value of fp_index is always 0, so remove unnecessary calculation.
+ * @brief   Build the polyphase filter table, it's the only place float math used.
+ * @remarks Phase q holds the Blackman windowed sinc sampled at taps input frames
+ *          around the point q/phases frames after the newest one minus taps/2.
+ *          Each phase is normalized to unity DC gain after rounding to Q15.
+ *          An extra phase equal to 1.0 lets positions round up without moving rows.
+ * @param   src: pointer to resampler object.
+ * @return  0 on success, negative value means failure.
  */
-static int32_t downresample_int(src_context_t *src, int32_t *num_frames_in)
+static int init_filter(src_context_t *src)
 {
-	int32_t quotient = (int32_t)src->inverse_ratio;
-	*num_frames_in = *num_frames_in / quotient * quotient;
-	int32_t num_frames_out = *num_frames_in / quotient;
-
-	const int16_t *input = src->in_buffer;
-	int16_t *output = src->out_buffer;
-	int32_t channels_num = src->new_channel_num;
-	uint32_t step = TO_16_16_FIXED(quotient);
-	uint32_t fp_index = 0;
-	uint32_t whole;
-	int32_t i, j;
-
-	for (i = 0; i < num_frames_out; ++i, fp_index += step) {
-		whole = INTPART_VALUE(fp_index);
-		for (j = 0; j < channels_num; j++) {
-			*output++ = input[whole * channels_num + j];
+	uint32_t divisor = gcd(src->old_sample_rate, src->new_sample_rate);
+	src->up = src->new_sample_rate / divisor;
+	src->down = src->old_sample_rate / divisor;
+	src->taps = SRC_BASE_TAPS * ((src->down + src->up - 1) / src->up);
+	src->phases = MINIMUM(MINIMUM(src->up, SRC_MAX_PHASES), SRC_MAX_COEFFS / src->taps - 1);
+
+	src->filter_coeff = (int16_t *)malloc((src->phases + 1) * src->taps * sizeof(int16_t));
+	RETURN_VAL_IF_FAIL((src->filter_coeff != NULL), SRC_ERR_MALLOC_FAILED);
+
+	float cutoff = SRC_CUTOFF * MINIMUM(1.0f, (float)src->up / (float)src->down);
+	float half = (float)src->taps / 2;
+	float coeff[src->taps];
+	int q, i;
+
+	for (q = 0; q <= src->phases; q++) {
+		int16_t *row = &src->filter_coeff[q * src->taps];
+		float sum = 0;
+		for (i = 0; i < src->taps; i++) {
+			// Distance to the output point in input frames, in (-taps/2, taps/2]
+			float d = (float)(i + 1) - half - (float)q / src->phases;
+			float x = cutoff * d;
+			float w = (d + half) / src->taps;
+			w = 0.42f - 0.5f * cosf(2 * PI_F * w) + 0.08f * cosf(4 * PI_F * w);
+			coeff[i] = ((x == 0) ? 1.0f : sinf(PI_F * x) / (PI_F * x)) * w;
+			sum += coeff[i];
+		}
+
+		int32_t total = 0;
+		for (i = 0; i < src->taps; i++) {
+			row[i] = LRINTF(coeff[i] / sum * Q15_ONE);
+			total += row[i];
 		}
+		row[src->taps / 2 - 1] += Q15_ONE - total;
 	}
 
-	return num_frames_out;
+	return SRC_ERR_NO_ERROR;
+}
+
+/**
+ * @brief   Append input frames to internal buffer rows, remixing them in the same pass.
+ * @param   src: pointer to resampler object.
+ * @param   input: pointer to interleaved input frames.
+ * @param   frames: number of input frames.
+ */
+static void append_frames(src_context_t *src, const int16_t *input, int32_t frames)
+{
+	int32_t in_ch = src->old_channel_num;
+	int32_t ch, i, k;
+
+	for (ch = 0; ch < src->new_channel_num; ch++) {
+		const int16_t *gain = &src->remix[ch * in_ch];
+		const int16_t *frame = input;
+		int16_t *row = CHANNEL_ROW(src, ch) + src->left_frames;
+		for (i = 0; i < frames; i++, frame += in_ch) {
+			int32_t sum = 1 << (REMIX_GAIN_SHIFT - 1);
+			for (k = 0; k < in_ch; k++) {
+				sum += (int32_t)frame[k] * gain[k];
+			}
+			row[i] = clip(sum >> REMIX_GAIN_SHIFT);
+		}
+	}
+	src->left_frames += frames;
 }
 
 /**
- * @brief   Do filtering once new frames added to internal buffer.
+ * @brief   Generate output frames from the buffered input frames.
  * @param   src: pointer to resampler object.
- * @param   num_frames_add: number of frames added
+ * @param   output: pointer to interleaved output frames.
+ * @param   max_frames: capability of output in frames.
+ * @return  number of frames generated
  */
-static void convolution_filtering(src_context_t *src, int32_t num_frames_add)
+static int32_t resample(src_context_t *src, int16_t *output, int32_t max_frames)
 {
-	if ((src->filter_coeff != NULL) && (src->left_frames > src->overlap_frames)) {
-		int16_t *input;
-		int32_t samples;
-		if (src->left_frames == num_frames_add) {
-			input = src->in_buffer;
-			samples = (num_frames_add - src->overlap_frames) * src->new_channel_num;
-		} else {
-			input = src->in_buffer + src->left_frames - num_frames_add - src->overlap_frames;
-			samples = num_frames_add * src->new_channel_num;
+	int32_t frames = 0;
+	int32_t ch;
+
+	while ((frames < max_frames) && (src->position < src->left_frames)) {
+		uint32_t q = (src->phase * src->phases + src->up / 2) / src->up;
+		const int16_t *coeff = &src->filter_coeff[q * src->taps];
+		int32_t oldest = src->position - src->taps + 1;
+		for (ch = 0; ch < src->new_channel_num; ch++) {
+			*output++ = clip(fir_convolve(CHANNEL_ROW(src, ch) + oldest, coeff, src->taps));
 		}
+		frames++;
 
-		int32_t i;
-		for (i = 0; i < samples; ++i) {
-			input[i] = fir_convolve(input + i, src->filter_coeff, src->overlap_frames, src->new_channel_num);
+		src->phase += src->down;
+		while (src->phase >= src->up) {
+			src->phase -= src->up;
+			src->position++;
 		}
 	}
+
+	// Drop the frames no longer under the filter
+	int32_t drop = MINIMUM(src->position - (src->taps - 1), src->left_frames);
+	if (drop > 0) {
+		src->left_frames -= drop;
+		src->position -= drop;
+		for (ch = 0; ch < src->new_channel_num; ch++) {
+			memmove(CHANNEL_ROW(src, ch), CHANNEL_ROW(src, ch) + drop, src->left_frames * sizeof(int16_t));
+		}
+	}
+
+	return frames;
 }
 
 /**
@@ -282,13 +319,14 @@ static int check_src_data(src_context_t *src, src_data_t *src_data)
 
 	if (!CHECK_SRC_CONTEXT_INIT(src)) {
 		// Check supported converting ratio
+		RETURN_VAL_IF_FAIL(((src_data->origin_sample_rate > 0) && (src_data->desired_sample_rate > 0)), SRC_ERR_BAD_SRC_RATIO);
 		if (!src_is_valid_ratio((float)src_data->desired_sample_rate / (float)src_data->origin_sample_rate)) {
 			return SRC_ERR_BAD_SRC_RATIO;
 		}
 		// Check supported input multichannels number: 1-Mono/.../6-5.1 Stereo
-		RETURN_VAL_IF_FAIL(((src_data->origin_channel_num >= 1) && (src_data->origin_channel_num <= 6)), SRC_ERR_BAD_CHANNEL_COUNT);
+		RETURN_VAL_IF_FAIL(((src_data->origin_channel_num >= 1) && (src_data->origin_channel_num <= SRC_MAX_IN_CH)), SRC_ERR_BAD_CHANNEL_COUNT);
 		// Check supported output channel: 1-Mono/2-Stereo
-		RETURN_VAL_IF_FAIL(((src_data->desired_channel_num == 1) || (src_data->desired_channel_num == 2)), SRC_ERR_BAD_CHANNEL_COUNT);
+		RETURN_VAL_IF_FAIL(((src_data->desired_channel_num == 1) || (src_data->desired_channel_num == SRC_MAX_CH)), SRC_ERR_BAD_CHANNEL_COUNT);
 		// Check supported sample width: SAMPLE_WIDTH_16BITS
 		RETURN_VAL_IF_FAIL((src_data->origin_sample_width == SAMPLE_WIDTH_16BITS), SRC_ERR_NOT_SUPPORT);
 		// Check supported format conversion: Not support!
@@ -314,51 +352,35 @@ static int check_src_data(src_context_t *src, src_data_t *src_data)
  */
 static int init_src_context(src_context_t *src, src_data_t *src_data)
 {
-	// Allocate internal buffer
-	src->in_buffer = (int16_t *)malloc(src->in_buffer_bytes);
-	RETURN_VAL_IF_FAIL((src->in_buffer != NULL), SRC_ERR_MALLOC_FAILED);
-
-	// Initialize other members
 	src->old_channel_num = src_data->origin_channel_num;
 	src->new_channel_num = src_data->desired_channel_num;
 	src->old_sample_width = src_data->origin_sample_width;
 	src->new_sample_width = src_data->desired_sample_width;
 	src->old_sample_rate = src_data->origin_sample_rate;
 	src->new_sample_rate = src_data->desired_sample_rate;
-	src->in_buffer_frames = src->in_buffer_bytes / OLD_FRAMES_TO_BYTES(src, 1);
-	src->left_frames = 0;
-	src->used_frames = 0;
-	src->fp_frac = 0;
-
-	// Calculate converting ratio for later use
-	src->ratio = (float)src->new_sample_rate / (float)src->old_sample_rate;
-	src->inverse_ratio = (float)src->old_sample_rate / (float)src->new_sample_rate;
-
-	// Set overlap frame number and converting function as per converting ratio
-	if (src->old_sample_rate > src->new_sample_rate) {
-		// down resampling
-		if (src->old_sample_rate % src->new_sample_rate == 0) {
-			// inverse ratio 2.0/3.0 cases. e.g. 48K->16K, 48K->24K, 44.1K->22.05K, ...
-			src->filter_coeff = filter_22khz_coeff;
-			src->overlap_frames = OVERLAP_22KHZ;
-			src->src_func = downresample_int;
-		} else if ((int)src->inverse_ratio >= 2) {
-			// inverse ratio 2.* cases. e.g. 48K->22.05K, 44.1K->16K, 24K->11.025K, ...
-			src->filter_coeff = filter_22khz_coeff;
-			src->overlap_frames = OVERLAP_22KHZ;
-			src->src_func = resample_frac;
-		} else {
-			// inverse ratio 1.* cases. e.g. 48K->44.1K, 44.1K->32K, 44.1K->24K, ...
-			src->filter_coeff = NULL;
-			src->overlap_frames = OVERLAP_DEFAULT;
-			src->src_func = resample_frac;
-		}
-	} else {
-		// up resampling
+
+	// Remix gains applied while appending input frames
+	RETURN_VAL_IF_FAIL((remix_matrix(ch2layout(src->old_channel_num), ch2layout(src->new_channel_num), src->remix) == 0), SRC_ERR_BAD_CHANNEL_COUNT);
+
+	int ret = init_filter(src);
+	RETURN_VAL_IF_FAIL((ret == SRC_ERR_NO_ERROR), ret);
+
+	// Allocate internal buffer, each row keeps taps - 1 history frames besides input frames
+	src->in_buffer_frames = src->in_buffer_bytes / OLD_FRAMES_TO_BYTES(src, 1) + src->taps;
+	src->in_buffer = (int16_t *)malloc(src->new_channel_num * src->in_buffer_frames * sizeof(int16_t));
+	if (src->in_buffer == NULL) {
+		free(src->filter_coeff);
 		src->filter_coeff = NULL;
-		src->overlap_frames = OVERLAP_DEFAULT;
-		src->src_func = resample_frac;
-		// TODO: Noises appeared in ratio 2.* cases, consider fir-filtering after converting process
+		return SRC_ERR_MALLOC_FAILED;
+	}
+
+	// Start with silence history, the first output frame is at the first input frame minus taps/2
+	src->left_frames = src->taps - 1;
+	src->position = src->taps - 1;
+	src->phase = 0;
+	int ch;
+	for (ch = 0; ch < src->new_channel_num; ch++) {
+		memset(CHANNEL_ROW(src, ch), 0, src->left_frames * sizeof(int16_t));
 	}
 
 	return SRC_ERR_NO_ERROR;
@@ -378,6 +400,7 @@ src_handle_t src_init(int size)
 	src->in_buffer_bytes = (((size + max_frame_size - 1) / max_frame_size) * max_frame_size);
 	src->in_buffer_frames = 0;
 	src->in_buffer = NULL;
+	src->filter_coeff = NULL;
 	// Other members will be initilized before first use,
 	// as soon as in_buffer allocated in init_src_context().
 
@@ -391,6 +414,8 @@ int src_destroy(src_handle_t handle)
 
 	free(src->in_buffer);
 	src->in_buffer = NULL;
+	free(src->filter_coeff);
+	src->filter_coeff = NULL;
 
 	free(src);
 	return SRC_ERR_NO_ERROR;
@@ -437,49 +462,17 @@ int src_simple(src_handle_t handle, src_data_t *src_data)
 	if (!CHECK_SRC_CONTEXT_INIT(src)) {
 		ret = init_src_context(src, src_data);
 		RETURN_VAL_IF_FAIL((ret == SRC_ERR_NO_ERROR), ret);
-		RETURN_VAL_IF_FAIL((src->src_func != NULL), SRC_ERR_UNKNOWN);
-	}
-
-	// Update output buffer to src context (used in converting proccess functions)
-	src->out_buffer = (int16_t *)src_data->data_out;
-
-	// Move remaining frames in internal buffer
-	if ((src->used_frames > 0) && (src->left_frames > 0)) {
-		memcpy((void *)src->in_buffer, \
-			(const void *)((int8_t *)src->in_buffer + NEW_FRAMES_TO_BYTES(src, src->used_frames)), \
-			NEW_FRAMES_TO_BYTES(src, src->left_frames));
-		src->used_frames = 0;
 	}
 
-	// Accept input frames as much as possible, append (rechannel/copy) input frames to internal buffer
+	// Accept input frames as much as possible, remix them into internal buffer
 	int input_frames_used = MINIMUM(src_data->input_frames, (src->in_buffer_frames - src->left_frames));
-	frames = rechannel(ch2layout(src->old_channel_num), ch2layout(src->new_channel_num), \
-					(const int16_t *)src_data->data_in, input_frames_used, \
-					(int16_t *)((int8_t *)src->in_buffer + NEW_FRAMES_TO_BYTES(src, src->left_frames)), input_frames_used);
-	RETURN_VAL_IF_FAIL((frames == input_frames_used), SRC_ERR_UNKNOWN);
-	src->left_frames += input_frames_used;
-
-	// Filtering on new appended frames
-	convolution_filtering(src, input_frames_used);
-
-	// Calculate how many input frames needed if fill up out buffer
-	float input_frames_need = (float)out_buffer_frames / src->ratio;
-	if (input_frames_need - (int)input_frames_need > 0) {
-		input_frames_need = (int)input_frames_need + 1;
-	}
-
-	int output_frames_gen = 0;
-	// Reserve overlap frames, then do converting process with available frames
-	frames = MINIMUM(src->left_frames - src->overlap_frames, (int)input_frames_need);
-	if (frames > 0) {
-		output_frames_gen = src->src_func(src, &frames);
-		if (output_frames_gen != 0) {
-			src->used_frames = frames;
-			src->left_frames -= frames;
-		}
+	if (input_frames_used > 0) {
+		append_frames(src, (const int16_t *)src_data->data_in, input_frames_used);
+	} else {
+		input_frames_used = 0;
 	}
 
 	src_data->input_frames_used = input_frames_used;
-	src_data->output_frames_gen = output_frames_gen;
+	src_data->output_frames_gen = resample(src, (int16_t *)src_data->data_out, out_buffer_frames);
 	return SRC_ERR_NO_ERROR;
 }
@@ -139,8 +139,8 @@ int src_destroy(src_handle_t handle);
  * @brief   Check if the conversion ratio is valid or not.
  * @remarks To provide high quality SRC, conversion ratio is limited in a range.
  * @param   ratio: calculating formula is original_samplerate/target_samplerate.
- *          currently, ratio in range [1/3, 3] is valid, it may be changed in future.
- *          so, e.g. it's not possible to resample from 48KHz to 8KHz.
+ *          currently, ratio in range [1/6, 6] is valid, it may be changed in future.
+ *          so, e.g. it's possible to resample from 48KHz to 8KHz, but not to 7.35KHz.
  * @return  true if it's valid, otherwise, returns false.
  * @see
  */
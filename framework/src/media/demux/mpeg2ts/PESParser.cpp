@@ -17,18 +17,26 @@
  ******************************************************************/
 
 #include <debug.h>
+#include <string.h>
 #include "Mpeg2TsTypes.h"
 #include "PESParser.h"
-#include "PESPacket.h"
 
 #define PES_PACKET_HEAD_BYTES               (6) // packet_start_code_prefix + stream_id + packet length fields
 #define PES_STREAM_HEAD_BYTES               (3) // stream info + 7 flags + PES head data length fields
 #define PACKET_START_CODE_PREFIX(buffer)    ((buffer[0] << 16) | (buffer[1] << 8) | buffer[2])
 #define STREAM_ID(buffer)                   (buffer[3])
 #define PACKET_LENGTH(buffer)               ((buffer[4] << 8) | buffer[5])
+#define PES_HEADER_DATA_LENGTH(buffer)      (buffer[8])
+#define CONTINUITY_COUNTER_MOD              (16) // Continuity counter's module value
 
 PESParser::PESParser()
-	: mPacketStartCodePrefix(0)
+	: mState(STATE_WAIT_START)
+	, mContinuityCounter(0)
+	, mHeaderLen(0)
+	, mHeaderNeed(0)
+	, mESRemaining(0)
+	, mUnbounded(false)
+	, mPacketStartCodePrefix(0)
 	, mStreamId(0)
 	, mPacketLength(0)
 {
@@ -38,37 +46,102 @@ PESParser::~PESParser()
 {
 }
 
-bool PESParser::parse(std::shared_ptr<PESPacket> pPESPacket)
+bool PESParser::parse(bool unitStart, uint8_t continuityCounter, uint8_t *pData, uint16_t size, uint8_t **esData, uint16_t *esDataLen)
 {
-	if (!pPESPacket) {
-		meddbg("pPESPacket is null!\n");
+	*esData = nullptr;
+	*esDataLen = 0;
+
+	if (unitStart) {
+		if (mState == STATE_PAYLOAD && !mUnbounded && mESRemaining != 0) {
+			meddbg("PES packet is incomplete, %u bytes lost!\n", mESRemaining);
+		}
+		// new PES packet start
+		mState = STATE_HEADER;
+		mHeaderLen = 0;
+		mHeaderNeed = PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES;
+	} else if (mState == STATE_WAIT_START) {
+		// wait for the start of next PES packet
+		return false;
+	} else if (continuityCounter != ((mContinuityCounter + 1) % CONTINUITY_COUNTER_MOD)) {
+		meddbg("continuity counter(0x%x) do not match, current 0x%x\n", continuityCounter, mContinuityCounter);
 		reset();
 		return false;
 	}
+	mContinuityCounter = continuityCounter;
+
+	while (mState == STATE_HEADER) {
+		uint16_t len = mHeaderNeed - mHeaderLen;
+		if (len > size) {
+			len = size;
+		}
+		memcpy(mHeader + mHeaderLen, pData, len);
+		mHeaderLen += len;
+		pData += len;
+		size -= len;
+
+		if (mHeaderLen < mHeaderNeed) {
+			// header continues in next packet
+			return true;
+		}
+
+		if (!parseHeader()) {
+			reset();
+			return false;
+		}
+	}
 
-	mPESPacket = pPESPacket;
-
-	uint8_t *pData = mPESPacket->getDataPtr();
-	mPacketStartCodePrefix = PACKET_START_CODE_PREFIX(pData);
-	mStreamId = STREAM_ID(pData);
-	mPacketLength = PACKET_LENGTH(pData);
-
-	if (mPacketStartCodePrefix != PES_PACKET_START_CODE_PREFIX){
-		meddbg("Invalid PES packet, not match PES_PACKET_START_CODE_PREFIX!\n");
-		reset();
-		return false;
+	if (!mUnbounded) {
+		if (size > mESRemaining) {
+			size = mESRemaining;
+		}
+		mESRemaining -= size;
+		if (mESRemaining == 0) {
+			// all ES data of the PES packet have been returned
+			mState = STATE_WAIT_START;
+		}
 	}
 
-	if ((size_t)PES_PACKET_HEAD_BYTES + mPacketLength > mPESPacket->getDataLen()) {
-		meddbg("Packet length overflow!\n");
-		reset();
-		return false;
+	*esData = pData;
+	*esDataLen = size;
+	return true;
+}
+
+bool PESParser::parseHeader(void)
+{
+	if (mHeaderNeed == PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES) {
+		mPacketStartCodePrefix = PACKET_START_CODE_PREFIX(mHeader);
+		mStreamId = STREAM_ID(mHeader);
+		mPacketLength = PACKET_LENGTH(mHeader);
+
+		if (mPacketStartCodePrefix != PES_PACKET_START_CODE_PREFIX) {
+			meddbg("Invalid PES packet, not match PES_PACKET_START_CODE_PREFIX!\n");
+			return false;
+		}
+
+		if (!parseStream(&mHeader[PES_PACKET_HEAD_BYTES])) {
+			return false;
+		}
+
+		if (mPacketLength != 0 && mPacketLength < PES_STREAM_HEAD_BYTES + mPESHeaderDataLength) {
+			meddbg("Packet length underflow!\n");
+			return false;
+		}
+
+		if (mPESHeaderDataLength != 0) {
+			// collect optional fields
+			mHeaderNeed += mPESHeaderDataLength;
+			return true;
+		}
 	}
 
-	return parseStream(&pData[PES_PACKET_HEAD_BYTES], mPacketLength);
+	// header is complete
+	mUnbounded = (mPacketLength == 0);
+	mESRemaining = mUnbounded ? 0 : mPacketLength - PES_STREAM_HEAD_BYTES - mPESHeaderDataLength;
+	mState = STATE_PAYLOAD;
+	return true;
 }
 
-bool PESParser::parseStream(uint8_t *pData, uint32_t size)
+bool PESParser::parseStream(uint8_t *pData)
 {
 	if (mStreamId >= 0xc0 && mStreamId <= 0xdf) {
 		// stream id = 110xxxxx means audio streams
@@ -90,34 +163,17 @@ bool PESParser::parseStream(uint8_t *pData, uint32_t size)
 	}
 
 	meddbg("stream_id: 0x%x is not supported!\n", mStreamId);
-	reset();
 	return false;
 }
 
-uint8_t *PESParser::getESData(void)
-{
-	if (!mPESPacket) {
-		// no PES packet, it's normal case.
-		return nullptr;
-	}
-
-	return mPESPacket->getDataPtr() + PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES + mPESHeaderDataLength;
-}
-
-uint16_t PESParser::getESDataLen(void)
-{
-	if (!mPESPacket) {
-		meddbg("There's no valid PES packet!\n");
-		return 0;
-	}
-
-	return mPacketLength - PES_STREAM_HEAD_BYTES - mPESHeaderDataLength;
-}
-
 void PESParser::reset(void)
 {
 	medvdbg("reset PES packet!\n");
-	mPESPacket = nullptr;
+	mState = STATE_WAIT_START;
+	mHeaderLen = 0;
+	mHeaderNeed = 0;
+	mESRemaining = 0;
+	mUnbounded = false;
 	mPacketStartCodePrefix = 0;
 	mStreamId = 0;
 	mPacketLength = 0;
@@ -19,35 +19,52 @@
 #ifndef __PES_PARSER_H
 #define __PES_PARSER_H
 
-#include <memory>
 #include "Mpeg2TsTypes.h"
 
-class PESPacket;
+/* Streaming PES parser. It takes the payload of each transport packet of
+ * an elementary stream PID and returns the ES data found in it, so that
+ * PES packets never need to be reassembled.
+ */
 class PESParser
 {
 public:
 	enum {
 		PES_PACKET_START_CODE_PREFIX = 0x000001,
+		PES_HEADER_MAX_LENGTH = 6 + 3 + 255, // packet head + stream head + PES_header_data_length
 	};
 
 	PESParser();
 	virtual ~PESParser();
-	// parse PES packet, and the parser will add reference to the packet.
-	bool parse(std::shared_ptr<PESPacket> pPESPacket);
-	// get ES data in PES
-	uint8_t *getESData(void);
-	// get ES data length
-	uint16_t getESDataLen(void);
-	// reset PES parser, to remove reference of the PES packet
+	// parse the payload of a transport packet
+	// on return, esData and esDataLen point to the ES data in the payload (may be empty)
+	// return false if the payload is dropped
+	bool parse(bool unitStart, uint8_t continuityCounter, uint8_t *pData, uint16_t size, uint8_t **esData, uint16_t *esDataLen);
+	// reset PES parser, drop the PES packet in progress
 	void reset(void);
 
 protected:
+	// parse header fields, once header bytes are present
+	bool parseHeader(void);
 	// parse stream data in PES
-	bool parseStream(uint8_t *pData, uint32_t size);
+	bool parseStream(uint8_t *pData);
 
 private:
-	// PES packet reference
-	std::shared_ptr<PESPacket> mPESPacket;
+	enum {
+		STATE_WAIT_START, // waiting for payload unit start
+		STATE_HEADER,     // header bytes are being collected
+		STATE_PAYLOAD,    // ES data follows
+	};
+
+	uint8_t mState;
+	// continuity counter of last ts packet accepted
+	uint8_t mContinuityCounter;
+	// PES header collected across transport packets
+	uint8_t mHeader[PES_HEADER_MAX_LENGTH];
+	uint16_t mHeaderLen;
+	uint16_t mHeaderNeed;
+	// ES data left in current PES packet, unbounded if PES_packet_length is 0
+	uint16_t mESRemaining;
+	bool mUnbounded;
 	// packet start code prefix
 	uint32_t mPacketStartCodePrefix;
 	// stream id
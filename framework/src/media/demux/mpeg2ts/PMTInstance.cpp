@@ -19,7 +19,6 @@
 #include <debug.h>
 
 #include "Mpeg2TsTypes.h"
-#include "PMTElementary.h"
 #include "PMTInstance.h"
 
 #define PMT_PROG_INFO_LENGTH(buffer)       (((buffer[0] & 0x0F) << 8) + buffer[1])
@@ -64,13 +63,8 @@ bool PMTInstance::parseInfo(uint8_t *pData, uint32_t size)
 
 	int32_t length = (int32_t)(size - (uint32_t)PMT_CRC_BYTES);
 	while (length > 0) {
-		auto stream = std::make_shared<PMTElementary>();
-		if (!stream) {
-			meddbg("Run out of memory!\n");
-			return false;
-		}
-
-		int32_t len = stream->parseES(pData, (uint32_t)length);
+		PMTElementary stream;
+		int32_t len = stream.parseES(pData, (uint32_t)length);
 		mElementaryStreams.push_back(stream);
 		length -= len;
 		pData += len;
@@ -118,11 +112,11 @@ size_t PMTInstance::numOfElementary(void)
 	return mElementaryStreams.size();
 }
 
-std::shared_ptr<PMTElementary> PMTInstance::getPMTElementary(uint32_t index)
+PMTElementary *PMTInstance::getPMTElementary(uint32_t index)
 {
 	if ((size_t)index >= numOfElementary()) {
 		return nullptr;
 	}
 
-	return mElementaryStreams[index];
+	return &mElementaryStreams[index];
 }
@@ -24,8 +24,8 @@
 
 #include "Mpeg2TsTypes.h"
 #include "TableBase.h"
+#include "PMTElementary.h"
 
-class PMTElementary;
 class PMTInstance : public TableBase
 {
 public:
@@ -39,7 +39,7 @@ public:
 	// number of elementary streams
 	size_t numOfElementary(void);
 	// get elementary stream by index
-	std::shared_ptr<PMTElementary> getPMTElementary(uint32_t index);
+	PMTElementary *getPMTElementary(uint32_t index);
 
 protected:
 	// parse specific information in PMT
@@ -59,7 +59,7 @@ private:
 	// program info length
 	uint16_t mProgramInfoLength;
 	// Elementary streams
-	std::vector<std::shared_ptr<PMTElementary>> mElementaryStreams;
+	std::vector<PMTElementary> mElementaryStreams;
 };
 
 #endif /* __PMT_INSTANCE_H */
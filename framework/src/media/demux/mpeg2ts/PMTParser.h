@@ -20,6 +20,7 @@
 #define __PMT_PARSER_H
 
 #include <map>
+#include <memory>
 #include "Mpeg2TsTypes.h"
 #include "SectionParser.h"
 
@@ -40,6 +41,8 @@ public:
 	std::shared_ptr<PMTInstance> getPMTInstance(prog_num_t programNumber);
 	// update PMT elememts
 	void updatePMTElements(std::map<int, ts_pid_t> &pmtMap);
+	// check if the given PMT elements are the current ones
+	bool isPMTElements(std::map<int, ts_pid_t> &pmtMap) { return mPMTElements == pmtMap; }
 	// make key with PMT pid and program number
 	static int makeKey(ts_pid_t pid, prog_num_t progNum);
 
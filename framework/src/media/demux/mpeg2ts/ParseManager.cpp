@@ -29,21 +29,19 @@
 #define TABILE_ID(buffer)   (buffer[0])
 
 ParserManager::ParserManager()
+	: mPATParser(std::make_shared<PATParser>())
+	, mPMTParser(std::make_shared<PMTParser>())
+	, mProgramsVersion(0)
 {
-	// Add PAT parser
-	addParser(std::make_shared<PATParser>());
-	// Add PMT parser
-	addParser(std::make_shared<PMTParser>());
 }
 
 ParserManager::~ParserManager()
 {
-	mTableParsers.clear();
 }
 
 bool ParserManager::isPATReceived(void)
 {
-	auto pPATParser = std::static_pointer_cast<PATParser>(getParser(PATParser::TABLE_ID));
+	auto pPATParser = mPATParser;
 	if (!pPATParser) {
 		meddbg("PAT parser is not found!\n");
 		return false;
@@ -54,7 +52,7 @@ bool ParserManager::isPATReceived(void)
 
 bool ParserManager::isPMTReceived(prog_num_t progNum)
 {
-	auto pPMTParser = std::static_pointer_cast<PMTParser>(getParser(PMTParser::TABLE_ID));
+	auto pPMTParser = mPMTParser;
 	if (!pPMTParser) {
 		meddbg("PMT parser is not found!\n");
 		return false;
@@ -71,7 +69,7 @@ bool ParserManager::isPMTReceived(prog_num_t progNum)
 
 bool ParserManager::isPMTReceived(void)
 {
-	auto pPATParser = std::static_pointer_cast<PATParser>(getParser(PATParser::TABLE_ID));
+	auto pPATParser = mPATParser;
 	if (!pPATParser) {
 		meddbg("PAT parser is not found!\n");
 		return false;
@@ -93,7 +91,7 @@ bool ParserManager::isPMTReceived(void)
 
 bool ParserManager::getAudioStreamInfo(prog_num_t progNum, uint8_t &streamType, ts_pid_t &pid)
 {
-	auto pPMTParser = std::static_pointer_cast<PMTParser>(getParser(PMTParser::TABLE_ID));
+	auto pPMTParser = mPMTParser;
 	auto pPMTInstance = pPMTParser->getPMTInstance(progNum);
 
 	if (pPMTInstance && pPMTInstance->isCompleted()) {
@@ -132,7 +130,7 @@ bool ParserManager::getPrograms(std::vector<prog_num_t> &programs)
 {
 	size_t i, num;
 
-	auto pPATParser = std::static_pointer_cast<PATParser>(getParser(PATParser::TABLE_ID));
+	auto pPATParser = mPATParser;
 	if (!pPATParser) {
 		meddbg("PAT parser is not found!\n");
 		return false;
@@ -158,7 +156,7 @@ bool ParserManager::syncProgramInfoFromPAT(void)
 	prog_num_t progNum;
 	std::map<int, ts_pid_t> pmt_elements;
 
-	auto pPATParser = std::static_pointer_cast<PATParser>(getParser(PATParser::TABLE_ID));
+	auto pPATParser = mPATParser;
 	if (!pPATParser) {
 		meddbg("PAT parser is not found!\n");
 		return false;
@@ -169,10 +167,7 @@ bool ParserManager::syncProgramInfoFromPAT(void)
 		return false;
 	}
 
-	// Clear current PMT Pids
-	mPMTPids.clear();
-
-	// Update new informations from PAT
+	// Collect new informations from PAT
 	num = pPATParser->sizeOfProgram();
 	for (i = 0; i < num; ++i) {
 		progNum = pPATParser->getProgramNumber(i);
@@ -184,15 +179,28 @@ bool ParserManager::syncProgramInfoFromPAT(void)
 			continue;
 		}
 		pmt_elements[PMTParser::makeKey(pmtPid, progNum)] = pmtPid;
-		mPMTPids.push_back(pmtPid);
 		medvdbg("index %d, progNum %u ,pmtPid 0x%02x\n", i, progNum, pmtPid);
 	}
 
-	auto pPMTParser = std::static_pointer_cast<PMTParser>(getParser(PMTParser::TABLE_ID));
+	auto pPMTParser = mPMTParser;
 	if (!pPMTParser) {
 		meddbg("PMT parser is not found!\n");
 		return false;
 	}
+
+	if (pPMTParser->isPMTElements(pmt_elements)) {
+		// new PAT version with the same programs, PMTs received are still valid
+		medvdbg("programs not changed\n");
+		return true;
+	}
+
+	// Update current PMT Pids
+	mPMTPids.clear();
+	for (auto iter : pmt_elements) {
+		mPMTPids.push_back(iter.second);
+	}
+	mProgramsVersion++;
+
 	// Reinitialize PMT parser and update new PMT elements to PMT parser
 	pPMTParser->Initialize();
 	pPMTParser->updatePMTElements(pmt_elements);
@@ -210,7 +218,7 @@ bool ParserManager::isPMTPid(ts_pid_t pid)
 	return false;
 }
 
-bool ParserManager::processSection(std::shared_ptr<Section> pSection)
+bool ParserManager::processSection(Section *pSection)
 {
 	if (!pSection) {
 		meddbg("section is nullptr!\n");
@@ -247,29 +255,15 @@ bool ParserManager::processSection(std::shared_ptr<Section> pSection)
 	return result;
 }
 
-bool ParserManager::addParser(std::shared_ptr<SectionParser> pParser)
-{
-	if (!pParser) {
-		meddbg("pParser is nullptr!\n");
-		return false;
-	}
-
-	if (getParser(pParser->getTableId())) {
-		meddbg("parser for tableid (0x%02x) already exists!\n", pParser->getTableId());
-		return false;
-	}
-
-	mTableParsers[pParser->getTableId()] = pParser;
-	return true;
-}
-
 std::shared_ptr<SectionParser> ParserManager::getParser(table_id_t tableId)
 {
-	auto it = mTableParsers.find(tableId);
-	if (it == mTableParsers.end()) {
+	switch (tableId) {
+	case PATParser::TABLE_ID:
+		return mPATParser;
+	case PMTParser::TABLE_ID:
+		return mPMTParser;
+	default:
 		medwdbg("no parser for tableid (0x%02x)\n", tableId);
 		return nullptr;
 	}
-
-	return it->second;
 }
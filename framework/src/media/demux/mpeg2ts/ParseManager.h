@@ -19,20 +19,21 @@
 #ifndef __PARSE_MANAGER_H
 #define __PARSE_MANAGER_H
 
-#include <map>
 #include <vector>
 #include <memory>
 #include "Mpeg2TsTypes.h"
 
 class Section;
 class SectionParser;
+class PATParser;
+class PMTParser;
 class ParserManager
 {
 public:
 	ParserManager();
 	virtual ~ParserManager();
 	// parse section with the corresponding parser
-	bool processSection(std::shared_ptr<Section> pSection);
+	bool processSection(Section *pSection);
 	// check if PAT has been received
 	bool isPATReceived(void);
 	// check if the PMT of the given program number has been received
@@ -45,10 +46,12 @@ public:
 	bool getPrograms(std::vector<prog_num_t> &programs);
 	// check if the given PID is a PMT PID
 	bool isPMTPid(ts_pid_t pid);
+	// get PIDs of PMT for section filtering
+	const std::vector<ts_pid_t> &getPMTPids(void) { return mPMTPids; }
+	// get version of the program list, changed whenever PMT PIDs are changed
+	uint32_t getProgramsVersion(void) { return mProgramsVersion; }
 
 protected:
-	// add new section parser
-	bool addParser(std::shared_ptr<SectionParser> pParser);
 	// get section parser of the given table id
 	std::shared_ptr<SectionParser> getParser(table_id_t tableId);
 	// sync program information from PAT parser when PAT received,
@@ -57,9 +60,12 @@ protected:
 
 private:
 	// table parsers
-	std::map<table_id_t, std::shared_ptr<SectionParser>> mTableParsers;
+	std::shared_ptr<PATParser> mPATParser;
+	std::shared_ptr<PMTParser> mPMTParser;
 	// Pids of PMT for section filtering
 	std::vector<ts_pid_t> mPMTPids;
+	// version of the program list, increased when the PMT PIDs are updated
+	uint32_t mProgramsVersion;
 };
 
 #endif /* __PARSE_MANAGER_H */
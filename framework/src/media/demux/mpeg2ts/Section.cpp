@@ -20,89 +20,92 @@
 #include <string.h>
 #include "Mpeg2TsTypes.h"
 #include "Section.h"
-#include "SectionParser.h"
 
 
 #define SECTION_LENGTH(buffer)  ((uint16_t)((buffer[1] & 0x0F) << 8) + (uint16_t)buffer[2])
 #define SECTION_HEAD_BYTES      (3)  // table_id + ... + section_length
 #define CONTINUITY_COUNTER_MOD  (16) // Continuity counter's module value
+#define MINIMUM(a, b)           ((a) < (b) ? (a) : (b))
 
 
-std::shared_ptr<Section> Section::create(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size)
+Section::Section()
+	: mPid(INVALID_PID)
+	, mContinuityCounter(0)
+	, mSectionDataLen(0)
+	, mPresentDataLen(0)
 {
-	auto instance = std::make_shared<Section>();
-	if (instance && instance->initialize(pid, continuityCounter, pData, size)) {
-		return instance;
-	}
-
-	meddbg("create Section instance failed!\n");
-	return nullptr;
 }
 
-bool Section::initialize(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size)
+Section::~Section()
 {
-	mSectionDataLen = parseLengthField(pData, size);
-	mSectionData = new uint8_t[mSectionDataLen];
-	if (!mSectionData) {
-		meddbg("Run out of memory! Allocating %d bytes failed!\n", mSectionDataLen);
-		return false;
-	}
-
-	if (mSectionDataLen < size) {
-		// abnormal case, anyway it would be abandoned if it's invalid section.
-		mPresentDataLen = mSectionDataLen;
-	} else {
-		mPresentDataLen = size;
-	}
-	memcpy(mSectionData, pData, mPresentDataLen);
+}
 
+uint16_t Section::initialize(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size)
+{
 	mPid = pid;
 	mContinuityCounter = continuityCounter;
-	medvdbg("initialize new section/packet, pid:0x%x, continuity:%u, data %u/%u\n", mPid, mContinuityCounter, mPresentDataLen, mSectionDataLen);
-	return true;
-}
+	mSectionDataLen = 0;
+	mPresentDataLen = 0;
 
-Section::Section()
-	: mPid(INVALID_PID)
-	, mContinuityCounter(0)
-	, mSectionData(nullptr)
-	, mSectionDataLen(0)
-	, mPresentDataLen(0)
-{
+	uint16_t used = fill(pData, size);
+	medvdbg("initialize new section, pid:0x%x, continuity:%u, data %u/%u\n", mPid, mContinuityCounter, mPresentDataLen, mSectionDataLen);
+	return used;
 }
 
-Section::~Section()
+void Section::reset(void)
 {
-	if (mSectionData) {
-		delete[] mSectionData;
-		mSectionData = nullptr;
-	}
+	mPid = INVALID_PID;
+	mSectionDataLen = 0;
+	mPresentDataLen = 0;
 }
 
-bool Section::appendData(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size)
+uint16_t Section::appendData(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size)
 {
 	if (mPid != pid) {
 		meddbg("pid(0x%x) do not match, current 0x%x\n", pid, mPid);
-		return false;
+		return 0;
 	}
 
 	if (continuityCounter != ((mContinuityCounter + 1) % CONTINUITY_COUNTER_MOD)) {
 		meddbg("continuity counter(0x%x) do not match, current 0x%x\n", continuityCounter, mContinuityCounter);
-		return false;
+		reset();
+		return 0;
 	}
 
 	mContinuityCounter = continuityCounter;
 
-	if (mPresentDataLen + size <= mSectionDataLen) {
-		memcpy(mSectionData + mPresentDataLen, pData, size);
-		mPresentDataLen += size;
-	} else {
-		memcpy(mSectionData + mPresentDataLen, pData, mSectionDataLen - mPresentDataLen);
-		mPresentDataLen = mSectionDataLen;
+	uint16_t used = fill(pData, size);
+	medvdbg("append section, pid:0x%x, continuity:%u, data %u(%u)/%u\n", mPid, mContinuityCounter, mPresentDataLen, size, mSectionDataLen);
+	return used;
+}
+
+uint16_t Section::fill(uint8_t *pData, uint16_t size)
+{
+	uint16_t used = 0;
+	uint16_t len;
+
+	if (mSectionDataLen == 0) {
+		// the header may be split between packets
+		len = MINIMUM(size, (uint16_t)(SECTION_HEAD_BYTES - mPresentDataLen));
+		memcpy(mSectionData + mPresentDataLen, pData, len);
+		mPresentDataLen += len;
+		used += len;
+		if (mPresentDataLen < SECTION_HEAD_BYTES) {
+			return used;
+		}
+
+		mSectionDataLen = parseLengthField(mSectionData);
+		if (mSectionDataLen > MAX_LENGTH) {
+			meddbg("section length %u exceeds %u, drop it!\n", mSectionDataLen, MAX_LENGTH);
+			reset();
+			return size;
+		}
 	}
 
-	medvdbg("append section/packet, pid:0x%x, continuity:%u, data %u(%u)/%u\n", mPid, mContinuityCounter, mPresentDataLen, size, mSectionDataLen);
-	return true;
+	len = MINIMUM((uint16_t)(size - used), (uint16_t)(mSectionDataLen - mPresentDataLen));
+	memcpy(mSectionData + mPresentDataLen, pData + used, len);
+	mPresentDataLen += len;
+	return used + len;
 }
 
 bool Section::verifyCrc32(void)
@@ -120,7 +123,7 @@ bool Section::isCompleted(void)
 	return ((mSectionDataLen != 0) && (mSectionDataLen == mPresentDataLen));
 }
 
-uint16_t Section::parseLengthField(uint8_t *pData, uint16_t size)
+uint16_t Section::parseLengthField(uint8_t *pData)
 {
 	return (SECTION_HEAD_BYTES + SECTION_LENGTH(pData));
 }
@@ -19,23 +19,34 @@
 #ifndef __SECTION_H
 #define __SECTION_H
 
-#include <memory>
 #include "Mpeg2TsTypes.h"
 
+/* Reassembly buffer of a PSI section, preallocated and reused for every
+ * section of the PID it is bound to.
+ */
 class Section
 {
 public:
-	// should always use this static method to create a new section instance
-	static std::shared_ptr<Section> create(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	enum {
+		// section_length of PAT and PMT shall not exceed 1021 (0x3FD)
+		MAX_LENGTH = 1024,
+	};
+
 	// constructor and destructor
 	Section();
 	virtual ~Section();
-	// initialize section member and allocate data buffer
-	bool initialize(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	// start a new section with the payload following the pointer field
+	// return number of bytes taken from the payload
+	uint16_t initialize(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
 	// append new section data from ts packet payload
-	bool appendData(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	// return number of bytes taken from the payload, or 0 if the section is dropped
+	uint16_t appendData(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	// drop the section in progress
+	void reset(void);
 	// verify mpeg2 crc32
 	bool verifyCrc32(void);
+	// check if a section is in progress
+	bool isStarted(void) { return mPid != INVALID_PID; }
 	// check if section is completed
 	bool isCompleted(void);
 	// get pointer of section data buffer
@@ -46,10 +57,11 @@ public:
 	ts_pid_t getPid(void) { return mPid; }
 
 protected:
-	// parse length field from the given data
-	// return length value of the object, in this class it's section_length
-	// derived class can override this method to get it's own length field.
-	virtual uint16_t parseLengthField(uint8_t *pData, uint16_t size);
+	// parse length field once the section header is present
+	// return length value of the section including the header
+	uint16_t parseLengthField(uint8_t *pData);
+	// copy payload into the section buffer
+	uint16_t fill(uint8_t *pData, uint16_t size);
 	// calculates the MPEG2 32 bit CRC
 	uint32_t crc32(uint8_t *data, uint32_t length);
 
@@ -58,9 +70,9 @@ private:
 	ts_pid_t mPid;
 	// continuity counter of last ts packet accepted
 	uint8_t mContinuityCounter;
-	// section data buffer allocated
-	uint8_t *mSectionData;
-	// total data length in bytes of a completed section
+	// section data buffer
+	uint8_t mSectionData[MAX_LENGTH];
+	// total data length in bytes of a completed section, 0 until the header is present
 	uint16_t mSectionDataLen;
 	// present data length in section data buffer
 	uint16_t mPresentDataLen;
@@ -27,7 +27,6 @@
 #include "PATParser.h"
 #include "ParseManager.h"
 #include "PMTElementary.h"
-#include "PESPacket.h"
 #include "PESParser.h"
 #include "TSDemuxer.h"
 
@@ -39,18 +38,29 @@
 #define TS_SYNC_COUNT               (3)
 // threshold is not used, we don't have any buffer observer now.
 #define TS_DEMUX_BUFFER_THRESHOLD   (CONFIG_DEMUX_BUFFER_SIZE / 2)
+#define TABLE_ID(buffer)            (buffer[0])
 
 namespace media {
 
 TSDemuxer::TSDemuxer()
 	: Demuxer(AUDIO_TYPE_MP2T)
+	, mESData(nullptr)
+	, mESDataLen(0)
 	, mPESPid(INVALID_PID)
-	, mPESDataUsed(0)
+	, mProgramsVersion(0)
 {
+	for (int i = 0; i < PID_FILTER_SIZE; i++) {
+		mFilters[i].pid = INVALID_PID;
+		mFilters[i].type = FILTER_NONE;
+		mFilters[i].section = nullptr;
+	}
 }
 
 TSDemuxer::~TSDemuxer()
 {
+	for (int i = 0; i < PID_FILTER_SIZE; i++) {
+		delete mFilters[i].section;
+	}
 }
 
 std::shared_ptr<TSDemuxer> TSDemuxer::create(void)
@@ -90,18 +100,8 @@ bool TSDemuxer::initialize(void)
 		return false;
 	}
 
-	mPESParser = std::make_shared<PESParser>();
-	if (!mPESParser) {
-		meddbg("mPESParser is nullptr!\n");
-		return false;
-	}
-
-	mTSPacket = std::make_shared<TSPacket>();
-	if (!mTSPacket) {
-		meddbg("mTSPacket is nullptr!\n");
-		return false;
-	}
-
+	// PAT is always filtered
+	updateFilters();
 	return true;
 }
 
@@ -138,55 +138,41 @@ ssize_t TSDemuxer::pullData(uint8_t *buf, size_t size, void *param)
 			return DEMUXER_ERROR_NOT_READY;
 		}
 		medvdbg("setup audio PES PID: 0x%x\n", mPESPid);
+		updateFilters();
 	}
 
 	int ret = DEMUXER_ERROR_NONE;
 	size_t fill = 0;
 	size_t need;
 	while (fill < size) {
-		need = size - fill;
-		if (mPESParser->getESData() != nullptr) {
-			// get remaining payload in last PES packet
-			if (need > mPESParser->getESDataLen() - mPESDataUsed) {
-				need = mPESParser->getESDataLen() - mPESDataUsed;
+		if (mESDataLen > 0) {
+			// ES data are copied straight from the TS packet payload
+			need = size - fill;
+			if (need > mESDataLen) {
+				need = mESDataLen;
 			}
 
-			memcpy(&buf[fill], mPESParser->getESData() + mPESDataUsed, need);
-			mPESDataUsed += need;
+			memcpy(&buf[fill], mESData, need);
+			mESData += need;
+			mESDataLen -= need;
 			fill += need;
 			medvdbg("Got ES data %u(%u)/%u\n", fill, need, size);
-
-			if (mPESDataUsed == mPESParser->getESDataLen()) {
-				// all ES data in PES parser have been read.
-				medvdbg("All ES data (%u) in PES parser have been read!\n", mPESParser->getESDataLen());
-				mPESParser->reset();
-				mPESDataUsed = 0;
-			}
 			continue;
-		} else {
-			medvdbg("Need to get new PES packet!\n");
 		}
 
-		// get new PES packet
-		std::shared_ptr<PESPacket> pPESPacket = nullptr;
-		ret = getPESPacket(pPESPacket);
+		// get next TS packet
+		ret = loadTSPacket();
 		if (ret == DEMUXER_ERROR_WANT_DATA) {
-			medvdbg("Push more data to get PES packet\n");
+			medvdbg("Push more data to get TS packet\n");
 			break;
 		}
 
 		if (ret != DEMUXER_ERROR_NONE) {
-			meddbg("Get PES packet failed! error: %d\n", ret);
+			meddbg("Get TS packet failed! error: %d\n", ret);
 			break;
 		}
 
-		// parse PES packet
-		if (mPESParser->parse(pPESPacket)) {
-			mPESDataUsed = 0;
-		} else {
-			meddbg("PES parse failed!\n");
-			continue;
-		}
+		dispatchTSPacket(&mESData, &mESDataLen);
 	} // end while
 
 	if (fill == 0) {
@@ -274,128 +260,204 @@ int TSDemuxer::resync(uint8_t *pPacketData, size_t readOffset)
 	return DEMUXER_ERROR_SYNC_FAILED;
 }
 
-std::shared_ptr<Section> TSDemuxer::PSIUnpack(std::shared_ptr<TSPacket> pTSPacket)
+struct TSDemuxer::pid_filter_s *TSDemuxer::findFilter(ts_pid_t pid)
 {
-	std::shared_ptr<Section> pSection = nullptr;
-	uint8_t  lenPayload = 0;
-	uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
+	int i;
+	int index = pid & (PID_FILTER_SIZE - 1);
 
-	if (!ptrPayload) {
-		// no payload
-		return pSection;
-	}
-
-	if (pTSPacket->payloadUnitStartIndicator()) {
-		// new section start
-		// first byte in payload is the pointer field in case of unit start indicator is 1
-		uint8_t u8PointerField = ptrPayload[0];
-		if (u8PointerField != 0) {
-			// prev section tail and next section head in this packet,
-			// firstly, handle prev section data
-			auto it = mPidSectionMap.find(pTSPacket->getPid());
-			if (it != mPidSectionMap.end()) {
-				auto preSection = it->second;
-				preSection->appendData(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload + 1, u8PointerField);
-				if (preSection->isCompleted()) {
-					pSection = preSection;
-				} else {
-					meddbg("Drop incomplete section!\n");
-				}
-				// remove section from map anyway
-				mPidSectionMap.erase(it);
-			}
+	for (i = 0; i < PID_FILTER_SIZE; i++) {
+		struct pid_filter_s *filter = &mFilters[(index + i) & (PID_FILTER_SIZE - 1)];
+		if (filter->pid == pid) {
+			return filter;
 		}
+		if (filter->type == FILTER_NONE) {
+			// empty slot ends the probing
+			break;
+		}
+	}
 
-		// and then handle new section
-		auto newSection = Section::create(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload + 1 + u8PointerField, lenPayload - 1 - u8PointerField);
-		if (newSection->isCompleted()) {
-			if (pSection != nullptr) {
-				meddbg("It should be unreachable! Fixme if it happen!\n");
-			}
-			pSection = newSection;
-		} else {
-			mPidSectionMap.insert(std::pair<uint16_t, std::shared_ptr<Section>>(pTSPacket->getPid(), newSection));
+	return nullptr;
+}
+
+bool TSDemuxer::addFilter(ts_pid_t pid, uint8_t type, Section *section)
+{
+	int i;
+	int index = pid & (PID_FILTER_SIZE - 1);
+
+	if (findFilter(pid)) {
+		delete section;
+		return true;
+	}
+
+	if (type == FILTER_PSI && !section) {
+		// one section per PSI PID, allocated only when the PID is filtered first
+		section = new Section();
+		if (!section) {
+			meddbg("Run out of memory! Allocate section for PSI PID 0x%x failed!\n", pid);
+			return false;
 		}
-	} else {
-		// section appending
-		auto it = mPidSectionMap.find(pTSPacket->getPid());
-		if (it != mPidSectionMap.end()) {
-			auto preSection = it->second;
-			preSection->appendData(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload); // no point filed
-			if (preSection->isCompleted()) {
-				pSection = preSection;
-				// remove section from map
-				mPidSectionMap.erase(it);
+	}
+
+	for (i = 0; i < PID_FILTER_SIZE; i++) {
+		struct pid_filter_s *filter = &mFilters[(index + i) & (PID_FILTER_SIZE - 1)];
+		if (filter->type == FILTER_NONE) {
+			filter->pid = pid;
+			filter->type = type;
+			filter->section = section;
+			return true;
+		}
+	}
+
+	meddbg("PID filter table is full, PID 0x%x\n", pid);
+	delete section;
+	return false;
+}
+
+void TSDemuxer::updateFilters(void)
+{
+	struct pid_filter_s prev[PID_FILTER_SIZE];
+	int i;
+
+	// take the section of the given PID out of the previous table
+	auto takeSection = [&prev](ts_pid_t pid) -> Section * {
+		for (int j = 0; j < PID_FILTER_SIZE; j++) {
+			if (prev[j].pid == pid && prev[j].section) {
+				Section *section = prev[j].section;
+				prev[j].section = nullptr;
+				return section;
 			}
 		}
+		return nullptr;
+	};
+
+	for (i = 0; i < PID_FILTER_SIZE; i++) {
+		prev[i] = mFilters[i];
+		mFilters[i].pid = INVALID_PID;
+		mFilters[i].type = FILTER_NONE;
+		mFilters[i].section = nullptr;
 	}
 
-	return pSection;
+	mProgramsVersion = mParserManager->getProgramsVersion();
+	addFilter(PATParser::PAT_PID, FILTER_PSI, takeSection(PATParser::PAT_PID));
+	for (auto pid : mParserManager->getPMTPids()) {
+		addFilter(pid, FILTER_PSI, takeSection(pid));
+	}
+	if (mPESPid != INVALID_PID) {
+		addFilter(mPESPid, FILTER_PES);
+	}
+
+	// release sections of the PIDs not filtered any more
+	for (i = 0; i < PID_FILTER_SIZE; i++) {
+		delete prev[i].section;
+	}
+}
+
+uint8_t TSDemuxer::dispatchTSPacket(uint8_t **esData, uint16_t *esDataLen)
+{
+	*esData = nullptr;
+	*esDataLen = 0;
+
+	struct pid_filter_s *filter = findFilter(mTSPacket.getPid());
+	if (!filter) {
+		// not filtered
+		return FILTER_NONE;
+	}
+
+	switch (filter->type) {
+	case FILTER_PES: {
+		uint8_t lenPayload = 0;
+		uint8_t *ptrPayload = mTSPacket.getPayloadData(&lenPayload);
+		if (ptrPayload) {
+			mPESParser.parse(mTSPacket.payloadUnitStartIndicator(), mTSPacket.continuityCounter(), ptrPayload, lenPayload, esData, esDataLen);
+		}
+		break;
+	}
+	case FILTER_PSI:
+		PSIUnpack(*filter->section);
+		return FILTER_PSI;
+	default:
+		break;
+	}
+
+	return filter->type;
 }
 
-std::shared_ptr<PESPacket> TSDemuxer::PESUnpack(std::shared_ptr<TSPacket> pTSPacket)
+void TSDemuxer::PSIUnpack(Section &section)
 {
-	std::shared_ptr<PESPacket> pPESPacket = nullptr;
 	uint8_t  lenPayload = 0;
-	uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
+	uint8_t *ptrPayload = mTSPacket.getPayloadData(&lenPayload);
+	ts_pid_t pid = mTSPacket.getPid();
+	uint8_t continuityCounter = mTSPacket.continuityCounter();
 
 	if (!ptrPayload) {
 		// no payload
-		return pPESPacket;
+		return;
 	}
 
-	if (pTSPacket->payloadUnitStartIndicator()) {
-		// new PES packet start
-		medvdbg("new PES packet (PID:%u) start...\n", pTSPacket->getPid());
-		auto newPacket = PESPacket::create(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload);
-		if (newPacket->isCompleted()) {
-			medvdbg("PES packet (PID:%u) complete\n", pTSPacket->getPid());
-			pPESPacket = newPacket;
-		} else {
-			auto it = mPidPESPacketMap.find(pTSPacket->getPid());
-			if (it != mPidPESPacketMap.end()) {
-				// incomplete PES packet with same PID exist, remove it!
-				mPidPESPacketMap.erase(it);
-			}
-			mPidPESPacketMap.insert(std::pair<uint16_t, std::shared_ptr<PESPacket>>(pTSPacket->getPid(), newPacket));
-		}
-	} else {
-		// PES packet appending
-		auto it = mPidPESPacketMap.find(pTSPacket->getPid());
-		if (it != mPidPESPacketMap.end()) {
-			auto prePacket = it->second;
-			prePacket->appendData(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload);
-			if (prePacket->isCompleted()) {
-				medvdbg("PES packet (PID:%u) complete\n", pTSPacket->getPid());
-				pPESPacket = prePacket;
-				mPidPESPacketMap.erase(it);
+	if (!mTSPacket.payloadUnitStartIndicator()) {
+		// section appending
+		if (section.isStarted()) {
+			section.appendData(pid, continuityCounter, ptrPayload, lenPayload); // no point filed
+			if (section.isCompleted()) {
+				processSection(section);
 			}
 		}
+		return;
 	}
 
-	return pPESPacket;
-}
+	// new section start
+	// first byte in payload is the pointer field in case of unit start indicator is 1
+	uint8_t u8PointerField = ptrPayload[0];
+	ptrPayload++;
+	lenPayload--;
+	if (u8PointerField > lenPayload) {
+		meddbg("Invalid pointer field %u!\n", u8PointerField);
+		section.reset();
+		return;
+	}
 
-bool TSDemuxer::isPsiPid(uint16_t pid)
-{
-	switch (pid) {
-	case PATParser::PAT_PID:
-		return true;
-	default:
-		return mParserManager->isPMTPid(pid);
+	if (u8PointerField != 0 && section.isStarted()) {
+		// prev section tail and next section head in this packet,
+		// firstly, handle prev section data
+		section.appendData(pid, continuityCounter, ptrPayload, u8PointerField);
+		if (section.isCompleted()) {
+			processSection(section);
+		} else {
+			meddbg("Drop incomplete section!\n");
+		}
+	}
+	ptrPayload += u8PointerField;
+	lenPayload -= u8PointerField;
+
+	// and then handle new sections, the rest is stuffing once table id is 0xFF
+	while (lenPayload > 0 && ptrPayload[0] != 0xFF) {
+		uint8_t used = (uint8_t)section.initialize(pid, continuityCounter, ptrPayload, lenPayload);
+		if (!section.isCompleted()) {
+			// section continues in next packet
+			break;
+		}
+		processSection(section);
+		ptrPayload += used;
+		lenPayload -= used;
 	}
 }
 
-bool TSDemuxer::isPESPid(uint16_t pid)
+void TSDemuxer::processSection(Section &section)
 {
-	return (pid == mPESPid);
+	uint8_t tableId = TABLE_ID(section.getDataPtr());
+	if (mParserManager->processSection(&section) && tableId == PATParser::TABLE_ID &&
+		mParserManager->getProgramsVersion() != mProgramsVersion) {
+		// PMT PIDs are changed, filter them, the PAT section is kept
+		updateFilters();
+	}
+	section.reset();
 }
 
-int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size_t *offset)
+int TSDemuxer::loadTSPacket(bool sync, size_t *offset)
 {
 	int syncOffset = 0;
 	uint8_t buffLen; // TSPacket::PACKET_SIZE
-	uint8_t *pBuffer = pTSPacket->getPacketBuffer(&buffLen);
+	uint8_t *pBuffer = mTSPacket.getPacketBuffer(&buffLen);
 	size_t readOffset = (offset == nullptr) ? 0 : *offset;
 
 	// try to copy 188 bytes of packet data from stream buffer
@@ -406,7 +468,7 @@ int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size
 	}
 
 	// check if resync is required
-	if (sync || !pTSPacket->parse()) {
+	if (sync || !mTSPacket.parse()) {
 		syncOffset = resync(pBuffer, readOffset);
 		if (syncOffset < 0) {
 			// sync failed, negative value means error code.
@@ -417,7 +479,7 @@ int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size
 			readOffset += syncOffset;
 		}
 		// parse packet again after resync
-		pTSPacket->parse();
+		mTSPacket.parse();
 	}
 
 	// 188 bytes ts packet has been loaded to output buffer
@@ -431,24 +493,6 @@ int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size
 	return DEMUXER_ERROR_NONE;
 }
 
-// return demuxer_error_e
-int TSDemuxer::getPESPacket(std::shared_ptr<PESPacket> &pPESPacket)
-{
-	int ret;
-
-	while ((ret = loadTSPacket(mTSPacket)) == DEMUXER_ERROR_NONE) {
-		if (isPESPid(mTSPacket->getPid())) {
-			pPESPacket = PESUnpack(mTSPacket);
-			if (pPESPacket) {
-				medvdbg("got new PES packet\n");
-				return DEMUXER_ERROR_NONE;
-			}
-		}
-	}
-
-	return ret;
-}
-
 bool TSDemuxer::isReady(void)
 {
 	return (mParserManager->isPATReceived() && mParserManager->isPMTReceived());
@@ -460,6 +504,8 @@ int TSDemuxer::prepare(void)
 {
 	ssize_t ret;
 	size_t readOffset = 0;
+	uint8_t *esData;
+	uint16_t esDataLen;
 
 	medvdbg("called!\n");
 
@@ -469,23 +515,15 @@ int TSDemuxer::prepare(void)
 	}
 
 	// Load 1st ts packet with force sync
-	ret = loadTSPacket(mTSPacket, true, &readOffset);
+	ret = loadTSPacket(true, &readOffset);
 	while (ret == DEMUXER_ERROR_NONE) {
-		if (isPsiPid(mTSPacket->getPid())) {
-			// packet of PSI table section
-			auto pSection = PSIUnpack(mTSPacket);
-			if (pSection) {
-				// got PSI section
-				if (mParserManager->processSection(pSection)) {
-					if (isReady()) {
-						// pre parse succeed
-						medvdbg("preparse succeed!\n");
-						return DEMUXER_ERROR_NONE;
-					}
-				}
-			}
+		// only PSI PIDs are filtered before the PES PID is set up
+		if (dispatchTSPacket(&esData, &esDataLen) == FILTER_PSI && isReady()) {
+			// pre parse succeed
+			medvdbg("preparse succeed!\n");
+			return DEMUXER_ERROR_NONE;
 		}
-		ret = loadTSPacket(mTSPacket, false, &readOffset);
+		ret = loadTSPacket(false, &readOffset);
 	}
 
 	// return error code
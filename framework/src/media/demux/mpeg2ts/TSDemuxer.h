@@ -21,19 +21,16 @@
 
 #include <stdio.h>
 #include <stdint.h>
-#include <string>
 #include <vector>
-#include <map>
-#include <list>
 #include <memory>
 #include <media/MediaTypes.h>
 #include "../../Demuxer.h"
+#include "Mpeg2TsTypes.h"
+#include "TSPacket.h"
+#include "Section.h"
+#include "PESParser.h"
 
 class ParserManager;
-class Section;
-class TSPacket;
-class PESParser;
-class PESPacket;
 
 namespace media {
 namespace stream {
@@ -45,6 +42,10 @@ class StreamBufferWriter;
 class TSDemuxer : public Demuxer
 {
 public:
+	enum {
+		PID_FILTER_SIZE = 16,   // entries of PID filter table, power of 2
+	};
+
 	// create new TSDemuxer object
 	static std::shared_ptr<TSDemuxer> create(void);
 
@@ -73,33 +74,46 @@ public:
 	bool getPrograms(std::vector<uint16_t> &progs);
 
 private:
-	// check if the given PID is PSI table's PID in TS
-	bool isPsiPid(uint16_t pid);
-	// check if the given PID is PES packet's PID we need
-	bool isPESPid(uint16_t pid);
-	// extract a PES packet from the input transport stream
-	// on success, return 0
-	// on failure, return negative value (see demuxer_error_e)
-	int getPESPacket(std::shared_ptr<PESPacket> &pPESPacket);
+	enum {
+		FILTER_NONE,
+		FILTER_PSI,
+		FILTER_PES,
+	};
+
+	struct pid_filter_s {
+		ts_pid_t pid;
+		uint8_t type;
+		Section *section;   // reassembly buffer for PSI
+	};
+
+	// find the filter of the given PID, nullptr if the PID is not filtered
+	struct pid_filter_s *findFilter(ts_pid_t pid);
+	// add the given PID to the filter table
+	// section, reassembly buffer kept from the previous table, nullptr to allocate one for PSI
+	bool addFilter(ts_pid_t pid, uint8_t type, Section *section = nullptr);
+	// rebuild filter table with PAT, PMT PIDs and the elementary stream PID
+	// sections of the PIDs still filtered are kept with the data in progress
+	void updateFilters(void);
+	// dispatch the loaded TS packet to its filter, return the filter type
+	// on return, esData and esDataLen point to ES data in the packet
+	uint8_t dispatchTSPacket(uint8_t **esData, uint16_t *esDataLen);
 	// load a valid TS packet from the input data stream
 	// sync, request to do force resync
 	// offset, if not null, just copy data from stream buffer
 	// return value:
 	// on success, return 0
 	// on failure, return negative value (see demuxer_error_e)
-	int loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync = false, size_t *offset = nullptr);
-	// Unpack a TS packet and return a section if get a completed one
-	std::shared_ptr<Section> PSIUnpack(std::shared_ptr<TSPacket> pTSPacket);
-	// Unpack a TS packet and return a PES packet if get a completed one
-	std::shared_ptr<PESPacket> PESUnpack(std::shared_ptr<TSPacket> pTSPacket);
+	int loadTSPacket(bool sync = false, size_t *offset = nullptr);
+	// Unpack a TS packet of PSI, and process every section completed in it
+	void PSIUnpack(Section &section);
+	// process a completed section
+	void processSection(Section &section);
 	// resync TS packet by TSPacket::SYNC_BYTE
 	int resync(uint8_t *pPacketData, size_t offset);
 
 private:
-	// <pid, section_ptr> pairs in map to take incomplete sections
-	std::map<uint16_t, std::shared_ptr<Section>> mPidSectionMap;
-	// <pid, pespacket_ptr> pairs in map to take incomplete PES packets
-	std::map<uint16_t, std::shared_ptr<PESPacket>> mPidPESPacketMap;
+	// PID filter table, open addressing by PID
+	struct pid_filter_s mFilters[PID_FILTER_SIZE];
 	// PSI table pasers manager
 	std::shared_ptr<ParserManager> mParserManager;
 	// stream buffer to held inputing TS stream data
@@ -109,11 +123,15 @@ private:
 	// writer handler of the stream buffer
 	std::shared_ptr<stream::StreamBufferWriter> mBufferWriter;
 	// PES parser
-	std::shared_ptr<PESParser> mPESParser;
+	PESParser mPESParser;
 	// TS packet
-	std::shared_ptr<TSPacket> mTSPacket;
+	TSPacket mTSPacket;
+	// ES data in TS packet not pulled yet
+	uint8_t *mESData;
+	uint16_t mESDataLen;
 	uint16_t mPESPid;
-	size_t mPESDataUsed;
+	// version of the program list the filter table is built with
+	uint32_t mProgramsVersion;
 };
 
 } // namespace media
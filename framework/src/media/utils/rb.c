@@ -155,6 +155,39 @@ size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset)
 	return len;
 }
 
+size_t rb_write_span(rb_p rbp, void **ptr)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(ptr != NULL, SIZE_ZERO);
+
+	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
+	*ptr = (void *)((uint8_t *)rbp->buf + wr_idx);
+
+	// Free space ends at the end of ring buffer at most
+	return MINIMUM(rb_avail(rbp), (rbp->depth - wr_idx));
+}
+
+size_t rb_write_commit(rb_p rbp, size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_avail(rbp));
+	_incr(rbp, &rbp->wr_idx, len);
+	return len;
+}
+
+size_t rb_read_span(rb_p rbp, void **ptr)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(ptr != NULL, SIZE_ZERO);
+
+	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
+	*ptr = (void *)((uint8_t *)rbp->buf + rd_idx);
+
+	// Data ends at the end of ring buffer at most
+	return MINIMUM(rb_used(rbp), (rbp->depth - rd_idx));
+}
+
 bool rb_reset(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
@@ -102,6 +102,34 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get the contiguous free space at the write position, so that new data
+ *         can be put in place and committed by rb_write_commit() without a copy.
+ *         Free space wrapping around the end of the buffer needs a second span.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer to save the start address of the free space
+ * @return size of the contiguous free space in bytes
+ */
+size_t rb_write_span(rb_p rbp, void **ptr);
+
+/**
+ * @brief  Commit data put in place at the write position, see rb_write_span().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data put in place
+ * @return size the wr_idx increased, range[0, len]
+ */
+size_t rb_write_commit(rb_p rbp, size_t len);
+
+/**
+ * @brief  Get the contiguous data at the read position, so that it can be used
+ *         in place and then dropped by rb_read() with NULL 'ptr'.
+ *         Data wrapping around the end of the buffer needs a second span.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer to save the start address of the data
+ * @return size of the contiguous data in bytes
+ */
+size_t rb_read_span(rb_p rbp, void **ptr);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
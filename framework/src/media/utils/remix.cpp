@@ -89,6 +89,11 @@ using namespace media;
  ****************************************************************************/
 #define MIX_COEFF   7071 / 1000 // 0.7071, DONOT (7071 / 1000)
 
+// Q14 gains used by remix_matrix()
+#define GAIN_ONE    REMIX_GAIN_ONE
+#define GAIN_HALF   (REMIX_GAIN_ONE / 2)
+#define GAIN_MIX    (REMIX_GAIN_ONE * 7071 / 10000)
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -319,3 +324,77 @@ int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input,
 
 	return (int32_t)out_frames;
 }
+
+int32_t remix_matrix(uint32_t in_layout, uint32_t out_layout, int16_t *matrix)
+{
+	RETURN_VAL_IF_FAIL((matrix != NULL), -1);
+	RETURN_VAL_IF_FAIL((out_layout == CH_LAYOUT_MONO || out_layout == CH_LAYOUT_STEREO), -1);
+
+	uint32_t in_ch = layout2ch(in_layout);
+	RETURN_VAL_IF_FAIL((in_ch > 0), -1);
+
+	if (in_layout == out_layout) {
+		memset(matrix, 0, in_ch * in_ch * sizeof(int16_t));
+		for (uint32_t i = 0; i < in_ch; i++) {
+			matrix[i * in_ch + i] = GAIN_ONE;
+		}
+		return 0;
+	}
+
+	if (in_layout == CH_LAYOUT_MONO) { // out_layout: CH_LAYOUT_STEREO
+		matrix[0] = GAIN_ONE;
+		matrix[1] = GAIN_ONE;
+		return 0;
+	}
+
+	// Same rules as rechannel(), the left output gains first, then the right ones
+	int16_t *fl = &matrix[0];
+	int16_t *fr = &matrix[in_ch];
+	memset(matrix, 0, 2 * in_ch * sizeof(int16_t));
+
+	switch (in_layout) {
+	case CH_LAYOUT_STEREO:
+		fl[0] = GAIN_ONE;
+		fr[1] = GAIN_ONE;
+		break;
+	case CH_LAYOUT_2POINT1:
+		fl[0] = GAIN_ONE;
+		fr[1] = GAIN_ONE;
+		break;
+	case CH_LAYOUT_3POINT1: // fall through
+	case CH_LAYOUT_SURROUND:
+		fl[0] = GAIN_ONE;
+		fl[2] = GAIN_HALF;
+		fr[1] = GAIN_ONE;
+		fr[2] = GAIN_HALF;
+		break;
+	case CH_LAYOUT_QUAD:
+		fl[0] = GAIN_HALF;
+		fl[2] = GAIN_HALF;
+		fr[1] = GAIN_HALF;
+		fr[3] = GAIN_HALF;
+		break;
+	case CH_LAYOUT_5POINT1_BACK: // fall through
+	case CH_LAYOUT_5POINT0_BACK: {
+		uint32_t bl = (in_layout == CH_LAYOUT_5POINT1_BACK) ? 4 : 3;
+		fl[0] = GAIN_ONE;
+		fl[2] = GAIN_MIX;
+		fl[bl] = GAIN_MIX;
+		fr[1] = GAIN_ONE;
+		fr[2] = GAIN_MIX;
+		fr[bl + 1] = GAIN_MIX;
+	} break;
+	default:
+		meddbg("unsupported in_layout 0x%x\n", in_layout);
+		return -1;
+	}
+
+	// Stereo -> mono averages the two stereo rows
+	if (out_layout == CH_LAYOUT_MONO) {
+		for (uint32_t i = 0; i < in_ch; i++) {
+			matrix[i] = ((int32_t)fl[i] + fr[i]) / 2;
+		}
+	}
+
+	return 0;
+}
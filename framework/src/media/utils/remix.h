@@ -25,6 +25,10 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/* Remix gains are Q14 fixed point values, REMIX_GAIN_ONE means 1.0 */
+#define REMIX_GAIN_SHIFT 14
+#define REMIX_GAIN_ONE   (1 << REMIX_GAIN_SHIFT)
+
 /**
  * @brief   Get number of channels of the given channle layout
  * @param   layout: channel layout
@@ -52,6 +56,17 @@ uint32_t ch2layout(uint32_t nb_chs);
  */
 int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames);
 
+/**
+ * @brief   Get the gains rechannel() applies to remix the given layouts
+ * @remarks It lets callers do the remix in the same pass as other per sample processing:
+ *          output[o] = sum(matrix[o * in_channels + i] * input[i]) >> REMIX_GAIN_SHIFT.
+ * @param   in_layout: channel layout of the input audio
+ * @param   out_layout: channel layout desired for the output, supports Mono/Stereo only.
+ * @param   matrix: pointer to the output gains, it must hold out_channels * in_channels values.
+ * @return  0 on success, return negative value if the given layouts are unsupported.
+ */
+int32_t remix_matrix(uint32_t in_layout, uint32_t out_layout, int16_t *matrix);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
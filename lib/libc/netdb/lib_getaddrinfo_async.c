@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ * Copyright 2019 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netdb.h>
+#include <errno.h>
+#include <tinyara/netmgr/netctl.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: getaddrinfo_async
+ *
+ * Description:
+ *   Start the translation getaddrinfo() does and return without waiting for
+ *   the DNS server. The A and AAAA queries of an AF_UNSPEC lookup are sent
+ *   in parallel.
+ *
+ *   cb is called exactly once, with 0 and the result (to be released with
+ *   freeaddrinfo()) or with an EAI_ error and NULL. It is called before
+ *   getaddrinfo_async() returns when the answer is cached or hostname is an
+ *   address string, otherwise from the network stack thread, so it must not
+ *   block.
+ *
+ * Input Parameters:
+ *   hostname - descriptive name or address string of the host
+ *                 (may be NULL -> local address)
+ *   servname - port number as string of NULL
+ *   hint - structure containing input values that set socktype and protocol
+ *   cb - completion callback
+ *   arg - argument passed to cb
+ *
+ * Returned Value:
+ *   0 if cb will be called, non-zero (and no call of cb) on failure
+ *
+ ****************************************************************************/
+int getaddrinfo_async(FAR const char *hostname,
+					  FAR const char *servname,
+					  FAR const struct addrinfo *hint,
+					  getaddrinfo_cb_t cb, FAR void *arg)
+{
+	int ret = -1;
+	struct req_lwip_data req;
+
+	if (!cb) {
+		return EAI_FAIL;
+	}
+
+	int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sockfd < 0) {
+		printf("socket() failed with errno: %d\t%s\n", errno, __FUNCTION__);
+		return ret;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.type = GETADDRINFO_ASYNC;
+	req.msg.netdb.host_name = hostname;
+	req.msg.netdb.serv_name = servname;
+	req.msg.netdb.ai_hint = hint;
+	req.msg.netdb.ai_cb = cb;
+	req.msg.netdb.ai_cb_arg = arg;
+
+	ret = ioctl(sockfd, SIOCLWIP, (unsigned long)&req);
+	close(sockfd);
+	if (ret == ERROR) {
+		printf("ioctl() failed with errno: %d\t%s\n", errno, __FUNCTION__);
+		return ret;
+	}
+
+	return req.req_res;
+}
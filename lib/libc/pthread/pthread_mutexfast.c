@@ -0,0 +1,149 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * libc/pthread/pthread_mutexfast.c
+ *
+ *   User-space fast path of pthread_mutex_lock/trylock/unlock.  The mutex
+ *   is taken with a compare-and-swap of its lock word; the system call is
+ *   only made when the lock word shows that the kernel tracks the mutex or
+ *   another thread holds it.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+
+#if defined(CONFIG_PTHREAD_MUTEX_USERFAST) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_userfast
+ *
+ * Description:
+ *   Only non-robust NORMAL mutexes may be held without the kernel knowing.
+ *   The other kinds need the holder pid or the robust list at every lock.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_userfast(FAR pthread_mutex_t *mutex)
+{
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+	if (mutex->type != PTHREAD_MUTEX_NORMAL) {
+		return false;
+	}
+#endif
+#ifdef CONFIG_PTHREAD_MUTEX_BOTH
+	if ((mutex->flags & _PTHREAD_MFLAGS_ROBUST) != 0) {
+		return false;
+	}
+#endif
+	return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fastlock
+ *
+ * Description:
+ *   Lock the mutex with the lock word when it is free.  The address of a
+ *   stack variable is stored as the owner; the kernel maps it back to the
+ *   owning thread if another thread has to wait for the mutex.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastlock(FAR pthread_mutex_t *mutex)
+{
+	uint32_t owner = (uint32_t)(uintptr_t)&mutex;
+
+	if (mutex != NULL && pthread_mutex_userfast(mutex)) {
+		if (__sync_bool_compare_and_swap(&mutex->lockword, _PTHREAD_LOCKWORD_FREE, owner)) {
+			return OK;
+		}
+	}
+
+	return (pthread_mutex_lock)(mutex);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fasttrylock
+ ****************************************************************************/
+
+int pthread_mutex_fasttrylock(FAR pthread_mutex_t *mutex)
+{
+	uint32_t owner = (uint32_t)(uintptr_t)&mutex;
+	uint32_t lockword;
+
+	if (mutex != NULL && pthread_mutex_userfast(mutex)) {
+		if (__sync_bool_compare_and_swap(&mutex->lockword, _PTHREAD_LOCKWORD_FREE, owner)) {
+			return OK;
+		}
+
+		/* A user-space owner certainly holds it.  A kernel-tracked mutex may
+		 * be free (e.g. released by pthread_cond_wait()), so ask the kernel.
+		 */
+
+		lockword = mutex->lockword;
+		if (lockword != _PTHREAD_LOCKWORD_FREE && (lockword & _PTHREAD_LOCKWORD_KERNEL) == 0) {
+			return EBUSY;
+		}
+	}
+
+	return (pthread_mutex_trylock)(mutex);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastunlock
+ *
+ * Description:
+ *   Release a mutex that was taken in user space.  If a waiter made the
+ *   kernel take over the mutex in the meantime, the compare-and-swap fails
+ *   and the kernel hands the mutex over to the waiter.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex)
+{
+	uint32_t lockword;
+
+	if (mutex != NULL && pthread_mutex_userfast(mutex)) {
+		lockword = mutex->lockword;
+		if (lockword != _PTHREAD_LOCKWORD_FREE && (lockword & _PTHREAD_LOCKWORD_KERNEL) == 0) {
+			if (__sync_bool_compare_and_swap(&mutex->lockword, lockword, _PTHREAD_LOCKWORD_FREE)) {
+				return OK;
+			}
+		}
+	}
+
+	return (pthread_mutex_unlock)(mutex);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_USERFAST && !__KERNEL__ */
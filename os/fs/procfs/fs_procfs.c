@@ -96,6 +96,15 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS)
+extern const struct procfs_operations wqueue_operations;
+#endif
+#if defined(CONFIG_SCHED_WAKEUP_STATS)
+extern const struct procfs_operations wakeups_operations;
+#endif
+#if defined(CONFIG_NET_TCP_PCB_STATS)
+extern const struct procfs_operations net_tcp_operations;
+#endif
 #if defined(CONFIG_LOG_DUMP)
 extern const struct procfs_operations logsave_operations;
 #endif
@@ -152,6 +161,10 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"partitions", &part_procfsoperations},
 #endif
 
+#if defined(CONFIG_NET_TCP_PCB_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_NET_TCP)
+	{"net/tcp", &net_tcp_operations},
+#endif
+
 #if defined(CONFIG_PM) && !defined(CONFIG_FS_PROCFS_EXCLUDE_POWER)
 	{"power/domains**", &power_procfsoperations},
 #endif
@@ -164,6 +177,14 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"version", &version_operations},
 #endif
 
+#if defined(CONFIG_SCHED_WAKEUP_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WAKEUPS)
+	{"wakeups", &wakeups_operations},
+#endif
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+	{"wqueue", &wqueue_operations},
+#endif
+
 #if defined(CONFIG_CM) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CONNECTIVITY)
 	{"connectivity**", &cm_operations},
 #endif
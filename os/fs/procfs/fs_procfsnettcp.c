@@ -0,0 +1,415 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfsnettcp.c
+ *
+ *   Reports the statistics of the active TCP connections, one line per
+ *   connection.  Times are in milliseconds, windows and queues in bytes
+ *   except SNDQL which counts the pbufs waiting in the send queues.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/net/net.h>
+#include <tinyara/netmgr/netctl.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_NET_TCP_PCB_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_NET_TCP)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* A line holds two IPv6 endpoints and the counters */
+
+#define NETTCP_LINELEN 256
+
+/* Connections may be opened between counting them and copying them */
+
+#define NETTCP_SLACK   4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct nettcp_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	size_t linesize;			/* Number of valid characters in line[] */
+	FAR char *line;				/* Formatted snapshot, NULL before the first read */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int nettcp_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int nettcp_close(FAR struct file *filep);
+static ssize_t nettcp_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int nettcp_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int nettcp_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Indexed by the lwIP enum tcp_state */
+
+static FAR const char *g_nettcp_states[] = {
+	"CLOSED", "LISTEN", "SYN_S", "SYN_R", "ESTAB", "FIN_1",
+	"FIN_2", "CL_WT", "CLSNG", "L_ACK", "T_WT"
+};
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations net_tcp_operations = {
+	nettcp_open,				/* open */
+	nettcp_close,				/* close */
+	nettcp_read,				/* read */
+	NULL,						/* write */
+
+	nettcp_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	nettcp_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nettcp_addr
+ *
+ * Description:
+ *   Format an endpoint as addr:port, or [addr]:port for IPv6.
+ *
+ ****************************************************************************/
+
+static void nettcp_addr(FAR const struct sockaddr_storage *ss, FAR char *buf, size_t len)
+{
+	char addr[INET6_ADDRSTRLEN];
+
+#ifdef CONFIG_NET_IPv6
+	if (ss->ss_family == AF_INET6) {
+		FAR const struct sockaddr_in6 *sin6 = (FAR const struct sockaddr_in6 *)ss;
+		inet_ntop(AF_INET6, &sin6->sin6_addr, addr, sizeof(addr));
+		snprintf(buf, len, "[%s]:%u", addr, ntohs(sin6->sin6_port));
+		return;
+	}
+#endif
+	FAR const struct sockaddr_in *sin = (FAR const struct sockaddr_in *)ss;
+	inet_ntop(AF_INET, &sin->sin_addr, addr, sizeof(addr));
+	snprintf(buf, len, "%s:%u", addr, ntohs(sin->sin_port));
+}
+
+/****************************************************************************
+ * Name: nettcp_snapshot
+ *
+ * Description:
+ *   Replace the formatted text with the current state of the connections.
+ *
+ ****************************************************************************/
+
+static int nettcp_snapshot(FAR struct nettcp_file_s *attr)
+{
+	FAR struct netmon_tcp_stats *stats;
+	char local[INET6_ADDRSTRLEN + 8];
+	char remote[INET6_ADDRSTRLEN + 8];
+	size_t buflen;
+	int count;
+	int max;
+	int i;
+
+	if (attr->line) {
+		kmm_free(attr->line);
+		attr->line = NULL;
+	}
+	attr->linesize = 0;
+
+	count = net_tcpstats(NULL, 0);
+	if (count < 0) {
+		return count;
+	}
+
+	max = count + NETTCP_SLACK;
+	stats = (FAR struct netmon_tcp_stats *)kmm_malloc(max * sizeof(struct netmon_tcp_stats));
+	if (!stats) {
+		return -ENOMEM;
+	}
+
+	count = net_tcpstats(stats, max);
+	if (count < 0) {
+		kmm_free(stats);
+		return count;
+	}
+	if (count > max) {
+		count = max;
+	}
+
+	buflen = (count + 1) * NETTCP_LINELEN;
+	attr->line = (FAR char *)kmm_malloc(buflen);
+	if (!attr->line) {
+		kmm_free(stats);
+		return -ENOMEM;
+	}
+
+	attr->linesize = snprintf(attr->line, buflen, "%-21s %-21s %-6s %5s %5s %5s %5s %6s %6s %6s %6s %6s %5s %6s %8s %8s %10s %10s %6s\n", "LOCAL", "REMOTE", "STATE", "MSS", "SRTT", "RTTVAR", "RTO", "CWND", "SSTHR", "SNDWND", "RCVWND", "SNDQ", "SNDQL", "RCVQ", "SEGIN", "SEGOUT", "BYTESIN", "BYTESOUT", "RETX");
+
+	for (i = 0; i < count && attr->linesize < buflen; i++) {
+		FAR struct netmon_tcp_stats *st = &stats[i];
+
+		nettcp_addr(&st->local, local, sizeof(local));
+		nettcp_addr(&st->remote, remote, sizeof(remote));
+		attr->linesize += snprintf(&attr->line[attr->linesize], buflen - attr->linesize, "%-21s %-21s %-6s %5u %5lu %5lu %5lu %6lu %6lu %6lu %6lu %6lu %5u %6lu %8lu %8lu %10lu %10lu %6lu\n", local, remote, st->state < sizeof(g_nettcp_states) / sizeof(g_nettcp_states[0]) ? g_nettcp_states[st->state] : "?", st->mss, (unsigned long)st->srtt, (unsigned long)st->rttvar, (unsigned long)st->rto, (unsigned long)st->cwnd, (unsigned long)st->ssthresh, (unsigned long)st->snd_wnd, (unsigned long)st->rcv_wnd, (unsigned long)st->snd_queued, st->snd_queuelen, (unsigned long)st->rcv_queued, (unsigned long)st->segs_in, (unsigned long)st->segs_out, (unsigned long)st->bytes_in, (unsigned long)st->bytes_out, (unsigned long)st->retransmits);
+	}
+
+	if (attr->linesize > buflen - 1) {
+		attr->linesize = buflen - 1;
+	}
+
+	kmm_free(stats);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: nettcp_open
+ ****************************************************************************/
+
+static int nettcp_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct nettcp_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "net/tcp" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "net/tcp") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct nettcp_file_s *)kmm_zalloc(sizeof(struct nettcp_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: nettcp_close
+ ****************************************************************************/
+
+static int nettcp_close(FAR struct file *filep)
+{
+	FAR struct nettcp_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct nettcp_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the snapshot and the file attributes structure */
+
+	if (attr->line) {
+		kmm_free(attr->line);
+	}
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: nettcp_read
+ ****************************************************************************/
+
+static ssize_t nettcp_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct nettcp_file_s *attr;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct nettcp_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Take the snapshot on the first read so that the statistics stay
+	 * consistent if the user reads the file in several pieces.
+	 */
+
+	if (filep->f_pos == 0) {
+		ret = nettcp_snapshot(attr);
+		if (ret < 0) {
+			fdbg("ERROR: Failed to collect the statistics: %d\n", (int)ret);
+			return ret;
+		}
+	}
+
+	if (!attr->line) {
+		return 0;
+	}
+
+	/* Transfer the statistics to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: nettcp_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int nettcp_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct nettcp_file_s *oldattr;
+	FAR struct nettcp_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct nettcp_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct nettcp_file_s *)kmm_malloc(sizeof(struct nettcp_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new,
+	 * giving the new file its own copy of the snapshot.
+	 */
+
+	memcpy(newattr, oldattr, sizeof(struct nettcp_file_s));
+	if (oldattr->line) {
+		newattr->line = (FAR char *)kmm_malloc(oldattr->linesize + 1);
+		if (!newattr->line) {
+			kmm_free(newattr);
+			fdbg("ERROR: Failed to allocate the snapshot\n");
+			return -ENOMEM;
+		}
+		memcpy(newattr->line, oldattr->line, oldattr->linesize);
+	}
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: nettcp_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int nettcp_stat(const char *relpath, struct stat *buf)
+{
+	/* "net/tcp" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "net/tcp") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "net/tcp" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_NET_TCP_PCB_STATS && !CONFIG_FS_PROCFS_EXCLUDE_NET_TCP */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -0,0 +1,348 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfswakeups.c
+ *
+ *   Reports the timer wakeups by source: watchdogs started by interrupt
+ *   handlers, by threads that have exited, by each live thread, and the
+ *   expirations that were served by an earlier timer event.  PER_SEC is
+ *   the count of the last complete one second window.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/clock.h>
+#include <tinyara/sched.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_WAKEUP_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WAKEUPS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to hold the header, the three other sources and one line for each thread.
+ */
+
+#define WAKEUPS_LINELEN 48
+#define WAKEUPS_BUFLEN  ((CONFIG_MAX_TASKS + 4) * WAKEUPS_LINELEN)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wakeups_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	unsigned int linesize;		/* Number of valid characters in line[] */
+	char line[WAKEUPS_BUFLEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/* Snapshot of the live threads */
+
+struct wakeups_pids_s {
+	int npids;
+	pid_t pid[CONFIG_MAX_TASKS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int wakeups_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int wakeups_close(FAR struct file *filep);
+static ssize_t wakeups_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int wakeups_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int wakeups_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wakeups_operations = {
+	wakeups_open,				/* open */
+	wakeups_close,				/* close */
+	wakeups_read,				/* read */
+	NULL,						/* write */
+
+	wakeups_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	wakeups_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wakeups_enum
+ ****************************************************************************/
+
+static void wakeups_enum(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	FAR struct wakeups_pids_s *pids = (FAR struct wakeups_pids_s *)arg;
+
+	if (pids->npids < CONFIG_MAX_TASKS) {
+		pids->pid[pids->npids++] = tcb->pid;
+	}
+}
+
+/****************************************************************************
+ * Name: wakeups_line
+ *
+ * Description:
+ *   Format the wakeups of one source at the end of the buffer.  Threads
+ *   that never caused a wakeup are skipped.
+ *
+ ****************************************************************************/
+
+static void wakeups_line(FAR struct wakeups_file_s *attr, FAR const char *name, int source)
+{
+	struct wakeup_count_s wakeups;
+
+	if (clock_wakeups(source, &wakeups) != OK || (source >= 0 && wakeups.total == 0)) {
+		return;
+	}
+
+	attr->linesize += snprintf(&attr->line[attr->linesize], WAKEUPS_BUFLEN - attr->linesize, "%5d %-16.16s %10lu %7u\n", source, name, (unsigned long)wakeups.total, wakeups.rate);
+}
+
+/****************************************************************************
+ * Name: wakeups_open
+ ****************************************************************************/
+
+static int wakeups_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct wakeups_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "wakeups" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wakeups") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct wakeups_file_s *)kmm_zalloc(sizeof(struct wakeups_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wakeups_close
+ ****************************************************************************/
+
+static int wakeups_close(FAR struct file *filep)
+{
+	FAR struct wakeups_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wakeups_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wakeups_read
+ ****************************************************************************/
+
+static ssize_t wakeups_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct wakeups_file_s *attr;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wakeups_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Take the snapshot on the first read so that the report stays
+	 * consistent if the user reads the file in several pieces.
+	 */
+
+	if (filep->f_pos == 0) {
+		struct wakeups_pids_s pids;
+#if CONFIG_TASK_NAME_SIZE > 0
+		FAR struct tcb_s *tcb;
+#endif
+		FAR const char *name;
+		int i;
+
+		attr->linesize = snprintf(attr->line, WAKEUPS_BUFLEN, "%5s %-16s %10s %7s\n", "PID", "SOURCE", "TOTAL", "PER_SEC");
+		wakeups_line(attr, "<irq>", WAKEUP_SOURCE_IRQ);
+		wakeups_line(attr, "<exited>", WAKEUP_SOURCE_EXITED);
+		wakeups_line(attr, "<coalesced>", WAKEUP_SOURCE_COALESCED);
+
+		pids.npids = 0;
+		sched_foreach(wakeups_enum, &pids);
+		for (i = 0; i < pids.npids; i++) {
+			name = "<noname>";
+#if CONFIG_TASK_NAME_SIZE > 0
+			tcb = sched_gettcb(pids.pid[i]);
+			if (tcb != NULL) {
+				name = tcb->name;
+			}
+#endif
+			wakeups_line(attr, name, pids.pid[i]);
+		}
+	}
+
+	/* Transfer the report to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: wakeups_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wakeups_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct wakeups_file_s *oldattr;
+	FAR struct wakeups_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct wakeups_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct wakeups_file_s *)kmm_malloc(sizeof(struct wakeups_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct wakeups_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wakeups_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wakeups_stat(const char *relpath, struct stat *buf)
+{
+	/* "wakeups" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wakeups") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "wakeups" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_WAKEUP_STATS && !CONFIG_FS_PROCFS_EXCLUDE_WAKEUPS */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
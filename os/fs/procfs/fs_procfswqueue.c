@@ -0,0 +1,310 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfswqueue.c
+ *
+ *   Reports the statistics of the kernel work queues, one line per queue.
+ *   Latencies are in clock ticks, measured from the time work became due
+ *   until its worker was called.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/wqueue.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to hold the header and one line for each kernel work queue.
+ */
+
+#define WQUEUE_LINELEN 64
+#define WQUEUE_BUFLEN  (3 * WQUEUE_LINELEN)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	unsigned int linesize;		/* Number of valid characters in line[] */
+	char line[WQUEUE_BUFLEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wqueue_operations = {
+	wqueue_open,				/* open */
+	wqueue_close,				/* close */
+	wqueue_read,				/* read */
+	NULL,						/* write */
+
+	wqueue_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	wqueue_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_line
+ *
+ * Description:
+ *   Format the statistics of one work queue at the end of the buffer.
+ *
+ ****************************************************************************/
+
+static void wqueue_line(FAR struct wqueue_file_s *attr, FAR const char *name, int qid)
+{
+	struct work_stats_s stats;
+	unsigned long avglatency;
+
+	if (work_getstats(qid, &stats) != OK) {
+		return;
+	}
+
+	avglatency = stats.nrun > 0 ? (unsigned long)(stats.totlatency / stats.nrun) : 0;
+	attr->linesize += snprintf(&attr->line[attr->linesize], WQUEUE_BUFLEN - attr->linesize, "%-6s %8lu %8lu %5u %5u %5u %6lu %6lu\n", name, (unsigned long)stats.nqueued, (unsigned long)stats.nrun, stats.nready, stats.ndelayed, stats.maxpending, (unsigned long)stats.maxlatency, avglatency);
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct wqueue_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "wqueue" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wqueue") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct wqueue_file_s *)kmm_zalloc(sizeof(struct wqueue_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+	FAR struct wqueue_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wqueue_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct wqueue_file_s *attr;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wqueue_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Take the snapshot on the first read so that the statistics stay
+	 * consistent if the user reads the file in several pieces.
+	 */
+
+	if (filep->f_pos == 0) {
+		attr->linesize = snprintf(attr->line, WQUEUE_BUFLEN, "%-6s %8s %8s %5s %5s %5s %6s %6s\n", "QUEUE", "QUEUED", "RUN", "READY", "DELAY", "PEAK", "MAXLAT", "AVGLAT");
+#ifdef CONFIG_SCHED_HPWORK
+		wqueue_line(attr, HPWORKNAME, HPWORK);
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+		wqueue_line(attr, LPWORKNAME, LPWORK);
+#endif
+	}
+
+	/* Transfer the statistics to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct wqueue_file_s *oldattr;
+	FAR struct wqueue_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct wqueue_file_s *)kmm_malloc(sizeof(struct wqueue_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(const char *relpath, struct stat *buf)
+{
+	/* "wqueue" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wqueue") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "wqueue" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_WORKQUEUE_STATS && !CONFIG_FS_PROCFS_EXCLUDE_WQUEUE */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
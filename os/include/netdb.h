@@ -164,6 +164,33 @@ void freeaddrinfo(struct addrinfo *ai);
 */
 int getaddrinfo(const char *nodename, const char *servname, const struct addrinfo *hints, struct addrinfo **res);
 
+#ifdef CONFIG_NET_DNS_ASYNC
+/**
+* @brief Completion callback of getaddrinfo_async()
+*
+* @param[in] result 0 on success, otherwise a fail number
+* @param[in] res the result on success, to be freed with freeaddrinfo(), otherwise NULL
+* @param[in] arg the argument given to getaddrinfo_async()
+*/
+typedef void (*getaddrinfo_cb_t)(int result, struct addrinfo *res, void *arg);
+
+/**
+* @brief getaddrinfo_async() starts the lookup getaddrinfo() does and returns without waiting for the DNS server.
+*
+* cb is called exactly once: before getaddrinfo_async() returns when the answer is cached,
+* otherwise from the network stack thread, so it must not block.
+*
+* @param[in] nodename can be among a domain name, ip address and NULL
+* @param[in] servname can be a port number passed as string or a service name
+* @param[in] hints can be either NULL or an addrinfo structure with the type of service requested
+* @param[in] cb is the completion callback
+* @param[in] arg is passed to cb
+* @return On success, 0 is returned and cb will be called. On failure, a fail number is returned
+* @since TizenRT v3.1
+*/
+int getaddrinfo_async(const char *nodename, const char *servname, const struct addrinfo *hints, getaddrinfo_cb_t cb, void *arg);
+#endif
+
 /**
 * @brief getnameinfo() is a function that returns translated string from 32bit(ipv4)/128bit(ipv6) IP address. As lwip doesn't support rarp and relative functions it has restricted usage.
 *
@@ -204,6 +204,18 @@
 #define _PTHREAD_MFLAGS_INCONSISTENT  (1 << 1)	/* Mutex is in an inconsistent state */
 #define _PTHREAD_MFLAGS_NRECOVERABLE  (1 << 2)	/* Inconsistent mutex has been unlocked */
 
+/*
+ * Values for struct pthread_mutex_s lockword.  Zero means that the mutex is
+ * free.  Any other value without _PTHREAD_LOCKWORD_KERNEL is a stack address
+ * of the thread that took the mutex in user space, without the kernel
+ * knowing.  _PTHREAD_LOCKWORD_KERNEL means that the kernel tracks the holder
+ * and every operation must go through the system call.
+ */
+#ifdef CONFIG_PTHREAD_MUTEX_USERFAST
+#define _PTHREAD_LOCKWORD_FREE        0
+#define _PTHREAD_LOCKWORD_KERNEL      (1 << 0)
+#endif
+
 /*
  * Maximum values of pthread key operation
  */
@@ -562,6 +574,26 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex);
  */
 int pthread_mutex_unlock(FAR pthread_mutex_t *mutex);
 
+#if defined(CONFIG_PTHREAD_MUTEX_USERFAST) && !defined(__KERNEL__)
+/* In user space, uncontended lock and unlock of non-robust NORMAL mutexes
+ * complete with an atomic operation on the lock word.  The system calls
+ * above are only made to block, to wake a waiter or for the other mutex
+ * types.
+ */
+
+int pthread_mutex_fastlock(FAR pthread_mutex_t *mutex);
+int pthread_mutex_fasttrylock(FAR pthread_mutex_t *mutex);
+int pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex);
+
+/* The syscall proxies and stubs define and call the real entry points */
+
+#ifndef __SYSCALL_BUILD__
+#define pthread_mutex_lock(m)    pthread_mutex_fastlock(m)
+#define pthread_mutex_trylock(m) pthread_mutex_fasttrylock(m)
+#define pthread_mutex_unlock(m)  pthread_mutex_fastunlock(m)
+#endif
+#endif
+
 /**
  * @cond
  * @internal
@@ -130,10 +130,9 @@ struct sem_s {
 
 	uint8_t flags;			/* See definitions for the struct sem_s flags */
 #ifdef SAVE_SEM_HOLDER
+	struct semholder_s holder;	/* Embedded holder, always checked first */
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-	FAR struct semholder_s *hhead;	/* List of holders of semaphore counts */
-#else
-	struct semholder_s holder;	/* Single holder */
+	FAR struct semholder_s *hhead;	/* List of additional holders of semaphore counts */
 #endif
 #endif
 };
@@ -153,13 +152,13 @@ typedef struct sem_s sem_t;
 #ifdef SAVE_SEM_HOLDER
 #ifdef CONFIG_BINARY_MANAGER
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#define SEM_INITIALIZER(c) {NULL, (c), FLAGS_INITIALIZED, NULL} /* flink, semcount, flags, hhead */
+#define SEM_INITIALIZER(c) {NULL, (c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER, NULL} /* flink, semcount, flags, holder, hhead */
 #else
 #define SEM_INITIALIZER(c) {NULL, (c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER} /* flink, semcount, flags, holder */
 #endif
 #else // CONFIG_BINARY_MANAGER
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#define SEM_INITIALIZER(c) {(c), FLAGS_INITIALIZED, NULL} /* semcount, flags, hhead */
+#define SEM_INITIALIZER(c) {(c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER, NULL} /* semcount, flags, holder, hhead */
 #else
 #define SEM_INITIALIZER(c) {(c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER} /* semcount, flags, holder */
 #endif
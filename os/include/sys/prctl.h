@@ -96,6 +96,19 @@
  *
  *      char myname[CONFIG_TASK_NAME_SIZE];
  *      prctl(PR_GET_NAME_BYPID, myname, 0);
+ *
+ *  PR_SET_TIMERSLACK
+ *    Set the timer slack of the calling thread to arg1 (unsigned long)
+ *    microseconds.  Watchdogs started by the thread may expire up to that
+ *    much later so that they can be served together with other timers.
+ *    The slack is truncated to whole system ticks, so a value below one
+ *    tick disables coalescing.  Requires CONFIG_SCHED_TIMER_SLACK.  As an
+ *    example:
+ *
+ *      prctl(PR_SET_TIMERSLACK, 5000);
+ *
+ *  PR_GET_TIMERSLACK
+ *    Return the timer slack of the calling thread in microseconds.
  */
 
 /**
@@ -123,6 +136,8 @@ enum prctl_type_e {
 	PR_REBOOT_REASON_READ,
 	PR_REBOOT_REASON_WRITE,
 	PR_REBOOT_REASON_CLEAR,
+	PR_SET_TIMERSLACK,
+	PR_GET_TIMERSLACK,
 };
 
 /****************************************************************************
@@ -122,6 +122,12 @@ extern "C" {
 #ifndef AF_UNSPEC
 #define AF_UNSPEC PF_UNSPEC
 #endif
+#ifndef AF_UNIX
+#define AF_UNIX PF_UNIX
+#endif
+#ifndef AF_LOCAL
+#define AF_LOCAL PF_LOCAL
+#endif
 #ifndef AF_INET
 #define AF_INET PF_INET
 #endif
@@ -129,6 +135,12 @@ extern "C" {
 #define AF_INET6 PF_INET6
 #endif
 
+/* Socket-level control message types */
+
+#ifndef SCM_RIGHTS
+#define SCM_RIGHTS 0x01 /* Pass file descriptors over an AF_UNIX socket */
+#endif
+
 /****************************************************************************
  * Public Structure
  ****************************************************************************/
@@ -143,6 +155,13 @@ struct msghdr {
 	int msg_flags;                 /* flags on received message */
 };
 
+struct timespec;
+
+struct mmsghdr {
+	struct msghdr msg_hdr;         /* message header */
+	unsigned int msg_len;          /* bytes transmitted for this message */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -363,6 +382,10 @@ int getpeername(int s, struct sockaddr *name, socklen_t *namelen);
 
 ssize_t recvmsg(int sockfd, struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, struct msghdr *msg, int flags);
+int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+int recv_zerocopy(int sockfd, struct iovec *iov, int iovcnt, void **handle, int flags);
+int recv_zerocopy_release(int sockfd, void *handle);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -2214,6 +2214,30 @@ bool is_kernel_text_space(void *addr);
  ****************************************************************************/
 bool is_kernel_data_space(void *addr);
 
+#ifdef CONFIG_NET_ARCH_CHKSUM
+/****************************************************************************
+ * Name: up_chksum
+ *
+ * Description:
+ *   Calculate the 16-bit one's complement sum of len bytes at data, which
+ *   may have any alignment.  The sum is not inverted and is in the byte
+ *   order of the data.
+ *
+ ****************************************************************************/
+uint16_t up_chksum(FAR const void *data, int len);
+
+/****************************************************************************
+ * Name: up_chksum_copy
+ *
+ * Description:
+ *   Copy len bytes from src to dst and return the sum of the copied data
+ *   as up_chksum() would, reading the data only once.
+ *
+ ****************************************************************************/
+uint16_t up_chksum_copy(FAR void *dst, FAR const void *src, uint16_t len);
+
+#endif
+
 #ifdef CONFIG_BUILD_PROTECTED
 /****************************************************************************
  * Name: is_kernel_space
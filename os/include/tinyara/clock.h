@@ -211,6 +211,26 @@ struct cpuload_s {
 #endif
 #endif
 
+/* This structure is used to report the timer wakeups caused by one source.
+ * The count is kept in one second windows; rate holds the count of the
+ * last complete window.
+ */
+
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+struct wakeup_count_s {
+	uint32_t total;				/* Total number of wakeups */
+	uint16_t count;				/* Wakeups in the current window */
+	uint16_t rate;				/* Wakeups in the last complete window */
+	clock_t start;				/* Start time of the current window */
+};
+
+/* Wakeup sources other than a thread, see clock_wakeups() */
+
+#define WAKEUP_SOURCE_IRQ       (-1)	/* Watchdogs started by interrupt handlers */
+#define WAKEUP_SOURCE_EXITED    (-2)	/* Watchdogs of threads that have exited */
+#define WAKEUP_SOURCE_COALESCED (-3)	/* Expirations sharing an earlier wakeup */
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -370,6 +390,35 @@ int clock_cpuload(int pid, int index, FAR struct cpuload_s *cpuload);
  */
 #endif
 
+/****************************************************************************
+ * Function:  clock_wakeups
+ *
+ * Description:
+ *   Return the timer wakeups caused by one source.
+ *
+ * Parameters:
+ *   source - The task ID of the thread of interest or one of the
+ *            WAKEUP_SOURCE_* values
+ *   wakeups - The location to return the wakeup counts
+ *
+ * Return Value:
+ *   OK (0) on success; a negated errno value on failure.  The only reason
+ *   that this function can fail is if 'source' no longer refers to a valid
+ *   thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+/**
+ * @cond
+ * @internal
+ */
+int clock_wakeups(int source, FAR struct wakeup_count_s *wakeups);
+/**
+ * @endcond
+ */
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
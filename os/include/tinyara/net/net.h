@@ -464,6 +464,28 @@ int net_ioctl(int sockfd, int cmd, unsigned long arg);
  ****************************************************************************/
 
 int netdev_foreach(netdev_callback_t callback, void *arg);
+
+#ifdef CONFIG_NET_TCP_PCB_STATS
+/****************************************************************************
+ * Function: net_tcpstats
+ *
+ * Description:
+ *   Take a snapshot of the statistics of every active TCP connection.
+ *
+ * Parameters:
+ *   stats - Array to fill, may be NULL if max is 0
+ *   max   - Number of entries in stats
+ *
+ * Returned Value:
+ *   The number of active connections, which may be larger than max; only
+ *   the first max of them are copied.  A negated errno value on failure.
+ *
+ ****************************************************************************/
+
+struct netmon_tcp_stats;		/* Forward reference. Defined in netmgr/netctl.h */
+int net_tcpstats(FAR struct netmon_tcp_stats *stats, int max);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
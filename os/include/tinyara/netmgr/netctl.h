@@ -20,6 +20,8 @@
 
 #if CONFIG_NET_LWIP
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
 
 typedef enum {
 	GETADDRINFO,
@@ -36,6 +38,8 @@ typedef enum {
 	GETNETSTATS, /*  get network statistics */
 	GETSOCKINFO, /*  get opened socket information */
 	GETDEVSTATS, /*  get NIC statistics */
+	GETADDRINFO_ASYNC, /*  resolve without blocking the caller */
+	GETTCPSTATS, /*  get per-connection TCP statistics */
 } req_type;
 
 struct lwip_netdb_msg {
@@ -49,6 +53,9 @@ struct lwip_netdb_msg {
 	size_t host_len;
 	size_t serv_len;
 	int flags;
+	/* completion callback of GETADDRINFO_ASYNC */
+	void (*ai_cb)(int result, struct addrinfo *res, void *arg);
+	void *ai_cb_arg;
 };
 
 struct lwip_dns_msg {
@@ -68,6 +75,35 @@ struct lwip_netmon_msg {
 	const char *ifname;
 };
 
+/* One TCP connection as reported by GETTCPSTATS and /proc/net/tcp */
+struct netmon_tcp_stats {
+	struct sockaddr_storage local;
+	struct sockaddr_storage remote;
+	uint8_t state;          /* enum tcp_state */
+	uint16_t mss;
+	uint32_t srtt;          /* smoothed RTT in ms, 0 before the first sample */
+	uint32_t rttvar;        /* RTT variance in ms */
+	uint32_t rto;           /* retransmission timeout in ms */
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t snd_wnd;
+	uint32_t rcv_wnd;
+	uint32_t snd_queued;    /* bytes written but not yet acknowledged */
+	uint16_t snd_queuelen;  /* pbufs in the send queues */
+	uint32_t rcv_queued;    /* bytes received but not yet read */
+	uint32_t segs_in;
+	uint32_t segs_out;
+	uint32_t bytes_in;
+	uint32_t bytes_out;
+	uint32_t retransmits;
+};
+
+struct lwip_tcpstats_msg {
+	struct netmon_tcp_stats *stats;
+	int max;                /* entries in stats */
+	int count;              /* connections found, may exceed max */
+};
+
 /* To send a request to lwip stack by ioctl() use */
 struct req_lwip_data {
 	req_type type;
@@ -77,6 +113,7 @@ struct req_lwip_data {
 		struct lwip_dns_msg dns;
 		struct lwip_dhcp_msg dhcp;
 		struct lwip_netmon_msg netmon;
+		struct lwip_tcpstats_msg tcpstats;
 	} msg;
 };
 
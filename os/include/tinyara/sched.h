@@ -561,6 +561,12 @@ struct tcb_s {
 	int timeslice;				/* RR timeslice interval remaining     */
 #endif
 	FAR struct wdog_s *waitdog;	/* All timed waits used this wdog      */
+#ifdef CONFIG_SCHED_TIMER_SLACK
+	uint32_t timer_slack;		/* Allowed deferral of watchdogs (ticks) */
+#endif
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+	struct wakeup_count_s wakeups;	/* Wakeups caused by this thread   */
+#endif
 
 	/* Stack-Related Fields ****************************************************** */
 
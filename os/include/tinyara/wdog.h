@@ -152,6 +152,9 @@ struct wdog_s {
 	int lag;					/* Timer associated with the delay */
 	uint8_t flags;				/* See WDOGF_* definitions above */
 	uint8_t argc;				/* The number of parameters to pass */
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+	pid_t pid;					/* Thread that started it, or WAKEUP_SOURCE_IRQ */
+#endif
 	uint32_t parm[CONFIG_MAX_WDOGPARMS];
 };
 
@@ -179,6 +182,9 @@ int wd_delete(WDOG_ID wdog);
 int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...);
 int wd_cancel(WDOG_ID wdog);
 int wd_gettime(WDOG_ID wdog);
+#if defined(CONFIG_SCHED_TICKSUPPRESS) || defined(CONFIG_PM)
+int wd_getdelay(void);
+#endif
 
 #undef EXTERN
 #ifdef __cplusplus
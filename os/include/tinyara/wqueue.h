@@ -289,6 +289,23 @@ struct work_s {
 	clock_t delay;			/* Delay until work performed */
 };
 
+/* Statistics kept by each work queue when CONFIG_SCHED_WORKQUEUE_STATS is
+ * selected.  Latencies are measured in clock ticks from the time the work
+ * became due (qtime + delay) until its worker was called.
+ */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct work_stats_s {
+	uint32_t nqueued;			/* Number of work items queued */
+	uint32_t nrun;				/* Number of work items performed */
+	uint16_t nready;			/* Work currently due and waiting for a worker */
+	uint16_t ndelayed;			/* Work currently waiting for its delay */
+	uint16_t maxpending;		/* Peak of nready + ndelayed */
+	clock_t maxlatency;			/* Longest latency observed */
+	uint64_t totlatency;		/* Sum of all latencies */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -432,6 +449,27 @@ int work_cancel(int qid, FAR struct work_s *work);
 
 int work_signal(int qid);
 
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Take a snapshot of the statistics of a kernel work queue.
+ *
+ * Input parameters:
+ *   qid   - The work queue ID
+ *   stats - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && (defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK))
+int work_getstats(int qid, FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: work_available
  *
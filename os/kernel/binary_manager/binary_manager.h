@@ -151,6 +151,8 @@ struct binmgr_uinfo_s {
 	sq_queue_t cb_list; // list node type : statecb_node_t
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 	struct binary_s *binp;
+	uint8_t load_idx;		/* Partition index which binp was loaded from */
+	uint32_t load_crc;		/* Header crc of the binary which binp was loaded from */
 #endif
 };
 typedef struct binmgr_uinfo_s binmgr_uinfo_t;
@@ -227,6 +229,8 @@ binmgr_uinfo_t *binary_manager_get_udata(uint32_t bin_idx);
 #define BIN_PRIORITY(bin_idx)                           binary_manager_get_udata(bin_idx)->load_attr.priority
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 #define BIN_LOADINFO(bin_idx)                           binary_manager_get_udata(bin_idx)->binp
+#define BIN_LOADIDX(bin_idx)                            binary_manager_get_udata(bin_idx)->load_idx
+#define BIN_LOADCRC(bin_idx)                            binary_manager_get_udata(bin_idx)->load_crc
 #endif
 
 /****************************************************************************
@@ -41,6 +41,7 @@
 #include <tinyara/sched.h>
 #include <tinyara/init.h>
 #include <tinyara/kthread.h>
+#include <tinyara/kmalloc.h>
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 #include <tinyara/binfmt/binfmt.h>
 #endif
@@ -147,6 +148,100 @@ static int binary_manager_load_binary(int bin_idx, char *path, load_attr_t *load
 	return ERROR;
 }
 
+#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+/****************************************************************************
+ * Name: binary_manager_release_loadinfo
+ *
+ * Description:
+ *	 This function frees the loading sections kept in RAM for reloading.
+ *
+ ****************************************************************************/
+static void binary_manager_release_loadinfo(int bin_idx)
+{
+	struct binary_s *binp;
+
+	binp = BIN_LOADINFO(bin_idx);
+	if (!binp) {
+		return;
+	}
+
+	binp->reload = false;
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	if (bin_idx == BM_CMNLIB_IDX) {
+		(void)unload_module(binp);
+		kmm_free(binp);
+		g_lib_binp = NULL;
+	} else
+#endif
+	{
+		binfmt_exit(binp);
+	}
+	BIN_LOADINFO(bin_idx) = NULL;
+}
+
+/****************************************************************************
+ * Name: binary_manager_check_loadinfo
+ *
+ * Description:
+ *	 The loading sections kept in RAM were verified with signature and crc
+ *	 when they were loaded first. They are reused only if the partition to
+ *	 load still holds the same binary, which is checked with the crc and
+ *	 version in its header. Otherwise, they are released and the binary is
+ *	 loaded from the partition again.
+ *
+ ****************************************************************************/
+static void binary_manager_check_loadinfo(int bin_idx)
+{
+	int ret;
+	uint32_t crc_hash;
+	uint32_t version;
+	char devpath[BINARY_PATH_LEN];
+	user_binary_header_t user_header_data;
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	int uidx;
+	uint32_t bin_count;
+	common_binary_header_t common_header_data;
+#endif
+
+	if (!BIN_LOADINFO(bin_idx)) {
+		return;
+	}
+
+	if (BIN_LOADIDX(bin_idx) == BIN_USEIDX(bin_idx)) {
+		snprintf(devpath, BINARY_PATH_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx))));
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+		if (bin_idx == BM_CMNLIB_IDX) {
+			ret = binary_manager_read_header(BINARY_COMMON, devpath, &common_header_data, false);
+			crc_hash = common_header_data.crc_hash;
+			version = common_header_data.version;
+		} else
+#endif
+		{
+			ret = binary_manager_read_header(BINARY_USERAPP, devpath, &user_header_data, false);
+			crc_hash = user_header_data.crc_hash;
+			version = user_header_data.bin_ver;
+		}
+		if (ret == BINMGR_OK && crc_hash == BIN_LOADCRC(bin_idx) && version == BIN_LOADVER(bin_idx)) {
+			bmvdbg("Reuse loaded sections of %s, version %u\n", BIN_NAME(bin_idx), version);
+			return;
+		}
+	}
+
+	bmdbg("Release loaded sections of %s, binary in %s is changed\n", BIN_NAME(bin_idx), GET_PARTNAME(BIN_USEIDX(bin_idx)));
+	binary_manager_release_loadinfo(bin_idx);
+
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	/* User binaries are relocated against common binary, so they can't be reused with new common binary */
+	if (bin_idx == BM_CMNLIB_IDX) {
+		bin_count = binary_manager_get_ucount();
+		for (uidx = 1; uidx <= bin_count; uidx++) {
+			binary_manager_release_loadinfo(uidx);
+		}
+	}
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: binary_manager_load
  *
@@ -167,6 +262,7 @@ static int binary_manager_load(int bin_idx)
 #endif
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 	struct binary_s *binp;
+	uint32_t crc_hash = 0;
 #endif
 
 	if (bin_idx < 0) {
@@ -181,6 +277,7 @@ static int binary_manager_load(int bin_idx)
 	}
 
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+	binary_manager_check_loadinfo(bin_idx);
 	binp = BIN_LOADINFO(bin_idx);
 	if (binp) {
 		bin_count = 1;
@@ -251,6 +348,9 @@ static int binary_manager_load(int bin_idx)
 				load_attr.offset = CHECKSUM_SIZE + common_header_data.header_size;
 				load_attr.bin_size = common_header_data.bin_size;
 				load_attr.bin_ver = common_header_data.version;
+#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+				crc_hash = common_header_data.crc_hash;
+#endif
 #ifdef CONFIG_BINARY_SIGNING
 				load_attr.offset += USER_SIGN_PREPEND_SIZE;
 #endif
@@ -269,6 +369,9 @@ static int binary_manager_load(int bin_idx)
 				load_attr.offset += USER_SIGN_PREPEND_SIZE;
 #endif
 				load_attr.bin_ver = user_header_data.bin_ver;
+#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+				crc_hash = user_header_data.crc_hash;
+#endif
 			}
 		}
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
@@ -280,6 +383,13 @@ static int binary_manager_load(int bin_idx)
 
 		ret = binary_manager_load_binary(bin_idx, devpath, &load_attr);
 		if (ret == OK) {
+#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+			if (!binp) {
+				/* Remember which binary is kept in RAM for reloading */
+				BIN_LOADIDX(bin_idx) = BIN_USEIDX(bin_idx);
+				BIN_LOADCRC(bin_idx) = crc_hash;
+			}
+#endif
 			if (need_update_bp) {
 				/* Update boot param data because the binary not written to bootparam is loaded */
 				binmgr_bpdata_t update_bp_data;
@@ -315,9 +425,11 @@ static int binary_manager_load(int bin_idx)
  * Description:
  *   This function executes registered callbacks for 'unload' state,
  *   terminates all task/threads of binary, and unloads binary.
+ *   If keep_loaded is true or binary is faulty, loading sections are kept
+ *   in RAM to reload the same binary without reading it again.
  *
  ****************************************************************************/
-static int binary_manager_terminate_binary(int bin_idx)
+static int binary_manager_terminate_binary(int bin_idx, bool keep_loaded)
 {
 	int ret;
 	int binid;
@@ -333,7 +445,7 @@ static int binary_manager_terminate_binary(int bin_idx)
 #ifdef CONFIG_SUPPORT_COMMON_BINARY
 	if (bin_idx == BM_CMNLIB_IDX) {
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
-		if (BIN_STATE(bin_idx) == BINARY_FAULT) {
+		if ((BIN_STATE(bin_idx) == BINARY_FAULT || keep_loaded) && BIN_LOADINFO(bin_idx)) {
 			/* Set the flag to reload binary without freeing memory in unload_module for app reloading optimization. */
 			binp = BIN_LOADINFO(bin_idx);
 			binp->reload = true;
@@ -417,7 +529,7 @@ static int binary_manager_terminate_binary(int bin_idx)
 	}
 
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
-	if (state == BINARY_FAULT) {
+	if ((state == BINARY_FAULT || keep_loaded) && BIN_LOADINFO(bin_idx)) {
 		binp = BIN_LOADINFO(bin_idx);
 		binp->reload = true;
 	}
@@ -555,7 +667,7 @@ static int reloading_thread(int argc, char *argv[])
 
 	/* Unload all user binaries and common binary */
 	for (bidx = 0; bidx <= bin_count; bidx++) {
-		ret = binary_manager_terminate_binary(bidx);
+		ret = binary_manager_terminate_binary(bidx, false);
 		if (ret != OK) {
 			return BINMGR_OPERATION_FAIL;
 		}
@@ -565,7 +677,7 @@ static int reloading_thread(int argc, char *argv[])
 	load_cmd = LOADCMD_LOAD;
 
 	/* Unload the faulty binary */
-	ret = binary_manager_terminate_binary(bin_idx);
+	ret = binary_manager_terminate_binary(bin_idx, false);
 	if (ret != OK) {
 		return BINMGR_OPERATION_FAIL;
 	}
@@ -615,7 +727,8 @@ static int update_thread(int argc, char *argv[])
 	/* Else, Reload all binaries */
 	for (bin_idx = 1; bin_idx <= bin_count; bin_idx++) {
 		if (BIN_STATE(bin_idx) == BINARY_LOADED || BIN_STATE(bin_idx) == BINARY_RUNNING) {
-			ret = binary_manager_terminate_binary(bin_idx);
+			/* Keep loaded sections, they are reused if the binary is not updated */
+			ret = binary_manager_terminate_binary(bin_idx, true);
 			if (ret != OK) {
 				return BINMGR_OPERATION_FAIL;
 			}
@@ -625,7 +738,7 @@ static int update_thread(int argc, char *argv[])
 
 #ifdef CONFIG_SUPPORT_COMMON_BINARY
 	/* Finally, Unload common library */
-	ret = binary_manager_terminate_binary(BM_CMNLIB_IDX);
+	ret = binary_manager_terminate_binary(BM_CMNLIB_IDX, true);
 	if (ret != OK) {
 		return BINMGR_OPERATION_FAIL;
 	}
@@ -661,6 +774,9 @@ void binary_manager_release_binary_sem(int bin_idx)
 	sem_t *sem;
 	irqstate_t flags;
 	FAR struct semholder_s *holder;
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+	FAR struct semholder_s *next;
+#endif
 
 	flags = irqsave();
 
@@ -669,13 +785,15 @@ void binary_manager_release_binary_sem(int bin_idx)
 		bmdbg("g_sem_list is empty.\n");
 	} else {
 		do {
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-			for (holder = sem->hhead; holder; holder = holder->flink)
-#else
+			/* Check the built-in holder first, then any additional holders */
+
 			holder = &sem->holder;
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+			next = sem->hhead;
+			for (; holder; holder = next, next = next ? next->flink : NULL)
 #endif
 			{
-				if (holder && holder->htcb && holder->htcb->group && holder->htcb->group->tg_binidx == bin_idx) {
+				if (holder->htcb && holder->htcb->group && holder->htcb->group->tg_binidx == bin_idx) {
 					/* Increase semcount and release itself from holder */
 					sem->semcount++;
 
@@ -343,6 +343,11 @@ void os_start(void)
 	g_idletcb.cmn.task_state = TSTATE_TASK_RUNNING;
 	g_idletcb.cmn.entry.main = (main_t)os_start;
 	g_idletcb.cmn.flags = TCB_FLAG_TTYPE_KERNEL;
+#ifdef CONFIG_SCHED_TIMER_SLACK
+	/* Truncate to whole ticks as prctl(PR_SET_TIMERSLACK) does */
+
+	g_idletcb.cmn.timer_slack = CONFIG_SCHED_TIMER_SLACK_DEFAULT / USEC_PER_TICK;
+#endif
 
 	/* Set the IDLE task name */
 
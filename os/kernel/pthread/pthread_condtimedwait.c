@@ -212,6 +212,12 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
 	/* pthread_cond_timedwait() is a cancellation point */
 	(void)enter_cancellation_point();
 
+	/* Take over a mutex that was locked in user space */
+
+	if (mutex) {
+		pthread_mutex_adopt(mutex);
+	}
+
 	/* Make sure that non-NULL references were provided. */
 
 	if (!cond || !mutex) {
@@ -328,6 +334,7 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
 					svdbg("Re-locking...\n");
 
 					oldstate = pthread_disable_cancel();
+					pthread_mutex_adopt(mutex);
 					status = pthread_mutex_take(mutex, false);
 					pthread_enable_cancel(oldstate);
 
@@ -338,6 +345,8 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
 					}
 				}
 
+				pthread_mutex_disown(mutex);
+
 				/* Re-enable pre-emption (It is expected that interrupts
 				 * have already been re-enabled in the above logic)
 				 */
@@ -96,6 +96,12 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 	/* pthread_cond_wait() is a cancellation point */
 	(void)enter_cancellation_point();
 
+	/* Take over a mutex that was locked in user space */
+
+	if (mutex != NULL) {
+		pthread_mutex_adopt(mutex);
+	}
+
 	/* Make sure that non-NULL references were provided. */
 
 	if (cond == NULL || mutex == NULL) {
@@ -137,7 +143,11 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 		svdbg("Reacquire mutex...\n");
 
 		oldstate = pthread_disable_cancel();
+		sched_lock();
+		pthread_mutex_adopt(mutex);
 		status = pthread_mutex_take(mutex, false);
+		pthread_mutex_disown(mutex);
+		sched_unlock();
 		pthread_enable_cancel(oldstate);
 
 		if (ret == OK) {
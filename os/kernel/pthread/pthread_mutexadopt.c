@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/pthread/pthread_mutexadopt.c
+ *
+ *   Kernel side of the user-space mutex fast path.  A mutex that was taken
+ *   in user space is invisible to the kernel: its semaphore still has a
+ *   count of one.  Before the kernel operates on a mutex, it adopts it by
+ *   taking that count on behalf of the user-space holder.  When the kernel
+ *   is done and the mutex is free again, the lock word is given back to
+ *   user space.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/sched.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_USERFAST
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct pthread_owner_s {
+	uintptr_t stackaddr;		/* Stack address stored in the lock word */
+	FAR struct tcb_s *tcb;		/* Thread owning that stack, if any */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_matchstack
+ ****************************************************************************/
+
+static void pthread_mutex_matchstack(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	FAR struct pthread_owner_s *owner = (FAR struct pthread_owner_s *)arg;
+
+	if (owner->stackaddr >= (uintptr_t)tcb->stack_alloc_ptr && owner->stackaddr < (uintptr_t)tcb->adj_stack_ptr) {
+		owner->tcb = tcb;
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_adopt
+ *
+ * Description:
+ *   Make the kernel track the mutex.  If the lock word holds a user-space
+ *   owner, the count of the semaphore is taken on behalf of the thread
+ *   whose stack contains the stored address.  That thread becomes a
+ *   semaphore holder so that waiters can boost its priority.  Afterwards
+ *   the lock word is _PTHREAD_LOCKWORD_KERNEL and user-space lock and
+ *   unlock fall back to the system calls.
+ *
+ * Parameters:
+ *   mutex - The mutex about to be operated on by the kernel
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pthread_mutex_adopt(FAR struct pthread_mutex_s *mutex)
+{
+	struct pthread_owner_s owner;
+	irqstate_t flags;
+
+	DEBUGASSERT(mutex != NULL);
+
+	flags = irqsave();
+	if (mutex->lockword != _PTHREAD_LOCKWORD_FREE && (mutex->lockword & _PTHREAD_LOCKWORD_KERNEL) == 0) {
+		owner.stackaddr = (uintptr_t)mutex->lockword;
+		owner.tcb = NULL;
+		sched_foreach(pthread_mutex_matchstack, &owner);
+
+		/* The semaphore was never touched by the user-space holder */
+
+		DEBUGASSERT(mutex->sem.semcount == 1);
+		mutex->sem.semcount--;
+
+		if (owner.tcb != NULL) {
+			sem_addholder_tcb(owner.tcb, &mutex->sem);
+			mutex->pid = owner.tcb->pid;
+#ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
+			DEBUGASSERT(mutex->flink == NULL);
+			mutex->flink = ((FAR struct pthread_tcb_s *)owner.tcb)->mhead;
+			((FAR struct pthread_tcb_s *)owner.tcb)->mhead = mutex;
+#endif
+		} else {
+			sdbg("mutex=0x%p holder exited\n", mutex);
+		}
+	}
+
+	mutex->lockword = _PTHREAD_LOCKWORD_KERNEL;
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_disown
+ *
+ * Description:
+ *   Give the lock word back to user space if the mutex is free, so that the
+ *   next uncontended lock does not need a system call.
+ *
+ * Parameters:
+ *   mutex - The mutex the kernel has finished operating on
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pthread_mutex_disown(FAR struct pthread_mutex_s *mutex)
+{
+	irqstate_t flags;
+
+	DEBUGASSERT(mutex != NULL);
+
+	flags = irqsave();
+	if (mutex->sem.semcount > 0) {
+		mutex->lockword = _PTHREAD_LOCKWORD_FREE;
+	}
+	irqrestore(flags);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_USERFAST */
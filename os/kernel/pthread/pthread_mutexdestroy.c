@@ -125,6 +125,10 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
 
 		sched_lock();
 
+		/* Take over a mutex that was locked in user space */
+
+		pthread_mutex_adopt(mutex);
+
 		/* Is the semaphore available? */
 
 		if (mutex->pid >= 0) {
@@ -201,6 +205,7 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
 			ret = ((status != OK) ? get_errno() : OK);
 		}
 
+		pthread_mutex_disown(mutex);
 		sched_unlock();
 	}
 
@@ -178,6 +178,10 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
 		mutex->type = type;
 		mutex->nlocks = 0;
 #endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_USERFAST
+		mutex->lockword = _PTHREAD_LOCKWORD_FREE;
+#endif
 	}
 
 	svdbg("Returning %d\n", ret);
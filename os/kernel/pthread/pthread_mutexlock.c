@@ -157,6 +157,10 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 
 		sched_lock();
 
+		/* Take over a mutex that was locked in user space */
+
+		pthread_mutex_adopt(mutex);
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 		/* All mutex types except for NORMAL (and DEFAULT) will return
 		 * and an error  error if the caller does not hold the mutex.
@@ -248,6 +252,7 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 
 		}
 
+		pthread_mutex_disown(mutex);
 		sched_unlock();
 	}
 
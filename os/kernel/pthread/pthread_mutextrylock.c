@@ -137,6 +137,10 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
 
 		sched_lock();
 
+		/* Take over a mutex that was locked in user space */
+
+		pthread_mutex_adopt(mutex);
+
 		/* Try to get the semaphore. */
 
 		status = pthread_mutex_trytake(mutex);
@@ -229,6 +233,7 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
 				ret = status;
 			}
 
+		pthread_mutex_disown(mutex);
 		sched_unlock();
 	}
 
@@ -160,6 +160,10 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 	 */
 	sched_lock();
 
+	/* Take over a mutex that was locked in user space */
+
+	pthread_mutex_adopt(mutex);
+
 	/* The unlock operation is only performed if the mutex is actually locked.
 	 * EPERM *must* be returned if the mutex type is PTHREAD_MUTEX_ERRORCHECK
 	 * or PTHREAD_MUTEX_RECURSIVE, or the mutex is a robust mutex, and the
@@ -247,6 +251,7 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 			}
 	}
 
+	pthread_mutex_disown(mutex);
 	sched_unlock();
 	svdbg("Returning %d\n", ret);
 	return ret;
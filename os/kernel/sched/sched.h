@@ -253,10 +253,12 @@ int sched_reprioritize(FAR struct tcb_s *tcb, int sched_priority);
 
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int sched_timer_cancel(void);
+unsigned int sched_timer_elapsed(void);
 void sched_timer_resume(void);
 void sched_timer_reassess(void);
 #else
 #define sched_timer_cancel() (0)
+#define sched_timer_elapsed() (0)
 #define sched_timer_resume()
 #define sched_timer_reassess()
 #endif
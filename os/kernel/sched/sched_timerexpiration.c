@@ -138,6 +138,12 @@ static unsigned int g_timer_interval;
  */
 
 static struct timespec g_stop_time;
+#else
+/* This is the time that the interval timer was last started.  Only
+ * sched_timer_elapsed() uses it.
+ */
+
+static struct timespec g_start_time;
 #endif
 
 /************************************************************************
@@ -190,7 +196,6 @@ static void sched_timespec_add(FAR const struct timespec *ts1, FAR const struct
  *
  ************************************************************************/
 
-#ifdef CONFIG_SCHED_TICKLESS_ALARM
 static void sched_timespec_subtract(FAR const struct timespec *ts1, FAR const struct timespec *ts2, FAR struct timespec *ts3)
 {
 	time_t sec;
@@ -215,7 +220,6 @@ static void sched_timespec_subtract(FAR const struct timespec *ts1, FAR const st
 	ts3->tv_sec = sec;
 	ts3->tv_nsec = nsec;
 }
-#endif
 
 /************************************************************************
  * Name:  sched_process_timeslice
@@ -471,6 +475,7 @@ static void sched_timer_start(unsigned int ticks)
 #else
 		/* [Re-]start the interval timer */
 
+		(void)up_timer_gettime(&g_start_time);
 		ret = up_timer_start(&ts);
 #endif
 
@@ -650,6 +655,46 @@ unsigned int sched_timer_cancel(void)
 }
 #endif
 
+/****************************************************************************
+ * Name:  sched_timer_elapsed
+ *
+ * Description:
+ *   Return the number of ticks that have passed on the active timer and
+ *   have not yet been taken off the lag of the watchdog at the head of the
+ *   list.  Unlike sched_timer_cancel(), the timer is left running.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Elapsed ticks, or zero if no timer is active.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+unsigned int sched_timer_elapsed(void)
+{
+	struct timespec ts;
+	unsigned int elapsed;
+
+	if (g_timer_interval == 0) {
+		return 0;
+	}
+
+	(void)up_timer_gettime(&ts);
+#ifdef CONFIG_SCHED_TICKLESS_ALARM
+	sched_timespec_subtract(&ts, &g_stop_time, &ts);
+#else
+	sched_timespec_subtract(&ts, &g_start_time, &ts);
+#endif
+
+	elapsed = SEC2TICK(ts.tv_sec);
+	elapsed += NSEC2TICK(ts.tv_nsec);
+	return elapsed < g_timer_interval ? elapsed : g_timer_interval;
+}
+
 /****************************************************************************
  * Name:  sched_timer_resume
  *
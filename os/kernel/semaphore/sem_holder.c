@@ -110,27 +110,27 @@ static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
 
 	/* Check if the "built-in" holder is being used.  We have this built-in
 	 * holder to optimize for the simplest case where semaphores are only
-	 * used to implement mutexes.
+	 * used to implement mutexes.  The pre-allocated pool is only touched
+	 * when more than one thread holds counts at the same time.
 	 */
 
+	if (!sem->holder.htcb) {
+		pholder = &sem->holder;
+		pholder->counts = 0;
+	}
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-	pholder = g_freeholders;
-	if (pholder) {
+	else if (g_freeholders) {
 		/* Remove the holder from the free list an put it into the semaphore's
 		 * holder list
 		 */
 
+		pholder = g_freeholders;
 		g_freeholders = pholder->flink;
 		pholder->flink = sem->hhead;
 		sem->hhead = pholder;
 
 		/* Make sure the initial count is zero */
 
-		pholder->counts = 0;
-	}
-#else
-	if (!sem->holder.htcb) {
-		pholder = &sem->holder;
 		pholder->counts = 0;
 	}
 #endif
@@ -173,6 +173,12 @@ void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
 	pholder->counts = 0;
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
+	/* The built-in holder is not part of the list */
+
+	if (pholder == &sem->holder) {
+		return;
+	}
+
 	/* Search the list for the matching holder */
 
 	for (prev = NULL, curr = sem->hhead; curr && curr != pholder; prev = curr, curr = curr->flink) ;
@@ -206,25 +212,25 @@ static int sem_foreachholder(FAR sem_t *sem, holderhandler_t handler, FAR void *
 #endif
 	int ret = 0;
 
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-	for (pholder = sem->hhead; pholder && ret == 0; pholder = next)
-#else
+	/* The initial "built-in" container may hold a NULL holder */
+
 	pholder = &sem->holder;
-#endif
-	{
+	if (pholder->htcb) {
+		/* Call the handler */
+
+		ret = handler(pholder, sem, arg);
+	}
+
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
+	for (pholder = sem->hhead; pholder && ret == 0; pholder = next) {
 		/* In case this holder gets deleted */
 
 		next = pholder->flink;
-#endif
-		/* The initial "built-in" container may hold a NULL holder */
-
 		if (pholder->htcb) {
-			/* Call the handler */
-
 			ret = handler(pholder, sem, arg);
 		}
 	}
+#endif
 
 	return ret;
 }
@@ -759,13 +765,13 @@ void sem_destroyholder(FAR sem_t *sem)
 		sdbg("Semaphore destroyed with holders\n");
 		(void)sem_foreachholder(sem, sem_recoverholders, NULL);
 	}
-#else
+#endif
 	if (sem->holder.htcb) {
 		sdbg("Semaphore destroyed with holder\n");
 	}
 
 	sem->holder.htcb = NULL;
-#endif
+	sem->holder.counts = 0;
 }
 
 /****************************************************************************
@@ -774,24 +780,27 @@ void sem_destroyholder(FAR sem_t *sem)
 
 struct semholder_s *sem_findholder(sem_t *sem, FAR struct tcb_s *htcb)
 {
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
 	FAR struct semholder_s *pholder;
+#endif
 
-	/* Try to find the holder in the list of holders associated with this
-	 * semaphore
+	/* The built-in holder covers every mutex-style semaphore, so check it
+	 * before walking the list of additional holders.
 	 */
 
+	if (sem->holder.htcb == htcb) {
+		return &sem->holder;
+	}
+
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-	for (pholder = sem->hhead; pholder; pholder = pholder->flink)
-#else
-	pholder = &sem->holder;
-#endif
-	{
+	for (pholder = sem->hhead; pholder; pholder = pholder->flink) {
 		if (pholder->htcb == htcb) {
 			/* Got it! */
 
 			return pholder;
 		}
 	}
+#endif
 
 	/* The holder does not appear in the list */
 
@@ -909,6 +918,37 @@ void sem_releaseholder(FAR sem_t *sem, FAR struct tcb_s *rtcb)
 	}
 }
 
+/****************************************************************************
+ * Name: sem_dropholder
+ *
+ * Description:
+ *   Called from sem_post() when a thread releases a count and no other
+ *   thread is waiting for the semaphore.  Frees the holder container once
+ *   it no longer holds any counts.  No priority restoration is needed
+ *   because there is no waiter that could have boosted the holder.
+ *
+ * Parameters:
+ *   sem  - A reference to the semaphore being posted
+ *   htcb - TCB of the thread that released the count
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sem_dropholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
+{
+	FAR struct semholder_s *pholder;
+
+	pholder = sem_findholder(sem, htcb);
+	if (pholder && pholder->counts <= 0) {
+		sem_freeholder(sem, pholder);
+	}
+}
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
 /****************************************************************************
  * Name: void sem_boostpriority(sem_t *sem)
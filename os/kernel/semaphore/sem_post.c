@@ -215,7 +215,22 @@ int sem_post(FAR sem_t *sem)
 		sem_releaseholder(sem, this_task());
 		sem->semcount++;
 
-		sem_unblock_task(sem, this_task());
+#ifdef CONFIG_PRIORITY_INHERITANCE
+		/* If no thread is waiting, nothing can have been boosted on behalf
+		 * of this semaphore.  Skip the scheduler lock and the restoration
+		 * passes and just drop the emptied holder of the running task.
+		 */
+
+		if (sem->semcount > 0 && (sem->flags & PRIOINHERIT_FLAGS_DISABLE) == 0 && !up_interrupt_context()) {
+#ifdef CONFIG_SEMAPHORE_HISTORY
+			save_semaphore_history(sem, (void *)this_task(), SEM_RELEASE);
+#endif
+			sem_dropholder(sem, this_task());
+		} else
+#endif
+		{
+			sem_unblock_task(sem, this_task());
+		}
 		ret = OK;
 
 		/* Interrupts may now be enabled. */
@@ -354,6 +354,23 @@ int prctl(int option, ...)
 		return ret;
 	}
 #endif
+#ifdef CONFIG_SCHED_TIMER_SLACK
+	case PR_SET_TIMERSLACK:
+	{
+		unsigned long usec = va_arg(ap, unsigned long);
+
+		/* Whole ticks only: a slack below one tick defers nothing */
+
+		this_task()->timer_slack = (uint32_t)(usec / USEC_PER_TICK);
+	}
+	break;
+	case PR_GET_TIMERSLACK:
+	{
+		va_end(ap);
+		trace_end(TTRACE_TAG_TASK);
+		return (int)TICK2USEC(this_task()->timer_slack);
+	}
+#endif
 #ifdef CONFIG_SYSTEM_REBOOT_REASON
 	case PR_REBOOT_REASON_READ:
 	{
@@ -436,6 +436,12 @@ static int thread_schedsetup(FAR struct tcb_s *tcb, int priority, start_t start,
 		(void)sigprocmask(SIG_SETMASK, NULL, &tcb->sigprocmask);
 #endif
 
+		/* They also inherit the timer slack of the parent thread */
+
+#ifdef CONFIG_SCHED_TIMER_SLACK
+		tcb->timer_slack = this_task()->timer_slack;
+#endif
+
 		/* Initialize the task state.  It does not get a valid state
 		 * until it is activated.
 		 */
@@ -56,8 +56,10 @@
 
 #include <tinyara/config.h>
 
+#include <tinyara/irq.h>
 #include <tinyara/wdog.h>
 
+#include "sched/sched.h"
 #include "wdog/wdog.h"
 
 /********************************************************************************
@@ -130,19 +132,22 @@ int wd_gettime(WDOG_ID wdog)
 	return 0;
 }
 
-#ifdef CONFIG_SCHED_TICKSUPPRESS
+#if defined(CONFIG_SCHED_TICKSUPPRESS) || defined(CONFIG_PM)
 /********************************************************************************
  * Name: wd_getdelay
  *
  * Description:
  *  This function returns delay (in system ticks) from head of wdog active list.
- *  This function is provided by RTOS and called from platform-specific code.
+ *  This function is provided by RTOS and called from platform-specific code
+ *  and from the PM logic to find out how long the system may sleep.  With
+ *  CONFIG_SCHED_TIMER_SLACK, coalesced watchdogs share one expiration, so
+ *  this is the true time of the next timer event.
  *
  * Parameters:
  *	None
  *
  * Return Value:
- *  wdog delay in system ticks
+ *  wdog delay in system ticks, zero if no watchdog is active
  *
  * Assumptions:
  *
@@ -150,6 +155,26 @@ int wd_gettime(WDOG_ID wdog)
 
 int wd_getdelay(void)
 {
-	return (g_wdactivelist.head) ? ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+	FAR struct wdog_s *head;
+	irqstate_t flags;
+	int delay = 0;
+
+	flags = irqsave();
+	head = (FAR struct wdog_s *)g_wdactivelist.head;
+	if (head != NULL && head->lag > 0) {
+		/* In tick-less mode the lag of the head is only brought up to date
+		 * when the timer is reassessed.  Take off the time that has passed
+		 * since then without disturbing the running timer.  A watchdog that
+		 * is due now still reports one tick.
+		 */
+
+		delay = head->lag - (int)sched_timer_elapsed();
+		if (delay <= 0) {
+			delay = 1;
+		}
+	}
+
+	irqrestore(flags);
+	return delay;
 }
 #endif
@@ -131,6 +131,9 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
 static inline void wd_expiration(void)
 {
 	FAR struct wdog_s *wdog;
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+	bool coalesced = false;
+#endif
 
 	/* Check if the watchdog at the head of the list is ready to run */
 
@@ -156,6 +159,15 @@ static inline void wd_expiration(void)
 
 			WDOG_CLRACTIVE(wdog);
 
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+			/* The first watchdog is the one that woke us up; the others
+			 * share its timer event.
+			 */
+
+			wd_wakeup(wdog->pid, coalesced);
+			coalesced = true;
+#endif
+
 			/* Execute the watchdog function */
 
 			up_setpicbase(wdog->picbase);
@@ -193,6 +205,51 @@ static inline void wd_expiration(void)
 	}
 }
 
+/****************************************************************************
+ * Name: wd_coalesce
+ *
+ * Description:
+ *   Find the first active watchdog that expires at or after 'delay'.  If it
+ *   expires within 'slack' ticks of 'delay', return its expiration so that
+ *   the new watchdog shares its timer event.
+ *
+ * Parameters:
+ *   delay - The requested delay in clock ticks
+ *   slack - The allowed deferral in clock ticks
+ *
+ * Return Value:
+ *   The delay to use for the new watchdog
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TIMER_SLACK
+static int wd_coalesce(int delay, uint32_t slack)
+{
+	FAR struct wdog_s *curr;
+	int32_t now = 0;
+
+	if (slack == 0) {
+		return delay;
+	}
+
+	for (curr = (FAR struct wdog_s *)g_wdactivelist.head; curr; curr = curr->next) {
+		now += curr->lag;
+		if (now >= delay) {
+			if ((uint32_t)(now - delay) <= slack) {
+				return now;
+			}
+
+			break;
+		}
+	}
+
+	return delay;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -275,6 +332,12 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 #endif
 	va_end(ap);
 
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+	/* Remember who will be responsible for the wakeup */
+
+	wdog->pid = up_interrupt_context() ? WAKEUP_SOURCE_IRQ : this_task()->pid;
+#endif
+
 	/* Calculate delay+1, forcing the delay into a range that we can handle */
 
 	if (delay <= 0) {
@@ -292,6 +355,17 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	(void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
+	/* Let a thread's watchdog expire together with one that is already due
+	 * within the slack of the thread.  Watchdogs started from interrupt
+	 * handlers are never deferred.
+	 */
+
+	if (!up_interrupt_context()) {
+		delay = wd_coalesce(delay, this_task()->timer_slack);
+	}
+#endif
+
 	/* Do the easy case first -- when the watchdog timer queue is empty. */
 
 	if (g_wdactivelist.head == NULL) {
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/clock.h>
+#include <tinyara/sched.h>
+#include <tinyara/wdog.h>
+
+#include "sched/sched.h"
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Wakeups that cannot be accounted to a live thread */
+
+static struct wakeup_count_s g_wakeup_irq;
+static struct wakeup_count_s g_wakeup_exited;
+static struct wakeup_count_s g_wakeup_coalesced;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wakeupcount
+ *
+ * Description:
+ *   Close the current one second window if it has passed and add 'n'
+ *   wakeups.  The rate is only kept if no whole window was skipped.
+ *
+ ****************************************************************************/
+
+static void wd_wakeupcount(FAR struct wakeup_count_s *wakeups, uint16_t n)
+{
+	clock_t now = clock_systimer();
+	clock_t elapsed = now - wakeups->start;
+
+	if (elapsed >= CLOCKS_PER_SEC) {
+		wakeups->rate = elapsed < 2 * CLOCKS_PER_SEC ? wakeups->count : 0;
+		wakeups->count = 0;
+		wakeups->start = now - (elapsed % CLOCKS_PER_SEC);
+	}
+
+	wakeups->count += n;
+	wakeups->total += n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wakeup
+ *
+ * Description:
+ *   Account one watchdog expiration to the source that started it.
+ *
+ ****************************************************************************/
+
+void wd_wakeup(pid_t pid, bool coalesced)
+{
+	FAR struct tcb_s *tcb;
+
+	if (coalesced) {
+		wd_wakeupcount(&g_wakeup_coalesced, 1);
+	} else if (pid == WAKEUP_SOURCE_IRQ) {
+		wd_wakeupcount(&g_wakeup_irq, 1);
+	} else {
+		tcb = sched_gettcb(pid);
+		wd_wakeupcount(tcb != NULL ? &tcb->wakeups : &g_wakeup_exited, 1);
+	}
+}
+
+/****************************************************************************
+ * Function:  clock_wakeups
+ *
+ * Description:
+ *   Return the timer wakeups caused by one source.
+ *
+ * Parameters:
+ *   source - The task ID of the thread of interest or one of the
+ *            WAKEUP_SOURCE_* values
+ *   wakeups - The location to return the wakeup counts
+ *
+ * Return Value:
+ *   OK (0) on success; -ESRCH if 'source' no longer refers to a valid
+ *   thread.
+ *
+ ****************************************************************************/
+
+int clock_wakeups(int source, FAR struct wakeup_count_s *wakeups)
+{
+	FAR struct wakeup_count_s *counts;
+	FAR struct tcb_s *tcb;
+	irqstate_t flags;
+	int ret = OK;
+
+	DEBUGASSERT(wakeups != NULL);
+
+	flags = irqsave();
+	if (source == WAKEUP_SOURCE_IRQ) {
+		counts = &g_wakeup_irq;
+	} else if (source == WAKEUP_SOURCE_EXITED) {
+		counts = &g_wakeup_exited;
+	} else if (source == WAKEUP_SOURCE_COALESCED) {
+		counts = &g_wakeup_coalesced;
+	} else {
+		tcb = sched_gettcb((pid_t)source);
+		counts = tcb != NULL ? &tcb->wakeups : NULL;
+	}
+
+	if (counts != NULL) {
+		/* Close a window that has passed without wakeups */
+
+		wd_wakeupcount(counts, 0);
+		*wakeups = *counts;
+	} else {
+		ret = -ESRCH;
+	}
+
+	irqrestore(flags);
+	return ret;
+}
+
+#endif /* CONFIG_SCHED_WAKEUP_STATS */
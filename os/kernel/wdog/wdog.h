@@ -162,6 +162,29 @@ void wd_timer(void);
 #ifdef CONFIG_SCHED_TICKSUPPRESS
 void wd_timer_nohz(int ticks);
 #endif
+/****************************************************************************
+ * Name: wd_wakeup
+ *
+ * Description:
+ *   Account one watchdog expiration to the source that started it.
+ *
+ * Parameters:
+ *   pid - The thread that started the watchdog or WAKEUP_SOURCE_IRQ
+ *   coalesced - True if the expiration shared the timer event of an
+ *     earlier one
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WAKEUP_STATS
+void wd_wakeup(pid_t pid, bool coalesced);
+#endif
+
 /****************************************************************************
  * Name: wd_recover
  *
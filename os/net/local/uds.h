@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/uds.h
+ *
+ *   Internal definitions of the AF_UNIX local socket stack.
+ *
+ *   Every local socket is a struct uds_conn_s.  A connected SOCK_STREAM
+ *   pair points at each other and the sender writes straight into the
+ *   receive ring of its peer; when the peer is already blocked in recv()
+ *   on an empty ring the data is copied into the receiver's buffer with
+ *   no intermediate copy at all.  A bound SOCK_DGRAM socket owns a ring
+ *   of records that any sender may append to.
+ *
+ *   All connections are protected by one lock.  Local socket descriptors
+ *   are global, like LWIP socket descriptors, and are numbered right after
+ *   them.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_LOCAL_UDS_H
+#define __NET_LOCAL_UDS_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/uio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+#include <queue.h>
+#include <poll.h>
+
+#ifdef CONFIG_NET_LOCAL_SCM
+#include <tinyara/fs/fs.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Local socket descriptors follow the LWIP socket descriptors */
+
+#define UDS_FD_BASE      (CONFIG_NFILE_DESCRIPTORS + CONFIG_NBSDSOCKET_DESCRIPTORS)
+#define UDS_ISFD(fd)     ((unsigned int)((fd) - UDS_FD_BASE) < CONFIG_NUDS_DESCRIPTORS)
+
+#define UDS_BUFSIZE      CONFIG_NET_LOCAL_BUFSIZE
+
+/* Connection states */
+
+#define UDS_IDLE         0	/* Created, possibly bound */
+#define UDS_LISTENING    1	/* SOCK_STREAM accepting connections */
+#define UDS_CONNECTED    2	/* SOCK_STREAM connected to a peer */
+#define UDS_DISCONNECTED 3	/* SOCK_STREAM whose peer has gone away */
+
+/* Connection flags */
+
+#define UDS_NONBLOCK     (1 << 0)	/* O_NONBLOCK is set */
+#define UDS_RDSHUT       (1 << 1)	/* shutdown(SHUT_RD) */
+#define UDS_WRSHUT       (1 << 2)	/* shutdown(SHUT_WR) */
+#define UDS_PENDING      (1 << 3)	/* Waiting in the accept queue of a listener */
+#define UDS_ACCEPTED     (1 << 4)	/* Created by connect(), shares the listener name */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Receive ring.  in and out run freely and only their difference and their
+ * values modulo UDS_BUFSIZE matter, so they double as the stream offsets
+ * that SCM_RIGHTS ancillary data is attached to.
+ */
+
+struct uds_ring_s {
+	FAR uint8_t *buf;
+	uint32_t in;				/* Total bytes written */
+	uint32_t out;				/* Total bytes consumed */
+};
+
+/* Each datagram is stored in the ring as this header, the sender name and
+ * the payload.
+ */
+
+struct uds_dgram_s {
+	uint16_t datalen;
+	uint8_t namelen;
+	uint8_t reserved;
+};
+
+/* Cursor over the iovec array of a send or receive call */
+
+struct uds_iter_s {
+	FAR const struct iovec *iov;
+	int iovcnt;
+	size_t off;					/* Offset into iov[0] */
+};
+
+struct uds_conn_s;
+struct uds_rights_s;
+
+#ifdef CONFIG_NET_LOCAL_SCM
+/* Descriptors sent with SCM_RIGHTS and not yet received.  Files are held
+ * as detached struct file copies, local sockets as connection references.
+ */
+
+struct uds_passfd_s {
+	FAR struct uds_conn_s *conn;
+	struct file file;
+};
+
+struct uds_rights_s {
+	sq_entry_t node;
+	uint32_t pos;				/* Receive ring offset of the attached data */
+	uint8_t nfds;
+	struct uds_passfd_s fds[CONFIG_NET_LOCAL_SCM_MAXFD];
+};
+#endif
+
+struct uds_conn_s {
+	dq_entry_t node;			/* Link in the list of all connections */
+	FAR struct uds_conn_s *peer;	/* Stream peer or default datagram destination */
+	FAR struct uds_conn_s *pending;	/* Listener: first unaccepted connection */
+	FAR struct uds_conn_s *next;	/* Link in the accept queue of a listener */
+
+	uint8_t crefs;				/* Descriptors and calls in progress using it */
+	uint8_t type;				/* SOCK_STREAM or SOCK_DGRAM */
+	uint8_t state;				/* See UDS_IDLE and friends */
+	uint8_t flags;				/* See UDS_NONBLOCK and friends */
+	uint8_t backlog;			/* Listener: maximum unaccepted connections */
+	uint8_t npending;			/* Listener: current unaccepted connections */
+	uint8_t nrdwait;			/* Tasks waiting on rdsem */
+	uint8_t nwrwait;			/* Tasks waiting on wrsem */
+
+	uint8_t namelen;			/* 0 if unnamed */
+	char name[UNIX_PATH_MAX];	/* Pathname, or abstract name starting with NUL */
+
+	struct uds_ring_s rx;
+
+	/* Receive buffer of a reader blocked on an empty stream ring, filled
+	 * directly by the peer.
+	 */
+
+	FAR struct uds_iter_s *rditer;
+	size_t rdlen;
+	size_t rdcopied;
+
+	sem_t rdsem;				/* Data, connections or hangup arrived */
+	sem_t wrsem;				/* Peer ring space became available */
+
+	FAR struct pollfd *fds[CONFIG_NET_LOCAL_NPOLLWAITERS];
+
+#ifdef CONFIG_NET_LOCAL_SCM
+	sq_queue_t rights;			/* Pending struct uds_rights_s, in ring order */
+#endif
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* uds_conn.c */
+
+void uds_initialize(void);
+ssize_t uds_result(ssize_t ret);
+void uds_lock(void);
+void uds_unlock(void);
+int uds_wait(FAR sem_t *sem, FAR uint8_t *nwait);
+void uds_notify(FAR sem_t *sem, FAR uint8_t *nwait);
+int uds_waitany(void);
+void uds_notifyany(void);
+
+FAR struct uds_conn_s *uds_alloc(uint8_t type);
+void uds_release(FAR struct uds_conn_s *conn);
+int uds_bufalloc(FAR struct uds_conn_s *conn);
+
+int uds_fdalloc(FAR struct uds_conn_s *conn);
+FAR struct uds_conn_s *uds_fdget(int fd);
+FAR struct uds_conn_s *uds_fdhold(int fd);
+FAR struct uds_conn_s *uds_fdfree(int fd);
+void uds_fdset(int fd, FAR struct uds_conn_s *conn);
+
+FAR struct uds_conn_s *uds_find(uint8_t type, FAR const char *name, uint8_t namelen);
+int uds_autobind(FAR struct uds_conn_s *conn);
+int uds_getname(FAR const struct sockaddr *addr, socklen_t addrlen, FAR char *name, FAR uint8_t *namelen);
+void uds_putname(FAR const char *name, uint8_t namelen, FAR struct sockaddr *addr, FAR socklen_t *addrlen);
+
+pollevent_t uds_pollstate(FAR struct uds_conn_s *conn);
+void uds_pollnotify(FAR struct uds_conn_s *conn, pollevent_t eventset);
+
+size_t uds_iter_chunk(FAR struct uds_iter_s *iter, FAR uint8_t **ptr, size_t len);
+size_t uds_iter_len(FAR const struct uds_iter_s *iter);
+void uds_ring_write(FAR struct uds_ring_s *ring, FAR const uint8_t *src, size_t len);
+void uds_ring_peek(FAR struct uds_ring_s *ring, uint32_t off, FAR uint8_t *dst, size_t len);
+
+/* Bytes stored in a ring and bytes still free */
+
+#define uds_ring_used(r)  ((uint32_t)((r)->in - (r)->out))
+#define uds_ring_space(r) (UDS_BUFSIZE - uds_ring_used(r))
+
+#ifdef CONFIG_NET_LOCAL_SCM
+/* uds_scm.c */
+
+int uds_rights_get(FAR const struct msghdr *msg, FAR struct uds_rights_s **rights);
+void uds_rights_put(FAR struct msghdr *msg, FAR struct uds_rights_s *rights);
+void uds_rights_free(FAR struct uds_rights_s *rights);
+#endif
+
+#endif							/* __NET_LOCAL_UDS_H */
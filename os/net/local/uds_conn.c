@@ -0,0 +1,550 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/uds_conn.c
+ *
+ *   Local socket connections: allocation, the descriptor table, the name
+ *   registry, the receive rings and the wait and poll notifications.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/semaphore.h>
+
+#include "uds.h"
+
+#if (UDS_BUFSIZE & (UDS_BUFSIZE - 1)) != 0
+#error "CONFIG_NET_LOCAL_BUFSIZE must be a power of two"
+#endif
+
+#define UDS_AUTONAME_LEN 6		/* NUL and five hex digits, as Linux does */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct uds_conn_s *g_uds_fds[CONFIG_NUDS_DESCRIPTORS];
+static dq_queue_t g_uds_conns;
+static sem_t g_uds_sem;
+
+/* Waiters for a condition on a connection they do not own: datagram ring
+ * space of another socket or room in the accept queue of a listener.
+ */
+
+static sem_t g_uds_waitsem;
+static uint8_t g_uds_nwait;
+
+static uint32_t g_uds_autoname;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void uds_initialize(void)
+{
+	sem_init(&g_uds_sem, 0, 1);
+	sem_init(&g_uds_waitsem, 0, 0);
+	sem_setprotocol(&g_uds_waitsem, SEM_PRIO_NONE);
+	dq_init(&g_uds_conns);
+}
+
+/* Turn a negated errno value into the BSD socket API convention */
+
+ssize_t uds_result(ssize_t ret)
+{
+	if (ret < 0) {
+		set_errno(-ret);
+		return ERROR;
+	}
+	return ret;
+}
+
+void uds_lock(void)
+{
+	while (sem_wait(&g_uds_sem) != OK) {
+		DEBUGASSERT(get_errno() == EINTR);
+	}
+}
+
+void uds_unlock(void)
+{
+	sem_post(&g_uds_sem);
+}
+
+/****************************************************************************
+ * Name: uds_wait
+ *
+ * Description:
+ *   Release the lock, wait for sem to be posted by uds_notify() and take
+ *   the lock again.  Wakeups may be spurious, so callers check their
+ *   condition again.
+ *
+ * Returned Value:
+ *   0 on wakeup, -EINTR if a signal interrupted the wait.
+ *
+ ****************************************************************************/
+
+int uds_wait(FAR sem_t *sem, FAR uint8_t *nwait)
+{
+	int ret;
+
+	(*nwait)++;
+	uds_unlock();
+	ret = sem_wait(sem);
+	uds_lock();
+
+	if (ret != OK) {
+		/* Nobody posted for us, unless uds_notify() ran in between */
+
+		if (*nwait > 0) {
+			(*nwait)--;
+		}
+		return -EINTR;
+	}
+	return 0;
+}
+
+void uds_notify(FAR sem_t *sem, FAR uint8_t *nwait)
+{
+	while (*nwait > 0) {
+		(*nwait)--;
+		sem_post(sem);
+	}
+}
+
+int uds_waitany(void)
+{
+	return uds_wait(&g_uds_waitsem, &g_uds_nwait);
+}
+
+void uds_notifyany(void)
+{
+	uds_notify(&g_uds_waitsem, &g_uds_nwait);
+}
+
+/****************************************************************************
+ * Name: uds_alloc
+ *
+ * Description:
+ *   Allocate a connection holding one reference.  Called with the lock
+ *   held.
+ *
+ ****************************************************************************/
+
+FAR struct uds_conn_s *uds_alloc(uint8_t type)
+{
+	FAR struct uds_conn_s *conn;
+
+	conn = (FAR struct uds_conn_s *)kmm_zalloc(sizeof(struct uds_conn_s));
+	if (conn == NULL) {
+		return NULL;
+	}
+
+	conn->crefs = 1;
+	conn->type = type;
+	conn->state = UDS_IDLE;
+	sem_init(&conn->rdsem, 0, 0);
+	sem_setprotocol(&conn->rdsem, SEM_PRIO_NONE);
+	sem_init(&conn->wrsem, 0, 0);
+	sem_setprotocol(&conn->wrsem, SEM_PRIO_NONE);
+#ifdef CONFIG_NET_LOCAL_SCM
+	sq_init(&conn->rights);
+#endif
+	dq_addlast(&conn->node, &g_uds_conns);
+
+	return conn;
+}
+
+/****************************************************************************
+ * Name: uds_release
+ *
+ * Description:
+ *   Drop one reference.  The last one hangs up the peer, refuses the
+ *   connections nobody accepted, closes descriptors still in flight and
+ *   frees the connection.  Called with the lock held.
+ *
+ ****************************************************************************/
+
+void uds_release(FAR struct uds_conn_s *conn)
+{
+	FAR struct uds_conn_s *other;
+	FAR dq_entry_t *node;
+
+	DEBUGASSERT(conn->crefs > 0);
+	if (--conn->crefs > 0) {
+		return;
+	}
+
+	while ((other = conn->pending) != NULL) {
+		conn->pending = other->next;
+		other->next = NULL;
+		other->flags &= ~UDS_PENDING;
+		uds_release(other);
+	}
+
+	if (conn->type == SOCK_STREAM) {
+		other = conn->peer;
+		if (other != NULL) {
+			other->peer = NULL;
+			other->state = UDS_DISCONNECTED;
+			uds_notify(&other->rdsem, &other->nrdwait);
+			uds_notify(&other->wrsem, &other->nwrwait);
+			uds_pollnotify(other, POLLIN | POLLOUT | POLLHUP);
+		}
+	} else {
+		for (node = dq_peek(&g_uds_conns); node != NULL; node = dq_next(node)) {
+			other = (FAR struct uds_conn_s *)node;
+			if (other->peer == conn) {
+				other->peer = NULL;
+			}
+		}
+	}
+
+	/* Wake up anyone still polling the descriptor that was closed */
+
+	uds_pollnotify(conn, POLLHUP);
+
+#ifdef CONFIG_NET_LOCAL_SCM
+	while (!sq_empty(&conn->rights)) {
+		uds_rights_free((FAR struct uds_rights_s *)sq_remfirst(&conn->rights));
+	}
+#endif
+
+	dq_rem(&conn->node, &g_uds_conns);
+	sem_destroy(&conn->rdsem);
+	sem_destroy(&conn->wrsem);
+	if (conn->rx.buf != NULL) {
+		kmm_free(conn->rx.buf);
+	}
+	kmm_free(conn);
+
+	/* Datagram senders may have been waiting for this socket */
+
+	uds_notifyany();
+}
+
+int uds_bufalloc(FAR struct uds_conn_s *conn)
+{
+	if (conn->rx.buf == NULL) {
+		conn->rx.buf = (FAR uint8_t *)kmm_malloc(UDS_BUFSIZE);
+		if (conn->rx.buf == NULL) {
+			return -ENOMEM;
+		}
+	}
+	return 0;
+}
+
+/****************************************************************************
+ * Name: uds_fdalloc
+ *
+ * Description:
+ *   Assign the lowest free local socket descriptor to conn.  The
+ *   descriptor takes over one reference of the caller.
+ *
+ ****************************************************************************/
+
+int uds_fdalloc(FAR struct uds_conn_s *conn)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NUDS_DESCRIPTORS; i++) {
+		if (g_uds_fds[i] == NULL) {
+			g_uds_fds[i] = conn;
+			return UDS_FD_BASE + i;
+		}
+	}
+	return -ENFILE;
+}
+
+FAR struct uds_conn_s *uds_fdget(int fd)
+{
+	if (!UDS_ISFD(fd)) {
+		return NULL;
+	}
+	return g_uds_fds[fd - UDS_FD_BASE];
+}
+
+/* Look up a descriptor and take a reference that keeps the connection
+ * alive while the caller waits without the lock.
+ */
+
+FAR struct uds_conn_s *uds_fdhold(int fd)
+{
+	FAR struct uds_conn_s *conn = uds_fdget(fd);
+
+	if (conn != NULL) {
+		conn->crefs++;
+	}
+	return conn;
+}
+
+/* Detach a descriptor and hand its reference to the caller */
+
+FAR struct uds_conn_s *uds_fdfree(int fd)
+{
+	FAR struct uds_conn_s *conn = uds_fdget(fd);
+
+	if (conn != NULL) {
+		g_uds_fds[fd - UDS_FD_BASE] = NULL;
+	}
+	return conn;
+}
+
+void uds_fdset(int fd, FAR struct uds_conn_s *conn)
+{
+	DEBUGASSERT(UDS_ISFD(fd));
+	g_uds_fds[fd - UDS_FD_BASE] = conn;
+}
+
+/****************************************************************************
+ * Name: uds_find
+ *
+ * Description:
+ *   Look up the socket bound to a name.  Accepted connections share the
+ *   name of their listener but are never found by it.
+ *
+ ****************************************************************************/
+
+FAR struct uds_conn_s *uds_find(uint8_t type, FAR const char *name, uint8_t namelen)
+{
+	FAR struct uds_conn_s *conn;
+	FAR dq_entry_t *node;
+
+	for (node = dq_peek(&g_uds_conns); node != NULL; node = dq_next(node)) {
+		conn = (FAR struct uds_conn_s *)node;
+		if (conn->type == type && conn->namelen == namelen && (conn->flags & UDS_ACCEPTED) == 0 && memcmp(conn->name, name, namelen) == 0) {
+			return conn;
+		}
+	}
+	return NULL;
+}
+
+/* Bind conn to an unused abstract name */
+
+int uds_autobind(FAR struct uds_conn_s *conn)
+{
+	static const char hex[] = "0123456789abcdef";
+	uint32_t id;
+	int i;
+
+	do {
+		id = g_uds_autoname++;
+		conn->name[0] = '\0';
+		for (i = UDS_AUTONAME_LEN - 1; i > 0; i--) {
+			conn->name[i] = hex[id & 0xf];
+			id >>= 4;
+		}
+	} while (uds_find(conn->type, conn->name, UDS_AUTONAME_LEN) != NULL);
+
+	conn->namelen = UDS_AUTONAME_LEN;
+	return 0;
+}
+
+/****************************************************************************
+ * Name: uds_getname
+ *
+ * Description:
+ *   Extract the name from a struct sockaddr_un.  A pathname ends at its
+ *   NUL terminator; an abstract name starts with NUL and spans the rest of
+ *   addrlen.  A name of length 0 means an unnamed address.
+ *
+ ****************************************************************************/
+
+int uds_getname(FAR const struct sockaddr *addr, socklen_t addrlen, FAR char *name, FAR uint8_t *namelen)
+{
+	FAR const struct sockaddr_un *sun = (FAR const struct sockaddr_un *)addr;
+	size_t len;
+
+	if (addr == NULL || addrlen < offsetof(struct sockaddr_un, sun_path)) {
+		return -EINVAL;
+	}
+	if (sun->sun_family != AF_UNIX) {
+		return -EAFNOSUPPORT;
+	}
+
+	len = addrlen - offsetof(struct sockaddr_un, sun_path);
+	if (len > UNIX_PATH_MAX) {
+		len = UNIX_PATH_MAX;
+	}
+	if (len > 0 && sun->sun_path[0] != '\0') {
+		len = strnlen(sun->sun_path, len);
+	}
+
+	memcpy(name, sun->sun_path, len);
+	*namelen = (uint8_t)len;
+	return 0;
+}
+
+/* Fill a struct sockaddr_un, truncated to *addrlen, and return its full
+ * length in *addrlen.
+ */
+
+void uds_putname(FAR const char *name, uint8_t namelen, FAR struct sockaddr *addr, FAR socklen_t *addrlen)
+{
+	struct sockaddr_un sun;
+	socklen_t len;
+
+	if (addr == NULL || addrlen == NULL) {
+		return;
+	}
+
+	len = offsetof(struct sockaddr_un, sun_path) + namelen;
+	if (namelen > 0 && name[0] != '\0' && namelen < UNIX_PATH_MAX) {
+		len++;
+	}
+
+	memset(&sun, 0, sizeof(sun));
+#ifdef CONFIG_NET_LWIP
+	sun.sun_len = (u8_t)len;
+#endif
+	sun.sun_family = AF_UNIX;
+	memcpy(sun.sun_path, name, namelen);
+
+	memcpy(addr, &sun, *addrlen < len ? *addrlen : len);
+	*addrlen = len;
+}
+
+/****************************************************************************
+ * Name: uds_pollstate
+ *
+ * Description:
+ *   Return the poll events currently in effect for conn.
+ *
+ ****************************************************************************/
+
+pollevent_t uds_pollstate(FAR struct uds_conn_s *conn)
+{
+	pollevent_t events = 0;
+
+	if (uds_ring_used(&conn->rx) > 0 || conn->npending > 0 || (conn->flags & UDS_RDSHUT) != 0) {
+		events |= POLLIN;
+	}
+
+	if (conn->type == SOCK_DGRAM) {
+		events |= POLLOUT;
+	} else if (conn->state == UDS_DISCONNECTED) {
+		events |= POLLIN | POLLHUP;
+	} else if (conn->state == UDS_CONNECTED) {
+		if ((conn->peer->flags & UDS_WRSHUT) != 0) {
+			events |= POLLIN;
+		}
+		if ((conn->flags & UDS_WRSHUT) == 0 && uds_ring_space(&conn->peer->rx) > 0) {
+			events |= POLLOUT;
+		}
+	}
+
+	return events;
+}
+
+void uds_pollnotify(FAR struct uds_conn_s *conn, pollevent_t eventset)
+{
+	FAR struct pollfd *fds;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_LOCAL_NPOLLWAITERS; i++) {
+		fds = conn->fds[i];
+		if (fds != NULL) {
+			fds->revents |= (fds->events & eventset) | (eventset & (POLLERR | POLLHUP));
+			if (fds->revents != 0) {
+				sem_post(fds->sem);
+			}
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: uds_iter_chunk
+ *
+ * Description:
+ *   Return in *ptr the next contiguous piece of at most len bytes of the
+ *   iovec array and advance past it.
+ *
+ ****************************************************************************/
+
+size_t uds_iter_chunk(FAR struct uds_iter_s *iter, FAR uint8_t **ptr, size_t len)
+{
+	size_t n;
+
+	while (iter->iovcnt > 0 && iter->off >= iter->iov->iov_len) {
+		iter->iov++;
+		iter->iovcnt--;
+		iter->off = 0;
+	}
+	if (iter->iovcnt == 0) {
+		return 0;
+	}
+
+	n = iter->iov->iov_len - iter->off;
+	if (n > len) {
+		n = len;
+	}
+	*ptr = (FAR uint8_t *)iter->iov->iov_base + iter->off;
+	iter->off += n;
+	return n;
+}
+
+size_t uds_iter_len(FAR const struct uds_iter_s *iter)
+{
+	size_t len = 0;
+	int i;
+
+	for (i = 0; i < iter->iovcnt; i++) {
+		len += iter->iov[i].iov_len;
+	}
+	return len - iter->off;
+}
+
+void uds_ring_write(FAR struct uds_ring_s *ring, FAR const uint8_t *src, size_t len)
+{
+	uint32_t idx = ring->in & (UDS_BUFSIZE - 1);
+	size_t n = UDS_BUFSIZE - idx;
+
+	if (n > len) {
+		n = len;
+	}
+	memcpy(ring->buf + idx, src, n);
+	memcpy(ring->buf, src + n, len - n);
+	ring->in += len;
+}
+
+/* Copy len bytes starting off bytes past the read position, without
+ * consuming them.
+ */
+
+void uds_ring_peek(FAR struct uds_ring_s *ring, uint32_t off, FAR uint8_t *dst, size_t len)
+{
+	uint32_t idx = (ring->out + off) & (UDS_BUFSIZE - 1);
+	size_t n = UDS_BUFSIZE - idx;
+
+	if (n > len) {
+		n = len;
+	}
+	memcpy(dst, ring->buf + idx, n);
+	memcpy(dst + n, ring->buf, len - n);
+}
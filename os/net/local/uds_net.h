@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/uds_net.h
+ *
+ *   Entry points of the AF_UNIX local socket stack used by netstack_uds.c.
+ *   They follow the BSD socket API: on failure -1 is returned and errno is
+ *   set.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_LOCAL_UDS_NET_H
+#define __NET_LOCAL_UDS_NET_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <poll.h>
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+int uds_init(void *data);
+
+/* VFS */
+
+int uds_close(int sockfd);
+int uds_dup(int sockfd);
+int uds_dup2(int sockfd1, int sockfd2);
+int uds_checksd(int sd, int oflags);
+int uds_ioctl(int sockfd, int cmd, unsigned long arg);
+int uds_fcntl(int sockfd, int cmd, va_list ap);
+int uds_poll(int fd, struct pollfd *fds, bool setup);
+
+/* BSD socket API */
+
+int uds_socket(int domain, int type, int protocol);
+int uds_bind(int s, const struct sockaddr *name, socklen_t namelen);
+int uds_connect(int s, const struct sockaddr *name, socklen_t namelen);
+int uds_accept(int s, struct sockaddr *addr, socklen_t *addrlen);
+int uds_listen(int s, int backlog);
+int uds_shutdown(int s, int how);
+ssize_t uds_recv(int s, void *mem, size_t len, int flags);
+ssize_t uds_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen);
+ssize_t uds_recvmsg(int s, struct msghdr *msg, int flags);
+ssize_t uds_send(int s, const void *data, size_t size, int flags);
+ssize_t uds_sendto(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen);
+ssize_t uds_sendmsg(int s, struct msghdr *msg, int flags);
+int uds_getsockname(int s, struct sockaddr *name, socklen_t *namelen);
+int uds_getpeername(int s, struct sockaddr *name, socklen_t *namelen);
+int uds_setsockopt(int s, int level, int optname, const void *optval, socklen_t optlen);
+int uds_getsockopt(int s, int level, int optname, void *optval, socklen_t *optlen);
+
+#endif							/* __NET_LOCAL_UDS_NET_H */
@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/uds_scm.c
+ *
+ *   SCM_RIGHTS descriptor passing.  File descriptors are duplicated into a
+ *   detached struct file when sent and installed into the receiving task
+ *   when received; local socket descriptors carry a connection reference.
+ *   LWIP sockets cannot be passed.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+
+#include "uds.h"
+
+#ifdef CONFIG_NET_LOCAL_SCM
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int uds_rights_hold(FAR struct uds_passfd_s *pass, int fd)
+{
+	FAR struct file *filep;
+	int ret;
+
+	if (UDS_ISFD(fd)) {
+		uds_lock();
+		pass->conn = uds_fdhold(fd);
+		uds_unlock();
+		return pass->conn != NULL ? OK : -EBADF;
+	}
+
+	if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS) {
+		return fd < 0 || fd >= CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS ? -EBADF : -EOPNOTSUPP;
+	}
+
+	ret = fs_getfilep(fd, &filep);
+	if (ret < 0) {
+		return -get_errno();
+	}
+	if (file_dup2(filep, &pass->file) < 0) {
+		return -get_errno();
+	}
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uds_rights_get
+ *
+ * Description:
+ *   Take references on the descriptors of the SCM_RIGHTS message in the
+ *   control data of msg.  *rights is left NULL if there is none.
+ *
+ ****************************************************************************/
+
+int uds_rights_get(FAR const struct msghdr *msg, FAR struct uds_rights_s **rights)
+{
+	FAR struct uds_rights_s *entry = NULL;
+	FAR struct cmsghdr *cmsg;
+	FAR int *fds;
+	int nfds;
+	int ret = OK;
+	int i;
+
+	*rights = NULL;
+	if (msg->msg_control == NULL) {
+		return OK;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len < CMSG_LEN(0) || entry != NULL) {
+			ret = -EINVAL;
+			break;
+		}
+
+		nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		if (nfds > CONFIG_NET_LOCAL_SCM_MAXFD) {
+			ret = -ETOOMANYREFS;
+			break;
+		}
+		if (nfds == 0) {
+			continue;
+		}
+
+		entry = (FAR struct uds_rights_s *)kmm_zalloc(sizeof(struct uds_rights_s));
+		if (entry == NULL) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		fds = (FAR int *)CMSG_DATA(cmsg);
+		for (i = 0; i < nfds; i++) {
+			ret = uds_rights_hold(&entry->fds[i], fds[i]);
+			if (ret < 0) {
+				break;
+			}
+			entry->nfds++;
+		}
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (ret < 0) {
+		if (entry != NULL) {
+			uds_lock();
+			uds_rights_free(entry);
+			uds_unlock();
+		}
+		return ret;
+	}
+
+	*rights = entry;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: uds_rights_put
+ *
+ * Description:
+ *   Install the received descriptors into the calling task and report them
+ *   in the control data of msg.  Descriptors that do not fit are closed and
+ *   MSG_CTRUNC is set.  rights is freed.
+ *
+ ****************************************************************************/
+
+void uds_rights_put(FAR struct msghdr *msg, FAR struct uds_rights_s *rights)
+{
+	FAR struct uds_passfd_s *pass;
+	FAR struct cmsghdr *cmsg = NULL;
+	FAR int *fds = NULL;
+	int room = 0;
+	int nfds = 0;
+	int fd;
+	int i;
+
+	if (msg->msg_control != NULL && msg->msg_controllen >= CMSG_LEN(0)) {
+		cmsg = (FAR struct cmsghdr *)msg->msg_control;
+		fds = (FAR int *)CMSG_DATA(cmsg);
+		room = (msg->msg_controllen - CMSG_LEN(0)) / sizeof(int);
+	}
+
+	for (i = 0; i < rights->nfds; i++) {
+		pass = &rights->fds[i];
+		fd = -1;
+
+		if (nfds < room) {
+			if (pass->conn != NULL) {
+				uds_lock();
+				fd = uds_fdalloc(pass->conn);
+				if (fd >= 0) {
+					pass->conn = NULL;
+				}
+				uds_unlock();
+			} else {
+				fd = file_dup(&pass->file, 0);
+			}
+		}
+
+		if (fd >= 0) {
+			fds[nfds++] = fd;
+		} else {
+			msg->msg_flags |= MSG_CTRUNC;
+		}
+	}
+
+	if (nfds > 0) {
+		cmsg->cmsg_len = CMSG_LEN(nfds * sizeof(int));
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		msg->msg_controllen = CMSG_SPACE(nfds * sizeof(int));
+	} else {
+		msg->msg_controllen = 0;
+	}
+
+	/* Drop the references held while in flight */
+
+	uds_lock();
+	uds_rights_free(rights);
+	uds_unlock();
+}
+
+/****************************************************************************
+ * Name: uds_rights_free
+ *
+ * Description:
+ *   Drop the references held by rights and free it.  The caller holds the
+ *   local socket lock.
+ *
+ ****************************************************************************/
+
+void uds_rights_free(FAR struct uds_rights_s *rights)
+{
+	FAR struct uds_passfd_s *pass;
+	int i;
+
+	for (i = 0; i < rights->nfds; i++) {
+		pass = &rights->fds[i];
+		if (pass->conn != NULL) {
+			uds_release(pass->conn);
+		} else if (pass->file.f_inode != NULL) {
+			file_close(&pass->file);
+		}
+	}
+
+	kmm_free(rights);
+}
+
+#endif							/* CONFIG_NET_LOCAL_SCM */
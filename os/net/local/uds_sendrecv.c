@@ -0,0 +1,542 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/uds_sendrecv.c
+ *
+ *   Data transfer on local sockets.  Every send and receive call is turned
+ *   into a struct msghdr so that the scatter/gather and SCM_RIGHTS paths
+ *   are the only ones.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <errno.h>
+
+#include "uds.h"
+#include "uds_net.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline bool uds_nonblock(FAR struct uds_conn_s *conn, int flags)
+{
+	return (conn->flags & UDS_NONBLOCK) != 0 || (flags & MSG_DONTWAIT) != 0;
+}
+
+/* Copy up to len bytes from one iovec cursor to another */
+
+static size_t uds_iter_copy(FAR struct uds_iter_s *dst, FAR struct uds_iter_s *src, size_t len)
+{
+	FAR uint8_t *to;
+	FAR uint8_t *from;
+	size_t copied = 0;
+	size_t n;
+	size_t m;
+
+	while (copied < len && (n = uds_iter_chunk(dst, &to, len - copied)) > 0) {
+		while (n > 0 && (m = uds_iter_chunk(src, &from, n)) > 0) {
+			memcpy(to, from, m);
+			to += m;
+			n -= m;
+			copied += m;
+		}
+		if (n > 0) {
+			break;
+		}
+	}
+	return copied;
+}
+
+static void uds_ring_fill(FAR struct uds_ring_s *ring, FAR struct uds_iter_s *src, size_t len)
+{
+	FAR uint8_t *ptr;
+	size_t n;
+
+	while (len > 0 && (n = uds_iter_chunk(src, &ptr, len)) > 0) {
+		uds_ring_write(ring, ptr, n);
+		len -= n;
+	}
+}
+
+static void uds_ring_drain(FAR struct uds_ring_s *ring, uint32_t off, FAR struct uds_iter_s *dst, size_t len)
+{
+	FAR uint8_t *ptr;
+	size_t n;
+
+	while (len > 0 && (n = uds_iter_chunk(dst, &ptr, len)) > 0) {
+		uds_ring_peek(ring, off, ptr, n);
+		off += n;
+		len -= n;
+	}
+}
+
+/****************************************************************************
+ * Name: uds_stream_send
+ *
+ * Description:
+ *   Write into the receive ring of the peer.  If the peer is blocked in
+ *   recv() on an empty ring, the data goes straight into its buffer.
+ *   Returns the bytes sent, which may be short if the call would block
+ *   after some data was sent.
+ *
+ ****************************************************************************/
+
+static ssize_t uds_stream_send(FAR struct uds_conn_s *conn, FAR struct uds_iter_s *src, size_t len, int flags, FAR struct uds_rights_s **rights)
+{
+	FAR struct uds_conn_s *peer;
+	ssize_t ret = 0;
+	size_t sent = 0;
+	size_t n;
+	bool handoff;
+
+	while (sent < len) {
+		if ((conn->flags & UDS_WRSHUT) != 0 || conn->state == UDS_DISCONNECTED) {
+			ret = -EPIPE;
+			break;
+		}
+		if (conn->state != UDS_CONNECTED) {
+			ret = -ENOTCONN;
+			break;
+		}
+		peer = conn->peer;
+		if ((peer->flags & UDS_RDSHUT) != 0) {
+			ret = -EPIPE;
+			break;
+		}
+
+		/* Descriptors in flight must stay in order with the data, so they
+		 * always go through the ring.
+		 */
+
+		handoff = peer->rditer != NULL && peer->rdcopied < peer->rdlen && uds_ring_used(&peer->rx) == 0;
+#ifdef CONFIG_NET_LOCAL_SCM
+		handoff = handoff && *rights == NULL && sq_empty(&peer->rights);
+#endif
+		n = handoff ? peer->rdlen - peer->rdcopied : uds_ring_space(&peer->rx);
+		if (n > len - sent) {
+			n = len - sent;
+		}
+
+		if (n > 0) {
+#ifdef CONFIG_NET_LOCAL_SCM
+			if (*rights != NULL) {
+				/* Descriptors are received with the first byte of this call */
+
+				(*rights)->pos = peer->rx.in;
+				sq_addlast(&(*rights)->node, &peer->rights);
+				*rights = NULL;
+			}
+#endif
+			if (handoff) {
+				n = uds_iter_copy(peer->rditer, src, n);
+				peer->rdcopied += n;
+
+				/* Keep the ring offsets in step with the bytes delivered */
+
+				peer->rx.in += n;
+				peer->rx.out += n;
+			} else {
+				uds_ring_fill(&peer->rx, src, n);
+			}
+
+			sent += n;
+			uds_notify(&peer->rdsem, &peer->nrdwait);
+			uds_pollnotify(peer, POLLIN);
+			continue;
+		}
+
+		if (uds_nonblock(conn, flags)) {
+			ret = -EAGAIN;
+			break;
+		}
+		ret = uds_wait(&conn->wrsem, &conn->nwrwait);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	return sent > 0 ? (ssize_t)sent : ret;
+}
+
+static ssize_t uds_stream_recv(FAR struct uds_conn_s *conn, FAR struct uds_iter_s *dst, size_t len, int flags, FAR struct uds_rights_s **rights)
+{
+	FAR struct uds_conn_s *peer;
+	uint32_t avail;
+	size_t copied;
+	bool handoff;
+	int ret;
+#ifdef CONFIG_NET_LOCAL_SCM
+	FAR struct uds_rights_s *next;
+#endif
+
+	for (;;) {
+		if (conn->state != UDS_CONNECTED && conn->state != UDS_DISCONNECTED) {
+			return -ENOTCONN;
+		}
+
+		avail = uds_ring_used(&conn->rx);
+#ifdef CONFIG_NET_LOCAL_SCM
+		/* Deliver the descriptors sent with the data at the read position
+		 * and never read past the data of the next ones.
+		 */
+
+		next = (FAR struct uds_rights_s *)sq_peek(&conn->rights);
+		if (next != NULL && next->pos == conn->rx.out) {
+			if ((flags & MSG_PEEK) == 0) {
+				*rights = (FAR struct uds_rights_s *)sq_remfirst(&conn->rights);
+			}
+			next = (FAR struct uds_rights_s *)sq_next(&next->node);
+		}
+		if (next != NULL && next->pos - conn->rx.out < avail) {
+			avail = next->pos - conn->rx.out;
+		}
+#endif
+
+		if (avail > 0 || len == 0) {
+			copied = avail < len ? avail : len;
+			uds_ring_drain(&conn->rx, 0, dst, copied);
+			if ((flags & MSG_PEEK) == 0) {
+				conn->rx.out += copied;
+				peer = conn->peer;
+				if (peer != NULL) {
+					uds_notify(&peer->wrsem, &peer->nwrwait);
+					uds_pollnotify(peer, POLLOUT);
+				}
+			}
+			return copied;
+		}
+
+		peer = conn->peer;
+		if ((conn->flags & UDS_RDSHUT) != 0 || peer == NULL || (peer->flags & UDS_WRSHUT) != 0) {
+			/* End of file */
+
+			return 0;
+		}
+		if (uds_nonblock(conn, flags)) {
+			return -EAGAIN;
+		}
+
+		/* Offer our buffer to the peer while we sleep */
+
+		handoff = conn->rditer == NULL && (flags & MSG_PEEK) == 0;
+		if (handoff) {
+			conn->rditer = dst;
+			conn->rdlen = len;
+			conn->rdcopied = 0;
+		}
+
+		ret = uds_wait(&conn->rdsem, &conn->nrdwait);
+
+		if (handoff) {
+			copied = conn->rdcopied;
+			conn->rditer = NULL;
+			conn->rdcopied = 0;
+			if (copied > 0) {
+				return copied;
+			}
+		}
+		if (ret < 0) {
+			return ret;
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: uds_dgram_send
+ *
+ * Description:
+ *   Append a record to the ring of the destination, waiting for room
+ *   unless non-blocking.  A datagram is never split.
+ *
+ ****************************************************************************/
+
+static ssize_t uds_dgram_send(FAR struct uds_conn_s *conn, FAR struct uds_iter_s *src, size_t len, int flags, FAR const char *name, uint8_t namelen, FAR struct uds_rights_s **rights)
+{
+	FAR struct uds_conn_s *dest;
+	struct uds_dgram_s hdr;
+	size_t need;
+	int ret;
+
+	need = sizeof(hdr) + conn->namelen + len;
+	if (need > UDS_BUFSIZE) {
+		return -EMSGSIZE;
+	}
+
+	for (;;) {
+		if ((conn->flags & UDS_WRSHUT) != 0) {
+			return -EPIPE;
+		}
+
+		dest = name != NULL ? uds_find(SOCK_DGRAM, name, namelen) : conn->peer;
+		if (dest == NULL) {
+			return name != NULL ? -ECONNREFUSED : -ENOTCONN;
+		}
+		if ((dest->flags & UDS_RDSHUT) != 0) {
+			return -EPIPE;
+		}
+		if (uds_ring_space(&dest->rx) >= need) {
+			break;
+		}
+		if (uds_nonblock(conn, flags)) {
+			return -EAGAIN;
+		}
+
+		ret = uds_waitany();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+#ifdef CONFIG_NET_LOCAL_SCM
+	if (*rights != NULL) {
+		(*rights)->pos = dest->rx.in;
+		sq_addlast(&(*rights)->node, &dest->rights);
+		*rights = NULL;
+	}
+#endif
+
+	hdr.datalen = (uint16_t)len;
+	hdr.namelen = conn->namelen;
+	hdr.reserved = 0;
+	uds_ring_write(&dest->rx, (FAR const uint8_t *)&hdr, sizeof(hdr));
+	uds_ring_write(&dest->rx, (FAR const uint8_t *)conn->name, conn->namelen);
+	uds_ring_fill(&dest->rx, src, len);
+
+	uds_notify(&dest->rdsem, &dest->nrdwait);
+	uds_pollnotify(dest, POLLIN);
+	return len;
+}
+
+static ssize_t uds_dgram_recv(FAR struct uds_conn_s *conn, FAR struct uds_iter_s *dst, size_t len, int flags, FAR struct msghdr *msg, FAR struct uds_rights_s **rights)
+{
+	struct uds_dgram_s hdr;
+	char name[UNIX_PATH_MAX];
+	size_t copied;
+	int ret;
+#ifdef CONFIG_NET_LOCAL_SCM
+	FAR struct uds_rights_s *next;
+#endif
+
+	while (uds_ring_used(&conn->rx) == 0) {
+		if ((conn->flags & UDS_RDSHUT) != 0) {
+			return 0;
+		}
+		if (uds_nonblock(conn, flags)) {
+			return -EAGAIN;
+		}
+
+		ret = uds_wait(&conn->rdsem, &conn->nrdwait);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	uds_ring_peek(&conn->rx, 0, (FAR uint8_t *)&hdr, sizeof(hdr));
+	if (msg->msg_name != NULL) {
+		uds_ring_peek(&conn->rx, sizeof(hdr), (FAR uint8_t *)name, hdr.namelen);
+		uds_putname(name, hdr.namelen, (FAR struct sockaddr *)msg->msg_name, &msg->msg_namelen);
+	}
+
+	copied = hdr.datalen < len ? hdr.datalen : len;
+	uds_ring_drain(&conn->rx, sizeof(hdr) + hdr.namelen, dst, copied);
+	if (copied < hdr.datalen) {
+		msg->msg_flags |= MSG_TRUNC;
+	}
+
+	if ((flags & MSG_PEEK) == 0) {
+#ifdef CONFIG_NET_LOCAL_SCM
+		next = (FAR struct uds_rights_s *)sq_peek(&conn->rights);
+		if (next != NULL && next->pos == conn->rx.out) {
+			*rights = (FAR struct uds_rights_s *)sq_remfirst(&conn->rights);
+		}
+#endif
+		conn->rx.out += sizeof(hdr) + hdr.namelen + hdr.datalen;
+
+		/* Senders waiting for room may go on */
+
+		uds_notifyany();
+	}
+
+	return copied;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+ssize_t uds_sendmsg(int s, struct msghdr *msg, int flags)
+{
+	FAR struct uds_conn_s *conn;
+	FAR struct uds_rights_s *rights = NULL;
+	struct uds_iter_s src;
+	char name[UNIX_PATH_MAX];
+	uint8_t namelen = 0;
+	ssize_t ret;
+
+	if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0)) {
+		return uds_result(-EINVAL);
+	}
+	if (msg->msg_name != NULL) {
+		ret = uds_getname((FAR const struct sockaddr *)msg->msg_name, msg->msg_namelen, name, &namelen);
+		if (ret == OK && namelen == 0) {
+			ret = -EINVAL;
+		}
+		if (ret < 0) {
+			return uds_result(ret);
+		}
+	}
+#ifdef CONFIG_NET_LOCAL_SCM
+	ret = uds_rights_get(msg, &rights);
+	if (ret < 0) {
+		return uds_result(ret);
+	}
+#endif
+
+	src.iov = msg->msg_iov;
+	src.iovcnt = msg->msg_iovlen;
+	src.off = 0;
+
+	uds_lock();
+	conn = uds_fdhold(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->type == SOCK_STREAM) {
+		if (msg->msg_name != NULL) {
+			ret = conn->state == UDS_CONNECTED ? -EISCONN : -EOPNOTSUPP;
+		} else {
+			ret = uds_stream_send(conn, &src, uds_iter_len(&src), flags, &rights);
+		}
+	} else {
+		ret = uds_dgram_send(conn, &src, uds_iter_len(&src), flags, msg->msg_name != NULL ? name : NULL, namelen, &rights);
+	}
+
+#ifdef CONFIG_NET_LOCAL_SCM
+	/* Nothing was sent, so the descriptors go back */
+
+	if (rights != NULL) {
+		uds_rights_free(rights);
+	}
+#endif
+	if (conn != NULL) {
+		uds_release(conn);
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+ssize_t uds_sendto(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen)
+{
+	struct iovec iov;
+	struct msghdr msg;
+
+	iov.iov_base = (FAR void *)data;
+	iov.iov_len = size;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = (FAR void *)to;
+	msg.msg_namelen = tolen;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+
+	return uds_sendmsg(s, &msg, flags);
+}
+
+ssize_t uds_send(int s, const void *data, size_t size, int flags)
+{
+	return uds_sendto(s, data, size, flags, NULL, 0);
+}
+
+ssize_t uds_recvmsg(int s, struct msghdr *msg, int flags)
+{
+	FAR struct uds_conn_s *conn;
+	FAR struct uds_rights_s *rights = NULL;
+	struct uds_iter_s dst;
+	ssize_t ret;
+
+	if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0)) {
+		return uds_result(-EINVAL);
+	}
+
+	dst.iov = msg->msg_iov;
+	dst.iovcnt = msg->msg_iovlen;
+	dst.off = 0;
+	msg->msg_flags = 0;
+
+	uds_lock();
+	conn = uds_fdhold(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->type == SOCK_STREAM) {
+		ret = uds_stream_recv(conn, &dst, uds_iter_len(&dst), flags, &rights);
+		msg->msg_namelen = 0;
+	} else {
+		ret = uds_dgram_recv(conn, &dst, uds_iter_len(&dst), flags, msg, &rights);
+	}
+	if (conn != NULL) {
+		uds_release(conn);
+	}
+	uds_unlock();
+
+#ifdef CONFIG_NET_LOCAL_SCM
+	if (rights != NULL) {
+		uds_rights_put(msg, rights);
+	} else
+#endif
+	{
+		msg->msg_controllen = 0;
+	}
+
+	return uds_result(ret);
+}
+
+ssize_t uds_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen)
+{
+	struct iovec iov;
+	struct msghdr msg;
+	ssize_t ret;
+
+	iov.iov_base = mem;
+	iov.iov_len = len;
+
+	memset(&msg, 0, sizeof(msg));
+	if (from != NULL && fromlen != NULL) {
+		msg.msg_name = from;
+		msg.msg_namelen = *fromlen;
+	}
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+
+	ret = uds_recvmsg(s, &msg, flags);
+	if (ret >= 0 && from != NULL && fromlen != NULL) {
+		*fromlen = msg.msg_namelen;
+	}
+	return ret;
+}
+
+ssize_t uds_recv(int s, void *mem, size_t len, int flags)
+{
+	return uds_recvfrom(s, mem, len, flags, NULL, NULL);
+}
@@ -0,0 +1,642 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/uds_sockif.c
+ *
+ *   Socket life cycle of local sockets: creation, naming, connection
+ *   set-up, descriptor operations and poll.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/ioctl.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "uds.h"
+#include "uds_net.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uds_stream_connect
+ *
+ * Description:
+ *   Create the server side of a new connection and queue it on the
+ *   listener bound to name.  The connection is usable as soon as it is
+ *   queued; data sent before accept() waits in the server's ring.
+ *
+ ****************************************************************************/
+
+static int uds_stream_connect(FAR struct uds_conn_s *conn, FAR const char *name, uint8_t namelen)
+{
+	FAR struct uds_conn_s *listener;
+	FAR struct uds_conn_s *server;
+	FAR struct uds_conn_s **tail;
+	int ret;
+
+	for (;;) {
+		if (conn->state == UDS_CONNECTED) {
+			return -EISCONN;
+		}
+		if (conn->state != UDS_IDLE) {
+			return -EINVAL;
+		}
+
+		listener = uds_find(SOCK_STREAM, name, namelen);
+		if (listener == NULL || listener->state != UDS_LISTENING) {
+			return -ECONNREFUSED;
+		}
+		if (listener->npending < listener->backlog) {
+			break;
+		}
+		if ((conn->flags & UDS_NONBLOCK) != 0) {
+			return -EAGAIN;
+		}
+
+		ret = uds_waitany();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	server = uds_alloc(SOCK_STREAM);
+	if (server == NULL) {
+		return -ENOMEM;
+	}
+	ret = uds_bufalloc(server);
+	if (ret == 0) {
+		ret = uds_bufalloc(conn);
+	}
+	if (ret < 0) {
+		uds_release(server);
+		return ret;
+	}
+
+	server->state = UDS_CONNECTED;
+	server->flags = UDS_PENDING | UDS_ACCEPTED;
+	server->namelen = listener->namelen;
+	memcpy(server->name, listener->name, listener->namelen);
+	server->peer = conn;
+	conn->peer = server;
+	conn->state = UDS_CONNECTED;
+
+	/* The accept queue holds the reference of the new connection */
+
+	for (tail = &listener->pending; *tail != NULL; tail = &(*tail)->next) ;
+	*tail = server;
+	listener->npending++;
+
+	uds_notify(&listener->rdsem, &listener->nrdwait);
+	uds_pollnotify(listener, POLLIN);
+	return 0;
+}
+
+static int uds_stream_accept(FAR struct uds_conn_s *conn, FAR struct sockaddr *addr, FAR socklen_t *addrlen)
+{
+	FAR struct uds_conn_s *server;
+	FAR struct uds_conn_s *client;
+	int ret;
+
+	if (conn->type != SOCK_STREAM) {
+		return -EOPNOTSUPP;
+	}
+
+	for (;;) {
+		if (conn->state != UDS_LISTENING) {
+			return -EINVAL;
+		}
+		if (conn->pending != NULL) {
+			break;
+		}
+		if ((conn->flags & UDS_NONBLOCK) != 0) {
+			return -EAGAIN;
+		}
+
+		ret = uds_wait(&conn->rdsem, &conn->nrdwait);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	server = conn->pending;
+	ret = uds_fdalloc(server);
+	if (ret < 0) {
+		return ret;
+	}
+
+	conn->pending = server->next;
+	conn->npending--;
+	server->next = NULL;
+	server->flags &= ~UDS_PENDING;
+
+	/* A connect() may be waiting for room in the accept queue */
+
+	uds_notifyany();
+
+	client = server->peer;
+	if (client != NULL) {
+		uds_putname(client->name, client->namelen, addr, addrlen);
+	} else {
+		uds_putname(NULL, 0, addr, addrlen);
+	}
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int uds_init(void *data)
+{
+	uds_initialize();
+	return 0;
+}
+
+int uds_socket(int domain, int type, int protocol)
+{
+	FAR struct uds_conn_s *conn;
+	int ret;
+
+	if (domain != AF_UNIX) {
+		return uds_result(-EAFNOSUPPORT);
+	}
+	if (type != SOCK_STREAM && type != SOCK_DGRAM) {
+		return uds_result(-ESOCKTNOSUPPORT);
+	}
+	if (protocol != 0) {
+		return uds_result(-EPROTONOSUPPORT);
+	}
+
+	uds_lock();
+	conn = uds_alloc(type);
+	if (conn == NULL) {
+		ret = -ENOMEM;
+	} else {
+		ret = uds_fdalloc(conn);
+		if (ret < 0) {
+			uds_release(conn);
+		}
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_close(int sockfd)
+{
+	FAR struct uds_conn_s *conn;
+
+	uds_lock();
+	conn = uds_fdfree(sockfd);
+	if (conn != NULL) {
+		uds_release(conn);
+	}
+	uds_unlock();
+
+	return uds_result(conn != NULL ? OK : -EBADF);
+}
+
+int uds_dup(int sockfd)
+{
+	FAR struct uds_conn_s *conn;
+	int ret = -EBADF;
+
+	uds_lock();
+	conn = uds_fdget(sockfd);
+	if (conn != NULL) {
+		ret = uds_fdalloc(conn);
+		if (ret >= 0) {
+			conn->crefs++;
+		}
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_dup2(int sockfd1, int sockfd2)
+{
+	FAR struct uds_conn_s *conn;
+	FAR struct uds_conn_s *old;
+	int ret = -EBADF;
+
+	uds_lock();
+	conn = uds_fdget(sockfd1);
+	if (conn != NULL && UDS_ISFD(sockfd2)) {
+		ret = OK;
+		if (sockfd1 != sockfd2) {
+			old = uds_fdfree(sockfd2);
+			conn->crefs++;
+			uds_fdset(sockfd2, conn);
+			if (old != NULL) {
+				uds_release(old);
+			}
+		}
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_checksd(int sd, int oflags)
+{
+	int ret;
+
+	uds_lock();
+	ret = uds_fdget(sd) != NULL ? OK : -EBADF;
+	uds_unlock();
+
+	return ret;
+}
+
+/* net_ioctl() expects a negated errno value, -ENOTTY for commands it
+ * should pass on to the network devices.
+ */
+
+int uds_ioctl(int sockfd, int cmd, unsigned long arg)
+{
+	FAR struct uds_conn_s *conn;
+	FAR int *value = (FAR int *)((uintptr_t)arg);
+	struct uds_dgram_s hdr;
+	int ret = OK;
+
+	if ((cmd == FIONREAD || cmd == FIONBIO) && value == NULL) {
+		return -EINVAL;
+	}
+
+	uds_lock();
+	conn = uds_fdget(sockfd);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (cmd == FIONREAD) {
+		/* A datagram socket reports the size of the next datagram */
+
+		*value = 0;
+		if (uds_ring_used(&conn->rx) > 0) {
+			if (conn->type == SOCK_DGRAM) {
+				uds_ring_peek(&conn->rx, 0, (FAR uint8_t *)&hdr, sizeof(hdr));
+				*value = hdr.datalen;
+			} else {
+				*value = (int)uds_ring_used(&conn->rx);
+			}
+		}
+	} else if (cmd == FIONBIO) {
+		if (*value != 0) {
+			conn->flags |= UDS_NONBLOCK;
+		} else {
+			conn->flags &= ~UDS_NONBLOCK;
+		}
+	} else {
+		ret = -ENOTTY;
+	}
+	uds_unlock();
+
+	return ret;
+}
+
+int uds_fcntl(int sockfd, int cmd, va_list ap)
+{
+	FAR struct uds_conn_s *conn;
+	int ret = -EBADF;
+
+	uds_lock();
+	conn = uds_fdget(sockfd);
+	if (conn != NULL) {
+		if (cmd == F_GETFL) {
+			ret = O_RDWR | ((conn->flags & UDS_NONBLOCK) != 0 ? O_NONBLOCK : 0);
+		} else if (cmd == F_SETFL) {
+			if ((va_arg(ap, int) & O_NONBLOCK) != 0) {
+				conn->flags |= UDS_NONBLOCK;
+			} else {
+				conn->flags &= ~UDS_NONBLOCK;
+			}
+			ret = OK;
+		} else {
+			ret = -EINVAL;
+		}
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+/****************************************************************************
+ * Name: uds_poll
+ *
+ * Description:
+ *   Set up or tear down a poll on a local socket.  The events in effect
+ *   are reported right away; later ones are posted by uds_pollnotify().
+ *
+ ****************************************************************************/
+
+int uds_poll(int fd, struct pollfd *fds, bool setup)
+{
+	FAR struct uds_conn_s *conn;
+	int ret = OK;
+	int i;
+
+	uds_lock();
+	conn = uds_fdget(fd);
+	if (setup) {
+		ret = -EBADF;
+		if (conn != NULL) {
+			ret = -EBUSY;
+			for (i = 0; i < CONFIG_NET_LOCAL_NPOLLWAITERS; i++) {
+				if (conn->fds[i] == NULL) {
+					conn->fds[i] = fds;
+					ret = OK;
+					break;
+				}
+			}
+		}
+		if (ret == OK) {
+			fds->revents |= fds->events & uds_pollstate(conn);
+			if (fds->revents != 0) {
+				sem_post(fds->sem);
+			}
+		}
+	} else if (conn != NULL) {
+		/* The descriptor may have been closed, or even reused, meanwhile */
+
+		for (i = 0; i < CONFIG_NET_LOCAL_NPOLLWAITERS; i++) {
+			if (conn->fds[i] == fds) {
+				conn->fds[i] = NULL;
+			}
+		}
+	}
+	uds_unlock();
+
+	return ret;
+}
+
+int uds_bind(int s, const struct sockaddr *name, socklen_t namelen)
+{
+	FAR struct uds_conn_s *conn;
+	char path[UNIX_PATH_MAX];
+	uint8_t pathlen;
+	int ret;
+
+	ret = uds_getname(name, namelen, path, &pathlen);
+	if (ret < 0) {
+		return uds_result(ret);
+	}
+
+	uds_lock();
+	conn = uds_fdget(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->namelen > 0) {
+		ret = -EINVAL;
+	} else if (pathlen == 0) {
+		ret = uds_autobind(conn);
+	} else if (uds_find(conn->type, path, pathlen) != NULL) {
+		ret = -EADDRINUSE;
+	} else {
+		memcpy(conn->name, path, pathlen);
+		conn->namelen = pathlen;
+	}
+
+	/* A bound datagram socket can be sent to from now on */
+
+	if (ret == OK && conn->type == SOCK_DGRAM) {
+		ret = uds_bufalloc(conn);
+		if (ret < 0) {
+			conn->namelen = 0;
+		}
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_listen(int s, int backlog)
+{
+	FAR struct uds_conn_s *conn;
+	int ret = OK;
+
+	uds_lock();
+	conn = uds_fdget(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->type != SOCK_STREAM) {
+		ret = -EOPNOTSUPP;
+	} else if ((conn->state != UDS_IDLE && conn->state != UDS_LISTENING) || conn->namelen == 0) {
+		ret = -EINVAL;
+	} else {
+		if (backlog < 1) {
+			backlog = 1;
+		} else if (backlog > CONFIG_NUDS_DESCRIPTORS) {
+			backlog = CONFIG_NUDS_DESCRIPTORS;
+		}
+		conn->backlog = (uint8_t)backlog;
+		conn->state = UDS_LISTENING;
+
+		/* A larger backlog may let waiting connect() calls in */
+
+		uds_notifyany();
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_connect(int s, const struct sockaddr *name, socklen_t namelen)
+{
+	FAR struct uds_conn_s *conn;
+	FAR struct uds_conn_s *dest;
+	char path[UNIX_PATH_MAX];
+	uint8_t pathlen;
+	int ret;
+
+	ret = uds_getname(name, namelen, path, &pathlen);
+	if (ret == OK && pathlen == 0) {
+		ret = -EINVAL;
+	}
+	if (ret < 0) {
+		return uds_result(ret);
+	}
+
+	uds_lock();
+	conn = uds_fdhold(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->type == SOCK_STREAM) {
+		ret = uds_stream_connect(conn, path, pathlen);
+	} else {
+		/* Set the default destination of a datagram socket */
+
+		dest = uds_find(SOCK_DGRAM, path, pathlen);
+		if (dest == NULL) {
+			ret = -ECONNREFUSED;
+		} else {
+			conn->peer = dest;
+		}
+	}
+	if (conn != NULL) {
+		uds_release(conn);
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_accept(int s, struct sockaddr *addr, socklen_t *addrlen)
+{
+	FAR struct uds_conn_s *conn;
+	int ret;
+
+	uds_lock();
+	conn = uds_fdhold(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else {
+		ret = uds_stream_accept(conn, addr, addrlen);
+		uds_release(conn);
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_shutdown(int s, int how)
+{
+	FAR struct uds_conn_s *conn;
+	FAR struct uds_conn_s *peer;
+	uint8_t flags;
+	int ret = OK;
+
+	if (how == SHUT_RD) {
+		flags = UDS_RDSHUT;
+	} else if (how == SHUT_WR) {
+		flags = UDS_WRSHUT;
+	} else if (how == SHUT_RDWR) {
+		flags = UDS_RDSHUT | UDS_WRSHUT;
+	} else {
+		return uds_result(-EINVAL);
+	}
+
+	uds_lock();
+	conn = uds_fdget(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->type == SOCK_STREAM && conn->state != UDS_CONNECTED && conn->state != UDS_DISCONNECTED) {
+		ret = -ENOTCONN;
+	} else {
+		conn->flags |= flags;
+		uds_notify(&conn->rdsem, &conn->nrdwait);
+		uds_notify(&conn->wrsem, &conn->nwrwait);
+		uds_pollnotify(conn, uds_pollstate(conn));
+
+		/* The stream peer reads end of file once its ring is drained */
+
+		peer = conn->peer;
+		if (conn->type == SOCK_STREAM && peer != NULL && (flags & UDS_WRSHUT) != 0) {
+			uds_notify(&peer->rdsem, &peer->nrdwait);
+			uds_pollnotify(peer, POLLIN);
+		}
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_getsockname(int s, struct sockaddr *name, socklen_t *namelen)
+{
+	FAR struct uds_conn_s *conn;
+
+	uds_lock();
+	conn = uds_fdget(s);
+	if (conn != NULL) {
+		uds_putname(conn->name, conn->namelen, name, namelen);
+	}
+	uds_unlock();
+
+	return uds_result(conn != NULL ? OK : -EBADF);
+}
+
+int uds_getpeername(int s, struct sockaddr *name, socklen_t *namelen)
+{
+	FAR struct uds_conn_s *conn;
+	int ret = OK;
+
+	uds_lock();
+	conn = uds_fdget(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (conn->peer == NULL) {
+		ret = -ENOTCONN;
+	} else {
+		uds_putname(conn->peer->name, conn->peer->namelen, name, namelen);
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
+
+int uds_setsockopt(int s, int level, int optname, const void *optval, socklen_t optlen)
+{
+	int ret;
+
+	ret = uds_checksd(s, 0);
+	if (ret == OK) {
+		ret = -ENOPROTOOPT;
+	}
+	return uds_result(ret);
+}
+
+int uds_getsockopt(int s, int level, int optname, void *optval, socklen_t *optlen)
+{
+	FAR struct uds_conn_s *conn;
+	int ret = OK;
+
+	if (optval == NULL || optlen == NULL || *optlen < sizeof(int)) {
+		return uds_result(-EINVAL);
+	}
+	if (level != SOL_SOCKET) {
+		return uds_result(-ENOPROTOOPT);
+	}
+
+	uds_lock();
+	conn = uds_fdget(s);
+	if (conn == NULL) {
+		ret = -EBADF;
+	} else if (optname == SO_TYPE) {
+		*(FAR int *)optval = conn->type;
+	} else if (optname == SO_ERROR) {
+		*(FAR int *)optval = 0;
+	} else if (optname == SO_RCVBUF) {
+		*(FAR int *)optval = UDS_BUFSIZE;
+	} else {
+		ret = -ENOPROTOOPT;
+	}
+	if (ret == OK) {
+		*optlen = sizeof(int);
+	}
+	uds_unlock();
+
+	return uds_result(ret);
+}
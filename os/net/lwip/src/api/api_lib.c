@@ -528,18 +528,25 @@ static err_t netconn_recv_data(struct netconn *conn, void **new_buf)
 	if (NETCONNTYPE_GROUP(conn->type) == NETCONN_TCP)
 #endif							/* (LWIP_UDP || LWIP_RAW) */
 	{
-		/* Let the stack know that we have taken the data. */
-		/* @todo: Speedup: Don't block and wait for the answer here
-		   (to prevent multiple thread-switches). */
-		API_MSG_VAR_REF(msg).conn = conn;
-		if (buf != NULL) {
-			API_MSG_VAR_REF(msg).msg.r.len = ((struct pbuf *)buf)->tot_len;
-		} else {
-			API_MSG_VAR_REF(msg).msg.r.len = 1;
-		}
+#if LWIP_TCP_ZEROCOPY_RECV
+		/* The owner opens the window itself with netconn_recved(), but the
+		   FIN is still acknowledged here. */
+		if (!netconn_get_noautorecved(conn) || (buf == NULL))
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
+		{
+			/* Let the stack know that we have taken the data. */
+			/* @todo: Speedup: Don't block and wait for the answer here
+			   (to prevent multiple thread-switches). */
+			API_MSG_VAR_REF(msg).conn = conn;
+			if (buf != NULL) {
+				API_MSG_VAR_REF(msg).msg.r.len = ((struct pbuf *)buf)->tot_len;
+			} else {
+				API_MSG_VAR_REF(msg).msg.r.len = 1;
+			}
 
-		/* don't care for the return value of lwip_netconn_do_recv */
-		netconn_apimsg(lwip_netconn_do_recv, &API_MSG_VAR_REF(msg));
+			/* don't care for the return value of lwip_netconn_do_recv */
+			netconn_apimsg(lwip_netconn_do_recv, &API_MSG_VAR_REF(msg));
+		}
 		API_MSG_VAR_FREE(msg);
 
 		/* If we are closed, we indicate that we no longer wish to use the socket */
@@ -596,6 +603,38 @@ err_t netconn_recv_tcp_pbuf(struct netconn *conn, struct pbuf **new_buf)
 	return netconn_recv_data(conn, (void **)new_buf);
 }
 
+#if LWIP_TCP_ZEROCOPY_RECV
+/**
+ * Open the receive window of a TCP netconn for data the application has
+ * finished with. Only needed when NETCONN_FLAG_NO_AUTO_RECVED is set; the
+ * data must have been received with auto-recved off, or it would be
+ * acknowledged twice.
+ *
+ * @param conn the netconn the data was received on
+ * @param length number of bytes the application has consumed
+ * @return ERR_OK, or ERR_ARG if conn is not a TCP netconn
+ */
+err_t netconn_recved(struct netconn *conn, u32_t length)
+{
+	API_MSG_VAR_DECLARE(msg);
+	err_t err;
+
+	LWIP_ERROR("netconn_recved: invalid conn", (conn != NULL) && NETCONNTYPE_GROUP(netconn_type(conn)) == NETCONN_TCP, return ERR_ARG;);
+
+	if (length == 0) {
+		return ERR_OK;
+	}
+
+	API_MSG_VAR_ALLOC(msg);
+	API_MSG_VAR_REF(msg).conn = conn;
+	API_MSG_VAR_REF(msg).msg.r.len = length;
+	err = netconn_apimsg(lwip_netconn_do_recv, &API_MSG_VAR_REF(msg));
+	API_MSG_VAR_FREE(msg);
+
+	return err;
+}
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
+
 /**
  * Receive data (in form of a netbuf containing a packet buffer) from a netconn
  *
@@ -701,6 +740,40 @@ err_t netconn_send(struct netconn *conn, struct netbuf *buf)
 	return err;
 }
 
+#if LWIP_SOCKET_MMSG
+/**
+ * Send several netbufs over a UDP or RAW netconn with a single message to
+ * the tcpip thread. Sending stops at the first netbuf that fails.
+ *
+ * @param conn the UDP or RAW netconn over which to send data
+ * @param bufs the netbufs to send, each with its own destination
+ * @param num number of netbufs in bufs
+ * @param sent pointer to a location that receives the number of netbufs sent
+ * @return ERR_OK if all netbufs were sent, the error of the failing one otherwise
+ */
+err_t netconn_send_batch(struct netconn *conn, struct netbuf **bufs, u16_t num, u16_t *sent)
+{
+	API_MSG_VAR_DECLARE(msg);
+	err_t err;
+
+	LWIP_ERROR("netconn_send_batch: invalid conn", (conn != NULL), return ERR_ARG;);
+	LWIP_ERROR("netconn_send_batch: invalid bufs", (bufs != NULL) && (sent != NULL), return ERR_ARG;);
+
+	LWIP_DEBUGF(API_LIB_DEBUG, ("netconn_send_batch: sending %" U16_F " netbufs\n", num));
+
+	API_MSG_VAR_ALLOC(msg);
+	API_MSG_VAR_REF(msg).conn = conn;
+	API_MSG_VAR_REF(msg).msg.bb.bufs = bufs;
+	API_MSG_VAR_REF(msg).msg.bb.num = num;
+	API_MSG_VAR_REF(msg).msg.bb.sent = 0;
+	err = netconn_apimsg(lwip_netconn_do_send_batch, &API_MSG_VAR_REF(msg));
+	*sent = API_MSG_VAR_REF(msg).msg.bb.sent;
+	API_MSG_VAR_FREE(msg);
+
+	return err;
+}
+#endif							/* LWIP_SOCKET_MMSG */
+
 /**
  * Send data over a TCP netconn.
  *
@@ -62,6 +62,8 @@
 #include "lwip/ip_addr.h"
 #include "lwip/api.h"
 #include "lwip/dns.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
 
 #include <string.h>				/* memset */
 #include <stdlib.h>				/* atoi */
@@ -92,6 +94,347 @@ int h_errno;
 #define HOSTENT_STORAGE static
 #endif							/* LWIP_DNS_API_STATIC_HOSTENT */
 
+/** A lookup returns at most the first A and the first AAAA answer */
+#define NETDB_MAX_ADDRS 2
+
+/** Address family gethostbyname() resolves */
+#if LWIP_IPV4
+#define NETDB_HOSTENT_FAMILY AF_INET
+#else
+#define NETDB_HOSTENT_FAMILY AF_INET6
+#endif
+
+/* states of one query of a lookup */
+#define NETDB_QUERY_PENDING 0
+#define NETDB_QUERY_FOUND   1
+#define NETDB_QUERY_FAILED  2
+
+struct netdb_req;
+
+/** One A or AAAA query of a lookup */
+struct netdb_query {
+	struct netdb_req *req;
+	ip_addr_t addr;
+	u8_t type;					/* LWIP_DNS_ADDRTYPE_IPV4 or LWIP_DNS_ADDRTYPE_IPV6 */
+	u8_t state;
+};
+
+/** A lookup of one name. The A and AAAA queries of an AF_UNSPEC lookup are
+ * sent together; done() is called in the tcpip thread once both are answered. */
+struct netdb_req {
+	struct netdb_query q[NETDB_MAX_ADDRS];
+	const char *name;
+	u8_t nq;
+	u8_t pending;				/* queries in flight, plus one while they are sent */
+	void (*done)(struct netdb_req *req);
+	void *arg;
+};
+
+#if LWIP_DNS_CACHE_SIZE
+/* keeps expires - now within the s32_t range used to compare it */
+#define NETDB_CACHE_MAX_TTL (0x7fffffffUL / 1000)
+
+/** One cached answer: the first address of one record type for a name */
+struct netdb_cache_entry {
+	char *name;					/* NULL if the entry is free */
+	u32_t expires;				/* sys_now() at which the entry goes stale */
+	ip_addr_t addr;
+	u8_t type;
+	u8_t negative;				/* the lookup failed */
+};
+
+/* read from any thread, written only from the tcpip thread, both under SYS_ARCH_PROTECT */
+static struct netdb_cache_entry netdb_cache[LWIP_DNS_CACHE_SIZE];
+
+static s32_t netdb_cache_left(const struct netdb_cache_entry *e, u32_t now)
+{
+	return e->name == NULL ? 0 : (s32_t)(e->expires - now);
+}
+
+/**
+ * Look a name up in the cache.
+ *
+ * @return 1 and the address if the name resolved, 0 if it recently failed
+ *         to resolve, -1 if there is no fresh answer for it
+ */
+static int netdb_cache_get(const char *name, u8_t type, ip_addr_t *addr)
+{
+	struct netdb_cache_entry *e;
+	u32_t now = sys_now();
+	int ret = -1;
+	u8_t i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	for (i = 0; i < LWIP_DNS_CACHE_SIZE; i++) {
+		e = &netdb_cache[i];
+		if ((e->type == type) && (netdb_cache_left(e, now) > 0) && (lwip_stricmp(e->name, name) == 0)) {
+			if (e->negative) {
+				ret = 0;
+			} else {
+				ip_addr_copy(*addr, e->addr);
+				ret = 1;
+			}
+			break;
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	return ret;
+}
+
+/**
+ * Remember the answer to a query. A found address is kept for the TTL the
+ * DNS server gave it, a failure (addr == NULL) for LWIP_DNS_NEGATIVE_TTL.
+ * The entry of the same name and type is replaced, otherwise the one that
+ * expires first. Called from the tcpip thread only.
+ */
+static void netdb_cache_put(const char *name, u8_t type, const ip_addr_t *addr)
+{
+	struct netdb_cache_entry *e;
+	struct netdb_cache_entry *victim;
+	char *copy;
+	char *old;
+	size_t namelen;
+	u32_t ttl;
+	u32_t now;
+	u8_t i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	/* literals, local names and zero TTL answers are not cached */
+	ttl = (addr != NULL) ? dns_lookup_ttl(name, addr) : LWIP_DNS_NEGATIVE_TTL;
+	if (ttl == 0) {
+		return;
+	}
+	if (ttl > NETDB_CACHE_MAX_TTL) {
+		ttl = NETDB_CACHE_MAX_TTL;
+	}
+
+	namelen = strlen(name);
+	copy = (char *)mem_malloc((mem_size_t)(namelen + 1));
+	if (copy == NULL) {
+		return;
+	}
+	MEMCPY(copy, name, namelen + 1);
+
+	now = sys_now();
+	SYS_ARCH_PROTECT(lev);
+	victim = &netdb_cache[0];
+	for (i = 0; i < LWIP_DNS_CACHE_SIZE; i++) {
+		e = &netdb_cache[i];
+		if ((e->name != NULL) && (e->type == type) && (lwip_stricmp(e->name, name) == 0)) {
+			victim = e;
+			break;
+		}
+		if (netdb_cache_left(e, now) < netdb_cache_left(victim, now)) {
+			victim = e;
+		}
+	}
+	old = victim->name;
+	victim->name = copy;
+	victim->type = type;
+	victim->expires = now + ttl * 1000;
+	victim->negative = (addr == NULL);
+	if (addr != NULL) {
+		ip_addr_copy(victim->addr, *addr);
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (old != NULL) {
+		mem_free(old);
+	}
+}
+
+/**
+ * Drop every cached answer, e.g. after the DNS servers changed.
+ */
+void lwip_dns_cache_flush(void)
+{
+	char *old;
+	u8_t i;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	for (i = 0; i < LWIP_DNS_CACHE_SIZE; i++) {
+		SYS_ARCH_PROTECT(lev);
+		old = netdb_cache[i].name;
+		netdb_cache[i].name = NULL;
+		SYS_ARCH_UNPROTECT(lev);
+		if (old != NULL) {
+			mem_free(old);
+		}
+	}
+}
+#endif							/* LWIP_DNS_CACHE_SIZE */
+
+/**
+ * Set up a lookup of name: an A query for AF_INET, an AAAA query for
+ * AF_INET6 and both for AF_UNSPEC. name must stay valid until done().
+ */
+static void netdb_req_init(struct netdb_req *req, const char *name, int family)
+{
+	u8_t i;
+
+	memset(req, 0, sizeof(*req));
+	req->name = name;
+#if LWIP_IPV4
+	if (family != AF_INET6) {
+		req->q[req->nq++].type = LWIP_DNS_ADDRTYPE_IPV4;
+	}
+#endif							/* LWIP_IPV4 */
+#if LWIP_IPV6
+	if (family != AF_INET) {
+		req->q[req->nq++].type = LWIP_DNS_ADDRTYPE_IPV6;
+	}
+#endif							/* LWIP_IPV6 */
+	for (i = 0; i < req->nq; i++) {
+		req->q[i].req = req;
+		req->q[i].state = NETDB_QUERY_PENDING;
+	}
+}
+
+/**
+ * Answer the queries of a lookup from the cache.
+ *
+ * @return the number of queries that still have to be sent
+ */
+static u8_t netdb_req_lookup(struct netdb_req *req)
+{
+	u8_t left = 0;
+	u8_t i;
+
+	for (i = 0; i < req->nq; i++) {
+#if LWIP_DNS_CACHE_SIZE
+		switch (netdb_cache_get(req->name, req->q[i].type, &req->q[i].addr)) {
+		case 1:
+			req->q[i].state = NETDB_QUERY_FOUND;
+			continue;
+		case 0:
+			req->q[i].state = NETDB_QUERY_FAILED;
+			continue;
+		default:
+			break;
+		}
+#endif							/* LWIP_DNS_CACHE_SIZE */
+		left++;
+	}
+
+	return left;
+}
+
+static void netdb_req_put(struct netdb_req *req)
+{
+	if (--req->pending == 0) {
+		req->done(req);
+	}
+}
+
+static void netdb_query_done(struct netdb_query *q, const ip_addr_t *addr)
+{
+	if (addr != NULL) {
+		ip_addr_copy(q->addr, *addr);
+		q->state = NETDB_QUERY_FOUND;
+	} else {
+		q->state = NETDB_QUERY_FAILED;
+	}
+	netdb_req_put(q->req);
+}
+
+/** dns_found_callback of one query */
+static void netdb_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
+{
+	struct netdb_query *q = (struct netdb_query *)arg;
+
+#if LWIP_DNS_CACHE_SIZE
+	netdb_cache_put(name, q->type, ipaddr);
+#else
+	LWIP_UNUSED_ARG(name);
+#endif							/* LWIP_DNS_CACHE_SIZE */
+	netdb_query_done(q, ipaddr);
+}
+
+/** Send the queries the cache could not answer; runs in the tcpip thread */
+static void netdb_req_start(void *arg)
+{
+	struct netdb_req *req = (struct netdb_req *)arg;
+	struct netdb_query *q;
+	ip_addr_t addr;
+	err_t err;
+	u8_t i;
+
+	req->pending = 1;
+	for (i = 0; i < req->nq; i++) {
+		q = &req->q[i];
+		if (q->state != NETDB_QUERY_PENDING) {
+			continue;
+		}
+		req->pending++;
+		err = dns_gethostbyname_addrtype(req->name, &addr, netdb_dns_found, q, q->type);
+		if (err == ERR_OK) {
+#if LWIP_DNS_CACHE_SIZE
+			netdb_cache_put(req->name, q->type, &addr);
+#endif							/* LWIP_DNS_CACHE_SIZE */
+			netdb_query_done(q, &addr);
+		} else if (err != ERR_INPROGRESS) {
+			/* no server or no free dns_table entry: not worth caching */
+			netdb_query_done(q, NULL);
+		}
+	}
+	netdb_req_put(req);
+}
+
+static void netdb_req_wakeup(struct netdb_req *req)
+{
+	sys_sem_signal((sys_sem_t *)req->arg);
+}
+
+/**
+ * Send the queries of a lookup and block until they are answered.
+ *
+ * @return 0 when done, EAI_MEMORY if the lookup could not be started
+ */
+static int netdb_req_wait(struct netdb_req *req)
+{
+	sys_sem_t sem;
+
+	if (sys_sem_new(&sem, 0) != ERR_OK) {
+		return EAI_MEMORY;
+	}
+	req->done = netdb_req_wakeup;
+	req->arg = &sem;
+	if (tcpip_callback(netdb_req_start, req) != ERR_OK) {
+		sys_sem_free(&sem);
+		return EAI_MEMORY;
+	}
+	sys_sem_wait(&sem);
+	sys_sem_free(&sem);
+
+	return 0;
+}
+
+/**
+ * Resolve a name to the first address gethostbyname() reports.
+ *
+ * @return ERR_OK and the address, or an error if the name did not resolve
+ */
+static err_t netdb_gethostbyname(const char *name, ip_addr_t *addr)
+{
+	struct netdb_req req;
+
+	if (ipaddr_aton(name, addr)) {
+		return ERR_OK;
+	}
+	netdb_req_init(&req, name, NETDB_HOSTENT_FAMILY);
+	if ((netdb_req_lookup(&req) > 0) && (netdb_req_wait(&req) != 0)) {
+		return ERR_MEM;
+	}
+	if (req.q[0].state != NETDB_QUERY_FOUND) {
+		return ERR_VAL;
+	}
+	ip_addr_copy(*addr, req.q[0].addr);
+
+	return ERR_OK;
+}
+
 /**
  * Returns an entry containing addresses of address family AF_INET
  * for the host with name name.
@@ -114,7 +457,7 @@ struct hostent *lwip_gethostbyname(const char *name)
 	HOSTENT_STORAGE char s_hostname[DNS_MAX_NAME_LENGTH + 1];
 
 	/* query host IP address */
-	err = netconn_gethostbyname(name, &addr);
+	err = netdb_gethostbyname(name, &addr);
 	if (err != ERR_OK) {
 		LWIP_DEBUGF(DNS_DEBUG, ("lwip_gethostbyname(%s) failed, err=%d\n", name, err));
 		h_errno = HOST_NOT_FOUND;
@@ -212,7 +555,7 @@ int lwip_gethostbyname_r(const char *name, struct hostent *ret, char *buf, size_
 	hostname = ((char *)h) + sizeof(struct gethostbyname_r_helper);
 
 	/* query host IP address */
-	err = netconn_gethostbyname(name, &h->addr);
+	err = netdb_gethostbyname(name, &h->addr);
 	if (err != ERR_OK) {
 		LWIP_DEBUGF(DNS_DEBUG, ("lwip_gethostbyname(%s) failed, err=%d\n", name, err));
 		*h_errnop = HOST_NOT_FOUND;
@@ -259,113 +602,96 @@ void lwip_freeaddrinfo(struct addrinfo *ai)
 }
 
 /**
- * Translates the name of a service location (for example, a host name) and/or
- * a service name and returns a set of socket addresses and associated
- * information to be used in creating a socket with which to address the
- * specified service.
- * Memory for the result is allocated internally and must be freed by calling
- * lwip_freeaddrinfo()!
- *
- * Due to a limitation in dns_gethostbyname, only the first address of a
- * host is returned.
- * Also, service names are not supported (only port numbers)!
- *
- * @param nodename descriptive name or address string of the host
- *                 (may be NULL -> local address)
- * @param servname port number as string of NULL
- * @param hints structure containing input values that set socktype and protocol
- * @param res pointer to a pointer where to store the result (set to NULL on failure)
- * @return 0 on success, non-zero on failure
+ * Check the arguments of getaddrinfo() and convert the service to a port.
  *
- * @todo: implement AI_V4MAPPED, AI_ADDRCONFIG
+ * @return 0 on success, an EAI_ error otherwise
  */
-int lwip_getaddrinfo(const char *nodename, const char *servname, const struct addrinfo *hints, struct addrinfo **res)
+static int netdb_check_args(const char *nodename, const char *servname, const struct addrinfo *hints, int *family, int *port)
 {
-	err_t err;
-	ip_addr_t addr;
-	struct addrinfo *ai;
-	struct sockaddr_storage *sa = NULL;
-	int port_nr = 0;
-	size_t total_size;
-	size_t namelen = 0;
-	int ai_family;
+	*family = AF_UNSPEC;
+	*port = 0;
 
-	if (res == NULL) {
-		return EAI_FAIL;
-	}
-	*res = NULL;
 	if ((nodename == NULL) && (servname == NULL)) {
 		return EAI_NONAME;
 	}
 
 	if (hints != NULL) {
-		ai_family = hints->ai_family;
-		if ((ai_family != AF_UNSPEC)
+		*family = hints->ai_family;
+		if ((*family != AF_UNSPEC)
 #if LWIP_IPV4
-			&& (ai_family != AF_INET)
+			&& (*family != AF_INET)
 #endif							/* LWIP_IPV4 */
 #if LWIP_IPV6
-			&& (ai_family != AF_INET6)
+			&& (*family != AF_INET6)
 #endif							/* LWIP_IPV6 */
 		   ) {
 			return EAI_FAMILY;
 		}
-	} else {
-		ai_family = AF_UNSPEC;
 	}
 
 	if (servname != NULL) {
 		/* service name specified: convert to port number
 		 * @todo?: currently, only ASCII integers (port numbers) are supported (AI_NUMERICSERV)! */
-		port_nr = atoi(servname);
-		if ((port_nr <= 0) || (port_nr > 0xffff)) {
+		*port = atoi(servname);
+		if ((*port <= 0) || (*port > 0xffff)) {
 			return EAI_SERVICE;
 		}
 	}
 
-	if (nodename != NULL) {
-		/* service location specified, try to resolve */
-		if ((hints != NULL) && (hints->ai_flags & AI_NUMERICHOST)) {
-			/* no DNS lookup, just parse for an address string */
-			if (!ipaddr_aton(nodename, &addr)) {
-				return EAI_NONAME;
-			}
-#if LWIP_IPV4 && LWIP_IPV6
-			if ((IP_IS_V6_VAL(addr) && ai_family == AF_INET) || (IP_IS_V4_VAL(addr) && ai_family == AF_INET6)) {
-				return EAI_NONAME;
-			}
-#endif							/* LWIP_IPV4 && LWIP_IPV6 */
-		} else {
-#if LWIP_IPV4 && LWIP_IPV6
-			/* AF_UNSPEC: prefer IPv4 */
-			u8_t type = NETCONN_DNS_IPV4_IPV6;
-			if (ai_family == AF_INET) {
-				type = NETCONN_DNS_IPV4;
-			} else if (ai_family == AF_INET6) {
-				type = NETCONN_DNS_IPV6;
-			}
-#endif							/* LWIP_IPV4 && LWIP_IPV6 */
-			err = netconn_gethostbyname_addrtype(nodename, &addr, type);
-			if (err != ERR_OK) {
-				return EAI_FAIL;
-			}
-		}
-	} else {
+	if ((nodename != NULL) && (strlen(nodename) > DNS_MAX_NAME_LENGTH)) {
+		/* invalid name length */
+		return EAI_FAIL;
+	}
+
+	return 0;
+}
+
+/**
+ * Find the address of a node that needs no lookup: the local address for a
+ * NULL nodename, or an address string.
+ *
+ * @return 0 and the address, EAI_NONAME if the address string does not match
+ *         the family, 1 if nodename has to be looked up
+ */
+static int netdb_numeric(const char *nodename, const struct addrinfo *hints, int family, ip_addr_t *addr)
+{
+	if (nodename == NULL) {
 		/* service location specified, use loopback address */
 		if ((hints != NULL) && (hints->ai_flags & AI_PASSIVE)) {
-			ip_addr_set_any(ai_family == AF_INET6, &addr);
+			ip_addr_set_any(family == AF_INET6, addr);
 		} else {
-			ip_addr_set_loopback(ai_family == AF_INET6, &addr);
+			ip_addr_set_loopback(family == AF_INET6, addr);
 		}
+		return 0;
 	}
 
+	if (!ipaddr_aton(nodename, addr)) {
+		return 1;
+	}
+#if LWIP_IPV4 && LWIP_IPV6
+	if ((IP_IS_V6_VAL(*addr) && family == AF_INET) || (IP_IS_V4_VAL(*addr) && family == AF_INET6)) {
+		return EAI_NONAME;
+	}
+#endif							/* LWIP_IPV4 && LWIP_IPV6 */
+
+	return 0;
+}
+
+/**
+ * Allocate one addrinfo for an address.
+ *
+ * @return the addrinfo, or NULL if out of memory
+ */
+static struct addrinfo *netdb_addrinfo(const ip_addr_t *addr, int port, int socktype, int protocol, const char *nodename)
+{
+	struct addrinfo *ai;
+	struct sockaddr_storage *sa;
+	size_t total_size;
+	size_t namelen = 0;
+
 	total_size = sizeof(struct addrinfo) + sizeof(struct sockaddr_storage);
 	if (nodename != NULL) {
 		namelen = strlen(nodename);
-		if (namelen > DNS_MAX_NAME_LENGTH) {
-			/* invalid name length */
-			return EAI_FAIL;
-		}
 		LWIP_ASSERT("namelen is too long", total_size + namelen + 1 > total_size);
 		total_size += namelen + 1;
 	}
@@ -373,39 +699,36 @@ int lwip_getaddrinfo(const char *nodename, const char *servname, const struct ad
 	LWIP_ASSERT("total_size <= NETDB_ELEM_SIZE: please report this!", total_size <= NETDB_ELEM_SIZE);
 	ai = (struct addrinfo *)memp_malloc(MEMP_NETDB);
 	if (ai == NULL) {
-		return EAI_MEMORY;
+		return NULL;
 	}
 	memset(ai, 0, total_size);
 	/* cast through void* to get rid of alignment warnings */
 	sa = (struct sockaddr_storage *)(void *)((u8_t *) ai + sizeof(struct addrinfo));
-	if (IP_IS_V6_VAL(addr)) {
+	if (IP_IS_V6_VAL(*addr)) {
 #if LWIP_IPV6
 		struct sockaddr_in6 *sa6 = (struct sockaddr_in6 *)sa;
 		/* set up sockaddr */
-		inet6_addr_from_ip6addr(&sa6->sin6_addr, ip_2_ip6(&addr));
+		inet6_addr_from_ip6addr(&sa6->sin6_addr, ip_2_ip6(addr));
 		sa6->sin6_family = AF_INET6;
 		sa6->sin6_len = sizeof(struct sockaddr_in6);
-		sa6->sin6_port = lwip_htons((u16_t) port_nr);
+		sa6->sin6_port = lwip_htons((u16_t) port);
 		ai->ai_family = AF_INET6;
 #endif							/* LWIP_IPV6 */
 	} else {
 #if LWIP_IPV4
 		struct sockaddr_in *sa4 = (struct sockaddr_in *)sa;
 		/* set up sockaddr */
-		inet_addr_from_ip4addr(&sa4->sin_addr, ip_2_ip4(&addr));
+		inet_addr_from_ip4addr(&sa4->sin_addr, ip_2_ip4(addr));
 		sa4->sin_family = AF_INET;
 		sa4->sin_len = sizeof(struct sockaddr_in);
-		sa4->sin_port = lwip_htons((u16_t) port_nr);
+		sa4->sin_port = lwip_htons((u16_t) port);
 		ai->ai_family = AF_INET;
 #endif							/* LWIP_IPV4 */
 	}
 
 	/* set up addrinfo */
-	if (hints != NULL) {
-		/* copy socktype & protocol from hints if specified */
-		ai->ai_socktype = hints->ai_socktype;
-		ai->ai_protocol = hints->ai_protocol;
-	}
+	ai->ai_socktype = socktype;
+	ai->ai_protocol = protocol;
 	if (nodename != NULL) {
 		/* copy nodename to canonname if specified */
 		ai->ai_canonname = ((char *)ai + sizeof(struct addrinfo) + sizeof(struct sockaddr_storage));
@@ -415,10 +738,195 @@ int lwip_getaddrinfo(const char *nodename, const char *servname, const struct ad
 	ai->ai_addrlen = sizeof(struct sockaddr_storage);
 	ai->ai_addr = (struct sockaddr *)sa;
 
-	*res = ai;
+	return ai;
+}
+
+/**
+ * Build the result of a lookup: one addrinfo per address found, IPv4 first.
+ *
+ * @return 0 on success, EAI_FAIL if nothing was found, EAI_MEMORY
+ */
+static int netdb_req_result(const struct netdb_req *req, int port, int socktype, int protocol, struct addrinfo **res)
+{
+	struct addrinfo **tail = res;
+	u8_t i;
+
+	*res = NULL;
+	for (i = 0; i < req->nq; i++) {
+		if (req->q[i].state != NETDB_QUERY_FOUND) {
+			continue;
+		}
+		/* only the first entry carries the canonical name */
+		*tail = netdb_addrinfo(&req->q[i].addr, port, socktype, protocol, (*res == NULL) ? req->name : NULL);
+		if (*tail == NULL) {
+			lwip_freeaddrinfo(*res);
+			*res = NULL;
+			return EAI_MEMORY;
+		}
+		tail = &(*tail)->ai_next;
+	}
+
+	return (*res != NULL) ? 0 : EAI_FAIL;
+}
+
+/**
+ * Translates the name of a service location (for example, a host name) and/or
+ * a service name and returns a set of socket addresses and associated
+ * information to be used in creating a socket with which to address the
+ * specified service.
+ * Memory for the result is allocated internally and must be freed by calling
+ * lwip_freeaddrinfo()!
+ *
+ * For AF_UNSPEC the A and AAAA queries are sent in parallel and the first
+ * address of each is returned, IPv4 first. Answers are kept in a cache of
+ * LWIP_DNS_CACHE_SIZE entries, so a repeated lookup does not block.
+ * Also, service names are not supported (only port numbers)!
+ *
+ * @param nodename descriptive name or address string of the host
+ *                 (may be NULL -> local address)
+ * @param servname port number as string of NULL
+ * @param hints structure containing input values that set socktype and protocol
+ * @param res pointer to a pointer where to store the result (set to NULL on failure)
+ * @return 0 on success, non-zero on failure
+ *
+ * @todo: implement AI_V4MAPPED, AI_ADDRCONFIG
+ */
+int lwip_getaddrinfo(const char *nodename, const char *servname, const struct addrinfo *hints, struct addrinfo **res)
+{
+	struct netdb_req req;
+	ip_addr_t addr;
+	int ai_family;
+	int port_nr;
+	int socktype = (hints != NULL) ? hints->ai_socktype : 0;
+	int protocol = (hints != NULL) ? hints->ai_protocol : 0;
+	int err;
+
+	if (res == NULL) {
+		return EAI_FAIL;
+	}
+	*res = NULL;
+
+	err = netdb_check_args(nodename, servname, hints, &ai_family, &port_nr);
+	if (err != 0) {
+		return err;
+	}
+
+	err = netdb_numeric(nodename, hints, ai_family, &addr);
+	if (err == 0) {
+		*res = netdb_addrinfo(&addr, port_nr, socktype, protocol, nodename);
+		return (*res != NULL) ? 0 : EAI_MEMORY;
+	}
+	if ((err != 1) || ((hints != NULL) && (hints->ai_flags & AI_NUMERICHOST))) {
+		/* no DNS lookup for AI_NUMERICHOST */
+		return EAI_NONAME;
+	}
+
+	netdb_req_init(&req, nodename, ai_family);
+	if (netdb_req_lookup(&req) > 0) {
+		err = netdb_req_wait(&req);
+		if (err != 0) {
+			return err;
+		}
+	}
+
+	return netdb_req_result(&req, port_nr, socktype, protocol, res);
+}
+
+#if LWIP_DNS_ASYNC
+/** State of one lwip_getaddrinfo_async() call */
+struct netdb_async {
+	struct netdb_req req;
+	lwip_getaddrinfo_cb cb;
+	void *arg;
+	int port;
+	int socktype;
+	int protocol;
+	char name[1];				/* the rest of the name follows */
+};
+
+static void netdb_async_done(struct netdb_req *req)
+{
+	struct netdb_async *a = (struct netdb_async *)req->arg;
+	struct addrinfo *res;
+	int err;
+
+	err = netdb_req_result(req, a->port, a->socktype, a->protocol, &res);
+	a->cb(err, res, a->arg);
+	mem_free(a);
+}
+
+/**
+ * Like lwip_getaddrinfo(), but returns without waiting for the DNS server.
+ * cb is called exactly once with the result, which it owns and frees with
+ * lwip_freeaddrinfo(). It is called before this function returns when the
+ * answer is cached or nodename is an address, otherwise from the tcpip
+ * thread, so it must not block.
+ *
+ * @param nodename descriptive name or address string of the host
+ *                 (may be NULL -> local address)
+ * @param servname port number as string or NULL
+ * @param hints structure containing input values that set socktype and protocol
+ * @param cb function called with 0 or an EAI_ error and the result
+ * @param arg argument passed to cb
+ * @return 0 if cb will be called, an EAI_ error (and no call) otherwise
+ */
+int lwip_getaddrinfo_async(const char *nodename, const char *servname, const struct addrinfo *hints, lwip_getaddrinfo_cb cb, void *arg)
+{
+	struct netdb_async *a;
+	struct addrinfo *res;
+	ip_addr_t addr;
+	size_t namelen;
+	int ai_family;
+	int port_nr;
+	int err;
+
+	if (cb == NULL) {
+		return EAI_FAIL;
+	}
+
+	err = netdb_check_args(nodename, servname, hints, &ai_family, &port_nr);
+	if (err != 0) {
+		return err;
+	}
+
+	err = netdb_numeric(nodename, hints, ai_family, &addr);
+	if (err == 0) {
+		res = netdb_addrinfo(&addr, port_nr, (hints != NULL) ? hints->ai_socktype : 0, (hints != NULL) ? hints->ai_protocol : 0, nodename);
+		cb((res != NULL) ? 0 : EAI_MEMORY, res, arg);
+		return 0;
+	}
+	if ((err != 1) || ((hints != NULL) && (hints->ai_flags & AI_NUMERICHOST))) {
+		return EAI_NONAME;
+	}
+
+	/* the caller's strings need not outlive this call */
+	namelen = strlen(nodename);
+	a = (struct netdb_async *)mem_malloc((mem_size_t)(sizeof(*a) + namelen));
+	if (a == NULL) {
+		return EAI_MEMORY;
+	}
+	MEMCPY(a->name, nodename, namelen + 1);
+	a->cb = cb;
+	a->arg = arg;
+	a->port = port_nr;
+	a->socktype = (hints != NULL) ? hints->ai_socktype : 0;
+	a->protocol = (hints != NULL) ? hints->ai_protocol : 0;
+
+	netdb_req_init(&a->req, a->name, ai_family);
+	a->req.done = netdb_async_done;
+	a->req.arg = a;
+	if (netdb_req_lookup(&a->req) == 0) {
+		netdb_async_done(&a->req);
+		return 0;
+	}
+	if (tcpip_callback(netdb_req_start, &a->req) != ERR_OK) {
+		mem_free(a);
+		return EAI_MEMORY;
+	}
 
 	return 0;
 }
+#endif							/* LWIP_DNS_ASYNC */
 
 /**
  * Translates the socket addresses and returns the string.
@@ -281,6 +281,17 @@ union sockaddr_aligned {
 #endif							/* LWIP_IPV4 */
 };
 
+#if LWIP_TCP_ZEROCOPY_RECV
+/* What lwip_recv_zerocopy() hands out: the pbufs and the socket they came from */
+struct lwip_zerocopy_handle {
+	struct pbuf *p;
+	u32_t sock_id;
+};
+
+/* Last zerocopy_id given to a socket */
+static u32_t zerocopy_last_id;
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
+
 #if LWIP_IGMP
 /* Define the number of IPv4 multicast memberships, default is one per socket */
 #ifndef LWIP_SOCKET_MAX_MEMBERSHIPS
@@ -501,6 +512,9 @@ static int alloc_socket(struct netconn *newconn, int accepted)
 			sock->sendevent = (NETCONNTYPE_GROUP(newconn->type) == NETCONN_TCP ? (accepted != 0) : 1);
 			sock->pid = getpid();
 			_get_pid_name(sock->pid, sock->pname);
+#if LWIP_TCP_ZEROCOPY_RECV
+			sock->zerocopy_id = ++zerocopy_last_id;
+#endif
 			list->sl_sockets[idx].sock = sock;
 			list->sl_sockets[idx].s_crefs = 1;
 			SYS_ARCH_UNPROTECT(lev);
@@ -970,6 +984,12 @@ int lwip_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from
 
 		/* If we don't peek the incoming message... */
 		if ((flags & MSG_PEEK) == 0) {
+#if LWIP_TCP_ZEROCOPY_RECV
+			/* the stack left the window to us, open it for what was copied */
+			if ((NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) && netconn_get_noautorecved(sock->conn)) {
+				netconn_recved(sock->conn, copylen);
+			}
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
 			/* If this is a TCP socket, check if there is data left in the
 			   buffer. If so, it should be saved in the sock structure for next
 			   time around. */
@@ -996,6 +1016,158 @@ int lwip_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from
 	return off;
 }
 
+#if LWIP_TCP_ZEROCOPY_RECV
+/**
+ * Receive data from a TCP socket without copying it.
+ *
+ * Up to iovcnt received pbufs are taken off the socket and their payloads
+ * are returned in iov. The data is read-only and stays valid until the
+ * handle is passed to lwip_recv_zerocopy_release(), which also opens the
+ * receive window for it. TCP_ZEROCOPY_RECV must be set on the socket.
+ *
+ * @param s the socket to receive from
+ * @param iov filled with one entry per pbuf
+ * @param iovcnt number of entries in iov
+ * @param handle set to the reference to release
+ * @param flags MSG_DONTWAIT or 0
+ * @return the number of bytes referenced by iov, 0 at end of stream or -1
+ *         with errno set
+ */
+int lwip_recv_zerocopy(int s, struct iovec *iov, int iovcnt, void **handle, int flags)
+{
+	struct lwip_sock *sock;
+	struct lwip_zerocopy_handle *h;
+	struct pbuf *p;
+	struct pbuf *q;
+	struct pbuf *rest;
+	int len;
+	int i;
+	err_t err;
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zerocopy(%d, %p, %d, 0x%x)\n", s, iov, iovcnt, flags));
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		return -1;
+	}
+	if (iov == NULL || iovcnt <= 0 || handle == NULL || (flags & ~MSG_DONTWAIT) != 0) {
+		sock_set_errno(sock, EINVAL);
+		return -1;
+	}
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_TCP || !netconn_get_noautorecved(sock->conn)) {
+		sock_set_errno(sock, EOPNOTSUPP);
+		return -1;
+	}
+	*handle = NULL;
+
+	h = (struct lwip_zerocopy_handle *)mem_malloc(sizeof(struct lwip_zerocopy_handle));
+	if (h == NULL) {
+		sock_set_errno(sock, ENOMEM);
+		return -1;
+	}
+
+	if (sock->lastdata == NULL) {
+		if (((flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) && (sock->rcvevent <= 0)) {
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zerocopy(%d): returning EWOULDBLOCK\n", s));
+			mem_free(h);
+			set_errno(EWOULDBLOCK);
+			return -1;
+		}
+		err = netconn_recv_tcp_pbuf(sock->conn, &p);
+		if (err != ERR_OK) {
+			mem_free(h);
+			sock_set_errno(sock, err_to_errno(err));
+			if (err == ERR_CLSD) {
+				/* Normal operation, peer ended */
+				sock->conn->last_err = ERR_OK;
+				return 0;
+			}
+			return -1;
+		}
+		sock->lastdata = p;
+		sock->lastoffset = 0;
+	}
+	p = (struct pbuf *)sock->lastdata;
+
+	/* Drop what recv() has already consumed. The receive path links pbufs
+	   with pbuf_cat(), so the chain owns one reference to each of them and
+	   may be cut by hand. */
+	while (sock->lastoffset >= p->len) {
+		sock->lastoffset -= p->len;
+		rest = p->next;
+		rest->tot_len = p->tot_len - p->len;
+		p->next = NULL;
+		p->tot_len = p->len;
+		pbuf_free(p);
+		p = rest;
+	}
+	if (sock->lastoffset > 0) {
+		pbuf_header(p, -(s16_t)sock->lastoffset);
+		sock->lastoffset = 0;
+	}
+
+	/* Hand out up to iovcnt pbufs and keep the rest for the next call */
+	len = 0;
+	q = p;
+	for (i = 0; i < iovcnt; i++) {
+		iov[i].iov_base = q->payload;
+		iov[i].iov_len = q->len;
+		len += q->len;
+		if (i == iovcnt - 1 || q->next == NULL) {
+			break;
+		}
+		q = q->next;
+	}
+	rest = q->next;
+	if (rest != NULL) {
+		q->next = NULL;
+		for (q = p; q != NULL; q = q->next) {
+			q->tot_len -= rest->tot_len;
+		}
+	}
+	sock->lastdata = rest;
+
+	h->p = p;
+	h->sock_id = sock->zerocopy_id;
+	*handle = h;
+	sock_set_errno(sock, 0);
+	return len;
+}
+
+/**
+ * Give back data returned by lwip_recv_zerocopy() and open the receive
+ * window for it. Release before closing the socket: a handle that outlives
+ * its socket is still freed, but nothing is acknowledged and -1 is returned
+ * with EBADF, even if s has been given to a new socket since.
+ *
+ * @param s the socket the data was received on
+ * @param handle the handle set by lwip_recv_zerocopy()
+ * @return 0 on success, -1 with errno set otherwise
+ */
+int lwip_recv_zerocopy_release(int s, void *handle)
+{
+	struct lwip_sock *sock;
+	struct lwip_zerocopy_handle *h = (struct lwip_zerocopy_handle *)handle;
+	int ret = 0;
+
+	if (h == NULL) {
+		set_errno(EINVAL);
+		return -1;
+	}
+	sock = get_socket_by_pid(s, getpid());
+	if (sock != NULL && sock->conn != NULL && sock->zerocopy_id == h->sock_id) {
+		netconn_recved(sock->conn, h->p->tot_len);
+		sock_set_errno(sock, 0);
+	} else {
+		LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recv_zerocopy_release(%d): socket closed\n", s));
+		set_errno(EBADF);
+		ret = -1;
+	}
+	pbuf_free(h->p);
+	mem_free(h);
+	return ret;
+}
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
+
 int lwip_read(int s, void *mem, size_t len)
 {
 	return lwip_recvfrom(s, mem, len, 0, NULL, NULL);
@@ -1038,6 +1210,207 @@ int lwip_send(int s, const void *data, size_t size, int flags)
 	return (err == ERR_OK ? (int)written : -1);
 }
 
+#if LWIP_SOCKET_MMSG
+/* Size to split the payload of msg into: a UDP_SEGMENT control message
+ * overrides the socket option. Only UDP sockets are split.
+ */
+static u16_t lwip_mmsg_gso_size(struct lwip_sock *sock, const struct msghdr *msg)
+{
+	struct cmsghdr *cmsg;
+	u16_t gso_size;
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_UDP) {
+		return 0;
+	}
+
+	gso_size = sock->gso_size;
+	if (msg->msg_control != NULL) {
+		for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+			if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_SEGMENT && cmsg->cmsg_len == CMSG_LEN(sizeof(u16_t))) {
+				gso_size = *(u16_t *)CMSG_DATA(cmsg);
+			}
+		}
+	}
+	return gso_size;
+}
+
+/* Copy the payload of msg into newly allocated netbufs at bufs, one per
+ * gso_size bytes (a single one if gso_size is 0 or larger than the payload).
+ * Returns the number of netbufs built and the payload size in *size, 0 if
+ * they do not fit in room, or -1 with *err set.
+ */
+static int lwip_mmsg_build(const struct msghdr *msg, u16_t gso_size, struct netbuf **bufs, int room, size_t *size, err_t *err)
+{
+	struct netbuf *buf;
+	ip_addr_t remote_addr;
+	u16_t remote_port = 0;
+	size_t total = 0;
+	size_t seglen;
+	size_t copied;
+	size_t chunk;
+	size_t iov_off = 0;
+	int iov_idx = 0;
+	int nseg;
+	int i;
+#if LWIP_CHECKSUM_ON_COPY
+	u32_t chksum;
+	u16_t part;
+#endif							/* LWIP_CHECKSUM_ON_COPY */
+
+	if (msg->msg_iov == NULL || msg->msg_iovlen <= 0 || ((msg->msg_name != NULL || msg->msg_namelen != 0) && !IS_SOCK_ADDR_LEN_VALID(msg->msg_namelen))) {
+		*err = ERR_ARG;
+		return -1;
+	}
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		total += msg->msg_iov[i].iov_len;
+	}
+
+	if (gso_size == 0 || total <= gso_size) {
+		nseg = 1;
+		seglen = total;
+	} else {
+		nseg = (total + gso_size - 1) / gso_size;
+		seglen = gso_size;
+	}
+	if (seglen > 0xFFFF || nseg > LWIP_SOCKET_MMSG_BATCH) {
+		*err = ERR_VAL;
+		return -1;
+	}
+	if (nseg > room) {
+		return 0;
+	}
+
+	ip_addr_set_zero(&remote_addr);
+	if (msg->msg_name != NULL) {
+		SOCKADDR_TO_IPADDR_PORT((const struct sockaddr *)msg->msg_name, &remote_addr, remote_port);
+#if LWIP_IPV4 && LWIP_IPV6
+		/* Dual-stack: Unmap IPv4 mapped IPv6 addresses */
+		if (IP_IS_V6_VAL(remote_addr) && ip6_addr_isipv4mappedipv6(ip_2_ip6(&remote_addr))) {
+			unmap_ipv4_mapped_ipv6(ip_2_ip4(&remote_addr), ip_2_ip6(&remote_addr));
+			IP_SET_TYPE_VAL(remote_addr, IPADDR_TYPE_V4);
+		}
+#endif							/* LWIP_IPV4 && LWIP_IPV6 */
+	}
+
+	*size = total;
+	for (i = 0; i < nseg; i++) {
+		u16_t len = (u16_t)LWIP_MIN(seglen, total);
+
+		buf = netbuf_new();
+		if (buf == NULL) {
+			goto errout;
+		}
+		if (netbuf_alloc(buf, len) == NULL) {
+			netbuf_delete(buf);
+			goto errout;
+		}
+		bufs[i] = buf;
+		ip_addr_copy(buf->addr, remote_addr);
+		buf->port = remote_port;
+
+		/* gather the next len bytes of the IO vectors */
+#if LWIP_CHECKSUM_ON_COPY
+		chksum = 0;
+#endif							/* LWIP_CHECKSUM_ON_COPY */
+		for (copied = 0; copied < len;) {
+			chunk = LWIP_MIN(msg->msg_iov[iov_idx].iov_len - iov_off, (size_t)(len - copied));
+#if LWIP_CHECKSUM_ON_COPY
+			part = LWIP_CHKSUM_COPY((u8_t *)buf->p->payload + copied, (u8_t *)msg->msg_iov[iov_idx].iov_base + iov_off, (u16_t)chunk);
+			chksum += (copied & 1) ? SWAP_BYTES_IN_WORD(part) : part;
+#else							/* LWIP_CHECKSUM_ON_COPY */
+			MEMCPY((u8_t *)buf->p->payload + copied, (u8_t *)msg->msg_iov[iov_idx].iov_base + iov_off, chunk);
+#endif							/* LWIP_CHECKSUM_ON_COPY */
+			copied += chunk;
+			iov_off += chunk;
+			if (iov_off == msg->msg_iov[iov_idx].iov_len) {
+				iov_idx++;
+				iov_off = 0;
+			}
+		}
+#if LWIP_CHECKSUM_ON_COPY
+		chksum = FOLD_U32T(chksum);
+		chksum = FOLD_U32T(chksum);
+		netbuf_set_chksum(buf, (u16_t)chksum);
+#endif							/* LWIP_CHECKSUM_ON_COPY */
+		total -= len;
+	}
+	return nseg;
+
+errout:
+	while (i-- > 0) {
+		netbuf_delete(bufs[i]);
+	}
+	*err = ERR_MEM;
+	return -1;
+}
+
+/* Receive one datagram into the IO vectors of msg. Returns the number of
+ * bytes copied or -1 with *err set.
+ */
+static int lwip_mmsg_recv(struct lwip_sock *sock, struct msghdr *msg, int flags, err_t *err)
+{
+	struct netbuf *buf;
+	u16_t buflen;
+	u16_t copylen;
+	u16_t off = 0;
+	int i;
+
+	if (sock->lastdata) {
+		/* left behind by an earlier MSG_PEEK */
+		buf = (struct netbuf *)sock->lastdata;
+	} else {
+		if (((flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) && (sock->rcvevent <= 0)) {
+			*err = ERR_WOULDBLOCK;
+			return -1;
+		}
+		*err = netconn_recv(sock->conn, &buf);
+		if (*err != ERR_OK) {
+			return -1;
+		}
+		sock->lastdata = buf;
+	}
+
+	buflen = buf->p->tot_len;
+	msg->msg_flags = 0;
+	for (i = 0; i < msg->msg_iovlen && off < buflen; i++) {
+		copylen = (u16_t)LWIP_MIN(msg->msg_iov[i].iov_len, (size_t)(buflen - off));
+		pbuf_copy_partial(buf->p, msg->msg_iov[i].iov_base, copylen, off);
+		off += copylen;
+	}
+	if (off < buflen) {
+		msg->msg_flags |= MSG_TRUNC;
+	}
+	msg->msg_controllen = 0;
+
+	if (msg->msg_name != NULL && msg->msg_namelen > 0) {
+		ip_addr_t *fromaddr = netbuf_fromaddr(buf);
+		union sockaddr_aligned saddr;
+
+#if LWIP_IPV4 && LWIP_IPV6
+		/* Dual-stack: Map IPv4 addresses to IPv4 mapped IPv6 */
+		if (NETCONNTYPE_ISIPV6(netconn_type(sock->conn)) && IP_IS_V4(fromaddr)) {
+			ip4_2_ipv4_mapped_ipv6(ip_2_ip6(fromaddr), ip_2_ip4(fromaddr));
+			IP_SET_TYPE(fromaddr, IPADDR_TYPE_V6);
+		}
+#endif							/* LWIP_IPV4 && LWIP_IPV6 */
+
+		IPADDR_PORT_TO_SOCKADDR(&saddr, fromaddr, netbuf_fromport(buf));
+		if (msg->msg_namelen > saddr.sa.sa_len) {
+			msg->msg_namelen = saddr.sa.sa_len;
+		}
+		MEMCPY(msg->msg_name, &saddr, msg->msg_namelen);
+	}
+
+	if ((flags & MSG_PEEK) == 0) {
+		sock->lastdata = NULL;
+		sock->lastoffset = 0;
+		netbuf_delete(buf);
+	}
+	return off;
+}
+#endif							/* LWIP_SOCKET_MMSG */
+
 int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 {
 	struct lwip_sock *sock;
@@ -1101,6 +1474,16 @@ int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 	{
 		struct netbuf *chain_buf;
 
+#if LWIP_SOCKET_MMSG
+		if (lwip_mmsg_gso_size(sock, msg) != 0) {
+			/* split into several datagrams, sent with one tcpip message */
+			struct mmsghdr mmsg;
+
+			mmsg.msg_hdr = *msg;
+			mmsg.msg_len = 0;
+			return (lwip_sendmmsg(s, &mmsg, 1, flags) == 1) ? (int)mmsg.msg_len : -1;
+		}
+#endif							/* LWIP_SOCKET_MMSG */
 		LWIP_UNUSED_ARG(flags);
 		LWIP_ERROR("lwip_sendmsg: invalid msghdr name", (((msg->msg_name == NULL) && (msg->msg_namelen == 0)) || IS_SOCK_ADDR_LEN_VALID(msg->msg_namelen)), sock_set_errno(sock, err_to_errno(ERR_ARG)); return -1;);
 
@@ -1125,16 +1508,23 @@ int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 		} else {
 			/* flatten the IO vectors */
 			size_t offset = 0;
+#if LWIP_CHECKSUM_ON_COPY
+			u32_t chksum = 0;
+#endif							/* LWIP_CHECKSUM_ON_COPY */
 			for (i = 0; i < msg->msg_iovlen; i++) {
+#if LWIP_CHECKSUM_ON_COPY
+				/* sum while copying; a vector at an odd offset sums byte-swapped */
+				u16_t part = LWIP_CHKSUM_COPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, (u16_t) msg->msg_iov[i].iov_len);
+				chksum += (offset & 1) ? SWAP_BYTES_IN_WORD(part) : part;
+#else							/* LWIP_CHECKSUM_ON_COPY */
 				MEMCPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+#endif							/* LWIP_CHECKSUM_ON_COPY */
 				offset += msg->msg_iov[i].iov_len;
 			}
 #if LWIP_CHECKSUM_ON_COPY
-			{
-				/* This can be improved by using LWIP_CHKSUM_COPY() and aggregating the checksum for each IO vector */
-				u16_t chksum = ~inet_chksum_pbuf(chain_buf->p);
-				netbuf_set_chksum(chain_buf, chksum);
-			}
+			chksum = FOLD_U32T(chksum);
+			chksum = FOLD_U32T(chksum);
+			netbuf_set_chksum(chain_buf, (u16_t) chksum);
 #endif							/* LWIP_CHECKSUM_ON_COPY */
 			err = ERR_OK;
 		}
@@ -1275,6 +1665,148 @@ int lwip_sendto(int s, const void *data, size_t size, int flags, const struct so
 	return (err == ERR_OK ? short_size : -1);
 }
 
+#if LWIP_SOCKET_MMSG
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	struct lwip_sock *sock;
+	struct netbuf *bufs[LWIP_SOCKET_MMSG_BATCH];
+	unsigned int owner[LWIP_SOCKET_MMSG_BATCH];
+	unsigned int done = 0;
+	unsigned int next = 0;
+	size_t size;
+	int nbufs;
+	int n;
+	int i;
+	u16_t sent;
+	err_t serr;
+	err_t err = ERR_OK;
+
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		return -1;
+	}
+
+	LWIP_ERROR("lwip_sendmmsg: invalid msgvec", (msgvec != NULL || vlen == 0), sock_set_errno(sock, err_to_errno(ERR_ARG)); return -1;);
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+		/* nothing to batch on a stream, write the messages one by one */
+		for (done = 0; done < vlen; done++) {
+			n = lwip_sendmsg(s, &msgvec[done].msg_hdr, flags);
+			if (n < 0) {
+				break;
+			}
+			msgvec[done].msg_len = n;
+		}
+		return (done > 0 || vlen == 0) ? (int)done : -1;
+	}
+
+	LWIP_UNUSED_ARG(flags);
+	while (next < vlen && err == ERR_OK) {
+		/* copy as many messages as fit into one batch */
+		nbufs = 0;
+		while (next < vlen) {
+			n = lwip_mmsg_build(&msgvec[next].msg_hdr, lwip_mmsg_gso_size(sock, &msgvec[next].msg_hdr), &bufs[nbufs], LWIP_SOCKET_MMSG_BATCH - nbufs, &size, &err);
+			if (n <= 0) {
+				break;
+			}
+			msgvec[next].msg_len = size;
+			for (i = 0; i < n; i++) {
+				owner[nbufs + i] = next;
+			}
+			nbufs += n;
+			next++;
+		}
+
+		/* hand the whole batch to the tcpip thread at once */
+		done = next;
+		if (nbufs > 0) {
+			serr = netconn_send_batch(sock->conn, bufs, (u16_t)nbufs, &sent);
+			if (serr != ERR_OK) {
+				done = owner[sent];
+				err = serr;
+			}
+			for (i = 0; i < nbufs; i++) {
+				netbuf_delete(bufs[i]);
+			}
+		}
+	}
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendmmsg(%d) err=%d sent=%u/%u\n", s, err, done, vlen));
+	if (done > 0 || err == ERR_OK) {
+		sock_set_errno(sock, 0);
+		return (int)done;
+	}
+	sock_set_errno(sock, err_to_errno(err));
+	return -1;
+}
+
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+	struct lwip_sock *sock;
+	struct msghdr *hdr;
+	unsigned int done;
+	u32_t start = 0;
+	u32_t limit = 0;
+	int rflags = flags & ~MSG_WAITFORONE;
+	int n;
+	err_t err = ERR_OK;
+
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		return -1;
+	}
+
+	LWIP_ERROR("lwip_recvmmsg: invalid msgvec", (msgvec != NULL || vlen == 0), sock_set_errno(sock, err_to_errno(ERR_ARG)); return -1;);
+
+	if (timeout != NULL) {
+		start = sys_now();
+		limit = (u32_t)timeout->tv_sec * 1000 + (u32_t)timeout->tv_nsec / 1000000;
+	}
+
+	for (done = 0; done < vlen; done++) {
+		hdr = &msgvec[done].msg_hdr;
+		if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+			/* streams have no message boundaries, fill the first IO vector */
+			n = lwip_recvfrom(s, hdr->msg_iov->iov_base, hdr->msg_iov->iov_len, rflags, (struct sockaddr *)hdr->msg_name, &hdr->msg_namelen);
+			if (n < 0) {
+				break;
+			}
+			hdr->msg_controllen = 0;
+			hdr->msg_flags = 0;
+			msgvec[done].msg_len = n;
+			if (n == 0) {
+				done++;
+				break;
+			}
+		} else {
+			n = lwip_mmsg_recv(sock, hdr, rflags, &err);
+			if (n < 0) {
+				if (done == 0) {
+					sock_set_errno(sock, err_to_errno(err));
+				}
+				break;
+			}
+			msgvec[done].msg_len = n;
+		}
+
+		if (flags & MSG_WAITFORONE) {
+			rflags |= MSG_DONTWAIT;
+		}
+		if (timeout != NULL && sys_now() - start >= limit) {
+			done++;
+			break;
+		}
+	}
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvmmsg(%d) received=%u/%u\n", s, done, vlen));
+	if (done > 0 || vlen == 0) {
+		sock_set_errno(sock, 0);
+		return (int)done;
+	}
+	return -1;
+}
+#endif							/* LWIP_SOCKET_MMSG */
+
 int lwip_socket(int domain, int type, int protocol)
 {
 	struct netconn *conn;
@@ -2352,6 +2884,12 @@ static u8_t lwip_getsockopt_impl(int s, int level, int optname, void *optval, so
 			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_getsockopt(%d, IPPROTO_TCP, TCP_KEEPCNT) = %d\n", s, *(int *)optval));
 			break;
 #endif							/* LWIP_TCP_KEEPALIVE */
+#if LWIP_TCP_ZEROCOPY_RECV
+		case TCP_ZEROCOPY_RECV:
+			*(int *)optval = netconn_get_noautorecved(sock->conn);
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_getsockopt(%d, IPPROTO_TCP, TCP_ZEROCOPY_RECV) = %s\n", s, (*(int *)optval) ? "on" : "off"));
+			break;
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
 		default:
 			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_getsockopt(%d, IPPROTO_TCP, UNIMPL: optname=0x%x, ..)\n", s, optname));
 			err = ENOPROTOOPT;
@@ -2377,6 +2915,23 @@ static u8_t lwip_getsockopt_impl(int s, int level, int optname, void *optval, so
 		break;
 #endif							/* LWIP_IPV6 */
 
+#if LWIP_UDP && LWIP_SOCKET_MMSG
+	/* Level: IPPROTO_UDP */
+	case IPPROTO_UDP:
+		switch (optname) {
+		case UDP_SEGMENT:
+			LWIP_SOCKOPT_CHECK_OPTLEN_CONN_PCB_TYPE(sock, *optlen, int, NETCONN_UDP);
+			*(int *)optval = sock->gso_size;
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_getsockopt(%d, IPPROTO_UDP, UDP_SEGMENT) = %d\n", s, (*(int *)optval)));
+			break;
+		default:
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_getsockopt(%d, IPPROTO_UDP, UNIMPL: optname=0x%x, ..)\n", s, optname));
+			err = ENOPROTOOPT;
+			break;
+		}						/* switch (optname) */
+		break;
+#endif							/* LWIP_UDP && LWIP_SOCKET_MMSG */
+
 #if LWIP_UDP && LWIP_UDPLITE
 	/* Level: IPPROTO_UDPLITE */
 	case IPPROTO_UDPLITE:
@@ -2722,6 +3277,24 @@ static u8_t lwip_setsockopt_impl(int s, int level, int optname, const void *optv
 			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_setsockopt(%d, IPPROTO_TCP, TCP_KEEPCNT) -> %" U32_F "\n", s, sock->conn->pcb.tcp->keep_cnt));
 			break;
 #endif							/* LWIP_TCP_KEEPALIVE */
+#if LWIP_TCP_ZEROCOPY_RECV
+		case TCP_ZEROCOPY_RECV:
+			if (*(const int *)optval) {
+				/* data left by an earlier recv() has already been acknowledged */
+				if (!netconn_get_noautorecved(sock->conn) && sock->lastdata != NULL) {
+					return EBUSY;
+				}
+				netconn_set_noautorecved(sock->conn, 1);
+			} else if (netconn_get_noautorecved(sock->conn)) {
+				/* acknowledge what is left before the stack does it again on receive */
+				if (sock->lastdata != NULL) {
+					tcp_recved(sock->conn->pcb.tcp, ((struct pbuf *)sock->lastdata)->tot_len - sock->lastoffset);
+				}
+				netconn_set_noautorecved(sock->conn, 0);
+			}
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_setsockopt(%d, IPPROTO_TCP, TCP_ZEROCOPY_RECV) -> %s\n", s, (*(const int *)optval) ? "on" : "off"));
+			break;
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
 		default:
 			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_setsockopt(%d, IPPROTO_TCP, UNIMPL: optname=0x%x, ..)\n", s, optname));
 			err = ENOPROTOOPT;
@@ -2751,6 +3324,26 @@ static u8_t lwip_setsockopt_impl(int s, int level, int optname, const void *optv
 		break;
 #endif							/* LWIP_IPV6 */
 
+#if LWIP_UDP && LWIP_SOCKET_MMSG
+	/* Level: IPPROTO_UDP */
+	case IPPROTO_UDP:
+		switch (optname) {
+		case UDP_SEGMENT:
+			LWIP_SOCKOPT_CHECK_OPTLEN_CONN_PCB_TYPE(sock, optlen, int, NETCONN_UDP);
+			if ((*(const int *)optval < 0) || (*(const int *)optval > 0xffff)) {
+				return EINVAL;
+			}
+			sock->gso_size = (u16_t) * (const int *)optval;
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_setsockopt(%d, IPPROTO_UDP, UDP_SEGMENT) -> %d\n", s, (*(const int *)optval)));
+			break;
+		default:
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_setsockopt(%d, IPPROTO_UDP, UNIMPL: optname=0x%x, ..)\n", s, optname));
+			err = ENOPROTOOPT;
+			break;
+		}						/* switch (optname) */
+		break;
+#endif							/* LWIP_UDP && LWIP_SOCKET_MMSG */
+
 #if LWIP_UDP && LWIP_UDPLITE
 	/* Level: IPPROTO_UDPLITE */
 	case IPPROTO_UDPLITE:
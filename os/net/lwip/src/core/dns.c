@@ -628,6 +628,27 @@ static err_t dns_lookup(const char *name, ip_addr_t *addr LWIP_DNS_ADDRTYPE_ARG(
 	return ERR_ARG;
 }
 
+/**
+ * Return the remaining time to live of an answer in the dns_table.
+ * Called from a dns_found_callback, this is the TTL of the answer just received.
+ *
+ * @param name the hostname that was looked up
+ * @param addr the address that was found for it
+ * @return the remaining TTL in seconds, 0 if the answer is not cached
+ */
+u32_t dns_lookup_ttl(const char *name, const ip_addr_t *addr)
+{
+	u8_t i;
+
+	for (i = 0; i < DNS_TABLE_SIZE; ++i) {
+		if ((dns_table[i].state == DNS_STATE_DONE) && (lwip_strnicmp(name, dns_table[i].name, sizeof(dns_table[i].name)) == 0) && ip_addr_cmp(addr, &dns_table[i].ipaddr)) {
+			return dns_table[i].ttl;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * Compare the "dotted" name "query" with the encoded name "response"
  * to make sure an answer from the DNS server matches the current dns_table
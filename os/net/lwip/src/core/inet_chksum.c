@@ -601,3 +601,60 @@ u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
 	return LWIP_CHKSUM(dst, len);
 }
 #endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 1) */
+
+#if (LWIP_CHKSUM_COPY_ALGORITHM == 2)	/* Version #2 */
+/** Copy and sum in a single pass over the data. Whole words are used when
+ * both buffers are word aligned, halfwords when they are halfword aligned,
+ * otherwise bytes paired by their offset from the start.
+ */
+u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	u8_t *pd = (u8_t *)dst;
+	const u8_t *ps = (const u8_t *)src;
+	u32_t sum = 0;
+	u32_t w;
+	u16_t t;
+
+	if ((((mem_ptr_t) pd | (mem_ptr_t) ps) & 3) == 0) {
+		/* at most 0x4000 words of two halves each: cannot overflow */
+		while (len > 3) {
+			w = *(const u32_t *)(const void *)ps;
+			*(u32_t *)(void *)pd = w;
+			sum += (w >> 16) + (w & 0x0000ffffUL);
+			ps += 4;
+			pd += 4;
+			len -= 4;
+		}
+	}
+
+	if ((((mem_ptr_t) pd | (mem_ptr_t) ps) & 1) == 0) {
+		while (len > 1) {
+			t = *(const u16_t *)(const void *)ps;
+			*(u16_t *)(void *)pd = t;
+			sum += t;
+			ps += 2;
+			pd += 2;
+			len -= 2;
+		}
+	}
+
+	while (len > 1) {
+		((u8_t *)&t)[0] = pd[0] = ps[0];
+		((u8_t *)&t)[1] = pd[1] = ps[1];
+		sum += t;
+		ps += 2;
+		pd += 2;
+		len -= 2;
+	}
+
+	if (len > 0) {
+		t = 0;
+		((u8_t *)&t)[0] = pd[0] = ps[0];
+		sum += t;
+	}
+
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+	return (u16_t) sum;
+}
+#endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
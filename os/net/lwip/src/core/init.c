@@ -169,6 +169,9 @@ PACK_STRUCT_END
 #error "If you want to use TCP, TCP_WND must fit in an u16_t, so, you have to reduce it in your lwipopts.h (or enable window scaling)"
 #endif
 #endif							/* LWIP_WND_SCALE */
+#if (LWIP_TCP && LWIP_TCP_SACK && ((LWIP_TCP_MAX_SACK_NUM < 1) || (LWIP_TCP_MAX_SACK_NUM > (LWIP_TCP_TIMESTAMPS ? 3 : 4))))
+#error "LWIP_TCP_MAX_SACK_NUM must be 1..4 (1..3 with LWIP_TCP_TIMESTAMPS) to fit in the TCP options"
+#endif
 #if (LWIP_TCP && (TCP_SND_QUEUELEN > 0xffff))
 #error "If you want to use TCP, TCP_SND_QUEUELEN must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
 #endif
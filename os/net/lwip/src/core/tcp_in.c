@@ -99,12 +99,22 @@ static u8_t flags;
 static u8_t recv_flags;
 static struct pbuf *recv_data;
 
+#if LWIP_TCP_SACK
+/* SACK blocks of the current segment as pairs of left and right edges */
+#define TCP_SACK_MAX_RX 4
+static u32_t tcphdr_sack[2 * TCP_SACK_MAX_RX];
+static u8_t tcphdr_sack_num;
+#endif							/* LWIP_TCP_SACK */
+
 struct tcp_pcb *tcp_input_pcb;
 
 /* Forward declarations. */
 static err_t tcp_process(struct tcp_pcb *pcb);
 static void tcp_receive(struct tcp_pcb *pcb);
 static void tcp_parseopt(struct tcp_pcb *pcb);
+#if LWIP_TCP_SACK
+static void tcp_sack_update(struct tcp_pcb *pcb);
+#endif
 
 static void tcp_listen_input(struct tcp_pcb_listen *pcb);
 static void tcp_timewait_input(struct tcp_pcb *pcb);
@@ -343,6 +353,7 @@ void tcp_input(struct pbuf *p, struct netif *inp)
 #if TCP_INPUT_DEBUG
 		tcp_debug_print_state(pcb->state);
 #endif							/* TCP_INPUT_DEBUG */
+		TCP_PCB_STATS_INC(pcb, segs_in);
 
 		/* Set up a tcp_seg structure. */
 		inseg.next = NULL;
@@ -998,6 +1009,13 @@ static void tcp_receive(struct tcp_pcb *pcb)
 	if (flags & TCP_ACK) {
 		right_wnd_edge = pcb->snd_wnd + pcb->snd_wl2;
 
+#if LWIP_TCP_SACK
+		/* Update the scoreboard before the dupack handling looks at it */
+		if (tcphdr_sack_num > 0) {
+			tcp_sack_update(pcb);
+		}
+#endif							/* LWIP_TCP_SACK */
+
 		/* Update window. */
 		if (TCP_SEQ_LT(pcb->snd_wl1, seqno) || (pcb->snd_wl1 == seqno && TCP_SEQ_LT(pcb->snd_wl2, ackno)) || (pcb->snd_wl2 == ackno && (u32_t) SND_WND_SCALE(pcb, tcphdr->wnd) > pcb->snd_wnd)) {
 			pcb->snd_wnd = SND_WND_SCALE(pcb, tcphdr->wnd);
@@ -1067,7 +1085,14 @@ static void tcp_receive(struct tcp_pcb *pcb)
 								if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
 									pcb->cwnd += pcb->mss;
 								}
-							} else if (pcb->dupacks == 3) {
+							}
+#if LWIP_TCP_SACK
+							if ((pcb->flags & TF_SACK) && (pcb->flags & TF_INFR)) {
+								/* Each further dupack may repair the next hole */
+								tcp_rexmit_sack(pcb);
+							} else
+#endif							/* LWIP_TCP_SACK */
+							if (pcb->dupacks == 3) {
 								/* Do fast retransmit */
 								tcp_rexmit_fast(pcb);
 							}
@@ -1087,8 +1112,17 @@ static void tcp_receive(struct tcp_pcb *pcb)
 			   in fast retransmit. Also reset the congestion window to the
 			   slow start threshold. */
 			if (pcb->flags & TF_INFR) {
-				pcb->flags &= ~TF_INFR;
-				pcb->cwnd = pcb->ssthresh;
+#if LWIP_TCP_SACK
+				if ((pcb->flags & TF_SACK) && TCP_SEQ_LT(ackno, pcb->recover)) {
+					/* Partial ACK: more data of the window was lost, stay in
+					   fast recovery and retransmit the next hole below. */
+					LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_receive: partial ACK %" U32_F " recover %" U32_F "\n", ackno, pcb->recover));
+				} else
+#endif							/* LWIP_TCP_SACK */
+				{
+					pcb->flags &= ~TF_INFR;
+					pcb->cwnd = pcb->ssthresh;
+				}
 			}
 
 			/* Reset the number of retransmissions. */
@@ -1102,8 +1136,8 @@ static void tcp_receive(struct tcp_pcb *pcb)
 			pcb->lastack = ackno;
 
 			/* Update the congestion control variables (cwnd and
-			   ssthresh). */
-			if (pcb->state >= ESTABLISHED) {
+			   ssthresh). The window stays inflated during fast recovery. */
+			if (pcb->state >= ESTABLISHED && !(pcb->flags & TF_INFR)) {
 				if (pcb->cwnd < pcb->ssthresh) {
 					if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
 						pcb->cwnd += pcb->mss;
@@ -1148,6 +1182,12 @@ static void tcp_receive(struct tcp_pcb *pcb)
 				pcb->rtime = 0;
 			}
 
+#if LWIP_TCP_SACK
+			if ((pcb->flags & TF_SACK) && (pcb->flags & TF_INFR)) {
+				tcp_rexmit_sack(pcb);
+			}
+#endif							/* LWIP_TCP_SACK */
+
 			pcb->polltmr = 0;
 
 #if LWIP_IPV6 && LWIP_ND6_TCP_REACHABILITY_HINTS
@@ -1450,6 +1490,9 @@ static void tcp_receive(struct tcp_pcb *pcb)
 					tcp_seg_free(cseg);
 				}
 #endif							/* TCP_QUEUE_OOSEQ */
+				if (recv_data != NULL) {
+					TCP_PCB_STATS_ADD(pcb, bytes_in, recv_data->tot_len);
+				}
 
 				/* Acknowledge the segment(s). */
 				tcp_ack(pcb);
@@ -1463,8 +1506,14 @@ static void tcp_receive(struct tcp_pcb *pcb)
 
 			} else {
 				/* We get here if the incoming segment is out-of-sequence. */
+#if !(LWIP_TCP_SACK && TCP_QUEUE_OOSEQ)
 				tcp_send_empty_ack(pcb);
+#endif
 #if TCP_QUEUE_OOSEQ
+#if LWIP_TCP_SACK
+				/* Report the block holding this segment first */
+				pcb->sack_recent = seqno;
+#endif							/* LWIP_TCP_SACK */
 				/* We queue the segment on the ->ooseq queue. */
 				if (pcb->ooseq == NULL) {
 					pcb->ooseq = tcp_seg_copy(&inseg);
@@ -1604,6 +1653,10 @@ static void tcp_receive(struct tcp_pcb *pcb)
 					}
 				}
 #endif							/* TCP_OOSEQ_MAX_BYTES || TCP_OOSEQ_MAX_PBUFS */
+#if LWIP_TCP_SACK
+				/* ACK once the segment is queued so the SACK blocks include it */
+				tcp_send_empty_ack(pcb);
+#endif							/* LWIP_TCP_SACK */
 #endif							/* TCP_QUEUE_OOSEQ */
 			}
 		} else {
@@ -1645,6 +1698,13 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 #if LWIP_TCP_TIMESTAMPS
 	u32_t tsval;
 #endif
+#if LWIP_TCP_SACK
+	u8_t i;
+#endif
+
+#if LWIP_TCP_SACK
+	tcphdr_sack_num = 0;
+#endif
 
 	/* Parse the TCP MSS option, if present. */
 	if (tcphdr_optlen != 0) {
@@ -1698,6 +1758,41 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 				}
 				break;
 #endif
+#if LWIP_TCP_SACK
+			case LWIP_TCP_OPT_SACK_PERM:
+				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK_PERM\n"));
+				if (tcp_getoptbyte() != LWIP_TCP_OPT_LEN_SACK_PERM || (tcp_optidx - 2 + LWIP_TCP_OPT_LEN_SACK_PERM) > tcphdr_optlen) {
+					/* Bad length */
+					LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+					return;
+				}
+				/* SACK is only negotiated in the SYN segments */
+				if (flags & TCP_SYN) {
+					pcb->flags |= TF_SACK;
+				}
+				break;
+			case LWIP_TCP_OPT_SACK:
+				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK\n"));
+				data = tcp_getoptbyte();
+				if (data < LWIP_TCP_OPT_LEN_SACK(1) || data > LWIP_TCP_OPT_LEN_SACK(TCP_SACK_MAX_RX) || ((data - 2) % 8) != 0 || (tcp_optidx - 2 + data) > tcphdr_optlen) {
+					/* Bad length */
+					LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+					return;
+				}
+				/* Blocks are only meaningful once SACK was agreed on */
+				if (!(pcb->flags & TF_SACK)) {
+					tcp_optidx += data - 2;
+					break;
+				}
+				tcphdr_sack_num = (u8_t)((data - 2) / 8);
+				for (i = 0; i < 2 * tcphdr_sack_num; i++) {
+					tcphdr_sack[i] = (u32_t)tcp_getoptbyte() << 24;
+					tcphdr_sack[i] |= (u32_t)tcp_getoptbyte() << 16;
+					tcphdr_sack[i] |= (u32_t)tcp_getoptbyte() << 8;
+					tcphdr_sack[i] |= tcp_getoptbyte();
+				}
+				break;
+#endif
 #if LWIP_TCP_TIMESTAMPS
 			case LWIP_TCP_OPT_TS:
 				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: TS\n"));
@@ -1740,6 +1835,35 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 	}
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Mark the unacked segments covered by the SACK blocks of the incoming
+ * segment, so that tcp_rexmit_sack() skips them.
+ *
+ * @param pcb the tcp_pcb for which a segment arrived
+ */
+static void tcp_sack_update(struct tcp_pcb *pcb)
+{
+	struct tcp_seg *seg;
+	u32_t left, right;
+	u8_t i;
+
+	for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+		if (seg->flags & TF_SEG_SACKED) {
+			continue;
+		}
+		left = lwip_ntohl(seg->tcphdr->seqno);
+		right = left + TCP_TCPLEN(seg);
+		for (i = 0; i < tcphdr_sack_num; i++) {
+			if (TCP_SEQ_GEQ(left, tcphdr_sack[2 * i]) && TCP_SEQ_LEQ(right, tcphdr_sack[2 * i + 1])) {
+				seg->flags |= TF_SEG_SACKED;
+				break;
+			}
+		}
+	}
+}
+#endif							/* LWIP_TCP_SACK */
+
 void tcp_trigger_input_pcb_close(void)
 {
 	recv_flags |= TF_CLOSED;
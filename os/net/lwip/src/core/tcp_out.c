@@ -781,6 +781,13 @@ err_t tcp_enqueue_flags(struct tcp_pcb *pcb, u8_t flags)
 			optflags |= TF_SEG_OPTS_WND_SCALE;
 		}
 #endif							/* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+		if ((pcb->state != SYN_RCVD) || (pcb->flags & TF_SACK)) {
+			/* Likewise, SACK is only permitted in a <SYN,ACK> if the remote host
+			   permitted it in its SYN. */
+			optflags |= TF_SEG_OPTS_SACK_PERM;
+		}
+#endif							/* LWIP_TCP_SACK */
 	}
 #if LWIP_TCP_TIMESTAMPS
 	if ((pcb->flags & TF_TIMESTAMP)) {
@@ -869,6 +876,66 @@ static void tcp_build_wnd_scale_option(u32_t *opts)
 }
 #endif
 
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+/** Get the next SACK block from the ooseq queue, merging adjacent segments
+ *
+ * @param seg the first segment of the block, advanced past the block
+ * @param left filled with the first seqno of the block
+ * @param right filled with the seqno following the block
+ */
+static void tcp_sack_next_block(struct tcp_seg **seg, u32_t *left, u32_t *right)
+{
+	*left = (*seg)->tcphdr->seqno;
+	*right = *left;
+	while (*seg != NULL && (*seg)->tcphdr->seqno == *right) {
+		*right += TCP_TCPLEN(*seg);
+		*seg = (*seg)->next;
+	}
+}
+
+/** Collect the SACK blocks to report for the ooseq queue.
+ *
+ * The block holding the most recently queued segment comes first as
+ * required by RFC 2018, the others follow in sequence order.
+ *
+ * @param pcb the tcp_pcb whose ooseq queue is reported
+ * @param blocks filled with pairs of left and right edges
+ * @return the number of blocks (at most LWIP_TCP_MAX_SACK_NUM)
+ */
+static u8_t tcp_sack_blocks(struct tcp_pcb *pcb, u32_t *blocks)
+{
+	struct tcp_seg *seg;
+	u32_t left, right;
+	u8_t num = 0;
+
+	if (!(pcb->flags & TF_SACK)) {
+		return 0;
+	}
+
+	for (seg = pcb->ooseq; seg != NULL;) {
+		tcp_sack_next_block(&seg, &left, &right);
+		if (TCP_SEQ_BETWEEN(pcb->sack_recent, left, right - 1)) {
+			blocks[0] = left;
+			blocks[1] = right;
+			num = 1;
+			break;
+		}
+	}
+
+	for (seg = pcb->ooseq; seg != NULL && num < LWIP_TCP_MAX_SACK_NUM;) {
+		tcp_sack_next_block(&seg, &left, &right);
+		if (num > 0 && left == blocks[0]) {
+			continue;
+		}
+		blocks[2 * num] = left;
+		blocks[2 * num + 1] = right;
+		num++;
+	}
+
+	return num;
+}
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
+
 /**
  * Send an ACK without data.
  *
@@ -880,15 +947,25 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 	struct pbuf *p;
 	u8_t optlen = 0;
 	struct netif *netif;
-#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP
+#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ)
 	struct tcp_hdr *tcphdr;
-#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP */
+#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ) */
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	u32_t sack_blocks[2 * LWIP_TCP_MAX_SACK_NUM];
+	u8_t sack_num;
+	u32_t *opts;
+	u8_t i;
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 #if LWIP_TCP_TIMESTAMPS
 	if (pcb->flags & TF_TIMESTAMP) {
 		optlen = LWIP_TCP_OPT_LENGTH(TF_SEG_OPTS_TS);
 	}
 #endif
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	sack_num = tcp_sack_blocks(pcb, sack_blocks);
+	optlen += LWIP_TCP_OPT_LEN_SACK_OUT(sack_num);
+#endif
 
 	p = tcp_output_alloc_header(pcb, optlen, 0, lwip_htonl(pcb->snd_nxt));
 	if (p == NULL) {
@@ -897,9 +974,9 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 		LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_output: (ACK) could not allocate pbuf\n"));
 		return ERR_BUF;
 	}
-#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP
+#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ)
 	tcphdr = (struct tcp_hdr *)p->payload;
-#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP */
+#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ) */
 	LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_output: sending ACK for %" U32_F "\n", pcb->rcv_nxt));
 
 	/* NB. MSS option is only sent on SYNs, so ignore it here */
@@ -910,6 +987,17 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 		tcp_build_timestamp_option(pcb, (u32_t *)(tcphdr + 1));
 	}
 #endif
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	if (sack_num > 0) {
+		/* The SACK option follows the timestamp option, if any */
+		opts = (u32_t *)(void *)((u8_t *)(tcphdr + 1) + optlen - LWIP_TCP_OPT_LEN_SACK_OUT(sack_num));
+		/* Pad with two NOP options to make everything nicely aligned */
+		opts[0] = lwip_htonl(0x01010000 | (LWIP_TCP_OPT_SACK << 8) | LWIP_TCP_OPT_LEN_SACK(sack_num));
+		for (i = 0; i < 2 * sack_num; i++) {
+			opts[1 + i] = lwip_htonl(sack_blocks[i]);
+		}
+	}
+#endif
 
 	netif = ip_route(&pcb->local_ip, &pcb->remote_ip);
 	if (netif == NULL) {
@@ -1173,6 +1261,13 @@ static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct
 		opts += 1;
 	}
 #endif
+#if LWIP_TCP_SACK
+	if (seg->flags & TF_SEG_OPTS_SACK_PERM) {
+		/* Pad with two NOP options to make everything nicely aligned */
+		*opts = PP_HTONL(0x01010402);
+		opts += 1;
+	}
+#endif
 
 	/* Set retransmission timer running if it is not currently enabled
 	   This must be set before checking the route. */
@@ -1192,7 +1287,12 @@ static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct
 	if (len == 0) {
 		/** Exclude retransmitted segments from this count. */
 		MIB2_STATS_INC(mib2.tcpoutsegs);
+	} else {
+		/* the IP header left from the last send is still in front */
+		TCP_PCB_STATS_INC(pcb, retransmits);
 	}
+	TCP_PCB_STATS_INC(pcb, segs_out);
+	TCP_PCB_STATS_ADD(pcb, bytes_out, seg->len);
 
 	seg->p->len -= len;
 	seg->p->tot_len -= len;
@@ -1319,6 +1419,13 @@ void tcp_rexmit_rto(struct tcp_pcb *pcb)
 	}
 
 	/* Move all unacked segments to the head of the unsent queue */
+#if LWIP_TCP_SACK
+	/* The receiver may drop data it has SACKed, so forget the scoreboard */
+	for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+		seg->flags &= ~(TF_SEG_SACKED | TF_SEG_SACK_REXMIT);
+	}
+	pcb->flags &= ~TF_INFR;
+#endif							/* LWIP_TCP_SACK */
 	for (seg = pcb->unacked; seg->next != NULL; seg = seg->next) ;
 	/* concatenate unsent queue after unacked queue */
 	seg->next = pcb->unsent;
@@ -1392,6 +1499,74 @@ void tcp_rexmit(struct tcp_pcb *pcb)
 	   and thus tcp_output directly returns. */
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Requeue the next hole of the SACK scoreboard for retransmission
+ *
+ * A hole is an unacked segment that was neither SACKed nor retransmitted
+ * yet and is either the first unacked segment or lies below data that the
+ * receiver has SACKed. Called by tcp_receive() during fast recovery.
+ *
+ * @param pcb the tcp_pcb for which to retransmit the next hole
+ * @return ERR_OK if a segment was requeued, ERR_VAL if there is no hole
+ */
+err_t tcp_rexmit_sack(struct tcp_pcb *pcb)
+{
+	struct tcp_seg *seg;
+	struct tcp_seg **cur_seg;
+	struct tcp_seg **hole = NULL;
+
+	for (cur_seg = &(pcb->unacked); *cur_seg != NULL; cur_seg = &((*cur_seg)->next)) {
+		seg = *cur_seg;
+		if (seg->flags & TF_SEG_SACKED) {
+			if (hole != NULL) {
+				break;
+			}
+		} else if (hole == NULL && !(seg->flags & TF_SEG_SACK_REXMIT)) {
+			hole = cur_seg;
+			if (seg == pcb->unacked) {
+				break;
+			}
+		}
+	}
+	if (hole == NULL || *cur_seg == NULL) {
+		return ERR_VAL;
+	}
+
+	/* Move the hole to the unsent queue, keeping it sorted */
+	seg = *hole;
+	*hole = seg->next;
+	seg->flags |= TF_SEG_SACK_REXMIT;
+
+	cur_seg = &(pcb->unsent);
+	while (*cur_seg && TCP_SEQ_LT(lwip_ntohl((*cur_seg)->tcphdr->seqno), lwip_ntohl(seg->tcphdr->seqno))) {
+		cur_seg = &((*cur_seg)->next);
+	}
+	seg->next = *cur_seg;
+	*cur_seg = seg;
+#if TCP_OVERSIZE
+	if (seg->next == NULL) {
+		/* the retransmitted segment is last in unsent, so reset unsent_oversize */
+		pcb->unsent_oversize = 0;
+	}
+#endif							/* TCP_OVERSIZE */
+
+	LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_rexmit_sack: hole %" U32_F "\n", lwip_ntohl(seg->tcphdr->seqno)));
+
+	if (pcb->nrtx < 0xFF) {
+		++pcb->nrtx;
+	}
+
+	/* Don't take any rtt measurements after retransmitting. */
+	pcb->rttest = 0;
+
+	MIB2_STATS_INC(mib2.tcpretranssegs);
+	/* No need to call tcp_output: we are always called from tcp_input()
+	   and thus tcp_output directly returns. */
+	return ERR_OK;
+}
+#endif							/* LWIP_TCP_SACK */
+
 /**
  * Handle retransmission after three dupacks received
  *
@@ -1402,7 +1577,14 @@ void tcp_rexmit_fast(struct tcp_pcb *pcb)
 	if (pcb->unacked != NULL && !(pcb->flags & TF_INFR)) {
 		/* This is fast retransmit. Retransmit the first unacked segment. */
 		LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_receive: dupacks %" U16_F " (%" U32_F "), fast retransmit %" U32_F "\n", (u16_t) pcb->dupacks, pcb->lastack, lwip_ntohl(pcb->unacked->tcphdr->seqno)));
-		tcp_rexmit(pcb);
+#if LWIP_TCP_SACK
+		/* Recovery lasts until everything sent so far is acknowledged */
+		pcb->recover = pcb->snd_nxt;
+		if (!(pcb->flags & TF_SACK) || tcp_rexmit_sack(pcb) != ERR_OK)
+#endif							/* LWIP_TCP_SACK */
+		{
+			tcp_rexmit(pcb);
+		}
 
 		/* Set ssthresh to half of the minimum of the current
 		 * cwnd and the advertised window */
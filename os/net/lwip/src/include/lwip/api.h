@@ -348,8 +348,14 @@ err_t netconn_listen_with_backlog(struct netconn *conn, u8_t backlog);
 err_t netconn_accept(struct netconn *conn, struct netconn **new_conn);
 err_t netconn_recv(struct netconn *conn, struct netbuf **new_buf);
 err_t netconn_recv_tcp_pbuf(struct netconn *conn, struct pbuf **new_buf);
+#if LWIP_TCP_ZEROCOPY_RECV
+err_t netconn_recved(struct netconn *conn, u32_t length);
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
 err_t netconn_sendto(struct netconn *conn, struct netbuf *buf, const ip_addr_t *addr, u16_t port);
 err_t netconn_send(struct netconn *conn, struct netbuf *buf);
+#if LWIP_SOCKET_MMSG
+err_t netconn_send_batch(struct netconn *conn, struct netbuf **bufs, u16_t num, u16_t *sent);
+#endif							/* LWIP_SOCKET_MMSG */
 err_t netconn_write_partly(struct netconn *conn, const void *dataptr, size_t size, u8_t apiflags, size_t *bytes_written);
 #define netconn_write(conn, dataptr, size, apiflags) \
 		netconn_write_partly(conn, dataptr, size, apiflags, NULL)
@@ -381,6 +387,16 @@ err_t netconn_gethostbyname(const char *name, ip_addr_t *addr);
 /* Get the blocking status of netconn calls (@todo: write/send is missing) */
 #define netconn_is_nonblocking(conn)        (((conn)->flags & NETCONN_FLAG_NON_BLOCKING) != 0)
 
+#if LWIP_TCP_ZEROCOPY_RECV
+/* Set whether received data is acknowledged by netconn_recved() instead of on receive */
+#define netconn_set_noautorecved(conn, val)  do { if (val) { \
+	(conn)->flags |= NETCONN_FLAG_NO_AUTO_RECVED; \
+} else { \
+	(conn)->flags &= ~NETCONN_FLAG_NO_AUTO_RECVED; } \
+} while (0)
+#define netconn_get_noautorecved(conn)        (((conn)->flags & NETCONN_FLAG_NO_AUTO_RECVED) != 0)
+#endif							/* LWIP_TCP_ZEROCOPY_RECV */
+
 #if LWIP_IPV6
 #define netconn_set_ipv6only(conn, val)  do { if (val) { \
 	(conn)->flags |= NETCONN_FLAG_IPV6_V6ONLY; \
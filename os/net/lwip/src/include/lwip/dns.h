@@ -124,6 +124,7 @@ void dns_setserver(u8_t numdns, const ip_addr_t * dnsserver);
 const ip_addr_t *dns_getserver(u8_t numdns);
 err_t dns_gethostbyname(const char *hostname, ip_addr_t * addr, dns_found_callback found, void *callback_arg);
 err_t dns_gethostbyname_addrtype(const char *hostname, ip_addr_t * addr, dns_found_callback found, void *callback_arg, u8_t dns_addrtype);
+u32_t dns_lookup_ttl(const char *name, const ip_addr_t * addr);
 
 #if DNS_LOCAL_HOSTLIST
 size_t dns_local_iterate(dns_found_callback iterator_fn, void *iterator_arg);
@@ -59,6 +59,10 @@
 #include "lwip/pbuf.h"
 #include "lwip/ip_addr.h"
 
+#ifdef CONFIG_NET_ARCH_CHKSUM
+#include <tinyara/arch.h>		/* up_chksum(), up_chksum_copy() */
+#endif
+
 /** Swap the bytes in an u16_t: much like htons() for little-endian */
 #ifndef SWAP_BYTES_IN_WORD
 #if LWIP_PLATFORM_BYTESWAP && (BYTE_ORDER == LITTLE_ENDIAN)
@@ -81,7 +85,7 @@
 #ifndef LWIP_CHKSUM_COPY
 #define LWIP_CHKSUM_COPY(dst, src, len) lwip_chksum_copy(dst, src, len)
 #ifndef LWIP_CHKSUM_COPY_ALGORITHM
-#define LWIP_CHKSUM_COPY_ALGORITHM 1
+#define LWIP_CHKSUM_COPY_ALGORITHM 2
 #endif							/* LWIP_CHKSUM_COPY_ALGORITHM */
 #else							/* LWIP_CHKSUM_COPY */
 #define LWIP_CHKSUM_COPY_ALGORITHM 0
@@ -99,6 +103,9 @@ u16_t inet_chksum_pbuf(struct pbuf *p);
 #if LWIP_CHKSUM_COPY_ALGORITHM
 u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len);
 #endif							/* LWIP_CHKSUM_COPY_ALGORITHM */
+#ifdef CONFIG_NET_ARCH_CHKSUM
+u16_t lwip_standard_chksum(const void *dataptr, int len);
+#endif							/* CONFIG_NET_ARCH_CHKSUM */
 
 u16_t inet_chksum_pseudo(struct pbuf *p, u8_t proto, u16_t proto_len, const ip4_addr_t * src, const ip4_addr_t * dest);
 u16_t inet_chksum_pseudo_partial(struct pbuf *p, u8_t proto, u16_t proto_len, u16_t chksum_len, const ip4_addr_t * src, const ip4_addr_t * dest);
@@ -442,6 +442,10 @@
 #define TCP_WND_UPDATE_THRESHOLD	CONFIG_NET_TCP_WND_UPDATE_THRESHOLD
 #endif
 
+#ifdef CONFIG_NET_TCP_ZEROCOPY_RECV
+#define LWIP_TCP_ZEROCOPY_RECV	1
+#endif
+
 #ifdef CONFIG_NET_WND_SCALE
 #define LWIP_WND_SCALE 1
 #endif
@@ -450,6 +454,18 @@
 #define TCP_RCV_SCALE CONFIG_NET_TCP_RCV_SCALE
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+#define LWIP_TCP_SACK 1
+#endif
+
+#ifdef CONFIG_NET_TCP_MAX_SACK_NUM
+#define LWIP_TCP_MAX_SACK_NUM CONFIG_NET_TCP_MAX_SACK_NUM
+#endif
+
+#ifdef CONFIG_NET_TCP_PCB_STATS
+#define LWIP_TCP_PCB_STATS 1
+#endif
+
 /* ---------- TCP options ---------- */
 
 /* ---------- UDP options ---------- */
@@ -471,6 +487,14 @@
 #define LWIP_NETBUF_RECVINFO	CONFIG_NET_NETBUF_RECVINFO
 #endif
 
+#ifdef CONFIG_NET_UDP_MMSG
+#define LWIP_SOCKET_MMSG	1
+#endif
+
+#ifdef CONFIG_NET_UDP_MMSG_BATCH
+#define LWIP_SOCKET_MMSG_BATCH	CONFIG_NET_UDP_MMSG_BATCH
+#endif
+
 /* ---------- UDP options ---------- */
 
 /* ---------- SNMP options ---------- */
@@ -1204,6 +1228,18 @@
 #endif
 #endif /* CONFIG_NET_DNS_LOCAL_HOSTLIST */
 
+#ifdef CONFIG_NET_DNS_CACHE_SIZE
+#define LWIP_DNS_CACHE_SIZE CONFIG_NET_DNS_CACHE_SIZE
+#endif
+
+#ifdef CONFIG_NET_DNS_NEGATIVE_TTL
+#define LWIP_DNS_NEGATIVE_TTL CONFIG_NET_DNS_NEGATIVE_TTL
+#endif
+
+#ifdef CONFIG_NET_DNS_ASYNC
+#define LWIP_DNS_ASYNC 1
+#endif
+
 #endif /* LWIP_DNS */
 /* ---------- End of DNS options ---------*/
 
@@ -1217,6 +1253,17 @@
 #define LWIP_NETIF_TX_SINGLE_PBUF             1
 #endif
 
+#if defined(CONFIG_NET_CHECKSUM_ON_COPY)
+#define LWIP_CHECKSUM_ON_COPY                 1
+#endif
+
+#if defined(CONFIG_NET_ARCH_CHKSUM)
+#define LWIP_CHKSUM                           up_chksum
+#define LWIP_CHKSUM_COPY(dst, src, len)       up_chksum_copy(dst, src, len)
+/* lwip_standard_chksum() stays as the reference for up_chksum() */
+#define LWIP_CHKSUM_ALGORITHM                 2
+#endif
+
 /*  ---------------Mandatory ---------------- */
 #define LWIP_DHCP_TCPIP_THREAD 1
 #endif							/* __LWIP_LWIPOPTS_H__ */
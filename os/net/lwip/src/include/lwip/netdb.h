@@ -142,6 +142,18 @@ void lwip_freeaddrinfo(struct addrinfo *ai);
 int lwip_getaddrinfo(const char *nodename, const char *servname, const struct addrinfo *hints, struct addrinfo **res);
 int lwip_getnameinfo(const struct sockaddr *sa, size_t salen, char *host, size_t hostlen, char *serv, size_t servlen, int flags);
 
+#if LWIP_DNS_CACHE_SIZE
+void lwip_dns_cache_flush(void);
+#endif							/* LWIP_DNS_CACHE_SIZE */
+
+#if LWIP_DNS_ASYNC
+/** Completion callback of lwip_getaddrinfo_async(): err is 0 or an EAI_ error,
+ * res the result to be freed with lwip_freeaddrinfo() */
+typedef void (*lwip_getaddrinfo_cb)(int err, struct addrinfo *res, void *arg);
+
+int lwip_getaddrinfo_async(const char *nodename, const char *servname, const struct addrinfo *hints, lwip_getaddrinfo_cb cb, void *arg);
+#endif							/* LWIP_DNS_ASYNC */
+
 #if LWIP_COMPAT_SOCKETS
 #define NI_NOFQDN       (1 << 0)
 #define NI_NUMERICHOST  (1 << 1)
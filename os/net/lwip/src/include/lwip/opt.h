@@ -1058,6 +1058,26 @@
 #ifndef LWIP_DNS_SUPPORT_MDNS_QUERIES
 #define LWIP_DNS_SUPPORT_MDNS_QUERIES  0
 #endif
+
+/** LWIP_DNS_CACHE_SIZE: number of answers (one per host name and address
+ * type) the netdb API keeps so that repeated lookups are answered in the
+ * caller's context without a round trip through the tcpip thread.
+ * 0 disables the cache. */
+#ifndef LWIP_DNS_CACHE_SIZE
+#define LWIP_DNS_CACHE_SIZE             0
+#endif
+
+/** LWIP_DNS_NEGATIVE_TTL: seconds a failed lookup stays in the netdb cache.
+ * 0 disables negative caching. */
+#ifndef LWIP_DNS_NEGATIVE_TTL
+#define LWIP_DNS_NEGATIVE_TTL           10
+#endif
+
+/** LWIP_DNS_ASYNC==1: provide lwip_getaddrinfo_async(), which reports the
+ * result through a callback instead of blocking the caller. */
+#ifndef LWIP_DNS_ASYNC
+#define LWIP_DNS_ASYNC                  0
+#endif
 /**
  * @}
  */
@@ -1277,6 +1297,33 @@
 #define LWIP_TCP_TIMESTAMPS             0
 #endif
 
+/**
+ * LWIP_TCP_SACK==1: support selective acknowledgements (RFC 2018).
+ * SACK is used when both ends send the SACK-permitted option in the SYN.
+ * The receiver then reports the blocks queued on ooseq in every empty ACK
+ * and the sender retransmits only the holes below the highest SACKed data
+ * during fast recovery. Needs TCP_QUEUE_OOSEQ to report anything useful.
+ */
+#ifndef LWIP_TCP_SACK
+#define LWIP_TCP_SACK                   0
+#endif
+
+/**
+ * LWIP_TCP_MAX_SACK_NUM: the maximum number of SACK blocks sent in one ACK.
+ * 4 blocks fill the 40 bytes of TCP options, only 3 fit next to timestamps.
+ */
+#ifndef LWIP_TCP_MAX_SACK_NUM
+#define LWIP_TCP_MAX_SACK_NUM           (LWIP_TCP_TIMESTAMPS ? 3 : 4)
+#endif
+
+/**
+ * LWIP_TCP_PCB_STATS==1: keep segment, byte and retransmission counters in
+ * every tcp_pcb. They are only written by the tcpip thread.
+ */
+#ifndef LWIP_TCP_PCB_STATS
+#define LWIP_TCP_PCB_STATS              0
+#endif
+
 /**
  * TCP_WND_UPDATE_THRESHOLD: difference in window to trigger an
  * explicit window update
@@ -1845,6 +1892,34 @@
 #ifndef LWIP_FIONREAD_LINUXMODE
 #define LWIP_FIONREAD_LINUXMODE         0
 #endif
+
+/**
+ * LWIP_SOCKET_MMSG==1: Enable lwip_recvmmsg()/lwip_sendmmsg() and the
+ * UDP_SEGMENT option, which splits one large UDP send into several
+ * datagrams inside the stack.
+ */
+#ifndef LWIP_SOCKET_MMSG
+#define LWIP_SOCKET_MMSG                0
+#endif
+
+/**
+ * LWIP_SOCKET_MMSG_BATCH: Maximum number of datagrams handed to the tcpip
+ * thread in one message by lwip_sendmmsg(). This also limits the number of
+ * segments a single UDP_SEGMENT send may be split into.
+ */
+#ifndef LWIP_SOCKET_MMSG_BATCH
+#define LWIP_SOCKET_MMSG_BATCH          8
+#endif
+
+/**
+ * LWIP_TCP_ZEROCOPY_RECV==1: Enable the TCP_ZEROCOPY_RECV socket option and
+ * lwip_recv_zerocopy()/lwip_recv_zerocopy_release(), which hand received
+ * pbufs to the application instead of copying them. The receive window is
+ * opened when the application releases the data.
+ */
+#ifndef LWIP_TCP_ZEROCOPY_RECV
+#define LWIP_TCP_ZEROCOPY_RECV          0
+#endif
 /**
  * @}
  */
@@ -99,6 +99,9 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb);
 void tcp_rexmit(struct tcp_pcb *pcb);
 void tcp_rexmit_rto(struct tcp_pcb *pcb);
 void tcp_rexmit_fast(struct tcp_pcb *pcb);
+#if LWIP_TCP_SACK
+err_t tcp_rexmit_sack(struct tcp_pcb *pcb);
+#endif
 u32_t tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb);
 err_t tcp_process_refused_data(struct tcp_pcb *pcb);
 
@@ -279,6 +282,9 @@ struct tcp_seg {
 #define TF_SEG_DATA_CHECKSUMMED (u8_t)0x04U	/* ALL data (not the header) is
 											   checksummed into 'chksum' */
 #define TF_SEG_OPTS_WND_SCALE   (u8_t)0x08U	/* Include WND SCALE option */
+#define TF_SEG_OPTS_SACK_PERM   (u8_t)0x10U	/* Include SACK Permitted option */
+#define TF_SEG_SACKED           (u8_t)0x20U	/* Unacked segment reported by a SACK block */
+#define TF_SEG_SACK_REXMIT      (u8_t)0x40U	/* Hole retransmitted during SACK recovery */
 	struct tcp_hdr *tcphdr;	/* the TCP header */
 };
 
@@ -286,6 +292,8 @@ struct tcp_seg {
 #define LWIP_TCP_OPT_NOP        1
 #define LWIP_TCP_OPT_MSS        2
 #define LWIP_TCP_OPT_WS         3
+#define LWIP_TCP_OPT_SACK_PERM  4
+#define LWIP_TCP_OPT_SACK       5
 #define LWIP_TCP_OPT_TS         8
 
 #define LWIP_TCP_OPT_LEN_MSS    4
@@ -302,10 +310,28 @@ struct tcp_seg {
 #define LWIP_TCP_OPT_LEN_WS_OUT 0
 #endif
 
+#if LWIP_TCP_SACK
+#define LWIP_TCP_OPT_LEN_SACK_PERM      2
+#define LWIP_TCP_OPT_LEN_SACK_PERM_OUT  4	/* aligned for output (includes NOP padding) */
+#define LWIP_TCP_OPT_LEN_SACK(n)        (2 + 8 * (n))
+#define LWIP_TCP_OPT_LEN_SACK_OUT(n)    ((n) ? 2 + LWIP_TCP_OPT_LEN_SACK(n) : 0)	/* includes NOP padding */
+#else
+#define LWIP_TCP_OPT_LEN_SACK_PERM_OUT  0
+#endif
+
 #define LWIP_TCP_OPT_LENGTH(flags) \
 		(flags & TF_SEG_OPTS_MSS       ? LWIP_TCP_OPT_LEN_MSS    : 0) + \
 		(flags & TF_SEG_OPTS_TS        ? LWIP_TCP_OPT_LEN_TS_OUT : 0) + \
-		(flags & TF_SEG_OPTS_WND_SCALE ? LWIP_TCP_OPT_LEN_WS_OUT : 0)
+		(flags & TF_SEG_OPTS_WND_SCALE ? LWIP_TCP_OPT_LEN_WS_OUT : 0) + \
+		(flags & TF_SEG_OPTS_SACK_PERM ? LWIP_TCP_OPT_LEN_SACK_PERM_OUT : 0)
+
+#if LWIP_TCP_PCB_STATS
+#define TCP_PCB_STATS_INC(pcb, x)     ((pcb)->stats.x++)
+#define TCP_PCB_STATS_ADD(pcb, x, n)  ((pcb)->stats.x += (n))
+#else
+#define TCP_PCB_STATS_INC(pcb, x)
+#define TCP_PCB_STATS_ADD(pcb, x, n)
+#endif							/* LWIP_TCP_PCB_STATS */
 
 /** This returns a TCP header option for MSS in an u32_t */
 #define TCP_BUILD_MSS_OPTION(mss) lwip_htonl(0x02040000 | ((mss) & 0xFFFF))
@@ -289,6 +289,7 @@ struct linger {
 #define MSG_OOB        0x04		/* Unimplemented: Requests out-of-band data. The significance and semantics of out-of-band data are protocol-specific */
 #define MSG_DONTWAIT   0x08		/* Nonblocking i/o for this operation only */
 #define MSG_MORE       0x10		/* Sender will send more */
+#define MSG_WAITFORONE 0x20		/* recvmmsg: only wait for the first message */
 
 /*
  * Options for level IPPROTO_IP
@@ -305,6 +306,9 @@ struct linger {
 #define TCP_KEEPIDLE   0x03		/* set pcb->keep_idle  - Same as TCP_KEEPALIVE, but use seconds for get/setsockopt */
 #define TCP_KEEPINTVL  0x04		/* set pcb->keep_intvl - Use seconds for get/setsockopt */
 #define TCP_KEEPCNT    0x05		/* set pcb->keep_cnt   - Use number of probes sent for get/setsockopt */
+#if LWIP_TCP_ZEROCOPY_RECV
+#define TCP_ZEROCOPY_RECV 0x06	/* leave the receive window closed until recv_zerocopy_release() */
+#endif
 #endif							/* LWIP_TCP */
 
 #if LWIP_IPV6
@@ -315,6 +319,14 @@ struct linger {
 #define IPV6_V6ONLY         27	/* RFC3493: boolean control to restrict AF_INET6 sockets to IPv6 communications only. */
 #endif							/* LWIP_IPV6 */
 
+#if LWIP_UDP && LWIP_SOCKET_MMSG
+/*
+ * Options and control messages for level IPPROTO_UDP
+ */
+#define SOL_UDP            IPPROTO_UDP
+#define UDP_SEGMENT        103	/* split sends into datagrams of this size */
+#endif							/* LWIP_UDP && LWIP_SOCKET_MMSG */
+
 #if LWIP_UDP && LWIP_UDPLITE
 /*
  * Options for level IPPROTO_UDPLITE
@@ -497,6 +509,14 @@ struct lwip_sock {
 	SELWAIT_T select_waiting;
 	u32_t pid;
 	u8_t pname[CONFIG_TASK_NAME_SIZE];
+#if LWIP_SOCKET_MMSG
+	/** UDP_SEGMENT size, 0 if sends are not split */
+	u16_t gso_size;
+#endif
+#if LWIP_TCP_ZEROCOPY_RECV
+	/** unique among the sockets ever opened, ties zero-copy handles to the socket */
+	u32_t zerocopy_id;
+#endif
 };
 
 #define lwip_socket_init()		/* Compatibility define, no init needed. */
@@ -520,6 +540,16 @@ int lwip_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from
 int lwip_send(int s, const void *dataptr, size_t size, int flags);
 int lwip_sendmsg(int s, const struct msghdr *message, int flags);
 int lwip_sendto(int s, const void *dataptr, size_t size, int flags, const struct sockaddr *to, socklen_t tolen);
+#if LWIP_SOCKET_MMSG
+struct mmsghdr;
+struct timespec;
+int lwip_recvmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+int lwip_sendmmsg(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+#endif
+#if LWIP_TCP_ZEROCOPY_RECV
+int lwip_recv_zerocopy(int s, struct iovec *iov, int iovcnt, void **handle, int flags);
+int lwip_recv_zerocopy_release(int s, void *handle);
+#endif
 int lwip_socket(int domain, int type, int protocol);
 int lwip_write(int s, const void *dataptr, size_t size);
 int lwip_writev(int s, const struct iovec *iov, int iovcnt);
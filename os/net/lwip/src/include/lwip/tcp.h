@@ -154,7 +154,7 @@ typedef u32_t tcpwnd_size_t;
 typedef u16_t tcpwnd_size_t;
 #endif
 
-#if LWIP_WND_SCALE || TCP_LISTEN_BACKLOG || LWIP_TCP_TIMESTAMPS
+#if LWIP_WND_SCALE || TCP_LISTEN_BACKLOG || LWIP_TCP_TIMESTAMPS || LWIP_TCP_SACK
 typedef u16_t tcpflags_t;
 #else
 typedef u8_t tcpflags_t;
@@ -203,6 +203,17 @@ struct tcp_pcb_listen {
 #endif							/* TCP_LISTEN_BACKLOG */
 };
 
+#if LWIP_TCP_PCB_STATS
+/** per-connection counters, see TCP_PCB_STATS_INC() */
+struct tcp_pcb_stats {
+	u32_t segs_in;			/* segments received */
+	u32_t segs_out;			/* segments sent from the send queue, retransmissions included */
+	u32_t bytes_in;			/* payload bytes passed up in order */
+	u32_t bytes_out;		/* payload bytes sent, retransmissions included */
+	u32_t retransmits;		/* segments sent again */
+};
+#endif							/* LWIP_TCP_PCB_STATS */
+
 /** the TCP protocol control block */
 struct tcp_pcb {
 	/** common PCB members */
@@ -230,6 +241,9 @@ struct tcp_pcb {
 #endif
 #if LWIP_TCP_TIMESTAMPS
 #define TF_TIMESTAMP   0x0400U	/* Timestamp option enabled */
+#endif
+#if LWIP_TCP_SACK
+#define TF_SACK        0x0800U	/* SACK option enabled */
 #endif
 
 	/* the rest of the fields are in host byte order
@@ -315,6 +329,11 @@ struct tcp_pcb {
 	u32_t ts_recent;
 #endif							/* LWIP_TCP_TIMESTAMPS */
 
+#if LWIP_TCP_SACK
+	u32_t sack_recent;		/* seqno of the latest segment queued on ooseq */
+	u32_t recover;			/* snd_nxt when fast recovery was entered */
+#endif							/* LWIP_TCP_SACK */
+
 	/* idle time before KEEPALIVE is sent */
 	u32_t keep_idle;
 #if LWIP_TCP_KEEPALIVE
@@ -334,6 +353,10 @@ struct tcp_pcb {
 	u8_t snd_scale;
 	u8_t rcv_scale;
 #endif
+
+#if LWIP_TCP_PCB_STATS
+	struct tcp_pcb_stats stats;
+#endif
 };
 
 #if LWIP_EVENT_API
@@ -0,0 +1,394 @@
+/****************************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "test_tcp_sack.h"
+
+#include "lwip/tcp_impl.h"
+#include "lwip/stats.h"
+#include "tcp_helper.h"
+
+#if !LWIP_STATS || !TCP_STATS || !MEMP_STATS
+#error "This tests needs TCP- and MEMP-statistics enabled"
+#endif
+#if !LWIP_TCP_SACK || !TCP_QUEUE_OOSEQ
+#error "This tests needs LWIP_TCP_SACK and TCP_QUEUE_OOSEQ enabled"
+#endif
+
+/* helper functions */
+
+/** Find a TCP option in a packet captured by the test netif
+ * @return pointer to the option kind or NULL if it is not present */
+static u8_t *test_tcp_find_opt(struct pbuf *p, u8_t kind)
+{
+	struct ip_hdr *iphdr = (struct ip_hdr *)p->payload;
+	struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *) iphdr + IPH_HL(iphdr) * 4);
+	u8_t *opts = (u8_t *)(tcphdr + 1);
+	int optlen = TCPH_HDRLEN(tcphdr) * 4 - TCP_HLEN;
+	int i = 0;
+
+	while (i < optlen && opts[i] != LWIP_TCP_OPT_EOL) {
+		if (opts[i] == LWIP_TCP_OPT_NOP) {
+			i++;
+			continue;
+		}
+		if (opts[i] == kind) {
+			return &opts[i];
+		}
+		if (i + 1 >= optlen || opts[i + 1] < 2) {
+			break;
+		}
+		i += opts[i + 1];
+	}
+	return NULL;
+}
+
+/** Get the seqno of a packet captured by the test netif */
+static u32_t test_tcp_tx_seqno(struct pbuf *p)
+{
+	struct ip_hdr *iphdr = (struct ip_hdr *)p->payload;
+	struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *) iphdr + IPH_HL(iphdr) * 4);
+	return ntohl(tcphdr->seqno);
+}
+
+/** Read the SACK blocks of a packet captured by the test netif
+ * @return the number of blocks, 0 if there is no SACK option */
+static int test_tcp_tx_sack(struct pbuf *p, u32_t *blocks)
+{
+	u8_t *opt = test_tcp_find_opt(p, LWIP_TCP_OPT_SACK);
+	int num, i;
+
+	if (opt == NULL) {
+		return 0;
+	}
+	num = (opt[1] - 2) / 8;
+	for (i = 0; i < 2 * num; i++) {
+		u8_t *edge = &opt[2 + 4 * i];
+		blocks[i] = ((u32_t) edge[0] << 24) | ((u32_t) edge[1] << 16) | ((u32_t) edge[2] << 8) | edge[3];
+	}
+	return num;
+}
+
+/** Build a SACK option with two leading NOPs
+ * @return the option length */
+static u8_t test_tcp_build_sack(u8_t *opts, const u32_t *blocks, int num)
+{
+	int i;
+
+	opts[0] = LWIP_TCP_OPT_NOP;
+	opts[1] = LWIP_TCP_OPT_NOP;
+	opts[2] = LWIP_TCP_OPT_SACK;
+	opts[3] = (u8_t)(2 + 8 * num);
+	for (i = 0; i < 2 * num; i++) {
+		opts[4 + 4 * i] = (u8_t)(blocks[i] >> 24);
+		opts[5 + 4 * i] = (u8_t)(blocks[i] >> 16);
+		opts[6 + 4 * i] = (u8_t)(blocks[i] >> 8);
+		opts[7 + 4 * i] = (u8_t) blocks[i];
+	}
+	return (u8_t)(4 + 8 * num);
+}
+
+/** Drop the packets captured by the test netif */
+static void test_tcp_tx_reset(struct test_tcp_txcounters *txcounters)
+{
+	if (txcounters->tx_packets != NULL) {
+		pbuf_free(txcounters->tx_packets);
+	}
+	txcounters->tx_packets = NULL;
+	txcounters->num_tx_calls = 0;
+	txcounters->num_tx_bytes = 0;
+}
+
+/* Setup/teardown functions */
+
+static void tcp_sack_setup(void)
+{
+	tcp_remove_all();
+}
+
+static void tcp_sack_teardown(void)
+{
+	netif_list = NULL;
+	tcp_remove_all();
+}
+
+/* Test functions */
+
+/** A SYN carries the SACK-permitted option */
+START_TEST(test_tcp_sack_syn_option)
+{
+	struct netif netif;
+	struct test_tcp_txcounters txcounters;
+	struct test_tcp_counters counters;
+	struct tcp_pcb *pcb;
+	u8_t *opt;
+	ip_addr_t remote_ip, local_ip, netmask;
+	err_t err;
+	LWIP_UNUSED_ARG(_i);
+
+	IP4_ADDR(&local_ip, 192, 168, 1, 1);
+	IP4_ADDR(&remote_ip, 192, 168, 1, 2);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+	test_tcp_init_netif(&netif, &txcounters, &local_ip, &netmask);
+	txcounters.copy_tx_packets = 1;
+	memset(&counters, 0, sizeof(counters));
+
+	pcb = test_tcp_new_counters_pcb(&counters);
+	EXPECT_RET(pcb != NULL);
+	err = tcp_connect(pcb, &remote_ip, 0x100, NULL);
+	EXPECT_RET(err == ERR_OK);
+	EXPECT_RET(txcounters.num_tx_calls == 1);
+	EXPECT_RET(txcounters.tx_packets != NULL);
+
+	opt = test_tcp_find_opt(txcounters.tx_packets, LWIP_TCP_OPT_SACK_PERM);
+	EXPECT(opt != NULL);
+	if (opt != NULL) {
+		EXPECT(opt[1] == LWIP_TCP_OPT_LEN_SACK_PERM);
+	}
+	/* SACK is not used before the peer permits it */
+	EXPECT((pcb->flags & TF_SACK) == 0);
+	test_tcp_tx_reset(&txcounters);
+
+	tcp_abort(pcb);
+	EXPECT_RET(lwip_stats.memp[MEMP_TCP_PCB].used == 0);
+}
+
+END_TEST
+/** Receive segments with two holes and check that every ACK reports the
+ * ooseq data, the most recently received block first */
+START_TEST(test_tcp_sack_recv_blocks)
+{
+	struct netif netif;
+	struct test_tcp_txcounters txcounters;
+	struct test_tcp_counters counters;
+	struct tcp_pcb *pcb;
+	struct pbuf *p;
+	char data[] = {
+		1, 2, 3, 4,
+		5, 6, 7, 8,
+		9, 10, 11, 12,
+		13, 14, 15, 16
+	};
+	u32_t blocks[2 * LWIP_TCP_MAX_SACK_NUM];
+	u32_t base;
+	ip_addr_t remote_ip, local_ip, netmask;
+	u16_t remote_port = 0x100, local_port = 0x101;
+	LWIP_UNUSED_ARG(_i);
+
+	IP4_ADDR(&local_ip, 192, 168, 1, 1);
+	IP4_ADDR(&remote_ip, 192, 168, 1, 2);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+	test_tcp_init_netif(&netif, &txcounters, &local_ip, &netmask);
+	txcounters.copy_tx_packets = 1;
+	memset(&counters, 0, sizeof(counters));
+	counters.expected_data_len = sizeof(data);
+	counters.expected_data = data;
+
+	pcb = test_tcp_new_counters_pcb(&counters);
+	EXPECT_RET(pcb != NULL);
+	tcp_set_state(pcb, ESTABLISHED, &local_ip, &remote_ip, local_port, remote_port);
+	pcb->flags |= TF_SACK;
+	base = pcb->rcv_nxt;
+
+	/* 4..8 arrives, 0..4 is lost */
+	p = tcp_create_rx_segment(pcb, &data[4], 4, 4, 0, TCP_ACK);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT_RET(txcounters.num_tx_calls == 1);
+	EXPECT(test_tcp_tx_sack(txcounters.tx_packets, blocks) == 1);
+	EXPECT(blocks[0] == base + 4 && blocks[1] == base + 8);
+	test_tcp_tx_reset(&txcounters);
+
+	/* 12..16 arrives, 8..12 is lost: the new block is reported first */
+	p = tcp_create_rx_segment(pcb, &data[12], 4, 12, 0, TCP_ACK);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT_RET(txcounters.num_tx_calls == 1);
+	EXPECT(test_tcp_tx_sack(txcounters.tx_packets, blocks) == 2);
+	EXPECT(blocks[0] == base + 12 && blocks[1] == base + 16);
+	EXPECT(blocks[2] == base + 4 && blocks[3] == base + 8);
+	test_tcp_tx_reset(&txcounters);
+
+	/* 8..12 fills the second hole: both blocks merge */
+	p = tcp_create_rx_segment(pcb, &data[8], 4, 8, 0, TCP_ACK);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT_RET(txcounters.num_tx_calls == 1);
+	EXPECT(test_tcp_tx_sack(txcounters.tx_packets, blocks) == 1);
+	EXPECT(blocks[0] == base + 4 && blocks[1] == base + 16);
+	test_tcp_tx_reset(&txcounters);
+	EXPECT(counters.recved_bytes == 0);
+
+	/* 0..4 fills the first hole: everything is passed up */
+	p = tcp_create_rx_segment(pcb, &data[0], 4, 0, 0, TCP_ACK);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(counters.recv_calls == 1);
+	EXPECT(counters.recved_bytes == sizeof(data));
+	EXPECT(pcb->ooseq == NULL);
+	EXPECT(pcb->rcv_nxt == base + sizeof(data));
+	test_tcp_tx_reset(&txcounters);
+
+	tcp_abort(pcb);
+	EXPECT_RET(lwip_stats.memp[MEMP_TCP_PCB].used == 0);
+}
+
+END_TEST
+static u8_t tx_data[6 * TCP_MSS];
+
+/** Send 6 segments, lose the 2nd and the 4th and check that SACKed
+ * segments are not retransmitted while both holes are repaired within
+ * one fast recovery */
+START_TEST(test_tcp_sack_rexmit_holes)
+{
+	struct netif netif;
+	struct test_tcp_txcounters txcounters;
+	struct test_tcp_counters counters;
+	struct tcp_pcb *pcb;
+	struct pbuf *p;
+	struct tcp_seg *seg;
+	u8_t opts[4 + 8 * 2];
+	u8_t optlen;
+	u32_t blocks[4];
+	u32_t base;
+	ip_addr_t remote_ip, local_ip, netmask;
+	u16_t remote_port = 0x100, local_port = 0x101;
+	err_t err;
+	int i;
+	LWIP_UNUSED_ARG(_i);
+
+	for (i = 0; i < (int)sizeof(tx_data); i++) {
+		tx_data[i] = (u8_t) i;
+	}
+
+	IP4_ADDR(&local_ip, 192, 168, 1, 1);
+	IP4_ADDR(&remote_ip, 192, 168, 1, 2);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+	test_tcp_init_netif(&netif, &txcounters, &local_ip, &netmask);
+	txcounters.copy_tx_packets = 1;
+	memset(&counters, 0, sizeof(counters));
+
+	pcb = test_tcp_new_counters_pcb(&counters);
+	EXPECT_RET(pcb != NULL);
+	tcp_set_state(pcb, ESTABLISHED, &local_ip, &remote_ip, local_port, remote_port);
+	pcb->mss = TCP_MSS;
+	pcb->flags |= TF_SACK;
+	/* disable initial congestion window (we don't send a SYN here...) */
+	pcb->cwnd = pcb->snd_wnd;
+	base = pcb->snd_nxt;
+
+	/* send 6 mss-sized segments */
+	for (i = 0; i < 6; i++) {
+		err = tcp_write(pcb, &tx_data[i * TCP_MSS], TCP_MSS, TCP_WRITE_FLAG_COPY);
+		EXPECT_RET(err == ERR_OK);
+	}
+	err = tcp_output(pcb);
+	EXPECT_RET(err == ERR_OK);
+	EXPECT_RET(txcounters.num_tx_calls == 6);
+	test_tcp_tx_reset(&txcounters);
+
+	/* ACK the first segment */
+	p = tcp_create_rx_segment(pcb, NULL, 0, 0, TCP_MSS, TCP_ACK);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(pcb->lastack == base + TCP_MSS);
+	test_tcp_tx_reset(&txcounters);
+
+	/* 1st dupack: the 3rd segment arrived, the 2nd is lost */
+	blocks[0] = base + 2 * TCP_MSS;
+	blocks[1] = base + 3 * TCP_MSS;
+	optlen = test_tcp_build_sack(opts, blocks, 1);
+	p = tcp_create_rx_segment_opts(pcb, NULL, 0, 0, 0, TCP_ACK, opts, optlen);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(pcb->dupacks == 1);
+	EXPECT(txcounters.num_tx_calls == 0);
+
+	/* 2nd and 3rd dupack: the 5th and 6th arrived, the 4th is lost */
+	blocks[0] = base + 4 * TCP_MSS;
+	blocks[1] = base + 6 * TCP_MSS;
+	blocks[2] = base + 2 * TCP_MSS;
+	blocks[3] = base + 3 * TCP_MSS;
+	optlen = test_tcp_build_sack(opts, blocks, 2);
+	p = tcp_create_rx_segment_opts(pcb, NULL, 0, 0, 0, TCP_ACK, opts, optlen);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(pcb->dupacks == 2);
+	EXPECT(txcounters.num_tx_calls == 0);
+
+	/* the scoreboard holds the 3rd, 5th and 6th segment */
+	for (seg = pcb->unacked, i = 1; seg != NULL; seg = seg->next, i++) {
+		EXPECT(((seg->flags & TF_SEG_SACKED) != 0) == (i == 2 || i == 4 || i == 5));
+	}
+
+	/* 3rd dupack -> fast retransmit of the first hole */
+	p = tcp_create_rx_segment_opts(pcb, NULL, 0, 0, 0, TCP_ACK, opts, optlen);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(pcb->dupacks == 3);
+	EXPECT(pcb->flags & TF_INFR);
+	EXPECT_RET(txcounters.num_tx_calls == 1);
+	EXPECT(test_tcp_tx_seqno(txcounters.tx_packets) == base + TCP_MSS);
+	test_tcp_tx_reset(&txcounters);
+
+	/* 4th dupack -> retransmit the second hole without waiting for an ACK */
+	p = tcp_create_rx_segment_opts(pcb, NULL, 0, 0, 0, TCP_ACK, opts, optlen);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT_RET(txcounters.num_tx_calls == 1);
+	EXPECT(test_tcp_tx_seqno(txcounters.tx_packets) == base + 3 * TCP_MSS);
+	test_tcp_tx_reset(&txcounters);
+
+	/* 5th dupack -> no holes left, SACKed segments are not sent again */
+	p = tcp_create_rx_segment_opts(pcb, NULL, 0, 0, 0, TCP_ACK, opts, optlen);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(txcounters.num_tx_calls == 0);
+
+	/* partial ACK up to the second hole keeps fast recovery going */
+	p = tcp_create_rx_segment_opts(pcb, NULL, 0, 0, 2 * TCP_MSS, TCP_ACK, opts, optlen);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(pcb->lastack == base + 3 * TCP_MSS);
+	EXPECT(pcb->flags & TF_INFR);
+	EXPECT(txcounters.num_tx_calls == 0);
+
+	/* ACK everything: recovery ends */
+	p = tcp_create_rx_segment(pcb, NULL, 0, 0, 3 * TCP_MSS, TCP_ACK);
+	EXPECT_RET(p != NULL);
+	test_tcp_input(p, &netif);
+	EXPECT(pcb->lastack == base + 6 * TCP_MSS);
+	EXPECT((pcb->flags & TF_INFR) == 0);
+	EXPECT(pcb->unacked == NULL);
+	EXPECT(pcb->unsent == NULL);
+	test_tcp_tx_reset(&txcounters);
+
+	tcp_abort(pcb);
+	EXPECT_RET(lwip_stats.memp[MEMP_TCP_PCB].used == 0);
+}
+
+END_TEST
+/** Create the suite including all tests for this module */
+Suite *tcp_sack_suite(void)
+{
+	TFun tests[] = {
+		test_tcp_sack_syn_option,
+		test_tcp_sack_recv_blocks,
+		test_tcp_sack_rexmit_holes
+	};
+	return create_suite("TCP_SACK", tests, sizeof(tests) / sizeof(TFun), tcp_sack_setup, tcp_sack_teardown);
+}
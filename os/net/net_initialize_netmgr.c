@@ -81,6 +81,13 @@ void net_setup(void)
 	if (res < 0) {
 		NET_LOGKE(TAG, "!!!initialize stack fail!!!\n");
 	}
+#ifdef CONFIG_NET_LOCAL
+	stk = get_netstack(TR_UDS);
+	NETSTACK_CALL_RET(stk, init, (NULL), res);
+	if (res < 0) {
+		NET_LOGKE(TAG, "!!!initialize local socket stack fail!!!\n");
+	}
+#endif
 	netdev_mgr_start();
 }
 
@@ -190,11 +190,122 @@ ssize_t sendmsg(int sockfd, struct msghdr *msg, int flags)
 	NETSTACK_CALL_BYFD(sockfd, sendmsg, (sockfd, msg, flags));
 }
 
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *	 Receive up to vlen messages with a single call. Each entry of msgvec is
+ *	 filled as by recvmsg() and its msg_len is set to the bytes received.
+ *
+ * Parameters:
+ *	 sockfd	  Socket descriptor of socket
+ *	 msgvec	  Array of messages to receive into
+ *	 vlen	  Number of entries in msgvec
+ *	 flags	  Receive flags, MSG_WAITFORONE to only block for the first one
+ *	 timeout  Optional limit on the time spent receiving, checked between
+ *	          messages
+ *
+ * Returned Value:
+ *	 The number of messages received, or -1 with errno set if none was.
+ *
+ ****************************************************************************/
+int recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	int res = -1;
+	NETSTACK_CALL_BYFD_RET(sockfd, recvmmsg, (sockfd, msgvec, vlen, flags, timeout), res);
+	leave_cancellation_point();
+	return res;
+}
+
+/****************************************************************************
+ * Function: sendmmsg
+ *
+ * Description:
+ *	 Send up to vlen messages with a single call. The msg_len of each
+ *	 entry sent is set to the bytes transmitted for it.
+ *
+ * Parameters:
+ *	 sockfd	  Socket descriptor of socket
+ *	 msgvec	  Array of messages to send
+ *	 vlen	  Number of entries in msgvec
+ *	 flags	  Send flags
+ *
+ * Returned Value:
+ *	 The number of messages sent, or -1 with errno set if none was.
+ *
+ ****************************************************************************/
+int sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	int res = -1;
+	NETSTACK_CALL_BYFD_RET(sockfd, sendmmsg, (sockfd, msgvec, vlen, flags), res);
+	leave_cancellation_point();
+	return res;
+}
+
+/****************************************************************************
+ * Function: recv_zerocopy
+ *
+ * Description:
+ *	 Receive data from a TCP socket without copying it. iov is filled with
+ *	 read-only references to the received segments, which stay valid until
+ *	 the handle is passed to recv_zerocopy_release(). The TCP_ZEROCOPY_RECV
+ *	 option must be set on the socket.
+ *
+ * Parameters:
+ *	 sockfd	  Socket descriptor of socket
+ *	 iov	  Filled with one entry per received segment
+ *	 iovcnt	  Number of entries in iov
+ *	 handle	  Set to the reference to release
+ *	 flags	  Receive flags, MSG_DONTWAIT or 0
+ *
+ * Returned Value:
+ *	 The number of bytes referenced by iov, 0 if the peer has closed the
+ *	 connection, or -1 with errno set.
+ *
+ ****************************************************************************/
+int recv_zerocopy(int sockfd, struct iovec *iov, int iovcnt, void **handle, int flags)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	int res = -1;
+	NETSTACK_CALL_BYFD_RET(sockfd, recv_zerocopy, (sockfd, iov, iovcnt, handle, flags), res);
+	leave_cancellation_point();
+	return res;
+}
+
+/****************************************************************************
+ * Function: recv_zerocopy_release
+ *
+ * Description:
+ *	 Release data returned by recv_zerocopy() and open the TCP receive
+ *	 window for it. Must be called before the socket is closed.
+ *
+ * Parameters:
+ *	 sockfd	  Socket descriptor the data was received on
+ *	 handle	  The handle set by recv_zerocopy()
+ *
+ * Returned Value:
+ *	 0 on success, or -1 with errno set.
+ *
+ ****************************************************************************/
+int recv_zerocopy_release(int sockfd, void *handle)
+{
+	int res = -1;
+	NETSTACK_CALL_BYFD_RET(sockfd, recv_zerocopy_release, (sockfd, handle), res);
+	return res;
+}
+
 int socket(int domain, int type, int protocol)
 {
 	struct netstack *stk = NULL;
 	if (domain == AF_LWNL) {
 		stk = get_netstack(TR_LWNL);
+	} else if (domain == AF_UNIX) {
+		stk = get_netstack(TR_UDS);
 	} else {
 		stk = get_netstack(TR_SOCKET);
 	}
@@ -178,8 +178,11 @@ int net_ioctl(int sd, int cmd, unsigned long arg)
 	}
 
 	/* ToDo:  Verify that the sd corresponds to valid, allocated socket */
-	sock = get_socket_by_pid(sd, getpid());
-	if (sock == NULL) {
+	/* Local sockets are not LWIP sockets and are checked by their stack */
+	if (netstack_socktype(sd) == TR_SOCKET) {
+		sock = get_socket_by_pid(sd, getpid());
+	}
+	if (sock == NULL && netstack_socktype(sd) != TR_UDS) {
 		NET_LOGKE(TAG, "get socket fail\n");
 		ret = -EBADF;
 		goto errout;
@@ -235,15 +238,20 @@ errout:
 int net_vfcntl(int sd, int cmd, va_list ap)
 {
 
-	FAR struct socket *sock = (struct socket *)get_socket_by_pid(sd, getpid());
+	FAR struct socket *sock = NULL;
 	int err = 0;
 	int ret = 0;
 
 	NET_LOGKV(TAG, "sd=%d cmd=%d\n", sd, cmd);
 
-	/* Verify that the sd corresponds to valid, allocated socket */
+	/* Verify that the sd corresponds to valid, allocated socket.  Local
+	 * sockets are checked by their own stack.
+	 */
 
-	if (!sock) {
+	if (netstack_socktype(sd) == TR_SOCKET) {
+		sock = (struct socket *)get_socket_by_pid(sd, getpid());
+	}
+	if (!sock && netstack_socktype(sd) != TR_UDS) {
 		err = EBADF;
 		NET_LOGKE(TAG, "invalid socket\n");
 		goto errout;
@@ -23,6 +23,7 @@
 #include <net/if.h>
 #include <ifaddrs.h>
 #include <tinyara/kmalloc.h>
+#include <tinyara/irq.h>
 #include <tinyara/lwnl/lwnl.h>
 #include <tinyara/net/if/wifi.h>
 #include <tinyara/net/if/ethernet.h>
@@ -36,7 +37,12 @@
 #include "lwip/netifapi.h"
 #include "lwip/snmp.h"
 #include "lwip/igmp.h"
+#include "lwip/tcpip.h"
+#include "lwip/timeouts.h"
+#include "lwip/ip.h"
+#include "lwip/netif/ethernet.h"
 #include "netdev_mgr_internal.h"
+#include "netdev_stats.h"
 #include <tinyara/net/netlog.h>
 
 /* This is really kind of bogus.. When asked for an IP address, this is
@@ -52,6 +58,38 @@
 #define GET_NETIF_FROM_NETDEV(dev) (struct netif *)(((struct netdev_ops *)(dev)->ops)->nic)
 #define TAG "[NETMGR]"
 
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+#if (CONFIG_NET_NETMGR_RXBATCH_QSIZE & (CONFIG_NET_NETMGR_RXBATCH_QSIZE - 1)) != 0
+#error "CONFIG_NET_NETMGR_RXBATCH_QSIZE must be a power of two"
+#endif
+#define LW_RXQ_MASK (CONFIG_NET_NETMGR_RXBATCH_QSIZE - 1)
+
+/* Delay before the poll tries again to post itself into a full mbox */
+#define LW_RXQ_RETRY_MS 1
+
+/* Frames received by a device and not yet seen by tcpip_thread.  The driver
+ * only moves head and tcpip_thread only moves tail.  scheduled is set while
+ * a poll is posted, armed as a timeout or running, and then the driver
+ * posts nothing.  closed is set by the device teardown; the last poll
+ * drops what is left and clears scheduled instead of polling again.
+ */
+struct lwip_rxq {
+	struct pbuf *frames[CONFIG_NET_NETMGR_RXBATCH_QSIZE];
+	volatile uint16_t head;
+	volatile uint16_t tail;
+	volatile uint8_t scheduled;
+	struct tcpip_callback_msg *msg;
+	struct netif *nic;
+	volatile uint8_t closed;
+};
+
+/* The queue lives right after the netdev pointer that follows the netif */
+#define LW_GETRXQ(nic) ((struct lwip_rxq *)(&((char *)nic)[sizeof(struct netif) + sizeof(struct netdev *)]))
+#define LW_RXQ_SIZE sizeof(struct lwip_rxq)
+#else
+#define LW_RXQ_SIZE 0
+#endif
+
 // ToDo
 static int g_num = 0;
 
@@ -273,6 +311,155 @@ static inline void _free_ifaddrs(struct ifaddrs *addrs)
 	}
 }
 
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+/* Post a poll unless one is already pending.  Called by the driver when
+ * the queue may have gone from empty to non-empty.
+ */
+static bool _lwip_rxq_schedule(struct lwip_rxq *q)
+{
+	irqstate_t flags = irqsave();
+	if (q->scheduled || q->closed) {
+		irqrestore(flags);
+		return false;
+	}
+	q->scheduled = 1;
+	irqrestore(flags);
+
+	if (tcpip_trycallback(q->msg) != ERR_OK) {
+		/* mbox is full, the next frame tries again */
+		q->scheduled = 0;
+		return false;
+	}
+	return true;
+}
+
+/* Runs in tcpip_thread: process up to the budget and poll again if frames
+ * are left, otherwise go back to waiting for the driver to post.  The poll
+ * stays scheduled until the queue is seen empty, so teardown never posts a
+ * second one.
+ */
+static void _lwip_rxq_poll(void *arg)
+{
+	struct lwip_rxq *q = (struct lwip_rxq *)arg;
+	struct netif *nic = q->nic;
+	uint16_t tail = q->tail;
+	struct pbuf *p;
+	irqstate_t flags;
+	err_t res;
+	int cnt = 0;
+
+	while (!q->closed && cnt < CONFIG_NET_NETMGR_RXBATCH_BUDGET && tail != q->head) {
+		p = q->frames[tail & LW_RXQ_MASK];
+		q->tail = ++tail;
+		cnt++;
+#if LWIP_ETHERNET
+		if (nic->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
+			res = ethernet_input(p, nic);
+		} else
+#endif
+		{
+			res = ip_input(p, nic);
+		}
+		if (res != ERR_OK) {
+			pbuf_free(p);
+		}
+	}
+	NETMGR_STATS_ADD(g_rxbatch_frame, cnt);
+	NETMGR_STATS_MAX(g_rxbatch_max, (uint32_t)cnt);
+
+	flags = irqsave();
+	if (q->closed) {
+		irqrestore(flags);
+		while (q->tail != q->head) {
+			pbuf_free(q->frames[q->tail & LW_RXQ_MASK]);
+			q->tail++;
+		}
+		/* Last access: q may be freed as soon as this is seen */
+		q->scheduled = 0;
+		return;
+	}
+	if (q->tail == q->head) {
+		q->scheduled = 0;
+		irqrestore(flags);
+		return;
+	}
+	irqrestore(flags);
+
+	if (tcpip_trycallback(q->msg) == ERR_OK) {
+		NETMGR_STATS_INC(g_rxbatch_poll);
+	} else {
+		/* mbox is full, don't leave the frames until the next one arrives */
+		sys_timeout(LW_RXQ_RETRY_MS, _lwip_rxq_poll, q);
+	}
+}
+
+static err_t _lwip_rx_input(struct netif *nic, struct pbuf *p)
+{
+	struct lwip_rxq *q = LW_GETRXQ(nic);
+	uint16_t head = q->head;
+
+	if (!q->msg) {
+		return nic->input(p, nic);
+	}
+	if (q->closed || (uint16_t)(head - q->tail) >= CONFIG_NET_NETMGR_RXBATCH_QSIZE) {
+		NETMGR_STATS_INC(g_rxbatch_drop);
+		return ERR_MEM;
+	}
+	q->frames[head & LW_RXQ_MASK] = p;
+	q->head = head + 1;
+
+	if (_lwip_rxq_schedule(q)) {
+		NETMGR_STATS_INC(g_rxbatch_wakeup);
+	}
+	return ERR_OK;
+}
+
+static void _lwip_rxq_init(struct netif *nic)
+{
+	struct lwip_rxq *q = LW_GETRXQ(nic);
+
+	q->nic = nic;
+	q->msg = tcpip_callbackmsg_new(_lwip_rxq_poll, q);
+	if (!q->msg) {
+		NET_LOGKE(TAG, "rx batch disabled: callback msg alloc fail\n");
+	}
+}
+
+/* Wait until no poll is posted or running before the netif is freed.  The
+ * frames still queued are dropped by the last poll in tcpip_thread.
+ */
+static void _lwip_rxq_deinit(struct netif *nic)
+{
+	struct lwip_rxq *q = LW_GETRXQ(nic);
+	irqstate_t flags;
+	bool post;
+
+	if (!q->msg) {
+		return;
+	}
+
+	flags = irqsave();
+	q->closed = 1;
+	post = !q->scheduled;
+	q->scheduled = 1;
+	irqrestore(flags);
+
+	if (post) {
+		while (tcpip_trycallback(q->msg) != ERR_OK) {
+			sys_msleep(LW_RXQ_RETRY_MS);
+		}
+	}
+	while (q->scheduled) {
+		sys_msleep(LW_RXQ_RETRY_MS);
+	}
+
+	tcpip_callbackmsg_delete(q->msg);
+	q->msg = NULL;
+}
+#else
+#define _lwip_rx_input(nic, p) (nic)->input(p, nic)
+#endif
+
 #ifdef CONFIG_NET_NETMGR_ZEROCOPY
 static err_t lwip_linkoutput(struct netif *nic, struct pbuf *buf)
 {
@@ -295,6 +482,7 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 		return -1;
 	}
 
+	struct netif *netif = GET_NETIF_FROM_NETDEV(dev);
 	struct pbuf *p = (struct pbuf *)frame_ptr;
 	struct eth_hdr *ethhdr = p->payload;
 
@@ -310,11 +498,13 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 #endif
 	{
 		/* full packet send to tcpip_thread to process */
-		if (netif->input(p, netif) != ERR_OK) {
+		if (_lwip_rx_input(netif, p) != ERR_OK) {
 			LWIP_DEBUGF(NETIF_DEBUG, ("input processing error\n"));
 			NET_LOGKE(TAG, "input processing error\n");
 			LINK_STATS_INC(link.err);
 			NETMGR_STATS_INC(g_link_recv_err);
+			/* the driver frees the pbuf */
+			return -1;
 		} else {
 			LINK_STATS_INC(link.recv);
 		}
@@ -389,7 +579,7 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 #endif
 	{
 		/* full packet send to tcpip_thread to process */
-		if (netif->input(p, netif) != ERR_OK) {
+		if (_lwip_rx_input(netif, p) != ERR_OK) {
 			NET_LOGKE(TAG, "input processing\n");
 			LWIP_DEBUGF(NETIF_DEBUG, ("input processing error\n"));
 			LINK_STATS_INC(link.err);
@@ -772,7 +962,7 @@ static int lwip_init_nic(struct netdev *dev, struct nic_config *config)
 		return -1;
 	}
 
-	char *rnetif = (char *)kmm_zalloc(sizeof(struct netif) + sizeof(struct netdev *));
+	char *rnetif = (char *)kmm_zalloc(sizeof(struct netif) + sizeof(struct netdev *) + LW_RXQ_SIZE);
 	if (!rnetif) {
 		NET_LOGKE(TAG, "zalloc fail\n");
 		return -1;
@@ -818,6 +1008,9 @@ static int lwip_init_nic(struct netdev *dev, struct nic_config *config)
 	taddr = (struct sockaddr_in *)&config->gw;
 	gw.addr = taddr->sin_addr.s_addr;
 	netif_add(nic, &ipaddr, &netmask, &gw, NULL, _lwip_nic_init, tcpip_input);
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+	_lwip_rxq_init(nic);
+#endif
 	if (config->is_default) {
 		netif_set_default(nic);
 	}
@@ -840,6 +1033,9 @@ static int lwip_deinit_nic(struct netdev *dev)
 
 	struct netif *ni = GET_NETIF_FROM_NETDEV(dev);
 	if (ni) {
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+		_lwip_rxq_deinit(ni);
+#endif
 		kmm_free((void *)ni);
 	}
 	ND_NETOPS(dev, nic) = NULL;
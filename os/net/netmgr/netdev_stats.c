@@ -28,9 +28,21 @@ uint32_t g_link_recv_err = 0;
 uint32_t g_app_recv_byte = 0;
 uint32_t g_app_recv_cnt = 0;
 
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+uint32_t g_rxbatch_wakeup = 0;
+uint32_t g_rxbatch_poll = 0;
+uint32_t g_rxbatch_frame = 0;
+uint32_t g_rxbatch_drop = 0;
+uint32_t g_rxbatch_max = 0;
+#endif
+
 void netstats_display(void)
 {
 	NET_LOGK(TAG, "[driver] total recv %u\t%u\n", g_link_recv_byte, g_link_recv_cnt);
 	NET_LOGK(TAG, "[driver] mbox err %u\n", g_link_recv_err);
 	NET_LOGK(TAG, "[app] total recv %u\t%u\n", g_app_recv_byte, g_app_recv_cnt);
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+	NET_LOGK(TAG, "[rxbatch] wakeup %u\tpoll %u\n", g_rxbatch_wakeup, g_rxbatch_poll);
+	NET_LOGK(TAG, "[rxbatch] frames %u\tdrop %u\tmax batch %u\n", g_rxbatch_frame, g_rxbatch_drop, g_rxbatch_max);
+#endif
 }
@@ -27,18 +27,39 @@ extern uint32_t g_link_recv_err;
 extern uint32_t g_app_recv_byte;
 extern uint32_t g_app_recv_cnt;
 
+#ifdef CONFIG_NET_NETMGR_RXBATCH
+extern uint32_t g_rxbatch_wakeup;
+extern uint32_t g_rxbatch_poll;
+extern uint32_t g_rxbatch_frame;
+extern uint32_t g_rxbatch_drop;
+extern uint32_t g_rxbatch_max;
+#endif
+
+/* The counters are shared by every device and every task calling recv(),
+ * so they are updated with an atomic add instead of a lock.
+ */
 #define NETMGR_STATS_ADD(x, y) \
 	do {                       \
-		x += y;                \
+		(void)__sync_fetch_and_add(&(x), (uint32_t)(y)); \
+	} while (0)
+
+#define NETMGR_STATS_INC(x) NETMGR_STATS_ADD(x, 1)
+
+/* Only used by tcpip_thread, which is the sole writer of the maximum */
+#define NETMGR_STATS_MAX(x, y) \
+	do {                       \
+		if ((y) > x) {         \
+			x = (y);           \
+		}                      \
 	} while (0)
 
-#define NETMGR_STATS_INC(x) x++;
 void netstats_display(void);
 
 #else
 
 #define NETMGR_STATS_ADD(x, y)
 #define NETMGR_STATS_INC(x)
+#define NETMGR_STATS_MAX(x, y)
 
 #define netstats_display(...)
 
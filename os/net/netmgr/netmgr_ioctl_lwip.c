@@ -24,6 +24,7 @@
 #include <netdb.h>
 #include <ifaddrs.h>
 #include <tinyara/kmalloc.h>
+#include <tinyara/net/net.h>
 #include <tinyara/netmgr/netdev_mgr.h>
 #include <net/if.h>
 #include "netdev_mgr_internal.h"
@@ -264,13 +265,14 @@ static struct addrinfo *_netdev_copy_addrinfo(struct addrinfo *src)
 		dst->ai_protocol = tmp->ai_protocol;
 		dst->ai_addrlen = tmp->ai_addrlen;
 
-		dst->ai_addr = (struct sockaddr *)kumm_malloc(sizeof(struct sockaddr));
+		/* ai_addrlen covers a sockaddr_in6 as well */
+		dst->ai_addr = (struct sockaddr *)kumm_malloc(tmp->ai_addrlen);
 		if (!dst->ai_addr) {
 			NET_LOGKE(TAG, "kumm_malloc failed\n");
 			kumm_free(dst);
 			break;
 		}
-		memcpy(dst->ai_addr, tmp->ai_addr, sizeof(struct sockaddr));
+		memcpy(dst->ai_addr, tmp->ai_addr, tmp->ai_addrlen);
 
 		if (tmp->ai_canonname) {
 			dst->ai_canonname = (char *)kumm_malloc(strlen(tmp->ai_canonname) + 1);
@@ -317,6 +319,30 @@ static int _netdev_free_addrinfo(struct addrinfo *ai)
 	}
 	return 0;
 }
+
+#if LWIP_DNS_ASYNC
+/* Caller's completion callback of a GETADDRINFO_ASYNC request */
+struct _netdev_gai_async {
+	void (*cb)(int result, struct addrinfo *res, void *arg);
+	void *arg;
+};
+
+static void _netdev_getaddrinfo_done(int err, struct addrinfo *res, void *arg)
+{
+	struct _netdev_gai_async *ctx = (struct _netdev_gai_async *)arg;
+	struct addrinfo *user_res = NULL;
+
+	if (err == 0) {
+		user_res = _netdev_copy_addrinfo(res);
+		lwip_freeaddrinfo(res);
+		if (!user_res) {
+			err = EAI_MEMORY;
+		}
+	}
+	ctx->cb(err, user_res, ctx->arg);
+	kmm_free(ctx);
+}
+#endif
 #endif
 
 /****************************************************************************
@@ -355,6 +381,9 @@ static int lwip_func_ioctl(int s, int cmd, void *arg)
 	struct hostent *host_ent = NULL;
 	struct hostent *user_ent = NULL;
 #endif
+#if LWIP_DNS_ASYNC
+	struct _netdev_gai_async *gai_ctx = NULL;
+#endif
 
 	switch (req->type) {
 #if LWIP_DNS
@@ -371,12 +400,36 @@ static int lwip_func_ioctl(int s, int cmd, void *arg)
 			lwip_freeaddrinfo(res);
 		}
 		break;
+#if LWIP_DNS_ASYNC
+	case GETADDRINFO_ASYNC:
+		ret = OK;
+		gai_ctx = (struct _netdev_gai_async *)kmm_malloc(sizeof(struct _netdev_gai_async));
+		if (!gai_ctx) {
+			req->req_res = EAI_MEMORY;
+			break;
+		}
+		gai_ctx->cb = req->msg.netdb.ai_cb;
+		gai_ctx->arg = req->msg.netdb.ai_cb_arg;
+		req->req_res = lwip_getaddrinfo_async(req->msg.netdb.host_name,
+											  req->msg.netdb.serv_name,
+											  req->msg.netdb.ai_hint,
+											  _netdev_getaddrinfo_done, gai_ctx);
+		if (req->req_res != 0) {
+			NET_LOGKE(TAG, "lwip_getaddrinfo_async() returned with the error code: %d\n", req->req_res);
+			kmm_free(gai_ctx);
+		}
+		break;
+#endif
 	case FREEADDRINFO:
 		req->req_res = _netdev_free_addrinfo(req->msg.netdb.ai_res);
 		ret = OK;
 		break;
 	case DNSSETSERVER:
 		req->req_res = _netdev_set_dnsserver(req->msg.dns.addr, req->msg.dns.index);
+#if LWIP_DNS_CACHE_SIZE
+		/* answers of the old servers, failures in particular, are stale */
+		lwip_dns_cache_flush();
+#endif
 		ret = OK;
 		break;
 	case GETHOSTBYNAME:
@@ -526,6 +579,20 @@ static int lwip_func_ioctl(int s, int cmd, void *arg)
 		}
 		break;
 	}
+#ifdef CONFIG_NET_TCP_PCB_STATS
+	case GETTCPSTATS: {
+		struct lwip_tcpstats_msg *msg = &(((struct req_lwip_data *)arg)->msg.tcpstats);
+		int count = net_tcpstats(msg->stats, msg->max);
+		if (count < 0) {
+			req->req_res = count;
+		} else {
+			msg->count = count;
+			req->req_res = 0;
+		}
+		ret = OK;
+		break;
+	}
+#endif
 	default:
 		NET_LOGKE(TAG, "Wrong request type: %d\n", req->type);
 		ret = -ENOTTY;
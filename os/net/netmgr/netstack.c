@@ -31,13 +31,18 @@ extern struct netstack *get_netstack_lwip(void);
 #ifdef CONFIG_LWNL80211
 extern struct netstack *get_netstack_netlink(void);
 #endif
+#ifdef CONFIG_NET_LOCAL
+extern struct netstack *get_netstack_uds(void);
+#endif
 
-static sock_type _get_socktype(int fd)
+sock_type netstack_socktype(int fd)
 {
 	if (fd < CONFIG_NFILE_DESCRIPTORS) {
 		return TR_LWNL;
-	} else if (fd < CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS) {
+	} else if (fd < CONFIG_NFILE_DESCRIPTORS + CONFIG_NBSDSOCKET_DESCRIPTORS) {
 		return TR_SOCKET;
+	} else if (fd < CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS) {
+		return TR_UDS;
 	}
 	NET_LOGKE(TAG, "not supported socket type\n");
 	return TR_UNKNOWN;
@@ -50,6 +55,10 @@ struct netstack *get_netstack(sock_type type)
 	} else if (type == TR_LWNL) {
 #ifdef CONFIG_LWNL80211
 		return get_netstack_netlink();
+#endif
+	} else if (type == TR_UDS) {
+#ifdef CONFIG_NET_LOCAL
+		return get_netstack_uds();
 #endif
 	}
 	NET_LOGKE(TAG, "not supported stack type\n");
@@ -58,13 +67,17 @@ struct netstack *get_netstack(sock_type type)
 
 struct netstack *get_netstack_byfd(int fd)
 {
-	sock_type type = _get_socktype(fd);
+	sock_type type = netstack_socktype(fd);
 
 	if (type == TR_SOCKET) {
 		return get_netstack_lwip();
 	} else if (type == TR_LWNL) {
 #ifdef CONFIG_LWNL80211
 		return get_netstack_netlink();
+#endif
+	} else if (type == TR_UDS) {
+#ifdef CONFIG_NET_LOCAL
+		return get_netstack_uds();
 #endif
 	}
 	NET_LOGKE(TAG, "not supported stack type\n");
@@ -77,6 +77,10 @@ struct netstack_ops {
 	ssize_t (*send)(int s, const void *data, size_t size, int flags);
 	ssize_t (*sendto)(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen);
 	ssize_t (*sendmsg)(int s, struct msghdr *msg, int flags);
+	int (*recvmmsg)(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout);
+	int (*sendmmsg)(int s, struct mmsghdr *msgvec, unsigned int vlen, int flags);
+	int (*recv_zerocopy)(int s, struct iovec *iov, int iovcnt, void **handle, int flags);
+	int (*recv_zerocopy_release)(int s, void *handle);
 	int (*getsockname)(int s, struct sockaddr *name, socklen_t *namelen);
 	int (*getpeername)(int s, struct sockaddr *name, socklen_t *namelen);
 	int (*setsockopt)(int s, int level, int optname, const void *optval, socklen_t optlen);
@@ -96,6 +100,7 @@ struct netstack {
 	void *data;
 };
 
+sock_type netstack_socktype(int fd);
 struct netstack *get_netstack(sock_type type);
 struct netstack *get_netstack_byfd(int fd);
 
@@ -44,6 +44,10 @@
 #include "lwip/raw.h"
 #include "lwip/ip.h"
 #include "lwip/ip6.h"
+#if LWIP_TCP_PCB_STATS
+#include "lwip/priv/tcpip_priv.h"
+#include "lwip/priv/tcp_priv.h"
+#endif
 
 #define TCP_STR "TCP"
 #define UDP_STR "UDP"
@@ -422,6 +426,87 @@ static void _netmon_handler(struct tcb_s *tcb, void *arg)
 	}
 }
 
+#if LWIP_TCP_PCB_STATS
+struct _tcpstats_call {
+	struct tcpip_api_call_data call;
+	struct netmon_tcp_stats *stats;
+	int max;
+	int count;
+};
+
+static void _tcpstats_sockaddr(struct sockaddr_storage *ss, const ip_addr_t *ipaddr, u16_t port)
+{
+	memset(ss, 0, sizeof(*ss));
+#if LWIP_IPV6
+	if (IP_IS_V6(ipaddr)) {
+		struct sockaddr_in6 *sin6 = (struct sockaddr_in6 *)ss;
+		sin6->sin6_family = AF_INET6;
+		sin6->sin6_port = lwip_htons(port);
+		inet6_addr_from_ip6addr(&sin6->sin6_addr, ip_2_ip6(ipaddr));
+		return;
+	}
+#endif
+	struct sockaddr_in *sin = (struct sockaddr_in *)ss;
+	sin->sin_family = AF_INET;
+	sin->sin_port = lwip_htons(port);
+	inet_addr_from_ip4addr(&sin->sin_addr, ip_2_ip4(ipaddr));
+}
+
+/* runs in the tcpip thread, so the pcb list can't change underneath */
+static err_t _tcpstats_collect(struct tcpip_api_call_data *call)
+{
+	struct _tcpstats_call *msg = (struct _tcpstats_call *)call;
+	struct tcp_pcb *pcb;
+
+	msg->count = 0;
+	for (pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next, msg->count++) {
+		if (msg->count >= msg->max) {
+			continue;
+		}
+		struct netmon_tcp_stats *st = &msg->stats[msg->count];
+		_tcpstats_sockaddr(&st->local, &pcb->local_ip, pcb->local_port);
+		_tcpstats_sockaddr(&st->remote, &pcb->remote_ip, pcb->remote_port);
+		st->state = pcb->state;
+		st->mss = pcb->mss;
+		/* sa holds 8 * srtt and sv 4 * rttvar, both in slow timer ticks */
+		st->srtt = (u32_t)(pcb->sa >> 3) * TCP_SLOW_INTERVAL;
+		st->rttvar = (u32_t)(pcb->sv >> 2) * TCP_SLOW_INTERVAL;
+		st->rto = (u32_t)pcb->rto * TCP_SLOW_INTERVAL;
+		st->cwnd = pcb->cwnd;
+		st->ssthresh = pcb->ssthresh;
+		st->snd_wnd = pcb->snd_wnd;
+		st->rcv_wnd = pcb->rcv_wnd;
+		st->snd_queued = pcb->snd_lbb - pcb->lastack;
+		st->snd_queuelen = pcb->snd_queuelen;
+		st->rcv_queued = TCP_WND_MAX(pcb) - pcb->rcv_wnd;
+		st->segs_in = pcb->stats.segs_in;
+		st->segs_out = pcb->stats.segs_out;
+		st->bytes_in = pcb->stats.bytes_in;
+		st->bytes_out = pcb->stats.bytes_out;
+		st->retransmits = pcb->stats.retransmits;
+	}
+	return ERR_OK;
+}
+
+int net_tcpstats(FAR struct netmon_tcp_stats *stats, int max)
+{
+	struct _tcpstats_call msg;
+	err_t err;
+
+	if (max < 0 || (max > 0 && stats == NULL)) {
+		return -EINVAL;
+	}
+	msg.stats = stats;
+	msg.max = max;
+	msg.count = 0;
+	err = tcpip_api_call(_tcpstats_collect, &msg.call);
+	if (err != ERR_OK) {
+		return -err_to_errno(err);
+	}
+	return msg.count;
+}
+#endif							/* LWIP_TCP_PCB_STATS */
+
 /*
  * ops functions
  */
@@ -639,14 +724,43 @@ static ssize_t lwip_ns_recvmsg(int sockfd, struct msghdr *msg, int flags)
 
 static ssize_t lwip_ns_sendmsg(int sockfd, struct msghdr *msg, int flags)
 {
+#if LWIP_SOCKET_MMSG
+	/* lwip_sendmsg() gathers every iovec and honours UDP_SEGMENT */
+	return lwip_sendmsg(sockfd, msg, flags);
+#else
 	uint8_t *buf = (uint8_t *)(msg->msg_iov->iov_base);
 	size_t len = msg->msg_iov->iov_len;
 	struct sockaddr *to = (struct sockaddr *)msg->msg_name;
 	int *addrlen = (int *)&(msg->msg_namelen);
 
 	return sendto(sockfd, buf, len, flags, to, (socklen_t)*addrlen);
+#endif
 }
 
+#if LWIP_SOCKET_MMSG
+static int lwip_ns_recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags, struct timespec *timeout)
+{
+	return lwip_recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+}
+
+static int lwip_ns_sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	return lwip_sendmmsg(sockfd, msgvec, vlen, flags);
+}
+#endif
+
+#if LWIP_TCP_ZEROCOPY_RECV
+static int lwip_ns_recv_zerocopy(int sockfd, struct iovec *iov, int iovcnt, void **handle, int flags)
+{
+	return lwip_recv_zerocopy(sockfd, iov, iovcnt, handle, flags);
+}
+
+static int lwip_ns_recv_zerocopy_release(int sockfd, void *handle)
+{
+	return lwip_recv_zerocopy_release(sockfd, handle);
+}
+#endif
+
 static int lwip_ns_init(void *data)
 {
 	lwip_init();
@@ -790,6 +904,20 @@ struct netstack_ops g_lwip_stack_ops = {
 	lwip_ns_send,
 	lwip_ns_sendto,
 	lwip_ns_sendmsg,
+#if LWIP_SOCKET_MMSG
+	lwip_ns_recvmmsg,
+	lwip_ns_sendmmsg,
+#else
+	NULL,
+	NULL,
+#endif
+#if LWIP_TCP_ZEROCOPY_RECV
+	lwip_ns_recv_zerocopy,
+	lwip_ns_recv_zerocopy_release,
+#else
+	NULL,
+	NULL,
+#endif
 
 	lwip_ns_getsockname,
 	lwip_ns_getpeername,
@@ -81,6 +81,10 @@ struct netstack_ops g_netlink_stack_ops = {
 	NULL,
 	NULL,
 	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
 
 	NULL,
 	NULL,
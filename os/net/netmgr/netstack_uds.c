@@ -24,45 +24,49 @@
 #include "local/uds_net.h"
 
 struct netstack_ops g_uds_stack_ops = {
-	NULL,
-	NULL,
+	uds_init,
 	NULL,
 	NULL,
 	NULL,
 
-	NULL,
-	NULL,
+	uds_close,
+	uds_dup,
+	uds_dup2,
 	NULL,
 	uds_checksd,
-	NULL,
-	NULL,
-	NULL,
+	uds_ioctl,
+	uds_fcntl,
+	uds_poll,
 
 	uds_socket,
 	uds_bind,
 	uds_connect,
 	uds_accept,
 	uds_listen,
-	NULL,
+	uds_shutdown,
 
 	uds_recv,
 	uds_recvfrom,
-	NULL,
+	uds_recvmsg,
 	uds_send,
 	uds_sendto,
+	uds_sendmsg,
+	NULL,
+	NULL,
+	NULL,
 	NULL,
 
 	uds_getsockname,
 	uds_getpeername,
-	NULL,
-	NULL,
+	uds_setsockopt,
+	uds_getsockopt,
 #ifdef CONFIG_NET_ROUTE
 	NULL,
 	NULL,
 #endif
-#ifdef CONFIG_NET_NETMON
 	NULL,
-#endif
+	NULL,
+	NULL,
 };
 
 struct netstack g_uds_stack = {&g_uds_stack_ops, NULL};
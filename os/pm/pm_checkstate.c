@@ -102,9 +102,13 @@
 enum pm_state_e pm_checkstate(int domain)
 {
 	FAR struct pm_domain_s *pdom;
+	enum pm_state_e state;
 	clock_t now;
 	irqstate_t flags;
 	int index;
+#if CONFIG_PM_STANDBY_MINSLEEP > 0 || CONFIG_PM_SLEEP_MINSLEEP > 0
+	int delay;
+#endif
 
 	/* Get a convenience pointer to minimize all of the indexing */
 
@@ -156,8 +160,30 @@ enum pm_state_e pm_checkstate(int domain)
 		}
 	}
 
+	state = pdom->recommended;
+
+#if CONFIG_PM_STANDBY_MINSLEEP > 0 || CONFIG_PM_SLEEP_MINSLEEP > 0
+	/* A low power state is not worth entering if the next timer event comes
+	 * before the state could pay off.  With coalesced timers, this is the
+	 * true next deadline of all watchdogs.
+	 */
+
+	if (state >= PM_STANDBY) {
+		delay = wd_getdelay();
+		if (delay > 0) {
+			if (state >= PM_SLEEP && delay < MSEC2TICK(CONFIG_PM_SLEEP_MINSLEEP)) {
+				state = PM_STANDBY;
+			}
+
+			if (state == PM_STANDBY && delay < MSEC2TICK(CONFIG_PM_STANDBY_MINSLEEP)) {
+				state = PM_IDLE;
+			}
+		}
+	}
+#endif
+
 	irqrestore(flags);
-	return pdom->recommended;
+	return state;
 }
 
 #endif							/* CONFIG_PM */
@@ -179,6 +179,7 @@ int work_hpstart(void)
 	/* Initialize work queue data structures */
 
 	dq_init(&g_hpwork.q);
+	dq_init(&g_hpwork.delayq);
 
 	/* Start the high-priority, kernel mode worker thread */
 
@@ -213,9 +213,10 @@ int work_lpstart(void)
 	/* Initialize work queue data structures */
 
 	struct lp_wqueue_s *lwq = get_lpwork();
-	memset(lwq, 0, sizeof(struct wqueue_s));
+	memset(lwq, 0, sizeof(struct lp_wqueue_s));
 
 	dq_init(&lwq->q);
+	dq_init(&lwq->delayq);
 
 	/* Don't permit any of the threads to run until we have fully initialized
 	 * g_lpwork.
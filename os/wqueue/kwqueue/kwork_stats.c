@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <errno.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/wqueue.h>
+
+#include "wqueue.h"
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Take a snapshot of the statistics of a kernel work queue.
+ *
+ * Input parameters:
+ *   qid   - The work queue ID
+ *   stats - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_getstats(int qid, FAR struct work_stats_s *stats)
+{
+	FAR struct wqueue_s *wqueue;
+	irqstate_t flags;
+
+#ifdef CONFIG_SCHED_HPWORK
+	if (qid == HPWORK) {
+		wqueue = (FAR struct wqueue_s *)get_hpwork();
+	} else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+	if (qid == LPWORK) {
+		wqueue = (FAR struct wqueue_s *)get_lpwork();
+	} else
+#endif
+	{
+		return -EINVAL;
+	}
+
+	/* The statistics are updated with interrupts disabled */
+
+	flags = irqsave();
+	*stats = wqueue->stats;
+	irqrestore(flags);
+
+	return OK;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE_STATS */
@@ -112,7 +112,6 @@
 
 int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 {
-	struct work_s *cur_work;
 	int ret = -ENOENT;
 
 	DEBUGASSERT(work != NULL);
@@ -131,31 +130,32 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 	if (work->worker != NULL) {
 		/* A little test of the integrity of the work queue */
 
-		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail);
-		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == wqueue->q.head);
+		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail || (FAR dq_entry_t *)work == wqueue->delayq.tail);
+		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == wqueue->q.head || (FAR dq_entry_t *)work == wqueue->delayq.head);
 
-		/* check whether requested work is in queue list or not */
-		cur_work = (struct work_s *)wqueue->q.head;
-		do {
-			if (cur_work == NULL) {
+		/* Remove the entry from the list it is in and make sure that it is
+		 * mark as available (i.e., the worker field is nullified).
+		 */
+
+		if (work_inqueue(&wqueue->q, work)) {
+			dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			wqueue->stats.nready--;
+#endif
+		} else if (work_inqueue(&wqueue->delayq, work)) {
+			dq_rem((FAR dq_entry_t *)work, &wqueue->delayq);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			wqueue->stats.ndelayed--;
+#endif
+		} else {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+			work_unlock();
 #else
-				irqrestore(flags);
+			irqrestore(flags);
 #endif
-				return -ENOENT;
-			} else if (cur_work == work) {
-				break;
-			}
-
-			cur_work = (struct work_s *)cur_work->dq.flink;
-		} while (1);
-
-		/* Remove the entry from the work queue and make sure that it is
-		 * mark as available (i.e., the worker field is nullified).
-		 */
+			return -ENOENT;
+		}
 
-		dq_rem((FAR dq_entry_t *)work, &wqueue->q);
 		work->worker = NULL;
 		ret = OK;
 	}
@@ -134,8 +134,6 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	 * we process items in the work list.
 	 */
 
-	next = 0;
-
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	while (work_lock() < 0);
 #else
@@ -143,93 +141,100 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	flags = irqsave();
 #endif
 
+	for (;;) {
+		/* Move the delayed work whose delay has elapsed to the tail of the
+		 * ready queue.  The delayed list is sorted by expiry time, so stop
+		 * at the first work that is not due yet and remember how long it
+		 * still has to wait.
+		 */
 
-	/* And check each entry in the work queue.  Since we have disabled
-	 * interrupts we know:  (1) we will not be suspended unless we do
-	 * so ourselves, and (2) there will be no changes to the work queue
-	 */
+		ctick = clock();
+		next = 0;
+
+		while ((work = (FAR struct work_s *)wqueue->delayq.head) != NULL) {
+			elapsed = ctick - work->qtime;
+			if (elapsed < work->delay) {
+				next = work->delay - elapsed;
+				break;
+			}
+
+			(void)dq_remfirst(&wqueue->delayq);
+			dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			wqueue->stats.ndelayed--;
+			wqueue->stats.nready++;
+#endif
+		}
 
-	work = (FAR struct work_s *)wqueue->q.head;
-	
-	while (work) {
-		
-		/* Is this work ready?  It is ready if there is no delay or if
-		 * the delay has elapsed. qtime is the time that the work was added
-		 * to the work queue.  It will always be greater than or equal to
-		 * zero.  Therefore a delay of zero will always execute immediately.
+		/* Take the oldest work that is due.  Since we have disabled
+		 * interrupts we know:  (1) we will not be suspended unless we do
+		 * so ourselves, and (2) there will be no changes to the work queue
 		 */
 
-		ctick = clock();
-		elapsed = ctick - work->qtime;
+		work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+		if (work == NULL) {
+			break;
+		}
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		wqueue->stats.nready--;
+#endif
 
-		if (elapsed >= work->delay) {
-			/* Remove the ready-to-execute work from the list */
+		/* Extract the work description from the entry (in case the work
+		 * instance by the re-used after it has been de-queued).
+		 */
 
-			(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+		worker = work->worker;
 
-			/* Extract the work description from the entry (in case the work
-			 * instance by the re-used after it has been de-queued).
-			 */
+		/* Check for a race condition where the work may be nullified
+		 * before it is removed from the queue.
+		 */
 
-			worker = work->worker;
+		if (worker != NULL) {
+			/* Extract the work argument (before re-enabling interrupts) */
 
-			/* Check for a race condition where the work may be nullified
-			 * before it is removed from the queue.
-			 */
+			arg = work->arg;
 
-			if (worker != NULL) {
-				/* Extract the work argument (before re-enabling interrupts) */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			/* Account the time from when the work became due until now */
 
-				arg = work->arg;
+			elapsed = ctick - work->qtime - work->delay;
+			if (elapsed > wqueue->stats.maxlatency) {
+				wqueue->stats.maxlatency = elapsed;
+			}
+
+			wqueue->stats.totlatency += elapsed;
+			wqueue->stats.nrun++;
+#endif
+
+			/* Mark the work as no longer being queued */
 
-				/* Mark the work as no longer being queued */
+			work->worker = NULL;
 
-				work->worker = NULL;
+			/* Do the work.  Re-enable interrupts while the work is being
+			 * performed... we don't have any idea how long this will take!
+			 */
 
-				/* Do the work.  Re-enable interrupts while the work is being
-				 * performed... we don't have any idea how long this will take!
-				 */
-				
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+			work_unlock();
 #else
-				irqrestore(flags);
+			irqrestore(flags);
 #endif
 #if defined(CONFIG_DEBUG_WORKQUEUE)
 #if defined(CONFIG_BUILD_FLAT) || (defined(CONFIG_BUILD_PROTECTED) && defined(__KERNEL__))
-				cur_worker = worker;
+			cur_worker = worker;
 #endif
 #endif
-				worker(arg);
-
-				/* Now, unfortunately, since we re-enabled interrupts we don't
-				 * know the state of the work list and we will have to start
-				 * back at the head of the list.
-				 */
+			worker(arg);
 
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				while (work_lock() < 0);
+			while (work_lock() < 0);
 #else
-				flags = irqsave();
+			flags = irqsave();
 #endif
-				work = (FAR struct work_s *)wqueue->q.head;
-			} else {
-				/* Cancelled.. Just move to the next work in the list with
-				 * interrupts still disabled.
-				 */
-
-				work = (FAR struct work_s *)work->dq.flink;
-			}
-		} else {				/* elapsed < work->delay */
-
-			next = work->delay - elapsed;
-
-			/* Then break at while loop due to sorted list */
-			break;
 		}
 	}
 
-	if (wqueue->q.head == NULL) {
+	if (wqueue->delayq.head == NULL) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 		work_unlock();
 #endif
@@ -241,11 +246,11 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 		wqueue->worker[wndx].busy = false;
 		DEBUGVERIFY(sigwaitinfo(&set, NULL));
 		wqueue->worker[wndx].busy = true;
-	} else if (next > 0) {
+	} else {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 		work_unlock();
 #endif
-		/* Wait awhile to check the work list.  We will wait here until
+		/* Wait until the next delayed work is due.  We will wait here until
 		 * either the time elapses or until we are awakened by a signal.
 		 * Interrupts will be re-enabled while we wait.
 		 */
@@ -253,12 +258,7 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 		usleep(next * USEC_PER_TICK);
 		wqueue->worker[wndx].busy = true;
 	}
-#if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-	else {
-		work_unlock();
-	}
-#else
+#if !defined(CONFIG_SCHED_USRWORK) || defined(__KERNEL__)
 	irqrestore(flags);
 #endif
-
 }
@@ -57,6 +57,7 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
@@ -84,9 +85,30 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Private Functions
+ * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_inqueue
+ *
+ * Description:
+ *   Return true if the work is linked in the given list of a work queue.
+ *
+ ****************************************************************************/
+
+bool work_inqueue(FAR struct dq_queue_s *q, FAR struct work_s *work)
+{
+	FAR dq_entry_t *entry;
+
+	for (entry = q->head; entry != NULL; entry = entry->flink) {
+		if (entry == (FAR dq_entry_t *)work) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -133,10 +155,12 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 	flags = irqsave();
 #endif
 
-	/* check whether requested work is in queue list or not */
-	cur_work = (struct work_s *)wqueue->q.head;
-	while (cur_work != NULL) {
-		if (cur_work == work) {
+	/* Work that was performed or cancelled has no worker, so only work that
+	 * still has one can be queued already.  Check both lists in that case.
+	 */
+
+	if (work->worker != NULL) {
+		if (work_inqueue(&wqueue->q, work) || work_inqueue(&wqueue->delayq, work)) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 			work_unlock();
 #else
@@ -144,27 +168,50 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 #endif
 			return -EALREADY;
 		}
+	}
+
+	work->worker = worker;		/* Work callback */
+	work->arg = arg;		/* Callback argument */
+	work->delay = delay;		/* Delay until work performed */
+	work->qtime = ctick;		/* Time work queued */
+
+	if (delay == 0) {
+		/* Work to be performed now goes to the tail of the ready queue */
 
-		if (next_work == NULL) {
+		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		wqueue->stats.nready++;
+#endif
+	} else {
+		/* Delayed work is inserted before the first work that expires later */
+
+		cur_work = (struct work_s *)wqueue->delayq.head;
+		while (cur_work != NULL) {
 			elapsed = ctick - cur_work->qtime;
 			if (cur_work->delay > elapsed && cur_work->delay - elapsed > delay) {
 				next_work = cur_work;
+				break;
 			}
+
+			cur_work = (struct work_s *)cur_work->dq.flink;
 		}
 
-		cur_work = (struct work_s *)cur_work->dq.flink;
+		if (next_work) {
+			dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->delayq);
+		} else {
+			dq_addlast((FAR dq_entry_t *)work, &wqueue->delayq);
+		}
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		wqueue->stats.ndelayed++;
+#endif
 	}
 
-	work->worker = worker;		/* Work callback */
-	work->arg = arg;		/* Callback argument */
-	work->delay = delay;		/* Delay until work performed */
-	work->qtime = ctick;		/* Time work queued */
-
-	if (next_work) {
-		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
-	} else {
-		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	wqueue->stats.nqueued++;
+	if (wqueue->stats.nready + wqueue->stats.ndelayed > wqueue->stats.maxpending) {
+		wqueue->stats.maxpending = wqueue->stats.nready + wqueue->stats.ndelayed;
 	}
+#endif
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	work_unlock();
 #else
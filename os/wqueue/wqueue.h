@@ -79,10 +79,18 @@ struct worker_s {
 	volatile bool busy;			/* True: Worker is not available */
 };
 
-/* This structure defines the state of work queue */
+/* This structure defines the state of work queue.  Work that can run now is
+ * kept in FIFO order in q, so that queueing and taking it are O(1).  Work
+ * with a delay is kept in delayq, sorted by the time it becomes due, and is
+ * moved to the tail of q by the worker thread when its delay has elapsed.
+ */
 
 struct wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work that is due */
+	struct dq_queue_s delayq;	/* Delayed work, ordered by expiry time */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and occupancy statistics */
+#endif
 	struct worker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -92,7 +100,11 @@ struct wqueue_s {
 
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work that is due */
+	struct dq_queue_s delayq;	/* Delayed work, ordered by expiry time */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and occupancy statistics */
+#endif
 	struct worker_s worker[1];	/* Describes the single high priority worker */
 };
 #endif
@@ -103,7 +115,11 @@ struct hp_wqueue_s {
 
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work that is due */
+	struct dq_queue_s delayq;	/* Delayed work, ordered by expiry time */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and occupancy statistics */
+#endif
 
 	/* Describes each thread in the low priority queue's thread pool */
 	struct worker_s worker[CONFIG_SCHED_LPNTHREADS];
@@ -174,6 +190,24 @@ int work_lock(void);
 void work_unlock(void);
 #endif
 
+/****************************************************************************
+ * Name: work_inqueue
+ *
+ * Description:
+ *   Check whether the work is linked in one list of a work queue.  The
+ *   caller must hold the work queue lock.
+ *
+ * Input parameters:
+ *   q    - The ready or the delayed list of a work queue
+ *   work - The work structure to look for
+ *
+ * Returned Value:
+ *   true if the work is in the list
+ *
+ ****************************************************************************/
+
+bool work_inqueue(FAR struct dq_queue_s *q, FAR struct work_s *work);
+
 /****************************************************************************
  * Name: work_qcancel
  *
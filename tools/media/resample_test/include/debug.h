@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host stand-in for <debug.h>, the media debug messages are dropped */
+
+#ifndef __TOOLS_MEDIA_RESAMPLE_TEST_DEBUG_H
+#define __TOOLS_MEDIA_RESAMPLE_TEST_DEBUG_H
+
+#define meddbg(...)  ((void)0)
+#define medwdbg(...) ((void)0)
+#define medvdbg(...) ((void)0)
+
+#endif							/* __TOOLS_MEDIA_RESAMPLE_TEST_DEBUG_H */
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Host test of the media sample rate converter.
+ *
+ * A 1 kHz tone at half of full scale is converted through src_simple() in
+ * the chunks the audio manager uses. The SNR is the power of the sine which
+ * fits the output best over the power of what is left, with the filter
+ * start-up and tail cut off. Throughput is the audio time converted per
+ * second of host CPU time, so it only compares builds on the same host.
+ *
+ *   resample_test                              run the default rate pairs
+ *   resample_test <in rate> <out rate> [ch]    run one conversion
+ *
+ * The exit status is non-zero if an SNR is below its limit.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "samplerate.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define TONE_HZ          1000.0
+#define TONE_LEVEL       16384.0
+#define TEST_SECONDS     10
+#define SKIP_SECONDS     0.01
+
+/* Same as the CONFIG_AUDIO_RESAMPLER_BUFSIZE default */
+#define SRC_BUFSIZE      4096
+#define CHUNK_FRAMES     1024
+#define OUT_CHUNK_FRAMES (CHUNK_FRAMES * 6 + 64)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct rate_pair_s {
+	int in_rate;
+	int out_rate;
+	double min_snr;				/* dB */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static const struct rate_pair_s g_pairs[] = {
+	{ 44100, 48000, 65.0 },
+	{ 48000, 44100, 65.0 },
+	{ 16000, 48000, 75.0 },
+	{ 48000, 16000, 75.0 },
+	{ 8000, 48000, 75.0 },
+	{ 48000, 8000, 75.0 },
+	{ 22050, 44100, 75.0 },
+	{ 44100, 22050, 75.0 },
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* SNR in dB of the first channel against the best fitting sine of TONE_HZ */
+static double measure_snr(const int16_t *out, long frames, int channels, int rate)
+{
+	double ss = 0, cc = 0, sc = 0, sy = 0, cy = 0;
+	double a, b, det, signal, noise, e;
+	double w = 2.0 * M_PI * TONE_HZ / rate;
+	long skip = (long)(SKIP_SECONDS * rate);
+	long i;
+
+	if (frames <= 2 * skip) {
+		return 0.0;
+	}
+
+	for (i = skip; i < frames - skip; i++) {
+		double s = sin(w * i);
+		double c = cos(w * i);
+		double y = out[i * channels];
+		ss += s * s;
+		cc += c * c;
+		sc += s * c;
+		sy += s * y;
+		cy += c * y;
+	}
+	det = ss * cc - sc * sc;
+	a = (sy * cc - cy * sc) / det;
+	b = (cy * ss - sy * sc) / det;
+
+	signal = 0;
+	noise = 0;
+	for (i = skip; i < frames - skip; i++) {
+		double fit = a * sin(w * i) + b * cos(w * i);
+		e = out[i * channels] - fit;
+		signal += fit * fit;
+		noise += e * e;
+	}
+	if (noise <= 0) {
+		return INFINITY;
+	}
+	return 10.0 * log10(signal / noise);
+}
+
+static int run_pair(int in_rate, int out_rate, int channels, double min_snr)
+{
+	long in_frames = (long)in_rate * TEST_SECONDS;
+	long out_max = (long)out_rate * TEST_SECONDS + OUT_CHUNK_FRAMES;
+	long in_pos = 0;
+	long out_pos = 0;
+	int16_t *in;
+	int16_t *out;
+	src_handle_t handle;
+	src_data_t data;
+	clock_t start;
+	double cpu;
+	double snr;
+	long i;
+	int ch;
+	int ret;
+
+	in = (int16_t *)malloc(in_frames * channels * sizeof(int16_t));
+	out = (int16_t *)malloc(out_max * channels * sizeof(int16_t));
+	handle = src_init(SRC_BUFSIZE);
+	if (in == NULL || out == NULL || handle == NULL) {
+		fprintf(stderr, "out of memory\n");
+		free(in);
+		free(out);
+		if (handle != NULL) {
+			src_destroy(handle);
+		}
+		return -1;
+	}
+
+	for (i = 0; i < in_frames; i++) {
+		int16_t v = (int16_t)lrint(TONE_LEVEL * sin(2.0 * M_PI * TONE_HZ * i / in_rate));
+		for (ch = 0; ch < channels; ch++) {
+			in[i * channels + ch] = v;
+		}
+	}
+
+	start = clock();
+	while (out_pos + OUT_CHUNK_FRAMES <= out_max) {
+		memset(&data, 0, sizeof(data));
+		data.data_in = in + in_pos * channels;
+		data.input_frames = (int)(in_frames - in_pos < CHUNK_FRAMES ? in_frames - in_pos : CHUNK_FRAMES);
+		data.origin_sample_rate = in_rate;
+		data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+		data.origin_channel_num = channels;
+		data.data_out = out + out_pos * channels;
+		data.out_buf_length = OUT_CHUNK_FRAMES * channels * sizeof(int16_t);
+		data.desired_sample_rate = out_rate;
+		data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+		data.desired_channel_num = channels;
+
+		ret = src_simple(handle, &data);
+		if (ret != SRC_ERR_NO_ERROR) {
+			fprintf(stderr, "%d -> %d: src_simple failed, error %d\n", in_rate, out_rate, ret);
+			break;
+		}
+		in_pos += data.input_frames_used;
+		out_pos += data.output_frames_gen;
+		if (data.input_frames_used == 0 && data.output_frames_gen == 0) {
+			break;
+		}
+	}
+	cpu = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	src_destroy(handle);
+	free(in);
+
+	if (ret != SRC_ERR_NO_ERROR) {
+		free(out);
+		return -1;
+	}
+
+	snr = measure_snr(out, out_pos, channels, out_rate);
+	printf("%6d -> %6d Hz, %d ch: SNR %6.1f dB (limit %4.1f), %8.1fx realtime\n", in_rate, out_rate, channels, snr, min_snr, cpu > 0 ? TEST_SECONDS / cpu : INFINITY);
+	free(out);
+
+	return snr < min_snr ? -1 : 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int main(int argc, char **argv)
+{
+	int failed = 0;
+	int channels;
+	size_t i;
+
+	if (argc == 3 || argc == 4) {
+		channels = argc == 4 ? atoi(argv[3]) : 1;
+		return run_pair(atoi(argv[1]), atoi(argv[2]), channels, 0.0) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	} else if (argc != 1) {
+		fprintf(stderr, "usage: %s [<in rate> <out rate> [channels]]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	for (i = 0; i < sizeof(g_pairs) / sizeof(g_pairs[0]); i++) {
+		for (channels = 1; channels <= 2; channels++) {
+			if (run_pair(g_pairs[i].in_rate, g_pairs[i].out_rate, channels, g_pairs[i].min_snr) != 0) {
+				failed++;
+			}
+		}
+	}
+
+	printf("%s\n", failed ? "FAILED" : "PASSED");
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,429 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Host benchmark of the media MPEG-TS demuxer.
+ *
+ * Each stream is probed and then demuxed the way InputHandler does it: TS
+ * data are pushed as far as the demux buffer has space, and the audio ES is
+ * pulled in decoder sized chunks. Reported are the ES size and checksum,
+ * which must not change between builds, the demux speed in host CPU time,
+ * and the operator new calls made while pulling.
+ *
+ *   tsdemux_bench [-n runs]              demux a generated stream
+ *   tsdemux_bench [-n runs] a.ts ...     demux captured streams
+ *
+ * The generated stream carries PROGRAMS programs, the first one with an AAC
+ * stream. PAT and PMTs are repeated every PSI_INTERVAL PES packets, and the
+ * PAT version changes halfway with the same programs. A null packet follows
+ * every NULL_INTERVAL packets. Its ES output is checked against the
+ * generated ES.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <new>
+#include <vector>
+
+#include "demux/mpeg2ts/TSDemuxer.h"
+
+using namespace media;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define TS_PACKET_SIZE   188
+#define TS_PAYLOAD_SIZE  184
+#define PAT_PID          0x0000
+#define PMT_PID          0x0100	/* PMT of program n is PMT_PID + 0x10 * n */
+#define AUDIO_PID        0x0101
+#define NULL_PID         0x1FFF
+#define STREAM_TYPE_AAC  0x0F
+
+#define PROGRAMS         4
+#define PES_PACKETS      4000
+#define PES_ES_SIZE      1500
+#define PSI_INTERVAL     20
+#define NULL_INTERVAL    10
+
+/* Size of the ES chunks pulled, as a decoder input buffer */
+#define ES_CHUNK_SIZE    4096
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct ts_stream_s {
+	std::vector<uint8_t> ts;
+	std::vector<uint8_t> es;	/* Expected ES, empty for captured streams */
+	uint8_t cc[2 + PROGRAMS];	/* Continuity counters of PAT, audio and PMTs */
+	unsigned packets;
+};
+
+struct demux_result_s {
+	size_t esBytes;
+	uint32_t esHash;
+	bool esMatch;
+	unsigned long allocs;
+	double seconds;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static unsigned long g_allocs;
+
+/****************************************************************************
+ * Allocation Counting
+ ****************************************************************************/
+void *operator new(size_t size)
+{
+	void *p = malloc(size ? size : 1);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	g_allocs++;
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static uint32_t crc32_mpeg(const uint8_t *data, size_t len)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	size_t i;
+	int bit;
+
+	for (i = 0; i < len; i++) {
+		crc ^= (uint32_t)data[i] << 24;
+		for (bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/* FNV-1a, to compare the ES output of two builds */
+static uint32_t hash_update(uint32_t hash, const uint8_t *data, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * 16777619u;
+	}
+	return hash;
+}
+
+/* Append a TS packet, stuffing short payloads with an adaptation field */
+static void put_packet(struct ts_stream_s *s, uint16_t pid, bool pusi, uint8_t *cc, const uint8_t *payload, size_t len)
+{
+	uint8_t packet[TS_PACKET_SIZE];
+	size_t stuff = TS_PAYLOAD_SIZE - len;
+
+	packet[0] = 0x47;
+	packet[1] = (pusi ? 0x40 : 0x00) | (uint8_t)(pid >> 8);
+	packet[2] = (uint8_t)pid;
+	packet[3] = (stuff ? 0x30 : 0x10) | (cc ? *cc : 0);
+	if (stuff > 0) {
+		packet[4] = (uint8_t)(stuff - 1);
+		if (stuff > 1) {
+			packet[5] = 0x00;
+			memset(&packet[6], 0xFF, stuff - 2);
+		}
+	}
+	memcpy(&packet[4 + stuff], payload, len);
+	if (cc) {
+		*cc = (*cc + 1) & 0x0F;
+	}
+	s->ts.insert(s->ts.end(), packet, packet + TS_PACKET_SIZE);
+
+	if (++s->packets % NULL_INTERVAL == 0) {
+		uint8_t null[TS_PAYLOAD_SIZE];
+		memset(null, 0xFF, sizeof(null));
+		put_packet(s, NULL_PID, false, NULL, null, sizeof(null));
+	}
+}
+
+/* Append a PSI section in one packet, the CRC is added to the given bytes */
+static void put_section(struct ts_stream_s *s, uint16_t pid, uint8_t *cc, const uint8_t *section, size_t len)
+{
+	uint8_t payload[TS_PAYLOAD_SIZE];
+	uint32_t crc;
+
+	memset(payload, 0xFF, sizeof(payload));
+	payload[0] = 0;				/* pointer_field */
+	memcpy(&payload[1], section, len);
+	crc = crc32_mpeg(section, len);
+	payload[1 + len] = (uint8_t)(crc >> 24);
+	payload[2 + len] = (uint8_t)(crc >> 16);
+	payload[3 + len] = (uint8_t)(crc >> 8);
+	payload[4 + len] = (uint8_t)crc;
+	put_packet(s, pid, true, cc, payload, sizeof(payload));
+}
+
+static void put_psi(struct ts_stream_s *s, uint8_t version)
+{
+	uint8_t pat[8 + 4 * PROGRAMS] = {
+		0x00, 0xB0, 5 + 4 * PROGRAMS + 4,	/* table_id, section_length */
+		0x00, 0x01,				/* transport_stream_id */
+		(uint8_t)(0xC1 | (version << 1)), 0x00, 0x00,	/* current, section 0 of 0 */
+	};
+	uint8_t pmt[] = {
+		0x02, 0xB0, 18,			/* table_id, section_length */
+		0x00, 0x01,				/* program_number */
+		0xC1, 0x00, 0x00,		/* version 0, current, section 0 of 0 */
+		0xE0 | (AUDIO_PID >> 8), AUDIO_PID & 0xFF,	/* PCR_PID */
+		0xF0, 0x00,				/* program_info_length */
+		STREAM_TYPE_AAC, 0xE0 | (AUDIO_PID >> 8), AUDIO_PID & 0xFF,
+		0xF0, 0x00,				/* ES_info_length */
+	};
+	uint16_t pid;
+	int i;
+
+	for (i = 0; i < PROGRAMS; i++) {
+		pid = PMT_PID + 0x10 * i;
+		pat[8 + 4 * i] = 0x00;
+		pat[9 + 4 * i] = (uint8_t)(i + 1);
+		pat[10 + 4 * i] = 0xE0 | (uint8_t)(pid >> 8);
+		pat[11 + 4 * i] = (uint8_t)pid;
+	}
+	put_section(s, PAT_PID, &s->cc[0], pat, sizeof(pat));
+
+	for (i = 0; i < PROGRAMS; i++) {
+		pmt[4] = (uint8_t)(i + 1);
+		put_section(s, PMT_PID + 0x10 * i, &s->cc[2 + i], pmt, sizeof(pmt));
+	}
+}
+
+static void put_pes(struct ts_stream_s *s, unsigned index, uint32_t *seed)
+{
+	std::vector<uint8_t> pes;
+	uint64_t pts = (uint64_t)index * 1920;
+	size_t start;
+	size_t len;
+	int i;
+
+	pes.push_back(0x00);
+	pes.push_back(0x00);
+	pes.push_back(0x01);
+	pes.push_back(0xC0);		/* audio stream 0 */
+	pes.push_back((uint8_t)((3 + 5 + PES_ES_SIZE) >> 8));
+	pes.push_back((uint8_t)(3 + 5 + PES_ES_SIZE));
+	pes.push_back(0x80);
+	pes.push_back(0x80);		/* PTS only */
+	pes.push_back(5);
+	pes.push_back(0x21 | (uint8_t)((pts >> 29) & 0x0E));
+	pes.push_back((uint8_t)(pts >> 22));
+	pes.push_back(0x01 | (uint8_t)((pts >> 14) & 0xFE));
+	pes.push_back((uint8_t)(pts >> 7));
+	pes.push_back(0x01 | (uint8_t)((pts << 1) & 0xFE));
+
+	start = s->es.size();
+	for (i = 0; i < PES_ES_SIZE; i++) {
+		*seed = *seed * 1103515245u + 12345u;
+		s->es.push_back((uint8_t)(*seed >> 16));
+	}
+	pes.insert(pes.end(), s->es.begin() + start, s->es.end());
+
+	for (start = 0; start < pes.size(); start += len) {
+		len = pes.size() - start;
+		if (len > TS_PAYLOAD_SIZE) {
+			len = TS_PAYLOAD_SIZE;
+		}
+		put_packet(s, AUDIO_PID, start == 0, &s->cc[1], &pes[start], len);
+	}
+}
+
+static void generate_stream(struct ts_stream_s *s)
+{
+	uint32_t seed = 1;
+	unsigned i;
+
+	memset(s->cc, 0, sizeof(s->cc));
+	s->packets = 0;
+	for (i = 0; i < PES_PACKETS; i++) {
+		if (i % PSI_INTERVAL == 0) {
+			put_psi(s, i < PES_PACKETS / 2 ? 0 : 1);
+		}
+		put_pes(s, i, &seed);
+	}
+}
+
+static bool load_stream(const char *path, struct ts_stream_s *s)
+{
+	uint8_t buf[4096];
+	size_t len;
+	FILE *fp;
+
+	fp = fopen(path, "rb");
+	if (fp == NULL) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+	while ((len = fread(buf, 1, sizeof(buf), fp)) > 0) {
+		s->ts.insert(s->ts.end(), buf, buf + len);
+	}
+	fclose(fp);
+	return true;
+}
+
+static bool demux_stream(const struct ts_stream_s *s, struct demux_result_s *r)
+{
+	uint8_t *ts = const_cast<uint8_t *>(s->ts.data());
+	size_t size = s->ts.size();
+	size_t pushed = 0;
+	size_t len;
+	ssize_t ret;
+	clock_t start;
+	uint8_t es[ES_CHUNK_SIZE];
+
+	auto demuxer = TSDemuxer::create();
+	if (!demuxer) {
+		fprintf(stderr, "TSDemuxer::create failed\n");
+		return false;
+	}
+
+	/* Probe the program information as InputHandler::registerCodec does */
+	do {
+		len = demuxer->getAvailSpace() / 4;
+		if (len > size - pushed) {
+			len = size - pushed;
+		}
+		if (len == 0) {
+			fprintf(stderr, "no PAT and PMT found\n");
+			return false;
+		}
+		pushed += (size_t)demuxer->pushData(ts + pushed, len);
+		ret = demuxer->prepare();
+		if (ret < 0 && ret != DEMUXER_ERROR_WANT_DATA) {
+			fprintf(stderr, "prepare failed, error %d\n", (int)ret);
+			return false;
+		}
+	} while (!demuxer->isReady());
+
+	r->esBytes = 0;
+	r->esHash = 2166136261u;
+	r->esMatch = true;
+	r->allocs = g_allocs;
+	start = clock();
+	while (true) {
+		len = demuxer->getAvailSpace();
+		if (len > size - pushed) {
+			len = size - pushed;
+		}
+		if (len > 0) {
+			pushed += (size_t)demuxer->pushData(ts + pushed, len);
+		}
+
+		ret = demuxer->pullData(es, sizeof(es));
+		if (ret > 0) {
+			r->esHash = hash_update(r->esHash, es, (size_t)ret);
+			if (!s->es.empty() && (r->esBytes + ret > s->es.size() || memcmp(es, &s->es[r->esBytes], ret) != 0)) {
+				r->esMatch = false;
+			}
+			r->esBytes += (size_t)ret;
+			continue;
+		}
+		if (ret == DEMUXER_ERROR_WANT_DATA && pushed < size) {
+			continue;
+		}
+		break;
+	}
+	r->seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+	r->allocs = g_allocs - r->allocs;
+
+	if (ret != DEMUXER_ERROR_WANT_DATA) {
+		fprintf(stderr, "pullData failed, error %d\n", (int)ret);
+		return false;
+	}
+	if (!s->es.empty() && r->esBytes != s->es.size()) {
+		r->esMatch = false;
+	}
+	return true;
+}
+
+static bool run_stream(const char *name, const struct ts_stream_s *s, int runs)
+{
+	struct demux_result_s r;
+	struct demux_result_s best = { 0, 0, false, 0, 0.0 };
+	int i;
+
+	for (i = 0; i < runs; i++) {
+		if (!demux_stream(s, &r)) {
+			fprintf(stderr, "%s: demux failed\n", name);
+			return false;
+		}
+		if (i == 0 || r.seconds < best.seconds) {
+			best = r;
+		}
+	}
+
+	printf("%s: %.2f MB TS, %.2f MB ES, hash 0x%08x, %.1f MB/s, %lu allocations while pulling", name, s->ts.size() / 1e6, best.esBytes / 1e6, best.esHash, best.seconds > 0 ? s->ts.size() / 1e6 / best.seconds : 0.0, best.allocs);
+	if (!s->es.empty()) {
+		printf(", ES %s", best.esMatch ? "matches" : "DIFFERS");
+	}
+	printf("\n");
+
+	return s->es.empty() || best.esMatch;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int main(int argc, char **argv)
+{
+	bool ok = true;
+	int runs = 5;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		if (opt == 'n' && atoi(optarg) > 0) {
+			runs = atoi(optarg);
+		} else {
+			fprintf(stderr, "usage: %s [-n runs] [file.ts ...]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind == argc) {
+		struct ts_stream_s s;
+		generate_stream(&s);
+		ok = run_stream("generated", &s, runs);
+	}
+
+	for (; optind < argc; optind++) {
+		struct ts_stream_s s;
+		if (!load_stream(argv[optind], &s) || !run_stream(argv[optind], &s, runs)) {
+			ok = false;
+		}
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}